@@ -48,6 +48,22 @@ ln -sf "../../../../SDK/Examples/Import Test/Import Test.c" ImportTest.c
 ln -sf "../../../../SDK/Examples/Camera Test/Camera Test.c" CameraTest.c
 ln -sf "../../../../SDK/Examples/Dump Group/Dump Group.c" DumpGroup.c
 ln -sf "../../../../SDK/Examples/Light Test/Light Test.c" LightTest.c
+ln -sf "../../../../SDK/Examples/Performance Test/Performance Test.cpp" PerformanceTest.cpp
+ln -sf ../../../../SDK/Extras/Rayshade/Sources Rayshade
+
+# the RayShade sources include their libraries by lower case name
+mkdir RayshadeIncludes
+pushd RayshadeIncludes
+
+ln -sf ../Rayshade/Rayshade/LibCommon libcommon
+ln -sf ../Rayshade/Rayshade/LibImage libimage
+ln -sf ../Rayshade/Rayshade/LibLight liblight
+ln -sf ../Rayshade/Rayshade/LibObj libobj
+ln -sf ../Rayshade/Rayshade/LibShade libshade
+ln -sf ../Rayshade/Rayshade/LibSurf libsurf
+ln -sf ../Rayshade/Rayshade/LibText libtext
+
+popd
 
 mkdir Models
 pushd Models
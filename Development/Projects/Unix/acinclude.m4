@@ -38,10 +38,10 @@ main ()
 }], ac_cv_c_bigendian=no, ac_cv_c_bigendian=yes)
 fi])
 if test $ac_cv_c_bigendian = no; then
-  CFLAGS="-DQUESA_HOST_IS_BIG_ENDIAN=0 ${CFLAGS}"
+  CPPFLAGS="-DQUESA_HOST_IS_BIG_ENDIAN=0 ${CPPFLAGS}"
 fi
 if test $ac_cv_c_bigendian = yes; then
-  CFLAGS="-DQUESA_HOST_IS_BIG_ENDIAN=1 ${CFLAGS}"
+  CPPFLAGS="-DQUESA_HOST_IS_BIG_ENDIAN=1 ${CPPFLAGS}"
 fi
 ])# AC_C_BIGENDIAN_QUESA
 
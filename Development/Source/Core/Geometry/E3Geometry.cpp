@@ -80,6 +80,8 @@
 #include "E3GeometryTriGrid.h"
 #include "E3GeometryTriMesh.h"
 
+#include <mutex>
+
 
 
 
@@ -87,7 +89,43 @@
 //=============================================================================
 //      Internal constants
 //-----------------------------------------------------------------------------
-#define		kWorldSpaceTolerance	1.0e-5f
+#define		kWorldSpaceTolerance			1.0e-5f
+
+#define		kGeomCacheMaxEntries			4
+#define		kGeomCacheDefaultMemoryLimit	(64 * 1024 * 1024)
+#define		kGeomCacheObjectSize			256
+#define		kGeomCacheAttributeSize			16
+#define		kGeomCacheScaleSteps			8.0f
+#define		kGeomCacheScaleDegenerate		((TQ3Int32) 0x7FFFFFFF)
+
+
+
+
+
+//=============================================================================
+//      Internal variables
+//-----------------------------------------------------------------------------
+//		Note :	Guards the global LRU and the per-geometry entry lists, since
+//				evicting on one thread can remove entries from a geometry
+//				which is being submitted on another.
+//
+//				The mutex is recursive since disposing of a cached object
+//				can dispose of geometries which purge their own entries.
+//-----------------------------------------------------------------------------
+static std::recursive_mutex sGeomCacheMutex;
+
+
+
+
+//=============================================================================
+//      Internal function prototypes
+//-----------------------------------------------------------------------------
+TQ3Boolean			e3geometry_cache_isvalid(TQ3ViewObject theView,
+											TQ3ObjectType objectType, TQ3GeometryObject theGeom,
+											const void   *geomData,   TQ3Object         cachedGeom);
+static void			e3geometry_cache_update(TQ3ViewObject theView,
+											TQ3ObjectType objectType, TQ3GeometryObject theGeom,
+											const void   *geomData,   TQ3Object         *cachedGeom);
 
 
 
@@ -159,6 +197,404 @@ e3geometry_get_attributes( E3Geometry* theGeom)
 
 
 
+//=============================================================================
+//      e3geometry_cache_link_global : Add an entry to the front of the LRU.
+//-----------------------------------------------------------------------------
+static void
+e3geometry_cache_link_global(E3GeometryCacheEntry *theEntry)
+	{
+	E3GlobalsPtr theGlobals = E3Globals_Get();
+
+	theEntry->prevGlobal = nullptr;
+	theEntry->nextGlobal = theGlobals->geomCacheHead;
+
+	if (theGlobals->geomCacheHead != nullptr)
+		theGlobals->geomCacheHead->prevGlobal = theEntry;
+	else
+		theGlobals->geomCacheTail = theEntry;
+
+	theGlobals->geomCacheHead = theEntry;
+	}
+
+
+
+
+
+//=============================================================================
+//      e3geometry_cache_unlink_global : Remove an entry from the LRU.
+//-----------------------------------------------------------------------------
+static void
+e3geometry_cache_unlink_global(E3GeometryCacheEntry *theEntry)
+	{
+	E3GlobalsPtr theGlobals = E3Globals_Get();
+
+	if (theEntry->prevGlobal != nullptr)
+		theEntry->prevGlobal->nextGlobal = theEntry->nextGlobal;
+	else
+		theGlobals->geomCacheHead = theEntry->nextGlobal;
+
+	if (theEntry->nextGlobal != nullptr)
+		theEntry->nextGlobal->prevGlobal = theEntry->prevGlobal;
+	else
+		theGlobals->geomCacheTail = theEntry->prevGlobal;
+
+	theEntry->prevGlobal = nullptr;
+	theEntry->nextGlobal = nullptr;
+	}
+
+
+
+
+
+//=============================================================================
+//      e3geometry_cache_remove : Remove and dispose of a cache entry.
+//-----------------------------------------------------------------------------
+static void
+e3geometry_cache_remove(E3GeometryCacheEntry *theEntry, TQ3Boolean isEviction)
+	{
+	E3GlobalsPtr    theGlobals = E3Globals_Get();
+	E3GeometryData* theOwner   = theEntry->owner;
+
+
+
+	// Unlink the entry from its geometry and from the LRU
+	E3GeometryCacheEntry** theLink = &theOwner->cacheEntries;
+	while (*theLink != theEntry)
+		theLink = &(*theLink)->nextInGeometry;
+
+	*theLink = theEntry->nextInGeometry;
+	theOwner->cacheEntryCount -= 1;
+
+	e3geometry_cache_unlink_global(theEntry);
+
+
+
+	// Update the statistics, and clean up
+	theGlobals->geomCacheEntryCount -= 1;
+	theGlobals->geomCacheMemoryUsed -= theEntry->memorySize;
+
+	if (isEviction)
+		theGlobals->geomCacheEvictions += 1;
+
+	Q3Object_CleanDispose(&theEntry->cachedObject);
+	Q3Memory_Free(&theEntry);
+	}
+
+
+
+
+
+//=============================================================================
+//      e3geometry_cache_purge : Dispose of all cache entries for a geometry.
+//-----------------------------------------------------------------------------
+static void
+e3geometry_cache_purge(E3GeometryData *instanceData)
+	{
+	std::lock_guard<std::recursive_mutex> cacheLock(sGeomCacheMutex);
+
+	while (instanceData->cacheEntries != nullptr)
+		e3geometry_cache_remove(instanceData->cacheEntries, kQ3False);
+	}
+
+
+
+
+
+//=============================================================================
+//      e3geometry_cache_trim : Evict entries until the cache fits its budget.
+//-----------------------------------------------------------------------------
+//		Note :	Entries are evicted from the least recently used end, but
+//				keepEntry (which may be nullptr) is never evicted.
+//-----------------------------------------------------------------------------
+static void
+e3geometry_cache_trim(E3GeometryCacheEntry *keepEntry)
+	{
+	E3GlobalsPtr theGlobals = E3Globals_Get();
+
+	while (theGlobals->geomCacheMemoryUsed > theGlobals->geomCacheMemoryLimit &&
+		   theGlobals->geomCacheTail != nullptr &&
+		   theGlobals->geomCacheTail != keepEntry)
+		e3geometry_cache_remove(theGlobals->geomCacheTail, kQ3True);
+	}
+
+
+
+
+
+//=============================================================================
+//      e3geometry_cache_estimate_size : Estimate the size of a cached object.
+//-----------------------------------------------------------------------------
+//		Note :	Decompositions are almost always TriMeshes, or groups which
+//				contain them, so we only look inside those. Attribute arrays
+//				are assumed to be of a typical size rather than measured.
+//-----------------------------------------------------------------------------
+static TQ3Uns32
+e3geometry_cache_estimate_size(TQ3Object theObject)
+	{
+	TQ3Uns32			theSize = kGeomCacheObjectSize;
+	TQ3TriMeshData		*triMeshData;
+	TQ3GroupPosition	thePosition;
+	TQ3Object			subObject;
+
+
+
+	// Measure TriMeshes
+	if (Q3Object_IsType(theObject, kQ3GeometryTypeTriMesh))
+		{
+		if (E3TriMesh_LockData(theObject, kQ3True, &triMeshData) == kQ3Success)
+			{
+			theSize += triMeshData->numPoints * (TQ3Uns32) (sizeof(TQ3Point3D) +
+						triMeshData->numVertexAttributeTypes * kGeomCacheAttributeSize);
+
+			theSize += triMeshData->numTriangles * (TQ3Uns32) (sizeof(TQ3TriMeshTriangleData) +
+						triMeshData->numTriangleAttributeTypes * kGeomCacheAttributeSize);
+
+			theSize += triMeshData->numEdges * (TQ3Uns32) (sizeof(TQ3TriMeshEdgeData) +
+						triMeshData->numEdgeAttributeTypes * kGeomCacheAttributeSize);
+
+			E3TriMesh_UnlockData(theObject);
+			}
+		}
+
+
+
+	// Measure the contents of groups
+	else if (Q3Object_IsType(theObject, kQ3ShapeTypeGroup))
+		{
+		Q3Group_GetFirstPosition(theObject, &thePosition);
+		while (thePosition != nullptr)
+			{
+			if (Q3Group_GetPositionObject(theObject, thePosition, &subObject) == kQ3Success)
+				{
+				theSize += e3geometry_cache_estimate_size(subObject);
+				Q3Object_Dispose(subObject);
+				}
+
+			Q3Group_GetNextPosition(theObject, &thePosition);
+			}
+		}
+
+	return theSize;
+	}
+
+
+
+
+
+//=============================================================================
+//      e3geometry_cache_get_key : Get the cache key for the current state.
+//-----------------------------------------------------------------------------
+//		Note :	The key holds the view state which the decomposed form of a
+//				geometry depends on, following e3geometry_cache_isvalid.
+//
+//				Rather than the exact local to world determinant, we key on
+//				the linear scale of the transform quantised to eighths of an
+//				octave (plus the sign of the determinant), so that animated
+//				or instanced geometry at similar scales can share a form.
+//-----------------------------------------------------------------------------
+static void
+e3geometry_cache_get_key(TQ3ViewObject theView, E3ClassInfoPtr theClass, E3GeometryCacheKey *theKey)
+	{
+	TQ3Matrix4x4		localToWorld;
+
+
+
+	// Clear the key, so that unused fields compare equal
+	Q3Memory_Clear(theKey, sizeof(E3GeometryCacheKey));
+
+
+
+	// Collect the subdivision state
+	if (theClass->GetMethod(kQ3XMethodTypeGeomUsesSubdivision) != nullptr)
+		{
+		theKey->styleSubdivision = *E3View_State_GetStyleSubdivision(theView);
+
+		if (theKey->styleSubdivision.method == kQ3SubdivisionMethodScreenSpace)
+			{
+			theKey->camera = E3View_AccessCamera(theView);
+			if (theKey->camera != nullptr)
+				theKey->cameraEditIndex = Q3Shared_GetEditIndex(theKey->camera);
+			}
+
+		if (theKey->styleSubdivision.method != kQ3SubdivisionMethodConstant)
+			{
+			Q3View_GetLocalToWorldMatrixState(theView, &localToWorld);
+			float theDet = Q3Matrix4x4_Determinant(&localToWorld);
+			float absDet = E3Float_Abs(theDet);
+
+			if (absDet > 0.0f && absDet <= FLT_MAX)
+				{
+				float logScale = log2f(absDet) / 3.0f;
+				theKey->scaleBucket = 2 * (TQ3Int32) floorf(logScale * kGeomCacheScaleSteps + 0.5f);
+				if (theDet < 0.0f)
+					theKey->scaleBucket += 1;
+				}
+			else
+				theKey->scaleBucket = kGeomCacheScaleDegenerate;
+			}
+		}
+
+
+
+	// Collect the orientation state
+	if (theClass->GetMethod(kQ3XMethodTypeGeomUsesOrientation) != nullptr)
+		theKey->styleOrientation = E3View_State_GetStyleOrientation(theView);
+	}
+
+
+
+
+
+//=============================================================================
+//      e3geometry_cache_key_equal : Compare two cache keys.
+//-----------------------------------------------------------------------------
+static bool
+e3geometry_cache_key_equal(const E3GeometryCacheKey &key1, const E3GeometryCacheKey &key2)
+	{
+	return key1.styleSubdivision.method == key2.styleSubdivision.method &&
+		   key1.styleSubdivision.c1     == key2.styleSubdivision.c1     &&
+		   key1.styleSubdivision.c2     == key2.styleSubdivision.c2     &&
+		   key1.camera                  == key2.camera                  &&
+		   key1.cameraEditIndex         == key2.cameraEditIndex         &&
+		   key1.scaleBucket             == key2.scaleBucket             &&
+		   key1.styleOrientation        == key2.styleOrientation;
+	}
+
+
+
+
+
+//=============================================================================
+//      e3geometry_cache_find_or_build : Find or build a decomposed geometry.
+//-----------------------------------------------------------------------------
+//		Note :	Returns a new reference to the cached object for the current
+//				view state, or nullptr on failure.
+//
+//				Each geometry keeps up to kGeomCacheMaxEntries decomposed
+//				forms, most recently used first. All entries are discarded
+//				when the geometry is edited.
+//
+//				The cache lock is released while the object is built, so
+//				that other threads can decompose their own geometries.
+//-----------------------------------------------------------------------------
+static TQ3Object
+e3geometry_cache_find_or_build(TQ3ViewObject theView, E3GeometryInfo *theClass,
+								TQ3GeometryObject theGeom, const void *geomData,
+								E3GeometryData *instanceData)
+	{
+	E3GlobalsPtr			theGlobals = E3Globals_Get();
+	E3GeometryCacheKey		theKey;
+	TQ3Object				cachedObject = nullptr;
+
+
+
+	std::unique_lock<std::recursive_mutex> cacheLock(sGeomCacheMutex);
+
+
+
+	// Discard everything if the geometry has changed
+	TQ3Uns32 editIndex = Q3Shared_GetEditIndex(theGeom);
+	if (editIndex != instanceData->cachedEditIndex)
+		{
+		e3geometry_cache_purge(instanceData);
+		instanceData->cachedEditIndex = editIndex;
+		}
+
+
+
+	// Look for an entry which matches the current state, and make it the most recent
+	e3geometry_cache_get_key(theView, theClass, &theKey);
+
+	for (E3GeometryCacheEntry** theLink = &instanceData->cacheEntries; *theLink != nullptr;
+			theLink = &(*theLink)->nextInGeometry)
+		{
+		E3GeometryCacheEntry* theEntry = *theLink;
+		if (e3geometry_cache_key_equal(theEntry->key, theKey))
+			{
+			*theLink                 = theEntry->nextInGeometry;
+			theEntry->nextInGeometry = instanceData->cacheEntries;
+			instanceData->cacheEntries = theEntry;
+
+			e3geometry_cache_unlink_global(theEntry);
+			e3geometry_cache_link_global(theEntry);
+
+			theGlobals->geomCacheHits += 1;
+			return Q3Shared_GetReference(theEntry->cachedObject);
+			}
+		}
+
+	theGlobals->geomCacheMisses += 1;
+	cacheLock.unlock();
+
+
+
+	// Build a new cached object
+	if (theClass->cacheNew == nullptr)
+		return nullptr;
+
+	try
+		{
+		cachedObject = theClass->cacheNew(theView, theGeom, geomData);
+		}
+	catch (std::bad_alloc&)
+		{
+		cachedObject = nullptr;
+		E3ErrorManager_PostError(kQ3ErrorOutOfMemory, kQ3False);
+		}
+	catch (...)
+		{
+		cachedObject = nullptr;
+		}
+
+	if (cachedObject == nullptr)
+		return nullptr;
+
+	E3GeometryCacheEntry* theEntry = (E3GeometryCacheEntry*) Q3Memory_AllocateClear(sizeof(E3GeometryCacheEntry));
+	if (theEntry == nullptr)
+		{
+		Q3Object_Dispose(cachedObject);
+		return nullptr;
+		}
+
+	theEntry->key          = theKey;
+	theEntry->cachedObject = cachedObject;
+	theEntry->memorySize   = e3geometry_cache_estimate_size(cachedObject);
+	theEntry->owner        = instanceData;
+
+	cacheLock.lock();
+
+
+
+	// Make room for the entry in the geometry, then add it to the front of both lists
+	if (instanceData->cacheEntryCount >= kGeomCacheMaxEntries)
+		{
+		E3GeometryCacheEntry* lastEntry = instanceData->cacheEntries;
+		while (lastEntry->nextInGeometry != nullptr)
+			lastEntry = lastEntry->nextInGeometry;
+
+		e3geometry_cache_remove(lastEntry, kQ3True);
+		}
+
+	theEntry->nextInGeometry   = instanceData->cacheEntries;
+	instanceData->cacheEntries = theEntry;
+	instanceData->cacheEntryCount += 1;
+
+	e3geometry_cache_link_global(theEntry);
+	theGlobals->geomCacheEntryCount += 1;
+	theGlobals->geomCacheMemoryUsed += theEntry->memorySize;
+
+
+
+	// Keep within the memory budget
+	e3geometry_cache_trim(theEntry);
+
+	return Q3Shared_GetReference(theEntry->cachedObject);
+	}
+
+
+
+
+
 //=============================================================================
 //      e3geometry_new : Geometry new method.
 //-----------------------------------------------------------------------------
@@ -186,6 +622,7 @@ e3geometry_delete(TQ3Object theObject, void *privateData)
 
 
 	// Clean up
+	e3geometry_cache_purge ( &instanceData->instanceData ) ;
 	Q3Object_CleanDispose ( &instanceData->instanceData.cachedObject ) ;
 	}
 
@@ -212,6 +649,8 @@ e3geometry_duplicate(TQ3Object fromObject, const void *fromPrivateData,
 	toInstanceData->instanceData.cachedEditIndex   = 0;
 	toInstanceData->instanceData.cachedObject      = nullptr;
 	toInstanceData->instanceData.cachedDeterminant = 0.0f;
+	toInstanceData->instanceData.cacheEntries      = nullptr;
+	toInstanceData->instanceData.cacheEntryCount   = 0;
 	
 	return kQ3Success ;
 	}
@@ -233,6 +672,10 @@ e3geometry_duplicate(TQ3Object fromObject, const void *fromPrivateData,
 //				If the cached form itself has to be decomposed, we will simply
 //				repeat the process until one of the required geometry types is
 //				reached.
+//
+//				Geometries which use the default cache methods keep several
+//				cached forms, keyed by view state. Geometries which override
+//				either method keep a single cached object, as before.
 //-----------------------------------------------------------------------------
 
 
@@ -259,18 +702,36 @@ e3geometry_submit_decomposed(TQ3ViewObject theView, TQ3ObjectType objectType, TQ
 
 
 
-		// Rebuild the cached object if it's out of date
-		if ( ! theClass->cacheIsValid ( theView, objectType, theObject,
-			objectData, instanceData->instanceData.cachedObject ) )
-			
-			theClass->cacheUpdate(theView, objectType, theObject, objectData,
-				&instanceData->instanceData.cachedObject);
+		// Find or build the cached object for the current state
+		//
+		// We hold a reference while submitting, since nested submits or
+		// other threads may evict the entry from the cache.
+		if ( theClass->cacheIsValid == e3geometry_cache_isvalid
+		&&   theClass->cacheUpdate  == e3geometry_cache_update )
+			{
+			TQ3Object cachedObject = e3geometry_cache_find_or_build ( theView, theClass, theObject,
+													objectData, &instanceData->instanceData ) ;
+			if ( cachedObject != nullptr )
+				{
+				qd3dStatus = E3View_SubmitRetained ( theView, cachedObject ) ;
+				Q3Object_Dispose ( cachedObject ) ;
+				}
+			}
+		else
+			{
+			// Rebuild the cached object if it's out of date
+			if ( ! theClass->cacheIsValid ( theView, objectType, theObject,
+				objectData, instanceData->instanceData.cachedObject ) )
+				
+				theClass->cacheUpdate(theView, objectType, theObject, objectData,
+					&instanceData->instanceData.cachedObject);
 
 
 
-		// Submit the cached object (or we fail)
-		if (instanceData->instanceData.cachedObject != nullptr)
-			qd3dStatus = E3View_SubmitRetained(theView, instanceData->instanceData.cachedObject);
+			// Submit the cached object (or we fail)
+			if (instanceData->instanceData.cachedObject != nullptr)
+				qd3dStatus = E3View_SubmitRetained(theView, instanceData->instanceData.cachedObject);
+			}
 		}
 
 
@@ -721,6 +1182,11 @@ e3geometry_metahandler(TQ3XMethodType methodType)
 TQ3Status
 E3Geometry_RegisterClass ( void )
 	{
+	// Initialise the cache budget
+	E3Globals_Get()->geomCacheMemoryLimit = kGeomCacheDefaultMemoryLimit ;
+
+
+
 	// Register the geometry classes
 	TQ3Status qd3dStatus = Q3_REGISTER_CLASS (	kQ3ClassNameGeometry,
 												e3geometry_metahandler,
@@ -965,6 +1431,51 @@ E3Geometry_GetDecomposed( TQ3GeometryObject theGeom, TQ3ViewObject view )
 
 
 
+//=============================================================================
+//      E3Geometry_GetCacheStatistics : Get the geometry cache statistics.
+//-----------------------------------------------------------------------------
+TQ3Status
+E3Geometry_GetCacheStatistics(TQ3GeometryCacheStatistics *statistics)
+	{
+	E3GlobalsPtr theGlobals = E3Globals_Get();
+	std::lock_guard<std::recursive_mutex> cacheLock(sGeomCacheMutex);
+
+
+
+	// Return the statistics
+	statistics->hitCount      = theGlobals->geomCacheHits;
+	statistics->missCount     = theGlobals->geomCacheMisses;
+	statistics->evictionCount = theGlobals->geomCacheEvictions;
+	statistics->entryCount    = theGlobals->geomCacheEntryCount;
+	statistics->memoryUsed    = theGlobals->geomCacheMemoryUsed;
+	statistics->memoryLimit   = theGlobals->geomCacheMemoryLimit;
+
+	return kQ3Success ;
+	}
+
+
+
+
+
+//=============================================================================
+//      E3Geometry_SetCacheMemoryLimit : Set the geometry cache budget.
+//-----------------------------------------------------------------------------
+TQ3Status
+E3Geometry_SetCacheMemoryLimit(TQ3Uns32 memoryLimit)
+	{
+	// Set the limit, and evict anything which no longer fits
+	std::lock_guard<std::recursive_mutex> cacheLock(sGeomCacheMutex);
+
+	E3Globals_Get()->geomCacheMemoryLimit = memoryLimit;
+	e3geometry_cache_trim(nullptr);
+
+	return kQ3Success ;
+	}
+
+
+
+
+
 //=============================================================================
 //      E3Geometry_IsDegenerateTriple : Test whether 3 axes are coplanar.
 //-----------------------------------------------------------------------------
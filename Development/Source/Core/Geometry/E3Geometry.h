@@ -88,6 +88,33 @@ public :
 
 
 
+// Cache key for a decomposed geometry
+struct E3GeometryCacheKey
+{
+	TQ3SubdivisionStyleData		styleSubdivision;
+	TQ3CameraObject				camera;
+	TQ3Uns32					cameraEditIndex;
+	TQ3Int32					scaleBucket;
+	TQ3OrientationStyle			styleOrientation;
+};
+
+
+// Cached decomposed geometry
+//
+// Entries are linked into their geometry's list, most recently used first,
+// and into a global list across all geometries in the same order.
+struct E3GeometryCacheEntry
+{
+	E3GeometryCacheKey			key;
+	TQ3Object					cachedObject;
+	TQ3Uns32					memorySize;
+	struct E3GeometryData*		owner;
+	E3GeometryCacheEntry*		nextInGeometry;
+	E3GeometryCacheEntry*		prevGlobal;
+	E3GeometryCacheEntry*		nextGlobal;
+};
+
+
 // Geometry data
 struct E3GeometryData
 {
@@ -97,6 +124,8 @@ struct E3GeometryData
 	TQ3Uns32					cachedEditIndex;
 	TQ3Object					cachedObject;
 	float						cachedDeterminant;
+	E3GeometryCacheEntry*		cacheEntries;
+	TQ3Uns32					cacheEntryCount;
 };
 
 
@@ -142,6 +171,8 @@ TQ3Status			E3Geometry_GetAttributeSet(TQ3GeometryObject theGeom, TQ3AttributeSe
 TQ3Status			E3Geometry_SetAttributeSet(TQ3GeometryObject theGeom, TQ3AttributeSet attributeSet);
 TQ3Status			E3Geometry_Submit(TQ3GeometryObject theGeom, TQ3ViewObject theView);
 TQ3Object			E3Geometry_GetDecomposed( TQ3GeometryObject theGeom, TQ3ViewObject view );
+TQ3Status			E3Geometry_GetCacheStatistics(TQ3GeometryCacheStatistics *statistics);
+TQ3Status			E3Geometry_SetCacheMemoryLimit(TQ3Uns32 memoryLimit);
 
 TQ3Boolean			E3Geometry_IsDegenerateTriple( const TQ3Vector3D* orientation,
 												const TQ3Vector3D* majorAxis,
@@ -53,6 +53,7 @@
 #include "E3Math_Intersect.h"
 #include "E3Geometry.h"
 #include "E3GeometryTriMesh.h"
+#include "E3GeometryTriMeshBVH.h"
 #include "E3ErrorManager.h"
 #include "QuesaMathOperators.hpp"
 
@@ -1052,6 +1053,54 @@ e3geom_trimesh_cache_new(TQ3ViewObject theView, TQ3GeometryObject theGeom,
 
 
 
+//=============================================================================
+//      e3geom_trimesh_window_candidates : Find the triangles which may touch
+//				an area of the window.
+//-----------------------------------------------------------------------------
+static bool
+e3geom_trimesh_window_candidates( TQ3ViewObject				theView,
+									TQ3GeometryObject		inNakedTriMesh,
+									const TQ3TriMeshData	*geomData,
+									const TQ3Area&			inArea,
+									E3FastArray<TQ3Uns32>&	outTriangles )
+{
+	TE3BVHWindowTest theTest;
+	
+	if (! E3BVH_InitWindowTest( theView, inArea, theTest ))
+		return false;
+	
+	return E3TriMeshBVH_GetCandidates( inNakedTriMesh, *geomData,
+		E3BVH_WindowNodeTest, &theTest, outTriangles );
+}
+
+
+
+
+
+//=============================================================================
+//      e3geom_trimesh_ray_candidates : Find the triangles a world ray may hit.
+//-----------------------------------------------------------------------------
+static bool
+e3geom_trimesh_ray_candidates( TQ3GeometryObject		inNakedTriMesh,
+								const TQ3TriMeshData	*geomData,
+								const TQ3Matrix4x4&		localToWorld,
+								const TQ3Ray3D&			worldRay,
+								float					worldTolerance,
+								E3FastArray<TQ3Uns32>&	outTriangles )
+{
+	TE3BVHRayTest theTest;
+	
+	if (! E3BVH_InitRayTest( localToWorld, worldRay, worldTolerance, theTest ))
+		return false;
+	
+	return E3TriMeshBVH_GetCandidates( inNakedTriMesh, *geomData,
+		E3BVH_RayNodeTest, &theTest, outTriangles );
+}
+
+
+
+
+
 //=============================================================================
 //      e3geom_trimesh_pick_with_ray : TriMesh ray picking method.
 //-----------------------------------------------------------------------------
@@ -1059,8 +1108,9 @@ static TQ3Status
 e3geom_trimesh_pick_with_ray( TQ3ViewObject				theView,
 								TQ3PickObject			thePick,
 								const TQ3Ray3D			*theRay,
+								TQ3GeometryObject		inNakedTriMesh,
 								const TQ3TriMeshData	*geomData )
-{	TQ3Uns32						n, numPoints, v0, v1, v2;
+{	TQ3Uns32						k, n, numPoints, v0, v1, v2;
 	TQ3Boolean						haveUV, cullBackface;
 	TQ3Param2D						hitUV, *resultUV;
 	TQ3BackfacingStyle				backfacingStyle;
@@ -1173,14 +1223,59 @@ e3geom_trimesh_pick_with_ray( TQ3ViewObject				theView,
 	}
 
 
-	// Transform our points from local to world coordinates
-	numPoints   = geomData->numPoints;
+	// Find the triangles the ray may hit. If the TriMesh has a triangle
+	// hierarchy we only need to look at some of them, and only transform
+	// their corners.
+	E3FastArray<TQ3Uns32>	candidates;
+	bool					haveCandidates;
+	
+	if (useTolerance && isWindowPointPick)
+	{
+		TQ3Point2D pickPt;
+		E3WindowPointPick_GetPoint( thePick, &pickPt );
+		
+		TQ3Area toleranceArea;
+		toleranceArea.min.x = pickPt.x - faceTolerance;
+		toleranceArea.min.y = pickPt.y - faceTolerance;
+		toleranceArea.max.x = pickPt.x + faceTolerance;
+		toleranceArea.max.y = pickPt.y + faceTolerance;
+		
+		haveCandidates = e3geom_trimesh_window_candidates( theView, inNakedTriMesh,
+			geomData, toleranceArea, candidates );
+	}
+	else
+	{
+		haveCandidates = e3geom_trimesh_ray_candidates( inNakedTriMesh, geomData,
+			*localToWorld, *theRay, useTolerance ? faceTolerance : 0.0f, candidates );
+	}
+	
+	TQ3Uns32 numToTest = haveCandidates ? candidates.size() : geomData->numTriangles;
+	if (numToTest == 0)
+		return kQ3Success;
+
+
+
+	// Transform our points from local to world coordinates, three per
+	// triangle when we have candidates
+	numPoints = haveCandidates ? 3 * numToTest : geomData->numPoints;
 	worldPoints = (TQ3Point3D *) Q3Memory_Allocate(static_cast<TQ3Uns32>(numPoints * sizeof(TQ3Point3D)));
 	if (worldPoints == nullptr)
 		return(kQ3Failure);
 
-	Q3Point3D_To3DTransformArray(geomData->points,
-								 E3View_State_GetMatrixLocalToWorld(theView),
+	if (haveCandidates)
+	{
+		for (k = 0; k < numToTest; ++k)
+		{
+			const TQ3Uns32* pointIndices = geomData->triangles[ candidates[k] ].pointIndices;
+			
+			worldPoints[3 * k + 0] = geomData->points[ pointIndices[0] ];
+			worldPoints[3 * k + 1] = geomData->points[ pointIndices[1] ];
+			worldPoints[3 * k + 2] = geomData->points[ pointIndices[2] ];
+		}
+	}
+
+	Q3Point3D_To3DTransformArray(haveCandidates ? worldPoints : geomData->points,
+								 localToWorld,
 								 worldPoints,
 								 numPoints,
 								 sizeof(TQ3Point3D),
@@ -1198,15 +1293,25 @@ e3geom_trimesh_pick_with_ray( TQ3ViewObject				theView,
 	//
 	// Note we do not use any vertex/edge tolerances supplied for the pick, since
 	// QD3D's blue book appears to suggest neither are used for triangles.
-	for (n = 0; n < geomData->numTriangles && qd3dStatus == kQ3Success; ++n)
+	for (k = 0; k < numToTest && qd3dStatus == kQ3Success; ++k)
 	{
 		// Grab the vertex indicies
-		v0 = geomData->triangles[n].pointIndices[0];
-		v1 = geomData->triangles[n].pointIndices[1];
-		v2 = geomData->triangles[n].pointIndices[2];
-		Q3_ASSERT(v0 >= 0 && v0 < geomData->numPoints);
-		Q3_ASSERT(v1 >= 0 && v1 < geomData->numPoints);
-		Q3_ASSERT(v2 >= 0 && v2 < geomData->numPoints);
+		n = haveCandidates ? candidates[k] : k;
+		if (haveCandidates)
+		{
+			v0 = 3 * k + 0;
+			v1 = 3 * k + 1;
+			v2 = 3 * k + 2;
+		}
+		else
+		{
+			v0 = geomData->triangles[n].pointIndices[0];
+			v1 = geomData->triangles[n].pointIndices[1];
+			v2 = geomData->triangles[n].pointIndices[2];
+		}
+		Q3_ASSERT(v0 >= 0 && v0 < numPoints);
+		Q3_ASSERT(v1 >= 0 && v1 < numPoints);
+		Q3_ASSERT(v2 >= 0 && v2 < numPoints);
 
 		// For convenience, name the 3 world-space corners of the triangle
 		const TQ3Point3D& p0( worldPoints[v0] );
@@ -1369,38 +1474,77 @@ static TQ3Status
 e3geom_trimesh_pick_with_rect(TQ3ViewObject				theView,
 								TQ3PickObject			thePick,
 								const TQ3Area			*theRect,
+								TQ3GeometryObject		inNakedTriMesh,
 								const TQ3TriMeshData	*geomData)
 {
-	TQ3Uns32			n, numPoints, v0, v1, v2;
+	TQ3Uns32			k, n, numPoints, v0, v1, v2;
 	TQ3Point2D			triVertices[3];
 	TQ3Status			qd3dStatus;
 
 
 
-	// Transform our points from local coordinates to window coordinates
-	numPoints    = geomData->numPoints;
+	// Find the triangles which may touch the rect, if we have a hierarchy
+	E3FastArray<TQ3Uns32>	candidates;
+	bool haveCandidates = e3geom_trimesh_window_candidates( theView, inNakedTriMesh,
+		geomData, *theRect, candidates );
+	
+	TQ3Uns32 numToTest = haveCandidates ? candidates.size() : geomData->numTriangles;
+
+
+
+	// Transform our points from local coordinates to window coordinates,
+	// three per triangle when we have candidates
+	numPoints    = haveCandidates ? 3 * numToTest : geomData->numPoints;
 	if (numPoints == 0)
 	{
 		return kQ3Success;
 	}
 	E3FastArray<TQ3Point2D>	windowPoints( numPoints );
 
-	E3View_TransformArrayLocalToWindow( theView, numPoints, geomData->points, &windowPoints[0] );
+	if (haveCandidates)
+	{
+		E3FastArray<TQ3Point3D>	localPoints( numPoints );
+		
+		for (k = 0; k < numToTest; ++k)
+		{
+			const TQ3Uns32* pointIndices = geomData->triangles[ candidates[k] ].pointIndices;
+			
+			localPoints[3 * k + 0] = geomData->points[ pointIndices[0] ];
+			localPoints[3 * k + 1] = geomData->points[ pointIndices[1] ];
+			localPoints[3 * k + 2] = geomData->points[ pointIndices[2] ];
+		}
+		
+		E3View_TransformArrayLocalToWindow( theView, numPoints, &localPoints[0], &windowPoints[0] );
+	}
+	else
+	{
+		E3View_TransformArrayLocalToWindow( theView, numPoints, geomData->points, &windowPoints[0] );
+	}
 
 
 
 	// See if we fall within the pick
 	qd3dStatus = kQ3Success;
 
-	for (n = 0; n < geomData->numTriangles && qd3dStatus == kQ3Success; n++)
+	for (k = 0; k < numToTest && qd3dStatus == kQ3Success; k++)
 	{
 		// Grab the vertex indices
-		v0 = geomData->triangles[n].pointIndices[0];
-		v1 = geomData->triangles[n].pointIndices[1];
-		v2 = geomData->triangles[n].pointIndices[2];
-		Q3_ASSERT(v0 >= 0 && v0 < geomData->numPoints);
-		Q3_ASSERT(v1 >= 0 && v1 < geomData->numPoints);
-		Q3_ASSERT(v2 >= 0 && v2 < geomData->numPoints);
+		n = haveCandidates ? candidates[k] : k;
+		if (haveCandidates)
+		{
+			v0 = 3 * k + 0;
+			v1 = 3 * k + 1;
+			v2 = 3 * k + 2;
+		}
+		else
+		{
+			v0 = geomData->triangles[n].pointIndices[0];
+			v1 = geomData->triangles[n].pointIndices[1];
+			v2 = geomData->triangles[n].pointIndices[2];
+		}
+		Q3_ASSERT(v0 >= 0 && v0 < numPoints);
+		Q3_ASSERT(v1 >= 0 && v1 < numPoints);
+		Q3_ASSERT(v2 >= 0 && v2 < numPoints);
 
 
 		// Set up the 2D component of the triangle
@@ -1461,7 +1605,8 @@ e3geom_trimesh_pick_screen_bounds(TQ3ViewObject theView, const TQ3TriMeshData *g
 //      e3geom_trimesh_pick_window_point : TriMesh window-point picking method.
 //-----------------------------------------------------------------------------
 static TQ3Status
-e3geom_trimesh_pick_window_point(TQ3ViewObject theView, TQ3PickObject thePick, const TQ3TriMeshData *geomData)
+e3geom_trimesh_pick_window_point(TQ3ViewObject theView, TQ3PickObject thePick,
+								TQ3GeometryObject inNakedTriMesh, const TQ3TriMeshData *geomData)
 {
 	TQ3Status					qd3dStatus;
 	TQ3Ray3D					theRay;
@@ -1471,7 +1616,7 @@ e3geom_trimesh_pick_window_point(TQ3ViewObject theView, TQ3PickObject thePick, c
 	E3View_GetRayThroughPickPoint(theView, &theRay);
 	
 	qd3dStatus = e3geom_trimesh_pick_with_ray( theView, thePick, &theRay,
-			geomData );
+			inNakedTriMesh, geomData );
 
 	return(qd3dStatus);
 }
@@ -1503,7 +1648,8 @@ e3geom_trimesh_record_any_xyz( TQ3ViewObject theView, TQ3PickObject thePick,
 //      e3geom_trimesh_pick_window_rect : TriMesh window-rect picking method.
 //-----------------------------------------------------------------------------
 static TQ3Status
-e3geom_trimesh_pick_window_rect(TQ3ViewObject theView, TQ3PickObject thePick, const TQ3TriMeshData *geomData)
+e3geom_trimesh_pick_window_rect(TQ3ViewObject theView, TQ3PickObject thePick,
+								TQ3GeometryObject inNakedTriMesh, const TQ3TriMeshData *geomData)
 {	TQ3Area						windowBounds;
 	TQ3Status					qd3dStatus = kQ3Success;
 	TQ3WindowRectPickData		pickData;
@@ -1525,7 +1671,8 @@ e3geom_trimesh_pick_window_rect(TQ3ViewObject theView, TQ3PickObject thePick, co
 		e3geom_trimesh_record_any_xyz( theView, thePick, *geomData );
 
 	else if (E3Rect_IntersectRect(&windowBounds, &pickData.rect))
-		qd3dStatus = e3geom_trimesh_pick_with_rect(theView, thePick, &pickData.rect, geomData);
+		qd3dStatus = e3geom_trimesh_pick_with_rect(theView, thePick, &pickData.rect,
+			inNakedTriMesh, geomData);
 
 	return(qd3dStatus);
 }
@@ -1538,7 +1685,8 @@ e3geom_trimesh_pick_window_rect(TQ3ViewObject theView, TQ3PickObject thePick, co
 //      e3geom_trimesh_pick_world_ray : TriMesh world-ray picking method.
 //-----------------------------------------------------------------------------
 static TQ3Status
-e3geom_trimesh_pick_world_ray(TQ3ViewObject theView, TQ3PickObject thePick, const TQ3TriMeshData *geomData)
+e3geom_trimesh_pick_world_ray(TQ3ViewObject theView, TQ3PickObject thePick,
+								TQ3GeometryObject inNakedTriMesh, const TQ3TriMeshData *geomData)
 {
 	TQ3Status					qd3dStatus;
 	TQ3Ray3D					pickRay;
@@ -1551,7 +1699,7 @@ e3geom_trimesh_pick_world_ray(TQ3ViewObject theView, TQ3PickObject thePick, cons
 
 
 	qd3dStatus = e3geom_trimesh_pick_with_ray( theView, thePick,
-			&pickRay, geomData );
+			&pickRay, inNakedTriMesh, geomData );
 
 
 	return(qd3dStatus);
@@ -1571,28 +1719,33 @@ e3geom_trimesh_pick(TQ3ViewObject theView, TQ3ObjectType objectType, TQ3Object t
 	TQ3Status				qd3dStatus;
 	const TQ3TriMeshData	*geomData;
 	TQ3PickObject			thePick;
+	TQ3GeometryObject		nakedTriMesh = nullptr;
 
 
 
-	// Get the geometry data
+	// Get the geometry data. Retained TriMeshes also give us the naked
+	// TriMesh which caches the triangle hierarchy.
 	geomData = e3geom_trimesh_get_geom_data(theObject, objectData);
 	Q3_ASSERT(geomData->bBox.isEmpty == kQ3False);
 
+	if (theObject != nullptr)
+		nakedTriMesh = ((const TQ3TriMeshOuterData *) objectData)->nakedTriMesh;
+
 
 
 	// Handle the pick
 	thePick = E3View_AccessPick(theView);
 	switch (Q3Pick_GetType(thePick)) {
 		case kQ3PickTypeWindowPoint:
-			qd3dStatus = e3geom_trimesh_pick_window_point(theView, thePick, geomData);
+			qd3dStatus = e3geom_trimesh_pick_window_point(theView, thePick, nakedTriMesh, geomData);
 			break;
 
 		case kQ3PickTypeWindowRect:
-			qd3dStatus = e3geom_trimesh_pick_window_rect(theView, thePick, geomData);
+			qd3dStatus = e3geom_trimesh_pick_window_rect(theView, thePick, nakedTriMesh, geomData);
 			break;
 
 		case kQ3PickTypeWorldRay:
-			qd3dStatus = e3geom_trimesh_pick_world_ray(theView, thePick, geomData);
+			qd3dStatus = e3geom_trimesh_pick_world_ray(theView, thePick, nakedTriMesh, geomData);
 			break;
 
 		default:
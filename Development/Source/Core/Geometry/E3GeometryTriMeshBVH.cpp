@@ -0,0 +1,244 @@
+/*  NAME:
+        E3GeometryTriMeshBVH.cpp
+
+    DESCRIPTION:
+        Bounding volume hierarchy used to accelerate TriMesh picking.
+
+    COPYRIGHT:
+        Copyright (c) 2026, Quesa Developers. All rights reserved.
+
+        For the current release of Quesa, please see:
+
+            <https://github.com/jwwalker/Quesa>
+        
+        Redistribution and use in source and binary forms, with or without
+        modification, are permitted provided that the following conditions
+        are met:
+        
+            o Redistributions of source code must retain the above copyright
+              notice, this list of conditions and the following disclaimer.
+        
+            o Redistributions in binary form must reproduce the above
+              copyright notice, this list of conditions and the following
+              disclaimer in the documentation and/or other materials provided
+              with the distribution.
+        
+            o Neither the name of Quesa nor the names of its contributors
+              may be used to endorse or promote products derived from this
+              software without specific prior written permission.
+        
+        THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+        "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+        LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+        A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+        OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+        SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+        TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+        PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+        LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+        NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+        SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+    ___________________________________________________________________________
+*/
+
+
+#include "E3GeometryTriMeshBVH.h"
+
+#include "E3Main.h"
+#include "E3Math.h"
+
+#include <vector>
+#include <new>
+#include <atomic>
+
+
+
+/*
+	DISCUSSION
+	
+	Picking a TriMesh used to test the pick against every triangle, which is
+	far too slow for meshes with millions of triangles.  Instead we keep a
+	bounding volume hierarchy over the triangles, in the local coordinates of
+	the TriMesh, so that a pick only needs to look at the triangles in nodes
+	whose bounds pass the pick's test.
+	
+	The hierarchy is stored as a flat block of memory so it can live in an
+	object property, like the edge cache of the OpenGL renderer:
+	
+		BVHCacheRec
+		TE3BVHNode		nodes[ nodeCount ]
+		TQ3Uns32		triangles[ triangleCount ]
+*/
+
+
+
+//=============================================================================
+//      Internal constants and types
+//-----------------------------------------------------------------------------
+namespace
+{
+	const TQ3ObjectType	kPropertyTypeBVHCache	= Q3_OBJECT_TYPE('t', 'm', 'b', 'v');
+	
+	// Meshes smaller than this are quicker to test triangle by triangle
+	const TQ3Uns32		kMinTrianglesForBVH		= 64;
+	
+	std::atomic<TQ3Uns32>	sMinTrianglesForBVH( kMinTrianglesForBVH );
+	
+	struct BVHCacheRec
+	{
+		TQ3Uns32			editIndex;
+		TQ3Uns32			nodeCount;
+		TQ3Uns32			triangleCount;
+		TQ3Uns32			reserved;
+		// Followed by:
+		// Variable-size array of TE3BVHNode
+		// Variable-size array of TQ3Uns32 triangle indices
+	};
+}
+
+
+
+
+
+//=============================================================================
+//      Internal functions
+//-----------------------------------------------------------------------------
+//      e3trimeshbvh_build : Build the hierarchy for some TriMesh data.
+//-----------------------------------------------------------------------------
+static void
+e3trimeshbvh_build( const TQ3TriMeshData& inData,
+					std::vector<TE3BVHNode>& outNodes,
+					std::vector<TQ3Uns32>& outTriangles )
+{
+	const TQ3Uns32 numTriangles = inData.numTriangles;
+	std::vector<TQ3BoundingBox>	triBounds( numTriangles );
+	
+	for (TQ3Uns32 n = 0; n < numTriangles; ++n)
+	{
+		const TQ3Uns32* indices = inData.triangles[n].pointIndices;
+		
+		E3BoundingBox_SetFromPoints3D( &triBounds[n], &inData.points[ indices[0] ], 1, sizeof(TQ3Point3D) );
+		E3BoundingBox_UnionPoint3D( &triBounds[n], &inData.points[ indices[1] ], &triBounds[n] );
+		E3BoundingBox_UnionPoint3D( &triBounds[n], &inData.points[ indices[2] ], &triBounds[n] );
+	}
+	
+	E3BVH_Build( numTriangles, &triBounds[0], outNodes, outTriangles );
+}
+
+
+
+
+
+//=============================================================================
+//      e3trimeshbvh_access : Get the cached hierarchy, building it if needed.
+//-----------------------------------------------------------------------------
+static const BVHCacheRec*
+e3trimeshbvh_access( TQ3GeometryObject inNakedTriMesh, const TQ3TriMeshData& inData )
+{
+	E3Shared*	theShared = (E3Shared*) inNakedTriMesh;
+	TQ3Uns32	geomEdits = theShared->GetEditIndex();
+	const BVHCacheRec* cacheData = reinterpret_cast<const BVHCacheRec*>(
+		theShared->GetPropertyAddress( kPropertyTypeBVHCache ) );
+	
+	if ( (cacheData != nullptr) && (cacheData->editIndex == geomEdits) &&
+		(cacheData->triangleCount == inData.numTriangles) )
+	{
+		return cacheData;
+	}
+	
+	
+	
+	// Build a new hierarchy, and pack it into a property
+	try
+	{
+		std::vector<TE3BVHNode>	theNodes;
+		std::vector<TQ3Uns32>	theTriangles;
+		
+		e3trimeshbvh_build( inData, theNodes, theTriangles );
+		if (theNodes.empty())
+			return nullptr;
+		
+		TQ3Uns32 propSize = static_cast<TQ3Uns32>( sizeof(BVHCacheRec) +
+			theNodes.size() * sizeof(TE3BVHNode) +
+			theTriangles.size() * sizeof(TQ3Uns32) );
+		E3FastArray<char>	propBuffer( propSize );
+		
+		BVHCacheRec* newCache = reinterpret_cast<BVHCacheRec*>( &propBuffer[0] );
+		newCache->editIndex     = geomEdits;
+		newCache->nodeCount     = static_cast<TQ3Uns32>( theNodes.size() );
+		newCache->triangleCount = inData.numTriangles;
+		newCache->reserved      = 0;
+		E3Memory_Copy( &theNodes[0], &propBuffer[0] + sizeof(BVHCacheRec),
+			static_cast<TQ3Uns32>( theNodes.size() * sizeof(TE3BVHNode) ) );
+		E3Memory_Copy( &theTriangles[0],
+			&propBuffer[0] + sizeof(BVHCacheRec) + theNodes.size() * sizeof(TE3BVHNode),
+			static_cast<TQ3Uns32>( theTriangles.size() * sizeof(TQ3Uns32) ) );
+		
+		
+		// Lock the edit index, so that adding a property won't change it.
+		StLockEditIndex lockIndex( inNakedTriMesh );
+		
+		if (theShared->SetProperty( kPropertyTypeBVHCache, propSize, newCache ) != kQ3Success)
+			return nullptr;
+	}
+	catch (...)
+	{
+		return nullptr;
+	}
+	
+	return reinterpret_cast<const BVHCacheRec*>(
+		theShared->GetPropertyAddress( kPropertyTypeBVHCache ) );
+}
+
+
+
+
+
+//=============================================================================
+//      Public functions
+//-----------------------------------------------------------------------------
+//      E3TriMeshBVH_GetCandidates : Find triangles in nodes passing a test.
+//-----------------------------------------------------------------------------
+bool
+E3TriMeshBVH_GetCandidates( TQ3GeometryObject inNakedTriMesh,
+							const TQ3TriMeshData& inData,
+							TE3BVHNodeTest inNodeTest,
+							void* inUserData,
+							E3FastArray<TQ3Uns32>& outTriangles )
+{
+	outTriangles.clear();
+	
+	if ( (inNakedTriMesh == nullptr) ||
+		(inData.numTriangles < sMinTrianglesForBVH.load( std::memory_order_relaxed )) )
+		return false;
+	
+	const BVHCacheRec* cacheData = e3trimeshbvh_access( inNakedTriMesh, inData );
+	if (cacheData == nullptr)
+		return false;
+	
+	const TE3BVHNode* theNodes = reinterpret_cast<const TE3BVHNode*>(
+		reinterpret_cast<const char*>( cacheData ) + sizeof(BVHCacheRec) );
+	const TQ3Uns32* theTriangles = reinterpret_cast<const TQ3Uns32*>(
+		theNodes + cacheData->nodeCount );
+	
+	E3BVH_GetCandidates( cacheData->nodeCount, theNodes, theTriangles,
+		inNodeTest, inUserData, outTriangles );
+	
+	return true;
+}
+
+
+
+
+
+//=============================================================================
+//      E3TriMeshBVH_SetMinTriangles : Set the smallest TriMesh given a BVH.
+//-----------------------------------------------------------------------------
+TQ3Uns32
+E3TriMeshBVH_SetMinTriangles( TQ3Uns32 inMinTriangles )
+{
+	if (inMinTriangles == 0)
+		inMinTriangles = kMinTrianglesForBVH;
+	
+	return sMinTrianglesForBVH.exchange( inMinTriangles, std::memory_order_relaxed );
+}
@@ -0,0 +1,105 @@
+#pragma once
+/*  NAME:
+        E3GeometryTriMeshBVH.h
+
+    DESCRIPTION:
+        Header file for E3GeometryTriMeshBVH.cpp.
+
+    COPYRIGHT:
+        Copyright (c) 2026, Quesa Developers. All rights reserved.
+
+        For the current release of Quesa, please see:
+
+            <https://github.com/jwwalker/Quesa>
+        
+        Redistribution and use in source and binary forms, with or without
+        modification, are permitted provided that the following conditions
+        are met:
+        
+            o Redistributions of source code must retain the above copyright
+              notice, this list of conditions and the following disclaimer.
+        
+            o Redistributions in binary form must reproduce the above
+              copyright notice, this list of conditions and the following
+              disclaimer in the documentation and/or other materials provided
+              with the distribution.
+        
+            o Neither the name of Quesa nor the names of its contributors
+              may be used to endorse or promote products derived from this
+              software without specific prior written permission.
+        
+        THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+        "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+        LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+        A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+        OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+        SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+        TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+        PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+        LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+        NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+        SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+    ___________________________________________________________________________
+*/
+
+
+
+
+//=============================================================================
+//      Include files
+//-----------------------------------------------------------------------------
+#include "E3Prefix.h"
+#include "E3BVH.h"
+
+
+
+//=============================================================================
+//      Function prototypes
+//-----------------------------------------------------------------------------
+/*!
+	@function	E3TriMeshBVH_GetCandidates
+	
+	@abstract	Find the triangles of a TriMesh whose bounds pass a node test.
+	
+	@discussion	A bounding volume hierarchy over the triangles is built the first
+				time it is needed and cached in a property of the naked TriMesh,
+				along with the edit index it was built for.  Editing the TriMesh
+				changes its edit index, so a stale hierarchy is rebuilt on the
+				next request.
+				
+				TriMeshes with too few triangles to benefit are not given a
+				hierarchy, and the function returns false so the caller can test
+				every triangle directly.
+				
+				The node bounds are in the local coordinates of the TriMesh, and
+				the candidate triangle indices are returned in increasing order.
+	
+	@param		inNakedTriMesh		The naked TriMesh owning inData.
+	@param		inData				The TriMesh data.
+	@param		inNodeTest			Test applied to each node's bounds.
+	@param		inUserData			Data passed to inNodeTest.
+	@param		outTriangles		Receives the candidate triangle indices.
+	@result		True if the hierarchy was used, false if the caller should
+				fall back to testing every triangle.
+*/
+bool E3TriMeshBVH_GetCandidates( TQ3GeometryObject inNakedTriMesh,
+								const TQ3TriMeshData& inData,
+								TE3BVHNodeTest inNodeTest,
+								void* inUserData,
+								E3FastArray<TQ3Uns32>& outTriangles );
+
+
+/*!
+	@function	E3TriMeshBVH_SetMinTriangles
+	
+	@abstract	Set the number of triangles a TriMesh needs to be given a
+				hierarchy.
+	
+	@discussion	Smaller TriMeshes are picked by testing every triangle.  Tests
+				pass 0xFFFFFFFF to compare the hierarchy with that, and 0 to
+				restore the default of 64.
+	
+	@param		inMinTriangles		The new minimum, or 0 for the default.
+	@result		The previous minimum.
+*/
+TQ3Uns32 E3TriMeshBVH_SetMinTriangles( TQ3Uns32 inMinTriangles );
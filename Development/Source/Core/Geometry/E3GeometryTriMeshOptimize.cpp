@@ -46,6 +46,9 @@
 #include "E3Utils.h"
 #include "E3Set.h"
 #include "E3ClassTree.h"
+#include "E3Group.h"
+#include "E3Parallel.h"
+#include "OptimizedTriMeshElement.h"
 #include "QuesaMath.h"
 
 #include <vector>
@@ -88,12 +91,23 @@
 	necessary, and which could not be accelerated using triangle strips.  Thus,
 	when two instances refer to the same point, we must treat them as the same
 	vertex unless there is a specific reason not to, such as a color conflict.
+	
+	The stages which look at each face, instance or vertex on its own, such as
+	computing face normals, finding a similar earlier instance, and filling in
+	the new arrays, are split across threads with E3Parallel_For.  All memory
+	is allocated and all Quesa objects are touched on the calling thread, except
+	when E3TriMesh_OptimizeHierarchy optimizes several small TriMeshes at once,
+	each on its own thread.  Those only allocate memory and take references to
+	surface shaders, which is safe from any thread.
 */
 
 namespace
 {
 	const float		kDegenerateLengthSquared	= 1.0e-12f;
 	
+	// Smallest number of faces, instances or vertices worth giving to a thread
+	const TQ3Uns32	kMinPerTask					= 4096;
+	
 	typedef	std::vector< TQ3Vector3D >	VecVec;
 	
 	typedef std::vector< TQ3Int32 >		IntVec;
@@ -132,8 +146,8 @@ namespace
 		void					EnsureFaceNormals();
 		void					MakeInstanceToPoint();
 		void					FindBackLinks();
-		bool					AreInstancesSimilar( TQ3Int32 inPt1, TQ3Int32 inPt2 );
-		TQ3Int32				FindPrevSimilarInstance( TQ3Int32 inPtInstanceIndex );
+		bool					AreInstancesSimilar( TQ3Int32 inPt1, TQ3Int32 inPt2 ) const;
+		TQ3Int32				FindPrevSimilarInstance( TQ3Int32 inPtInstanceIndex ) const;
 		void					FindDistinctVertices();
 		void					BuildNewTriMesh();
 		void					BuildFaces();
@@ -254,20 +268,26 @@ void	TriMeshOptimizer::MakeInstanceToPoint()
 {
 	mInstanceToPoint.reserve( mOrigData.numTriangles * 3 +
 		mOrigData.numEdges * 2 + mOrigData.numPoints );
+	mInstanceToPoint.resize( mOrigData.numTriangles * 3 + mOrigData.numEdges * 2 );
 	
 	TQ3Uns32 i;
 	
-	for (i = 0; i < mOrigData.numTriangles; ++i)
-	{
-		mInstanceToPoint.push_back( mOrigData.triangles[i].pointIndices[0] );
-		mInstanceToPoint.push_back( mOrigData.triangles[i].pointIndices[1] );
-		mInstanceToPoint.push_back( mOrigData.triangles[i].pointIndices[2] );
-	}
+	E3Parallel_For( mOrigData.numTriangles, kMinPerTask,
+		[this]( TQ3Uns32 inStart, TQ3Uns32 inEnd )
+		{
+			for (TQ3Uns32 j = inStart; j < inEnd; ++j)
+			{
+				mInstanceToPoint[ 3 * j ] = mOrigData.triangles[j].pointIndices[0];
+				mInstanceToPoint[ 3 * j + 1 ] = mOrigData.triangles[j].pointIndices[1];
+				mInstanceToPoint[ 3 * j + 2 ] = mOrigData.triangles[j].pointIndices[2];
+			}
+		} );
 	
+	TQ3Uns32	instanceIndex = mOrigData.numTriangles * 3;
 	for (i = 0; i < mOrigData.numEdges; ++i)
 	{
-		mInstanceToPoint.push_back( mOrigData.edges[i].pointIndices[0] );
-		mInstanceToPoint.push_back( mOrigData.edges[i].pointIndices[1] );
+		mInstanceToPoint[ instanceIndex++ ] = mOrigData.edges[i].pointIndices[0];
+		mInstanceToPoint[ instanceIndex++ ] = mOrigData.edges[i].pointIndices[1];
 	}
 	
 	// Let us only include instances points that do not occur in faces or edges.
@@ -455,7 +475,7 @@ static bool IsSameColor( const TQ3ColorRGB& inOne, const TQ3ColorRGB& inTwo )
 				indices into mInstanceToPoint) should be treated as the same
 				vertex.
 */
-bool	TriMeshOptimizer::AreInstancesSimilar( TQ3Int32 inPt1, TQ3Int32 inPt2 )
+bool	TriMeshOptimizer::AreInstancesSimilar( TQ3Int32 inPt1, TQ3Int32 inPt2 ) const
 {
 	Q3_ASSERT( mInstanceToPoint[ inPt1 ] == mInstanceToPoint[ inPt2 ] );
 	bool	isSame = true;
@@ -513,7 +533,7 @@ bool	TriMeshOptimizer::AreInstancesSimilar( TQ3Int32 inPt1, TQ3Int32 inPt2 )
 				previous instance of the same point that can be considered to
 				be the same vertex.
 */
-TQ3Int32	TriMeshOptimizer::FindPrevSimilarInstance( TQ3Int32 inPtInstanceIndex )
+TQ3Int32	TriMeshOptimizer::FindPrevSimilarInstance( TQ3Int32 inPtInstanceIndex ) const
 {
 	TQ3Int32	prevSimilarIndex = -1;
 	TQ3Int32	prevIndex;
@@ -562,16 +582,30 @@ TQ3Int32	TriMeshOptimizer::FindPrevSimilarInstance( TQ3Int32 inPtInstanceIndex )
 				
 				(3) mVertexToOwner[ mInstanceToVertex[i] ] == GetOwnerOfInstance(i)
 				for each i
+				
+				Finding the previous similar instance is the costly part, and
+				each instance can be looked at on its own, so we do that first
+				in parallel.  Numbering the vertices must then be done in order.
 */
 void	TriMeshOptimizer::FindDistinctVertices()
 {
 	const TQ3Int32	kNumInstances = static_cast<TQ3Int32>(mInstanceToPoint.size());
 	mInstanceToVertex.resize( kNumInstances );
 	TQ3Int32	i;
+	
+	E3Parallel_For( kNumInstances, kMinPerTask,
+		[this]( TQ3Uns32 inStart, TQ3Uns32 inEnd )
+		{
+			for (TQ3Uns32 j = inStart; j < inEnd; ++j)
+			{
+				mInstanceToVertex[j] = FindPrevSimilarInstance( j );
+			}
+		} );
 
 	for (i = 0; i < kNumInstances; ++i)
 	{
-		TQ3Int32	prevSimilar = FindPrevSimilarInstance( i );
+		// Earlier instances have been given their vertices by now
+		TQ3Int32	prevSimilar = mInstanceToVertex[i];
 		if (prevSimilar < 0)
 		{
 			// New vertex
@@ -615,12 +649,16 @@ void	TriMeshOptimizer::BuildFaces()
 			sizeof(TQ3TriMeshTriangleData) ) );
 	EQ3ThrowIfMemFail_( mResultData.triangles );
 	
-	for (TQ3Uns32 i = 0; i < mResultData.numTriangles; ++i)
-	{
-		mResultData.triangles[i].pointIndices[0] = mInstanceToVertex[ 3 * i ];
-		mResultData.triangles[i].pointIndices[1] = mInstanceToVertex[ 3 * i + 1 ];
-		mResultData.triangles[i].pointIndices[2] = mInstanceToVertex[ 3 * i + 2 ];
-	}
+	E3Parallel_For( mResultData.numTriangles, kMinPerTask,
+		[this]( TQ3Uns32 inStart, TQ3Uns32 inEnd )
+		{
+			for (TQ3Uns32 i = inStart; i < inEnd; ++i)
+			{
+				mResultData.triangles[i].pointIndices[0] = mInstanceToVertex[ 3 * i ];
+				mResultData.triangles[i].pointIndices[1] = mInstanceToVertex[ 3 * i + 1 ];
+				mResultData.triangles[i].pointIndices[2] = mInstanceToVertex[ 3 * i + 2 ];
+			}
+		} );
 }
 
 static TQ3Uns32	GetAttributeSize( TQ3AttributeType inAttType )
@@ -779,10 +817,14 @@ void	TriMeshOptimizer::BuildPoints()
 			E3Memory_AllocateClear( mResultData.numPoints * sizeof(TQ3Point3D) ) );
 		EQ3ThrowIfMemFail_( mResultData.points );
 		
-		for (TQ3Uns32 i = 0; i < mResultData.numPoints; ++i)
-		{
-			mResultData.points[i] = mOrigData.points[ mVertexToPoint[i] ];
-		}
+		E3Parallel_For( mResultData.numPoints, kMinPerTask,
+			[this]( TQ3Uns32 inStart, TQ3Uns32 inEnd )
+			{
+				for (TQ3Uns32 i = inStart; i < inEnd; ++i)
+				{
+					mResultData.points[i] = mOrigData.points[ mVertexToPoint[i] ];
+				}
+			} );
 	}
 }
 
@@ -839,11 +881,15 @@ void	TriMeshOptimizer::BuildVertexAttributes()
 			srcData = static_cast<char*>( mOrigData.vertexAttributeTypes[i].data );
 			dstData = static_cast<char*>( mResultData.vertexAttributeTypes[i].data );
 			
-			for (j = 0; j < mResultData.numPoints; ++j)
-			{
-				E3Memory_Copy( srcData + mVertexToPoint[j] * attrSize,
-					dstData + j * attrSize, attrSize );
-			}
+			E3Parallel_For( mResultData.numPoints, kMinPerTask,
+				[&]( TQ3Uns32 inStart, TQ3Uns32 inEnd )
+				{
+					for (TQ3Uns32 k = inStart; k < inEnd; ++k)
+					{
+						E3Memory_Copy( srcData + mVertexToPoint[k] * attrSize,
+							dstData + k * attrSize, attrSize );
+					}
+				} );
 			
 			if (mOrigData.vertexAttributeTypes[i].attributeUseArray != nullptr)
 			{
@@ -869,10 +915,14 @@ void	TriMeshOptimizer::BuildVertexAttributes()
 		EQ3ThrowIfMemFail_( vertNormals );
 		mResultData.vertexAttributeTypes[i].data = vertNormals;
 		
-		for (j = 0; j < mResultData.numPoints; ++j)
-		{
-			vertNormals[j] = GetNormalFromOwner( mVertexToOwner[j] );
-		}
+		E3Parallel_For( mResultData.numPoints, kMinPerTask,
+			[&]( TQ3Uns32 inStart, TQ3Uns32 inEnd )
+			{
+				for (TQ3Uns32 k = inStart; k < inEnd; ++k)
+				{
+					vertNormals[k] = GetNormalFromOwner( mVertexToOwner[k] );
+				}
+			} );
 		++i;
 	}
 	
@@ -884,10 +934,14 @@ void	TriMeshOptimizer::BuildVertexAttributes()
 		EQ3ThrowIfMemFail_( vertColors );
 		mResultData.vertexAttributeTypes[i].data = vertColors;
 		
-		for (j = 0; j < mResultData.numPoints; ++j)
-		{
-			vertColors[j] = GetDiffColorFromOwner( mVertexToOwner[j] );
-		}
+		E3Parallel_For( mResultData.numPoints, kMinPerTask,
+			[&]( TQ3Uns32 inStart, TQ3Uns32 inEnd )
+			{
+				for (TQ3Uns32 k = inStart; k < inEnd; ++k)
+				{
+					vertColors[k] = GetDiffColorFromOwner( mVertexToOwner[k] );
+				}
+			} );
 		++i;
 	}
 	
@@ -899,10 +953,14 @@ void	TriMeshOptimizer::BuildVertexAttributes()
 		EQ3ThrowIfMemFail_( vertTrans );
 		mResultData.vertexAttributeTypes[i].data = vertTrans;
 		
-		for (j = 0; j < mResultData.numPoints; ++j)
-		{
-			vertTrans[j] = GetTransColorFromOwner( mVertexToOwner[j] );
-		}
+		E3Parallel_For( mResultData.numPoints, kMinPerTask,
+			[&]( TQ3Uns32 inStart, TQ3Uns32 inEnd )
+			{
+				for (TQ3Uns32 k = inStart; k < inEnd; ++k)
+				{
+					vertTrans[k] = GetTransColorFromOwner( mVertexToOwner[k] );
+				}
+			} );
 		++i;
 	}
 	
@@ -914,10 +972,14 @@ void	TriMeshOptimizer::BuildVertexAttributes()
 		EQ3ThrowIfMemFail_( vertSpecs );
 		mResultData.vertexAttributeTypes[i].data = vertSpecs;
 		
-		for (j = 0; j < mResultData.numPoints; ++j)
-		{
-			vertSpecs[j] = GetSpecColorFromOwner( mVertexToOwner[j] );
-		}
+		E3Parallel_For( mResultData.numPoints, kMinPerTask,
+			[&]( TQ3Uns32 inStart, TQ3Uns32 inEnd )
+			{
+				for (TQ3Uns32 k = inStart; k < inEnd; ++k)
+				{
+					vertSpecs[k] = GetSpecColorFromOwner( mVertexToOwner[k] );
+				}
+			} );
 		++i;
 	}
 }
@@ -940,34 +1002,35 @@ void	TriMeshOptimizer::EnsureFaceNormals()
 	{
 		mComputedFaceNormals.resize( mOrigData.numTriangles );
 		
-		TQ3Vector3D	theNormal;
-		TQ3Uns32	i;
-		
-		for (i = 0; i < mOrigData.numTriangles; ++i)
-		{
-			typedef TQ3TriMeshTriangleData&	TQ3TriMeshTriangleDataRef; // limited VC++ 6.0
-
-			TQ3TriMeshTriangleDataRef	aFace( mOrigData.triangles[i] );
-
-			Q3FastPoint3D_CrossProductTri(
-				&mOrigData.points[ aFace.pointIndices[0] ],
-				&mOrigData.points[ aFace.pointIndices[1] ],
-				&mOrigData.points[ aFace.pointIndices[2] ],
-				&theNormal );
-			float	lenSq = Q3FastVector3D_LengthSquared( &theNormal );
-			
-			if (lenSq < kDegenerateLengthSquared)
-			{
-				theNormal.x = 1.0f;
-				theNormal.y = theNormal.z = 0.0f;
-			}
-			else
+		E3Parallel_For( mOrigData.numTriangles, kMinPerTask,
+			[this]( TQ3Uns32 inStart, TQ3Uns32 inEnd )
 			{
-				float	len = sqrtf( lenSq );
-				Q3FastVector3D_Scale( &theNormal, 1.0f/len, &theNormal );
-			}
-			mComputedFaceNormals[i] = theNormal;
-		}
+				TQ3Vector3D	theNormal;
+				
+				for (TQ3Uns32 i = inStart; i < inEnd; ++i)
+				{
+					const TQ3TriMeshTriangleData&	aFace( mOrigData.triangles[i] );
+					
+					Q3FastPoint3D_CrossProductTri(
+						&mOrigData.points[ aFace.pointIndices[0] ],
+						&mOrigData.points[ aFace.pointIndices[1] ],
+						&mOrigData.points[ aFace.pointIndices[2] ],
+						&theNormal );
+					float	lenSq = Q3FastVector3D_LengthSquared( &theNormal );
+					
+					if (lenSq < kDegenerateLengthSquared)
+					{
+						theNormal.x = 1.0f;
+						theNormal.y = theNormal.z = 0.0f;
+					}
+					else
+					{
+						float	len = sqrtf( lenSq );
+						Q3FastVector3D_Scale( &theNormal, 1.0f/len, &theNormal );
+					}
+					mComputedFaceNormals[i] = theNormal;
+				}
+			} );
 		mResultFaceNormals = &mComputedFaceNormals[0];
 	}
 	else
@@ -1165,3 +1228,169 @@ TQ3GeometryObject E3TriMesh_Optimize( TQ3GeometryObject inTriMesh )
 	
 	return theResult;
 }
+
+
+/*!
+	@function	e3trimesh_find_stale
+	
+	@abstract	Find each TriMesh in a hierarchy without an up to date cached
+				optimization.
+*/
+static void e3trimesh_find_stale( TQ3Object inObject,
+								std::vector<TQ3GeometryObject>& ioTriMeshes )
+{
+	if (Q3Object_IsType( inObject, kQ3GeometryTypeTriMesh ))
+	{
+		bool	wasValid = false;
+		CQ3ObjectRef	cachedGeom( GetCachedOptimizedTriMesh( inObject, wasValid ) );
+		
+		if (! wasValid)
+			ioTriMeshes.push_back( inObject );
+	}
+	else if (Q3Object_IsType( inObject, kQ3ShapeTypeGroup ))
+	{
+		E3Group*			theGroup = (E3Group*) inObject;
+		TQ3GroupPosition	thePosition = nullptr;
+		
+		theGroup->GetFirstPosition( &thePosition );
+		while (thePosition != nullptr)
+		{
+			e3trimesh_find_stale( ( (TQ3XGroupPosition*) thePosition )->object,
+				ioTriMeshes );
+			
+			theGroup->GetNextPosition( &thePosition );
+		}
+	}
+}
+
+
+/*!
+	@function	E3TriMesh_OptimizeHierarchy
+	
+	@abstract	Optimize each TriMesh in a hierarchy ahead of time, for the
+				interactive renderer.
+	
+	@discussion	Each TriMesh in the object, which may be a group, is optimized
+				as by E3TriMesh_Optimize, and the result is cached on the
+				TriMesh where the interactive renderer looks for it, so that
+				the first frame need not do the work.  TriMeshes with an up to
+				date cached result are skipped.
+				
+				The data of small TriMeshes is optimized across threads, one
+				TriMesh per task.  Large TriMeshes are optimized one after
+				another, with the work on each split across threads.  Locking
+				the data, creating the new TriMeshes and updating the caches
+				are done on the calling thread.
+	
+	@param		inObject		A TriMesh, a group, or another object.
+	@result		Success or failure of the operation.
+*/
+TQ3Status E3TriMesh_OptimizeHierarchy( TQ3Object inObject )
+{
+	// Smallest number of triangles worth splitting a TriMesh across threads
+	const TQ3Uns32	kMinTrianglesToSplit = 4 * kMinPerTask;
+	
+	struct StaleTriMesh
+	{
+		TQ3GeometryObject	mTriMesh;
+		TQ3TriMeshData*		mOrigData;
+		TQ3TriMeshData		mOptData;
+		TQ3Boolean			mDidChange;
+		TQ3Status			mStatus;
+	};
+	
+	
+	
+	// Find the TriMeshes to optimize, once each, and lock their data
+	std::vector<TQ3GeometryObject>	theTriMeshes;
+	std::vector<StaleTriMesh>		theStale;
+	std::vector<TQ3Uns32>			smallIndices, largeIndices;
+	
+	try
+	{
+		e3trimesh_find_stale( inObject, theTriMeshes );
+		
+		std::sort( theTriMeshes.begin(), theTriMeshes.end() );
+		theTriMeshes.erase( std::unique( theTriMeshes.begin(), theTriMeshes.end() ),
+			theTriMeshes.end() );
+		
+		theStale.reserve( theTriMeshes.size() );
+		smallIndices.reserve( theTriMeshes.size() );
+		largeIndices.reserve( theTriMeshes.size() );
+	}
+	catch (...)
+	{
+		return kQ3Failure;
+	}
+	
+	for (TQ3GeometryObject theTriMesh : theTriMeshes)
+	{
+		StaleTriMesh	theItem;
+		E3Memory_Clear( &theItem, sizeof(theItem) );
+		theItem.mTriMesh = theTriMesh;
+		
+		if (kQ3Success == Q3TriMesh_LockData( theTriMesh, kQ3True, &theItem.mOrigData ))
+		{
+			if (theItem.mOrigData->numTriangles < kMinTrianglesToSplit)
+				smallIndices.push_back( static_cast<TQ3Uns32>( theStale.size() ) );
+			else
+				largeIndices.push_back( static_cast<TQ3Uns32>( theStale.size() ) );
+			
+			theStale.push_back( theItem );
+		}
+	}
+	
+	
+	
+	// Optimize the data
+	E3Parallel_For( static_cast<TQ3Uns32>( smallIndices.size() ), 1,
+		[&]( TQ3Uns32 inStart, TQ3Uns32 inEnd )
+		{
+			for (TQ3Uns32 i = inStart; i < inEnd; ++i)
+			{
+				StaleTriMesh&	theItem( theStale[ smallIndices[i] ] );
+				
+				theItem.mStatus = E3TriMesh_OptimizeData( *theItem.mOrigData,
+					theItem.mOptData, theItem.mDidChange );
+			}
+		} );
+	
+	for (TQ3Uns32 theIndex : largeIndices)
+	{
+		StaleTriMesh&	theItem( theStale[ theIndex ] );
+		
+		theItem.mStatus = E3TriMesh_OptimizeData( *theItem.mOrigData,
+			theItem.mOptData, theItem.mDidChange );
+	}
+	
+	
+	
+	// Cache the results.  A nullptr result records that the TriMesh needs no
+	// optimization.
+	TQ3Status	theStatus = kQ3Success;
+	
+	for (StaleTriMesh& theItem : theStale)
+	{
+		if (theItem.mStatus == kQ3Success)
+		{
+			CQ3ObjectRef	optGeom;
+			
+			if (theItem.mDidChange == kQ3True)
+			{
+				optGeom = CQ3ObjectRef( Q3TriMesh_New( &theItem.mOptData ) );
+				
+				Q3TriMesh_EmptyData( &theItem.mOptData );
+			}
+			
+			SetCachedOptimizedTriMesh( theItem.mTriMesh, optGeom.get() );
+		}
+		else
+		{
+			theStatus = kQ3Failure;
+		}
+		
+		Q3TriMesh_UnlockData( theItem.mTriMesh );
+	}
+	
+	return theStatus;
+}
@@ -111,3 +111,19 @@ TQ3Status E3TriMesh_OptimizeData( const TQ3TriMeshData& inData,
 	@result		A TriMesh or nullptr.
 */
 TQ3GeometryObject E3TriMesh_Optimize( TQ3GeometryObject inTriMesh );
+
+
+/*!
+	@function	E3TriMesh_OptimizeHierarchy
+	
+	@abstract	Optimize each TriMesh in a hierarchy ahead of time, for the
+				interactive renderer.
+	
+	@discussion	Each TriMesh in the object, which may be a group, is optimized
+				as by E3TriMesh_Optimize, and the result is cached on the
+				TriMesh where the interactive renderer looks for it.
+	
+	@param		inObject		A TriMesh, a group, or another object.
+	@result		Success or failure of the operation.
+*/
+TQ3Status E3TriMesh_OptimizeHierarchy( TQ3Object inObject );
@@ -320,6 +320,35 @@ Q3XObjectHierarchy_FindClassByType(TQ3ObjectType theType)
 
 
 
+//=============================================================================
+//      Q3XObjectHierarchy_GetDynamicLookupCount : Quesa API entry point.
+//-----------------------------------------------------------------------------
+TQ3Uns32
+Q3XObjectHierarchy_GetDynamicLookupCount(TQ3Boolean inReset)
+{
+
+
+	// Release build checks
+
+
+
+	// Debug build checks
+
+
+
+	// Call the bottleneck
+	E3System_Bottleneck();
+
+
+
+	// Call our implementation
+	return(E3XObjectHierarchy_GetDynamicLookupCount(inReset));
+}
+
+
+
+
+
 //=============================================================================
 //      Q3XObjectClass_GetPrivate : Quesa API entry point.
 //-----------------------------------------------------------------------------
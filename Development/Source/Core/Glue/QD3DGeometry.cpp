@@ -70,6 +70,7 @@
 #include "E3GeometryTriMeshOptimize.h"
 #include "E3View.h"
 #include "MakeStrip.h"
+#include "VertexCacheOptimizer.h"
 
 
 
@@ -269,6 +270,67 @@ Q3Geometry_GetDecomposed(TQ3GeometryObject geometry, TQ3ViewObject view)
 
 
 
+//=============================================================================
+//      Q3Geometry_GetCacheStatistics : Quesa API entry point.
+//-----------------------------------------------------------------------------
+#if QUESA_ALLOW_QD3D_EXTENSIONS
+TQ3Status
+Q3Geometry_GetCacheStatistics(TQ3GeometryCacheStatistics *statistics)
+{
+
+
+	// Release build checks
+	Q3_REQUIRE_OR_RESULT(Q3_VALID_PTR(statistics), kQ3Failure);
+
+
+
+	// Debug build checks
+
+
+
+	// Call the bottleneck
+	E3System_Bottleneck();
+
+
+
+	// Call our implementation
+	return(E3Geometry_GetCacheStatistics(statistics));
+}
+
+
+
+
+
+//=============================================================================
+//      Q3Geometry_SetCacheMemoryLimit : Quesa API entry point.
+//-----------------------------------------------------------------------------
+TQ3Status
+Q3Geometry_SetCacheMemoryLimit(TQ3Uns32 memoryLimit)
+{
+
+
+	// Release build checks
+
+
+
+	// Debug build checks
+
+
+
+	// Call the bottleneck
+	E3System_Bottleneck();
+
+
+
+	// Call our implementation
+	return(E3Geometry_SetCacheMemoryLimit(memoryLimit));
+}
+#endif // QUESA_ALLOW_QD3D_EXTENSIONS
+
+
+
+
+
 //=============================================================================
 //      Q3Box_New : Quesa API entry point.
 //-----------------------------------------------------------------------------
@@ -10385,6 +10447,28 @@ TQ3GeometryObject Q3TriMesh_Optimize( TQ3GeometryObject inTriMesh )
 
 
 
+//=============================================================================
+//      Q3TriMesh_OptimizeHierarchy : Quesa API entry point.
+//-----------------------------------------------------------------------------
+TQ3Status Q3TriMesh_OptimizeHierarchy( TQ3Object inObject )
+{
+	Q3_REQUIRE_OR_RESULT( E3Shared_IsOfMyClass ( inObject ), kQ3Failure);
+	
+	
+	
+	// Call the bottleneck
+	E3System_Bottleneck();
+
+
+
+	// Call our implementation
+	return E3TriMesh_OptimizeHierarchy( inObject );
+}
+
+
+
+
+
 //=============================================================================
 //      Q3TriMesh_MakeTriangleStrip : Quesa API entry point.
 //-----------------------------------------------------------------------------
@@ -10460,6 +10544,138 @@ Q3TriMesh_MakeTriangleStrip(
 }
 
 
+
+
+//=============================================================================
+//      e3trimesh_are_point_indices_valid : Check point indices.
+//-----------------------------------------------------------------------------
+static TQ3Boolean
+e3trimesh_are_point_indices_valid( TQ3Uns32 inNumIndices,
+									const TQ3Uns32* inIndices,
+									TQ3Uns32 inNumPoints )
+{
+	for (TQ3Uns32 i = 0; i < inNumIndices; ++i)
+	{
+		if (inIndices[i] >= inNumPoints)
+		{
+			E3ErrorManager_PostError( kQ3ErrorTriMeshPointIndexOutOfRange, kQ3False );
+			return kQ3False;
+		}
+	}
+	
+	return kQ3True;
+}
+
+
+
+
+
+//=============================================================================
+//      Q3TriMesh_OptimizeTriangleOrder : Quesa API entry point.
+//-----------------------------------------------------------------------------
+TQ3Status
+Q3TriMesh_OptimizeTriangleOrder(
+	TQ3Uns32 inNumTriangles,
+	const TQ3Uns32* inTriangles,
+	TQ3Uns32 inNumPoints,
+	TQ3Uns32* outTriangles
+)
+{
+	Q3_REQUIRE_OR_RESULT(Q3_VALID_PTR(inTriangles), kQ3Failure);
+	Q3_REQUIRE_OR_RESULT(Q3_VALID_PTR(outTriangles), kQ3Failure);
+	
+	if (! e3trimesh_are_point_indices_valid( 3 * inNumTriangles, inTriangles,
+		inNumPoints ))
+	{
+		return kQ3Failure;
+	}
+	
+	
+	
+	// Call the bottleneck
+	E3System_Bottleneck();
+
+
+
+	// Call our implementation
+	TQ3Status	theStatus = kQ3Success;
+	try
+	{
+		std::vector<TQ3Uns32>	theFaces;
+		OptimizeTriangleOrder( inNumTriangles, inTriangles, inNumPoints,
+			theFaces );
+		if (! theFaces.empty())
+		{
+			Q3Memory_Copy( &theFaces[0], outTriangles,
+				static_cast<TQ3Uns32>(theFaces.size() * sizeof(TQ3Uns32)) );
+		}
+	}
+	catch (...)
+	{
+		E3ErrorManager_PostError( kQ3ErrorOutOfMemory, kQ3False );
+		theStatus = kQ3Failure;
+	}
+	
+	return theStatus;
+}
+
+
+
+
+
+//=============================================================================
+//      Q3TriMesh_SimulateVertexCache : Quesa API entry point.
+//-----------------------------------------------------------------------------
+TQ3Status
+Q3TriMesh_SimulateVertexCache(
+	TQ3Uns32 inNumTriangles,
+	const TQ3Uns32* inTriangles,
+	TQ3Uns32 inNumPoints,
+	TQ3Uns32 inCacheSize,
+	float* outACMR,
+	float* outATVR
+)
+{
+	Q3_REQUIRE_OR_RESULT(Q3_VALID_PTR(inTriangles), kQ3Failure);
+	Q3_REQUIRE_OR_RESULT(Q3_VALID_PTR(outACMR), kQ3Failure);
+	Q3_REQUIRE_OR_RESULT(Q3_VALID_PTR(outATVR), kQ3Failure);
+	
+	if (inCacheSize == 0)
+	{
+		E3ErrorManager_PostError( kQ3ErrorParameterOutOfRange, kQ3False );
+		return kQ3Failure;
+	}
+	
+	if (! e3trimesh_are_point_indices_valid( 3 * inNumTriangles, inTriangles,
+		inNumPoints ))
+	{
+		return kQ3Failure;
+	}
+	
+	
+	
+	// Call the bottleneck
+	E3System_Bottleneck();
+
+
+
+	// Call our implementation
+	TQ3Status	theStatus = kQ3Success;
+	try
+	{
+		SimulateVertexCache( inNumTriangles, inTriangles, inNumPoints,
+			inCacheSize, *outACMR, *outATVR );
+	}
+	catch (...)
+	{
+		E3ErrorManager_PostError( kQ3ErrorOutOfMemory, kQ3False );
+		theStatus = kQ3Failure;
+	}
+	
+	return theStatus;
+}
+
+
 /*!
 	@function	Q3TriMesh_GetNakedGeometry
 	@abstract	Get a reference to the unattributed geometry owned by a TriMesh.
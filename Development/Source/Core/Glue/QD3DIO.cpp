@@ -890,6 +890,67 @@ Q3File_GetReadInGroup(TQ3FileObject theFile, TQ3FileReadGroupState *readGroupSta
 
 
 
+//=============================================================================
+//      Q3File_SetReadInParallel : Quesa API entry point.
+//-----------------------------------------------------------------------------
+TQ3Status
+Q3File_SetReadInParallel(TQ3FileObject theFile, TQ3Boolean readInParallel)
+{
+
+
+	// Release build checks
+	Q3_REQUIRE_OR_RESULT(Q3Object_IsType(theFile, (kQ3SharedTypeFile)), kQ3Failure);
+
+
+
+	// Debug build checks
+
+
+
+	// Call the bottleneck
+	E3System_Bottleneck();
+
+
+
+	// Call our implementation
+	return ( (E3File*) theFile )->SetReadInParallel ( readInParallel ) ;
+}
+
+
+
+
+
+//=============================================================================
+//      Q3File_GetReadInParallel : Quesa API entry point.
+//-----------------------------------------------------------------------------
+TQ3Status
+Q3File_GetReadInParallel(TQ3FileObject theFile, TQ3Boolean *readInParallel)
+{
+
+
+	// Release build checks
+	Q3_REQUIRE_OR_RESULT(Q3Object_IsType(theFile, (kQ3SharedTypeFile)), kQ3Failure);
+	Q3_REQUIRE_OR_RESULT(Q3_VALID_PTR(readInParallel), kQ3Failure);
+
+
+
+	// Debug build checks
+
+
+
+	// Call the bottleneck
+	E3System_Bottleneck();
+
+
+
+	// Call our implementation
+	return ( (E3File*) theFile )->GetReadInParallel ( readInParallel ) ;
+}
+
+
+
+
+
 //=============================================================================
 //      Q3File_SetIdleMethod : Quesa API entry point.
 //-----------------------------------------------------------------------------
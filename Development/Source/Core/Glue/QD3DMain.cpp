@@ -210,6 +210,65 @@ Q3GetReleaseVersion(TQ3Uns32 *releaseRevision)
 
 
 
+//=============================================================================
+//      Q3SetThreadCount : Quesa API entry point.
+//-----------------------------------------------------------------------------
+TQ3Status
+Q3SetThreadCount(TQ3Uns32 threadCount)
+{
+
+
+	// Release build checks
+
+
+
+	// Debug build checks
+
+
+
+	// Call the bottleneck
+	E3System_Bottleneck();
+
+
+
+	// Call our implementation
+	return(E3SetThreadCount(threadCount));
+}
+
+
+
+
+
+//=============================================================================
+//      Q3GetThreadCount : Quesa API entry point.
+//-----------------------------------------------------------------------------
+TQ3Status
+Q3GetThreadCount(TQ3Uns32 *threadCount)
+{
+
+
+	// Release build checks
+	Q3_REQUIRE_OR_RESULT(Q3_VALID_PTR(threadCount), kQ3Failure);
+
+
+
+	// Debug build checks
+
+
+
+	// Call the bottleneck
+	E3System_Bottleneck();
+
+
+
+	// Call our implementation
+	return(E3GetThreadCount(threadCount));
+}
+
+
+
+
+
 //=============================================================================
 //      Q3LogMessage : Quesa API entry point.
 //-----------------------------------------------------------------------------
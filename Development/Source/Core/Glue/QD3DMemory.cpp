@@ -55,11 +55,7 @@
 //      Global Variables
 //-----------------------------------------------------------------------------
 
-#if QUESA_OS_MACINTOSH
-	extern volatile int32_t	gObjectCount;
-#elif QUESA_OS_WIN32
-	extern volatile LONG		gObjectCount;
-#endif
+extern std::atomic<TQ3Int32>	gObjectCount;
 
 
 
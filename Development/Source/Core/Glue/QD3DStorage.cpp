@@ -651,6 +651,38 @@ Q3PathStorage_Get(TQ3StorageObject theStorage, char *pathName)
 
 
 
+//=============================================================================
+//      Q3MappedPathStorage_New : Quesa API entry point.
+//-----------------------------------------------------------------------------
+#if QUESA_ALLOW_QD3D_EXTENSIONS
+TQ3StorageObject
+Q3MappedPathStorage_New(const char *pathName)
+{
+
+
+	// Release build checks
+	Q3_REQUIRE_OR_RESULT(Q3_VALID_PTR(pathName), nullptr);
+
+
+
+	// Debug build checks
+
+
+
+	// Call the bottleneck
+	E3System_Bottleneck();
+
+
+
+	// Call our implementation
+	return (E3MappedPathStorage_New( pathName ));
+}
+#endif
+
+
+
+
+
 //=============================================================================
 //      Q3FileStreamStorage_New : Quesa API entry point.
 //-----------------------------------------------------------------------------
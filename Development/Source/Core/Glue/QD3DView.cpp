@@ -1012,6 +1012,40 @@ Q3View_AllowAllGroupCulling(TQ3ViewObject view, TQ3Boolean allowCulling)
 
 
 
+//=============================================================================
+//      Q3View_AllowAutomaticGroupCulling : Quesa API entry point.
+//-----------------------------------------------------------------------------
+#if QUESA_ALLOW_QD3D_EXTENSIONS
+
+TQ3Status
+Q3View_AllowAutomaticGroupCulling(TQ3ViewObject view, TQ3Boolean allowCulling)
+{
+
+
+	// Release build checks
+	Q3_REQUIRE_OR_RESULT( E3View_IsOfMyClass ( view ), kQ3Failure);
+
+
+
+	// Debug build checks
+
+
+
+	// Call the bottleneck
+	E3System_Bottleneck();
+
+
+
+	// Call our implementation
+	return(E3View_AllowAutomaticGroupCulling(view, allowCulling));
+}
+
+#endif // QUESA_ALLOW_QD3D_EXTENSIONS
+
+
+
+
+
 //=============================================================================
 //      Q3View_TransformLocalToWorld : Quesa API entry point.
 //-----------------------------------------------------------------------------
@@ -0,0 +1,633 @@
+/*  NAME:
+        E3BVH.cpp
+
+    DESCRIPTION:
+        Bounding volume hierarchies, for picking.
+
+    COPYRIGHT:
+        Copyright (c) 2026, Quesa Developers. All rights reserved.
+
+        For the current release of Quesa, please see:
+
+            <https://github.com/jwwalker/Quesa>
+        
+        Redistribution and use in source and binary forms, with or without
+        modification, are permitted provided that the following conditions
+        are met:
+        
+            o Redistributions of source code must retain the above copyright
+              notice, this list of conditions and the following disclaimer.
+        
+            o Redistributions in binary form must reproduce the above
+              copyright notice, this list of conditions and the following
+              disclaimer in the documentation and/or other materials provided
+              with the distribution.
+        
+            o Neither the name of Quesa nor the names of its contributors
+              may be used to endorse or promote products derived from this
+              software without specific prior written permission.
+        
+        THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+        "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+        LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+        A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+        OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+        SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+        TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+        PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+        LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+        NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+        SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+    ___________________________________________________________________________
+*/
+
+
+//=============================================================================
+//      Include files
+//-----------------------------------------------------------------------------
+#include "E3BVH.h"
+
+#include "E3Camera.h"
+#include "E3Math.h"
+#include "E3Utils.h"
+#include "E3View.h"
+#include "QuesaMathOperators.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+
+
+/*
+	DISCUSSION
+	
+	A bounding volume hierarchy lets a pick skip the items, such as the
+	triangles of a TriMesh or the objects in a group, whose bounds cannot
+	meet the pick.  The nodes are kept in a flat array, so that callers can
+	cache them in an object property.
+	
+	Nodes are split using the surface area heuristic, evaluated at a fixed
+	number of bins along each axis of the centroid bounds.
+*/
+
+
+
+//=============================================================================
+//      Internal constants and types
+//-----------------------------------------------------------------------------
+namespace
+{
+	const TQ3Uns32		kNumBins				= 16;
+	const TQ3Uns32		kMinLeafItems			= 4;
+	const TQ3Uns32		kMaxLeafItems			= 8;
+	
+	// Cost of visiting a node, relative to the cost of testing an item
+	const float			kTraversalCost			= 1.0f;
+	
+	// Relative slack added to node bounds when picking, to cover rounding
+	// between the local space of the hierarchy and the space of the pick
+	const float			kPickBoundsSlack		= 1.0e-5f;
+	
+	struct Bounds
+	{
+		TQ3Point3D			min;
+		TQ3Point3D			max;
+	};
+	
+	struct BinRec
+	{
+		Bounds				bounds;
+		TQ3Uns32			count;
+	};
+	
+	struct BuildItem
+	{
+		TQ3Uns32			node;
+		TQ3Uns32			start;
+		TQ3Uns32			end;
+	};
+}
+
+
+
+
+
+//=============================================================================
+//      Internal functions
+//-----------------------------------------------------------------------------
+//      e3bvh_bounds_clear : Set bounds to contain nothing.
+//-----------------------------------------------------------------------------
+static inline void
+e3bvh_bounds_clear( Bounds& outBounds )
+{
+	outBounds.min.x = outBounds.min.y = outBounds.min.z = kQ3MaxFloat;
+	outBounds.max.x = outBounds.max.y = outBounds.max.z = -kQ3MaxFloat;
+}
+
+
+
+
+
+//=============================================================================
+//      e3bvh_bounds_add_point : Grow bounds to contain a point.
+//-----------------------------------------------------------------------------
+static inline void
+e3bvh_bounds_add_point( Bounds& ioBounds, const TQ3Point3D& inPoint )
+{
+	ioBounds.min.x = std::min( ioBounds.min.x, inPoint.x );
+	ioBounds.min.y = std::min( ioBounds.min.y, inPoint.y );
+	ioBounds.min.z = std::min( ioBounds.min.z, inPoint.z );
+	ioBounds.max.x = std::max( ioBounds.max.x, inPoint.x );
+	ioBounds.max.y = std::max( ioBounds.max.y, inPoint.y );
+	ioBounds.max.z = std::max( ioBounds.max.z, inPoint.z );
+}
+
+
+
+
+
+//=============================================================================
+//      e3bvh_bounds_add_bounds : Grow bounds to contain other bounds.
+//-----------------------------------------------------------------------------
+static inline void
+e3bvh_bounds_add_bounds( Bounds& ioBounds, const Bounds& inOther )
+{
+	if (inOther.min.x > inOther.max.x)
+		return;
+	
+	e3bvh_bounds_add_point( ioBounds, inOther.min );
+	e3bvh_bounds_add_point( ioBounds, inOther.max );
+}
+
+
+
+
+
+//=============================================================================
+//      e3bvh_bounds_area : Half the surface area of some bounds.
+//-----------------------------------------------------------------------------
+static inline float
+e3bvh_bounds_area( const Bounds& inBounds )
+{
+	if (inBounds.min.x > inBounds.max.x)
+		return 0.0f;
+	
+	float dx = inBounds.max.x - inBounds.min.x;
+	float dy = inBounds.max.y - inBounds.min.y;
+	float dz = inBounds.max.z - inBounds.min.z;
+	
+	return dx * dy + dy * dz + dz * dx;
+}
+
+
+
+
+
+//=============================================================================
+//      e3bvh_coord : Get one coordinate of a point.
+//-----------------------------------------------------------------------------
+static inline float
+e3bvh_coord( const TQ3Point3D& inPoint, TQ3Uns32 inAxis )
+{
+	return (inAxis == 0) ? inPoint.x : ((inAxis == 1) ? inPoint.y : inPoint.z);
+}
+
+
+
+
+
+//=============================================================================
+//      e3bvh_bin_index : Find the bin of a centroid.
+//-----------------------------------------------------------------------------
+static inline TQ3Uns32
+e3bvh_bin_index( float inCoord, float inMin, float inScale )
+{
+	TQ3Int32 theBin = static_cast<TQ3Int32>( (inCoord - inMin) * inScale );
+	
+	return static_cast<TQ3Uns32>( std::max( 0, std::min( theBin, static_cast<TQ3Int32>(kNumBins - 1) ) ) );
+}
+
+
+
+
+
+//=============================================================================
+//      Public functions
+//-----------------------------------------------------------------------------
+//      E3BVH_Build : Build a hierarchy over some boxes.
+//-----------------------------------------------------------------------------
+void
+E3BVH_Build( TQ3Uns32 inNumItems,
+			const TQ3BoundingBox* inItemBounds,
+			std::vector<TE3BVHNode>& outNodes,
+			std::vector<TQ3Uns32>& outItems )
+{
+	outNodes.clear();
+	outItems.clear();
+	
+	
+	
+	// Collect the items with bounds, and their centroids
+	std::vector<Bounds>		itemBounds( inNumItems );
+	std::vector<TQ3Point3D>	centroids( inNumItems );
+	
+	outItems.reserve( inNumItems );
+	
+	for (TQ3Uns32 n = 0; n < inNumItems; ++n)
+	{
+		if (inItemBounds[n].isEmpty)
+			continue;
+		
+		itemBounds[n].min = inItemBounds[n].min;
+		itemBounds[n].max = inItemBounds[n].max;
+		
+		centroids[n].x = 0.5f * (itemBounds[n].min.x + itemBounds[n].max.x);
+		centroids[n].y = 0.5f * (itemBounds[n].min.y + itemBounds[n].max.y);
+		centroids[n].z = 0.5f * (itemBounds[n].min.z + itemBounds[n].max.z);
+		
+		outItems.push_back( n );
+	}
+	
+	const TQ3Uns32 numItems = static_cast<TQ3Uns32>( outItems.size() );
+	if (numItems == 0)
+		return;
+
+
+
+	// Split nodes until the leaves are small, or splitting stops paying off
+	std::vector<BuildItem>	toDo;
+	BuildItem				theItem = { 0, 0, numItems };
+	
+	outNodes.reserve( 2 * (numItems / kMaxLeafItems) + 1 );
+	outNodes.push_back( TE3BVHNode() );
+	toDo.push_back( theItem );
+	
+	while (! toDo.empty())
+	{
+		theItem = toDo.back();
+		toDo.pop_back();
+		
+		TQ3Uns32	theCount = theItem.end - theItem.start;
+		Bounds		nodeBounds, centroidBounds;
+		
+		e3bvh_bounds_clear( nodeBounds );
+		e3bvh_bounds_clear( centroidBounds );
+		
+		for (TQ3Uns32 i = theItem.start; i < theItem.end; ++i)
+		{
+			e3bvh_bounds_add_bounds( nodeBounds, itemBounds[ outItems[i] ] );
+			e3bvh_bounds_add_point( centroidBounds, centroids[ outItems[i] ] );
+		}
+		
+		outNodes[ theItem.node ].min   = nodeBounds.min;
+		outNodes[ theItem.node ].max   = nodeBounds.max;
+		outNodes[ theItem.node ].first = theItem.start;
+		outNodes[ theItem.node ].count = theCount;
+		
+		if (theCount <= kMinLeafItems)
+			continue;
+
+
+
+		// Evaluate the split planes between bins on each axis
+		float		bestCost  = kQ3MaxFloat;
+		TQ3Uns32	bestAxis  = 0;
+		TQ3Uns32	bestSplit = 0;
+		
+		for (TQ3Uns32 axis = 0; axis < 3; ++axis)
+		{
+			float axisMin = e3bvh_coord( centroidBounds.min, axis );
+			float extent  = e3bvh_coord( centroidBounds.max, axis ) - axisMin;
+			if (extent <= 0.0f)
+				continue;
+			
+			float	scale = kNumBins / extent;
+			BinRec	bins[ kNumBins ];
+			
+			for (TQ3Uns32 b = 0; b < kNumBins; ++b)
+			{
+				e3bvh_bounds_clear( bins[b].bounds );
+				bins[b].count = 0;
+			}
+			
+			for (TQ3Uns32 i = theItem.start; i < theItem.end; ++i)
+			{
+				TQ3Uns32 itemIndex = outItems[i];
+				TQ3Uns32 b = e3bvh_bin_index( e3bvh_coord( centroids[itemIndex], axis ),
+											axisMin, scale );
+				e3bvh_bounds_add_bounds( bins[b].bounds, itemBounds[itemIndex] );
+				bins[b].count += 1;
+			}
+			
+			
+			// Sweep from the right to get the cost of everything right of each plane
+			float		rightArea[ kNumBins ];
+			TQ3Uns32	rightCount[ kNumBins ];
+			Bounds		sweepBounds;
+			TQ3Uns32	sweepCount = 0;
+			
+			e3bvh_bounds_clear( sweepBounds );
+			for (TQ3Uns32 b = kNumBins - 1; b > 0; --b)
+			{
+				e3bvh_bounds_add_bounds( sweepBounds, bins[b].bounds );
+				sweepCount += bins[b].count;
+				rightArea[b]  = e3bvh_bounds_area( sweepBounds );
+				rightCount[b] = sweepCount;
+			}
+			
+			
+			// Then sweep from the left, splitting after bin b
+			e3bvh_bounds_clear( sweepBounds );
+			sweepCount = 0;
+			for (TQ3Uns32 b = 0; b < kNumBins - 1; ++b)
+			{
+				e3bvh_bounds_add_bounds( sweepBounds, bins[b].bounds );
+				sweepCount += bins[b].count;
+				
+				if (sweepCount == 0 || rightCount[b + 1] == 0)
+					continue;
+				
+				float theCost = sweepCount * e3bvh_bounds_area( sweepBounds ) +
+								rightCount[b + 1] * rightArea[b + 1];
+				if (theCost < bestCost)
+				{
+					bestCost  = theCost;
+					bestAxis  = axis;
+					bestSplit = b;
+				}
+			}
+		}
+
+
+
+		// Keep a leaf if no plane separates the items, or if splitting
+		// costs more than testing them all
+		float nodeArea = e3bvh_bounds_area( nodeBounds );
+		
+		if (bestCost == kQ3MaxFloat)
+			continue;
+		
+		if ( (theCount <= kMaxLeafItems) &&
+			(kTraversalCost * nodeArea + bestCost >= theCount * nodeArea) )
+			continue;
+
+
+
+		// Partition the items and queue the children
+		float axisMin = e3bvh_coord( centroidBounds.min, bestAxis );
+		float scale   = kNumBins / (e3bvh_coord( centroidBounds.max, bestAxis ) - axisMin);
+		
+		TQ3Uns32* theMid = std::partition( &outItems[0] + theItem.start,
+			&outItems[0] + theItem.end,
+			[&]( TQ3Uns32 inItem )
+			{
+				return e3bvh_bin_index( e3bvh_coord( centroids[inItem], bestAxis ),
+										axisMin, scale ) <= bestSplit;
+			} );
+		
+		TQ3Uns32 midIndex = static_cast<TQ3Uns32>( theMid - &outItems[0] );
+		Q3_ASSERT( (midIndex > theItem.start) && (midIndex < theItem.end) );
+		
+		TQ3Uns32 leftChild = static_cast<TQ3Uns32>( outNodes.size() );
+		outNodes[ theItem.node ].first = leftChild;
+		outNodes[ theItem.node ].count = 0;
+		outNodes.push_back( TE3BVHNode() );
+		outNodes.push_back( TE3BVHNode() );
+		
+		BuildItem leftItem  = { leftChild,     theItem.start, midIndex    };
+		BuildItem rightItem = { leftChild + 1, midIndex,      theItem.end };
+		toDo.push_back( rightItem );
+		toDo.push_back( leftItem );
+	}
+}
+
+
+
+
+
+//=============================================================================
+//      E3BVH_GetCandidates : Find the items in nodes passing a test.
+//-----------------------------------------------------------------------------
+void
+E3BVH_GetCandidates( TQ3Uns32 inNodeCount,
+					const TE3BVHNode* inNodes,
+					const TQ3Uns32* inItems,
+					TE3BVHNodeTest inNodeTest,
+					void* inUserData,
+					E3FastArray<TQ3Uns32>& outItems )
+{
+	outItems.clear();
+	
+	if (inNodeCount == 0)
+		return;
+	
+	
+	
+	// Walk the hierarchy, collecting the items of leaves that pass
+	E3FastArray<TQ3Uns32>	toVisit;
+	toVisit.push_back( 0 );
+	
+	while (! toVisit.empty())
+	{
+		const TE3BVHNode& theNode( inNodes[ toVisit[ toVisit.size() - 1 ] ] );
+		toVisit.resize( toVisit.size() - 1 );
+		
+		if (! inNodeTest( theNode.min, theNode.max, inUserData ))
+			continue;
+		
+		if (theNode.count == 0)
+		{
+			toVisit.push_back( theNode.first + 1 );
+			toVisit.push_back( theNode.first );
+		}
+		else
+		{
+			for (TQ3Uns32 i = 0; i < theNode.count; ++i)
+				outItems.push_back( inItems[ theNode.first + i ] );
+		}
+	}
+	
+	
+	
+	// Return the candidates in the order a linear scan would visit them
+	if (! outItems.empty())
+		std::sort( &outItems[0], &outItems[0] + outItems.size() );
+}
+
+
+
+
+
+//=============================================================================
+//      E3BVH_InitRayTest : Prepare to test a hierarchy against a world ray.
+//-----------------------------------------------------------------------------
+bool
+E3BVH_InitRayTest( const TQ3Matrix4x4& inLocalToWorld,
+					const TQ3Ray3D& inWorldRay,
+					float inWorldTolerance,
+					TE3BVHRayTest& outTest )
+{
+	// The hierarchy is in local coordinates, so we need an affine transform
+	// to bring the ray into local space
+	if ( (inLocalToWorld.value[0][3] != 0.0f) || (inLocalToWorld.value[1][3] != 0.0f) ||
+		(inLocalToWorld.value[2][3] != 0.0f) || (inLocalToWorld.value[3][3] != 1.0f) )
+		return false;
+	
+	TQ3Matrix4x4 worldToLocal;
+	E3Matrix4x4_Invert( &inLocalToWorld, &worldToLocal );
+	
+	outTest.origin    = inWorldRay.origin * worldToLocal;
+	outTest.direction = inWorldRay.direction * worldToLocal;
+	outTest.wholeLine = (inWorldTolerance > 0.0f);
+	
+	
+	// Bound the local length of a world-space tolerance by the Frobenius norm
+	// of the linear part of the inverse transform
+	float normSquared = 0.0f;
+	for (TQ3Uns32 row = 0; row < 3; ++row)
+		for (TQ3Uns32 col = 0; col < 3; ++col)
+			normSquared += worldToLocal.value[row][col] * worldToLocal.value[row][col];
+	
+	float originSize = E3Num_Max( fabsf( outTest.origin.x ),
+		E3Num_Max( fabsf( outTest.origin.y ), fabsf( outTest.origin.z ) ) );
+	
+	outTest.slack = inWorldTolerance * sqrtf( normSquared ) +
+					kPickBoundsSlack * originSize;
+	
+	return true;
+}
+
+
+
+
+
+//=============================================================================
+//      E3BVH_InitWindowTest : Prepare to test a hierarchy against an area of
+//				the window.
+//-----------------------------------------------------------------------------
+bool
+E3BVH_InitWindowTest( TQ3ViewObject inView,
+						const TQ3Area& inArea,
+						TE3BVHWindowTest& outTest )
+{
+	// Nonlinear projections don't keep the projected node bounds convex
+	TQ3CameraObject theCamera = E3View_AccessCamera( inView );
+	if ( (theCamera == nullptr) || E3FisheyeCamera::IsOfMyClass( theCamera ) ||
+		E3AllSeeingCamera::IsOfMyClass( theCamera ) )
+		return false;
+	
+	TQ3Matrix4x4 worldToView;
+	
+	Q3Camera_GetWorldToView( theCamera, &worldToView );
+	outTest.theView     = inView;
+	outTest.localToView = *E3View_State_GetMatrixLocalToWorld( inView ) * worldToView;
+	
+	// Allow a pixel for rounding in the projection
+	outTest.theArea = inArea;
+	outTest.theArea.min.x -= 1.0f;
+	outTest.theArea.min.y -= 1.0f;
+	outTest.theArea.max.x += 1.0f;
+	outTest.theArea.max.y += 1.0f;
+	
+	return true;
+}
+
+
+
+
+
+//=============================================================================
+//      E3BVH_RayNodeTest : Test whether a ray may pass a node.
+//-----------------------------------------------------------------------------
+bool
+E3BVH_RayNodeTest( const TQ3Point3D& inMin, const TQ3Point3D& inMax, void* inUserData )
+{
+	const TE3BVHRayTest*	theTest = (const TE3BVHRayTest*) inUserData;
+	const float				boxMin[3] = { inMin.x, inMin.y, inMin.z };
+	const float				boxMax[3] = { inMax.x, inMax.y, inMax.z };
+	const float				origin[3] = { theTest->origin.x, theTest->origin.y, theTest->origin.z };
+	const float				dir[3]    = { theTest->direction.x, theTest->direction.y, theTest->direction.z };
+	float					maxAbs    = 0.0f;
+	TQ3Uns32				n;
+
+
+
+	// Pad the node in proportion to its size, so rounding can't lose a hit
+	for (n = 0; n < 3; ++n)
+		maxAbs = E3Num_Max( maxAbs, E3Num_Max( fabsf( boxMin[n] ), fabsf( boxMax[n] ) ) );
+
+	float slack = theTest->slack + kPickBoundsSlack * maxAbs;
+
+
+
+	// Clip the ray against each pair of slabs
+	float tNear = theTest->wholeLine ? -kQ3MaxFloat : 0.0f;
+	float tFar  = kQ3MaxFloat;
+	
+	for (n = 0; n < 3; ++n)
+	{
+		float lo = boxMin[n] - slack;
+		float hi = boxMax[n] + slack;
+		
+		if (dir[n] == 0.0f)
+		{
+			if (origin[n] < lo || origin[n] > hi)
+				return false;
+		}
+		else
+		{
+			float t1 = (lo - origin[n]) / dir[n];
+			float t2 = (hi - origin[n]) / dir[n];
+			if (t1 > t2)
+				std::swap( t1, t2 );
+			
+			tNear = E3Num_Max( tNear, t1 );
+			tFar  = E3Num_Min( tFar,  t2 );
+			if (tNear > tFar)
+				return false;
+		}
+	}
+	
+	return true;
+}
+
+
+
+
+
+//=============================================================================
+//      E3BVH_WindowNodeTest : Test whether a node may touch an area of the
+//				window.
+//-----------------------------------------------------------------------------
+//		Note :	The projected corners of the node only bound the projection of
+//				its contents when the whole node is in front of the camera, so
+//				nodes which are not are always accepted.
+//-----------------------------------------------------------------------------
+bool
+E3BVH_WindowNodeTest( const TQ3Point3D& inMin, const TQ3Point3D& inMax, void* inUserData )
+{
+	const TE3BVHWindowTest*	theTest = (const TE3BVHWindowTest*) inUserData;
+	TQ3BoundingBox			nodeBounds;
+	TQ3Point3D				localCorners[8];
+	TQ3Point2D				windowCorners[8];
+	TQ3Uns32				n;
+
+
+
+	nodeBounds.min     = inMin;
+	nodeBounds.max     = inMax;
+	nodeBounds.isEmpty = kQ3False;
+	E3BoundingBox_GetCorners( &nodeBounds, localCorners );
+	
+	for (n = 0; n < 8; ++n)
+	{
+		TQ3Point3D viewCorner = localCorners[n] * theTest->localToView;
+		if (viewCorner.z >= 0.0f)
+			return true;
+	}
+	
+	E3View_TransformArrayLocalToWindow( theTest->theView, 8, localCorners, windowCorners );
+	TQ3Area windowBounds = E3Area_SetFromPoints2D( 8, windowCorners );
+	
+	return E3Rect_IntersectRect( &windowBounds, &theTest->theArea ) == kQ3True;
+}
@@ -0,0 +1,216 @@
+#pragma once
+/*  NAME:
+        E3BVH.h
+
+    DESCRIPTION:
+        Header file for E3BVH.cpp.
+
+    COPYRIGHT:
+        Copyright (c) 2026, Quesa Developers. All rights reserved.
+
+        For the current release of Quesa, please see:
+
+            <https://github.com/jwwalker/Quesa>
+        
+        Redistribution and use in source and binary forms, with or without
+        modification, are permitted provided that the following conditions
+        are met:
+        
+            o Redistributions of source code must retain the above copyright
+              notice, this list of conditions and the following disclaimer.
+        
+            o Redistributions in binary form must reproduce the above
+              copyright notice, this list of conditions and the following
+              disclaimer in the documentation and/or other materials provided
+              with the distribution.
+        
+            o Neither the name of Quesa nor the names of its contributors
+              may be used to endorse or promote products derived from this
+              software without specific prior written permission.
+        
+        THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+        "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+        LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+        A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+        OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+        SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+        TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+        PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+        LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+        NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+        SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+    ___________________________________________________________________________
+*/
+
+
+
+
+
+
+//=============================================================================
+//      Include files
+//-----------------------------------------------------------------------------
+#include "E3Prefix.h"
+#include "E3FastArray.h"
+
+#include <vector>
+
+
+
+//=============================================================================
+//      Types
+//-----------------------------------------------------------------------------
+/*!
+	@struct		TE3BVHNode
+	@abstract	A node of a bounding volume hierarchy.
+	@discussion	Interior nodes have a count of 0, and first is the index of
+				their first child.  The second child immediately follows the
+				first.  Leaf nodes hold a range of the item array.
+*/
+struct TE3BVHNode
+{
+	TQ3Point3D			min;
+	TQ3Point3D			max;
+	TQ3Uns32			first;
+	TQ3Uns32			count;
+};
+
+
+/*!
+	@typedef	TE3BVHNodeTest
+	@abstract	Callback deciding whether a node can contain a hit.
+	@discussion	The test must be conservative: returning false for a node whose
+				bounds contain a hit would lose that hit.
+	@param		inMin		Minimum corner of the node bounds.
+	@param		inMax		Maximum corner of the node bounds.
+	@param		inUserData	The data passed to E3BVH_GetCandidates.
+	@result		True if the items below the node should be considered.
+*/
+typedef bool (*TE3BVHNodeTest)( const TQ3Point3D& inMin,
+								const TQ3Point3D& inMax,
+								void* inUserData );
+
+
+/*!
+	@struct		TE3BVHRayTest
+	@abstract	Data for E3BVH_RayNodeTest, in the coordinates of the hierarchy.
+*/
+struct TE3BVHRayTest
+{
+	TQ3Point3D			origin;
+	TQ3Vector3D			direction;
+	float				slack;
+	bool				wholeLine;
+};
+
+
+/*!
+	@struct		TE3BVHWindowTest
+	@abstract	Data for E3BVH_WindowNodeTest.
+*/
+struct TE3BVHWindowTest
+{
+	TQ3ViewObject		theView;
+	TQ3Matrix4x4		localToView;
+	TQ3Area				theArea;
+};
+
+
+
+//=============================================================================
+//      Function prototypes
+//-----------------------------------------------------------------------------
+/*!
+	@function	E3BVH_Build
+	@abstract	Build a hierarchy over some boxes.
+	@discussion	Nodes are split with a binned surface area heuristic.  Items
+				with empty bounds are left out of the hierarchy.
+				
+				May throw std::bad_alloc.
+	@param		inNumItems		Number of boxes.
+	@param		inItemBounds	The boxes.
+	@param		outNodes		Receives the nodes, the root first.  Empty if
+								no item has bounds.
+	@param		outItems		Receives the item indices referenced by leaves.
+*/
+void	E3BVH_Build( TQ3Uns32 inNumItems,
+					const TQ3BoundingBox* inItemBounds,
+					std::vector<TE3BVHNode>& outNodes,
+					std::vector<TQ3Uns32>& outItems );
+
+
+/*!
+	@function	E3BVH_GetCandidates
+	@abstract	Find the items in leaves whose ancestors all pass a node test.
+	@discussion	The candidates are returned in increasing order, so that callers
+				visit them in the same order as a linear scan.
+	@param		inNodeCount		Number of nodes.
+	@param		inNodes			The nodes.
+	@param		inItems			The item indices referenced by leaves.
+	@param		inNodeTest		Test applied to each node's bounds.
+	@param		inUserData		Data passed to inNodeTest.
+	@param		outItems		Receives the candidate item indices.
+*/
+void	E3BVH_GetCandidates( TQ3Uns32 inNodeCount,
+							const TE3BVHNode* inNodes,
+							const TQ3Uns32* inItems,
+							TE3BVHNodeTest inNodeTest,
+							void* inUserData,
+							E3FastArray<TQ3Uns32>& outItems );
+
+
+/*!
+	@function	E3BVH_InitRayTest
+	@abstract	Prepare to test a hierarchy against a world ray.
+	@discussion	The ray is brought into the local coordinates of the hierarchy.
+				This requires an affine local to world transform, so the
+				function returns false for any other kind.
+				
+				A positive tolerance picks along the whole line rather than only
+				in front of the ray origin, matching the tolerance tests of the
+				pick methods.
+	@param		inLocalToWorld		The local to world matrix.
+	@param		inWorldRay			The ray, in world coordinates.
+	@param		inWorldTolerance	Distance from the ray which counts as a hit.
+	@param		outTest				Receives the test data for E3BVH_RayNodeTest.
+	@result		True if the test data can be used.
+*/
+bool	E3BVH_InitRayTest( const TQ3Matrix4x4& inLocalToWorld,
+							const TQ3Ray3D& inWorldRay,
+							float inWorldTolerance,
+							TE3BVHRayTest& outTest );
+
+
+/*!
+	@function	E3BVH_InitWindowTest
+	@abstract	Prepare to test a hierarchy against an area of the window.
+	@discussion	The hierarchy is taken to be in the current local coordinates
+				of the view.  Fisheye and all-seeing cameras do not keep the
+				projection of a box inside the projection of its corners, so
+				the function returns false for them.
+	@param		inView				The view, which must be submitting.
+	@param		inArea				The area, in window coordinates.
+	@param		outTest				Receives the test data for E3BVH_WindowNodeTest.
+	@result		True if the test data can be used.
+*/
+bool	E3BVH_InitWindowTest( TQ3ViewObject inView,
+							const TQ3Area& inArea,
+							TE3BVHWindowTest& outTest );
+
+
+/*!
+	@function	E3BVH_RayNodeTest
+	@abstract	Node test for a ray, taking a TE3BVHRayTest as user data.
+*/
+bool	E3BVH_RayNodeTest( const TQ3Point3D& inMin,
+							const TQ3Point3D& inMax,
+							void* inUserData );
+
+
+/*!
+	@function	E3BVH_WindowNodeTest
+	@abstract	Node test for a window area, taking a TE3BVHWindowTest as user data.
+*/
+bool	E3BVH_WindowNodeTest( const TQ3Point3D& inMin,
+							const TQ3Point3D& inMax,
+							void* inUserData );
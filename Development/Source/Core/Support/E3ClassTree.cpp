@@ -66,6 +66,8 @@
 #include <time.h>
 #include <stdio.h>
 #include <new>
+#include <mutex>
+#include <atomic>
 
 
 
@@ -76,6 +78,7 @@
 //-----------------------------------------------------------------------------
 #define kClassHashTableSize							512
 #define kMethodHashTableSize						64
+#define kClassIndexInitialSize						1024
 
 static TQ3Uns8	sDummyPlaceholder;
 
@@ -87,14 +90,68 @@ static void* const	sMissingMethodPlaceholder	= (void*) &sDummyPlaceholder;
 
 
 
+
 //=============================================================================
 //      Internal types
 //-----------------------------------------------------------------------------
+//		Note :	The class index is an open-addressed table of the registered
+//				classes, read by GetClass without taking sClassTreeMutex.
+//
+//				Slots are only changed while holding the lock. A slot's name
+//				and class are stored before its type, so a reader which sees
+//				the type also sees a fully registered class. Unregistering a
+//				class clears the class but keeps the type, and the slot is
+//				reused if the type is registered again.
+//
+//				Searches by name compare the index's own copy of each name,
+//				since another thread may be unregistering one of the classes.
+//
+//				The index is copied into one twice the size when it gets half
+//				full. Readers may still be using the old one, so it is kept
+//				until the class tree is destroyed; the old indexes add up to
+//				less than the size of the current one. The names are kept
+//				until then too.
+//-----------------------------------------------------------------------------
+typedef struct E3ClassIndexName {
+	struct E3ClassIndexName			*nextName;
+	char							theName[1];
+} E3ClassIndexName;
+
+typedef struct E3ClassIndexSlot {
+	std::atomic<TQ3ObjectType>		classType;
+	std::atomic<E3ClassInfoPtr>		theClass;
+	std::atomic<const char*>		className;
+} E3ClassIndexSlot;
+
+typedef struct E3ClassIndex {
+	TQ3Uns32						numSlots;
+	TQ3Uns32						numUsed;
+	E3ClassIndexSlot				*theSlots;
+	struct E3ClassIndex				*previousIndex;
+} E3ClassIndex;
 
 
 
 
 
+//=============================================================================
+//      Internal variables
+//-----------------------------------------------------------------------------
+//		Note :	Guards the class tree and the method caches of each class.
+//
+//				The lock is recursive since registering a class looks up its
+//				parent, and metahandlers may look up or register other classes.
+//				Lookups of classes go through sClassIndex, and lookups of
+//				well-known methods go through the dense method table, so
+//				neither takes it.
+//-----------------------------------------------------------------------------
+static std::recursive_mutex sClassTreeMutex;
+
+static std::atomic<E3ClassIndex*> sClassIndex( nullptr );
+static E3ClassIndexName			*sClassIndexNames = nullptr;
+
+
+
 
 
 //=============================================================================
@@ -139,6 +196,246 @@ OpaqueTQ3Object::Verify ()
 
 
 
+//=============================================================================
+//      e3classtree_index_new : Create an empty class index.
+//-----------------------------------------------------------------------------
+//		Note :	numSlots must be a power of 2.
+//-----------------------------------------------------------------------------
+static E3ClassIndex *
+e3classtree_index_new ( TQ3Uns32 numSlots )
+	{
+	// Allocate the index
+	E3ClassIndex *theIndex = new ( std::nothrow ) E3ClassIndex ;
+	if ( theIndex == nullptr )
+		return nullptr ;
+
+	theIndex->theSlots = new ( std::nothrow ) E3ClassIndexSlot [ numSlots ] ;
+	if ( theIndex->theSlots == nullptr )
+		{
+		delete theIndex ;
+		return nullptr ;
+		}
+
+
+
+	// Initialise it
+	for ( TQ3Uns32 n = 0 ; n < numSlots ; ++n )
+		{
+		theIndex->theSlots [ n ].classType.store ( kQ3ObjectTypeInvalid, std::memory_order_relaxed ) ;
+		theIndex->theSlots [ n ].theClass.store ( nullptr, std::memory_order_relaxed ) ;
+		theIndex->theSlots [ n ].className.store ( nullptr, std::memory_order_relaxed ) ;
+		}
+
+	theIndex->numSlots      = numSlots ;
+	theIndex->numUsed       = 0 ;
+	theIndex->previousIndex = nullptr ;
+	
+	return theIndex ;
+	}
+
+
+
+
+
+//=============================================================================
+//      e3classtree_index_slot : Find the slot for a type in a class index.
+//-----------------------------------------------------------------------------
+//		Note :	Returns the slot holding the type, or the empty slot where it
+//				would be added. The index is never more than half full, so the
+//				search always ends.
+//-----------------------------------------------------------------------------
+static E3ClassIndexSlot *
+e3classtree_index_slot ( const E3ClassIndex *theIndex, TQ3ObjectType classType )
+	{
+	TQ3Uns32 theHash = (TQ3Uns32) classType * 2654435761U ;
+	TQ3Uns32 theMask = theIndex->numSlots - 1 ;
+	TQ3Uns32 n       = ( theHash ^ ( theHash >> 16 ) ) & theMask ;
+
+	for ( ; ; n = ( n + 1 ) & theMask )
+		{
+		TQ3ObjectType slotType = theIndex->theSlots [ n ].classType.load ( std::memory_order_acquire ) ;
+		if ( slotType == classType || slotType == kQ3ObjectTypeInvalid )
+			return &theIndex->theSlots [ n ] ;
+		}
+	}
+
+
+
+
+
+//=============================================================================
+//      e3classtree_index_name : Copy a class name for the class index.
+//-----------------------------------------------------------------------------
+//		Note :	Must be called with sClassTreeMutex held.
+//-----------------------------------------------------------------------------
+static const char *
+e3classtree_index_name ( const char *className )
+	{
+	// Allocate the copy
+	TQ3Uns32          nameSize = (TQ3Uns32) strlen ( className ) + 1 ;
+	E3ClassIndexName *theName  = (E3ClassIndexName *) Q3Memory_Allocate ( (TQ3Uns32) sizeof ( E3ClassIndexName ) + nameSize ) ;
+	if ( theName == nullptr )
+		return nullptr ;
+
+
+
+	// Keep it until the index is destroyed
+	strcpy ( theName->theName, className ) ;
+	theName->nextName = sClassIndexNames ;
+	sClassIndexNames  = theName ;
+	
+	return theName->theName ;
+	}
+
+
+
+
+
+//=============================================================================
+//      e3classtree_index_add : Add a registered class to the class index.
+//-----------------------------------------------------------------------------
+//		Note :	Must be called with sClassTreeMutex held, once the class is
+//				fully set up.
+//-----------------------------------------------------------------------------
+static TQ3Status
+e3classtree_index_add ( TQ3ObjectType classType, E3ClassInfoPtr theClass, const char *className )
+	{
+	E3ClassIndex *theIndex = sClassIndex.load ( std::memory_order_relaxed ) ;
+	const char   *theName  = nullptr ;
+
+
+
+	// Reuse the slot of a type which was registered before, and its name
+	if ( theIndex != nullptr )
+		{
+		E3ClassIndexSlot *theSlot = e3classtree_index_slot ( theIndex, classType ) ;
+		if ( theSlot->classType.load ( std::memory_order_relaxed ) == classType )
+			{
+			theName = theSlot->className.load ( std::memory_order_relaxed ) ;
+			if ( ! E3CString_IsEqual ( theName, className ) )
+				{
+				theName = e3classtree_index_name ( className ) ;
+				if ( theName == nullptr )
+					return kQ3Failure ;
+
+				theSlot->className.store ( theName, std::memory_order_release ) ;
+				}
+
+			theSlot->theClass.store ( theClass, std::memory_order_release ) ;
+			return kQ3Success ;
+			}
+		}
+
+
+
+	// Copy the name
+	theName = e3classtree_index_name ( className ) ;
+	if ( theName == nullptr )
+		return kQ3Failure ;
+
+
+
+	// Grow the index if it would be more than half full
+	if ( theIndex == nullptr || ( theIndex->numUsed + 1 ) * 2 > theIndex->numSlots )
+		{
+		E3ClassIndex *newIndex = e3classtree_index_new ( theIndex == nullptr ? kClassIndexInitialSize : theIndex->numSlots * 2 ) ;
+		if ( newIndex == nullptr )
+			return kQ3Failure ;
+
+		if ( theIndex != nullptr )
+			{
+			for ( TQ3Uns32 n = 0 ; n < theIndex->numSlots ; ++n )
+				{
+				E3ClassInfoPtr oldClass = theIndex->theSlots [ n ].theClass.load ( std::memory_order_relaxed ) ;
+				if ( oldClass == nullptr )
+					continue ;
+
+				TQ3ObjectType     oldType = theIndex->theSlots [ n ].classType.load ( std::memory_order_relaxed ) ;
+				E3ClassIndexSlot *newSlot = e3classtree_index_slot ( newIndex, oldType ) ;
+				newSlot->className.store ( theIndex->theSlots [ n ].className.load ( std::memory_order_relaxed ), std::memory_order_relaxed ) ;
+				newSlot->theClass.store ( oldClass, std::memory_order_relaxed ) ;
+				newSlot->classType.store ( oldType, std::memory_order_relaxed ) ;
+				newIndex->numUsed++ ;
+				}
+			}
+
+		newIndex->previousIndex = theIndex ;
+		sClassIndex.store ( newIndex, std::memory_order_release ) ;
+		theIndex = newIndex ;
+		}
+
+
+
+	// Add the class
+	E3ClassIndexSlot *theSlot = e3classtree_index_slot ( theIndex, classType ) ;
+	theSlot->className.store ( theName, std::memory_order_release ) ;
+	theSlot->theClass.store ( theClass, std::memory_order_release ) ;
+	theSlot->classType.store ( classType, std::memory_order_release ) ;
+	theIndex->numUsed++ ;
+	
+	return kQ3Success ;
+	}
+
+
+
+
+
+//=============================================================================
+//      e3classtree_index_remove : Remove a class from the class index.
+//-----------------------------------------------------------------------------
+//		Note :	Must be called with sClassTreeMutex held.
+//-----------------------------------------------------------------------------
+static void
+e3classtree_index_remove ( TQ3ObjectType classType )
+	{
+	E3ClassIndex *theIndex = sClassIndex.load ( std::memory_order_relaxed ) ;
+	if ( theIndex == nullptr )
+		return ;
+
+	E3ClassIndexSlot *theSlot = e3classtree_index_slot ( theIndex, classType ) ;
+	if ( theSlot->classType.load ( std::memory_order_relaxed ) == classType )
+		theSlot->theClass.store ( nullptr, std::memory_order_release ) ;
+	}
+
+
+
+
+
+//=============================================================================
+//      e3classtree_index_destroy : Destroy the class index and its old copies.
+//-----------------------------------------------------------------------------
+//		Note :	Must be called with sClassTreeMutex held, when no other thread
+//				is using Quesa.
+//-----------------------------------------------------------------------------
+static void
+e3classtree_index_destroy ( void )
+	{
+	E3ClassIndex *theIndex = sClassIndex.exchange ( nullptr, std::memory_order_relaxed ) ;
+
+	while ( theIndex != nullptr )
+		{
+		E3ClassIndex *previousIndex = theIndex->previousIndex ;
+
+		delete [] theIndex->theSlots ;
+		delete theIndex ;
+
+		theIndex = previousIndex ;
+		}
+
+	while ( sClassIndexNames != nullptr )
+		{
+		E3ClassIndexName *nextName = sClassIndexNames->nextName ;
+
+		Q3Memory_Free ( &sClassIndexNames ) ;
+
+		sClassIndexNames = nextName ;
+		}
+	}
+
+
+
+
+
 //=============================================================================
 //      E3ClassInfo::E3ClassInfo : Constructor for class info of root class.
 //-----------------------------------------------------------------------------
@@ -168,6 +465,18 @@ E3ClassInfo::E3ClassInfo	(
 	
 	// Also before this:
 	registerMethod = (TQ3XObjectRegisterMethod) Find_Method ( kQ3XMethodTypeNewObjectClass , kQ3True ) ;
+	
+	
+	// Resolve the well-known methods, inheriting them from our parents.  No
+	// other thread can see the class until the class index publishes it,
+	// with a release, so these stores can be relaxed.
+	#define E3_DENSE_METHOD_FIND(_name, _type)		\
+		denseMethods [ kE3MethodIndex##_name ].store ( Find_Method ( _type , kQ3True ),	\
+													std::memory_order_relaxed ) ;
+
+	E3_DENSE_METHOD_TYPES ( E3_DENSE_METHOD_FIND )
+
+	#undef E3_DENSE_METHOD_FIND
 	}
 
 
@@ -253,46 +562,6 @@ E3ClassInfo::Detach ( void )
 
 
 
-//=============================================================================
-//      e3class_find_by_name : Recursive search for a class given a name.
-//-----------------------------------------------------------------------------
-E3ClassInfoPtr
-E3ClassInfo::Find ( const char *theClassName )
-	{
-	// Validate our parameters
-	Q3_REQUIRE_OR_RESULT(Q3_VALID_PTR(this),							nullptr);
-	Q3_REQUIRE_OR_RESULT(Q3_VALID_PTR(theClassName),                    nullptr);
-	Q3_REQUIRE_OR_RESULT(strlen(theClassName) < kQ3StringMaximumLength, nullptr);
-
-
-
-	// Check this node
-	if ( E3CString_IsEqual ( className, theClassName ) )
-		return this ;
-
-
-
-	// Check the children of the class
-	for ( TQ3Uns32 n = 0 ; n < numChildren ; ++n )
-		{
-		// Get the child
-		E3ClassInfoPtr theChild = theChildren [ n ] ;
-		Q3_ASSERT_VALID_PTR(theChild);
-
-
-		// Check it
-		E3ClassInfoPtr theResult = theChild->Find ( theClassName ) ;
-		if ( theResult != nullptr )
-			return theResult ;
-		}
-	
-	return nullptr ;
-	}
-
-
-
-
-
 //=============================================================================
 //      e3class_find_method : Find a method for a class.
 //-----------------------------------------------------------------------------
@@ -428,6 +697,7 @@ void
 E3ClassTree::Destroy ( void )
 	{
 	E3GlobalsPtr theGlobals = E3Globals_Get () ;
+	std::lock_guard<std::recursive_mutex> treeLock ( sClassTreeMutex ) ;
 
 	// If we have a class tree, destroy it
 	if (theGlobals->classTree != nullptr)
@@ -435,6 +705,8 @@ E3ClassTree::Destroy ( void )
 		E3HashTable_Destroy(&theGlobals->classTree);
 		theGlobals->classTreeRoot = nullptr;
 		}
+
+	e3classtree_index_destroy () ;
 	}
 
 
@@ -450,6 +722,7 @@ TQ3ObjectType
 E3ClassTree::GetNextClassType ( void )
 	{
 	E3GlobalsPtr theGlobals = E3Globals_Get () ;
+	std::lock_guard<std::recursive_mutex> treeLock ( sClassTreeMutex ) ;
 
 	// Decrement the class type, and return the next available type
 	theGlobals->classNextType--;
@@ -510,6 +783,8 @@ E3ClassTree::RegisterClass (	TQ3ObjectType		parentClassType,
 	Q3_REQUIRE_OR_RESULT(Q3_VALID_PTR(className),                    kQ3Failure);
 	Q3_REQUIRE_OR_RESULT(strlen(className) < kQ3StringMaximumLength, kQ3Failure);
 
+	std::lock_guard<std::recursive_mutex> treeLock ( sClassTreeMutex ) ;
+
 	E3ClassInfo* theParent = E3ClassTree::GetClass ( parentClassType ) ;
 	if ( theParent == nullptr )
 		Q3_REQUIRE_OR_RESULT(theGlobals->classTree == nullptr, kQ3Failure);
@@ -606,6 +881,16 @@ E3ClassTree::RegisterClass (	TQ3ObjectType		parentClassType,
 
 
 
+	// Let GetClass find the class
+	if ( qd3dStatus != kQ3Failure )
+		{
+		qd3dStatus = e3classtree_index_add ( classType, newClass, className ) ;
+		if ( qd3dStatus == kQ3Failure && newClass->theParent != nullptr )
+			newClass->E3ClassInfo::Detach () ;
+		}
+
+
+
 	// Handle failure
 	if ( qd3dStatus == kQ3Failure )
 		{
@@ -647,6 +932,7 @@ TQ3Status
 E3ClassTree::UnregisterClass ( TQ3ObjectType classType, TQ3Boolean isRequired )
 	{
 	E3GlobalsPtr theGlobals = E3Globals_Get () ;
+	std::lock_guard<std::recursive_mutex> treeLock ( sClassTreeMutex ) ;
 	
 	
 
@@ -695,6 +981,7 @@ E3ClassTree::UnregisterClass ( TQ3ObjectType classType, TQ3Boolean isRequired )
 	if ( theGlobals->classTreeRoot == theClass )
 		theGlobals->classTreeRoot = nullptr ;
 
+	e3classtree_index_remove(classType);
 	E3HashTable_Remove(theGlobals->classTree, classType);
 
 
@@ -858,7 +1145,7 @@ E3ClassInfo::CreateInstance (	TQ3Boolean		sharedParams,
 		}
 		
 	// Increment the instance count of the class (watch for overflow)
-	++numInstances ;
+	numInstances.fetch_add ( 1, std::memory_order_relaxed ) ;
 	Q3_ASSERT ( numInstances > 0 ) ;
 
 
@@ -927,7 +1214,7 @@ OpaqueTQ3Object::DestroyInstance ( void )
 
 	// Decrement the instance count of the class
 	Q3_ASSERT(theClass->numInstances > 0);
-	theClass->numInstances-- ;
+	theClass->numInstances.fetch_sub ( 1, std::memory_order_relaxed ) ;
 
 
 	// Mark it as no longer a good object
@@ -1048,7 +1335,7 @@ OpaqueTQ3Object::DuplicateInstance ( void )
 	
 
 	// Increment the instance count of the object's class
-	theClass->numInstances++ ;
+	theClass->numInstances.fetch_add ( 1, std::memory_order_relaxed ) ;
 	Q3_ASSERT ( theClass->numInstances > 0 ) ;
 
 
@@ -1182,23 +1469,20 @@ OpaqueTQ3Object::GetLeafObject ( void )
 E3ClassInfoPtr
 E3ClassTree::GetClass ( TQ3ObjectType classType )
 	{
-	E3GlobalsPtr theGlobals = E3Globals_Get () ;
-
-
-
 	// Validate our parameters
 	Q3_REQUIRE_OR_RESULT(classType != kQ3ObjectTypeInvalid, nullptr);
 
 
 
-	// We can't find anything if we don't have a tree
-	if ( theGlobals->classTree == nullptr )
+	// We can't find anything if we don't have an index
+	const E3ClassIndex *theIndex = sClassIndex.load ( std::memory_order_acquire ) ;
+	if ( theIndex == nullptr )
 		return nullptr ;
 
 
 
 	// Find the class
-	return (E3ClassInfoPtr) E3HashTable_Find ( theGlobals->classTree, classType ) ;
+	return e3classtree_index_slot ( theIndex, classType )->theClass.load ( std::memory_order_acquire ) ;
 	}
 
 
@@ -1208,33 +1492,35 @@ E3ClassTree::GetClass ( TQ3ObjectType classType )
 //=============================================================================
 //      E3ClassTree_GetClassByName : Find a node in the tree by name.
 //-----------------------------------------------------------------------------
-//		Note :	NB - the class tree is implemented as a hash table, keyed off
-//				the class type. This means that searches by name are very much
-//				sub-optimal, and are implemented as a linear search.
+//		Note :	NB - the class index is keyed off the class type. This means
+//				that searches by name are very much sub-optimal, and are
+//				implemented as a linear search of the index.
 //-----------------------------------------------------------------------------
 E3ClassInfoPtr
 E3ClassTree::GetClass ( const char *className )
 	{
-	E3GlobalsPtr theGlobals = E3Globals_Get () ;
-
-
-
 	// Validate our parameters
 	Q3_REQUIRE_OR_RESULT(Q3_VALID_PTR(className),                    nullptr);
 	Q3_REQUIRE_OR_RESULT(strlen(className) < kQ3StringMaximumLength, nullptr);
 
 
 
-	// Make sure we have a root
-	if ( theGlobals->classTreeRoot == nullptr )
+	// Make sure we have an index
+	const E3ClassIndex *theIndex = sClassIndex.load ( std::memory_order_acquire ) ;
+	if ( theIndex == nullptr )
 		return nullptr ;
 
 
 
-	// Find the class, starting at the root
-	E3ClassInfoPtr theClass = theGlobals->classTreeRoot->Find ( className ) ;
+	// Find the class
+	for ( TQ3Uns32 n = 0 ; n < theIndex->numSlots ; ++n )
+		{
+		E3ClassInfoPtr theClass = theIndex->theSlots [ n ].theClass.load ( std::memory_order_acquire ) ;
+		if ( theClass != nullptr && E3CString_IsEqual ( theIndex->theSlots [ n ].className.load ( std::memory_order_acquire ), className ) )
+			return theClass ;
+		}
 
-	return theClass ;
+	return nullptr ;
 	}
 
 
@@ -1455,9 +1741,12 @@ E3ClassInfo::GetNumInstances ( void )
 
 
 //=============================================================================
-//      E3ClassTree_GetMethod : Get a method for a class.
+//      E3ClassTree_GetDynamicMethod : Get a method for a class.
 //-----------------------------------------------------------------------------
-//		Note :	When looking for methods, we first check the method table for
+//		Note :	Called by GetMethod for method types which are not in the
+//				dense method table.
+//
+//				When looking for methods, we first check the method table for
 //				the class. If this fails, we call the class metahandler.
 //
 //				When calling the metahandler, we inherit methods that the class
@@ -1467,13 +1756,19 @@ E3ClassInfo::GetNumInstances ( void )
 //				it for the next time.
 //-----------------------------------------------------------------------------
 TQ3XFunctionPointer
-E3ClassInfo::GetMethod ( TQ3XMethodType methodType )
+E3ClassInfo::GetDynamicMethod ( TQ3XMethodType methodType )
 {
 	// Validate our parameters
 	Q3_REQUIRE_OR_RESULT(Q3_VALID_PTR(this), nullptr);
 
 
 
+	// Count the lookup
+	E3Globals_Get()->classDynamicLookups.fetch_add( 1, std::memory_order_relaxed );
+
+	std::lock_guard<std::recursive_mutex> treeLock( sClassTreeMutex );
+
+
 	// Find the method
 	//
 	// We first check the hash table for the class. If this fails, we invoke the
@@ -1531,6 +1826,12 @@ OpaqueTQ3Object::GetMethod ( TQ3XMethodType methodType )
 //				methods to the class tree's cache - this is because these
 //				objects go through a secondary metahandler, which needs to be
 //				queried by the renderer class itself.
+//
+//				Well-known methods replace the entry in the dense table, the
+//				rest are added to the hash table.  GetMethod reads the dense
+//				table without a lock, so its entries are stored with a
+//				release, and a method may be added while other threads use
+//				the class.
 //-----------------------------------------------------------------------------
 void
 E3ClassInfo::AddMethod ( TQ3XMethodType methodType, TQ3XFunctionPointer theMethod )
@@ -1540,7 +1841,19 @@ E3ClassInfo::AddMethod ( TQ3XMethodType methodType, TQ3XFunctionPointer theMetho
 
 
 
+	// Update the dense table if this is a well-known method
+	TQ3Int32 methodIndex = GetMethodIndex ( methodType ) ;
+	if ( methodIndex >= 0 )
+	{
+		denseMethods [ methodIndex ].store ( theMethod, std::memory_order_release ) ;
+		return ;
+	}
+
+
+
 	// Add the method to the hash table for the class
+	std::lock_guard<std::recursive_mutex> treeLock( sClassTreeMutex );
+
 	if (theMethod == nullptr)
 	{
 		E3HashTable_Add( methodTable, methodType, sMissingMethodPlaceholder );
@@ -1577,6 +1890,35 @@ E3ClassTree::AddMethod ( TQ3ObjectType classType, TQ3XMethodType methodType, TQ3
 
 
 
+//=============================================================================
+//      E3ClassTree_GetDynamicLookupCount : Get the dynamic lookup count.
+//-----------------------------------------------------------------------------
+//		Note :	Counts the calls to GetMethod which fell back to the method
+//				hash table, since the count was last reset.
+//-----------------------------------------------------------------------------
+TQ3Uns32
+E3ClassTree::GetDynamicLookupCount ( void )
+	{
+	return E3Globals_Get ()->classDynamicLookups ;
+	}
+
+
+
+
+
+//=============================================================================
+//      E3ClassTree_ResetDynamicLookupCount : Reset the dynamic lookup count.
+//-----------------------------------------------------------------------------
+void
+E3ClassTree::ResetDynamicLookupCount ( void )
+	{
+	E3Globals_Get ()->classDynamicLookups = 0 ;
+	}
+
+
+
+
+
 //=============================================================================
 //      E3ClassTree_Dump : Dump some stats on the class tree.
 //-----------------------------------------------------------------------------
@@ -1587,6 +1929,7 @@ void
 E3ClassTree::Dump ( void )
 	{
 	E3GlobalsPtr theGlobals = E3Globals_Get () ;
+	std::lock_guard<std::recursive_mutex> treeLock ( sClassTreeMutex ) ;
 
 
 
@@ -1619,6 +1962,9 @@ E3ClassTree::Dump ( void )
 	fprintf(theFile, "class tree, table size    = %lu\n",
 						(unsigned long)E3HashTable_GetTableSize(theGlobals->classTree));
 
+	fprintf(theFile, "class tree, dynamic method lookups = %lu\n",
+						(unsigned long)theGlobals->classDynamicLookups);
+
 
 
 	// Dump the class tree, starting at the root
@@ -50,6 +50,8 @@
 
 #include "E3HashTable.h"
 
+#include <atomic>
+
 
 //=============================================================================
 //		C++ preamble
@@ -73,6 +75,120 @@ enum
 	} ;
 
 
+// Well-known method types which are called on hot paths.
+//
+// These are resolved into a dense per-class table when the class is
+// registered, so that GetMethod can index them directly rather than going
+// through the method hash table. Renderers are queried with object types as
+// method types (see e3renderer_add_methods), so those are listed too.
+#define E3_DENSE_METHOD_TYPES(_m)												\
+	_m ( ObjectRead,							kQ3XMethodTypeObjectRead )						\
+	_m ( ObjectReadData,						kQ3XMethodTypeObjectReadData )					\
+	_m ( ObjectReadDefault,						kQ3XMethodTypeObjectReadDefault )				\
+	_m ( ObjectTraverse,						kQ3XMethodTypeObjectTraverse )					\
+	_m ( ObjectWrite,							kQ3XMethodTypeObjectWrite )						\
+	_m ( AttributeInherit,						kQ3XMethodTypeAttributeInherit )				\
+	_m ( AttributeCopyInherit,					kQ3XMethodTypeAttributeCopyInherit )			\
+	_m ( GeomUsesSubdivision,					kQ3XMethodTypeGeomUsesSubdivision )				\
+	_m ( GeomUsesOrientation,					kQ3XMethodTypeGeomUsesOrientation )				\
+	_m ( StorageReadData,						kQ3XMethodTypeStorageReadData )					\
+	_m ( StorageWriteData,						kQ3XMethodTypeStorageWriteData )				\
+	_m ( FFormatInt8Read,						kQ3XMethodTypeFFormatInt8Read )					\
+	_m ( FFormatInt16Read,						kQ3XMethodTypeFFormatInt16Read )				\
+	_m ( FFormatInt32Read,						kQ3XMethodTypeFFormatInt32Read )				\
+	_m ( FFormatInt64Read,						kQ3XMethodTypeFFormatInt64Read )				\
+	_m ( FFormatFloat32Read,					kQ3XMethodTypeFFormatFloat32Read )				\
+	_m ( FFormatFloat64Read,					kQ3XMethodTypeFFormatFloat64Read )				\
+	_m ( FFormatRawRead,						kQ3XMethodTypeFFormatRawRead )					\
+	_m ( FFormatInt8ReadArray,					kQ3XMethodTypeFFormatInt8ReadArray )			\
+	_m ( FFormatInt16ReadArray,					kQ3XMethodTypeFFormatInt16ReadArray )			\
+	_m ( FFormatInt32ReadArray,					kQ3XMethodTypeFFormatInt32ReadArray )			\
+	_m ( FFormatFloat32ReadArray,				kQ3XMethodTypeFFormatFloat32ReadArray )			\
+	_m ( FFormatInt8Write,						kQ3XMethodTypeFFormatInt8Write )				\
+	_m ( FFormatInt16Write,						kQ3XMethodTypeFFormatInt16Write )				\
+	_m ( FFormatInt32Write,						kQ3XMethodTypeFFormatInt32Write )				\
+	_m ( FFormatInt64Write,						kQ3XMethodTypeFFormatInt64Write )				\
+	_m ( FFormatFloat32Write,					kQ3XMethodTypeFFormatFloat32Write )				\
+	_m ( FFormatFloat64Write,					kQ3XMethodTypeFFormatFloat64Write )				\
+	_m ( FFormatRawWrite,						kQ3XMethodTypeFFormatRawWrite )					\
+	_m ( RendererStartFrame,					kQ3XMethodTypeRendererStartFrame )				\
+	_m ( RendererStartPass,						kQ3XMethodTypeRendererStartPass )				\
+	_m ( RendererEndPass,						kQ3XMethodTypeRendererEndPass )					\
+	_m ( RendererFlushFrame,					kQ3XMethodTypeRendererFlushFrame )				\
+	_m ( RendererEndFrame,						kQ3XMethodTypeRendererEndFrame )				\
+	_m ( RendererIsBoundingBoxVisible,			kQ3XMethodTypeRendererIsBoundingBoxVisible )	\
+	_m ( RendererMatrixLocalToWorld,			kQ3XMethodTypeRendererUpdateMatrixLocalToWorld )					\
+	_m ( RendererMatrixLocalToWorldInverse,		kQ3XMethodTypeRendererUpdateMatrixLocalToWorldInverse )			\
+	_m ( RendererMatrixLocalToWorldInverseTranspose,	kQ3XMethodTypeRendererUpdateMatrixLocalToWorldInverseTranspose ) \
+	_m ( RendererMatrixLocalToCamera,			kQ3XMethodTypeRendererUpdateMatrixLocalToCamera )					\
+	_m ( RendererMatrixLocalToFrustum,			kQ3XMethodTypeRendererUpdateMatrixLocalToFrustum )				\
+	_m ( RendererMatrixWorldToCamera,			kQ3XMethodTypeRendererUpdateMatrixWorldToCamera )					\
+	_m ( RendererMatrixWorldToFrustum,			kQ3XMethodTypeRendererUpdateMatrixWorldToFrustum )				\
+	_m ( RendererMatrixCameraToFrustum,			kQ3XMethodTypeRendererUpdateMatrixCameraToFrustum )				\
+	_m ( GeometryBox,							kQ3GeometryTypeBox )							\
+	_m ( GeometryCone,							kQ3GeometryTypeCone )							\
+	_m ( GeometryCylinder,						kQ3GeometryTypeCylinder )						\
+	_m ( GeometryDisk,							kQ3GeometryTypeDisk )							\
+	_m ( GeometryEllipse,						kQ3GeometryTypeEllipse )						\
+	_m ( GeometryEllipsoid,						kQ3GeometryTypeEllipsoid )						\
+	_m ( GeometryGeneralPolygon,				kQ3GeometryTypeGeneralPolygon )					\
+	_m ( GeometryLine,							kQ3GeometryTypeLine )							\
+	_m ( GeometryMarker,						kQ3GeometryTypeMarker )							\
+	_m ( GeometryMesh,							kQ3GeometryTypeMesh )							\
+	_m ( GeometryNURBCurve,						kQ3GeometryTypeNURBCurve )						\
+	_m ( GeometryNURBPatch,						kQ3GeometryTypeNURBPatch )						\
+	_m ( GeometryPixmapMarker,					kQ3GeometryTypePixmapMarker )					\
+	_m ( GeometryPoint,							kQ3GeometryTypePoint )							\
+	_m ( GeometryPolyLine,						kQ3GeometryTypePolyLine )						\
+	_m ( GeometryPolygon,						kQ3GeometryTypePolygon )						\
+	_m ( GeometryPolyhedron,					kQ3GeometryTypePolyhedron )						\
+	_m ( GeometryTorus,							kQ3GeometryTypeTorus )							\
+	_m ( GeometryTriangle,						kQ3GeometryTypeTriangle )						\
+	_m ( GeometryTriGrid,						kQ3GeometryTypeTriGrid )						\
+	_m ( GeometryTriMesh,						kQ3GeometryTypeTriMesh )						\
+	_m ( AttributeSurfaceUV,					kQ3AttributeTypeSurfaceUV )						\
+	_m ( AttributeShadingUV,					kQ3AttributeTypeShadingUV )						\
+	_m ( AttributeNormal,						kQ3AttributeTypeNormal )						\
+	_m ( AttributeAmbientCoefficient,			kQ3AttributeTypeAmbientCoefficient )			\
+	_m ( AttributeDiffuseColor,					kQ3AttributeTypeDiffuseColor )					\
+	_m ( AttributeSpecularColor,				kQ3AttributeTypeSpecularColor )					\
+	_m ( AttributeSpecularControl,				kQ3AttributeTypeSpecularControl )				\
+	_m ( AttributeTransparencyColor,			kQ3AttributeTypeTransparencyColor )				\
+	_m ( AttributeSurfaceTangent,				kQ3AttributeTypeSurfaceTangent )				\
+	_m ( AttributeHighlightState,				kQ3AttributeTypeHighlightState )				\
+	_m ( AttributeSurfaceShader,				kQ3AttributeTypeSurfaceShader )					\
+	_m ( AttributeEmissiveColor,				kQ3AttributeTypeEmissiveColor )					\
+	_m ( AttributeMetallic,						kQ3AttributeTypeMetallic )						\
+	_m ( ShaderSurface,							kQ3ShaderTypeSurface )							\
+	_m ( ShaderIllumination,					kQ3ShaderTypeIllumination )						\
+	_m ( StyleBackfacing,						kQ3StyleTypeBackfacing )						\
+	_m ( StyleInterpolation,					kQ3StyleTypeInterpolation )						\
+	_m ( StyleFill,								kQ3StyleTypeFill )								\
+	_m ( StylePickID,							kQ3StyleTypePickID )							\
+	_m ( StyleCastShadows,						kQ3StyleTypeCastShadows )						\
+	_m ( StyleReceiveShadows,					kQ3StyleTypeReceiveShadows )					\
+	_m ( StyleHighlight,						kQ3StyleTypeHighlight )							\
+	_m ( StyleSubdivision,						kQ3StyleTypeSubdivision )						\
+	_m ( StyleOrientation,						kQ3StyleTypeOrientation )						\
+	_m ( StylePickParts,						kQ3StyleTypePickParts )							\
+	_m ( StyleAntiAlias,						kQ3StyleTypeAntiAlias )							\
+	_m ( StyleFog,								kQ3StyleTypeFog )								\
+	_m ( StyleFogExtended,						kQ3StyleTypeFogExtended )						\
+	_m ( StyleLineWidth,						kQ3StyleTypeLineWidth )
+
+
+// Indices into the dense method table
+#define E3_DENSE_METHOD_INDEX(_name, _type)		kE3MethodIndex##_name ,
+
+enum E3MethodIndex
+	{
+	E3_DENSE_METHOD_TYPES ( E3_DENSE_METHOD_INDEX )
+	kE3MethodIndexCount
+	} ;
+
+#undef E3_DENSE_METHOD_INDEX
+
+
 
 //=============================================================================
 //      Types
@@ -104,8 +220,9 @@ class E3ClassInfo
 									// a default version which did nothing.
 
 
-	// Instances
-	TQ3Uns32			numInstances ;
+	// Instances (counted atomically, since objects of a class may be
+	// created and destroyed on several threads at once)
+	std::atomic<TQ3Uns32>	numInstances ;
 	TQ3Uns32			instanceSize ; // Includes all parents instance data
 	TQ3Uns32			deltaInstanceSize;
 	// deltaInstanceSize is intended to be the size of the instance data that is
@@ -125,6 +242,12 @@ class E3ClassInfo
 	TQ3ObjectType		ownAndParentTypes [ kQ3MaxBuiltInClassHierarchyDepth ] ;
 	
 	TQ3XObjectRegisterMethod	registerMethod ;
+	
+	// Well-known methods.  AddMethod can replace one while other threads
+	// look it up without a lock, so the slots are atomic: the store is a
+	// release and the load an acquire, so whoever sees the new method also
+	// sees everything its installer wrote before installing it.
+	std::atomic<TQ3XFunctionPointer>	denseMethods [ kE3MethodIndexCount ] ;
 
 	// This is the last of the normal class data
 	// In memory, this is followed by the method data of each sub-class
@@ -132,8 +255,8 @@ class E3ClassInfo
 	
 	static TQ3Status	Attach ( E3ClassInfoPtr theChild, E3ClassInfoPtr theParent ) ;
 	void				Detach ( void ) ;	
-	E3ClassInfoPtr		Find ( const char *className ) ;
 	void				Dump_Class ( FILE *theFile, TQ3Uns32 indent ) ;
+	TQ3XFunctionPointer	GetDynamicMethod ( TQ3XMethodType methodType ) ;
 						E3ClassInfo ( void ) ; // Not used. Private so nobody can forget to call the normal constructor
 public :
 
@@ -156,7 +279,14 @@ public :
 	TQ3XMetaHandler		GetMetaHandler ( void ) ;
 	TQ3Uns32			GetInstanceSize ( void ) ;
 	TQ3Uns32			GetNumInstances ( void ) ;
-	TQ3XFunctionPointer GetMethod ( TQ3XMethodType methodType ) ;
+	TQ3XFunctionPointer GetMethod ( TQ3XMethodType methodType )
+		{
+		TQ3Int32 methodIndex = GetMethodIndex ( methodType ) ;
+		if ( methodIndex >= 0 )
+			return denseMethods [ methodIndex ].load ( std::memory_order_acquire ) ;
+		return GetDynamicMethod ( methodType ) ;
+		}
+	static TQ3Int32		GetMethodIndex ( TQ3XMethodType methodType ) ;
 	void				AddMethod ( TQ3XMethodType methodType, TQ3XFunctionPointer theMethod ) ;
 	TQ3Object			CreateInstance ( TQ3Boolean sharedParams, const void* paramData ) ;
 	void				SetAbstract ( void ) { abstract = kQ3True ; }
@@ -207,6 +337,11 @@ public :
 	static void				Dump ( void ) ;
 
 
+	// Count the method lookups which missed the dense method table
+	static TQ3Uns32			GetDynamicLookupCount ( void ) ;
+	static void				ResetDynamicLookupCount ( void ) ;
+
+
 	
 	friend class E3ClassInfo ;
 	} ;
@@ -0,0 +1,230 @@
+/*  NAME:
+        E3EdgeAdjacency.cpp
+
+    DESCRIPTION:
+        Linear-time edge adjacency for triangle lists.
+
+    COPYRIGHT:
+        Copyright (c) 2026, Quesa Developers. All rights reserved.
+
+        For the current release of Quesa, please see:
+
+            <https://github.com/jwwalker/Quesa>
+        
+        Redistribution and use in source and binary forms, with or without
+        modification, are permitted provided that the following conditions
+        are met:
+        
+            o Redistributions of source code must retain the above copyright
+              notice, this list of conditions and the following disclaimer.
+        
+            o Redistributions in binary form must reproduce the above
+              copyright notice, this list of conditions and the following
+              disclaimer in the documentation and/or other materials provided
+              with the distribution.
+        
+            o Neither the name of Quesa nor the names of its contributors
+              may be used to endorse or promote products derived from this
+              software without specific prior written permission.
+        
+        THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+        "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+        LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+        A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+        OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+        SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+        TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+        PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+        LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+        NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+        SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+    ___________________________________________________________________________
+*/
+
+
+
+
+//=============================================================================
+//      Include files
+//-----------------------------------------------------------------------------
+#include "E3EdgeAdjacency.h"
+
+#include <algorithm>
+
+
+
+//=============================================================================
+//      Internal constants
+//-----------------------------------------------------------------------------
+namespace
+{
+	const TQ3Uns32	kInvalidIndex	= 0xFFFFFFFFU;
+}
+
+
+
+//=============================================================================
+//      Internal functions
+//-----------------------------------------------------------------------------
+//      e3edgeadjacency_half_edge_end : Point index at the end of a half edge.
+//-----------------------------------------------------------------------------
+static inline TQ3Uns32
+e3edgeadjacency_half_edge_end( const TQ3Uns32* inFaces, TQ3Uns32 inHalfEdge )
+{
+	TQ3Uns32	theSide = inHalfEdge % 3;
+	return inFaces[ inHalfEdge - theSide + (theSide + 1) % 3 ];
+}
+
+
+
+
+
+//=============================================================================
+//      Public functions
+//-----------------------------------------------------------------------------
+//      E3EdgeAdjacency_Build : Find the distinct edges of a triangle list.
+//-----------------------------------------------------------------------------
+//		Note :	Each half edge is put in the bucket of its smaller point index
+//				by a counting sort.  Within a bucket, the edge for each larger
+//				point index is found through a table indexed by point, which
+//				is stamped with the bucket rather than cleared between buckets.
+//				A second counting sort then groups the half edges by edge.
+//-----------------------------------------------------------------------------
+void
+E3EdgeAdjacency_Build( TQ3Uns32 inNumFaces,
+					const TQ3Uns32* inFaces,
+					TE3EdgeAdjacency& outAdjacency )
+{
+	const TQ3Uns32	kNumHalfEdges = 3 * inNumFaces;
+	TQ3Uns32		i, j;
+	
+	outAdjacency.edgeEnds.clear();
+	outAdjacency.halfEdgeToEdge.resize( kNumHalfEdges );
+	outAdjacency.edgeHalfEdges.resize( kNumHalfEdges );
+	outAdjacency.edgeHalfEdgeStart.clear();
+	
+	if (inNumFaces == 0)
+	{
+		outAdjacency.edgeHalfEdgeStart.push_back( 0 );
+		return;
+	}
+	
+	TQ3Uns32	numPoints = 1 + *std::max_element( inFaces, inFaces + kNumHalfEdges );
+	
+	
+	
+	// Bucket the half edges by their smaller point index
+	std::vector<TQ3Uns32>	bucketStart( numPoints + 1, 0 );
+	std::vector<TQ3Uns32>	bucketed( kNumHalfEdges );
+	
+	for (i = 0; i < kNumHalfEdges; ++i)
+	{
+		TQ3Uns32	lowPt = std::min( inFaces[i],
+			e3edgeadjacency_half_edge_end( inFaces, i ) );
+		bucketStart[ lowPt + 1 ] += 1;
+	}
+	
+	for (i = 0; i < numPoints; ++i)
+	{
+		bucketStart[ i + 1 ] += bucketStart[ i ];
+	}
+	
+	std::vector<TQ3Uns32>	bucketFill( bucketStart.begin(), bucketStart.end() - 1 );
+	
+	for (i = 0; i < kNumHalfEdges; ++i)
+	{
+		TQ3Uns32	lowPt = std::min( inFaces[i],
+			e3edgeadjacency_half_edge_end( inFaces, i ) );
+		bucketed[ bucketFill[ lowPt ]++ ] = i;
+	}
+	
+	
+	
+	// Match the larger point index within each bucket.  bucketFill is
+	// reused as the stamp table, since it is no longer needed.
+	std::vector<TQ3Uns32>&	stampOfPoint( bucketFill );
+	std::vector<TQ3Uns32>	edgeOfPoint( numPoints );
+	std::fill( stampOfPoint.begin(), stampOfPoint.end(), kInvalidIndex );
+	outAdjacency.edgeEnds.reserve( kNumHalfEdges );
+	
+	for (i = 0; i < numPoints; ++i)
+	{
+		for (j = bucketStart[ i ]; j < bucketStart[ i + 1 ]; ++j)
+		{
+			TQ3Uns32	halfEdge = bucketed[ j ];
+			TQ3Uns32	highPt = std::max( inFaces[ halfEdge ],
+				e3edgeadjacency_half_edge_end( inFaces, halfEdge ) );
+			
+			if (stampOfPoint[ highPt ] != i)
+			{
+				stampOfPoint[ highPt ] = i;
+				edgeOfPoint[ highPt ] = static_cast<TQ3Uns32>(
+					outAdjacency.edgeEnds.size() / 2 );
+				outAdjacency.edgeEnds.push_back( i );
+				outAdjacency.edgeEnds.push_back( highPt );
+			}
+			
+			outAdjacency.halfEdgeToEdge[ halfEdge ] = edgeOfPoint[ highPt ];
+		}
+	}
+	
+	
+	
+	// Group the half edges by edge
+	const TQ3Uns32	kNumEdges = static_cast<TQ3Uns32>( outAdjacency.edgeEnds.size() / 2 );
+	std::vector<TQ3Uns32>&	edgeStart( outAdjacency.edgeHalfEdgeStart );
+	edgeStart.assign( kNumEdges + 1, 0 );
+	
+	for (i = 0; i < kNumHalfEdges; ++i)
+	{
+		edgeStart[ outAdjacency.halfEdgeToEdge[ i ] + 1 ] += 1;
+	}
+	
+	for (i = 0; i < kNumEdges; ++i)
+	{
+		edgeStart[ i + 1 ] += edgeStart[ i ];
+	}
+	
+	std::vector<TQ3Uns32>	edgeFill( edgeStart.begin(), edgeStart.end() - 1 );
+	
+	for (i = 0; i < kNumHalfEdges; ++i)
+	{
+		outAdjacency.edgeHalfEdges[ edgeFill[ outAdjacency.halfEdgeToEdge[ i ] ]++ ] = i;
+	}
+}
+
+
+
+
+
+//=============================================================================
+//      E3EdgeAdjacency_Classify : Classify an edge by the faces that use it.
+//-----------------------------------------------------------------------------
+TE3EdgeKind
+E3EdgeAdjacency_Classify( const TE3EdgeAdjacency& inAdjacency,
+					const TQ3Uns32* inFaces,
+					TQ3Uns32 inEdge )
+{
+	TQ3Uns32	theStart = inAdjacency.edgeHalfEdgeStart[ inEdge ];
+	TQ3Uns32	theCount = inAdjacency.edgeHalfEdgeStart[ inEdge + 1 ] - theStart;
+	TE3EdgeKind	theKind;
+	
+	if (theCount == 1)
+	{
+		theKind = kE3EdgeKindBoundary;
+	}
+	else if (theCount == 2)
+	{
+		bool	flipA = E3EdgeAdjacency_IsFlipped( inFaces,
+			inAdjacency.edgeHalfEdges[ theStart ] );
+		bool	flipB = E3EdgeAdjacency_IsFlipped( inFaces,
+			inAdjacency.edgeHalfEdges[ theStart + 1 ] );
+		theKind = (flipA != flipB)? kE3EdgeKindManifold : kE3EdgeKindInconsistent;
+	}
+	else
+	{
+		theKind = kE3EdgeKindNonManifold;
+	}
+	
+	return theKind;
+}
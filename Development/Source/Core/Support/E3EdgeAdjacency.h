@@ -0,0 +1,153 @@
+#pragma once
+/*  NAME:
+        E3EdgeAdjacency.h
+
+    DESCRIPTION:
+        Header file for E3EdgeAdjacency.cpp.
+
+    COPYRIGHT:
+        Copyright (c) 2026, Quesa Developers. All rights reserved.
+
+        For the current release of Quesa, please see:
+
+            <https://github.com/jwwalker/Quesa>
+        
+        Redistribution and use in source and binary forms, with or without
+        modification, are permitted provided that the following conditions
+        are met:
+        
+            o Redistributions of source code must retain the above copyright
+              notice, this list of conditions and the following disclaimer.
+        
+            o Redistributions in binary form must reproduce the above
+              copyright notice, this list of conditions and the following
+              disclaimer in the documentation and/or other materials provided
+              with the distribution.
+        
+            o Neither the name of Quesa nor the names of its contributors
+              may be used to endorse or promote products derived from this
+              software without specific prior written permission.
+        
+        THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+        "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+        LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+        A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+        OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+        SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+        TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+        PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+        LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+        NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+        SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+    ___________________________________________________________________________
+*/
+
+
+
+
+
+
+
+
+//=============================================================================
+//      Include files
+//-----------------------------------------------------------------------------
+#include "E3Prefix.h"
+
+#include <vector>
+
+
+
+//=============================================================================
+//      Types
+//-----------------------------------------------------------------------------
+/*!
+	@enum		TE3EdgeKind
+	@abstract	Classification of an edge by the faces that use it.
+	@constant	kE3EdgeKindBoundary			One face uses the edge.
+	@constant	kE3EdgeKindManifold			Two faces use the edge, in opposite
+											directions.
+	@constant	kE3EdgeKindInconsistent		Two faces use the edge in the same
+											direction, so their orientations
+											disagree.
+	@constant	kE3EdgeKindNonManifold		More than two faces use the edge.
+*/
+enum TE3EdgeKind
+{
+	kE3EdgeKindBoundary,
+	kE3EdgeKindManifold,
+	kE3EdgeKindInconsistent,
+	kE3EdgeKindNonManifold
+};
+
+
+/*!
+	@struct		TE3EdgeAdjacency
+	@abstract	The distinct edges of a triangle list, and the half edges of
+				each.
+	@discussion	Half edge 3 * f + k is side k of face f, running from corner k
+				to corner (k + 1) % 3.  Edge e joins the points
+				edgeEnds[2*e] <= edgeEnds[2*e+1], and its half edges are
+				edgeHalfEdges[ edgeHalfEdgeStart[e] ] up to but not including
+				edgeHalfEdges[ edgeHalfEdgeStart[e+1] ].
+*/
+struct TE3EdgeAdjacency
+{
+	std::vector<TQ3Uns32>	edgeEnds;
+	std::vector<TQ3Uns32>	halfEdgeToEdge;
+	std::vector<TQ3Uns32>	edgeHalfEdgeStart;
+	std::vector<TQ3Uns32>	edgeHalfEdges;
+};
+
+
+
+//=============================================================================
+//      Function prototypes
+//-----------------------------------------------------------------------------
+/*!
+	@function	E3EdgeAdjacency_Build
+	@abstract	Find the distinct edges of a triangle list.
+	@discussion	Half edges are bucketed by their smaller point index with a
+				counting sort, and matched by their larger point index within
+				each bucket, so the time taken is linear in the number of
+				faces and points.
+				
+				May throw std::bad_alloc.
+	@param		inNumFaces		Number of faces.
+	@param		inFaces			Point indices of the faces, 3 per face.
+	@param		outAdjacency	Receives the edges.
+*/
+void	E3EdgeAdjacency_Build( TQ3Uns32 inNumFaces,
+					const TQ3Uns32* inFaces,
+					TE3EdgeAdjacency& outAdjacency );
+
+
+/*!
+	@function	E3EdgeAdjacency_IsFlipped
+	@abstract	Test whether a half edge runs from the larger point index to
+				the smaller.
+	@discussion	The half edges of a manifold edge are one flipped and one not.
+	@param		inFaces			Point indices of the faces, 3 per face.
+	@param		inHalfEdge		A half edge.
+	@result		True if the half edge is flipped.
+*/
+inline bool	E3EdgeAdjacency_IsFlipped( const TQ3Uns32* inFaces,
+					TQ3Uns32 inHalfEdge )
+{
+	TQ3Uns32	theSide = inHalfEdge % 3;
+	TQ3Uns32	theFace = inHalfEdge - theSide;
+	return inFaces[ inHalfEdge ] > inFaces[ theFace + (theSide + 1) % 3 ];
+}
+
+
+/*!
+	@function	E3EdgeAdjacency_Classify
+	@abstract	Classify an edge by the faces that use it.
+	@param		inAdjacency		Edges built by E3EdgeAdjacency_Build.
+	@param		inFaces			The faces passed to E3EdgeAdjacency_Build.
+	@param		inEdge			An edge index.
+	@result		The kind of edge.
+*/
+TE3EdgeKind	E3EdgeAdjacency_Classify( const TE3EdgeAdjacency& inAdjacency,
+					const TQ3Uns32* inFaces,
+					TQ3Uns32 inEdge );
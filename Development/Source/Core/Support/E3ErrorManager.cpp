@@ -61,23 +61,24 @@
 //-----------------------------------------------------------------------------
 void
 E3ErrorManager_PostError(TQ3Error theError, TQ3Boolean isFatal)
-{	E3GlobalsPtr	theGlobals = E3Globals_Get();
+{	E3GlobalsPtr		theGlobals    = E3Globals_Get();
+	E3ThreadGlobalsPtr	threadGlobals = E3Globals_GetThread();
 
 
 
 	// Update our state
-	if (theGlobals->errMgrOldestError == kQ3ErrorNone)
-		theGlobals->errMgrOldestError = theError;
+	if (threadGlobals->errMgrOldestError == kQ3ErrorNone)
+		threadGlobals->errMgrOldestError = theError;
 	
-	theGlobals->errMgrIsFatalError = isFatal;
-	theGlobals->errMgrLatestError  = theError;
+	threadGlobals->errMgrIsFatalError = isFatal;
+	threadGlobals->errMgrLatestError  = theError;
 
 
 
 	// Call the handler
 	if (theGlobals->errMgrHandlerFuncError != nullptr)
-		theGlobals->errMgrHandlerFuncError(theGlobals->errMgrOldestError,
-										   theGlobals->errMgrLatestError,
+		theGlobals->errMgrHandlerFuncError(threadGlobals->errMgrOldestError,
+										   threadGlobals->errMgrLatestError,
 										   theGlobals->errMgrHandlerDataError);
 }
 
@@ -90,22 +91,23 @@ E3ErrorManager_PostError(TQ3Error theError, TQ3Boolean isFatal)
 //-----------------------------------------------------------------------------
 void
 E3ErrorManager_PostWarning(TQ3Warning theWarning)
-{	E3GlobalsPtr	theGlobals = E3Globals_Get();
+{	E3GlobalsPtr		theGlobals    = E3Globals_Get();
+	E3ThreadGlobalsPtr	threadGlobals = E3Globals_GetThread();
 
 
 
 	// Update our state
-	if (theGlobals->errMgrOldestWarning == kQ3WarningNone)
-		theGlobals->errMgrOldestWarning = theWarning;
+	if (threadGlobals->errMgrOldestWarning == kQ3WarningNone)
+		threadGlobals->errMgrOldestWarning = theWarning;
 	
-	theGlobals->errMgrLatestWarning = theWarning;
+	threadGlobals->errMgrLatestWarning = theWarning;
 
 
 
 	// Call the handler
 	if (theGlobals->errMgrHandlerFuncWarning != nullptr)
-		theGlobals->errMgrHandlerFuncWarning(theGlobals->errMgrOldestWarning,
-											 theGlobals->errMgrLatestWarning,
+		theGlobals->errMgrHandlerFuncWarning(threadGlobals->errMgrOldestWarning,
+											 threadGlobals->errMgrLatestWarning,
 											 theGlobals->errMgrHandlerDataWarning);
 }
 
@@ -118,23 +120,24 @@ E3ErrorManager_PostWarning(TQ3Warning theWarning)
 //-----------------------------------------------------------------------------
 void
 E3ErrorManager_PostNotice(TQ3Notice theNotice)
-{	E3GlobalsPtr	theGlobals = E3Globals_Get();
+{	E3ThreadGlobalsPtr	threadGlobals = E3Globals_GetThread();
 
 
 
 	// Update our state
-	if (theGlobals->errMgrOldestNotice == kQ3NoticeNone)
-		theGlobals->errMgrOldestNotice = theNotice;
+	if (threadGlobals->errMgrOldestNotice == kQ3NoticeNone)
+		threadGlobals->errMgrOldestNotice = theNotice;
 	
-	theGlobals->errMgrLatestNotice = theNotice;
+	threadGlobals->errMgrLatestNotice = theNotice;
 
 
 
 	// Call the handler in debug builds (notices are not posted in release builds)
 	#if Q3_DEBUG
+	E3GlobalsPtr theGlobals = E3Globals_Get();
 	if (theGlobals->errMgrHandlerFuncNotice != nullptr)
-		theGlobals->errMgrHandlerFuncNotice(theGlobals->errMgrOldestNotice,
-											theGlobals->errMgrLatestNotice,
+		theGlobals->errMgrHandlerFuncNotice(threadGlobals->errMgrOldestNotice,
+											threadGlobals->errMgrLatestNotice,
 											theGlobals->errMgrHandlerDataNotice);
 	#endif
 }
@@ -148,15 +151,16 @@ E3ErrorManager_PostNotice(TQ3Notice theNotice)
 //-----------------------------------------------------------------------------
 void
 E3ErrorManager_PostPlatformError(TQ3Uns32 theError)
-{	E3GlobalsPtr	theGlobals = E3Globals_Get();
+{	E3GlobalsPtr		theGlobals    = E3Globals_Get();
+	E3ThreadGlobalsPtr	threadGlobals = E3Globals_GetThread();
 
 
 
 	// Update our state
-	if (theGlobals->errMgrOldestPlatform == 0)
-		theGlobals->errMgrOldestPlatform = theError;
+	if (threadGlobals->errMgrOldestPlatform == 0)
+		threadGlobals->errMgrOldestPlatform = theError;
 	
-	theGlobals->errMgrLatestPlatform = theError;
+	threadGlobals->errMgrLatestPlatform = theError;
 
 
 
@@ -171,8 +175,8 @@ E3ErrorManager_PostPlatformError(TQ3Uns32 theError)
 	// When this API is made public, apps will be able to listen directly
 	// to platform specific errors.
 	if (theGlobals->errMgrHandlerFuncPlatform != nullptr)
-		theGlobals->errMgrHandlerFuncPlatform((TQ3Error) theGlobals->errMgrOldestPlatform,
-											  (TQ3Error) theGlobals->errMgrLatestPlatform,
+		theGlobals->errMgrHandlerFuncPlatform((TQ3Error) threadGlobals->errMgrOldestPlatform,
+											  (TQ3Error) threadGlobals->errMgrLatestPlatform,
 											  theGlobals->errMgrHandlerDataPlatform);
 	else
 		E3ErrorManager_PostError(
@@ -201,7 +205,7 @@ E3ErrorManager_PostPlatformError(TQ3Uns32 theError)
 //-----------------------------------------------------------------------------
 TQ3Boolean
 E3ErrorManager_GetIsFatalError(TQ3Error theError)
-{	E3GlobalsPtr	theGlobals = E3Globals_Get();
+{	E3ThreadGlobalsPtr	threadGlobals = E3Globals_GetThread();
 
 
 
@@ -212,7 +216,7 @@ E3ErrorManager_GetIsFatalError(TQ3Error theError)
 
 
 	// If this error isn't fatal, see if we've hit one which is
-	return(theGlobals->errMgrIsFatalError);
+	return(threadGlobals->errMgrIsFatalError);
 }
 
 
@@ -226,22 +230,22 @@ E3ErrorManager_GetIsFatalError(TQ3Error theError)
 //-----------------------------------------------------------------------------
 void
 E3ErrorManager_GetError(TQ3Error *oldestError, TQ3Error *latestError)
-{	E3GlobalsPtr	theGlobals = E3Globals_Get();
+{	E3ThreadGlobalsPtr	threadGlobals = E3Globals_GetThread();
 
 
 
 	// Return the requested state
 	if (oldestError != nullptr)
-		*oldestError = theGlobals->errMgrOldestError;
+		*oldestError = threadGlobals->errMgrOldestError;
 
 	if (latestError != nullptr)
-		*latestError = theGlobals->errMgrLatestError;
+		*latestError = threadGlobals->errMgrLatestError;
 
 
 
 	// Set our flags
-	theGlobals->systemDoBottleneck = kQ3True;
-	theGlobals->errMgrClearError   = kQ3True;
+	threadGlobals->systemDoBottleneck = kQ3True;
+	threadGlobals->errMgrClearError   = kQ3True;
 }
 
 
@@ -255,22 +259,22 @@ E3ErrorManager_GetError(TQ3Error *oldestError, TQ3Error *latestError)
 //-----------------------------------------------------------------------------
 void
 E3ErrorManager_GetWarning(TQ3Warning *oldestWarning, TQ3Warning *latestWarning)
-{	E3GlobalsPtr	theGlobals = E3Globals_Get();
+{	E3ThreadGlobalsPtr	threadGlobals = E3Globals_GetThread();
 
 
 
 	// Return the requested state
 	if (oldestWarning != nullptr)
-		*oldestWarning = theGlobals->errMgrOldestWarning;
+		*oldestWarning = threadGlobals->errMgrOldestWarning;
 
 	if (latestWarning != nullptr)
-		*latestWarning = theGlobals->errMgrLatestWarning;
+		*latestWarning = threadGlobals->errMgrLatestWarning;
 
 
 
 	// Set our flags
-	theGlobals->systemDoBottleneck = kQ3True;
-	theGlobals->errMgrClearWarning = kQ3True;
+	threadGlobals->systemDoBottleneck = kQ3True;
+	threadGlobals->errMgrClearWarning = kQ3True;
 }
 
 
@@ -284,22 +288,22 @@ E3ErrorManager_GetWarning(TQ3Warning *oldestWarning, TQ3Warning *latestWarning)
 //-----------------------------------------------------------------------------
 void
 E3ErrorManager_GetNotice(TQ3Notice *oldestNotice, TQ3Notice *latestNotice)
-{	E3GlobalsPtr	theGlobals = E3Globals_Get();
+{	E3ThreadGlobalsPtr	threadGlobals = E3Globals_GetThread();
 
 
 
 	// Return the requested state
 	if (oldestNotice != nullptr)
-		*oldestNotice = theGlobals->errMgrOldestNotice;
+		*oldestNotice = threadGlobals->errMgrOldestNotice;
 
 	if (latestNotice != nullptr)
-		*latestNotice = theGlobals->errMgrLatestNotice;
+		*latestNotice = threadGlobals->errMgrLatestNotice;
 
 
 
 	// Set our flags
-	theGlobals->systemDoBottleneck = kQ3True;
-	theGlobals->errMgrClearNotice  = kQ3True;
+	threadGlobals->systemDoBottleneck = kQ3True;
+	threadGlobals->errMgrClearNotice  = kQ3True;
 }
 
 
@@ -313,22 +317,22 @@ E3ErrorManager_GetNotice(TQ3Notice *oldestNotice, TQ3Notice *latestNotice)
 //-----------------------------------------------------------------------------
 void
 E3ErrorManager_GetPlatformError(TQ3Uns32 *oldestPlatform, TQ3Uns32 *latestPlatform)
-{	E3GlobalsPtr	theGlobals = E3Globals_Get();
+{	E3ThreadGlobalsPtr	threadGlobals = E3Globals_GetThread();
 
 
 
 	// Return the requested state
 	if (oldestPlatform != nullptr)
-		*oldestPlatform = theGlobals->errMgrOldestPlatform;
+		*oldestPlatform = threadGlobals->errMgrOldestPlatform;
 
 	if (latestPlatform != nullptr)
-		*latestPlatform = theGlobals->errMgrLatestPlatform;
+		*latestPlatform = threadGlobals->errMgrLatestPlatform;
 
 
 
 	// Set our flags
-	theGlobals->systemDoBottleneck  = kQ3True;
-	theGlobals->errMgrClearPlatform = kQ3True;
+	threadGlobals->systemDoBottleneck  = kQ3True;
+	threadGlobals->errMgrClearPlatform = kQ3True;
 }
 
 
@@ -340,14 +344,14 @@ E3ErrorManager_GetPlatformError(TQ3Uns32 *oldestPlatform, TQ3Uns32 *latestPlatfo
 //-----------------------------------------------------------------------------
 void
 E3ErrorManager_ClearError(void)
-{	E3GlobalsPtr	theGlobals = E3Globals_Get();
+{	E3ThreadGlobalsPtr	threadGlobals = E3Globals_GetThread();
 
 
 
 	// Clear our state
-	theGlobals->errMgrClearError  	= kQ3False;
-	theGlobals->errMgrOldestError 	= kQ3ErrorNone;
-	theGlobals->errMgrLatestError 	= kQ3ErrorNone;
+	threadGlobals->errMgrClearError  	= kQ3False;
+	threadGlobals->errMgrOldestError 	= kQ3ErrorNone;
+	threadGlobals->errMgrLatestError 	= kQ3ErrorNone;
 }
 
 
@@ -359,14 +363,14 @@ E3ErrorManager_ClearError(void)
 //-----------------------------------------------------------------------------
 void
 E3ErrorManager_ClearWarning(void)
-{	E3GlobalsPtr	theGlobals = E3Globals_Get();
+{	E3ThreadGlobalsPtr	threadGlobals = E3Globals_GetThread();
 
 
 
 	// Clear our state
-	theGlobals->errMgrClearWarning  = kQ3False;
-	theGlobals->errMgrOldestWarning = kQ3WarningNone;
-	theGlobals->errMgrLatestWarning = kQ3WarningNone;
+	threadGlobals->errMgrClearWarning  = kQ3False;
+	threadGlobals->errMgrOldestWarning = kQ3WarningNone;
+	threadGlobals->errMgrLatestWarning = kQ3WarningNone;
 }
 
 
@@ -378,14 +382,14 @@ E3ErrorManager_ClearWarning(void)
 //-----------------------------------------------------------------------------
 void
 E3ErrorManager_ClearNotice(void)
-{	E3GlobalsPtr	theGlobals = E3Globals_Get();
+{	E3ThreadGlobalsPtr	threadGlobals = E3Globals_GetThread();
 
 
 
 	// Clear our state
-	theGlobals->errMgrClearNotice  = kQ3False;
-	theGlobals->errMgrOldestNotice = kQ3NoticeNone;
-	theGlobals->errMgrLatestNotice = kQ3NoticeNone;
+	threadGlobals->errMgrClearNotice  = kQ3False;
+	threadGlobals->errMgrOldestNotice = kQ3NoticeNone;
+	threadGlobals->errMgrLatestNotice = kQ3NoticeNone;
 }
 
 
@@ -397,14 +401,14 @@ E3ErrorManager_ClearNotice(void)
 //-----------------------------------------------------------------------------
 void
 E3ErrorManager_ClearPlatformError(void)
-{	E3GlobalsPtr	theGlobals = E3Globals_Get();
+{	E3ThreadGlobalsPtr	threadGlobals = E3Globals_GetThread();
 
 
 
 	// Clear our state
-	theGlobals->errMgrClearPlatform  = kQ3False;
-	theGlobals->errMgrOldestPlatform = 0;
-	theGlobals->errMgrLatestPlatform = 0;
+	threadGlobals->errMgrClearPlatform  = kQ3False;
+	threadGlobals->errMgrOldestPlatform = 0;
+	threadGlobals->errMgrLatestPlatform = 0;
 }
 
 
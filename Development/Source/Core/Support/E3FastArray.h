@@ -40,6 +40,8 @@
         SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
     ___________________________________________________________________________
 */
+#ifndef E3FASTARRAY_HDR
+#define E3FASTARRAY_HDR
 
 #include "E3Memory.h"
 #include <algorithm>
@@ -251,3 +253,5 @@ void	E3FastArray<T>::push_back( const T& value )
 		mSize += 1;
 	}
 }
+
+#endif
@@ -58,26 +58,13 @@
 //-----------------------------------------------------------------------------
 E3Globals gE3Globals = {
 	kQ3False,				// systemInitialised
-	kQ3False,				// systemDoBottleneck
 	0,						// systemRefCount
 	nullptr,				// classTree
 	nullptr,				// classTreeRoot
 	0,						// classNextType
+	{ 0 },					// classDynamicLookups
 	0,						// sharedLibraryCount
 	nullptr,				// sharedLibraryInfo
-	kQ3False,				// errMgrClearError
-	kQ3False,				// errMgrClearWarning
-	kQ3False,				// errMgrClearNotice
-	kQ3False,				// errMgrClearPlatform
-	kQ3False,				// errMgrIsFatalError
-	kQ3ErrorNone,			// errMgrOldestError
-	kQ3WarningNone,			// errMgrOldestWarning
-	kQ3NoticeNone,			// errMgrOldestNotice
-	0,						// errMgrOldestPlatform
-	kQ3ErrorNone,			// errMgrLatestError
-	kQ3WarningNone,			// errMgrLatestWarning
-	kQ3NoticeNone,			// errMgrLatestNotice
-	0,						// errMgrLatestPlatform
 	nullptr,				// errMgrHandlerFuncError
 	nullptr,				// errMgrHandlerFuncWarning
 	nullptr,				// errMgrHandlerFuncNotice
@@ -86,13 +73,38 @@ E3Globals gE3Globals = {
 	0,						// errMgrHandlerDataWarning
 	0,						// errMgrHandlerDataNotice
 	0,						// errMgrHandlerDataPlatform
+	nullptr,				// geomCacheHead
+	nullptr,				// geomCacheTail
+	0,						// geomCacheEntryCount
+	0,						// geomCacheMemoryUsed
+	0,						// geomCacheMemoryLimit
+	0,						// geomCacheHits
+	0,						// geomCacheMisses
+	0,						// geomCacheEvictions
 
 #if Q3_DEBUG
-	nullptr,					// listHead
+	nullptr,				// listHead
 	kQ3False				// isLeakChecking
 #endif
 };
 
+thread_local E3ThreadGlobals gE3ThreadGlobals = {
+	kQ3False,				// systemDoBottleneck
+	kQ3False,				// errMgrClearError
+	kQ3False,				// errMgrClearWarning
+	kQ3False,				// errMgrClearNotice
+	kQ3False,				// errMgrClearPlatform
+	kQ3False,				// errMgrIsFatalError
+	kQ3ErrorNone,			// errMgrOldestError
+	kQ3WarningNone,			// errMgrOldestWarning
+	kQ3NoticeNone,			// errMgrOldestNotice
+	0,						// errMgrOldestPlatform
+	kQ3ErrorNone,			// errMgrLatestError
+	kQ3WarningNone,			// errMgrLatestWarning
+	kQ3NoticeNone,			// errMgrLatestNotice
+	0						// errMgrLatestPlatform
+};
+
 
 
 
@@ -113,3 +125,22 @@ E3Globals_Get(void)
 	// Return the globals
 	return(&gE3Globals);
 }
+
+
+
+
+
+//=============================================================================
+//      E3Globals_GetThread : Get access to the Quesa per-thread state.
+//-----------------------------------------------------------------------------
+//		Note : Each thread starts with a clean error state and no pending
+//				bottleneck work.
+//-----------------------------------------------------------------------------
+E3ThreadGlobalsPtr
+E3Globals_GetThread(void)
+{
+
+
+	// Return the globals for this thread
+	return(&gE3ThreadGlobals);
+}
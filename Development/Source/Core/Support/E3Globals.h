@@ -48,6 +48,8 @@
 #include "E3ClassTree.h"
 #include "E3HashTable.h"
 
+#include <atomic>
+
 
 
 
@@ -255,6 +257,7 @@ extern "C" {
 #define kQ3ClassNameShaderUVTransform				"ShaderUVTransform"
 #define kQ3ClassNameStoragePath						"Quesa:Storage:Path"
 #define kQ3ClassNameStorageStream					"Quesa:Storage:Stream"
+#define kQ3ClassNameStorageMappedPath				"Quesa:Storage:MappedPath"
 #define kQ3ClassNameStorageBe						"Quesa:Storage:Be"
 #define kQ3ClassNameDrawContextBe					"Quesa:DrawContext:Be"
 #define kQ3ClassName3DMF							"Metafile"
@@ -321,6 +324,7 @@ extern "C" {
 #define kQ3XMethodTypeStorageOpen					Q3_METHOD_TYPE('Q', 'O', 'p', 'n')
 #define kQ3XMethodTypeStorageClose					Q3_METHOD_TYPE('Q', 'C', 'l', 's')
 #define kQ3XMethodTypeStorageGetOpenness			Q3_METHOD_TYPE('Q', 's', 'g', 'o')
+#define kQ3XMethodTypeStorageBorrowData				Q3_METHOD_TYPE('Q', 'b', 'r', 'w')
 
 
 // 3DMF object types
@@ -438,13 +442,13 @@ typedef class OpaqueTQ3Object {
 // every field in this structure, which minimises the amount of code which
 // depends on the content of the global state.
 //
-// Global state introduces penalties when running under a preemptively
-// threaded environment (which Quesa probably will, at some stage). Please
-// only use the global state as a last resort.
+// Global state is shared by every thread which calls Quesa, so fields which
+// can change after initialisation must either be atomic or be guarded by
+// the subsystem which owns them. Please only use the global state as a
+// last resort.
 typedef struct E3Globals {
 	// System
 	TQ3Boolean				systemInitialised;
-	TQ3Boolean				systemDoBottleneck;
 	TQ3Uns32				systemRefCount;
 
 
@@ -452,6 +456,7 @@ typedef struct E3Globals {
 	E3HashTablePtr			classTree;
 	E3ClassInfoPtr			classTreeRoot;
 	TQ3ObjectType			classNextType;
+	std::atomic<TQ3Uns32>	classDynamicLookups;
 	
 
 	// Shared libraries
@@ -460,19 +465,6 @@ typedef struct E3Globals {
 
 
 	// Error Manager
-	TQ3Boolean				errMgrClearError;
-	TQ3Boolean				errMgrClearWarning;
-	TQ3Boolean				errMgrClearNotice;
-	TQ3Boolean				errMgrClearPlatform;
-	TQ3Boolean				errMgrIsFatalError;
-	TQ3Error				errMgrOldestError;
-	TQ3Warning				errMgrOldestWarning;
-	TQ3Notice				errMgrOldestNotice;
-	TQ3Uns32				errMgrOldestPlatform;
-	TQ3Error				errMgrLatestError;
-	TQ3Warning				errMgrLatestWarning;
-	TQ3Notice				errMgrLatestNotice;
-	TQ3Uns32				errMgrLatestPlatform;
 	TQ3ErrorMethod			errMgrHandlerFuncError;
 	TQ3WarningMethod		errMgrHandlerFuncWarning;
 	TQ3NoticeMethod			errMgrHandlerFuncNotice;
@@ -483,6 +475,17 @@ typedef struct E3Globals {
 	TQ3Uns32		 		errMgrHandlerDataPlatform;
 
 
+	// Geometry cache
+	struct E3GeometryCacheEntry	*geomCacheHead;
+	struct E3GeometryCacheEntry	*geomCacheTail;
+	TQ3Uns32				geomCacheEntryCount;
+	TQ3Uns32				geomCacheMemoryUsed;
+	TQ3Uns32				geomCacheMemoryLimit;
+	TQ3Uns32				geomCacheHits;
+	TQ3Uns32				geomCacheMisses;
+	TQ3Uns32				geomCacheEvictions;
+
+
 	// Debugging
 #if Q3_DEBUG
 	TQ3Object				listHead;
@@ -492,6 +495,34 @@ typedef struct E3Globals {
 } E3Globals, *E3GlobalsPtr;
 
 
+// Per-thread state for each instance of Quesa.
+//
+// The error manager records errors for the thread which posted them, so
+// that Q3Error_Get and friends on one thread are not disturbed by errors
+// posted on another. The handlers themselves remain in E3Globals.
+typedef struct E3ThreadGlobals {
+	// System
+	TQ3Boolean				systemDoBottleneck;
+
+
+	// Error Manager
+	TQ3Boolean				errMgrClearError;
+	TQ3Boolean				errMgrClearWarning;
+	TQ3Boolean				errMgrClearNotice;
+	TQ3Boolean				errMgrClearPlatform;
+	TQ3Boolean				errMgrIsFatalError;
+	TQ3Error				errMgrOldestError;
+	TQ3Warning				errMgrOldestWarning;
+	TQ3Notice				errMgrOldestNotice;
+	TQ3Uns32				errMgrOldestPlatform;
+	TQ3Error				errMgrLatestError;
+	TQ3Warning				errMgrLatestWarning;
+	TQ3Notice				errMgrLatestNotice;
+	TQ3Uns32				errMgrLatestPlatform;
+
+} E3ThreadGlobals, *E3ThreadGlobalsPtr;
+
+
 
 
 
@@ -506,6 +537,12 @@ typedef struct E3Globals {
 extern E3Globals gE3Globals;
 
 
+// Per-thread Quesa state
+//
+// As above, code should use E3Globals_GetThread except for the bottleneck.
+extern thread_local E3ThreadGlobals gE3ThreadGlobals;
+
+
 
 
 
@@ -515,6 +552,40 @@ extern E3Globals gE3Globals;
 // Get access to the Quesa global state
 E3GlobalsPtr	E3Globals_Get(void);
 
+// Get access to the Quesa state for the calling thread
+E3ThreadGlobalsPtr	E3Globals_GetThread(void);
+
+
+
+
+
+//=============================================================================
+//      Inline functions
+//-----------------------------------------------------------------------------
+//      E3ClassInfo::GetMethodIndex : Get the dense table index for a method.
+//-----------------------------------------------------------------------------
+//		Note :	Returns -1 if the method type is not in the dense table. When
+//				inlined with a constant method type this folds away entirely.
+//
+//				Defined here rather than in E3ClassTree.h, since the dense
+//				method list includes the internal method types above.
+//-----------------------------------------------------------------------------
+#define E3_DENSE_METHOD_CASE(_name, _type)		case _type : return kE3MethodIndex##_name ;
+
+inline TQ3Int32
+E3ClassInfo::GetMethodIndex ( TQ3XMethodType methodType )
+	{
+	switch ( methodType )
+		{
+		E3_DENSE_METHOD_TYPES ( E3_DENSE_METHOD_CASE )
+		
+		default :
+			return -1 ;
+		}
+	}
+
+#undef E3_DENSE_METHOD_CASE
+
 
 
 
@@ -5,8 +5,10 @@
         Quesa hash table.
         
         Implements a simple hash table, where items within the table are
-        keyed using four character constants. Collisions are handled by
-        a resizeable array of unsorted items stored at each slot.
+        keyed using four character constants. Items are stored inline in a
+        single power-of-two sized array, and collisions are resolved by
+        linear probing with Robin Hood displacement. Removal uses backward
+        shifting, so the table never contains tombstones.
         
 		Used by the class tree to store the class tree nodes, and to cache
 		the methods for each node.
@@ -57,30 +59,40 @@
 
 
 
+//=============================================================================
+//      Internal constants
+//-----------------------------------------------------------------------------
+// Maximum load factor, as a fraction of kLoadDenominator. The table is grown
+// before an insertion would exceed this, which guarantees there is always at
+// least one empty slot.
+const TQ3Uns32 kLoadNumerator								= 3;
+const TQ3Uns32 kLoadDenominator								= 4;
+
+
+
+
+
 //=============================================================================
 //      Internal types
 //-----------------------------------------------------------------------------
-// An item stored within each node
+// A slot within the table
+//
+// probeLength is 0 for an empty slot, otherwise it is 1 more than the
+// distance of the slot from the home slot of its key. It fits into what
+// would otherwise be padding between the key and the item pointer.
 typedef struct E3HashTableItem {
 	TQ3ObjectType		theKey;						// Key for item
+	TQ3Uns32			probeLength;				// Distance from home slot + 1
 	void				*theItem;					// Data for item
 } E3HashTableItem, *E3HashTableItemPtr;
 
 
-// A node within a hash table
-typedef struct E3HashTableNode {
-	TQ3Uns32			numItems;					// Number of items in node
-	E3HashTableItemPtr	theItems;					// Array of items for node
-} E3HashTableNode, *E3HashTableNodePtr;
-
-
 // A hash table
 typedef struct E3HashTable {
-	TQ3Uns32			collisionMax;				// Worst case collision count
-	float				collisionAverage;			// Average collision count
 	TQ3Uns32			numItems;					// Number of items in table
 	TQ3Uns32			tableSize;					// Number of slots in table
-	E3HashTableNodePtr	*theTable;					// Array of node pointers
+	TQ3Uns32			tableMask;					// tableSize - 1
+	E3HashTableItemPtr	theSlots;					// Array of slots
 } E3HashTable;
 
 
@@ -90,23 +102,44 @@ typedef struct E3HashTable {
 //=============================================================================
 //      Internal functions
 //-----------------------------------------------------------------------------
-//      e3hash_find_node : Find the node for a given key.
+//      e3hash_home_slot : Get the home slot for a given key.
 //-----------------------------------------------------------------------------
-//		Note :	Hash index algorithm inspired by John Punin's hash table code
-//				for the W3's libwww library.  However, libwww needs to hash
-//				strings of unknown length, whereas here we hash just 4 bytes,
-//				which allows a mathematical simplification of the hash function.
-//
-//				Returns the address of a node pointer, rather than the node
-//				pointer itself, since the node pointer may be nullptr if the node
-//				hasn't been allocated yet.
+//		Note :	Four character codes differ mostly in their low bits, and the
+//				extension types from E3ClassTree::GetNextClassType are small
+//				consecutive negative numbers, so the key is run through the
+//				MurmurHash3 finaliser to spread it over every bit before
+//				it is masked down to the table size.
 //-----------------------------------------------------------------------------
-static E3HashTableNodePtr *
-e3hash_find_node(E3HashTablePtr theTable, TQ3ObjectType theKey)
+static inline TQ3Uns32
+e3hash_home_slot(const E3HashTable *theTable, TQ3ObjectType theKey)
 {
-	TQ3Uns32		theIndex;
-	TQ3Uns8			*thePtr;
+	TQ3Uns32	theHash = (TQ3Uns32) theKey;
 	
+	theHash ^= theHash >> 16;
+	theHash *= 0x85EBCA6BU;
+	theHash ^= theHash >> 13;
+	theHash *= 0xC2B2AE35U;
+	theHash ^= theHash >> 16;
+
+	return(theHash & theTable->tableMask);
+}
+
+
+
+
+
+//=============================================================================
+//      e3hash_find_slot : Find the slot containing a given key.
+//-----------------------------------------------------------------------------
+//		Note :	Returns nullptr if the key is not present. Since the table is
+//				ordered by probe length, the search can stop as soon as it
+//				reaches a slot which is closer to its home than we are.
+//-----------------------------------------------------------------------------
+static E3HashTableItemPtr
+e3hash_find_slot(const E3HashTable *theTable, TQ3ObjectType theKey)
+{	E3HashTableItemPtr		theSlot;
+	TQ3Uns32				theIndex, probeLength;
+
 
 
 	// Validate our parameters
@@ -115,18 +148,23 @@ e3hash_find_node(E3HashTablePtr theTable, TQ3ObjectType theKey)
 
 
 
-	// Calculate the index for the node
-	thePtr   = (TQ3Uns8 *) &theKey;
+	// Probe for the key
+	theIndex    = e3hash_home_slot(theTable, theKey);
+	probeLength = 1;
 	
-	// This hash function may not be the most theoretically sound, but I can't
-	// find anything faster that works as well.
-	theIndex = (27*thePtr[0] + 9*thePtr[1] + 3*thePtr[2] + thePtr[3]) & (theTable->tableSize - 1);
+	while (true)
+		{
+		theSlot = &theTable->theSlots[theIndex];
 
-	Q3_ASSERT(theIndex < theTable->tableSize);
+		if (theSlot->probeLength < probeLength)
+			return(nullptr);
 
+		if (theSlot->theKey == theKey)
+			return(theSlot);
 
-	// Return the address of the appropriate node within the table
-	return (&theTable->theTable[theIndex]);
+		theIndex = (theIndex + 1) & theTable->tableMask;
+		probeLength++;
+		}
 }
 
 
@@ -134,34 +172,55 @@ e3hash_find_node(E3HashTablePtr theTable, TQ3ObjectType theKey)
 
 
 //=============================================================================
-//      e3hash_add_key : Add a key and its item to a node.
+//      e3hash_insert_key : Insert a key and its item into a slot array.
 //-----------------------------------------------------------------------------
-static TQ3Status
-e3hash_add_key(E3HashTableNodePtr theNode, TQ3ObjectType theKey, void *theItem)
-{	TQ3Status		qd3dStatus;
+//		Note :	The key must not be present, and the array must contain at
+//				least one empty slot.
+//-----------------------------------------------------------------------------
+static void
+e3hash_insert_key(E3HashTablePtr theTable, TQ3ObjectType theKey, void *theItem)
+{	E3HashTableItem			theCarry, theTemp;
+	E3HashTableItemPtr		theSlot;
+	TQ3Uns32				theIndex;
 
 
 
 	// Validate our parameters
-	Q3_ASSERT_VALID_PTR(theNode);
+	Q3_ASSERT_VALID_PTR(theTable);
+	Q3_ASSERT(theTable->numItems < theTable->tableSize);
 
 
 
-	// Grow the node item array
-	qd3dStatus = Q3Memory_Reallocate(&theNode->theItems,
-										static_cast<TQ3Uns32>(sizeof(E3HashTableItem) * (theNode->numItems + 1)));
-	if (qd3dStatus != kQ3Success)
-		return(qd3dStatus);
+	// Walk forward from the home slot. Whenever we pass an item that is
+	// closer to its home than the item we are carrying, we take its slot
+	// and carry it onwards instead.
+	theCarry.theKey      = theKey;
+	theCarry.probeLength = 1;
+	theCarry.theItem     = theItem;
+	theIndex             = e3hash_home_slot(theTable, theKey);
 
+	while (true)
+		{
+		theSlot = &theTable->theSlots[theIndex];
 
+		if (theSlot->probeLength == 0)
+			{
+			*theSlot = theCarry;
+			break;
+			}
 
-	// Save the item and its key at the end of the node's list,
-	// and update the count for the node
-	theNode->theItems[theNode->numItems].theKey  = theKey;
-	theNode->theItems[theNode->numItems].theItem = theItem;
-	theNode->numItems++;
+		if (theSlot->probeLength < theCarry.probeLength)
+			{
+			theTemp  = *theSlot;
+			*theSlot = theCarry;
+			theCarry = theTemp;
+			}
 
-	return(kQ3Success);
+		theIndex = (theIndex + 1) & theTable->tableMask;
+		theCarry.probeLength++;
+		}
+
+	theTable->numItems++;
 }
 
 
@@ -169,40 +228,67 @@ e3hash_add_key(E3HashTableNodePtr theNode, TQ3ObjectType theKey, void *theItem)
 
 
 //=============================================================================
-//      e3hash_update_stats : Update the table stats.
+//      e3hash_resize : Resize the slot array of a table.
 //-----------------------------------------------------------------------------
-static void
-e3hash_update_stats(E3HashTablePtr theTable)
-{	TQ3Uns32				n, itemCount, slotCount;
-	E3HashTableNodePtr		theNode;
+static TQ3Status
+e3hash_resize(E3HashTablePtr theTable, TQ3Uns32 tableSize)
+{	E3HashTableItemPtr		oldSlots, newSlots;
+	TQ3Uns32				n, oldSize;
 
 
 
 	// Validate our parameters
 	Q3_ASSERT_VALID_PTR(theTable);
+	Q3_ASSERT( (tableSize & (tableSize - 1)) == 0 );	// power of 2
+	Q3_ASSERT(theTable->numItems * kLoadDenominator <= tableSize * kLoadNumerator);
 
 
 
-	// Recalculate the table stats
-	theTable->collisionMax     = 0;
-	theTable->collisionAverage = 0.0f;
-	itemCount                  = 0;
-	slotCount                  = 0;
-	
-	for (n = 0; n < theTable->tableSize; n++)
+	// Allocate the new slots
+	newSlots = (E3HashTableItemPtr) Q3Memory_AllocateClear(static_cast<TQ3Uns32>(sizeof(E3HashTableItem) * tableSize));
+	if (newSlots == nullptr)
+		return(kQ3Failure);
+
+
+
+	// Move the items across
+	oldSlots = theTable->theSlots;
+	oldSize  = theTable->tableSize;
+
+	theTable->theSlots  = newSlots;
+	theTable->tableSize = tableSize;
+	theTable->tableMask = tableSize - 1;
+	theTable->numItems  = 0;
+
+	for (n = 0; n < oldSize; n++)
 		{
-		theNode = theTable->theTable[n];
-		if (theNode != nullptr)
-			{
-			if (theNode->numItems > theTable->collisionMax)
-				theTable->collisionMax = theNode->numItems;
-		
-			itemCount += theNode->numItems;
-			slotCount++;
-			}
+		if (oldSlots[n].probeLength != 0)
+			e3hash_insert_key(theTable, oldSlots[n].theKey, oldSlots[n].theItem);
 		}
-	
-	theTable->collisionAverage = (float) itemCount / (float) slotCount;
+
+	Q3Memory_Free(&oldSlots);
+
+	return(kQ3Success);
+}
+
+
+
+
+
+//=============================================================================
+//      e3hash_size_for_items : Get the table size needed for some items.
+//-----------------------------------------------------------------------------
+static TQ3Uns32
+e3hash_size_for_items(TQ3Uns32 numItems)
+{	TQ3Uns32		tableSize = 2;
+
+
+
+	// Find the smallest power of 2 which stays within our load factor
+	while (numItems * kLoadDenominator > tableSize * kLoadNumerator)
+		tableSize *= 2;
+
+	return(tableSize);
 }
 
 
@@ -227,22 +313,27 @@ E3HashTable_Create(TQ3Uns32 tableSize)
 
 
 
+	// We always need at least one empty slot
+	if (tableSize < 2)
+		tableSize = 2;
+
+
+
 	// Create the table
 	theTable = (E3HashTablePtr) Q3Memory_Allocate(sizeof(E3HashTable));
 	if (theTable != nullptr)
 		{
 		// Initialise the table
-		theTable->collisionMax     = 0;
-		theTable->collisionAverage = 0.0f;
-		theTable->tableSize        = tableSize;
-		theTable->numItems         = 0;
-		theTable->theTable = (E3HashTableNodePtr *) Q3Memory_AllocateClear(static_cast<TQ3Uns32>(sizeof(E3HashTableNodePtr)
+		theTable->tableSize = tableSize;
+		theTable->tableMask = tableSize - 1;
+		theTable->numItems  = 0;
+		theTable->theSlots  = (E3HashTableItemPtr) Q3Memory_AllocateClear(static_cast<TQ3Uns32>(sizeof(E3HashTableItem)
 																			* theTable->tableSize));
 
 
 
 		// Handle failure
-		if (theTable->theTable == nullptr)
+		if (theTable->theSlots == nullptr)
 			{
 			Q3Memory_Free(&theTable);
 			theTable = nullptr;
@@ -261,10 +352,7 @@ E3HashTable_Create(TQ3Uns32 tableSize)
 //-----------------------------------------------------------------------------
 void
 E3HashTable_Destroy(E3HashTablePtr *theTable)
-{	E3HashTablePtr			tablePtr;
-	E3HashTableNodePtr		theNode;
-	TQ3Uns32				n;
-
+{
 
 
 	// Validate our parameters
@@ -273,22 +361,8 @@ E3HashTable_Destroy(E3HashTablePtr *theTable)
 
 
 
-	// Dispose of the table items
-	tablePtr = *theTable;
-	for (n = 0; n < tablePtr->tableSize; n++)
-		{
-		theNode = tablePtr->theTable[n];
-		if (theNode != nullptr)
-			{
-			Q3Memory_Free(&theNode->theItems);
-			Q3Memory_Free(&tablePtr->theTable[n]);
-			}
-		}
-
-
-
-	// Dispose of the table itself
-	Q3Memory_Free(&tablePtr->theTable);
+	// Dispose of the table
+	Q3Memory_Free(&(*theTable)->theSlots);
 	Q3Memory_Free(theTable);
 }
 
@@ -305,13 +379,13 @@ E3HashTable_Destroy(E3HashTablePtr *theTable)
 TQ3Status
 E3HashTable_Add(E3HashTablePtr theTable, TQ3ObjectType theKey, void *theItem)
 {	TQ3Status				qd3dStatus;
-	E3HashTableNodePtr		*theNode;
 
 
 
 	// Validate our parameters
 	Q3_ASSERT_VALID_PTR(theTable);
 	Q3_ASSERT(theItem != nullptr);
+	Q3_ASSERT(theKey != kQ3ObjectTypeInvalid);
 
 
 
@@ -320,32 +394,18 @@ E3HashTable_Add(E3HashTablePtr theTable, TQ3ObjectType theKey, void *theItem)
 
 
 
-	// Find the node which should contain the item
-	theNode = e3hash_find_node(theTable, theKey);
-	Q3_ASSERT_VALID_PTR(theNode);
-
-
-
-	// If the node doesn't exist, create it
-	if (*theNode == nullptr)
+	// Grow the table if this item would take us past our load factor
+	if ((theTable->numItems + 1) * kLoadDenominator > theTable->tableSize * kLoadNumerator)
 		{
-		*theNode = (E3HashTableNodePtr) Q3Memory_AllocateClear(sizeof(E3HashTableNode));
-		if (*theNode == nullptr)
-			return(kQ3Failure);
+		qd3dStatus = e3hash_resize(theTable, theTable->tableSize * 2);
+		if (qd3dStatus != kQ3Success)
+			return(qd3dStatus);
 		}
 
 
 
-	// Add the item to the node
-	qd3dStatus = e3hash_add_key(*theNode, theKey, theItem);
-	if (qd3dStatus != kQ3Success)
-		return(qd3dStatus);
-
-
-
-	// Update the table
-	theTable->numItems++;
-	e3hash_update_stats(theTable);
+	// Add the item
+	e3hash_insert_key(theTable, theKey, theItem);
 
 	return(kQ3Success);
 }
@@ -360,9 +420,8 @@ E3HashTable_Add(E3HashTablePtr theTable, TQ3ObjectType theKey, void *theItem)
 //		Note : The item must be present in the hash table.
 //-----------------------------------------------------------------------------
 void E3HashTable_Remove(E3HashTablePtr theTable, TQ3ObjectType theKey)
-{	E3HashTableNodePtr		theNode, *nodePtr;
-	TQ3Boolean				foundItem;
-	TQ3Uns32				n;
+{	E3HashTableItemPtr		theSlot, nextSlot;
+	TQ3Uns32				theIndex, nextIndex;
 
 
 
@@ -371,46 +430,43 @@ void E3HashTable_Remove(E3HashTablePtr theTable, TQ3ObjectType theKey)
 
 
 
-	// Find the node which should contain the item
-	nodePtr = e3hash_find_node(theTable, theKey);
-	Q3_ASSERT_VALID_PTR(nodePtr);
-	
-	theNode = *nodePtr;
-	Q3_ASSERT_VALID_PTR(nodePtr);
+	// Find the slot which contains the item
+	theSlot = e3hash_find_slot(theTable, theKey);
+	Q3_ASSERT(theSlot != nullptr);
+	Q3_ASSERT(theTable->numItems >= 1);
 
+	if (theSlot == nullptr)
+		return;
 
 
-	// Remove the item from the node
-	foundItem = kQ3False;
-	for (n = 0; n < theNode->numItems && !foundItem; n++)
+
+	// Shift the rest of the probe sequence back by one slot, until we reach
+	// an empty slot or an item which is already in its home slot
+	theIndex = (TQ3Uns32) (theSlot - theTable->theSlots);
+	
+	while (true)
 		{
-		if (theKey == theNode->theItems[n].theKey)
-			{
-			// Shift the items above this item, if any, done by 1
-			if (n != (theNode->numItems - 1))
-				memmove(&theNode->theItems[n],
-						&theNode->theItems[n+1],
-						(theNode->numItems - n - 1) * sizeof(E3HashTableItem));
-			
-			
-			// Decrement the node count and break
-			Q3_ASSERT(theNode->numItems >= 1);
-			theNode->numItems--;
-			foundItem = kQ3True;
-			}
+		nextIndex = (theIndex + 1) & theTable->tableMask;
+		nextSlot  = &theTable->theSlots[nextIndex];
+		
+		if (nextSlot->probeLength <= 1)
+			break;
+
+		*theSlot = *nextSlot;
+		theSlot->probeLength--;
+
+		theSlot  = nextSlot;
+		theIndex = nextIndex;
 		}
 
+	theSlot->theKey      = kQ3ObjectTypeInvalid;
+	theSlot->probeLength = 0;
+	theSlot->theItem     = nullptr;
 
 
-	// Update the table
-	Q3_ASSERT(foundItem);
-	Q3_ASSERT(theTable->numItems >= 1);
 
-	if (foundItem)
-		{
-		theTable->numItems--;
-		e3hash_update_stats(theTable);
-		}
+	// Update the table
+	theTable->numItems--;
 }
 
 
@@ -424,10 +480,8 @@ void E3HashTable_Remove(E3HashTablePtr theTable, TQ3ObjectType theKey)
 //-----------------------------------------------------------------------------
 void *
 E3HashTable_Find(E3HashTablePtr theTable, TQ3ObjectType theKey)
-{	E3HashTableNodePtr		theNode, *nodePtr;
-	E3HashTableItemPtr		theItem;
-	TQ3Uns32				n, numItems;
-	
+{	E3HashTableItemPtr		theSlot;
+
 
 
 	// Validate our parameters
@@ -435,32 +489,12 @@ E3HashTable_Find(E3HashTablePtr theTable, TQ3ObjectType theKey)
 
 
 
-	// Find the node which should contain the item
-	nodePtr = e3hash_find_node(theTable, theKey);
-
-
-
-	// If the node is empty, we're done
-	if (*nodePtr == nullptr)
+	// Find the item
+	theSlot = e3hash_find_slot(theTable, theKey);
+	if (theSlot == nullptr)
 		return(nullptr);
 
-	theNode = *nodePtr;
-	Q3_ASSERT_VALID_PTR(theNode);
-
-
-
-	// Otherwise, look for the item
-	theItem = theNode->theItems;
-	numItems = theNode->numItems;
-	for (n = 0; n < numItems; ++n)
-		{
-		if (theKey == theItem->theKey)
-			return(theItem->theItem);
-		
-		++theItem;
-		}
-
-	return(nullptr);
+	return(theSlot->theItem);
 }
 
 
@@ -470,13 +504,19 @@ E3HashTable_Find(E3HashTablePtr theTable, TQ3ObjectType theKey)
 //=============================================================================
 //      E3HashTable_Iterate : Iterate over the items in a hash table.
 //-----------------------------------------------------------------------------
+//		Note :	The iterator may remove the item it is passed, but must not
+//				otherwise modify the table.
+//
+//				We walk the slots backwards starting just below an empty slot.
+//				Removing an item only shifts the items that follow it in its
+//				probe sequence, and those all lie between the removed item and
+//				the next empty slot, so they have already been visited.
+//-----------------------------------------------------------------------------
 TQ3Status
 E3HashTable_Iterate(E3HashTablePtr theTable, TQ3HashTableIterator theIterator, void *userData)
 {	TQ3Status				qd3dStatus = kQ3Success;
-	E3HashTableItemPtr		theItem;
-	E3HashTableNodePtr		theNode;
-	TQ3Uns32				n;
-	TQ3Int32				m;	// must be signed due to backwards loop
+	E3HashTableItemPtr		theSlot;
+	TQ3Uns32				n, startIndex, theIndex;
 
 
 
@@ -486,27 +526,28 @@ E3HashTable_Iterate(E3HashTablePtr theTable, TQ3HashTableIterator theIterator, v
 
 
 
+	// Find an empty slot to start from
+	startIndex = 0;
+	while (theTable->theSlots[startIndex].probeLength != 0)
+		startIndex++;
+
+	Q3_ASSERT(startIndex < theTable->tableSize);
+
+
+
 	// Iterate over the table
-	for (n = 0; n < theTable->tableSize; n++)
-	{
-		theNode = theTable->theTable[n];
-		
-		if ( theNode != nullptr )
+	for (n = 1; n < theTable->tableSize; n++)
 		{
-			// Iterate backwards in case the iterator function removes any items
-			for (m = theNode->numItems - 1; m >= 0; --m)
+		theIndex = (startIndex - n) & theTable->tableMask;
+		theSlot  = &theTable->theSlots[theIndex];
+		
+		if (theSlot->probeLength != 0)
 			{
-				theItem = &theNode->theItems[m];
-				
-				qd3dStatus = theIterator(theTable, theItem->theKey, theItem->theItem, userData);
-				if (qd3dStatus != kQ3Success)
-					break;
+			qd3dStatus = theIterator(theTable, theSlot->theKey, theSlot->theItem, userData);
+			if (qd3dStatus != kQ3Success)
+				break;
 			}
 		}
-
-		if (qd3dStatus != kQ3Success)
-			break;
-	}
 	
 	return(qd3dStatus);
 }
@@ -515,12 +556,78 @@ E3HashTable_Iterate(E3HashTablePtr theTable, TQ3HashTableIterator theIterator, v
 
 
 
+//=============================================================================
+//      E3HashTable_Reserve : Make room for a number of items.
+//-----------------------------------------------------------------------------
+//		Note :	Grows the table, if necessary, so that numItems items can be
+//				held without any further reallocation.
+//-----------------------------------------------------------------------------
+TQ3Status
+E3HashTable_Reserve(E3HashTablePtr theTable, TQ3Uns32 numItems)
+{	TQ3Uns32		tableSize;
+
+
+
+	// Validate our parameters
+	Q3_ASSERT_VALID_PTR(theTable);
+
+
+
+	// Grow the table if required
+	tableSize = e3hash_size_for_items(numItems);
+	if (tableSize <= theTable->tableSize)
+		return(kQ3Success);
+
+	return(e3hash_resize(theTable, tableSize));
+}
+
+
+
+
+
+//=============================================================================
+//      E3HashTable_Rehash : Rebuild a table with a new size.
+//-----------------------------------------------------------------------------
+//		Note :	The table size is rounded up to a power of 2, and to the size
+//				required for the items currently in the table. Passing 0 will
+//				shrink the table to the smallest size that fits its items.
+//-----------------------------------------------------------------------------
+TQ3Status
+E3HashTable_Rehash(E3HashTablePtr theTable, TQ3Uns32 tableSize)
+{	TQ3Uns32		newSize;
+
+
+
+	// Validate our parameters
+	Q3_ASSERT_VALID_PTR(theTable);
+
+
+
+	// Work out the new size
+	newSize = e3hash_size_for_items(theTable->numItems);
+	while (newSize < tableSize)
+		newSize *= 2;
+
+
+
+	// Rebuild the table
+	return(e3hash_resize(theTable, newSize));
+}
+
+
+
+
+
 //=============================================================================
 //      E3HashTable_GetCollisionMax : Get the max collision count for a table.
 //-----------------------------------------------------------------------------
+//		Note :	Returns the longest probe sequence in the table, i.e., the
+//				number of slots examined by the worst case successful search.
+//-----------------------------------------------------------------------------
 TQ3Uns32
 E3HashTable_GetCollisionMax(E3HashTablePtr theTable)
-{
+{	TQ3Uns32		n, collisionMax;
+
 
 
 	// Validate our parameters
@@ -528,8 +635,16 @@ E3HashTable_GetCollisionMax(E3HashTablePtr theTable)
 
 
 
-	// Get the value
-	return(theTable->collisionMax);
+	// Calculate the value
+	collisionMax = 0;
+	
+	for (n = 0; n < theTable->tableSize; n++)
+		{
+		if (theTable->theSlots[n].probeLength > collisionMax)
+			collisionMax = theTable->theSlots[n].probeLength;
+		}
+
+	return(collisionMax);
 }
 
 
@@ -539,9 +654,13 @@ E3HashTable_GetCollisionMax(E3HashTablePtr theTable)
 //=============================================================================
 //      E3HashTable_GetCollisionAverage : Get the average collision count.
 //-----------------------------------------------------------------------------
+//		Note :	Returns the average probe sequence length, i.e., the average
+//				number of slots examined by a successful search.
+//-----------------------------------------------------------------------------
 float
 E3HashTable_GetCollisionAverage(E3HashTablePtr theTable)
-{
+{	TQ3Uns32		n, probeTotal;
+
 
 
 	// Validate our parameters
@@ -549,8 +668,16 @@ E3HashTable_GetCollisionAverage(E3HashTablePtr theTable)
 
 
 
-	// Get the value
-	return(theTable->collisionAverage);
+	// Calculate the value
+	if (theTable->numItems == 0)
+		return(0.0f);
+
+	probeTotal = 0;
+	
+	for (n = 0; n < theTable->tableSize; n++)
+		probeTotal += theTable->theSlots[n].probeLength;
+
+	return((float) probeTotal / (float) theTable->numItems);
 }
 
 
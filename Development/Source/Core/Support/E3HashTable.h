@@ -88,6 +88,11 @@ void				*E3HashTable_Find(E3HashTablePtr theTable, TQ3ObjectType theKey);
 TQ3Status			E3HashTable_Iterate(E3HashTablePtr theTable, TQ3HashTableIterator theIterator, void *userData);
 
 
+// Resize a hash table
+TQ3Status			E3HashTable_Reserve(E3HashTablePtr theTable, TQ3Uns32 numItems);
+TQ3Status			E3HashTable_Rehash(E3HashTablePtr theTable, TQ3Uns32 tableSize);
+
+
 // Get info on a hash table
 TQ3Uns32			E3HashTable_GetCollisionMax(E3HashTablePtr theTable);
 float				E3HashTable_GetCollisionAverage(E3HashTablePtr theTable);
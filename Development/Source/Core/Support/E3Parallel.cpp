@@ -0,0 +1,410 @@
+/*  NAME:
+        E3Parallel.cpp
+
+    DESCRIPTION:
+        A small thread pool for data-parallel loops.
+
+    COPYRIGHT:
+        Copyright (c) 2026, Quesa Developers. All rights reserved.
+
+        For the current release of Quesa, please see:
+
+            <https://github.com/jwwalker/Quesa>
+        
+        Redistribution and use in source and binary forms, with or without
+        modification, are permitted provided that the following conditions
+        are met:
+        
+            o Redistributions of source code must retain the above copyright
+              notice, this list of conditions and the following disclaimer.
+        
+            o Redistributions in binary form must reproduce the above
+              copyright notice, this list of conditions and the following
+              disclaimer in the documentation and/or other materials provided
+              with the distribution.
+        
+            o Neither the name of Quesa nor the names of its contributors
+              may be used to endorse or promote products derived from this
+              software without specific prior written permission.
+        
+        THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+        "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+        LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+        A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+        OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+        SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+        TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+        PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+        LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+        NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+        SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+    ___________________________________________________________________________
+*/
+
+
+
+
+//=============================================================================
+//      Include files
+//-----------------------------------------------------------------------------
+#include "E3Parallel.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+
+
+
+//=============================================================================
+//      Internal constants and types
+//-----------------------------------------------------------------------------
+namespace
+{
+	// Number of pieces per thread, so that threads which finish early can
+	// help with the rest
+	const TQ3Uns32		kPiecesPerThread			= 4;
+	
+	
+	class E3ParallelPool
+	{
+	public:
+							E3ParallelPool( TQ3Uns32 inNumWorkers );
+							~E3ParallelPool();
+		
+		bool				TryRun( TQ3Uns32 inCount,
+									TQ3Uns32 inPieceSize,
+									const TE3ParallelBody& inBody );
+	
+	private:
+		void				Stop();
+		void				WorkerLoop();
+		void				DoPieces();
+		
+		std::vector<std::thread>	mWorkers;
+		std::mutex					mMutex;
+		std::condition_variable		mWakeCondition;
+		std::condition_variable		mDoneCondition;
+		TQ3Uns32					mGeneration;
+		bool						mIsStopping;
+		std::atomic<bool>			mIsRunning;
+		
+		// The current job
+		const TE3ParallelBody*		mBody;
+		TQ3Uns32					mCount;
+		TQ3Uns32					mPieceSize;
+		TQ3Uns32					mNumPieces;
+		std::atomic<TQ3Uns32>		mNextPiece;
+		TQ3Uns32					mBusyWorkers;
+		std::exception_ptr			mError;
+	};
+	
+	
+	std::mutex				sPoolMutex;
+	E3ParallelPool*			sPool						= nullptr;
+	std::atomic<TQ3Uns32>	sThreadCount( 0 );
+}
+
+
+
+
+
+//=============================================================================
+//      Internal functions
+//-----------------------------------------------------------------------------
+//      E3ParallelPool::E3ParallelPool : Constructor.
+//-----------------------------------------------------------------------------
+//		Note :	May throw if a thread can't be started, in which case the
+//				threads already started are stopped.
+//-----------------------------------------------------------------------------
+E3ParallelPool::E3ParallelPool( TQ3Uns32 inNumWorkers )
+	: mGeneration( 0 )
+	, mIsStopping( false )
+	, mIsRunning( false )
+	, mBody( nullptr )
+	, mCount( 0 )
+	, mPieceSize( 0 )
+	, mNumPieces( 0 )
+	, mNextPiece( 0 )
+	, mBusyWorkers( 0 )
+{
+	try
+	{
+		for (TQ3Uns32 i = 0; i < inNumWorkers; ++i)
+			mWorkers.push_back( std::thread( &E3ParallelPool::WorkerLoop, this ) );
+	}
+	catch (...)
+	{
+		Stop();
+		throw;
+	}
+}
+
+
+
+
+
+//=============================================================================
+//      E3ParallelPool::~E3ParallelPool : Destructor.
+//-----------------------------------------------------------------------------
+E3ParallelPool::~E3ParallelPool()
+{
+	Stop();
+}
+
+
+
+
+
+//=============================================================================
+//      E3ParallelPool::Stop : Stop the worker threads.
+//-----------------------------------------------------------------------------
+void
+E3ParallelPool::Stop()
+{
+	{
+		std::lock_guard<std::mutex> theLock( mMutex );
+		mIsStopping = true;
+	}
+	mWakeCondition.notify_all();
+	
+	for (std::thread& theWorker : mWorkers)
+	{
+		if (theWorker.joinable())
+			theWorker.join();
+	}
+	mWorkers.clear();
+}
+
+
+
+
+
+//=============================================================================
+//      E3ParallelPool::TryRun : Run a job, if the pool is not busy.
+//-----------------------------------------------------------------------------
+bool
+E3ParallelPool::TryRun( TQ3Uns32 inCount, TQ3Uns32 inPieceSize,
+						const TE3ParallelBody& inBody )
+{
+	bool	wasRunning = false;
+	
+	if (! mIsRunning.compare_exchange_strong( wasRunning, true ))
+		return false;
+	
+	
+	
+	// Hand the job to the workers, and join in
+	{
+		std::lock_guard<std::mutex> theLock( mMutex );
+		mBody        = &inBody;
+		mCount       = inCount;
+		mPieceSize   = inPieceSize;
+		mNumPieces   = (inCount + inPieceSize - 1) / inPieceSize;
+		mNextPiece   = 0;
+		mBusyWorkers = static_cast<TQ3Uns32>( mWorkers.size() );
+		mError       = nullptr;
+		++mGeneration;
+	}
+	mWakeCondition.notify_all();
+	
+	DoPieces();
+	
+	
+	
+	// Wait for the workers to finish
+	std::exception_ptr theError;
+	{
+		std::unique_lock<std::mutex> theLock( mMutex );
+		mDoneCondition.wait( theLock, [this] { return mBusyWorkers == 0; } );
+		
+		theError = mError;
+		mError   = nullptr;
+		mBody    = nullptr;
+	}
+	
+	mIsRunning = false;
+	
+	if (theError)
+		std::rethrow_exception( theError );
+	
+	return true;
+}
+
+
+
+
+
+//=============================================================================
+//      E3ParallelPool::WorkerLoop : Body of a worker thread.
+//-----------------------------------------------------------------------------
+void
+E3ParallelPool::WorkerLoop()
+{
+	// The generation is 0 until the first job.  A worker that only gets
+	// going after that job has been posted must still take part in it.
+	std::unique_lock<std::mutex> theLock( mMutex );
+	TQ3Uns32 seenGeneration = 0;
+	
+	for (;;)
+	{
+		mWakeCondition.wait( theLock,
+			[&] { return mIsStopping || (mGeneration != seenGeneration); } );
+		
+		if (mIsStopping)
+			break;
+		
+		seenGeneration = mGeneration;
+		
+		theLock.unlock();
+		DoPieces();
+		theLock.lock();
+		
+		if (--mBusyWorkers == 0)
+			mDoneCondition.notify_all();
+	}
+}
+
+
+
+
+
+//=============================================================================
+//      E3ParallelPool::DoPieces : Do pieces of the current job until none
+//				are left.
+//-----------------------------------------------------------------------------
+void
+E3ParallelPool::DoPieces()
+{
+	for (;;)
+	{
+		TQ3Uns32 thePiece = mNextPiece.fetch_add( 1 );
+		if (thePiece >= mNumPieces)
+			break;
+		
+		TQ3Uns32 theStart = thePiece * mPieceSize;
+		TQ3Uns32 theEnd   = std::min( theStart + mPieceSize, mCount );
+		
+		try
+		{
+			(*mBody)( theStart, theEnd );
+		}
+		catch (...)
+		{
+			std::lock_guard<std::mutex> theLock( mMutex );
+			if (! mError)
+				mError = std::current_exception();
+		}
+	}
+}
+
+
+
+
+
+//=============================================================================
+//      Public functions
+//-----------------------------------------------------------------------------
+//      E3Parallel_For : Do some work for a range of indices, split across
+//				threads.
+//-----------------------------------------------------------------------------
+void
+E3Parallel_For( TQ3Uns32 inCount, TQ3Uns32 inMinPerTask, const TE3ParallelBody& inBody )
+{
+	if (inCount == 0)
+		return;
+	
+	TQ3Uns32 numThreads = E3Parallel_GetThreadCount();
+	uint64_t numPieces  = static_cast<uint64_t>( numThreads ) * kPiecesPerThread;
+	TQ3Uns32 pieceSize  = std::max( std::max( inMinPerTask, 1U ),
+		static_cast<TQ3Uns32>( (inCount + numPieces - 1) / numPieces ) );
+	
+	
+	
+	// Find the pool, starting it if need be
+	E3ParallelPool* thePool = nullptr;
+	
+	if ( (numThreads > 1) && (pieceSize < inCount) )
+	{
+		std::lock_guard<std::mutex> theLock( sPoolMutex );
+		
+		if (sPool == nullptr)
+		{
+			try
+			{
+				sPool = new E3ParallelPool( numThreads - 1 );
+			}
+			catch (...)
+			{
+				sPool = nullptr;
+			}
+		}
+		
+		thePool = sPool;
+	}
+	
+	
+	
+	// Run the job in the pool, or here if we can't
+	if ( (thePool == nullptr) || (! thePool->TryRun( inCount, pieceSize, inBody )) )
+		inBody( 0, inCount );
+}
+
+
+
+
+
+//=============================================================================
+//      E3Parallel_GetThreadCount : Get the number of threads to use.
+//-----------------------------------------------------------------------------
+TQ3Uns32
+E3Parallel_GetThreadCount( void )
+{
+	TQ3Uns32 threadCount = sThreadCount.load( std::memory_order_relaxed );
+	
+	if (threadCount != 0)
+		return threadCount;
+	
+	return std::max( std::thread::hardware_concurrency(), 1U );
+}
+
+
+
+
+
+//=============================================================================
+//      E3Parallel_SetThreadCount : Set the number of threads to use.
+//-----------------------------------------------------------------------------
+void
+E3Parallel_SetThreadCount( TQ3Uns32 inCount )
+{
+	std::lock_guard<std::mutex> theLock( sPoolMutex );
+	
+	if (inCount != sThreadCount.load( std::memory_order_relaxed ))
+	{
+		delete sPool;
+		sPool = nullptr;
+		sThreadCount.store( inCount, std::memory_order_relaxed );
+	}
+}
+
+
+
+
+
+//=============================================================================
+//      E3Parallel_Terminate : Stop the threads of the pool.
+//-----------------------------------------------------------------------------
+void
+E3Parallel_Terminate( void )
+{
+	std::lock_guard<std::mutex> theLock( sPoolMutex );
+	
+	delete sPool;
+	sPool = nullptr;
+}
@@ -0,0 +1,134 @@
+#pragma once
+/*  NAME:
+        E3Parallel.h
+
+    DESCRIPTION:
+        Header file for E3Parallel.cpp.
+
+    COPYRIGHT:
+        Copyright (c) 2026, Quesa Developers. All rights reserved.
+
+        For the current release of Quesa, please see:
+
+            <https://github.com/jwwalker/Quesa>
+        
+        Redistribution and use in source and binary forms, with or without
+        modification, are permitted provided that the following conditions
+        are met:
+        
+            o Redistributions of source code must retain the above copyright
+              notice, this list of conditions and the following disclaimer.
+        
+            o Redistributions in binary form must reproduce the above
+              copyright notice, this list of conditions and the following
+              disclaimer in the documentation and/or other materials provided
+              with the distribution.
+        
+            o Neither the name of Quesa nor the names of its contributors
+              may be used to endorse or promote products derived from this
+              software without specific prior written permission.
+        
+        THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+        "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+        LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+        A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+        OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+        SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+        TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+        PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+        LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+        NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+        SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+    ___________________________________________________________________________
+*/
+
+
+
+
+
+
+
+
+//=============================================================================
+//      Include files
+//-----------------------------------------------------------------------------
+#include "E3Prefix.h"
+
+#include <functional>
+
+
+
+//=============================================================================
+//      Types
+//-----------------------------------------------------------------------------
+/*!
+	@typedef	TE3ParallelBody
+	@abstract	The work done for a range of indices by E3Parallel_For.
+	@param		inStart		The first index of the range.
+	@param		inEnd		One past the last index of the range.
+*/
+typedef std::function< void ( TQ3Uns32 inStart, TQ3Uns32 inEnd ) >	TE3ParallelBody;
+
+
+
+//=============================================================================
+//      Function prototypes
+//-----------------------------------------------------------------------------
+/*!
+	@function	E3Parallel_For
+	@abstract	Do some work for a range of indices, split across threads.
+	@discussion	The range [0, inCount) is split into pieces of at least
+				inMinPerTask indices, and the body is called once for each
+				piece, on the calling thread and on the threads of a pool
+				which is created when first needed.  Returns when every
+				piece is done.
+				
+				Different pieces must not touch the same data, or use the
+				same Quesa object, at the same time.  They may share
+				references to objects, as described in Quesa.h.
+				
+				If the range is too small to be worth splitting, or the pool
+				is already busy, for instance because E3Parallel_For was called
+				from inside a body, the body is called for the whole range on
+				the calling thread.
+				
+				An exception thrown by the body is passed on to the caller,
+				once every piece has finished.
+	@param		inCount			Number of indices.
+	@param		inMinPerTask	Smallest number of indices worth giving to a
+								thread.
+	@param		inBody			The work to do.
+*/
+void		E3Parallel_For( TQ3Uns32 inCount,
+							TQ3Uns32 inMinPerTask,
+							const TE3ParallelBody& inBody );
+
+
+/*!
+	@function	E3Parallel_GetThreadCount
+	@abstract	Get the number of threads, including the calling thread, that
+				E3Parallel_For may use.
+	@result		The thread count.
+*/
+TQ3Uns32	E3Parallel_GetThreadCount( void );
+
+
+/*!
+	@function	E3Parallel_SetThreadCount
+	@abstract	Set the number of threads, including the calling thread, that
+				E3Parallel_For may use.
+	@discussion	Passing 0 restores the default, the number of hardware threads.
+				Passing 1 makes E3Parallel_For run everything on the calling
+				thread.  Must not be called while E3Parallel_For is running.
+	@param		inCount			The thread count.
+*/
+void		E3Parallel_SetThreadCount( TQ3Uns32 inCount );
+
+
+/*!
+	@function	E3Parallel_Terminate
+	@abstract	Stop the threads of the pool.
+	@discussion	Called when Quesa is terminated.  The pool will be restarted
+				if E3Parallel_For is called again.
+*/
+void		E3Parallel_Terminate( void );
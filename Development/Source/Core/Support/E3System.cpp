@@ -47,6 +47,7 @@
 #include "E3System.h"
 #include "GNRegister.h"
 #include "QORegister.h"
+#include "SWRegister.h"
 
 
 
@@ -147,6 +148,7 @@ E3System_LoadPlugins(void)
 	// Register the built-in plug-ins
 #if QUESA_REGISTER_BUILTIN_PLUGINS
 	GNRenderer_Register();
+	SWRenderer_Register();
 #if QUESA_BUILT_IN_OPENGL_RENDERER
 	QORenderer_Register();
 #endif
@@ -177,6 +179,7 @@ E3System_UnloadPlugins(void)
 	// Unregister the built-in plug-ins
 #if QUESA_REGISTER_BUILTIN_PLUGINS
 	GNRenderer_Unregister();
+	SWRenderer_Unregister();
 #if QUESA_BUILT_IN_OPENGL_RENDERER
 	QORenderer_Unregister();
 #endif
@@ -212,25 +215,25 @@ E3System_ClearBottleneck(void)
 
 
 	// Validate our state
-	Q3_ASSERT(gE3Globals.systemDoBottleneck);
+	Q3_ASSERT(gE3ThreadGlobals.systemDoBottleneck);
 
 
 
 	// Clear the Error Manager state
-	if (gE3Globals.errMgrClearError)
+	if (gE3ThreadGlobals.errMgrClearError)
 		E3ErrorManager_ClearError();
 
-	if (gE3Globals.errMgrClearWarning)
+	if (gE3ThreadGlobals.errMgrClearWarning)
 		E3ErrorManager_ClearWarning();
 
-	if (gE3Globals.errMgrClearNotice)
+	if (gE3ThreadGlobals.errMgrClearNotice)
 		E3ErrorManager_ClearNotice();
 
-	if (gE3Globals.errMgrClearPlatform)
+	if (gE3ThreadGlobals.errMgrClearPlatform)
 		E3ErrorManager_ClearPlatformError();
 
 
 
 	// Reset our state
-	gE3Globals.systemDoBottleneck = kQ3False;
+	gE3ThreadGlobals.systemDoBottleneck = kQ3False;
 }
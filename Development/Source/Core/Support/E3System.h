@@ -68,11 +68,11 @@ extern "C" {
 //
 // Invoked on every API entry point to allow us to perform system housekeeping.
 // To minimise the performance impact, the bottleneck is implemented as a macro
-// which polls a global then invokes a real function if there is any work to do.
+// which polls a per-thread flag then invokes a real function if there is any work to do.
 #define E3System_Bottleneck()													\
 				do																\
 					{															\
-					if (gE3Globals.systemDoBottleneck)							\
+					if (gE3ThreadGlobals.systemDoBottleneck)					\
 						E3System_ClearBottleneck();								\
 					}															\
 				while (0)
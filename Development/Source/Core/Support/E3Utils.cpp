@@ -51,6 +51,18 @@
 #include "E3Utils.h"
 #include "E3View.h"
 
+#if defined(__AVX2__)
+	#include <immintrin.h>
+#elif defined(__SSSE3__)
+	#include <tmmintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	#include <emmintrin.h>
+	#define QUESA_SWAP_SSE2		1
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+	#include <arm_neon.h>
+	#define QUESA_SWAP_NEON		1
+#endif
+
 
 
 
@@ -323,6 +335,131 @@ void E3Geometry_AddNormalIndicators(TQ3GroupObject group, TQ3Uns32 numPoints,
 
 
 
+//=============================================================================
+//      E3EndianSwapArray16 : Byte swap an array of 16-bit values.
+//-----------------------------------------------------------------------------
+//		Note :	The source and destination may be the same, but must not
+//				otherwise overlap. Neither needs to be aligned.
+//-----------------------------------------------------------------------------
+void
+E3EndianSwapArray16(TQ3Uns32 numNums, const void *srcData, void *dstData)
+{	const TQ3Uns8	*src = (const TQ3Uns8 *) srcData;
+	TQ3Uns8			*dst = (TQ3Uns8 *)       dstData;
+	TQ3Uns32		n    = 0;
+	TQ3Uns16		theValue;
+
+
+
+	// Swap as many values as we can in parallel
+#if defined(__AVX2__)
+	const __m256i theMask = _mm256_setr_epi8( 1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14,
+											  1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14 );
+	for (; n + 16 <= numNums; n += 16)
+		{
+		__m256i theValues = _mm256_loadu_si256( (const __m256i *) (src + n * 2) );
+		_mm256_storeu_si256( (__m256i *) (dst + n * 2), _mm256_shuffle_epi8( theValues, theMask ) );
+		}
+
+#elif defined(__SSSE3__)
+	const __m128i theMask = _mm_setr_epi8( 1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14 );
+	for (; n + 8 <= numNums; n += 8)
+		{
+		__m128i theValues = _mm_loadu_si128( (const __m128i *) (src + n * 2) );
+		_mm_storeu_si128( (__m128i *) (dst + n * 2), _mm_shuffle_epi8( theValues, theMask ) );
+		}
+
+#elif QUESA_SWAP_SSE2
+	for (; n + 8 <= numNums; n += 8)
+		{
+		__m128i theValues = _mm_loadu_si128( (const __m128i *) (src + n * 2) );
+		theValues = _mm_or_si128( _mm_slli_epi16( theValues, 8 ), _mm_srli_epi16( theValues, 8 ) );
+		_mm_storeu_si128( (__m128i *) (dst + n * 2), theValues );
+		}
+
+#elif QUESA_SWAP_NEON
+	for (; n + 8 <= numNums; n += 8)
+		vst1q_u8( dst + n * 2, vrev16q_u8( vld1q_u8( src + n * 2 ) ) );
+#endif
+
+
+
+	// Swap the remainder
+	for (; n < numNums; ++n)
+		{
+		memcpy( &theValue, src + n * 2, sizeof(theValue) );
+		theValue = (TQ3Uns16) E3EndianSwap16( theValue );
+		memcpy( dst + n * 2, &theValue, sizeof(theValue) );
+		}
+}
+
+
+
+
+
+//=============================================================================
+//      E3EndianSwapArray32 : Byte swap an array of 32-bit values.
+//-----------------------------------------------------------------------------
+//		Note :	The source and destination may be the same, but must not
+//				otherwise overlap. Neither needs to be aligned.
+//-----------------------------------------------------------------------------
+void
+E3EndianSwapArray32(TQ3Uns32 numNums, const void *srcData, void *dstData)
+{	const TQ3Uns8	*src = (const TQ3Uns8 *) srcData;
+	TQ3Uns8			*dst = (TQ3Uns8 *)       dstData;
+	TQ3Uns32		n    = 0;
+	TQ3Uns32		theValue;
+
+
+
+	// Swap as many values as we can in parallel
+#if defined(__AVX2__)
+	const __m256i theMask = _mm256_setr_epi8( 3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12,
+											  3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12 );
+	for (; n + 8 <= numNums; n += 8)
+		{
+		__m256i theValues = _mm256_loadu_si256( (const __m256i *) (src + n * 4) );
+		_mm256_storeu_si256( (__m256i *) (dst + n * 4), _mm256_shuffle_epi8( theValues, theMask ) );
+		}
+
+#elif defined(__SSSE3__)
+	const __m128i theMask = _mm_setr_epi8( 3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12 );
+	for (; n + 4 <= numNums; n += 4)
+		{
+		__m128i theValues = _mm_loadu_si128( (const __m128i *) (src + n * 4) );
+		_mm_storeu_si128( (__m128i *) (dst + n * 4), _mm_shuffle_epi8( theValues, theMask ) );
+		}
+
+#elif QUESA_SWAP_SSE2
+	// Swap the bytes within each 16-bit half, then swap the halves
+	for (; n + 4 <= numNums; n += 4)
+		{
+		__m128i theValues = _mm_loadu_si128( (const __m128i *) (src + n * 4) );
+		theValues = _mm_or_si128( _mm_slli_epi16( theValues, 8 ), _mm_srli_epi16( theValues, 8 ) );
+		theValues = _mm_shufflelo_epi16( theValues, _MM_SHUFFLE( 2, 3, 0, 1 ) );
+		theValues = _mm_shufflehi_epi16( theValues, _MM_SHUFFLE( 2, 3, 0, 1 ) );
+		_mm_storeu_si128( (__m128i *) (dst + n * 4), theValues );
+		}
+
+#elif QUESA_SWAP_NEON
+	for (; n + 4 <= numNums; n += 4)
+		vst1q_u8( dst + n * 4, vrev32q_u8( vld1q_u8( src + n * 4 ) ) );
+#endif
+
+
+
+	// Swap the remainder
+	for (; n < numNums; ++n)
+		{
+		memcpy( &theValue, src + n * 4, sizeof(theValue) );
+		theValue = E3EndianSwap32( theValue );
+		memcpy( dst + n * 4, &theValue, sizeof(theValue) );
+		}
+}
+
+
+
+
+
 //=============================================================================
 //      E3Matrix4x4_IsIdentity : Is a TQ3Matrix4x4 an identity matrix?
 //-----------------------------------------------------------------------------
@@ -550,19 +687,17 @@ E3Rect_IntersectRect(const TQ3Area *rect1, const TQ3Area *rect2)
 
 
 
-	// Check for overlaps in x
-	if ((rect1->min.x >= rect2->min.x || rect1->min.x <= rect2->max.x) ||
-		(rect1->max.x >= rect2->min.x || rect1->max.x <= rect2->max.x))
-		return(kQ3True);
+	// Check for separation in x
+	if (rect1->min.x > rect2->max.x || rect1->max.x < rect2->min.x)
+		return(kQ3False);
 
 
 
-	// Check for overlaps in y
-	if ((rect1->min.y >= rect2->min.y || rect1->min.x <= rect2->max.y) ||
-		(rect1->max.y >= rect2->min.y || rect1->max.x <= rect2->max.y))
-		return(kQ3True);
+	// Check for separation in y
+	if (rect1->min.y > rect2->max.y || rect1->max.y < rect2->min.y)
+		return(kQ3False);
 	
-	return(kQ3False);
+	return(kQ3True);
 }
 
 
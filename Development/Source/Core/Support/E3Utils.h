@@ -191,6 +191,10 @@ void		E3AttributeSet_Combine(TQ3AttributeSet parent, TQ3AttributeSet child, TQ3A
 
 void		E3Geometry_AddNormalIndicators(TQ3GroupObject group, TQ3Uns32 numPoints, const TQ3Point3D *points, const TQ3Vector3D *normals);
 
+void		E3EndianSwapArray16(TQ3Uns32 numNums, const void *srcData, void *dstData);
+
+void		E3EndianSwapArray32(TQ3Uns32 numNums, const void *srcData, void *dstData);
+
 TQ3Boolean	E3Matrix4x4_IsIdentity(const TQ3Matrix4x4 *theMatrix);
 
 TQ3Boolean	E3CString_IsEqual(const char *str_a, const char *str_b);
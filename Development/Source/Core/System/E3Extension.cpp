@@ -210,6 +210,25 @@ E3XObjectHierarchy_FindClassByType(TQ3ObjectType theType)
 
 
 
+//=============================================================================
+//      E3XObjectHierarchy_GetDynamicLookupCount : Get the dynamic lookup count.
+//-----------------------------------------------------------------------------
+TQ3Uns32
+E3XObjectHierarchy_GetDynamicLookupCount(TQ3Boolean inReset)
+	{
+	// Get the count, and reset it if required
+	TQ3Uns32 theCount = E3ClassTree::GetDynamicLookupCount () ;
+	
+	if ( inReset )
+		E3ClassTree::ResetDynamicLookupCount () ;
+	
+	return theCount ;
+	}
+
+
+
+
+
 //=============================================================================
 //      E3XObjectClass_GetMethod : Find a method for a class.
 //-----------------------------------------------------------------------------
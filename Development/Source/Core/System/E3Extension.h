@@ -73,6 +73,7 @@ TQ3Status				E3XObjectHierarchy_UnregisterClass(TQ3XObjectClass objectClass);
 TQ3Object				E3XObjectHierarchy_NewObject(TQ3XObjectClass objectClass, void *parameters);
 TQ3Status				E3XObjectHierarchy_GetClassVersion(TQ3ObjectType objectClassType, TQ3XObjectClassVersion *version);
 TQ3XObjectClass			E3XObjectHierarchy_FindClassByType(TQ3ObjectType theType);
+TQ3Uns32				E3XObjectHierarchy_GetDynamicLookupCount(TQ3Boolean inReset);
 TQ3XFunctionPointer		E3XObjectClass_GetMethod(TQ3XObjectClass objectClass, TQ3XMethodType methodType);
 TQ3ObjectType			E3XObjectClass_GetLeafType(TQ3XObjectClass objectClass);
 TQ3Status				E3XObjectClass_GetType(TQ3XObjectClass objectClass, TQ3ObjectType *theType);
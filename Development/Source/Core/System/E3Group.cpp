@@ -45,6 +45,8 @@
 //-----------------------------------------------------------------------------
 #include "E3Prefix.h"
 #include "E3Group.h"
+#include "E3GroupBounds.h"
+#include "E3GroupPickIndex.h"
 #include "E3IOFileFormat.h"
 #include "E3View.h"
 #include "E3ClassTree.h"
@@ -166,6 +168,21 @@ E3GroupInfo::E3GroupInfo	(
 	}
 
 
+//=============================================================================
+//      e3group_contents_changed : Note a change to the contents of a group.
+//-----------------------------------------------------------------------------
+//		Note :	Adding or removing objects doesn't change the edit index of a
+//				group, so the automatic bounds of the group, and of the
+//				groups above it, are invalidated here instead.
+//-----------------------------------------------------------------------------
+static inline void
+e3group_contents_changed ( E3Group* theGroup )
+	{
+	if ( theGroup->sharedData.boundsFlags.load ( std::memory_order_relaxed ) != 0 )
+		E3GroupBounds_Invalidate ( theGroup ) ;
+	}
+
+
 //=============================================================================
 //      e3drawcontext_new_class_info : Method to construct a class info record.
 //-----------------------------------------------------------------------------
@@ -1076,13 +1093,16 @@ e3group_submit_contents(TQ3ViewObject theView, TQ3ObjectType objectType, E3Group
 
 
 //=============================================================================
-//      e3group_submit_pick : Group submit method for picking.
+//      e3group_submit_pick_contents : Submit the contents of a group for
+//				picking.
+//-----------------------------------------------------------------------------
+//		Note :	If skipFlags is not nullptr, it holds a flag for each object in
+//				the group, and objects with a nonzero flag are not submitted.
 //-----------------------------------------------------------------------------
 static TQ3Status
-e3group_submit_pick(TQ3ViewObject theView, TQ3ObjectType objectType,
-					E3Group* theObject, const void *objectData)
+e3group_submit_pick_contents(TQ3ViewObject theView, E3Group* theObject,
+								const TQ3Uns8* skipFlags, TQ3Uns32 numSkipFlags)
 {
-#pragma unused( objectType, objectData )
 	E3GroupInfo* groupClass = theObject->GetClass () ;
 
 
@@ -1095,22 +1115,28 @@ e3group_submit_pick(TQ3ViewObject theView, TQ3ObjectType objectType,
 	// Submit the contents of the group
 	TQ3GroupPosition thePosition ;
 	TQ3Object subObject ;
+	TQ3Uns32 objectIndex = 0 ;
 	TQ3Status qd3dStatus = groupClass->startIterateMethod ( theObject, &thePosition, &subObject, theView ) ;
 	if ( qd3dStatus != kQ3Failure )
 	{
 		while ( subObject != nullptr ) // If that was the last object, stop
 		{
-			// We're picking, update the view
-			E3View_PickStack_SavePosition ( theView, thePosition ) ;
+			if ( ( skipFlags == nullptr ) || ( objectIndex >= numSkipFlags ) ||
+				( skipFlags[ objectIndex ] == 0 ) )
+			{
+				// We're picking, update the view
+				E3View_PickStack_SavePosition ( theView, thePosition ) ;
 
 
 
-			// Submit the object, ignore errors
-			E3View_SubmitRetained( theView, subObject );
+				// Submit the object, ignore errors
+				E3View_SubmitRetained( theView, subObject );
+			}
 
 
 
 			// Get the next object	
+			++objectIndex ;
 			qd3dStatus = groupClass->endIterateMethod ( theObject, &thePosition, &subObject, theView ) ;
 			if ( qd3dStatus == kQ3Failure )
 				return kQ3Failure ;
@@ -1131,6 +1157,23 @@ e3group_submit_pick(TQ3ViewObject theView, TQ3ObjectType objectType,
 
 
 
+//=============================================================================
+//      e3group_submit_pick : Group submit method for picking.
+//-----------------------------------------------------------------------------
+static TQ3Status
+e3group_submit_pick(TQ3ViewObject theView, TQ3ObjectType objectType,
+					E3Group* theObject, const void *objectData)
+{
+#pragma unused( objectType, objectData )
+
+
+	return e3group_submit_pick_contents ( theView, theObject, nullptr, 0 ) ;
+}
+
+
+
+
+
 //=============================================================================
 //      e3group_submit_write : Group write submit method.
 //-----------------------------------------------------------------------------
@@ -1324,6 +1367,10 @@ e3group_display_new(TQ3Object theObject, void *privateData, const void *paramDat
 	instanceData->displayGroupData.bBox.max.z   = 0.0f;
 	instanceData->displayGroupData.bBox.isEmpty = kQ3True;
 
+	instanceData->displayGroupData.autoBounds           = instanceData->displayGroupData.bBox;
+	instanceData->displayGroupData.autoBoundsGeneration = 0;
+	instanceData->displayGroupData.autoBoundsStatus     = kE3GroupBoundsNone;
+
 	return kQ3Success ;
 	}
 
@@ -1358,6 +1405,18 @@ e3group_display_submit_render(TQ3ViewObject theView, TQ3ObjectType objectType,
 	{
 		shouldSubmit = E3Renderer_Method_IsBBoxVisible( theView, &theBBox );
 	}
+	
+	
+	
+	// Otherwise use the automatic bounds of the group, if allowed
+	else if ( shouldSubmit &&
+		! E3Bit_IsSet( theState, kQ3DisplayGroupStateMaskUseBoundingBox ) &&
+		! E3Bit_AnySet( theState, kQ3DisplayGroupStateMaskIsInline ) &&
+		E3View_IsAutomaticGroupCullingAllowed( theView ) &&
+		E3GroupBounds_Get( theObject, theBBox ) )
+	{
+		shouldSubmit = E3Renderer_Method_IsBBoxVisible( theView, &theBBox );
+	}
 
 
 
@@ -1466,8 +1525,14 @@ e3group_display_submit_pick(TQ3ViewObject theView, TQ3ObjectType objectType,
 		if ( qd3dStatus == kQ3Failure ) return qd3dStatus;
 		
 		
-		// Submit the group, using the generic group submit method
-		qd3dStatus = e3group_submit_pick ( theView, objectType, (E3Group*) theObject, objectData ) ;
+		// Submit the group, skipping anything its pick index says the pick
+		// cannot reach
+		E3FastArray<TQ3Uns8> skipFlags ;
+		if ( E3GroupPickIndex_FindSkipped ( theView, theObject, skipFlags ) )
+			qd3dStatus = e3group_submit_pick_contents ( theView, (E3Group*) theObject,
+				skipFlags.empty() ? nullptr : &skipFlags[0], skipFlags.size() ) ;
+		else
+			qd3dStatus = e3group_submit_pick ( theView, objectType, (E3Group*) theObject, objectData ) ;
 
 
 
@@ -2858,7 +2923,11 @@ TQ3GroupPosition
 E3Group::AddObject ( TQ3Object object )
 	{
 	// Call the method
-	return GetClass ()->addObjectMethod ( this, object ) ;
+	TQ3GroupPosition result = GetClass ()->addObjectMethod ( this, object ) ;
+
+	e3group_contents_changed ( this ) ;
+
+	return result ;
 	}
 
 
@@ -2894,7 +2963,11 @@ E3Group::AddObjectBefore ( TQ3GroupPosition position, TQ3Object object )
 	{
 	
 	// Call the method
-	return GetClass ()->addObjectBeforeMethod ( this, position, object ) ;
+	TQ3GroupPosition result = GetClass ()->addObjectBeforeMethod ( this, position, object ) ;
+
+	e3group_contents_changed ( this ) ;
+
+	return result ;
 	}
 
 
@@ -2908,7 +2981,11 @@ TQ3GroupPosition
 E3Group::AddObjectAfter ( TQ3GroupPosition position, TQ3Object object )
 	{
 	// Call the method
-	return GetClass ()->addObjectAfterMethod ( this, position, object ) ;
+	TQ3GroupPosition result = GetClass ()->addObjectAfterMethod ( this, position, object ) ;
+
+	e3group_contents_changed ( this ) ;
+
+	return result ;
 	}
 
 
@@ -2966,7 +3043,11 @@ TQ3Object
 E3Group::RemovePosition ( TQ3GroupPosition position )
 	{
 	// Call the method
-	return GetClass ()->removePositionMethod ( this, position ) ;
+	TQ3Object result = GetClass ()->removePositionMethod ( this, position ) ;
+
+	e3group_contents_changed ( this ) ;
+
+	return result ;
 	}
 
 
@@ -3050,7 +3131,11 @@ TQ3Status
 E3Group::EmptyObjects ( void )
 	{
 	// Call the method
-	return GetClass ()->emptyObjectsOfTypeMethod ( this, kQ3ObjectTypeShared ) ;
+	TQ3Status result = GetClass ()->emptyObjectsOfTypeMethod ( this, kQ3ObjectTypeShared ) ;
+
+	e3group_contents_changed ( this ) ;
+
+	return result ;
 	}
 
 
@@ -3134,7 +3219,11 @@ TQ3Status
 E3Group::EmptyObjectsOfType ( TQ3ObjectType isType )
 	{
 	// Call the method
-	return GetClass ()->emptyObjectsOfTypeMethod ( this, isType ) ;
+	TQ3Status result = GetClass ()->emptyObjectsOfTypeMethod ( this, isType ) ;
+
+	e3group_contents_changed ( this ) ;
+
+	return result ;
 	}
 
 
@@ -249,10 +249,23 @@ public :
 
 
 
+enum E3GroupBoundsStatus
+{
+	kE3GroupBoundsNone = 0,
+	kE3GroupBoundsBounded,
+	kE3GroupBoundsUnboundable
+};
+
+
 struct E3DisplayGroupData
 {
 	TQ3DisplayGroupState	state ;
 	TQ3BoundingBox			bBox ;
+	
+	// Automatic bounds, maintained by E3GroupBounds
+	TQ3BoundingBox			autoBounds ;
+	TQ3Uns32				autoBoundsGeneration ;
+	E3GroupBoundsStatus		autoBoundsStatus ;
 };
 
 
@@ -263,7 +276,7 @@ Q3_CLASS_ENUMS ( kQ3GroupTypeDisplay, E3DisplayGroup, E3Group )
 
 public :
 
-// 32 bytes + 16 bytes = 48 bytes overhead per display group
+// 32 bytes + 48 bytes + 16 bytes = 96 bytes overhead per display group
 // initialised in e3group_display_new
 	E3DisplayGroupData		displayGroupData;
 	
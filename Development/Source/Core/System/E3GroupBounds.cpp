@@ -0,0 +1,785 @@
+/*  NAME:
+        E3GroupBounds.cpp
+
+    DESCRIPTION:
+        Automatic bounds of display groups, used for group culling.
+
+    COPYRIGHT:
+        Copyright (c) 2026, Quesa Developers. All rights reserved.
+
+        For the current release of Quesa, please see:
+
+            <https://github.com/jwwalker/Quesa>
+        
+        Redistribution and use in source and binary forms, with or without
+        modification, are permitted provided that the following conditions
+        are met:
+        
+            o Redistributions of source code must retain the above copyright
+              notice, this list of conditions and the following disclaimer.
+        
+            o Redistributions in binary form must reproduce the above
+              copyright notice, this list of conditions and the following
+              disclaimer in the documentation and/or other materials provided
+              with the distribution.
+        
+            o Neither the name of Quesa nor the names of its contributors
+              may be used to endorse or promote products derived from this
+              software without specific prior written permission.
+        
+        THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+        "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+        LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+        A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+        OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+        SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+        TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+        PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+        LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+        NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+        SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+    ___________________________________________________________________________
+*/
+
+
+
+
+//=============================================================================
+//      Include files
+//-----------------------------------------------------------------------------
+#include "E3GroupBounds.h"
+
+#include "E3Camera.h"
+#include "E3Group.h"
+#include "E3Main.h"
+#include "E3Math.h"
+#include "E3Style.h"
+#include "E3Transform.h"
+#include "E3View.h"
+#include "QuesaMathOperators.hpp"
+#include "CQ3ObjectRef.h"
+
+#include <algorithm>
+#include <mutex>
+#include <new>
+#include <unordered_map>
+#include <vector>
+
+
+
+/*
+	DISCUSSION
+	
+	Group culling normally needs a bounding box set on the group by the
+	application.  When automatic group culling is allowed in a view, a display
+	group which is not inline and has no bounding box of its own is culled
+	against bounds computed from its contents.
+	
+	The bounds of a group are built from the bounds of its children, so that a
+	change deep in a scene only recomputes the groups above it.  Geometries
+	are bounded with a scratch bounding view, while display groups which push
+	the view state contribute their own cached bounds, transformed into the
+	coordinates of the parent.  Inline groups and plain groups are walked as
+	part of their parent, since their transforms affect what follows them.
+	
+	Editing an object does not change the edit index of the groups that
+	contain it, so when a group computes its bounds it registers itself as a
+	dependent of every object they were computed from: its geometries,
+	transforms and subgroups.  Those objects are flagged, and when a flagged
+	object is edited, or the contents of a flagged group change, the bounds
+	of its dependents are invalidated, and so on up the parent chain.  Cached
+	bounds are then used without looking at the contents of the group at all,
+	and an edit only costs as much as the number of groups it invalidates.
+	
+	Each group has a generation, which is advanced when its bounds are
+	invalidated, so that registrations left over from earlier bounds can be
+	recognised and ignored.  They are pruned as the lists grow, and all of a
+	group's registrations are removed when it is disposed of.  The pick index
+	of a group registers in the same way, so that it shares the invalidation.
+	
+	A group is left unbounded, and so never culled, if anything in it could
+	draw outside bounds known in advance: markers, cameras, lights, transforms
+	which depend on the camera or on the transform outside the group, IO proxy
+	groups, unbalanced pops of the view state, and geometries with no bounds.
+*/
+
+
+
+//=============================================================================
+//      Internal constants and types
+//-----------------------------------------------------------------------------
+namespace
+{
+	// Relative padding of computed bounds, to cover geometries whose render
+	// methods decompose them differently to their bounds methods
+	const float			kGroupBoundsPadding		= 1.0e-3f;
+	
+	// Bounds flags of shared objects
+	const TQ3Uns32		kBoundsFlagHasDependents	= (1 << 0);
+	const TQ3Uns32		kBoundsFlagHasRegistered	= (1 << 1);
+	
+	// Smallest list of dependents which is pruned of stale entries
+	const size_t		kMinPruneSize				= 16;
+	
+	struct BoundsContext
+	{
+		CQ3ObjectRef				boundsView;
+		std::vector<TQ3Matrix4x4>	matrixStack;
+		TQ3Uns32					stackBase;
+	};
+	
+	struct Dependent
+	{
+		E3DisplayGroup*				group;
+		TQ3Uns32					generation;
+	};
+	
+	typedef std::vector<TQ3Object>		ObjectVec;
+	typedef std::vector<Dependent>		DependentVec;
+	
+	// The registry is guarded by sRegistryLock.  sDependents maps an object to
+	// the groups whose bounds were computed from it, and sDependencies maps a
+	// group to every object it has registered with, sorted.
+	std::mutex									sRegistryLock;
+	std::unordered_map<TQ3Object, DependentVec>	sDependents;
+	std::unordered_map<E3DisplayGroup*, ObjectVec>	sDependencies;
+}
+
+
+
+
+
+//=============================================================================
+//      Internal function prototypes
+//-----------------------------------------------------------------------------
+static void		e3groupbounds_validate( BoundsContext& ioContext, E3DisplayGroup* inGroup );
+
+
+
+
+
+//=============================================================================
+//      Internal functions
+//-----------------------------------------------------------------------------
+//      e3groupbounds_object_at : Get the object at a group position.
+//-----------------------------------------------------------------------------
+//		Note :	Unlike GetPositionObject, this does not add a reference.
+//-----------------------------------------------------------------------------
+static inline TQ3Object
+e3groupbounds_object_at( TQ3GroupPosition inPosition )
+{
+	return ( (TQ3XGroupPosition*) inPosition )->object;
+}
+
+
+
+
+
+//=============================================================================
+//      e3groupbounds_is_culled_group : Is an object a display group which
+//				keeps its own automatic bounds?
+//-----------------------------------------------------------------------------
+static bool
+e3groupbounds_is_culled_group( TQ3Object inObject )
+{
+	if ( (! Q3Object_IsType( inObject, kQ3GroupTypeDisplay )) ||
+		Q3Object_IsType( inObject, kQ3DisplayGroupTypeIOProxy ) )
+		return false;
+	
+	TQ3DisplayGroupState theState = 0;
+	( (E3DisplayGroup*) inObject )->GetState( &theState );
+	
+	return ! E3Bit_AnySet( theState, kQ3DisplayGroupStateMaskIsInline );
+}
+
+
+
+
+
+//=============================================================================
+//      e3groupbounds_is_local_transform : Can a transform be followed?
+//-----------------------------------------------------------------------------
+//		Note :	Reset and camera transforms depend on the transform outside
+//				the group, or on the camera.
+//-----------------------------------------------------------------------------
+static bool
+e3groupbounds_is_local_transform( TQ3TransformObject inTransform )
+{
+	switch (Q3Transform_GetType( inTransform ))
+	{
+		case kQ3TransformTypeMatrix:
+		case kQ3TransformTypeScale:
+		case kQ3TransformTypeTranslate:
+		case kQ3TransformTypeRotate:
+		case kQ3TransformTypeRotateAboutPoint:
+		case kQ3TransformTypeRotateAboutAxis:
+		case kQ3TransformTypeQuaternion:
+			return true;
+	}
+	
+	return false;
+}
+
+
+
+
+
+//=============================================================================
+//      e3groupbounds_new_bounds_view : Create a view for bounding geometries.
+//-----------------------------------------------------------------------------
+//		Note :	The camera plays no part in the bounds, but a view can't start
+//				a bounding loop without one.
+//-----------------------------------------------------------------------------
+static TQ3ViewObject
+e3groupbounds_new_bounds_view()
+{
+	TQ3OrthographicCameraData	cameraData;
+	
+	memset( &cameraData, 0, sizeof(cameraData) );
+	cameraData.cameraData.placement.cameraLocation.z	= 1.0f;
+	cameraData.cameraData.placement.upVector.y			= 1.0f;
+	cameraData.cameraData.range.hither					= 0.1f;
+	cameraData.cameraData.range.yon						= 10.0f;
+	cameraData.cameraData.viewPort.origin.x				= -1.0f;
+	cameraData.cameraData.viewPort.origin.y				=  1.0f;
+	cameraData.cameraData.viewPort.width				=  2.0f;
+	cameraData.cameraData.viewPort.height				=  2.0f;
+	cameraData.left										= -1.0f;
+	cameraData.top										=  1.0f;
+	cameraData.right									=  1.0f;
+	cameraData.bottom									= -1.0f;
+	
+	CQ3ObjectRef	theCamera( E3OrthographicCamera_New( &cameraData ) );
+	TQ3ViewObject	theView = Q3View_New();
+	
+	if ( (theView != nullptr) &&
+		( (! theCamera.isvalid()) || (Q3View_SetCamera( theView, theCamera.get() ) == kQ3Failure) ) )
+	{
+		Q3Object_Dispose( theView );
+		theView = nullptr;
+	}
+	
+	return theView;
+}
+
+
+
+
+
+//=============================================================================
+//      e3groupbounds_calc_geometry : Find the bounds of a geometry, in the
+//				coordinates of its group.
+//-----------------------------------------------------------------------------
+static void
+e3groupbounds_calc_geometry( BoundsContext& ioContext,
+							TQ3GeometryObject inGeometry,
+							const TQ3Matrix4x4& inObjectToGroup,
+							TQ3BoundingBox& outBounds )
+{
+	TQ3SubdivisionStyleData	subData = {
+		kQ3SubdivisionMethodConstant,
+		20.0f, 20.0f
+	};
+	TQ3ViewStatus			viewStatus;
+	
+	outBounds.isEmpty = kQ3True;
+	
+	if (! ioContext.boundsView.isvalid())
+		ioContext.boundsView = CQ3ObjectRef( e3groupbounds_new_bounds_view() );
+	
+	TQ3ViewObject boundsView = ioContext.boundsView.get();
+	if ( (boundsView == nullptr) ||
+		(Q3View_StartBoundingBox( boundsView, kQ3ComputeBoundsExact ) == kQ3Failure) )
+		return;
+	
+	do
+	{
+		// Submit a subdivision style, because some geometries do not implement
+		// the default screen space subdivision.
+		E3SubdivisionStyle_Submit( &subData, boundsView );
+		E3MatrixTransform_Submit( &inObjectToGroup, boundsView );
+		Q3Object_Submit( inGeometry, boundsView );
+		
+		viewStatus = Q3View_EndBoundingBox( boundsView, &outBounds );
+	}
+	while (viewStatus == kQ3ViewStatusRetraverse);
+	
+	if (viewStatus != kQ3ViewStatusDone)
+		outBounds.isEmpty = kQ3True;
+}
+
+
+
+
+
+//=============================================================================
+//      e3groupbounds_calc_contents : Accumulate the bounds of the contents
+//				of a group.
+//-----------------------------------------------------------------------------
+//		Note :	The matrix and the matrix stack follow the transforms and
+//				state operators in the group, as a view would.  Returns false
+//				if the group can't be bounded.  Every object the bounds depend
+//				on is added to ioDependencies, including those which make the
+//				group unboundable.
+//-----------------------------------------------------------------------------
+static bool
+e3groupbounds_calc_contents( BoundsContext& ioContext,
+							E3Group* inGroup,
+							TQ3Matrix4x4& ioObjectToGroup,
+							TQ3BoundingBox& ioBounds,
+							ObjectVec& ioDependencies )
+{
+	TQ3GroupPosition	thePosition = nullptr;
+	
+	inGroup->GetFirstPosition( &thePosition );
+	while (thePosition != nullptr)
+	{
+		TQ3Object		theObject = e3groupbounds_object_at( thePosition );
+		TQ3BoundingBox	theBounds;
+		
+		theBounds.isEmpty = kQ3True;
+		
+		if (Q3Object_IsType( theObject, kQ3ShapeTypeGeometry ))
+		{
+			ioDependencies.push_back( theObject );
+			
+			// Markers are drawn in window space
+			if (Q3Object_IsType( theObject, kQ3GeometryTypeMarker ) ||
+				Q3Object_IsType( theObject, kQ3GeometryTypePixmapMarker ))
+				return false;
+			
+			// Geometries with no bounds may still draw something
+			e3groupbounds_calc_geometry( ioContext, theObject, ioObjectToGroup, theBounds );
+			if (theBounds.isEmpty)
+				return false;
+		}
+		
+		else if (Q3Object_IsType( theObject, kQ3ShapeTypeTransform ))
+		{
+			ioDependencies.push_back( theObject );
+			
+			if (! e3groupbounds_is_local_transform( theObject ))
+				return false;
+			
+			TQ3Matrix4x4 theMatrix;
+			Q3Transform_GetMatrix( theObject, &theMatrix );
+			ioObjectToGroup = theMatrix * ioObjectToGroup;
+		}
+		
+		else if (Q3Object_IsType( theObject, kQ3ShapeTypeStateOperator ))
+		{
+			if (Q3Object_IsType( theObject, kQ3StateOperatorTypePush ))
+			{
+				ioContext.matrixStack.push_back( ioObjectToGroup );
+			}
+			else if (Q3Object_IsType( theObject, kQ3StateOperatorTypePop ))
+			{
+				if (ioContext.matrixStack.size() <= ioContext.stackBase)
+					return false;
+				
+				ioObjectToGroup = ioContext.matrixStack.back();
+				ioContext.matrixStack.pop_back();
+			}
+		}
+		
+		else if (Q3Object_IsType( theObject, kQ3ShapeTypeGroup ))
+		{
+			ioDependencies.push_back( theObject );
+			
+			if (Q3Object_IsType( theObject, kQ3DisplayGroupTypeIOProxy ))
+				return false;
+			
+			TQ3DisplayGroupState theState = kQ3DisplayGroupStateMaskIsDrawn;
+			if (Q3Object_IsType( theObject, kQ3GroupTypeDisplay ))
+				( (E3DisplayGroup*) theObject )->GetState( &theState );
+			
+			if (! E3Bit_AnySet( theState, kQ3DisplayGroupStateMaskIsDrawn ))
+			{
+				// Not drawn, so it does not matter
+			}
+			else if (e3groupbounds_is_culled_group( theObject ))
+			{
+				// Use the cached bounds of the child, which depend on its
+				// contents rather than ours
+				e3groupbounds_validate( ioContext, (E3DisplayGroup*) theObject );
+				
+				const E3DisplayGroupData& childData = ( (E3DisplayGroup*) theObject )->displayGroupData;
+				
+				if (childData.autoBoundsStatus != kE3GroupBoundsBounded)
+					return false;
+				
+				E3BoundingBox_Transform( &childData.autoBounds, &ioObjectToGroup, &theBounds );
+			}
+			else if (! e3groupbounds_calc_contents( ioContext, (E3Group*) theObject,
+				ioObjectToGroup, ioBounds, ioDependencies ))
+			{
+				return false;
+			}
+		}
+		
+		else if (Q3Object_IsType( theObject, kQ3ShapeTypeCamera ) ||
+			Q3Object_IsType( theObject, kQ3ShapeTypeLight ) ||
+			Q3Object_IsType( theObject, kQ3ShapeTypeReference ))
+		{
+			return false;
+		}
+		
+		if (! theBounds.isEmpty)
+			E3BoundingBox_Union( &ioBounds, &theBounds, &ioBounds );
+		
+		inGroup->GetNextPosition( &thePosition );
+	}
+	
+	return true;
+}
+
+
+
+
+
+//=============================================================================
+//      e3groupbounds_calc : Compute the bounds of a display group.
+//-----------------------------------------------------------------------------
+static E3GroupBoundsStatus
+e3groupbounds_calc( BoundsContext& ioContext,
+					E3DisplayGroup* inGroup,
+					TQ3BoundingBox& outBounds,
+					ObjectVec& outDependencies )
+{
+	TQ3Matrix4x4	objectToGroup;
+	TQ3Uns32		oldBase = ioContext.stackBase;
+	
+	E3Matrix4x4_SetIdentity( &objectToGroup );
+	E3BoundingBox_Reset( &outBounds );
+	
+	
+	
+	// The group starts with the view state pushed, and pops it at the end
+	ioContext.stackBase = static_cast<TQ3Uns32>( ioContext.matrixStack.size() );
+	
+	bool isBounded = e3groupbounds_calc_contents( ioContext, inGroup, objectToGroup,
+		outBounds, outDependencies );
+	
+	ioContext.matrixStack.resize( ioContext.stackBase );
+	ioContext.stackBase = oldBase;
+	
+	if (! isBounded)
+		return kE3GroupBoundsUnboundable;
+	
+	if (! outBounds.isEmpty)
+	{
+		float padding = kGroupBoundsPadding * E3Num_Max( outBounds.max.x - outBounds.min.x,
+			E3Num_Max( outBounds.max.y - outBounds.min.y, outBounds.max.z - outBounds.min.z ) );
+		
+		outBounds.min.x -= padding;
+		outBounds.min.y -= padding;
+		outBounds.min.z -= padding;
+		outBounds.max.x += padding;
+		outBounds.max.y += padding;
+		outBounds.max.z += padding;
+	}
+	
+	return kE3GroupBoundsBounded;
+}
+
+
+
+
+
+//=============================================================================
+//      e3groupbounds_prune : Remove stale entries from a list of dependents.
+//-----------------------------------------------------------------------------
+//		Note :	Called with the registry locked.
+//-----------------------------------------------------------------------------
+static void
+e3groupbounds_prune( DependentVec& ioDependents )
+{
+	ioDependents.erase( std::remove_if( ioDependents.begin(), ioDependents.end(),
+		[]( const Dependent& inDependent )
+		{
+			return inDependent.generation !=
+				inDependent.group->displayGroupData.autoBoundsGeneration;
+		} ), ioDependents.end() );
+}
+
+
+
+
+
+//=============================================================================
+//      e3groupbounds_register : Register a group as a dependent of the
+//				objects its bounds were computed from.
+//-----------------------------------------------------------------------------
+//		Note :	Called with the registry locked.  The group is flagged before
+//				it is added to any list, so that it is always removed from them
+//				when it is disposed of.
+//-----------------------------------------------------------------------------
+static void
+e3groupbounds_register( E3DisplayGroup* inGroup, ObjectVec& ioDependencies )
+{
+	std::sort( ioDependencies.begin(), ioDependencies.end() );
+	ioDependencies.erase( std::unique( ioDependencies.begin(), ioDependencies.end() ),
+		ioDependencies.end() );
+	
+	
+	
+	// Remember every object the group has registered with
+	ObjectVec& knownObjects = sDependencies[ inGroup ];
+	ObjectVec mergedObjects;
+	mergedObjects.reserve( knownObjects.size() + ioDependencies.size() );
+	std::set_union( knownObjects.begin(), knownObjects.end(),
+		ioDependencies.begin(), ioDependencies.end(),
+		std::back_inserter( mergedObjects ) );
+	knownObjects.swap( mergedObjects );
+	
+	inGroup->sharedData.boundsFlags.fetch_or( kBoundsFlagHasRegistered, std::memory_order_relaxed );
+	
+	
+	
+	// And add it to the dependents of each object
+	Dependent theDependent = { inGroup, inGroup->displayGroupData.autoBoundsGeneration };
+	
+	for (TQ3Object theObject : ioDependencies)
+	{
+		DependentVec& theDependents = sDependents[ theObject ];
+		
+		if ( (theDependents.size() >= kMinPruneSize) &&
+			((theDependents.size() & (theDependents.size() - 1)) == 0) )
+			e3groupbounds_prune( theDependents );
+		
+		theDependents.push_back( theDependent );
+		
+		( (E3Shared*) theObject )->sharedData.boundsFlags.fetch_or( kBoundsFlagHasDependents,
+			std::memory_order_relaxed );
+	}
+}
+
+
+
+
+
+//=============================================================================
+//      e3groupbounds_validate : Bring the cached bounds of a group up to date.
+//-----------------------------------------------------------------------------
+//		Note :	A duplicate of a group copies its cached bounds, but not its
+//				registration, so its bounds are only trusted once registered.
+//-----------------------------------------------------------------------------
+static void
+e3groupbounds_validate( BoundsContext& ioContext, E3DisplayGroup* inGroup )
+{
+	E3DisplayGroupData&	groupData = inGroup->displayGroupData;
+	
+	
+	
+	// If nothing beneath the group has changed, the cache is current
+	if ( (groupData.autoBoundsStatus != kE3GroupBoundsNone) &&
+		E3Bit_AnySet( inGroup->sharedData.boundsFlags.load( std::memory_order_relaxed ),
+			kBoundsFlagHasRegistered ) )
+		return;
+	
+	
+	
+	// Otherwise compute the bounds, and register the group with everything
+	// they were computed from before publishing them
+	TQ3BoundingBox		theBounds;
+	ObjectVec			theDependencies;
+	
+	E3GroupBoundsStatus theStatus = e3groupbounds_calc( ioContext, inGroup, theBounds,
+		theDependencies );
+	
+	std::lock_guard<std::mutex> theLock( sRegistryLock );
+	
+	e3groupbounds_register( inGroup, theDependencies );
+	
+	groupData.autoBounds       = theBounds;
+	groupData.autoBoundsStatus = theStatus;
+}
+
+
+
+
+
+//=============================================================================
+//      Public functions
+//-----------------------------------------------------------------------------
+//      E3GroupBounds_Get : Get the automatic bounds of a display group.
+//-----------------------------------------------------------------------------
+bool
+E3GroupBounds_Get( TQ3GroupObject theGroup, TQ3BoundingBox& outBounds )
+{
+	E3DisplayGroup* displayGroup = (E3DisplayGroup*) theGroup;
+	
+	try
+	{
+		BoundsContext theContext;
+		theContext.stackBase = 0;
+		
+		e3groupbounds_validate( theContext, displayGroup );
+	}
+	catch (const std::bad_alloc&)
+	{
+		displayGroup->displayGroupData.autoBoundsStatus = kE3GroupBoundsNone;
+		return false;
+	}
+	
+	if (displayGroup->displayGroupData.autoBoundsStatus != kE3GroupBoundsBounded)
+		return false;
+	
+	outBounds = displayGroup->displayGroupData.autoBounds;
+	
+	return true;
+}
+
+
+
+
+
+//=============================================================================
+//      E3GroupBounds_Register : Register a group as a dependent of objects.
+//-----------------------------------------------------------------------------
+TQ3Uns32
+E3GroupBounds_Register( TQ3GroupObject theGroup, TQ3Uns32 numObjects,
+						const TQ3Object* theObjects )
+{
+	E3DisplayGroup*	displayGroup = (E3DisplayGroup*) theGroup;
+	ObjectVec		theDependencies( theObjects, theObjects + numObjects );
+	
+	std::lock_guard<std::mutex> theLock( sRegistryLock );
+	
+	e3groupbounds_register( displayGroup, theDependencies );
+	
+	return displayGroup->displayGroupData.autoBoundsGeneration;
+}
+
+
+
+
+
+//=============================================================================
+//      E3GroupBounds_IsCurrent : Is a registration of a group still current?
+//-----------------------------------------------------------------------------
+bool
+E3GroupBounds_IsCurrent( TQ3GroupObject theGroup, TQ3Uns32 inGeneration )
+{
+	E3DisplayGroup* displayGroup = (E3DisplayGroup*) theGroup;
+	
+	return E3Bit_AnySet( displayGroup->sharedData.boundsFlags.load( std::memory_order_relaxed ),
+		kBoundsFlagHasRegistered ) &&
+		(displayGroup->displayGroupData.autoBoundsGeneration == inGeneration);
+}
+
+
+
+
+
+//=============================================================================
+//      E3GroupBounds_Invalidate : Invalidate the bounds which depend on an
+//				object.
+//-----------------------------------------------------------------------------
+void
+E3GroupBounds_Invalidate( TQ3Object theObject )
+{
+	std::lock_guard<std::mutex> theLock( sRegistryLock );
+	
+	ObjectVec	toVisit( 1, theObject );
+	
+	while (! toVisit.empty())
+	{
+		E3Shared* theShared = (E3Shared*) toVisit.back();
+		toVisit.pop_back();
+		
+		TQ3Uns32 theFlags = theShared->sharedData.boundsFlags.load( std::memory_order_relaxed );
+		
+		
+		
+		// A group which has cached bounds loses them, and any registrations
+		// it made for them become stale
+		if (E3Bit_AnySet( theFlags, kBoundsFlagHasRegistered ))
+		{
+			E3DisplayGroupData& groupData = ( (E3DisplayGroup*) theShared )->displayGroupData;
+			
+			groupData.autoBoundsStatus      = kE3GroupBoundsNone;
+			groupData.autoBoundsGeneration += 1;
+		}
+		
+		
+		
+		// Groups whose current bounds depend on the object are invalidated
+		// in turn.  They register again when their bounds are recomputed.
+		if (E3Bit_AnySet( theFlags, kBoundsFlagHasDependents ))
+		{
+			auto theEntry = sDependents.find( theShared );
+			
+			if (theEntry != sDependents.end())
+			{
+				for (const Dependent& theDependent : theEntry->second)
+				{
+					if (theDependent.generation ==
+						theDependent.group->displayGroupData.autoBoundsGeneration)
+						toVisit.push_back( theDependent.group );
+				}
+				
+				sDependents.erase( theEntry );
+			}
+			
+			theShared->sharedData.boundsFlags.fetch_and( ~kBoundsFlagHasDependents,
+				std::memory_order_relaxed );
+		}
+	}
+}
+
+
+
+
+
+//=============================================================================
+//      E3GroupBounds_Forget : Remove an object from the bounds registry.
+//-----------------------------------------------------------------------------
+//		Note :	The objects a group registered with may already have been
+//				disposed of, so only the registry is touched, not the objects.
+//-----------------------------------------------------------------------------
+void
+E3GroupBounds_Forget( TQ3Object theObject )
+{
+	std::lock_guard<std::mutex> theLock( sRegistryLock );
+	
+	E3Shared* theShared = (E3Shared*) theObject;
+	
+	
+	
+	// Remove a group from the lists of the objects it registered with
+	if (E3Bit_AnySet( theShared->sharedData.boundsFlags.load( std::memory_order_relaxed ),
+		kBoundsFlagHasRegistered ))
+	{
+		auto theObjects = sDependencies.find( (E3DisplayGroup*) theObject );
+		
+		if (theObjects != sDependencies.end())
+		{
+			for (TQ3Object dependency : theObjects->second)
+			{
+				auto theEntry = sDependents.find( dependency );
+				if (theEntry == sDependents.end())
+					continue;
+				
+				DependentVec& theDependents = theEntry->second;
+				theDependents.erase( std::remove_if( theDependents.begin(), theDependents.end(),
+					[theObject]( const Dependent& inDependent )
+					{
+						return inDependent.group == theObject;
+					} ), theDependents.end() );
+				
+				if (theDependents.empty())
+					sDependents.erase( theEntry );
+			}
+			
+			sDependencies.erase( theObjects );
+		}
+	}
+	
+	
+	
+	// And forget the groups which depended on the object
+	sDependents.erase( theObject );
+	
+	theShared->sharedData.boundsFlags.store( 0, std::memory_order_relaxed );
+}
@@ -0,0 +1,143 @@
+#pragma once
+/*  NAME:
+        E3GroupBounds.h
+
+    DESCRIPTION:
+        Header file for E3GroupBounds.cpp.
+
+    COPYRIGHT:
+        Copyright (c) 2026, Quesa Developers. All rights reserved.
+
+        For the current release of Quesa, please see:
+
+            <https://github.com/jwwalker/Quesa>
+        
+        Redistribution and use in source and binary forms, with or without
+        modification, are permitted provided that the following conditions
+        are met:
+        
+            o Redistributions of source code must retain the above copyright
+              notice, this list of conditions and the following disclaimer.
+        
+            o Redistributions in binary form must reproduce the above
+              copyright notice, this list of conditions and the following
+              disclaimer in the documentation and/or other materials provided
+              with the distribution.
+        
+            o Neither the name of Quesa nor the names of its contributors
+              may be used to endorse or promote products derived from this
+              software without specific prior written permission.
+        
+        THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+        "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+        LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+        A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+        OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+        SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+        TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+        PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+        LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+        NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+        SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+    ___________________________________________________________________________
+*/
+
+
+
+
+
+
+
+
+//=============================================================================
+//      Include files
+//-----------------------------------------------------------------------------
+#include "E3Prefix.h"
+
+
+
+//=============================================================================
+//      Function prototypes
+//-----------------------------------------------------------------------------
+/*!
+	@function	E3GroupBounds_Get
+	
+	@abstract	Get the automatically maintained bounds of a display group.
+	
+	@discussion	The bounds contain everything drawn by the contents of the
+				group, in the local coordinates of the group, as if the group
+				were submitted with the view state pushed.  They are computed
+				when first needed and cached in the group, which registers
+				itself with everything they were computed from, so they are
+				only recomputed after something in the group has been edited.
+				
+				Some groups have no useful bounds, for example because they
+				contain a marker or a transform which depends on the view.
+	
+	@param		theGroup		The display group.
+	@param		outBounds		Receives the bounds of the group.  These may
+								be empty, if the group draws nothing.
+	@result		True if the group could be bounded.
+*/
+bool	E3GroupBounds_Get( TQ3GroupObject theGroup,
+							TQ3BoundingBox& outBounds );
+
+
+/*!
+	@function	E3GroupBounds_Register
+	
+	@abstract	Register a display group as a dependent of some objects.
+	
+	@discussion	Lets other caches of a group share the invalidation of its
+				bounds.  When any of the objects is edited, or the contents of
+				the group change, the generation of the group is advanced, as
+				are those of the groups which depend on it.
+	
+	@param		theGroup		The display group.
+	@param		numObjects		The number of objects.
+	@param		theObjects		The objects the cache was computed from.
+	@result		The generation of the group, for E3GroupBounds_IsCurrent.
+*/
+TQ3Uns32	E3GroupBounds_Register( TQ3GroupObject theGroup,
+									TQ3Uns32 numObjects,
+									const TQ3Object* theObjects );
+
+
+/*!
+	@function	E3GroupBounds_IsCurrent
+	
+	@abstract	Check whether a registration of a group is still current.
+	
+	@param		theGroup		The display group.
+	@param		inGeneration	The generation returned by E3GroupBounds_Register.
+	@result		True if nothing the group registered with has changed since.
+*/
+bool	E3GroupBounds_IsCurrent( TQ3GroupObject theGroup,
+								TQ3Uns32 inGeneration );
+
+
+/*!
+	@function	E3GroupBounds_Invalidate
+	
+	@abstract	Invalidate the cached bounds which depend on an object.
+	
+	@discussion	Called when an object with bounds flags set is edited, or when
+				the contents of such a group change.  The bounds of the object,
+				if it is a group, and of every group whose bounds were computed
+				from it, directly or through a subgroup, are invalidated.
+	
+	@param		theObject		The object which has changed.
+*/
+void	E3GroupBounds_Invalidate( TQ3Object theObject );
+
+
+/*!
+	@function	E3GroupBounds_Forget
+	
+	@abstract	Remove an object from the registry of bounds dependencies.
+	
+	@discussion	Called when an object with bounds flags set is disposed of.
+	
+	@param		theObject		The object being disposed of.
+*/
+void	E3GroupBounds_Forget( TQ3Object theObject );
@@ -0,0 +1,693 @@
+/*  NAME:
+        E3GroupPickIndex.cpp
+
+    DESCRIPTION:
+        Bounds index used to skip the contents of display groups when picking.
+
+    COPYRIGHT:
+        Copyright (c) 2026, Quesa Developers. All rights reserved.
+
+        For the current release of Quesa, please see:
+
+            <https://github.com/jwwalker/Quesa>
+        
+        Redistribution and use in source and binary forms, with or without
+        modification, are permitted provided that the following conditions
+        are met:
+        
+            o Redistributions of source code must retain the above copyright
+              notice, this list of conditions and the following disclaimer.
+        
+            o Redistributions in binary form must reproduce the above
+              copyright notice, this list of conditions and the following
+              disclaimer in the documentation and/or other materials provided
+              with the distribution.
+        
+            o Neither the name of Quesa nor the names of its contributors
+              may be used to endorse or promote products derived from this
+              software without specific prior written permission.
+        
+        THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+        "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+        LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+        A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+        OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+        SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+        TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+        PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+        LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+        NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+        SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+    ___________________________________________________________________________
+*/
+
+
+//=============================================================================
+//      Include files
+//-----------------------------------------------------------------------------
+#include "E3GroupPickIndex.h"
+
+#include "E3BVH.h"
+#include "E3Camera.h"
+#include "E3Group.h"
+#include "E3GroupBounds.h"
+#include "E3Main.h"
+#include "E3Math.h"
+#include "E3Pick.h"
+#include "E3Style.h"
+#include "E3Transform.h"
+#include "E3View.h"
+#include "QuesaMathOperators.hpp"
+#include "CQ3ObjectRef.h"
+
+#include <vector>
+#include <new>
+
+
+
+/*
+	DISCUSSION
+	
+	Picking submits everything in a scene and lets each geometry test itself
+	against the pick, even when the pick only touches a small part of the
+	scene.  A display group with the kQ3DisplayGroupPropertyPickIndex property
+	keeps a bounding volume hierarchy over the bounds of its contents, so that
+	a pick can skip the geometries and subgroups it cannot reach.
+	
+	Only some objects in the group are indexed: geometries, and display groups
+	which push and pop the view state.  Everything else, such as transforms,
+	styles and attribute sets, is always submitted, so that the view state
+	seen by the objects which are submitted does not change.  The bounds of an
+	object depend on the transforms ahead of it in the group, so we follow
+	them while building the index.  Once we meet an object that changes the
+	transform in a way we can't follow, such as an inline group containing a
+	transform, nothing more in the group is indexed.
+	
+	Markers are picked in window space, where their bounds tell us nothing,
+	so they are never indexed, nor are groups containing them.
+	
+	The index is stored as a flat block of memory in a property of the group:
+	
+		IndexCacheRec
+		TE3BVHNode		nodes[ nodeCount ]
+		TQ3Uns32		items[ itemCount ]
+		TQ3Uns8			isIndexed[ childCount ]
+	
+	Editing an object inside the group does not change the edit index of the
+	group, so when the index is built the group registers as a dependent of
+	everything beneath it, using the registry of the automatic group bounds.
+	An edit to any of those objects, or to the contents of the group, then
+	advances the generation of the group, and the cache records the
+	generation it was built for.  Checking the cache costs the same however
+	large the group is.  The cache also records the group it was built for,
+	since a duplicate of the group copies the property but not the
+	registration.
+*/
+
+
+
+//=============================================================================
+//      Internal constants and types
+//-----------------------------------------------------------------------------
+namespace
+{
+	const TQ3ObjectType	kPropertyTypePickIndexCache	= Q3_OBJECT_TYPE('d', 'g', 'p', 'c');
+	
+	// Relative padding of indexed bounds, to cover geometries whose pick
+	// methods decompose them differently to their bounds methods
+	const float			kIndexedBoundsPadding		= 1.0e-3f;
+	
+	struct IndexCacheRec
+	{
+		TQ3Uns32			ownerLow;		// Property data is only 4-byte aligned
+		TQ3Uns32			ownerHigh;
+		TQ3Uns32			generation;
+		TQ3Uns32			childCount;
+		TQ3Uns32			nodeCount;
+		TQ3Uns32			itemCount;
+		// Followed by:
+		// Variable-size array of TE3BVHNode
+		// Variable-size array of TQ3Uns32 child indices
+		// Variable-size array of TQ3Uns8 flags
+	};
+}
+
+
+
+
+
+//=============================================================================
+//      Internal functions
+//-----------------------------------------------------------------------------
+//      e3grouppickindex_object_at : Get the object at a group position.
+//-----------------------------------------------------------------------------
+//		Note :	Unlike GetPositionObject, this does not add a reference.
+//-----------------------------------------------------------------------------
+static inline TQ3Object
+e3grouppickindex_object_at( TQ3GroupPosition inPosition )
+{
+	return ( (TQ3XGroupPosition*) inPosition )->object;
+}
+
+
+
+
+
+//=============================================================================
+//      e3grouppickindex_add_dependencies : Collect everything beneath a group.
+//-----------------------------------------------------------------------------
+static void
+e3grouppickindex_add_dependencies( TQ3GroupObject inGroup,
+								std::vector<TQ3Object>& ioDependencies )
+{
+	E3Group*			theGroup = (E3Group*) inGroup;
+	TQ3GroupPosition	thePosition = nullptr;
+	
+	theGroup->GetFirstPosition( &thePosition );
+	while (thePosition != nullptr)
+	{
+		TQ3Object theObject = e3grouppickindex_object_at( thePosition );
+		
+		ioDependencies.push_back( theObject );
+		
+		if (Q3Object_IsType( theObject, kQ3ShapeTypeGroup ))
+			e3grouppickindex_add_dependencies( theObject, ioDependencies );
+		
+		theGroup->GetNextPosition( &thePosition );
+	}
+}
+
+
+
+
+
+//=============================================================================
+//      e3grouppickindex_is_inline : Does submitting a group leave its state
+//				in the view?
+//-----------------------------------------------------------------------------
+static bool
+e3grouppickindex_is_inline( TQ3GroupObject inGroup )
+{
+	if (! Q3Object_IsType( inGroup, kQ3GroupTypeDisplay ))
+		return true;
+	
+	TQ3DisplayGroupState theState = 0;
+	( (E3DisplayGroup*) inGroup )->GetState( &theState );
+	
+	return E3Bit_AnySet( theState, kQ3DisplayGroupStateMaskIsInline ) == kQ3True;
+}
+
+
+
+
+
+//=============================================================================
+//      e3grouppickindex_changes_frame : Does submitting an inline group
+//				change the local to world transform?
+//-----------------------------------------------------------------------------
+static bool
+e3grouppickindex_changes_frame( TQ3GroupObject inGroup )
+{
+	E3Group*			theGroup = (E3Group*) inGroup;
+	TQ3GroupPosition	thePosition = nullptr;
+	
+	theGroup->GetFirstPosition( &thePosition );
+	while (thePosition != nullptr)
+	{
+		TQ3Object theObject = e3grouppickindex_object_at( thePosition );
+		
+		if (Q3Object_IsType( theObject, kQ3ShapeTypeTransform ))
+			return true;
+		
+		if ( Q3Object_IsType( theObject, kQ3ShapeTypeGroup ) &&
+			e3grouppickindex_is_inline( theObject ) &&
+			e3grouppickindex_changes_frame( theObject ) )
+			return true;
+		
+		theGroup->GetNextPosition( &thePosition );
+	}
+	
+	return false;
+}
+
+
+
+
+
+//=============================================================================
+//      e3grouppickindex_is_local_transform : Can a transform be followed
+//				while building the index?
+//-----------------------------------------------------------------------------
+//		Note :	Reset and camera transforms depend on the transform outside
+//				the group, or on the camera.
+//-----------------------------------------------------------------------------
+static bool
+e3grouppickindex_is_local_transform( TQ3TransformObject inTransform )
+{
+	switch (Q3Transform_GetType( inTransform ))
+	{
+		case kQ3TransformTypeMatrix:
+		case kQ3TransformTypeScale:
+		case kQ3TransformTypeTranslate:
+		case kQ3TransformTypeRotate:
+		case kQ3TransformTypeRotateAboutPoint:
+		case kQ3TransformTypeRotateAboutAxis:
+		case kQ3TransformTypeQuaternion:
+			return true;
+	}
+	
+	return false;
+}
+
+
+
+
+
+//=============================================================================
+//      e3grouppickindex_can_bound : Do the bounds of an object contain
+//				everything that can pick it?
+//-----------------------------------------------------------------------------
+static bool
+e3grouppickindex_can_bound( TQ3Object inObject )
+{
+	if (Q3Object_IsType( inObject, kQ3GeometryTypeMarker ) ||
+		Q3Object_IsType( inObject, kQ3GeometryTypePixmapMarker ))
+		return false;
+	
+	if (Q3Object_IsType( inObject, kQ3ShapeTypeTransform ))
+		return e3grouppickindex_is_local_transform( inObject );
+	
+	if (! Q3Object_IsType( inObject, kQ3ShapeTypeGroup ))
+		return true;
+	
+	
+	
+	// Groups which are left out of bounds, or which choose what to submit
+	// based on the view, can't be bounded
+	if (Q3Object_IsType( inObject, kQ3DisplayGroupTypeIOProxy ))
+		return false;
+	
+	if (Q3Object_IsType( inObject, kQ3GroupTypeDisplay ))
+	{
+		TQ3DisplayGroupState theState = 0;
+		( (E3DisplayGroup*) inObject )->GetState( &theState );
+		if (E3Bit_AnySet( theState, kQ3DisplayGroupStateMaskIsNotForBounding ))
+			return false;
+	}
+	
+	E3Group*			theGroup = (E3Group*) inObject;
+	TQ3GroupPosition	thePosition = nullptr;
+	
+	theGroup->GetFirstPosition( &thePosition );
+	while (thePosition != nullptr)
+	{
+		if (! e3grouppickindex_can_bound( e3grouppickindex_object_at( thePosition ) ))
+			return false;
+		
+		theGroup->GetNextPosition( &thePosition );
+	}
+	
+	return true;
+}
+
+
+
+
+
+//=============================================================================
+//      e3grouppickindex_new_bounds_view : Create a view for bounding objects.
+//-----------------------------------------------------------------------------
+//		Note :	The camera plays no part in the bounds, but a view can't start
+//				a bounding loop without one.
+//-----------------------------------------------------------------------------
+static TQ3ViewObject
+e3grouppickindex_new_bounds_view()
+{
+	TQ3OrthographicCameraData	cameraData;
+	
+	memset( &cameraData, 0, sizeof(cameraData) );
+	cameraData.cameraData.placement.cameraLocation.z	= 1.0f;
+	cameraData.cameraData.placement.upVector.y			= 1.0f;
+	cameraData.cameraData.range.hither					= 0.1f;
+	cameraData.cameraData.range.yon						= 10.0f;
+	cameraData.cameraData.viewPort.origin.x				= -1.0f;
+	cameraData.cameraData.viewPort.origin.y				=  1.0f;
+	cameraData.cameraData.viewPort.width				=  2.0f;
+	cameraData.cameraData.viewPort.height				=  2.0f;
+	cameraData.left										= -1.0f;
+	cameraData.top										=  1.0f;
+	cameraData.right									=  1.0f;
+	cameraData.bottom									= -1.0f;
+	
+	CQ3ObjectRef	theCamera( E3OrthographicCamera_New( &cameraData ) );
+	TQ3ViewObject	theView = Q3View_New();
+	
+	if ( (theView != nullptr) &&
+		( (! theCamera.isvalid()) || (Q3View_SetCamera( theView, theCamera.get() ) == kQ3Failure) ) )
+	{
+		Q3Object_Dispose( theView );
+		theView = nullptr;
+	}
+	
+	return theView;
+}
+
+
+
+
+
+//=============================================================================
+//      e3grouppickindex_calc_bounds : Find the bounds of an object, in the
+//				coordinates of its group.
+//-----------------------------------------------------------------------------
+static void
+e3grouppickindex_calc_bounds( TQ3ViewObject inBoundsView,
+							TQ3Object inObject,
+							const TQ3Matrix4x4& inObjectToGroup,
+							TQ3BoundingBox& outBounds )
+{
+	TQ3SubdivisionStyleData	subData = {
+		kQ3SubdivisionMethodConstant,
+		20.0f, 20.0f
+	};
+	TQ3ViewStatus			viewStatus;
+	
+	outBounds.isEmpty = kQ3True;
+	
+	if (Q3View_StartBoundingBox( inBoundsView, kQ3ComputeBoundsExact ) == kQ3Failure)
+		return;
+	
+	do
+	{
+		// Submit a subdivision style, because some geometries do not implement
+		// the default screen space subdivision.
+		E3SubdivisionStyle_Submit( &subData, inBoundsView );
+		E3MatrixTransform_Submit( &inObjectToGroup, inBoundsView );
+		Q3Object_Submit( inObject, inBoundsView );
+		
+		viewStatus = Q3View_EndBoundingBox( inBoundsView, &outBounds );
+	}
+	while (viewStatus == kQ3ViewStatusRetraverse);
+	
+	if (viewStatus != kQ3ViewStatusDone)
+	{
+		outBounds.isEmpty = kQ3True;
+	}
+	else if (! outBounds.isEmpty)
+	{
+		float padding = kIndexedBoundsPadding * E3Num_Max( outBounds.max.x - outBounds.min.x,
+			E3Num_Max( outBounds.max.y - outBounds.min.y, outBounds.max.z - outBounds.min.z ) );
+		
+		outBounds.min.x -= padding;
+		outBounds.min.y -= padding;
+		outBounds.min.z -= padding;
+		outBounds.max.x += padding;
+		outBounds.max.y += padding;
+		outBounds.max.z += padding;
+	}
+}
+
+
+
+
+
+//=============================================================================
+//      e3grouppickindex_build : Build the index for a group.
+//-----------------------------------------------------------------------------
+static void
+e3grouppickindex_build( TQ3GroupObject inGroup,
+						std::vector<TE3BVHNode>& outNodes,
+						std::vector<TQ3Uns32>& outItems,
+						std::vector<TQ3Uns8>& outIsIndexed )
+{
+	E3Group*					theGroup = (E3Group*) inGroup;
+	TQ3GroupPosition			thePosition = nullptr;
+	std::vector<TQ3BoundingBox>	childBounds;
+	TQ3Matrix4x4				childToGroup;
+	bool						isFrameKnown = true;
+	CQ3ObjectRef				boundsView( e3grouppickindex_new_bounds_view() );
+	
+	E3Matrix4x4_SetIdentity( &childToGroup );
+	
+	
+	
+	// Find the bounds of each object we can skip
+	theGroup->GetFirstPosition( &thePosition );
+	while (thePosition != nullptr)
+	{
+		TQ3Object		theObject = e3grouppickindex_object_at( thePosition );
+		TQ3BoundingBox	theBounds;
+		bool			isIndexed = false;
+		
+		theBounds.isEmpty = kQ3True;
+		
+		if (Q3Object_IsType( theObject, kQ3ShapeTypeTransform ))
+		{
+			if (isFrameKnown && e3grouppickindex_is_local_transform( theObject ))
+			{
+				TQ3Matrix4x4 theMatrix;
+				Q3Transform_GetMatrix( theObject, &theMatrix );
+				childToGroup = theMatrix * childToGroup;
+			}
+			else
+				isFrameKnown = false;
+		}
+		else if (Q3Object_IsType( theObject, kQ3ShapeTypeGroup ) &&
+			e3grouppickindex_is_inline( theObject ))
+		{
+			if (e3grouppickindex_changes_frame( theObject ))
+				isFrameKnown = false;
+		}
+		else if ( isFrameKnown && boundsView.isvalid() &&
+			( Q3Object_IsType( theObject, kQ3ShapeTypeGeometry ) ||
+			Q3Object_IsType( theObject, kQ3GroupTypeDisplay ) ) &&
+			e3grouppickindex_can_bound( theObject ) )
+		{
+			e3grouppickindex_calc_bounds( boundsView.get(), theObject, childToGroup, theBounds );
+			isIndexed = true;
+		}
+		
+		childBounds.push_back( theBounds );
+		outIsIndexed.push_back( isIndexed ? 1 : 0 );
+		
+		theGroup->GetNextPosition( &thePosition );
+	}
+	
+	
+	
+	// Build the hierarchy.  Indexed objects with empty bounds can't be
+	// picked, so they are left out of it and always skipped.
+	E3BVH_Build( static_cast<TQ3Uns32>( childBounds.size() ),
+		childBounds.empty() ? nullptr : &childBounds[0], outNodes, outItems );
+}
+
+
+
+
+
+//=============================================================================
+//      e3grouppickindex_access : Get the cached index, building it if needed.
+//-----------------------------------------------------------------------------
+static const IndexCacheRec*
+e3grouppickindex_access( TQ3GroupObject inGroup )
+{
+	E3Shared*		theShared = (E3Shared*) inGroup;
+	const uint64_t	theOwner  = (uintptr_t) inGroup;
+	const TQ3Uns32	ownerLow  = static_cast<TQ3Uns32>( theOwner & 0xFFFFFFFFU );
+	const TQ3Uns32	ownerHigh = static_cast<TQ3Uns32>( theOwner >> 32 );
+	const IndexCacheRec* cacheData = reinterpret_cast<const IndexCacheRec*>(
+		theShared->GetPropertyAddress( kPropertyTypePickIndexCache ) );
+	
+	if ( (cacheData != nullptr) && (cacheData->ownerLow == ownerLow) &&
+		(cacheData->ownerHigh == ownerHigh) &&
+		E3GroupBounds_IsCurrent( inGroup, cacheData->generation ) )
+	{
+		return cacheData;
+	}
+	
+	
+	
+	// Build a new index, and pack it into a property
+	try
+	{
+		std::vector<TE3BVHNode>	theNodes;
+		std::vector<TQ3Uns32>	theItems;
+		std::vector<TQ3Uns8>	isIndexed;
+		std::vector<TQ3Object>	theDependencies;
+		
+		e3grouppickindex_build( inGroup, theNodes, theItems, isIndexed );
+		e3grouppickindex_add_dependencies( inGroup, theDependencies );
+		
+		TQ3Uns32 propSize = static_cast<TQ3Uns32>( sizeof(IndexCacheRec) +
+			theNodes.size() * sizeof(TE3BVHNode) +
+			theItems.size() * sizeof(TQ3Uns32) +
+			isIndexed.size() );
+		E3FastArray<char>	propBuffer( propSize );
+		char*				dataPtr = &propBuffer[0];
+		
+		IndexCacheRec* newCache = reinterpret_cast<IndexCacheRec*>( dataPtr );
+		newCache->ownerLow   = ownerLow;
+		newCache->ownerHigh  = ownerHigh;
+		newCache->childCount = static_cast<TQ3Uns32>( isIndexed.size() );
+		newCache->nodeCount  = static_cast<TQ3Uns32>( theNodes.size() );
+		newCache->itemCount  = static_cast<TQ3Uns32>( theItems.size() );
+		dataPtr += sizeof(IndexCacheRec);
+		
+		if (! theNodes.empty())
+		{
+			E3Memory_Copy( &theNodes[0], dataPtr,
+				static_cast<TQ3Uns32>( theNodes.size() * sizeof(TE3BVHNode) ) );
+			dataPtr += theNodes.size() * sizeof(TE3BVHNode);
+			
+			E3Memory_Copy( &theItems[0], dataPtr,
+				static_cast<TQ3Uns32>( theItems.size() * sizeof(TQ3Uns32) ) );
+			dataPtr += theItems.size() * sizeof(TQ3Uns32);
+		}
+		
+		if (! isIndexed.empty())
+			E3Memory_Copy( &isIndexed[0], dataPtr, static_cast<TQ3Uns32>( isIndexed.size() ) );
+		
+		
+		// Register with everything beneath the group, so that any edit to
+		// them makes the index stale
+		newCache->generation = E3GroupBounds_Register( inGroup,
+			static_cast<TQ3Uns32>( theDependencies.size() ),
+			theDependencies.empty() ? nullptr : &theDependencies[0] );
+		
+		
+		// Lock the edit index, so that adding a property won't change it.
+		StLockEditIndex lockIndex( inGroup );
+		
+		if (theShared->SetProperty( kPropertyTypePickIndexCache, propSize, newCache ) != kQ3Success)
+			return nullptr;
+	}
+	catch (...)
+	{
+		return nullptr;
+	}
+	
+	return reinterpret_cast<const IndexCacheRec*>(
+		theShared->GetPropertyAddress( kPropertyTypePickIndexCache ) );
+}
+
+
+
+
+
+//=============================================================================
+//      e3grouppickindex_init_test : Set up the node test for the current pick.
+//-----------------------------------------------------------------------------
+static TE3BVHNodeTest
+e3grouppickindex_init_test( TQ3ViewObject theView,
+							TE3BVHRayTest& outRayTest,
+							TE3BVHWindowTest& outWindowTest )
+{
+	TQ3PickObject	thePick = E3View_AccessPick( theView );
+	float			vertexTolerance = 0.0f, edgeTolerance = 0.0f, faceTolerance = 0.0f;
+	TQ3Point2D		thePoint;
+	TQ3Area			theArea;
+	TQ3Ray3D		theRay;
+	
+	if (thePick == nullptr)
+		return nullptr;
+	
+	E3Pick_GetVertexTolerance( thePick, &vertexTolerance );
+	E3Pick_GetEdgeTolerance( thePick, &edgeTolerance );
+	E3Pick_GetFaceTolerance( thePick, &faceTolerance );
+	
+	float tolerance = E3Num_Max( 0.0f,
+		E3Num_Max( vertexTolerance, E3Num_Max( edgeTolerance, faceTolerance ) ) );
+	
+	
+	
+	switch (E3Pick_GetType( thePick ))
+	{
+		case kQ3PickTypeWorldRay:
+			E3WorldRayPick_GetRay( thePick, &theRay );
+			if (E3BVH_InitRayTest( *E3View_State_GetMatrixLocalToWorld( theView ),
+				theRay, tolerance, outRayTest ))
+				return E3BVH_RayNodeTest;
+			break;
+		
+		case kQ3PickTypeWindowPoint:
+			E3WindowPointPick_GetPoint( thePick, &thePoint );
+			theArea.min.x = thePoint.x - tolerance;
+			theArea.min.y = thePoint.y - tolerance;
+			theArea.max.x = thePoint.x + tolerance;
+			theArea.max.y = thePoint.y + tolerance;
+			if (E3BVH_InitWindowTest( theView, theArea, outWindowTest ))
+				return E3BVH_WindowNodeTest;
+			break;
+		
+		case kQ3PickTypeWindowRect:
+			E3WindowRectPick_GetRect( thePick, &theArea );
+			theArea.min.x -= tolerance;
+			theArea.min.y -= tolerance;
+			theArea.max.x += tolerance;
+			theArea.max.y += tolerance;
+			if (E3BVH_InitWindowTest( theView, theArea, outWindowTest ))
+				return E3BVH_WindowNodeTest;
+			break;
+	}
+	
+	return nullptr;
+}
+
+
+
+
+
+//=============================================================================
+//      Public functions
+//-----------------------------------------------------------------------------
+//      E3GroupPickIndex_FindSkipped : Find the objects a pick cannot reach.
+//-----------------------------------------------------------------------------
+bool
+E3GroupPickIndex_FindSkipped( TQ3ViewObject theView,
+							TQ3GroupObject theGroup,
+							E3FastArray<TQ3Uns8>& outSkip )
+{
+	// Check that the group wants an index, and can use one
+	const TQ3Boolean* wantIndex = reinterpret_cast<const TQ3Boolean*>(
+		theGroup->GetPropertyAddress( kQ3DisplayGroupPropertyPickIndex ) );
+	
+	if ( (wantIndex == nullptr) || (*wantIndex == kQ3False) ||
+		Q3Object_IsType( theGroup, kQ3DisplayGroupTypeIOProxy ) )
+		return false;
+	
+	TE3BVHRayTest		rayTest;
+	TE3BVHWindowTest	windowTest;
+	TE3BVHNodeTest		nodeTest = e3grouppickindex_init_test( theView, rayTest, windowTest );
+	if (nodeTest == nullptr)
+		return false;
+	
+	void* testData = (nodeTest == E3BVH_RayNodeTest) ? (void*) &rayTest : (void*) &windowTest;
+	
+	const IndexCacheRec* cacheData = e3grouppickindex_access( theGroup );
+	if (cacheData == nullptr)
+		return false;
+	
+	const TE3BVHNode* theNodes = reinterpret_cast<const TE3BVHNode*>(
+		reinterpret_cast<const char*>( cacheData ) + sizeof(IndexCacheRec) );
+	const TQ3Uns32* theItems = reinterpret_cast<const TQ3Uns32*>(
+		theNodes + cacheData->nodeCount );
+	const TQ3Uns8* isIndexed = reinterpret_cast<const TQ3Uns8*>(
+		theItems + cacheData->itemCount );
+	
+	
+	
+	// Skip the indexed objects, except for those in nodes the pick reaches
+	E3FastArray<TQ3Uns32>	candidates;
+	
+	E3BVH_GetCandidates( cacheData->nodeCount, theNodes, theItems,
+		nodeTest, testData, candidates );
+	
+	outSkip.resizeNotPreserving( cacheData->childCount );
+	if (cacheData->childCount != 0)
+		E3Memory_Copy( isIndexed, &outSkip[0], cacheData->childCount );
+	
+	for (TQ3Uns32 n = 0; n < candidates.size(); ++n)
+		outSkip[ candidates[n] ] = 0;
+	
+	return true;
+}
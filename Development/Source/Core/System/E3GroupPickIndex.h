@@ -0,0 +1,86 @@
+#pragma once
+/*  NAME:
+        E3GroupPickIndex.h
+
+    DESCRIPTION:
+        Header file for E3GroupPickIndex.cpp.
+
+    COPYRIGHT:
+        Copyright (c) 2026, Quesa Developers. All rights reserved.
+
+        For the current release of Quesa, please see:
+
+            <https://github.com/jwwalker/Quesa>
+        
+        Redistribution and use in source and binary forms, with or without
+        modification, are permitted provided that the following conditions
+        are met:
+        
+            o Redistributions of source code must retain the above copyright
+              notice, this list of conditions and the following disclaimer.
+        
+            o Redistributions in binary form must reproduce the above
+              copyright notice, this list of conditions and the following
+              disclaimer in the documentation and/or other materials provided
+              with the distribution.
+        
+            o Neither the name of Quesa nor the names of its contributors
+              may be used to endorse or promote products derived from this
+              software without specific prior written permission.
+        
+        THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+        "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+        LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+        A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+        OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+        SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+        TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+        PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+        LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+        NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+        SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+    ___________________________________________________________________________
+*/
+
+
+
+
+
+
+//=============================================================================
+//      Include files
+//-----------------------------------------------------------------------------
+#include "E3Prefix.h"
+#include "E3FastArray.h"
+
+
+
+//=============================================================================
+//      Function prototypes
+//-----------------------------------------------------------------------------
+/*!
+	@function	E3GroupPickIndex_FindSkipped
+	
+	@abstract	Find the contents of a display group which a pick cannot reach.
+	
+	@discussion	Only groups with the kQ3DisplayGroupPropertyPickIndex property
+				set are indexed.  The index holds the bounds of the contents of
+				the group, in the local coordinates of the group, and is cached
+				in a property.  The group registers as a dependent of everything
+				beneath it, as for its automatic bounds, so any edit beneath the
+				group makes the index stale, and it is rebuilt on the next pick.
+				
+				The view must be picking, with its local to world matrix set up
+				for the contents of the group.
+	
+	@param		theView			The view.
+	@param		theGroup		The display group.
+	@param		outSkip			Receives one flag per object of the group, in
+								the order the group is iterated, which is
+								nonzero for objects that need not be submitted.
+	@result		True if outSkip was filled in, false if every object of the
+				group should be submitted.
+*/
+bool	E3GroupPickIndex_FindSkipped( TQ3ViewObject theView,
+									TQ3GroupObject theGroup,
+									E3FastArray<TQ3Uns8>& outSkip );
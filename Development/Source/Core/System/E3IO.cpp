@@ -887,6 +887,36 @@ E3File::GetReadInGroup ( TQ3FileReadGroupState* readGroupState )
 
 
 
+//=============================================================================
+//      E3File_SetReadInParallel : Set whether the file is read on several
+//				threads.
+//-----------------------------------------------------------------------------
+TQ3Status
+E3File::SetReadInParallel ( TQ3Boolean readInParallel )
+	{
+	instanceData.readInParallel = readInParallel ;
+	return kQ3Success ;
+	}
+
+
+
+
+
+//=============================================================================
+//      E3File_GetReadInParallel : Get whether the file is read on several
+//				threads.
+//-----------------------------------------------------------------------------
+TQ3Status
+E3File::GetReadInParallel ( TQ3Boolean* readInParallel )
+	{
+	*readInParallel = instanceData.readInParallel ;
+	return kQ3Success ;
+	}
+
+
+
+
+
 //=============================================================================
 //      E3File_SetIdleMethod : Set the idle method for a file.
 //-----------------------------------------------------------------------------
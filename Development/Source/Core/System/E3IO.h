@@ -99,6 +99,8 @@ typedef struct TE3FileData {
 	
 	TQ3FileIdleMethod		idleMethod;
 	const void*				idleData;
+	
+	TQ3Boolean				readInParallel;
 } TE3FileData;
 
 
@@ -134,6 +136,8 @@ public :
 	TQ3Boolean				IsEndOfFile ( void ) ;
 	TQ3Status				SetReadInGroup ( TQ3FileReadGroupState readGroupState ) ;
 	TQ3Status				GetReadInGroup ( TQ3FileReadGroupState* readGroupState ) ;
+	TQ3Status				SetReadInParallel ( TQ3Boolean readInParallel ) ;
+	TQ3Status				GetReadInParallel ( TQ3Boolean* readInParallel ) ;
 	TQ3Status				SetIdleMethod ( TQ3FileIdleMethod idle, const void* idleData ) ;
 	TQ3FileFormatObject		GetFileFormat ( void ) ;
 	TE3FileStatus			GetFileStatus ( void ) ;
@@ -53,6 +53,7 @@
 #include "E3DrawContext.h"
 #include "E3Renderer.h"
 #include "E3Group.h"
+#include "E3GroupBounds.h"
 #include "E3Set.h"
 #include "E3Light.h"
 #include "E3Style.h"
@@ -68,13 +69,11 @@
 #include "E3CustomElements.h"
 #include "E3IOFileFormat.h"
 #include "E3StackCrawl.h"
+#include "E3Parallel.h"
 
 
-#if QUESA_OS_MACINTOSH
-	#include <libkern/OSAtomic.h>
-#endif
-
 #include <cstring>
+#include <mutex>
 #include <map>
 #include <set>
 #include <utility>
@@ -92,13 +91,8 @@
 //      Global Variables
 //-----------------------------------------------------------------------------
 
-#if QUESA_OS_MACINTOSH
-	extern volatile int32_t gObjectCount;
-	volatile int32_t	gObjectCount = 0;
-#elif QUESA_OS_WIN32
-	extern volatile LONG gObjectCount;
-	volatile LONG		gObjectCount = 0;
-#endif
+extern std::atomic<TQ3Int32> gObjectCount;
+std::atomic<TQ3Int32>	gObjectCount( 0 );
 
 
 
@@ -129,6 +123,17 @@ typedef std::map< TQ3Object, WeakRefSet > ObToWeakRefs;
 
 static ObToWeakRefs* sObToWeakRefs = nullptr;
 
+// Guards sObToWeakRefs. Deleting an object only takes the lock if some
+// object has weak references, which sWeakRefObjectCount lets us test
+// without it.
+static std::mutex					sWeakRefMutex;
+static std::atomic<size_t>			sWeakRefObjectCount( 0 );
+
+#if Q3_DEBUG
+// Guards the list of live objects used for leak checking
+static std::recursive_mutex			sLeakListMutex;
+#endif
+
 
 //=============================================================================
 //      Internal functions
@@ -235,8 +240,8 @@ e3shared_new ( TQ3Object inObject, void *privateData, const void *paramData )
 
 
 	// Initialise our instance data
-	theObject->sharedData.refCount  = 1 ;
-	theObject->sharedData.editIndex = 1 ;
+	theObject->sharedData.refCount.store ( 1, std::memory_order_relaxed ) ;
+	theObject->sharedData.editIndex.store ( 1, std::memory_order_relaxed ) ;
 
 #if Q3_DEBUG
 	theObject->sharedData.logRefs = kQ3False;
@@ -262,22 +267,32 @@ E3Shared_Dispose ( TQ3Object inObject )
 
 
 	// Decrement the reference count
+	//
+	// The release half of the exchange publishes our writes to the object
+	// before another thread can see the count fall, and the acquire half
+	// makes every other thread's writes visible to whoever destroys it.
 	E3Shared* theObject = (E3Shared*) inObject;
-	Q3_ASSERT(theObject->sharedData.refCount >= 1);
-	theObject->sharedData.refCount--;
+	TQ3Uns32 oldCount = theObject->sharedData.refCount.fetch_sub( 1, std::memory_order_acq_rel );
+	Q3_ASSERT(oldCount >= 1);
+	TQ3Uns32 newCount = oldCount - 1;
 
 #if Q3_DEBUG
 	if (theObject->IsLoggingRefs())
 	{
 		Q3_MESSAGE_FMT("Ref count of %p reduced to %d", theObject,
-			(int) theObject->sharedData.refCount );
+			(int) newCount );
 	}
 #endif
 
 
 	// If the reference count falls to 0, dispose of the object
-	if ( theObject->sharedData.refCount == 0 )
+	if ( newCount == 0 )
+		{
+		if ( theObject->sharedData.boundsFlags.load( std::memory_order_relaxed ) != 0 )
+			E3GroupBounds_Forget( theObject ) ;
+
 		theObject->DestroyInstance () ;
+		}
 	}
 
 
@@ -292,22 +307,23 @@ void E3Shared_AddReference( E3Shared* theObject )
 	if ( theObject == nullptr )
 		return ;
 
-	theObject->sharedData.refCount++;
+	// The caller already holds a reference, so nothing needs ordering here
+	TQ3Uns32 newCount = theObject->sharedData.refCount.fetch_add( 1, std::memory_order_relaxed ) + 1;
 #if Q3_DEBUG
-	if (theObject->sharedData.refCount < 2)
+	if (newCount < 2)
 	{
 		Q3_MESSAGE_FMT("E3Shared::GetReference has refCount %d.",
-			(int)theObject->sharedData.refCount );
+			(int)newCount );
 		Q3_MESSAGE_FMT("Class of messed up object was %s.",
 			theObject->GetClass()->GetName() );
 	}
 #endif
-	Q3_ASSERT(theObject->sharedData.refCount >= 2);
+	Q3_ASSERT(newCount >= 2);
 #if Q3_DEBUG
 	if (theObject->IsLoggingRefs())
 	{
 		Q3_MESSAGE_FMT("Ref count of %p increased to %d", theObject,
-			(int) theObject->sharedData.refCount );
+			(int) newCount );
 	}
 #endif
 }
@@ -337,8 +353,11 @@ e3shared_duplicate(TQ3Object fromObject,     const void *fromPrivateData,
 
 
 	// Initialise the instance data of the new object
-	instanceData->sharedData.refCount  = 1;
-	instanceData->sharedData.editIndex = E3Integer_Abs( fromInstanceData->sharedData.editIndex );
+	TQ3Int32 fromEditIndex = fromInstanceData->sharedData.editIndex.load( std::memory_order_relaxed );
+	
+	instanceData->sharedData.refCount.store( 1, std::memory_order_relaxed );
+	instanceData->sharedData.editIndex.store( E3Integer_Abs( fromEditIndex ), std::memory_order_relaxed );
+	instanceData->sharedData.boundsFlags.store( 0, std::memory_order_relaxed );
 
 #if Q3_DEBUG
 	instanceData->sharedData.logRefs = kQ3False;
@@ -557,6 +576,7 @@ e3root_new( TQ3Object theObject, void *privateData, const void *paramData )
 #if Q3_DEBUG
 	E3GlobalsPtr	theGlobals = E3Globals_Get();
 	static TQ3Boolean	sIsMakingListHead = kQ3False;
+	std::lock_guard<std::recursive_mutex> listLock( sLeakListMutex );
 	
 	if (sIsMakingListHead == kQ3True)
 	{
@@ -602,11 +622,7 @@ e3root_new( TQ3Object theObject, void *privateData, const void *paramData )
 	theObject->propertyTable = nullptr;
 	
 	// Update the global object count.
-#if QUESA_OS_MACINTOSH
-	OSAtomicIncrement32( &gObjectCount );
-#elif QUESA_OS_WIN32
-	InterlockedIncrement( &gObjectCount );
-#endif
+	gObjectCount.fetch_add( 1, std::memory_order_relaxed );
 	
 	return kQ3Success;
 }
@@ -683,14 +699,11 @@ e3root_delete( TQ3Object theObject, void *privateData )
 
 	
 	// Update the global object count.
-#if QUESA_OS_MACINTOSH
-	OSAtomicDecrement32( &gObjectCount );
-#elif QUESA_OS_WIN32
-	InterlockedDecrement( &gObjectCount );
-#endif
+	gObjectCount.fetch_sub( 1, std::memory_order_relaxed );
 
 
 #if Q3_DEBUG
+	std::unique_lock<std::recursive_mutex> listLock( sLeakListMutex );
 	if ( instanceData->prev != nullptr )
 	{
 		NEXTLINK( instanceData->prev ) = instanceData->next;
@@ -702,6 +715,7 @@ e3root_delete( TQ3Object theObject, void *privateData )
 
 	instanceData->prev = nullptr;
 	instanceData->next = nullptr;
+	listLock.unlock();
 	
 	E3StackCrawl_Dispose( instanceData->stackCrawl );
 #endif
@@ -980,6 +994,11 @@ E3Exit(void)
 
 
 
+		// Stop the worker threads
+		E3Parallel_Terminate();
+
+
+
 		// Terminate Quesa
 		E3CustomElements_UnregisterClass();
 		E3Pick_UnregisterClass();
@@ -1093,6 +1112,42 @@ E3GetReleaseVersion(TQ3Uns32 *releaseRevision)
 
 
 
+//=============================================================================
+//      E3SetThreadCount : Set the number of threads Quesa may use.
+//-----------------------------------------------------------------------------
+TQ3Status
+E3SetThreadCount(TQ3Uns32 threadCount)
+{
+
+
+	// Set the thread count
+	E3Parallel_SetThreadCount(threadCount);
+
+	return(kQ3Success);
+}
+
+
+
+
+
+//=============================================================================
+//      E3GetThreadCount : Get the number of threads Quesa may use.
+//-----------------------------------------------------------------------------
+TQ3Status
+E3GetThreadCount(TQ3Uns32 *threadCount)
+{
+
+
+	// Return the thread count
+	*threadCount = E3Parallel_GetThreadCount();
+
+	return(kQ3Success);
+}
+
+
+
+
+
 //=============================================================================
 //      E3ObjectHierarchy_GetTypeFromString : Find the type for a class.
 //-----------------------------------------------------------------------------
@@ -1313,6 +1368,8 @@ E3Object_CleanDispose(TQ3Object *theObject)
 //-----------------------------------------------------------------------------
 void	E3Object_GetWeakReference( TQ3Object* theRefAddress )
 {
+	std::lock_guard<std::mutex> weakRefLock( sWeakRefMutex );
+
 	if (sObToWeakRefs == nullptr)
 	{
 		sObToWeakRefs = new ObToWeakRefs;
@@ -1320,6 +1377,7 @@ void	E3Object_GetWeakReference( TQ3Object* theRefAddress )
 	
 	//Q3_MESSAGE_FMT("+ weak ref %p -> %p", theRefAddress, *theRefAddress );
 	(*sObToWeakRefs)[ *theRefAddress ].insert( theRefAddress );
+	sWeakRefObjectCount.store( sObToWeakRefs->size(), std::memory_order_release );
 }
 
 
@@ -1331,10 +1389,21 @@ void	E3Object_GetWeakReference( TQ3Object* theRefAddress )
 //-----------------------------------------------------------------------------
 void	E3Object_ReleaseWeakReference( TQ3Object* theRefAddress )
 {
+	std::lock_guard<std::mutex> weakRefLock( sWeakRefMutex );
+
 	if (sObToWeakRefs != nullptr)
 	{
 		//Q3_MESSAGE_FMT("- weak ref %p -> %p", theRefAddress, *theRefAddress );
-		(*sObToWeakRefs)[ *theRefAddress ].erase( theRefAddress );
+		ObToWeakRefs::iterator found = sObToWeakRefs->find( *theRefAddress );
+		if (found != sObToWeakRefs->end())
+		{
+			found->second.erase( theRefAddress );
+			if (found->second.empty())
+			{
+				sObToWeakRefs->erase( found );
+			}
+		}
+		sWeakRefObjectCount.store( sObToWeakRefs->size(), std::memory_order_release );
 	}
 }
 
@@ -1349,6 +1418,20 @@ void	E3Object_ReleaseWeakReference( TQ3Object* theRefAddress )
 //-----------------------------------------------------------------------------
 void	E3Object_ZeroWeakReferences( TQ3Object deletedObject )
 {
+	// Skip the lock when no object has weak references. Making a weak
+	// reference to this object needs a live reference to it, so every such
+	// call happened before the final dispose that brought us here (through
+	// the acq_rel decrement of the reference count). Its release store of
+	// the count is then seen by this acquire load, and a count of zero means
+	// this object has no entry. Entries for other objects may change
+	// concurrently, but only under the lock.
+	if (sWeakRefObjectCount.load( std::memory_order_acquire ) == 0)
+	{
+		return;
+	}
+	
+	std::lock_guard<std::mutex> weakRefLock( sWeakRefMutex );
+
 	if (sObToWeakRefs != nullptr)
 	{
 		ObToWeakRefs::iterator found = sObToWeakRefs->find( deletedObject );
@@ -1365,6 +1448,7 @@ void	E3Object_ZeroWeakReferences( TQ3Object deletedObject )
 				*theRefAddr = nullptr;
 			}
 			sObToWeakRefs->erase( found );
+			sWeakRefObjectCount.store( sObToWeakRefs->size(), std::memory_order_release );
 			//Q3_MESSAGE_FMT("----");
 		}
 	}
@@ -1374,6 +1458,20 @@ void	E3Object_ZeroWeakReferences( TQ3Object deletedObject )
 
 
 
+//=============================================================================
+//      E3Object_GetLeakListMutex : Get the lock for the leak checking list.
+//-----------------------------------------------------------------------------
+#if Q3_DEBUG
+std::recursive_mutex&	E3Object_GetLeakListMutex( void )
+{
+	return sLeakListMutex;
+}
+#endif
+
+
+
+
+
 //=============================================================================
 //      E3Object_Duplicate : Duplicate an object.
 //-----------------------------------------------------------------------------
@@ -1994,7 +2092,7 @@ TQ3Boolean
 E3Shared::IsReferenced ( void )
 	{
 	// Return as the reference count is greater than 1
-	return ( (TQ3Boolean) ( sharedData.refCount > 1 ) ) ;
+	return ( (TQ3Boolean) ( sharedData.refCount.load( std::memory_order_relaxed ) > 1 ) ) ;
 	}
 
 
@@ -2008,7 +2106,7 @@ TQ3Uns32
 E3Shared::GetReferenceCount ( void )
 	{
 	// Return the reference count
-	return sharedData.refCount ;
+	return sharedData.refCount.load( std::memory_order_relaxed ) ;
 	}
 
 
@@ -2022,7 +2120,7 @@ TQ3Uns32
 E3Shared::GetEditIndex ( void )
 	{
 	// Return the edit index
-	return E3Integer_Abs( sharedData.editIndex );
+	return E3Integer_Abs( sharedData.editIndex.load( std::memory_order_relaxed ) );
 	}
 
 
@@ -2035,7 +2133,10 @@ E3Shared::GetEditIndex ( void )
 void
 E3Shared::SetEditIndex( TQ3Uns32 inIndex )
 {
-	sharedData.editIndex = inIndex;
+	sharedData.editIndex.store( (TQ3Int32) inIndex, std::memory_order_relaxed );
+	
+	if ( sharedData.boundsFlags.load( std::memory_order_relaxed ) != 0 )
+		E3GroupBounds_Invalidate( this );
 }
 
 
@@ -2058,10 +2159,20 @@ void		E3Shared::SetLoggingRefs( TQ3Boolean inLog )
 TQ3Status
 E3Shared::Edited ( void )
 {
-	if (sharedData.editIndex >= 0)
-	{
-		// Increment the edit index
-		++sharedData.editIndex ;
+	// Increment the edit index unless it is locked. The lock can be set by
+	// another thread between our test and our increment, so the two must
+	// happen as one step.
+	TQ3Int32 oldIndex = sharedData.editIndex.load( std::memory_order_relaxed );
+	while (oldIndex >= 0)
+	{
+		if (sharedData.editIndex.compare_exchange_weak( oldIndex, oldIndex + 1,
+			std::memory_order_relaxed ))
+		{
+			// Let any group bounds which depend on us know they are stale
+			if ( sharedData.boundsFlags.load( std::memory_order_relaxed ) != 0 )
+				E3GroupBounds_Invalidate( this );
+			break;
+		}
 	}
 	
 	return kQ3Success ;
@@ -2077,14 +2188,22 @@ E3Shared::Edited ( void )
 void
 E3Shared::SetEditIndexLocked( TQ3Boolean inIsLocked )
 {
-	if (inIsLocked)
-	{
-		sharedData.editIndex = - E3Integer_Abs( sharedData.editIndex );
-	}
-	else	// unlock
+	TQ3Int32 oldIndex = sharedData.editIndex.load( std::memory_order_relaxed );
+	TQ3Int32 newIndex;
+	
+	do
 	{
-		sharedData.editIndex = E3Integer_Abs( sharedData.editIndex );
+		if (inIsLocked)
+		{
+			newIndex = - E3Integer_Abs( oldIndex );
+		}
+		else	// unlock
+		{
+			newIndex = E3Integer_Abs( oldIndex );
+		}
 	}
+	while (! sharedData.editIndex.compare_exchange_weak( oldIndex, newIndex,
+		std::memory_order_relaxed ));
 }
 
 
@@ -2097,7 +2216,7 @@ E3Shared::SetEditIndexLocked( TQ3Boolean inIsLocked )
 TQ3Boolean
 E3Shared::IsEditIndexLocked() const
 {
-	return (sharedData.editIndex < 0) ? kQ3True : kQ3False;
+	return (sharedData.editIndex.load( std::memory_order_relaxed ) < 0) ? kQ3True : kQ3False;
 }
 
 
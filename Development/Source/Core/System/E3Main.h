@@ -48,6 +48,8 @@
 // Include files go here
 
 #include <new>
+#include <atomic>
+#include <mutex>
 
 
 #include "E3Memory.h"
@@ -304,10 +306,16 @@ public :
 
 
 
+// The reference count and edit index may be touched from several threads
+// at once, so both are atomic. Shared objects are allocated with zeroed
+// memory rather than constructed, which is a valid initial state for all
+// three. The bounds flags are set by E3GroupBounds, for objects which
+// cached group bounds depend on.
 struct E3SharedData
 {
-	TQ3Uns32		refCount;
-	TQ3Int32		editIndex;	// normally positive, negative means "locked"
+	std::atomic<TQ3Uns32>	refCount;
+	std::atomic<TQ3Int32>	editIndex;	// normally positive, negative means "locked"
+	std::atomic<TQ3Uns32>	boundsFlags;
 #if Q3_DEBUG
 	TQ3Boolean		logRefs;
 #endif
@@ -388,6 +396,8 @@ TQ3Status			E3Exit(void);
 TQ3Boolean			E3IsInitialized(void);
 TQ3Status			E3GetVersion(TQ3Uns32 *majorRevision, TQ3Uns32 *minorRevision);
 TQ3Status			E3GetReleaseVersion(TQ3Uns32 *releaseRevision);
+TQ3Status			E3SetThreadCount(TQ3Uns32 threadCount);
+TQ3Status			E3GetThreadCount(TQ3Uns32 *threadCount);
 
 TQ3Status			E3ObjectHierarchy_GetTypeFromString(const TQ3ObjectClassNameString objectClassString, TQ3ObjectType *objectClassType);
 TQ3Status			E3ObjectHierarchy_GetStringFromType(TQ3ObjectType objectClassType, TQ3ObjectClassNameString objectClassString);
@@ -437,5 +447,17 @@ TQ3Status			E3Bitmap_SetBit(TQ3Bitmap *theBitmap, TQ3Uns32 x, TQ3Uns32 y, TQ3Boo
 }
 #endif
 
+
+
+
+
+//=============================================================================
+//      C++ function prototypes
+//-----------------------------------------------------------------------------
+// Guards the list of live objects recorded for leak checking
+#if Q3_DEBUG
+std::recursive_mutex&	E3Object_GetLeakListMutex( void );
+#endif
+
 #endif
 
@@ -52,6 +52,37 @@
 #include <limits>
 #include <cstring>
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	#include <emmintrin.h>
+	#define QUESA_MATH_SSE2		1
+	#define QUESA_MATH_SIMD		1
+#elif (defined(__ARM_NEON) || defined(__ARM_NEON__)) && (defined(__aarch64__) || defined(_M_ARM64))
+	#include <arm_neon.h>
+	#define QUESA_MATH_NEON		1
+	#define QUESA_MATH_SIMD		1
+#endif
+
+// GCC and clang can compile AVX2 kernels alongside the SSE2 ones, to be
+// chosen at run time
+#if QUESA_MATH_SSE2 && defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+	#include <immintrin.h>
+	#define QUESA_MATH_AVX2		1
+	#define E3_TARGET_AVX2		__attribute__((target("avx2")))
+#endif
+
+// The SIMD kernels round each multiply and add separately, so the compiler
+// must not fuse those of the scalar code into multiply-adds, or the two paths
+// would give different results on targets with FMA instructions.
+#if QUESA_MATH_SIMD
+	#if defined(__clang__)
+		#pragma STDC FP_CONTRACT OFF
+	#elif defined(__GNUC__)
+		#pragma GCC optimize ("fp-contract=off")
+	#elif defined(_MSC_VER)
+		#pragma fp_contract (off)
+	#endif
+#endif
+
 
 
 //=============================================================================
@@ -655,6 +686,684 @@ e3bounding_box_accumulate_point3D(TQ3BoundingBox *bBox, const TQ3Point3D *point3
 
 
 
+//=============================================================================
+//		e3bounding_box_positive_zeros :	Replace any -0 in a bounding box by 0.
+//-----------------------------------------------------------------------------
+//		Note :	Which of several equal zeros ends up in the box depends on the
+//				order the points were compared in, which differs between the
+//				scalar and SIMD code, so the result is made the same for both.
+//				Strided arrays, which only use the scalar code, also get
+//				positive zeros where they used to keep whichever came first.
+//-----------------------------------------------------------------------------
+static inline void
+e3bounding_box_positive_zeros(TQ3BoundingBox *bBox)
+{
+	bBox->min.x += 0.0f;
+	bBox->min.y += 0.0f;
+	bBox->min.z += 0.0f;
+	bBox->max.x += 0.0f;
+	bBox->max.y += 0.0f;
+	bBox->max.z += 0.0f;
+}
+
+
+
+
+
+//=============================================================================
+//		SIMD kernels
+//-----------------------------------------------------------------------------
+//		The array transforms and bounding box construction work on 4 packed
+//		points at a time where SSE2 (always present on x86-64) or AArch64 NEON
+//		is available.  The points are deinterleaved into x, y and z vectors,
+//		and each output is computed in the same order of operations as the
+//		scalar code, so that both paths give the same results.  Where the CPU
+//		has AVX2, 8 points are handled at a time, in the same way.
+//
+//		Strided arrays, and the points left over at the end of a packed array,
+//		use the scalar code.
+//-----------------------------------------------------------------------------
+
+#if QUESA_MATH_SSE2
+typedef __m128		E3Float4;
+
+static inline E3Float4	e3float4_splat( float inValue )				{ return _mm_set1_ps( inValue ); }
+static inline E3Float4	e3float4_add( E3Float4 a, E3Float4 b )		{ return _mm_add_ps( a, b ); }
+static inline E3Float4	e3float4_mul( E3Float4 a, E3Float4 b )		{ return _mm_mul_ps( a, b ); }
+static inline E3Float4	e3float4_div( E3Float4 a, E3Float4 b )		{ return _mm_div_ps( a, b ); }
+
+// Minimum and maximum ignore a NaN in the first operand
+static inline E3Float4	e3float4_min( E3Float4 a, E3Float4 b )		{ return _mm_min_ps( a, b ); }
+static inline E3Float4	e3float4_max( E3Float4 a, E3Float4 b )		{ return _mm_max_ps( a, b ); }
+
+static inline float
+e3float4_hmin( E3Float4 a )
+{
+	a = _mm_min_ps( a, _mm_movehl_ps( a, a ) );
+	a = _mm_min_ss( a, _mm_shuffle_ps( a, a, _MM_SHUFFLE( 1, 1, 1, 1 ) ) );
+	return _mm_cvtss_f32( a );
+}
+
+static inline float
+e3float4_hmax( E3Float4 a )
+{
+	a = _mm_max_ps( a, _mm_movehl_ps( a, a ) );
+	a = _mm_max_ss( a, _mm_shuffle_ps( a, a, _MM_SHUFFLE( 1, 1, 1, 1 ) ) );
+	return _mm_cvtss_f32( a );
+}
+
+// Replace zeros by ones, returning true if there were any
+static inline bool
+e3float4_fix_zeros( E3Float4& ioValue )
+{
+	E3Float4	isZero = _mm_cmpeq_ps( ioValue, _mm_setzero_ps() );
+	
+	ioValue = _mm_or_ps( _mm_andnot_ps( isZero, ioValue ),
+						 _mm_and_ps( isZero, _mm_set1_ps( 1.0f ) ) );
+	
+	return _mm_movemask_ps( isZero ) != 0;
+}
+
+// Load 4 packed xyz triples, as x, y and z vectors
+static inline void
+e3float4_load3( const float* inData, E3Float4& outX, E3Float4& outY, E3Float4& outZ )
+{
+	E3Float4	a = _mm_loadu_ps( inData );			// x0 y0 z0 x1
+	E3Float4	b = _mm_loadu_ps( inData + 4 );		// y1 z1 x2 y2
+	E3Float4	c = _mm_loadu_ps( inData + 8 );		// z2 x3 y3 z3
+	E3Float4	z0x1y1z1 = _mm_shuffle_ps( a, b, _MM_SHUFFLE( 1, 0, 3, 2 ) );
+	E3Float4	x2y2z2x3 = _mm_shuffle_ps( b, c, _MM_SHUFFLE( 1, 0, 3, 2 ) );
+	E3Float4	x0y0x1y1 = _mm_shuffle_ps( a, z0x1y1z1, _MM_SHUFFLE( 2, 1, 1, 0 ) );
+	E3Float4	x2y2x3y3 = _mm_shuffle_ps( x2y2z2x3, c, _MM_SHUFFLE( 2, 1, 1, 0 ) );
+	
+	outX = _mm_shuffle_ps( x0y0x1y1, x2y2x3y3, _MM_SHUFFLE( 2, 0, 2, 0 ) );
+	outY = _mm_shuffle_ps( x0y0x1y1, x2y2x3y3, _MM_SHUFFLE( 3, 1, 3, 1 ) );
+	outZ = _mm_shuffle_ps( z0x1y1z1, c, _MM_SHUFFLE( 3, 0, 3, 0 ) );
+}
+
+// Store x, y and z vectors as 4 packed xyz triples
+static inline void
+e3float4_store3( float* outData, E3Float4 inX, E3Float4 inY, E3Float4 inZ )
+{
+	E3Float4	x0y0x1y1 = _mm_unpacklo_ps( inX, inY );
+	E3Float4	x2y2x3y3 = _mm_unpackhi_ps( inX, inY );
+	E3Float4	z0z0x1x1 = _mm_shuffle_ps( inZ, x0y0x1y1, _MM_SHUFFLE( 2, 2, 0, 0 ) );
+	E3Float4	y1y1z1z1 = _mm_shuffle_ps( x0y0x1y1, inZ, _MM_SHUFFLE( 1, 1, 3, 3 ) );
+	E3Float4	z2z2x3x3 = _mm_shuffle_ps( inZ, x2y2x3y3, _MM_SHUFFLE( 2, 2, 2, 2 ) );
+	E3Float4	y3y3z3z3 = _mm_shuffle_ps( x2y2x3y3, inZ, _MM_SHUFFLE( 3, 3, 3, 3 ) );
+	
+	_mm_storeu_ps( outData,     _mm_shuffle_ps( x0y0x1y1, z0z0x1x1, _MM_SHUFFLE( 2, 0, 1, 0 ) ) );
+	_mm_storeu_ps( outData + 4, _mm_shuffle_ps( y1y1z1z1, x2y2x3y3, _MM_SHUFFLE( 1, 0, 2, 0 ) ) );
+	_mm_storeu_ps( outData + 8, _mm_shuffle_ps( z2z2x3x3, y3y3z3z3, _MM_SHUFFLE( 2, 0, 2, 0 ) ) );
+}
+
+// Store x, y, z and w vectors as 4 packed xyzw quadruples
+static inline void
+e3float4_store4( float* outData, E3Float4 inX, E3Float4 inY, E3Float4 inZ, E3Float4 inW )
+{
+	_MM_TRANSPOSE4_PS( inX, inY, inZ, inW );
+	
+	_mm_storeu_ps( outData,      inX );
+	_mm_storeu_ps( outData + 4,  inY );
+	_mm_storeu_ps( outData + 8,  inZ );
+	_mm_storeu_ps( outData + 12, inW );
+}
+
+#if QUESA_MATH_AVX2
+typedef __m256		E3Float8;
+
+static inline E3_TARGET_AVX2 E3Float8	e3float8_splat( float inValue )				{ return _mm256_set1_ps( inValue ); }
+static inline E3_TARGET_AVX2 E3Float8	e3float8_add( E3Float8 a, E3Float8 b )		{ return _mm256_add_ps( a, b ); }
+static inline E3_TARGET_AVX2 E3Float8	e3float8_mul( E3Float8 a, E3Float8 b )		{ return _mm256_mul_ps( a, b ); }
+static inline E3_TARGET_AVX2 E3Float8	e3float8_div( E3Float8 a, E3Float8 b )		{ return _mm256_div_ps( a, b ); }
+static inline E3_TARGET_AVX2 E3Float8	e3float8_min( E3Float8 a, E3Float8 b )		{ return _mm256_min_ps( a, b ); }
+static inline E3_TARGET_AVX2 E3Float8	e3float8_max( E3Float8 a, E3Float8 b )		{ return _mm256_max_ps( a, b ); }
+
+static inline E3_TARGET_AVX2 E3Float4	e3float8_low( E3Float8 a )					{ return _mm256_castps256_ps128( a ); }
+static inline E3_TARGET_AVX2 E3Float4	e3float8_high( E3Float8 a )					{ return _mm256_extractf128_ps( a, 1 ); }
+
+static inline E3_TARGET_AVX2 E3Float8
+e3float8_combine( E3Float4 inLow, E3Float4 inHigh )
+{
+	return _mm256_insertf128_ps( _mm256_castps128_ps256( inLow ), inHigh, 1 );
+}
+
+// Replace zeros by ones, returning true if there were any
+static inline E3_TARGET_AVX2 bool
+e3float8_fix_zeros( E3Float8& ioValue )
+{
+	E3Float8	isZero = _mm256_cmp_ps( ioValue, _mm256_setzero_ps(), _CMP_EQ_OQ );
+	
+	ioValue = _mm256_blendv_ps( ioValue, _mm256_set1_ps( 1.0f ), isZero );
+	
+	return _mm256_movemask_ps( isZero ) != 0;
+}
+
+// Load 8 packed xyz triples, as x, y and z vectors
+static inline E3_TARGET_AVX2 void
+e3float8_load3( const float* inData, E3Float8& outX, E3Float8& outY, E3Float8& outZ )
+{
+	E3Float4	x0, y0, z0, x1, y1, z1;
+	
+	e3float4_load3( inData,      x0, y0, z0 );
+	e3float4_load3( inData + 12, x1, y1, z1 );
+	
+	outX = e3float8_combine( x0, x1 );
+	outY = e3float8_combine( y0, y1 );
+	outZ = e3float8_combine( z0, z1 );
+}
+
+// Store x, y and z vectors as 8 packed xyz triples
+static inline E3_TARGET_AVX2 void
+e3float8_store3( float* outData, E3Float8 inX, E3Float8 inY, E3Float8 inZ )
+{
+	e3float4_store3( outData,      e3float8_low( inX ),  e3float8_low( inY ),  e3float8_low( inZ ) );
+	e3float4_store3( outData + 12, e3float8_high( inX ), e3float8_high( inY ), e3float8_high( inZ ) );
+}
+
+// Store x, y, z and w vectors as 8 packed xyzw quadruples
+static inline E3_TARGET_AVX2 void
+e3float8_store4( float* outData, E3Float8 inX, E3Float8 inY, E3Float8 inZ, E3Float8 inW )
+{
+	e3float4_store4( outData,      e3float8_low( inX ),  e3float8_low( inY ),
+								   e3float8_low( inZ ),  e3float8_low( inW ) );
+	e3float4_store4( outData + 16, e3float8_high( inX ), e3float8_high( inY ),
+								   e3float8_high( inZ ), e3float8_high( inW ) );
+}
+
+// Does the CPU, and the OS, support AVX2?
+static inline bool
+e3math_has_avx2()
+{
+	static const bool sHasAVX2 = __builtin_cpu_supports( "avx2" );
+	
+	return sHasAVX2;
+}
+#endif // QUESA_MATH_AVX2
+
+#elif QUESA_MATH_NEON
+typedef float32x4_t	E3Float4;
+
+static inline E3Float4	e3float4_splat( float inValue )				{ return vdupq_n_f32( inValue ); }
+static inline E3Float4	e3float4_add( E3Float4 a, E3Float4 b )		{ return vaddq_f32( a, b ); }
+static inline E3Float4	e3float4_mul( E3Float4 a, E3Float4 b )		{ return vmulq_f32( a, b ); }
+static inline E3Float4	e3float4_div( E3Float4 a, E3Float4 b )		{ return vdivq_f32( a, b ); }
+
+// Minimum and maximum ignore a NaN in either operand
+static inline E3Float4	e3float4_min( E3Float4 a, E3Float4 b )		{ return vminnmq_f32( a, b ); }
+static inline E3Float4	e3float4_max( E3Float4 a, E3Float4 b )		{ return vmaxnmq_f32( a, b ); }
+
+static inline float		e3float4_hmin( E3Float4 a )					{ return vminnmvq_f32( a ); }
+static inline float		e3float4_hmax( E3Float4 a )					{ return vmaxnmvq_f32( a ); }
+
+// Replace zeros by ones, returning true if there were any
+static inline bool
+e3float4_fix_zeros( E3Float4& ioValue )
+{
+	uint32x4_t	isZero = vceqq_f32( ioValue, vdupq_n_f32( 0.0f ) );
+	
+	ioValue = vbslq_f32( isZero, vdupq_n_f32( 1.0f ), ioValue );
+	
+	return vmaxvq_u32( isZero ) != 0;
+}
+
+// Load 4 packed xyz triples, as x, y and z vectors
+static inline void
+e3float4_load3( const float* inData, E3Float4& outX, E3Float4& outY, E3Float4& outZ )
+{
+	float32x4x3_t	theData = vld3q_f32( inData );
+	
+	outX = theData.val[0];
+	outY = theData.val[1];
+	outZ = theData.val[2];
+}
+
+// Store x, y and z vectors as 4 packed xyz triples
+static inline void
+e3float4_store3( float* outData, E3Float4 inX, E3Float4 inY, E3Float4 inZ )
+{
+	float32x4x3_t	theData = { { inX, inY, inZ } };
+	
+	vst3q_f32( outData, theData );
+}
+
+// Store x, y, z and w vectors as 4 packed xyzw quadruples
+static inline void
+e3float4_store4( float* outData, E3Float4 inX, E3Float4 inY, E3Float4 inZ, E3Float4 inW )
+{
+	float32x4x4_t	theData = { { inX, inY, inZ, inW } };
+	
+	vst4q_f32( outData, theData );
+}
+#endif
+
+
+
+
+
+#if QUESA_MATH_AVX2
+//=============================================================================
+//		e3point3d_transform_avx2 : Transform packed 3D points, 8 at a time.
+//-----------------------------------------------------------------------------
+//		Note :	Returns the number of points transformed, a multiple of 8.
+//-----------------------------------------------------------------------------
+static E3_TARGET_AVX2 TQ3Uns32
+e3point3d_transform_avx2(const TQ3Point3D *inPoints3D, const TQ3Matrix4x4 *matrix4x4,
+	TQ3Point3D *outPoints3D, TQ3Uns32 numPoints, bool isAffine, bool& ioHadZeroW)
+{
+	const float*	src = reinterpret_cast<const float*>( inPoints3D );
+	float*			dst = reinterpret_cast<float*>( outPoints3D );
+	TQ3Uns32		n;
+	
+	#define M(x,y) e3float8_splat( matrix4x4->value[x][y] )
+	const E3Float8	m00 = M(0,0), m01 = M(0,1), m02 = M(0,2), m03 = M(0,3);
+	const E3Float8	m10 = M(1,0), m11 = M(1,1), m12 = M(1,2), m13 = M(1,3);
+	const E3Float8	m20 = M(2,0), m21 = M(2,1), m22 = M(2,2), m23 = M(2,3);
+	const E3Float8	m30 = M(3,0), m31 = M(3,1), m32 = M(3,2), m33 = M(3,3);
+	const E3Float8	one = e3float8_splat( 1.0f );
+	#undef M
+	
+	for (n = 0; n + 8 <= numPoints; n += 8, src += 24, dst += 24)
+	{
+		E3Float8	x, y, z;
+		e3float8_load3( src, x, y, z );
+		
+		E3Float8	rx = e3float8_add( e3float8_add( e3float8_add( e3float8_mul( x, m00 ),
+						e3float8_mul( y, m10 ) ), e3float8_mul( z, m20 ) ), m30 );
+		E3Float8	ry = e3float8_add( e3float8_add( e3float8_add( e3float8_mul( x, m01 ),
+						e3float8_mul( y, m11 ) ), e3float8_mul( z, m21 ) ), m31 );
+		E3Float8	rz = e3float8_add( e3float8_add( e3float8_add( e3float8_mul( x, m02 ),
+						e3float8_mul( y, m12 ) ), e3float8_mul( z, m22 ) ), m32 );
+		
+		if (! isAffine)
+		{
+			E3Float8	rw = e3float8_add( e3float8_add( e3float8_add( e3float8_mul( x, m03 ),
+							e3float8_mul( y, m13 ) ), e3float8_mul( z, m23 ) ), m33 );
+			
+			if (e3float8_fix_zeros( rw ))
+				ioHadZeroW = true;
+			
+			E3Float8	invw = e3float8_div( one, rw );
+			rx = e3float8_mul( rx, invw );
+			ry = e3float8_mul( ry, invw );
+			rz = e3float8_mul( rz, invw );
+		}
+		
+		e3float8_store3( dst, rx, ry, rz );
+	}
+	
+	return n;
+}
+
+
+
+
+
+//=============================================================================
+//		e3point3d_to4d_transform_avx2 : Transform packed 3D points into
+//										packed 4D rational points, 8 at a time.
+//-----------------------------------------------------------------------------
+//		Note :	Returns the number of points transformed, a multiple of 8.
+//-----------------------------------------------------------------------------
+static E3_TARGET_AVX2 TQ3Uns32
+e3point3d_to4d_transform_avx2(const TQ3Point3D *inPoints3D, const TQ3Matrix4x4 *matrix4x4,
+	TQ3RationalPoint4D *outRationalPoints4D, TQ3Uns32 numPoints)
+{
+	const float*	src = reinterpret_cast<const float*>( inPoints3D );
+	float*			dst = reinterpret_cast<float*>( outRationalPoints4D );
+	TQ3Uns32		n;
+	
+	#define M(x,y) e3float8_splat( matrix4x4->value[x][y] )
+	const E3Float8	m00 = M(0,0), m01 = M(0,1), m02 = M(0,2), m03 = M(0,3);
+	const E3Float8	m10 = M(1,0), m11 = M(1,1), m12 = M(1,2), m13 = M(1,3);
+	const E3Float8	m20 = M(2,0), m21 = M(2,1), m22 = M(2,2), m23 = M(2,3);
+	const E3Float8	m30 = M(3,0), m31 = M(3,1), m32 = M(3,2), m33 = M(3,3);
+	#undef M
+	
+	for (n = 0; n + 8 <= numPoints; n += 8, src += 24, dst += 32)
+	{
+		E3Float8	x, y, z;
+		e3float8_load3( src, x, y, z );
+		
+		e3float8_store4( dst,
+			e3float8_add( e3float8_add( e3float8_add( e3float8_mul( x, m00 ),
+				e3float8_mul( y, m10 ) ), e3float8_mul( z, m20 ) ), m30 ),
+			e3float8_add( e3float8_add( e3float8_add( e3float8_mul( x, m01 ),
+				e3float8_mul( y, m11 ) ), e3float8_mul( z, m21 ) ), m31 ),
+			e3float8_add( e3float8_add( e3float8_add( e3float8_mul( x, m02 ),
+				e3float8_mul( y, m12 ) ), e3float8_mul( z, m22 ) ), m32 ),
+			e3float8_add( e3float8_add( e3float8_add( e3float8_mul( x, m03 ),
+				e3float8_mul( y, m13 ) ), e3float8_mul( z, m23 ) ), m33 ) );
+	}
+	
+	return n;
+}
+
+
+
+
+
+//=============================================================================
+//		e3vector3d_transform_avx2 : Transform packed 3D vectors, 8 at a time.
+//-----------------------------------------------------------------------------
+//		Note :	Returns the number of vectors transformed, a multiple of 8.
+//-----------------------------------------------------------------------------
+static E3_TARGET_AVX2 TQ3Uns32
+e3vector3d_transform_avx2(const TQ3Vector3D *inVectors3D, const TQ3Matrix4x4 *matrix4x4,
+	TQ3Vector3D *outVectors3D, TQ3Uns32 numVectors)
+{
+	const float*	src = reinterpret_cast<const float*>( inVectors3D );
+	float*			dst = reinterpret_cast<float*>( outVectors3D );
+	TQ3Uns32		n;
+	
+	#define M(x,y) e3float8_splat( matrix4x4->value[x][y] )
+	const E3Float8	m00 = M(0,0), m01 = M(0,1), m02 = M(0,2);
+	const E3Float8	m10 = M(1,0), m11 = M(1,1), m12 = M(1,2);
+	const E3Float8	m20 = M(2,0), m21 = M(2,1), m22 = M(2,2);
+	#undef M
+	
+	for (n = 0; n + 8 <= numVectors; n += 8, src += 24, dst += 24)
+	{
+		E3Float8	x, y, z;
+		e3float8_load3( src, x, y, z );
+		
+		e3float8_store3( dst,
+			e3float8_add( e3float8_add( e3float8_mul( x, m00 ),
+				e3float8_mul( y, m10 ) ), e3float8_mul( z, m20 ) ),
+			e3float8_add( e3float8_add( e3float8_mul( x, m01 ),
+				e3float8_mul( y, m11 ) ), e3float8_mul( z, m21 ) ),
+			e3float8_add( e3float8_add( e3float8_mul( x, m02 ),
+				e3float8_mul( y, m12 ) ), e3float8_mul( z, m22 ) ) );
+	}
+	
+	return n;
+}
+
+
+
+
+
+//=============================================================================
+//		e3bounding_box_accumulate_avx2 : Accumulate packed 3D points into a
+//											nonempty bounding box, 8 at a time.
+//-----------------------------------------------------------------------------
+//		Note :	Returns the number of points accumulated, a multiple of 8.
+//-----------------------------------------------------------------------------
+static E3_TARGET_AVX2 TQ3Uns32
+e3bounding_box_accumulate_avx2(TQ3BoundingBox *bBox, const TQ3Point3D *points3D,
+	TQ3Uns32 numPoints)
+{
+	const float*	src = reinterpret_cast<const float*>( points3D );
+	E3Float8		minX = e3float8_splat( bBox->min.x );
+	E3Float8		minY = e3float8_splat( bBox->min.y );
+	E3Float8		minZ = e3float8_splat( bBox->min.z );
+	E3Float8		maxX = e3float8_splat( bBox->max.x );
+	E3Float8		maxY = e3float8_splat( bBox->max.y );
+	E3Float8		maxZ = e3float8_splat( bBox->max.z );
+	TQ3Uns32		n;
+	
+	for (n = 0; n + 8 <= numPoints; n += 8, src += 24)
+	{
+		E3Float8	x, y, z;
+		e3float8_load3( src, x, y, z );
+		
+		minX = e3float8_min( x, minX );
+		minY = e3float8_min( y, minY );
+		minZ = e3float8_min( z, minZ );
+		maxX = e3float8_max( x, maxX );
+		maxY = e3float8_max( y, maxY );
+		maxZ = e3float8_max( z, maxZ );
+	}
+	
+	bBox->min.x = e3float4_hmin( _mm_min_ps( e3float8_low( minX ), e3float8_high( minX ) ) );
+	bBox->min.y = e3float4_hmin( _mm_min_ps( e3float8_low( minY ), e3float8_high( minY ) ) );
+	bBox->min.z = e3float4_hmin( _mm_min_ps( e3float8_low( minZ ), e3float8_high( minZ ) ) );
+	bBox->max.x = e3float4_hmax( _mm_max_ps( e3float8_low( maxX ), e3float8_high( maxX ) ) );
+	bBox->max.y = e3float4_hmax( _mm_max_ps( e3float8_low( maxY ), e3float8_high( maxY ) ) );
+	bBox->max.z = e3float4_hmax( _mm_max_ps( e3float8_low( maxZ ), e3float8_high( maxZ ) ) );
+	
+	return n;
+}
+#endif // QUESA_MATH_AVX2
+
+
+
+
+
+#if QUESA_MATH_SIMD
+//=============================================================================
+//		e3point3d_transform_packed : Transform packed 3D points, 4 at a time.
+//-----------------------------------------------------------------------------
+//		Note :	Returns the number of points transformed, a multiple of 4.
+//				'outPoints3D' may be the same as 'inPoints3D'.
+//-----------------------------------------------------------------------------
+static TQ3Uns32
+e3point3d_transform_packed(const TQ3Point3D *inPoints3D, const TQ3Matrix4x4 *matrix4x4,
+	TQ3Point3D *outPoints3D, TQ3Uns32 numPoints, bool isAffine)
+{
+	const float*	src = reinterpret_cast<const float*>( inPoints3D );
+	float*			dst = reinterpret_cast<float*>( outPoints3D );
+	bool			hadZeroW = false;
+	TQ3Uns32		n;
+	
+	#define M(x,y) e3float4_splat( matrix4x4->value[x][y] )
+	const E3Float4	m00 = M(0,0), m01 = M(0,1), m02 = M(0,2), m03 = M(0,3);
+	const E3Float4	m10 = M(1,0), m11 = M(1,1), m12 = M(1,2), m13 = M(1,3);
+	const E3Float4	m20 = M(2,0), m21 = M(2,1), m22 = M(2,2), m23 = M(2,3);
+	const E3Float4	m30 = M(3,0), m31 = M(3,1), m32 = M(3,2), m33 = M(3,3);
+	const E3Float4	one = e3float4_splat( 1.0f );
+	#undef M
+	
+	n = 0;
+#if QUESA_MATH_AVX2
+	if (e3math_has_avx2())
+	{
+		n = e3point3d_transform_avx2( inPoints3D, matrix4x4, outPoints3D, numPoints,
+			isAffine, hadZeroW );
+		src += 3 * n;
+		dst += 3 * n;
+	}
+#endif
+	
+	for (; n + 4 <= numPoints; n += 4, src += 12, dst += 12)
+	{
+		E3Float4	x, y, z;
+		e3float4_load3( src, x, y, z );
+		
+		E3Float4	rx = e3float4_add( e3float4_add( e3float4_add( e3float4_mul( x, m00 ),
+						e3float4_mul( y, m10 ) ), e3float4_mul( z, m20 ) ), m30 );
+		E3Float4	ry = e3float4_add( e3float4_add( e3float4_add( e3float4_mul( x, m01 ),
+						e3float4_mul( y, m11 ) ), e3float4_mul( z, m21 ) ), m31 );
+		E3Float4	rz = e3float4_add( e3float4_add( e3float4_add( e3float4_mul( x, m02 ),
+						e3float4_mul( y, m12 ) ), e3float4_mul( z, m22 ) ), m32 );
+		
+		if (! isAffine)
+		{
+			// Scaling by 1/w is exact where w is 1, so unlike the scalar code
+			// we need not skip those points
+			E3Float4	rw = e3float4_add( e3float4_add( e3float4_add( e3float4_mul( x, m03 ),
+							e3float4_mul( y, m13 ) ), e3float4_mul( z, m23 ) ), m33 );
+			
+			if (e3float4_fix_zeros( rw ))
+				hadZeroW = true;
+			
+			E3Float4	invw = e3float4_div( one, rw );
+			rx = e3float4_mul( rx, invw );
+			ry = e3float4_mul( ry, invw );
+			rz = e3float4_mul( rz, invw );
+		}
+		
+		e3float4_store3( dst, rx, ry, rz );
+	}
+	
+	if (hadZeroW)
+		E3ErrorManager_PostError( kQ3ErrorInfiniteRationalPoint, kQ3False );
+	
+	return n;
+}
+
+
+
+
+
+//=============================================================================
+//		e3point3d_to4d_transform_packed : Transform packed 3D points into
+//											packed 4D rational points.
+//-----------------------------------------------------------------------------
+//		Note :	Returns the number of points transformed, a multiple of 4.
+//-----------------------------------------------------------------------------
+static TQ3Uns32
+e3point3d_to4d_transform_packed(const TQ3Point3D *inPoints3D, const TQ3Matrix4x4 *matrix4x4,
+	TQ3RationalPoint4D *outRationalPoints4D, TQ3Uns32 numPoints)
+{
+	const float*	src = reinterpret_cast<const float*>( inPoints3D );
+	float*			dst = reinterpret_cast<float*>( outRationalPoints4D );
+	TQ3Uns32		n;
+	
+	#define M(x,y) e3float4_splat( matrix4x4->value[x][y] )
+	const E3Float4	m00 = M(0,0), m01 = M(0,1), m02 = M(0,2), m03 = M(0,3);
+	const E3Float4	m10 = M(1,0), m11 = M(1,1), m12 = M(1,2), m13 = M(1,3);
+	const E3Float4	m20 = M(2,0), m21 = M(2,1), m22 = M(2,2), m23 = M(2,3);
+	const E3Float4	m30 = M(3,0), m31 = M(3,1), m32 = M(3,2), m33 = M(3,3);
+	#undef M
+	
+	n = 0;
+#if QUESA_MATH_AVX2
+	if (e3math_has_avx2())
+	{
+		n = e3point3d_to4d_transform_avx2( inPoints3D, matrix4x4, outRationalPoints4D, numPoints );
+		src += 3 * n;
+		dst += 4 * n;
+	}
+#endif
+	
+	for (; n + 4 <= numPoints; n += 4, src += 12, dst += 16)
+	{
+		E3Float4	x, y, z;
+		e3float4_load3( src, x, y, z );
+		
+		e3float4_store4( dst,
+			e3float4_add( e3float4_add( e3float4_add( e3float4_mul( x, m00 ),
+				e3float4_mul( y, m10 ) ), e3float4_mul( z, m20 ) ), m30 ),
+			e3float4_add( e3float4_add( e3float4_add( e3float4_mul( x, m01 ),
+				e3float4_mul( y, m11 ) ), e3float4_mul( z, m21 ) ), m31 ),
+			e3float4_add( e3float4_add( e3float4_add( e3float4_mul( x, m02 ),
+				e3float4_mul( y, m12 ) ), e3float4_mul( z, m22 ) ), m32 ),
+			e3float4_add( e3float4_add( e3float4_add( e3float4_mul( x, m03 ),
+				e3float4_mul( y, m13 ) ), e3float4_mul( z, m23 ) ), m33 ) );
+	}
+	
+	return n;
+}
+
+
+
+
+
+//=============================================================================
+//		e3vector3d_transform_packed : Transform packed 3D vectors, 4 at a time.
+//-----------------------------------------------------------------------------
+//		Note :	Returns the number of vectors transformed, a multiple of 4.
+//				'outVectors3D' may be the same as 'inVectors3D'.
+//-----------------------------------------------------------------------------
+static TQ3Uns32
+e3vector3d_transform_packed(const TQ3Vector3D *inVectors3D, const TQ3Matrix4x4 *matrix4x4,
+	TQ3Vector3D *outVectors3D, TQ3Uns32 numVectors)
+{
+	const float*	src = reinterpret_cast<const float*>( inVectors3D );
+	float*			dst = reinterpret_cast<float*>( outVectors3D );
+	TQ3Uns32		n;
+	
+	#define M(x,y) e3float4_splat( matrix4x4->value[x][y] )
+	const E3Float4	m00 = M(0,0), m01 = M(0,1), m02 = M(0,2);
+	const E3Float4	m10 = M(1,0), m11 = M(1,1), m12 = M(1,2);
+	const E3Float4	m20 = M(2,0), m21 = M(2,1), m22 = M(2,2);
+	#undef M
+	
+	n = 0;
+#if QUESA_MATH_AVX2
+	if (e3math_has_avx2())
+	{
+		n = e3vector3d_transform_avx2( inVectors3D, matrix4x4, outVectors3D, numVectors );
+		src += 3 * n;
+		dst += 3 * n;
+	}
+#endif
+	
+	for (; n + 4 <= numVectors; n += 4, src += 12, dst += 12)
+	{
+		E3Float4	x, y, z;
+		e3float4_load3( src, x, y, z );
+		
+		e3float4_store3( dst,
+			e3float4_add( e3float4_add( e3float4_mul( x, m00 ),
+				e3float4_mul( y, m10 ) ), e3float4_mul( z, m20 ) ),
+			e3float4_add( e3float4_add( e3float4_mul( x, m01 ),
+				e3float4_mul( y, m11 ) ), e3float4_mul( z, m21 ) ),
+			e3float4_add( e3float4_add( e3float4_mul( x, m02 ),
+				e3float4_mul( y, m12 ) ), e3float4_mul( z, m22 ) ) );
+	}
+	
+	return n;
+}
+
+
+
+
+
+//=============================================================================
+//		e3bounding_box_accumulate_packed : Accumulate packed 3D points into
+//											a nonempty bounding box.
+//-----------------------------------------------------------------------------
+//		Note :	Returns the number of points accumulated, a multiple of 4.
+//-----------------------------------------------------------------------------
+static TQ3Uns32
+e3bounding_box_accumulate_packed(TQ3BoundingBox *bBox, const TQ3Point3D *points3D,
+	TQ3Uns32 numPoints)
+{
+	TQ3Uns32		n = 0;
+	
+#if QUESA_MATH_AVX2
+	if (e3math_has_avx2())
+		n = e3bounding_box_accumulate_avx2( bBox, points3D, numPoints );
+#endif
+	
+	const float*	src = reinterpret_cast<const float*>( points3D + n );
+	E3Float4		minX = e3float4_splat( bBox->min.x );
+	E3Float4		minY = e3float4_splat( bBox->min.y );
+	E3Float4		minZ = e3float4_splat( bBox->min.z );
+	E3Float4		maxX = e3float4_splat( bBox->max.x );
+	E3Float4		maxY = e3float4_splat( bBox->max.y );
+	E3Float4		maxZ = e3float4_splat( bBox->max.z );
+	
+	for (; n + 4 <= numPoints; n += 4, src += 12)
+	{
+		E3Float4	x, y, z;
+		e3float4_load3( src, x, y, z );
+		
+		minX = e3float4_min( x, minX );
+		minY = e3float4_min( y, minY );
+		minZ = e3float4_min( z, minZ );
+		maxX = e3float4_max( x, maxX );
+		maxY = e3float4_max( y, maxY );
+		maxZ = e3float4_max( z, maxZ );
+	}
+	
+	bBox->min.x = e3float4_hmin( minX );
+	bBox->min.y = e3float4_hmin( minY );
+	bBox->min.z = e3float4_hmin( minZ );
+	bBox->max.x = e3float4_hmax( maxX );
+	bBox->max.y = e3float4_hmax( maxY );
+	bBox->max.z = e3float4_hmax( maxZ );
+	
+	return n;
+}
+#endif // QUESA_MATH_SIMD
+
+
+
+
+
 //=============================================================================
 //      Public functions
 //-----------------------------------------------------------------------------
@@ -2351,9 +3060,18 @@ E3Vector3D_To3DTransformArray(const TQ3Vector3D		*inVectors3D,
 							  TQ3Uns32				inStructSize,
 							  TQ3Uns32				outStructSize)
 {
-	TQ3Uns32 i;
+	TQ3Uns32 i = 0;
 	
-	for (i = 0; i < numVectors; ++i)
+#if QUESA_MATH_SIMD
+	if ( (inStructSize == sizeof(TQ3Vector3D)) && (outStructSize == sizeof(TQ3Vector3D)) )
+	{
+		i = e3vector3d_transform_packed( inVectors3D, matrix4x4, outVectors3D, numVectors );
+		inVectors3D  += i;
+		outVectors3D += i;
+	}
+#endif
+	
+	for (; i < numVectors; ++i)
 	{
 		E3Vector3D_Transform(inVectors3D, matrix4x4, outVectors3D);
 
@@ -2475,16 +3193,27 @@ E3Point3D_To3DTransformArray(const TQ3Point3D		*inPoints3D,
 							 TQ3Uns32				inStructSize,
 							 TQ3Uns32				outStructSize)
 {
-	TQ3Uns32 i;
+	TQ3Uns32 i = 0;
 	
 	// In the common case of the last column of the matrix being (0, 0, 0, 1),
 	// we can avoid some divisions and conditionals inside the loop.
-	if ( (matrix4x4->value[3][3] == 1.0f) &&
+	bool isAffine = (matrix4x4->value[3][3] == 1.0f) &&
 		(matrix4x4->value[0][3] == 0.0f) &&
 		(matrix4x4->value[1][3] == 0.0f) &&
-		(matrix4x4->value[2][3] == 0.0f) )
+		(matrix4x4->value[2][3] == 0.0f);
+	
+#if QUESA_MATH_SIMD
+	if ( (inStructSize == sizeof(TQ3Point3D)) && (outStructSize == sizeof(TQ3Point3D)) )
 	{
-		for (i = 0; i < numPoints; ++i)
+		i = e3point3d_transform_packed( inPoints3D, matrix4x4, outPoints3D, numPoints, isAffine );
+		inPoints3D  += i;
+		outPoints3D += i;
+	}
+#endif
+	
+	if (isAffine)
+	{
+		for (; i < numPoints; ++i)
 		{
 			E3Point3D_TransformAffine( inPoints3D, matrix4x4, outPoints3D );
 
@@ -2495,7 +3224,7 @@ E3Point3D_To3DTransformArray(const TQ3Point3D		*inPoints3D,
 	else
 	{
 		// Transform the points - will be in-lined in release builds
-		for (i = 0; i < numPoints; ++i)
+		for (; i < numPoints; ++i)
 		{
 			E3Point3D_Transform(inPoints3D, matrix4x4, outPoints3D);
 
@@ -2523,9 +3252,18 @@ E3Point3D_To4DTransformArray(const TQ3Point3D		*inPoints3D,
 							 TQ3Uns32				inStructSize,
 							 TQ3Uns32				outStructSize)
 {
-	TQ3Uns32 i;
+	TQ3Uns32 i = 0;
 	
-	for (i = 0; i < numPoints; ++i)
+#if QUESA_MATH_SIMD
+	if ( (inStructSize == sizeof(TQ3Point3D)) && (outStructSize == sizeof(TQ3RationalPoint4D)) )
+	{
+		i = e3point3d_to4d_transform_packed( inPoints3D, matrix4x4, outRationalPoints4D, numPoints );
+		inPoints3D          += i;
+		outRationalPoints4D += i;
+	}
+#endif
+	
+	for (; i < numPoints; ++i)
 	{
 		#define M(x,y) matrix4x4->value[x][y]
 		outRationalPoints4D->x = inPoints3D->x*M(0,0) + inPoints3D->y*M(1,0) + inPoints3D->z*M(2,0) + M(3,0);
@@ -4371,6 +5109,21 @@ E3BoundingBox_SetFromPoints3D(TQ3BoundingBox *bBox,
 		
 		Q3FastBoundingBox_Set(bBox, points3D, points3D, kQ3False);
 		
+#if QUESA_MATH_SIMD
+		// Tightly packed points are accumulated 4 at a time, and any left
+		// over one at a time
+		if (structSize == sizeof(TQ3Point3D))
+		{
+			i = e3bounding_box_accumulate_packed( bBox, points3D, numPoints );
+			
+			for (; i < numPoints; ++i)
+				e3bounding_box_accumulate_point3D( bBox, points3D + i );
+			
+			e3bounding_box_positive_zeros( bBox );
+			return(bBox);
+		}
+#endif
+		
 		// We have already accounted for the first point, so if the number of
 		// points is odd, we can handle the other points in pairs, and need not
 		// look at the first point again.  But if the number of points is even,
@@ -4457,6 +5210,8 @@ E3BoundingBox_SetFromPoints3D(TQ3BoundingBox *bBox,
 				}
 			}
 		}
+		
+		e3bounding_box_positive_zeros( bBox );
 	}
 
 	return(bBox);
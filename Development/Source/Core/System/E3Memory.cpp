@@ -53,6 +53,7 @@
 #include <time.h>
 #include <cstring>
 #include <atomic>
+#include <mutex>
 
 #if QUESA_OS_MACINTOSH
 	#include <unistd.h>
@@ -742,6 +743,8 @@ E3Memory_ForgetRecording(void)
 	E3GlobalsPtr	theGlobals = E3Globals_Get();
 	Q3_REQUIRE_OR_RESULT( theGlobals != nullptr, kQ3Failure );
 	
+	std::lock_guard<std::recursive_mutex> listLock( E3Object_GetLeakListMutex() );
+	
 	if (theGlobals->listHead)	// true if anything was ever recorded
 		{
 		anObject = NEXTLINK( theGlobals->listHead );
@@ -784,6 +787,8 @@ E3Memory_CountRecords(void)
 	
 	Q3_REQUIRE_OR_RESULT( theGlobals != nullptr, 0 ) ;
 	
+	std::lock_guard<std::recursive_mutex> listLock( E3Object_GetLeakListMutex() );
+	
 	if ( theGlobals->listHead != nullptr )	// true if anything was ever recorded
 		{
 		TQ3Object anObject = NEXTLINK( theGlobals->listHead ) ;
@@ -816,6 +821,8 @@ E3Memory_NextRecordedObject( TQ3Object inObject )
 	
 	Q3_REQUIRE_OR_RESULT( theGlobals != nullptr, nullptr ) ;
 	
+	std::lock_guard<std::recursive_mutex> listLock( E3Object_GetLeakListMutex() );
+	
 	if ( inObject == nullptr )
 		{
 		// Return the first thing in the list, if any.
@@ -859,6 +866,8 @@ E3Memory_DumpRecording( const char* fileName, const char* memo )
 	Q3_REQUIRE_OR_RESULT( Q3_VALID_PTR( fileName ), kQ3Failure );
 	Q3_REQUIRE_OR_RESULT( theGlobals != nullptr, kQ3Failure );
 	
+	std::lock_guard<std::recursive_mutex> listLock( E3Object_GetLeakListMutex() );
+	
 	if (theGlobals->listHead)	// true if anything was ever recorded
 	{
 		SetDirectoryForDump( fileName );
@@ -54,6 +54,12 @@
 	#include <unistd.h>
 #endif
 
+#if !QUESA_OS_WIN32
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+#endif
+
 
 
 
@@ -63,6 +69,11 @@
 #define kE3MemoryStorageDefaultGrowSize					1024
 #define kE3MemoryStorageMinimumGrowSize					32
 
+// Mapped path storage: size of the read window/write buffer used when the
+// file can not be mapped, and the value used for an unknown file position.
+#define kE3MappedStorageBufferSize						(1024 * 1024)
+#define kE3MappedStorageUnknownPosition					UINT32_MAX
+
 
 
 
@@ -80,7 +91,8 @@ E3StorageInfo::E3StorageInfo	(
 		: E3SharedInfo ( newClassMetaHandler, newParent ) ,
 		getData_Method		( (TQ3XStorageReadDataMethod)		Find_Method ( kQ3XMethodTypeStorageReadData ) ) ,
 		setData_Method		( (TQ3XStorageWriteDataMethod)		Find_Method ( kQ3XMethodTypeStorageWriteData ) ) ,
-		getEOF_Method		( (TQ3XStorageGetSizeMethod)		Find_Method ( kQ3XMethodTypeStorageGetSize ) )	
+		getEOF_Method		( (TQ3XStorageGetSizeMethod)		Find_Method ( kQ3XMethodTypeStorageGetSize ) ) ,
+		borrowData_Method	( (TE3StorageBorrowDataMethod)		Find_Method ( kQ3XMethodTypeStorageBorrowData ) )
 		 	 
 	{
 	if ( getData_Method == nullptr
@@ -227,6 +239,28 @@ e3storage_memory_getsize ( TQ3StorageObject inStorage, TQ3Uns32 *size )
 
 
 
+//=============================================================================
+//      e3storage_memory_borrow : Borrow a pointer to data in the storage.
+//-----------------------------------------------------------------------------
+TQ3Status
+e3storage_memory_borrow ( TQ3StorageObject inStorage, TQ3Uns32 offset, TQ3Uns32 dataSize, const TQ3Uns8 **outData )
+{
+	E3MemoryStorage* storage = (E3MemoryStorage*) inStorage;
+	*outData = nullptr ;
+
+	if ( offset > storage->memoryDetails.validSize ||
+		dataSize > storage->memoryDetails.validSize - offset )
+		return kQ3Failure ;
+
+	*outData = & storage->memoryDetails.buffer [ offset ] ;
+
+	return kQ3Success ;
+}
+
+
+
+
+
 //=============================================================================
 //      e3storage_memory_new : New method.
 //-----------------------------------------------------------------------------
@@ -418,6 +452,10 @@ e3storage_memory_metahandler(TQ3XMethodType methodType)
 			theMethod = (TQ3XFunctionPointer) e3storage_memory_write;
 			break;
 
+		case kQ3XMethodTypeStorageBorrowData:
+			theMethod = (TQ3XFunctionPointer) e3storage_memory_borrow;
+			break;
+
 		}
 	
 	return(theMethod);
@@ -785,6 +823,635 @@ e3storage_path_metahandler(TQ3XMethodType methodType)
 
 
 
+//=============================================================================
+//      e3storage_mapped_seek : Seek to an offset within a file.
+//-----------------------------------------------------------------------------
+//		Note :	fseek takes a long, which is 32 bits on Windows and 32-bit
+//				Unix, so offsets past 2 GB need the wider seek functions.
+//-----------------------------------------------------------------------------
+static TQ3Status
+e3storage_mapped_seek( TE3_MappedPathStorageData* instanceData, TQ3Uns32 offset )
+{
+	// Skip the seek if we're already there
+	if ( instanceData->filePosition == offset )
+		return kQ3Success;
+
+#if QUESA_OS_WIN32
+	if ( _fseeki64( instanceData->theFile, (__int64) offset, SEEK_SET ) != 0 )
+#else
+	if ( fseeko( instanceData->theFile, (off_t) offset, SEEK_SET ) != 0 )
+#endif
+	{
+		instanceData->filePosition = kE3MappedStorageUnknownPosition;
+		return kQ3Failure;
+	}
+	
+	instanceData->filePosition = offset;
+	return kQ3Success;
+}
+
+
+
+
+
+//=============================================================================
+//      e3storage_mapped_filesize : Get the size of an open file.
+//-----------------------------------------------------------------------------
+//		Note :	File format offsets are 32-bit, so larger files can't be read
+//				and are refused with an error.
+//-----------------------------------------------------------------------------
+static TQ3Status
+e3storage_mapped_filesize( FILE* theFile, TQ3Uns32* outSize )
+{
+#if QUESA_OS_WIN32
+	if ( _fseeki64( theFile, 0, SEEK_END ) != 0 )
+		return kQ3Failure;
+	
+	__int64 theSize = _ftelli64( theFile );
+#else
+	struct stat		fileInfo;
+	if ( fstat( fileno( theFile ), &fileInfo ) != 0 )
+		return kQ3Failure;
+	
+	off_t theSize = fileInfo.st_size;
+#endif
+
+	if ( theSize < 0 )
+		return kQ3Failure;
+
+	if ( (uint64_t) theSize > UINT32_MAX )
+	{
+		E3ErrorManager_PostError ( kQ3ErrorValueExceedsMaximumSize, kQ3False ) ;
+		return kQ3Failure;
+	}
+
+	*outSize = (TQ3Uns32) theSize;
+	return kQ3Success;
+}
+
+
+
+
+
+//=============================================================================
+//      e3storage_mapped_fill : Fill the read window starting at an offset.
+//-----------------------------------------------------------------------------
+static TQ3Status
+e3storage_mapped_fill( TE3_MappedPathStorageData* instanceData, TQ3Uns32 offset )
+{
+	// Allocate the window on first use
+	if ( instanceData->buffer == nullptr )
+	{
+		instanceData->buffer = (TQ3Uns8*) Q3Memory_Allocate( kE3MappedStorageBufferSize );
+		if ( instanceData->buffer == nullptr )
+			return kQ3Failure;
+	}
+	
+	
+	
+	// Read as much as we can. Switching between reading and writing requires
+	// a seek, so reads always seek and leave the file position unknown.
+	instanceData->bufferOffset = offset;
+	instanceData->bufferValid  = 0;
+	instanceData->filePosition = kE3MappedStorageUnknownPosition;
+
+	if ( e3storage_mapped_seek( instanceData, offset ) == kQ3Failure )
+		return kQ3Failure;
+
+	size_t bytesRead = fread( instanceData->buffer, 1, kE3MappedStorageBufferSize,
+		instanceData->theFile );
+	
+	instanceData->bufferValid  = (TQ3Uns32) bytesRead;
+	instanceData->filePosition = kE3MappedStorageUnknownPosition;
+	
+	return kQ3Success;
+}
+
+
+
+
+
+//=============================================================================
+//      e3storage_mapped_new : Mapped path storage new method.
+//-----------------------------------------------------------------------------
+static TQ3Status
+e3storage_mapped_new(TQ3Object /*theObject*/, void *privateData, const void *paramData)
+{	TE3_MappedPathStorageData	*instanceData = (TE3_MappedPathStorageData *) privateData;
+	const char					*pathName     = (const char *) paramData;
+
+
+
+	// Initialise our instance data
+	TQ3Uns32 pathLen = static_cast<TQ3Uns32>(strlen(pathName));
+	instanceData->thePath = (char *) Q3Memory_Allocate(pathLen + 1);
+	if (instanceData->thePath == nullptr)
+		return(kQ3Failure);
+
+	strcpy(instanceData->thePath, pathName);
+	
+	instanceData->filePosition = kE3MappedStorageUnknownPosition;
+	
+	return(kQ3Success);
+}
+
+
+
+
+
+//=============================================================================
+//      e3storage_mapped_duplicate : Mapped path storage duplicate method.
+//-----------------------------------------------------------------------------
+static TQ3Status
+e3storage_mapped_duplicate(	TQ3Object /*fromObject*/, const void *fromPrivateData,
+							TQ3Object /*toObject*/,   void       *toPrivateData)
+{
+	const TE3_MappedPathStorageData* fromInstanceData =
+		(const TE3_MappedPathStorageData *) fromPrivateData;
+	TE3_MappedPathStorageData* toInstanceData = (TE3_MappedPathStorageData *) toPrivateData;
+
+
+
+	// The copy starts out closed
+	Q3Memory_Clear( toInstanceData, sizeof(TE3_MappedPathStorageData) );
+	toInstanceData->filePosition = kE3MappedStorageUnknownPosition;
+
+	if ( fromInstanceData->theFile != nullptr || fromInstanceData->mapData != nullptr )
+	{
+		E3ErrorManager_PostError( kQ3ErrorFileIsOpen, kQ3False ) ;
+		return kQ3Failure ;
+	}
+	
+	
+	
+	// Copy the path
+	TQ3Uns32 pathLen = static_cast<TQ3Uns32>(strlen(fromInstanceData->thePath));
+	toInstanceData->thePath = (char *) Q3Memory_Allocate(pathLen + 1);
+	if (toInstanceData->thePath == nullptr)
+		return(kQ3Failure);
+
+	strcpy(toInstanceData->thePath, fromInstanceData->thePath);
+	
+	return kQ3Success;
+}
+
+
+
+
+
+//=============================================================================
+//      e3storage_mapped_open : Open the storage object.
+//-----------------------------------------------------------------------------
+//		Note :	Files opened for reading are mapped into memory if the
+//				platform supports it, and otherwise read through a large
+//				window. Files opened for writing are written through a large
+//				stdio buffer.
+//-----------------------------------------------------------------------------
+TQ3Status
+e3storage_mapped_open ( TQ3StorageObject inStorage, TQ3Boolean forWriting )
+{
+	TE3_MappedPathStorageData* instanceData = &((E3MappedPathStorage*) inStorage)->mappedDetails;
+
+
+
+	// Make sure the file isn't already open
+	if ( instanceData->theFile != nullptr || instanceData->mapData != nullptr )
+	{
+		E3ErrorManager_PostError ( kQ3ErrorFileAlreadyOpen, kQ3False ) ;
+		return kQ3Failure ;
+	}
+
+	instanceData->bufferOffset = 0;
+	instanceData->bufferValid  = 0;
+	instanceData->fileSize     = 0;
+	instanceData->filePosition = kE3MappedStorageUnknownPosition;
+
+
+
+	// Try and map the file
+#if !QUESA_OS_WIN32
+	if ( ! forWriting )
+	{
+		int theFD = open( instanceData->thePath, O_RDONLY );
+		if ( theFD == -1 )
+			return kQ3Failure;
+		
+		struct stat		fileInfo;
+		if ( fstat( theFD, &fileInfo ) != 0 )
+			fileInfo.st_size = 0;
+		
+		
+		// File format offsets are 32-bit, so larger files can't be read
+		if ( (uint64_t) fileInfo.st_size > UINT32_MAX )
+		{
+			close( theFD );
+			E3ErrorManager_PostError ( kQ3ErrorValueExceedsMaximumSize, kQ3False ) ;
+			return kQ3Failure;
+		}
+
+		if ( fileInfo.st_size > 0 )
+		{
+			void* theMap = mmap( nullptr, (size_t) fileInfo.st_size, PROT_READ,
+								MAP_PRIVATE, theFD, 0 );
+			if ( theMap != MAP_FAILED )
+			{
+	#ifdef MADV_SEQUENTIAL
+				madvise( theMap, (size_t) fileInfo.st_size, MADV_SEQUENTIAL );
+	#endif
+				instanceData->mapData  = (TQ3Uns8*) theMap;
+				instanceData->mapSize  = (TQ3Uns32) fileInfo.st_size;
+				instanceData->fileSize = instanceData->mapSize;
+			}
+		}
+		
+		
+		// The mapping keeps its own reference to the file
+		close( theFD );
+		
+		if ( instanceData->mapData != nullptr )
+			return kQ3Success;
+	}
+#endif
+
+
+
+	// Otherwise fall back to stdio
+	instanceData->theFile = fopen( instanceData->thePath, forWriting ? "wb+" : "rb" );
+	if ( instanceData->theFile == nullptr )
+		return kQ3Failure;
+
+	if ( forWriting )
+	{
+		setvbuf( instanceData->theFile, nullptr, _IOFBF, kE3MappedStorageBufferSize );
+		instanceData->filePosition = 0;
+	}
+	else if ( e3storage_mapped_filesize( instanceData->theFile, &instanceData->fileSize ) == kQ3Failure )
+	{
+		fclose( instanceData->theFile );
+		instanceData->theFile  = nullptr;
+		instanceData->fileSize = 0;
+		return kQ3Failure;
+	}
+	
+	return kQ3Success;
+}
+
+
+
+
+
+//=============================================================================
+//      e3storage_mapped_close : Close the storage object.
+//-----------------------------------------------------------------------------
+TQ3Status
+e3storage_mapped_close ( TQ3StorageObject inStorage )
+{
+	TE3_MappedPathStorageData* instanceData = &((E3MappedPathStorage*) inStorage)->mappedDetails;
+
+
+
+	// Make sure the file is open
+	if ( instanceData->theFile == nullptr && instanceData->mapData == nullptr )
+	{
+		E3ErrorManager_PostError ( kQ3ErrorFileNotOpen, kQ3False ) ;
+		return kQ3Failure ;
+	}
+
+
+
+	// Release the mapping or close the file
+#if !QUESA_OS_WIN32
+	if ( instanceData->mapData != nullptr )
+		munmap( instanceData->mapData, (size_t) instanceData->mapSize );
+#endif
+
+	if ( instanceData->theFile != nullptr )
+		fclose( instanceData->theFile );
+
+	Q3Memory_Free( &instanceData->buffer );
+
+	instanceData->theFile      = nullptr;
+	instanceData->mapData      = nullptr;
+	instanceData->mapSize      = 0;
+	instanceData->bufferValid  = 0;
+	instanceData->fileSize     = 0;
+	instanceData->filePosition = kE3MappedStorageUnknownPosition;
+
+	return kQ3Success ;
+}
+
+
+
+
+
+//=============================================================================
+//      e3storage_mapped_delete : Mapped path storage delete method.
+//-----------------------------------------------------------------------------
+static void
+e3storage_mapped_delete(TQ3Object storage, void *privateData)
+{	TE3_MappedPathStorageData	*instanceData = (TE3_MappedPathStorageData *) privateData;
+
+
+
+	// Make sure the file isn't open
+	if (instanceData->theFile != nullptr || instanceData->mapData != nullptr)
+	{
+		E3ErrorManager_PostError(kQ3ErrorFileIsOpen, kQ3False);
+		e3storage_mapped_close( storage );
+	}
+
+
+	// Dispose of our instance data
+	Q3Memory_Free(&instanceData->thePath);
+}
+
+
+
+
+
+//=============================================================================
+//      e3storage_mapped_getopenness : Check openness of the storage object.
+//-----------------------------------------------------------------------------
+TQ3Status
+e3storage_mapped_getopenness( TQ3StorageObject inStorage, TQ3StorageOpenness* outOpenness )
+{
+	TE3_MappedPathStorageData* instanceData = &((E3MappedPathStorage*) inStorage)->mappedDetails;
+
+	if ( instanceData->theFile == nullptr && instanceData->mapData == nullptr )
+		*outOpenness = kQ3StorageOpenness_Closed;
+	else
+		*outOpenness = kQ3StorageOpenness_Open;
+
+	return kQ3Success;
+}
+
+
+
+
+
+//=============================================================================
+//      e3storage_mapped_getsize : Get the size of the storage object.
+//-----------------------------------------------------------------------------
+TQ3Status
+e3storage_mapped_getsize ( TQ3StorageObject inStorage, TQ3Uns32 *size )
+{
+	TE3_MappedPathStorageData* instanceData = &((E3MappedPathStorage*) inStorage)->mappedDetails;
+
+
+
+	// Make sure the file is open
+	if ( instanceData->theFile == nullptr && instanceData->mapData == nullptr )
+	{
+		E3ErrorManager_PostError ( kQ3ErrorFileNotOpen, kQ3False ) ;
+		return kQ3Failure ;
+	}
+
+
+
+	// We track the size as we go, so no seeking is required
+	*size = instanceData->fileSize;
+	
+	return kQ3Success;
+}
+
+
+
+
+
+//=============================================================================
+//      e3storage_mapped_read : Read data from the storage object.
+//-----------------------------------------------------------------------------
+TQ3Status
+e3storage_mapped_read ( TQ3StorageObject inStorage, TQ3Uns32 offset, TQ3Uns32 dataSize, unsigned char *data, TQ3Uns32 *sizeRead )
+{
+	TE3_MappedPathStorageData* instanceData = &((E3MappedPathStorage*) inStorage)->mappedDetails;
+	*sizeRead = 0;
+
+
+
+	// Make sure the file is open
+	if ( instanceData->theFile == nullptr && instanceData->mapData == nullptr )
+	{
+		E3ErrorManager_PostError ( kQ3ErrorFileNotOpen, kQ3False ) ;
+		return kQ3Failure ;
+	}
+
+	if ( offset >= instanceData->fileSize || dataSize == 0 )
+		return kQ3Success;
+	
+	TQ3Uns32 bytesToRead = dataSize;
+	if ( bytesToRead > instanceData->fileSize - offset )
+		bytesToRead = instanceData->fileSize - offset;
+
+
+
+	// Copy straight from the mapping if we have one
+	if ( instanceData->mapData != nullptr )
+	{
+		Q3Memory_Copy( instanceData->mapData + offset, data, bytesToRead );
+		*sizeRead = bytesToRead;
+		return kQ3Success;
+	}
+
+
+
+	// Large reads bypass the window
+	if ( bytesToRead >= kE3MappedStorageBufferSize )
+	{
+		instanceData->filePosition = kE3MappedStorageUnknownPosition;
+		if ( e3storage_mapped_seek( instanceData, offset ) == kQ3Failure )
+			return kQ3Failure;
+		
+		size_t bytesRead = fread( data, 1, bytesToRead, instanceData->theFile );
+		instanceData->filePosition = kE3MappedStorageUnknownPosition;
+		*sizeRead = (TQ3Uns32) bytesRead;
+		return kQ3Success;
+	}
+	
+	
+	
+	// Otherwise read through the window, refilling it if necessary
+	if ( offset < instanceData->bufferOffset ||
+		offset - instanceData->bufferOffset + bytesToRead > instanceData->bufferValid )
+	{
+		if ( e3storage_mapped_fill( instanceData, offset ) == kQ3Failure )
+			return kQ3Failure;
+		
+		if ( bytesToRead > instanceData->bufferValid )
+			bytesToRead = instanceData->bufferValid;
+	}
+
+	Q3Memory_Copy( instanceData->buffer + (offset - instanceData->bufferOffset), data, bytesToRead );
+	*sizeRead = bytesToRead;
+
+	return kQ3Success;
+}
+
+
+
+
+
+//=============================================================================
+//      e3storage_mapped_borrow : Borrow a pointer to data in the storage.
+//-----------------------------------------------------------------------------
+//		Note :	If the file is mapped, the pointer remains valid until the
+//				storage is closed. Otherwise it points into the read window,
+//				and is only valid until the next read from the storage.
+//-----------------------------------------------------------------------------
+TQ3Status
+e3storage_mapped_borrow ( TQ3StorageObject inStorage, TQ3Uns32 offset, TQ3Uns32 dataSize, const TQ3Uns8 **outData )
+{
+	TE3_MappedPathStorageData* instanceData = &((E3MappedPathStorage*) inStorage)->mappedDetails;
+	*outData = nullptr;
+
+
+
+	// Check we can satisfy the request
+	if ( offset > instanceData->fileSize || dataSize > instanceData->fileSize - offset )
+		return kQ3Failure;
+	
+	if ( instanceData->mapData != nullptr )
+	{
+		*outData = instanceData->mapData + offset;
+		return kQ3Success;
+	}
+	
+	if ( instanceData->theFile == nullptr || dataSize > kE3MappedStorageBufferSize )
+		return kQ3Failure;
+
+
+
+	// Refill the window if necessary
+	if ( instanceData->buffer == nullptr || offset < instanceData->bufferOffset ||
+		offset - instanceData->bufferOffset + dataSize > instanceData->bufferValid )
+	{
+		if ( e3storage_mapped_fill( instanceData, offset ) == kQ3Failure )
+			return kQ3Failure;
+		
+		if ( dataSize > instanceData->bufferValid )
+			return kQ3Failure;
+	}
+	
+	*outData = instanceData->buffer + (offset - instanceData->bufferOffset);
+
+	return kQ3Success;
+}
+
+
+
+
+
+//=============================================================================
+//      e3storage_mapped_write : Write data to the storage object.
+//-----------------------------------------------------------------------------
+TQ3Status
+e3storage_mapped_write ( TQ3StorageObject inStorage, TQ3Uns32 offset, TQ3Uns32 dataSize, const unsigned char *data, TQ3Uns32 *sizeWritten )
+{
+	TE3_MappedPathStorageData* instanceData = &((E3MappedPathStorage*) inStorage)->mappedDetails;
+	*sizeWritten = 0;
+
+
+
+	// Make sure the file is open for writing
+	if ( instanceData->theFile == nullptr )
+	{
+		E3ErrorManager_PostError ( kQ3ErrorFileNotOpen, kQ3False ) ;
+		return kQ3Failure ;
+	}
+
+
+
+	// Offsets are 32-bit, so the file can't grow past 4 GB
+	if ( dataSize > UINT32_MAX - offset )
+	{
+		E3ErrorManager_PostError ( kQ3ErrorValueExceedsMaximumSize, kQ3False ) ;
+		return kQ3Failure ;
+	}
+
+
+
+	// Seek only if the write is not sequential, so that stdio can buffer it
+	if ( e3storage_mapped_seek( instanceData, offset ) == kQ3Failure )
+		return kQ3Failure;
+
+	size_t bytesWritten = fwrite( data, 1, dataSize, instanceData->theFile );
+	
+	
+	
+	// Update our state, discarding any read window that overlapped the write
+	instanceData->filePosition += (TQ3Uns32) bytesWritten;
+	instanceData->bufferValid   = 0;
+	
+	if ( instanceData->filePosition > instanceData->fileSize )
+		instanceData->fileSize = instanceData->filePosition;
+
+	*sizeWritten = (TQ3Uns32) bytesWritten;
+
+	return kQ3Success;
+}
+
+
+
+
+
+//=============================================================================
+//      e3storage_mapped_metahandler : Mapped path storage metahandler.
+//-----------------------------------------------------------------------------
+static TQ3XFunctionPointer
+e3storage_mapped_metahandler(TQ3XMethodType methodType)
+{	TQ3XFunctionPointer		theMethod = nullptr;
+
+
+
+	// Return our methods
+	switch (methodType) {
+		case kQ3XMethodTypeObjectNew:
+			theMethod = (TQ3XFunctionPointer) e3storage_mapped_new;
+			break;
+
+		case kQ3XMethodTypeObjectDelete:
+			theMethod = (TQ3XFunctionPointer) e3storage_mapped_delete;
+			break;
+
+		case kQ3XMethodTypeObjectDuplicate:
+			theMethod = (TQ3XFunctionPointer) e3storage_mapped_duplicate;
+			break;
+
+		case kQ3XMethodTypeStorageOpen:
+			theMethod = (TQ3XFunctionPointer) e3storage_mapped_open;
+			break;
+
+		case kQ3XMethodTypeStorageClose:
+			theMethod = (TQ3XFunctionPointer) e3storage_mapped_close;
+			break;
+
+		case kQ3XMethodTypeStorageGetOpenness:
+			theMethod = (TQ3XFunctionPointer) e3storage_mapped_getopenness;
+			break;
+
+		case kQ3XMethodTypeStorageGetSize:
+			theMethod = (TQ3XFunctionPointer) e3storage_mapped_getsize;
+			break;
+
+		case kQ3XMethodTypeStorageReadData:
+			theMethod = (TQ3XFunctionPointer) e3storage_mapped_read;
+			break;
+
+		case kQ3XMethodTypeStorageBorrowData:
+			theMethod = (TQ3XFunctionPointer) e3storage_mapped_borrow;
+			break;
+
+		case kQ3XMethodTypeStorageWriteData:
+			theMethod = (TQ3XFunctionPointer) e3storage_mapped_write;
+			break;
+		}
+	
+	return(theMethod);
+}
+
+
+
+
+
 //=============================================================================
 //      e3storage_stream_new : Stream storage new method.
 //-----------------------------------------------------------------------------
@@ -1007,6 +1674,12 @@ E3Storage_RegisterClass(void)
 											E3PathStorage,
 											pathDetails ) ;
 
+	if (qd3dStatus == kQ3Success)
+		qd3dStatus = Q3_REGISTER_CLASS_WITH_MEMBER (	kQ3ClassNameStorageMappedPath,
+											e3storage_mapped_metahandler,
+											E3MappedPathStorage,
+											mappedDetails ) ;
+
 	if (qd3dStatus == kQ3Success)
 		qd3dStatus = Q3_REGISTER_CLASS_WITH_MEMBER (	kQ3ClassNameStorageStream,
 											e3storage_stream_metahandler,
@@ -1041,6 +1714,7 @@ E3Storage_UnregisterClass(void)
 	E3ClassTree::UnregisterClass(kQ3SharedTypeStorage, kQ3True);
 	E3ClassTree::UnregisterClass(kQ3StorageTypeMemory, kQ3True);
 	E3ClassTree::UnregisterClass(kQ3StorageTypePath,   kQ3True);
+	E3ClassTree::UnregisterClass(kQ3StorageTypeMappedPath,   kQ3True);
 	E3ClassTree::UnregisterClass(kQ3StorageTypeFileStream,   kQ3True);
 
 #if QUESA_OS_WIN32
@@ -1137,6 +1811,28 @@ E3Storage::SetData ( TQ3Uns32 offset, TQ3Uns32 dataSize, const unsigned char* da
 
 
 
+//=============================================================================
+//      E3Storage::BorrowData : Borrow a pointer to data in a storage object.
+//-----------------------------------------------------------------------------
+//		Note :	Borrowing is an optimisation, and is not supported by every
+//				storage class. Callers must fall back to GetData on failure,
+//				so no error is posted.
+//-----------------------------------------------------------------------------
+TQ3Status
+E3Storage::BorrowData ( TQ3Uns32 offset, TQ3Uns32 dataSize, const TQ3Uns8** outData )
+	{
+	*outData = nullptr ;
+
+	if ( GetClass ()->borrowData_Method == nullptr )
+		return kQ3Failure ;
+	
+	return GetClass ()->borrowData_Method ( this, offset, dataSize, outData ) ;
+	}
+
+
+
+
+
 //=============================================================================
 //      E3Storage::Open : Open a storage object without aid of a File.
 //-----------------------------------------------------------------------------
@@ -1512,6 +2208,19 @@ E3PathStorage::Get ( char *pathName )
 
 
 
+//=============================================================================
+//      E3MappedPathStorage_New : Create a mapped path storage object.
+//-----------------------------------------------------------------------------
+TQ3StorageObject
+E3MappedPathStorage_New(const char *pathName)
+{
+	return E3ClassTree::CreateInstance ( kQ3StorageTypeMappedPath, kQ3False, pathName ) ;
+}
+
+
+
+
+
 //=============================================================================
 //      E3FileStreamStorage_New : Create a stream storage object.
 //-----------------------------------------------------------------------------
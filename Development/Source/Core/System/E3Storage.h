@@ -84,6 +84,28 @@ typedef struct TQ3PathStorageData {
 } TQ3PathStorageData;
 
 
+// Mapped path storage
+typedef struct TE3_MappedPathStorageData {
+	char*		thePath;
+	FILE*		theFile;
+	TQ3Uns8*	mapData;
+	TQ3Uns32	mapSize;
+	TQ3Uns8*	buffer;
+	TQ3Uns32	bufferOffset;
+	TQ3Uns32	bufferValid;
+	TQ3Uns32	fileSize;
+	TQ3Uns32	filePosition;
+} TE3_MappedPathStorageData;
+
+
+// Borrowing method, used internally by the file format readers
+typedef TQ3Status (*TE3StorageBorrowDataMethod)(
+					TQ3StorageObject	storage,
+					TQ3Uns32			offset,
+					TQ3Uns32			dataSize,
+					const TQ3Uns8**		outData);
+
+
 
 
 class E3StorageInfo : public E3SharedInfo
@@ -91,6 +113,7 @@ class E3StorageInfo : public E3SharedInfo
 	const TQ3XStorageReadDataMethod		getData_Method ;
 	const TQ3XStorageWriteDataMethod	setData_Method ;
 	const TQ3XStorageGetSizeMethod		getEOF_Method ;
+	const TE3StorageBorrowDataMethod	borrowData_Method ;
 	
 public :
 
@@ -120,6 +143,8 @@ public :
 	TQ3Status						GetSize ( TQ3Uns32* size ) ;
 	TQ3Status						GetData ( TQ3Uns32 offset, TQ3Uns32 dataSize, unsigned char* data, TQ3Uns32* sizeRead ) ;
 	TQ3Status						SetData ( TQ3Uns32 offset, TQ3Uns32 dataSize, const unsigned char* data, TQ3Uns32* sizeWritten ) ;
+
+	TQ3Status						BorrowData ( TQ3Uns32 offset, TQ3Uns32 dataSize, const TQ3Uns8** outData ) ;
 	
 	TQ3Status						Open( TQ3Boolean forWriting );
 	TQ3Status						Close();
@@ -144,6 +169,7 @@ public :
 	friend TQ3Status			e3storage_memory_grow ( E3MemoryStorage* storage, TQ3Uns32 requestedSize ) ;
 	friend TQ3Status			e3storage_memory_write ( E3MemoryStorage* storage, TQ3Uns32 offset, TQ3Uns32 dataSize, const unsigned char *data, TQ3Uns32 *sizeWritten ) ;
 	friend TQ3Status			e3storage_memory_getsize ( TQ3StorageObject inStorage, TQ3Uns32 *size ) ;
+	friend TQ3Status			e3storage_memory_borrow ( TQ3StorageObject inStorage, TQ3Uns32 offset, TQ3Uns32 dataSize, const TQ3Uns8 **outData ) ;
 	} ;
 
 
@@ -170,6 +196,24 @@ public :
 
 
 
+class E3MappedPathStorage : public E3Storage
+{
+Q3_CLASS_ENUMS ( kQ3StorageTypeMappedPath, E3MappedPathStorage, E3Storage )
+
+public:
+	TE3_MappedPathStorageData	mappedDetails;
+
+	friend TQ3Status			e3storage_mapped_open ( TQ3StorageObject inStorage, TQ3Boolean forWriting ) ;
+	friend TQ3Status			e3storage_mapped_close ( TQ3StorageObject inStorage ) ;
+	friend TQ3Status			e3storage_mapped_getopenness ( TQ3StorageObject inStorage, TQ3StorageOpenness* outOpenness ) ;
+	friend TQ3Status			e3storage_mapped_getsize ( TQ3StorageObject inStorage, TQ3Uns32 *size ) ;
+	friend TQ3Status			e3storage_mapped_read ( TQ3StorageObject inStorage, TQ3Uns32 offset, TQ3Uns32 dataSize, unsigned char *data, TQ3Uns32 *sizeRead ) ;
+	friend TQ3Status			e3storage_mapped_borrow ( TQ3StorageObject inStorage, TQ3Uns32 offset, TQ3Uns32 dataSize, const TQ3Uns8 **outData ) ;
+	friend TQ3Status			e3storage_mapped_write ( TQ3StorageObject inStorage, TQ3Uns32 offset, TQ3Uns32 dataSize, const unsigned char *data, TQ3Uns32 *sizeWritten ) ;
+};
+
+
+
 class E3FileStreamStorage : public E3Storage
 {
 Q3_CLASS_ENUMS ( kQ3StorageTypeFileStream, E3FileStreamStorage, E3Storage )
@@ -198,6 +242,7 @@ TQ3StorageObject	E3MemoryStorage_New(const unsigned char *buffer, TQ3Uns32 valid
 TQ3StorageObject	E3MemoryStorage_NewNoCopy(unsigned char *buffer, TQ3Uns32 validSize, TQ3Uns32 bufferSize);
 TQ3StorageObject	E3MemoryStorage_NewBuffer(unsigned char *buffer, TQ3Uns32 validSize, TQ3Uns32 bufferSize);
 TQ3StorageObject	E3PathStorage_New(const char *pathName, TQ3Boolean owned);
+TQ3StorageObject	E3MappedPathStorage_New(const char *pathName);
 TQ3StorageObject	E3FileStreamStorage_New(FILE *stream);
 
 
@@ -124,12 +124,7 @@ class E3View ;
 
 // Stack data
 typedef struct TQ3ViewStackItem {
-	// Next stack item
-	struct TQ3ViewStackItem*	next;
-	
-	
 	// Stack item state
-	TQ3ViewStackState			stackState;
 	TQ3Matrix4x4				matrixLocalToWorld;
 	TQ3Matrix4x4				matrixWorldToCamera;
 	TQ3Matrix4x4				matrixLocalToCamera;
@@ -165,6 +160,30 @@ typedef struct TQ3ViewStackItem {
 } TQ3ViewStackItem;
 
 
+// Stack frame
+//
+// A frame records the log position at the time of a push, the fields which
+// have been saved to the log since, and the renderer state which has been
+// changed since.
+typedef struct TQ3ViewStackFrame {
+	TQ3Uns32					logStart;
+	TQ3ViewStackState			savedState;
+	TQ3ViewStackState			stackState;
+} TQ3ViewStackFrame;
+
+
+// Stack field
+//
+// Describes a field of the stack item which is saved to the undo log when
+// the given state changes. Shared fields hold a reference while logged.
+typedef struct TQ3ViewStackField {
+	TQ3ViewStackState			theState;
+	TQ3Uns32					fieldOffset;
+	TQ3Uns32					fieldSize;
+	TQ3Boolean					isShared;
+} TQ3ViewStackField;
+
+
 // View data
 typedef struct TQ3ViewData {
 	// View state
@@ -176,15 +195,23 @@ typedef struct TQ3ViewData {
 	TQ3AttributeSet				viewAttributes;
 	TQ3AttributeSet				stateAttributes;	// needed for E3View_GetAttributeState
 	TQ3Boolean					allowGroupCulling;
+	TQ3Boolean					allowAutomaticGroupCulling;
 
 
 	// View stack
 	TQ3ViewStackItem			*viewStack;
-	TQ3ViewStackItem			*viewStackFreeList;
+	TQ3ViewStackItem			*viewStackStorage;
+	TQ3ViewStackFrame			*viewStackFrames;
+	TQ3Uns32					viewStackDepth;
+	TQ3Uns32					viewStackFramesSize;
+	TQ3Uns8						*viewStackLog;
+	TQ3Uns32					viewStackLogUsed;
+	TQ3Uns32					viewStackLogSize;
 	// Note: The renderer may cache pointers into the TQ3ViewStackItem, so the
-	// TQ3ViewStackItem should never move.  This is why we use a linked list
-	// rather than something like std::vector.  We keep a free list instead of
-	// freeing popped records, just to reduce memory allocations and frees.
+	// TQ3ViewStackItem should never move.  Rather than keeping an item per
+	// push, we keep a single item holding the current state (viewStack, which
+	// is nullptr when the stack is empty), and an undo log of the fields which
+	// have been changed since each push.
 
 
 	// Bounds state
@@ -209,6 +236,7 @@ typedef struct TQ3ViewData {
 	TQ3Object					pickedObject;
 	TQ3Ray3D					rayThroughPick;
 	TQ3Uns32					pickDecomposeCount;
+	TQ3Uns32					pickGeometryCount;
 
 
 	// Write state
@@ -296,6 +324,59 @@ public :
 	
 
 
+//=============================================================================
+//      Internal constants
+//-----------------------------------------------------------------------------
+// View stack fields
+//
+// The local-to-camera matrix is derived from both the local-to-world and the
+// world-to-camera matrices, so is saved when either of them changes.
+#define E3_VIEW_STACK_FIELD(_state, _field, _isShared)						\
+	{ _state, (TQ3Uns32) offsetof(TQ3ViewStackItem, _field),				\
+	  (TQ3Uns32) sizeof(((TQ3ViewStackItem*) nullptr)->_field), _isShared }
+
+static const TQ3ViewStackField kViewStackFields[] = {
+	E3_VIEW_STACK_FIELD(kQ3ViewStateMatrixLocalToWorld,			 matrixLocalToWorld,		  kQ3False),
+	E3_VIEW_STACK_FIELD(kQ3ViewStateMatrixLocalToWorld,			 matrixLocalToCamera,		  kQ3False),
+	E3_VIEW_STACK_FIELD(kQ3ViewStateMatrixWorldToCamera,		 matrixWorldToCamera,		  kQ3False),
+	E3_VIEW_STACK_FIELD(kQ3ViewStateMatrixWorldToCamera,		 matrixLocalToCamera,		  kQ3False),
+	E3_VIEW_STACK_FIELD(kQ3ViewStateMatrixCameraToFrustum,		 matrixCameraToFrustum,		  kQ3False),
+	E3_VIEW_STACK_FIELD(kQ3ViewStateMatrixCameraToFrustum,		 hasMatrixCameraToFrustum,	  kQ3False),
+	E3_VIEW_STACK_FIELD(kQ3ViewStateShaderIllumination,			 shaderIllumination,		  kQ3True),
+	E3_VIEW_STACK_FIELD(kQ3ViewStateShaderSurface,				 shaderSurface,				  kQ3True),
+	E3_VIEW_STACK_FIELD(kQ3ViewStateStyleBackfacing,			 styleBackfacing,			  kQ3False),
+	E3_VIEW_STACK_FIELD(kQ3ViewStateStyleInterpolation,			 styleInterpolation,		  kQ3False),
+	E3_VIEW_STACK_FIELD(kQ3ViewStateStyleFill,					 styleFill,					  kQ3False),
+	E3_VIEW_STACK_FIELD(kQ3ViewStateStyleHighlight,				 styleHighlight,			  kQ3True),
+	E3_VIEW_STACK_FIELD(kQ3ViewStateStyleSubdivision,			 styleSubdivision,			  kQ3False),
+	E3_VIEW_STACK_FIELD(kQ3ViewStateStyleOrientation,			 styleOrientation,			  kQ3False),
+	E3_VIEW_STACK_FIELD(kQ3ViewStateStyleCastShadows,			 styleCastShadows,			  kQ3False),
+	E3_VIEW_STACK_FIELD(kQ3ViewStateStyleReceiveShadows,		 styleReceiveShadows,		  kQ3False),
+	E3_VIEW_STACK_FIELD(kQ3ViewStateStylePickID,				 stylePickID,				  kQ3False),
+	E3_VIEW_STACK_FIELD(kQ3ViewStateStylePickParts,				 stylePickParts,			  kQ3False),
+	E3_VIEW_STACK_FIELD(kQ3ViewStateStyleAntiAlias,				 styleAntiAlias,			  kQ3False),
+	E3_VIEW_STACK_FIELD(kQ3ViewStateStyleFog,					 styleFogExtended,			  kQ3False),
+	E3_VIEW_STACK_FIELD(kQ3ViewStateStyleLineWidth,				 styleLineWidth,			  kQ3False),
+	E3_VIEW_STACK_FIELD(kQ3ViewStateAttributeSurfaceUV,			 attributeSurfaceUV,		  kQ3False),
+	E3_VIEW_STACK_FIELD(kQ3ViewStateAttributeShadingUV,			 attributeShadingUV,		  kQ3False),
+	E3_VIEW_STACK_FIELD(kQ3ViewStateAttributeNormal,			 attributeNormal,			  kQ3False),
+	E3_VIEW_STACK_FIELD(kQ3ViewStateAttributeAmbientCoefficient, attributeAmbientCoefficient, kQ3False),
+	E3_VIEW_STACK_FIELD(kQ3ViewStateAttributeDiffuseColour,		 attributeDiffuseColor,		  kQ3False),
+	E3_VIEW_STACK_FIELD(kQ3ViewStateAttributeSpecularColour,	 attributeSpecularColor,	  kQ3False),
+	E3_VIEW_STACK_FIELD(kQ3ViewStateAttributeSpecularControl,	 attributeSpecularControl,	  kQ3False),
+	E3_VIEW_STACK_FIELD(kQ3ViewStateAttributeMetallic,			 attributeMetallic,			  kQ3False),
+	E3_VIEW_STACK_FIELD(kQ3ViewStateAttributeTransparencyColour, attributeTransparencyColor,  kQ3False),
+	E3_VIEW_STACK_FIELD(kQ3ViewStateAttributeEmissiveColor,		 attributeEmissiveColor,	  kQ3False),
+	E3_VIEW_STACK_FIELD(kQ3ViewStateAttributeSurfaceTangent,	 attributeSurfaceTangent,	  kQ3False),
+	E3_VIEW_STACK_FIELD(kQ3ViewStateAttributeHighlightState,	 attributeHighlightState,	  kQ3False)
+};
+
+#define kViewStackFieldCount		(sizeof(kViewStackFields) / sizeof(kViewStackFields[0]))
+
+
+
+
+
 //=============================================================================
 //      Internal functions
 //-----------------------------------------------------------------------------
@@ -332,8 +413,6 @@ e3view_stack_initialise(TQ3ViewStackItem *theItem)
 	Q3Matrix4x4_SetIdentity(&theItem->matrixCameraToFrustum);
 	theItem->hasMatrixCameraToFrustum = kQ3True;
 
-	theItem->next					 = nullptr;
-	theItem->stackState				 = kQ3ViewStateNone;
 	theItem->shaderIllumination		 = Q3NULLIllumination_New();
 	theItem->shaderSurface			 = nullptr;
 	theItem->styleBackfacing         = kQ3BackfacingStyleBoth;
@@ -593,7 +672,7 @@ e3view_stack_update ( E3View* view, TQ3ViewStackState stateChange )
 	
 
 	// Update what has changed since the last push.
-	theItem->stackState |= stateChange ;
+	view->instanceData.viewStackFrames[ view->instanceData.viewStackDepth - 1 ].stackState |= stateChange ;
 
 
 
@@ -604,11 +683,99 @@ e3view_stack_update ( E3View* view, TQ3ViewStackState stateChange )
 
 
 
+//=============================================================================
+//      e3view_stack_save : Save fields to the undo log before changing them.
+//-----------------------------------------------------------------------------
+//		Note :	Must be called before the fields for theState are modified.
+//
+//				Each field is saved at most once per push, and fields are
+//				never saved for the first item since nothing is restored when
+//				it is popped. Shared objects keep a reference while logged.
+//
+//				A log entry is the field data followed by the field index, so
+//				that the log can be walked backwards when popping.
+//-----------------------------------------------------------------------------
+static void
+e3view_stack_save ( E3View* view, TQ3ViewStackState theState )
+	{
+	TQ3ViewData& instanceData( view->instanceData );
+
+
+
+	// Check we need to save anything
+	if ( instanceData.viewStackDepth < 2 )
+		return ;
+
+	TQ3ViewStackFrame& theFrame( instanceData.viewStackFrames[ instanceData.viewStackDepth - 1 ] );
+	TQ3ViewStackState newState = theState & ~theFrame.savedState ;
+	if ( newState == kQ3ViewStateNone )
+		return ;
+
+
+
+	// Grow the log to hold every field we're about to save
+	//
+	// The fields are only marked as saved once there is room for them, so
+	// that a failed allocation doesn't leave them marked as saved when the
+	// log holds nothing to restore.
+	TQ3Uns32 logNeeded = instanceData.viewStackLogUsed ;
+	for ( TQ3Uns32 n = 0 ; n < kViewStackFieldCount ; ++n )
+		{
+		if ( ( kViewStackFields[ n ].theState & newState ) != 0 )
+			logNeeded += kViewStackFields[ n ].fieldSize + sizeof ( TQ3Uns32 ) ;
+		}
+
+	if ( logNeeded > instanceData.viewStackLogSize )
+		{
+		TQ3Uns32 newSize = E3Num_Max ( 2 * instanceData.viewStackLogSize, logNeeded ) ;
+		newSize = E3Num_Max ( newSize, (TQ3Uns32) 1024 ) ;
+		if ( Q3Memory_Reallocate ( &instanceData.viewStackLog, newSize ) == kQ3Failure )
+			return ;
+		
+		instanceData.viewStackLogSize = newSize ;
+		}
+
+	theFrame.savedState |= newState ;
+
+
+
+	// Append the fields to the log
+	for ( TQ3Uns32 n = 0 ; n < kViewStackFieldCount ; ++n )
+		{
+		const TQ3ViewStackField& theField( kViewStackFields[ n ] );
+		if ( ( theField.theState & newState ) == 0 )
+			continue ;
+
+
+
+		// Save the field, taking a reference to shared objects
+		TQ3Uns8* fieldData = ( (TQ3Uns8*) instanceData.viewStack ) + theField.fieldOffset ;
+		TQ3Uns8* logData   = instanceData.viewStackLog + instanceData.viewStackLogUsed ;
+		TQ3Uns32 entrySize = theField.fieldSize + sizeof ( TQ3Uns32 ) ;
+
+		if ( theField.isShared )
+			{
+			TQ3SharedObject theObject = nullptr ;
+			E3Shared_Acquire ( &theObject, *( (TQ3SharedObject*) fieldData ) ) ;
+			memcpy ( logData, &theObject, sizeof ( TQ3SharedObject ) ) ;
+			}
+		else
+			memcpy ( logData, fieldData, theField.fieldSize ) ;
+		
+		memcpy ( logData + theField.fieldSize, &n, sizeof ( TQ3Uns32 ) ) ;
+		instanceData.viewStackLogUsed += entrySize ;
+		}
+	}
+
+
+
+
+
 //=============================================================================
 //      e3view_stack_push : Push the view state stack.
 //-----------------------------------------------------------------------------
-//		Note :	The first item is initialise to default values, and further
-//				items are cloned from the previously topmost item on the stack.
+//		Note :	The first push initialises the state to default values, and
+//				further pushes simply start a new frame in the undo log.
 //-----------------------------------------------------------------------------
 static TQ3Status
 e3view_stack_push ( E3View* view )
@@ -619,57 +786,45 @@ e3view_stack_push ( E3View* view )
 
 
 
-	// Grow the view stack to the hold the new item
-	TQ3ViewStackItem* newTop = nullptr;
-	if (instanceData.viewStackFreeList != nullptr)
-	{
-		newTop = instanceData.viewStackFreeList;
-		instanceData.viewStackFreeList = instanceData.viewStackFreeList->next;
-	}
-	else
-	{
-		newTop = (TQ3ViewStackItem*) Q3Memory_Allocate( sizeof ( TQ3ViewStackItem ) );
-		if ( newTop == nullptr )
+	// Grow the frames to hold the new frame
+	if ( instanceData.viewStackDepth == instanceData.viewStackFramesSize )
 		{
-			return kQ3Failure;
-		}
-	}
-	TQ3ViewStackItem* oldTop = instanceData.viewStack;
-	instanceData.viewStack = newTop;
-	
+		TQ3Uns32 newSize = E3Num_Max ( 2 * instanceData.viewStackFramesSize, (TQ3Uns32) 32 ) ;
+		if ( Q3Memory_Reallocate ( &instanceData.viewStackFrames, newSize * sizeof ( TQ3ViewStackFrame ) ) == kQ3Failure )
+			return kQ3Failure ;
 
-	// If this is the first item, initialise it
-	if ( oldTop == nullptr )
-		{
-		e3view_stack_initialise ( newTop ) ;
-		newTop->next = oldTop ;
-		instanceData.isLocalToFrustumValid = false;
-		instanceData.isLocalToFrustumInverseValid = false;
+		instanceData.viewStackFramesSize = newSize ;
 		}
-	
-	// Otherwise, clone what was on the top to the new top
-	else
-		{
-		// Take a copy of the state
-		Q3Memory_Copy ( oldTop, newTop, sizeof ( TQ3ViewStackItem ) ) ;
-		newTop->next = oldTop ;
 
 
 
-		// The stack state represents renderer state that has been changed since the push.
-		newTop->stackState = kQ3ViewStateNone ;
+	// If this is the first item, initialise the state
+	if ( instanceData.viewStack == nullptr )
+		{
+		if ( instanceData.viewStackStorage == nullptr )
+			{
+			instanceData.viewStackStorage = (TQ3ViewStackItem*) Q3Memory_Allocate ( sizeof ( TQ3ViewStackItem ) ) ;
+			if ( instanceData.viewStackStorage == nullptr )
+				return kQ3Failure ;
+			}
 
+		instanceData.viewStack = instanceData.viewStackStorage ;
+		e3view_stack_initialise ( instanceData.viewStack ) ;
+		instanceData.isLocalToFrustumValid = false;
+		instanceData.isLocalToFrustumInverseValid = false;
+		}
 
 
-		// Adjust the reference counts of the shared objects. The Q3Memory_Copy will have
-		// have copied them without adjusting the reference counts, which is incorrect.
-		
-		E3Shared_Acquire ( &newTop->shaderIllumination,     oldTop->shaderIllumination ) ;
-		E3Shared_Acquire ( &newTop->shaderSurface,          oldTop->shaderSurface ) ;
-		E3Shared_Acquire ( &newTop->styleHighlight,         oldTop->styleHighlight ) ;
-		}
 
+	// Start a new frame
+	//
+	// The stack state represents renderer state that has been changed since the push.
+	TQ3ViewStackFrame& newFrame( instanceData.viewStackFrames[ instanceData.viewStackDepth ] );
+	newFrame.logStart   = instanceData.viewStackLogUsed ;
+	newFrame.savedState = kQ3ViewStateNone ;
+	newFrame.stackState = kQ3ViewStateNone ;
 
+	instanceData.viewStackDepth += 1 ;
 
 	return kQ3Success ;
 	}
@@ -681,6 +836,9 @@ e3view_stack_push ( E3View* view )
 //=============================================================================
 //      e3view_stack_pop : Pop the view state stack.
 //-----------------------------------------------------------------------------
+//		Note :	Restores the fields saved since the matching push, most
+//				recent first, so that the oldest saved value wins.
+//-----------------------------------------------------------------------------
 static void
 e3view_stack_pop ( E3View* view )
 	{
@@ -688,18 +846,32 @@ e3view_stack_pop ( E3View* view )
 	Q3_ASSERT_VALID_PTR(view);
 	TQ3ViewData& instanceData( view->instanceData );
 	Q3_REQUIRE(Q3_VALID_PTR(instanceData.viewStack));
+	Q3_ASSERT(instanceData.viewStackDepth != 0);
 
 
 
-	// Save the state mask for the topmost item
-	TQ3ViewStackState theStateToUpdate = instanceData.viewStack->stackState;
+	// Save the state mask for the topmost frame
+	instanceData.viewStackDepth -= 1 ;
+	const TQ3ViewStackFrame& theFrame( instanceData.viewStackFrames[ instanceData.viewStackDepth ] );
+	TQ3ViewStackState theStateToUpdate = theFrame.stackState;
 
 
 
-	// Dispose of the shared objects in the topmost item
-	Q3Object_CleanDispose ( & instanceData.viewStack->shaderIllumination );
-	Q3Object_CleanDispose ( & instanceData.viewStack->shaderSurface );
-	Q3Object_CleanDispose ( & instanceData.viewStack->styleHighlight );
+	// Restore the saved fields, releasing the current shared objects
+	while ( instanceData.viewStackLogUsed > theFrame.logStart )
+		{
+		TQ3Uns32 n ;
+		memcpy ( &n, instanceData.viewStackLog + instanceData.viewStackLogUsed - sizeof ( TQ3Uns32 ), sizeof ( TQ3Uns32 ) ) ;
+
+		const TQ3ViewStackField& theField( kViewStackFields[ n ] );
+		instanceData.viewStackLogUsed -= theField.fieldSize + sizeof ( TQ3Uns32 ) ;
+
+		TQ3Uns8* fieldData = ( (TQ3Uns8*) instanceData.viewStack ) + theField.fieldOffset ;
+		if ( theField.isShared )
+			Q3Object_CleanDispose ( (TQ3SharedObject*) fieldData ) ;
+
+		memcpy ( fieldData, instanceData.viewStackLog + instanceData.viewStackLogUsed, theField.fieldSize ) ;
+		}
 
 
 
@@ -709,28 +881,24 @@ e3view_stack_pop ( E3View* view )
 
 
 
-	// Shrink the stack, moving the top item to the free list
-	TQ3ViewStackItem* theItem = instanceData.viewStack;
-	instanceData.viewStack = theItem->next;
-	theItem->next = instanceData.viewStackFreeList;
-	instanceData.viewStackFreeList = theItem;
+	// If this was the first item, dispose of the shared objects and empty the stack
+	if ( instanceData.viewStackDepth == 0 )
+		{
+		Q3Object_CleanDispose ( & instanceData.viewStack->shaderIllumination );
+		Q3Object_CleanDispose ( & instanceData.viewStack->shaderSurface );
+		Q3Object_CleanDispose ( & instanceData.viewStack->styleHighlight );
+		instanceData.viewStack = nullptr ;
+		return ;
+		}
 
 
 
-	// Update the renderer, using the state of the previously top
-	// item as the mask indicating what's changed.
+	// Update the renderer, using the state of the popped frame
+	// as the mask indicating what's changed.
 	
 	// In so doing, the mask of changes to view state after the last push
-	// will be ORed with the mask of changes before the push.
-	
-	// One might think that the mask could be kept the same as before the
-	// push, since we are undoing those state changes.  However, with the
-	// current design, it is not quite possible, because the renderer state
-	// keeps pointers into the top of the view stack.
-	// Suppose, for instance, you push twice, then set a diffuse color, then
-	// pop twice.  On the first (inner) pop, the renderer state points at the color
-	// in the TQ3ViewStackItem created by the first (outer) push.  The second
-	// pop deletes that storage, so it had better update the renderer.
+	// will be ORed with the mask of changes before the push, so that an
+	// outer pop will also restore the renderer's state.
 	e3view_stack_update ( view, theStateToUpdate ) ;
 	}
 
@@ -1058,10 +1226,15 @@ e3view_submit_retained_pick ( TQ3ViewObject inView, TQ3Object theObject )
 		E3View_PickStack_SaveObject ( view, theObject ) ;
 	
 	
-	// Call the method
+	// Call the method, counting the geometries submitted by the application
 	TQ3Status qd3dStatus = kQ3Success ;
 	if ( theClass->submitPickMethod != nullptr )
+		{
+		if ( ( view->instanceData.pickDecomposeCount == 0 ) && theClass->IsType ( kQ3ShapeTypeGeometry ) )
+			view->instanceData.pickGeometryCount++ ;
+		
 		qd3dStatus = theClass->submitPickMethod ( view, theClass->GetType (), theObject, theObject->FindLeafInstanceData () ) ;
+		}
 
 
 	// Reset the current hit target. Not strictly necessary (since we
@@ -1256,10 +1429,15 @@ e3view_submit_immediate_pick ( TQ3ViewObject inView , TQ3ObjectType objectType ,
 	if ( view->instanceData.pickDecomposeCount == 0 )
 		E3View_PickStack_SaveObject ( view, nullptr ) ;
 
-	// Call the method
+	// Call the method, counting the geometries submitted by the application
 	TQ3Status qd3dStatus ;
 	if ( theClass->submitPickMethod != nullptr )
+		{
+		if ( ( view->instanceData.pickDecomposeCount == 0 ) && theClass->IsType ( kQ3ShapeTypeGeometry ) )
+			view->instanceData.pickGeometryCount++ ;
+		
 		qd3dStatus = theClass->submitPickMethod ( view, objectType, nullptr, objectData ) ;
+		}
 	else
 		qd3dStatus = kQ3Success ;
 		
@@ -1588,6 +1766,7 @@ e3view_pick_begin ( E3View* view, TQ3PickObject thePick )
 	Q3Memory_Clear(& view->instanceData.pickedPath, sizeof( view->instanceData.pickedPath)); 
 	view->instanceData.pickedObject       = nullptr;
 	view->instanceData.pickDecomposeCount = 0;
+	view->instanceData.pickGeometryCount  = 0;
 
 
 
@@ -1778,6 +1957,7 @@ e3view_new(TQ3Object theObject, void *privateData, const void *paramData)
 	instanceData->submitRetainedMethod  = (TQ3XViewSubmitRetainedMethod) e3view_submit_retained_error;
 	instanceData->submitImmediateMethod = (TQ3XViewSubmitImmediateMethod) e3view_submit_immediate_error;
 	instanceData->allowGroupCulling = kQ3True;
+	instanceData->allowAutomaticGroupCulling = kQ3False;
 	
 	instanceData->viewAttributes = Q3AttributeSet_New();
 	if (instanceData->viewAttributes != nullptr)
@@ -1841,13 +2021,10 @@ e3view_delete ( TQ3ViewObject view, void *privateData )
 
 	e3view_stack_pop_clean ( (E3View*) view ) ;
 	
-	// Clear the free list
-	while (instanceData->viewStackFreeList != nullptr)
-	{
-		TQ3ViewStackItem* topItem = instanceData->viewStackFreeList;
-		instanceData->viewStackFreeList = instanceData->viewStackFreeList->next;
-		Q3Memory_Free( &topItem );
-	}
+	// Free the stack storage
+	Q3Memory_Free( &instanceData->viewStackStorage );
+	Q3Memory_Free( &instanceData->viewStackFrames );
+	Q3Memory_Free( &instanceData->viewStackLog );
 }
 
 
@@ -2406,6 +2583,25 @@ E3View_GetRayThroughPickPoint(TQ3ViewObject theView, TQ3Ray3D *theRay)
 
 
 
+//=============================================================================
+//      E3View_GetPickGeometryCount : Get the number of geometries picked.
+//-----------------------------------------------------------------------------
+//		Note :	Used to measure how many geometry pick methods were invoked in
+//				the current or most recent picking loop, counting each
+//				geometry submitted by the application once per pass, but not
+//				the geometries it decomposes into.
+//-----------------------------------------------------------------------------
+TQ3Uns32
+E3View_GetPickGeometryCount(TQ3ViewObject theView)
+	{
+	// Return the count
+	return ( (E3View*) theView )->instanceData.pickGeometryCount ;
+	}
+
+
+
+
+
 //=============================================================================
 //      E3View_UpdateBounds : Incorporate vertices into the bounds.
 //-----------------------------------------------------------------------------
@@ -2902,20 +3098,32 @@ E3View_State_SetMatrix(TQ3ViewObject			theView,
 
 
 
-	// Set the matrices which have changed
+	// Save the matrices which will change
 	TQ3ViewStackState stateChange = kQ3ViewStateNone;
 	
+	if (theState & kQ3MatrixStateLocalToWorld)
+		stateChange |= kQ3ViewStateMatrixLocalToWorld;
+	
+	if (theState & kQ3MatrixStateWorldToCamera)
+		stateChange |= kQ3ViewStateMatrixWorldToCamera;
+	
+	if (theState & kQ3MatrixStateCameraToFrustum)
+		stateChange |= kQ3ViewStateMatrixCameraToFrustum;
+	
+	e3view_stack_save ( (E3View*) theView, stateChange ) ;
+
+
+
+	// Set the matrices which have changed
 	if (theState & kQ3MatrixStateLocalToWorld)
 		{
 		Q3_ASSERT(Q3_VALID_PTR(localToWorld));
-		stateChange                                 |= kQ3ViewStateMatrixLocalToWorld;
 		instanceData.viewStack->matrixLocalToWorld = *localToWorld;
 		}
 	
 	if (theState & kQ3MatrixStateWorldToCamera)
 		{
 		Q3_ASSERT(Q3_VALID_PTR(worldToCamera));
-		stateChange                                  |= kQ3ViewStateMatrixWorldToCamera;
 		Q3_ASSERT( isfinite( worldToCamera->value[0][0] ) );
 		instanceData.viewStack->matrixWorldToCamera = *worldToCamera;
 		}
@@ -2928,7 +3136,6 @@ E3View_State_SetMatrix(TQ3ViewObject			theView,
 	
 	if (theState & kQ3MatrixStateCameraToFrustum)
 	{
-		stateChange                                    |= kQ3ViewStateMatrixCameraToFrustum;
 		instanceData.viewStack->hasMatrixCameraToFrustum = (TQ3Boolean)(cameraToFrustum != nullptr);
 		if (cameraToFrustum != nullptr)
 		{
@@ -2970,6 +3177,7 @@ E3View_State_SetShaderIllumination(TQ3ViewObject theView, const TQ3IlluminationS
 
 
 	// Set the value
+	e3view_stack_save ( (E3View*) theView, kQ3ViewStateShaderIllumination ) ;
 	E3Shared_Replace ( & ( (E3View*) theView )->instanceData.viewStack->shaderIllumination, theData ) ;
 
 
@@ -2997,6 +3205,7 @@ E3View_State_SetShaderSurface(	TQ3ViewObject theView, const TQ3SurfaceShaderObje
 	if ( ( (E3View*) theView )->instanceData.viewStack->shaderSurface != theData )
 		{
 		// Set the value
+		e3view_stack_save ( (E3View*) theView, kQ3ViewStateShaderSurface ) ;
 		E3Shared_Replace ( & ( (E3View*) theView )->instanceData.viewStack->shaderSurface, theData ) ;
 
 
@@ -3025,6 +3234,7 @@ E3View_State_SetStyleSubdivision(TQ3ViewObject theView, const TQ3SubdivisionStyl
 
 
 	// Set the value
+	e3view_stack_save ( (E3View*) theView, kQ3ViewStateStyleSubdivision ) ;
 	( (E3View*) theView )->instanceData.viewStack->styleSubdivision = *theData ;
 
 
@@ -3055,6 +3265,7 @@ E3View_State_SetStylePickID(TQ3ViewObject theView, TQ3Uns32 pickID)
 
 
 	// Set the value
+	e3view_stack_save ( (E3View*) theView, kQ3ViewStateStylePickID ) ;
 	( (E3View*) theView )->instanceData.viewStack->stylePickID = pickID ;
 
 
@@ -3079,6 +3290,7 @@ E3View_State_SetStylePickParts(TQ3ViewObject theView, TQ3PickParts pickParts)
 
 
 	// Set the value
+	e3view_stack_save ( (E3View*) theView, kQ3ViewStateStylePickParts ) ;
 	( (E3View*) theView )->instanceData.viewStack->stylePickParts = pickParts ;
 
 
@@ -3103,6 +3315,7 @@ E3View_State_SetStyleCastShadows(TQ3ViewObject theView, TQ3Boolean castShadows)
 
 
 	// Set the value
+	e3view_stack_save ( (E3View*) theView, kQ3ViewStateStyleCastShadows ) ;
 	( (E3View*) theView )->instanceData.viewStack->styleCastShadows = castShadows ;
 
 
@@ -3127,6 +3340,7 @@ E3View_State_SetStyleReceiveShadows(TQ3ViewObject theView, TQ3Boolean receiveSha
 
 
 	// Set the value
+	e3view_stack_save ( (E3View*) theView, kQ3ViewStateStyleReceiveShadows ) ;
 	( (E3View*) theView )->instanceData.viewStack->styleReceiveShadows = receiveShadows;
 
 
@@ -3153,6 +3367,7 @@ E3View_State_SetStyleFill(TQ3ViewObject theView, TQ3FillStyle fillStyle)
 	if ( ( (E3View*) theView )->instanceData.viewStack->styleFill != fillStyle )
 		{
 		// Set the value
+		e3view_stack_save ( (E3View*) theView, kQ3ViewStateStyleFill ) ;
 		( (E3View*) theView )->instanceData.viewStack->styleFill = fillStyle ;
 
 
@@ -3180,6 +3395,7 @@ E3View_State_SetStyleBackfacing(TQ3ViewObject theView, TQ3BackfacingStyle backfa
 	if ( ( (E3View*) theView )->instanceData.viewStack->styleBackfacing != backfacingStyle )
 		{
 		// Set the value
+		e3view_stack_save ( (E3View*) theView, kQ3ViewStateStyleBackfacing ) ;
 		( (E3View*) theView )->instanceData.viewStack->styleBackfacing = backfacingStyle ;
 
 
@@ -3207,6 +3423,7 @@ E3View_State_SetStyleInterpolation(TQ3ViewObject theView, TQ3InterpolationStyle
 	if ( ( (E3View*) theView )->instanceData.viewStack->styleInterpolation != interpolationStyle )
 		{
 		// Set the value
+		e3view_stack_save ( (E3View*) theView, kQ3ViewStateStyleInterpolation ) ;
 		( (E3View*) theView )->instanceData.viewStack->styleInterpolation = interpolationStyle ;
 
 
@@ -3232,6 +3449,7 @@ E3View_State_SetStyleHighlight(TQ3ViewObject theView, TQ3AttributeSet highlightA
 
 
 	// Set the value
+	e3view_stack_save ( (E3View*) theView, kQ3ViewStateStyleHighlight ) ;
 	E3Shared_Replace ( & ( (E3View*) theView )->instanceData.viewStack->styleHighlight, highlightAttribute ) ;
 
 
@@ -3258,6 +3476,7 @@ E3View_State_SetStyleOrientation(TQ3ViewObject theView, TQ3OrientationStyle fron
 	if ( ( (E3View*) theView )->instanceData.viewStack->styleOrientation != frontFacingDirection )
 		{
 		// Set the value
+		e3view_stack_save ( (E3View*) theView, kQ3ViewStateStyleOrientation ) ;
 		( (E3View*) theView )->instanceData.viewStack->styleOrientation = frontFacingDirection ;
 
 
@@ -3288,6 +3507,7 @@ E3View_State_SetStyleAntiAlias(TQ3ViewObject theView, const TQ3AntiAliasStyleDat
 	// so we can avoid updating the renderer if the style state does not change.
 	if ( memcmp ( & ( (E3View*) theView )->instanceData.viewStack->styleAntiAlias, theData, sizeof ( TQ3AntiAliasStyleData ) ) != 0 )
 		{
+		e3view_stack_save ( (E3View*) theView, kQ3ViewStateStyleAntiAlias ) ;
 		( (E3View*) theView )->instanceData.viewStack->styleAntiAlias = *theData ;
 		e3view_stack_update ( (E3View*) theView, kQ3ViewStateStyleAntiAlias ) ;
 		}
@@ -3342,6 +3562,7 @@ E3View_State_SetStyleFog(TQ3ViewObject theView, const TQ3FogStyleData *theData,
 	if ( memcmp( & stackTop->styleFogExtended, &fogExtended,
 		sizeof( TQ3FogStyleExtendedData ) ) != 0 )
 	{
+		e3view_stack_save ( (E3View*) theView, kQ3ViewStateStyleFog ) ;
 		stackTop->styleFogExtended = fogExtended;
 		
 		e3view_stack_update( (E3View*) theView, kQ3ViewStateStyleFog ) ;
@@ -3364,6 +3585,7 @@ E3View_State_SetStyleLineWidth(TQ3ViewObject theView, float inWidth)
 
 
 	// Set the value
+	e3view_stack_save ( (E3View*) theView, kQ3ViewStateStyleLineWidth ) ;
 	( (E3View*) theView )->instanceData.viewStack->styleLineWidth = inWidth;
 
 
@@ -3388,6 +3610,7 @@ E3View_State_SetAttributeSurfaceUV(TQ3ViewObject theView, const TQ3Param2D *theD
 
 
 	// Set the value
+	e3view_stack_save ( (E3View*) theView, kQ3ViewStateAttributeSurfaceUV ) ;
 	( (E3View*) theView )->instanceData.viewStack->attributeSurfaceUV = *theData ;
 
 
@@ -3412,6 +3635,7 @@ E3View_State_SetAttributeShadingUV(TQ3ViewObject theView, const TQ3Param2D *theD
 
 
 	// Set the value
+	e3view_stack_save ( (E3View*) theView, kQ3ViewStateAttributeShadingUV ) ;
 	( (E3View*) theView )->instanceData.viewStack->attributeShadingUV = *theData ;
 
 
@@ -3436,6 +3660,7 @@ E3View_State_SetAttributeNormal(TQ3ViewObject theView, const TQ3Vector3D *theDat
 
 
 	// Set the value
+	e3view_stack_save ( (E3View*) theView, kQ3ViewStateAttributeNormal ) ;
 	( (E3View*) theView )->instanceData.viewStack->attributeNormal = *theData ;
 
 
@@ -3460,6 +3685,7 @@ E3View_State_SetAttributeAmbientCoefficient(TQ3ViewObject theView, const float *
 
 
 	// Set the value
+	e3view_stack_save ( (E3View*) theView, kQ3ViewStateAttributeAmbientCoefficient ) ;
 	( (E3View*) theView )->instanceData.viewStack->attributeAmbientCoefficient = *theData ;
 
 
@@ -3484,6 +3710,7 @@ E3View_State_SetAttributeDiffuseColor(TQ3ViewObject theView, const TQ3ColorRGB *
 
 
 	// Set the value
+	e3view_stack_save ( (E3View*) theView, kQ3ViewStateAttributeDiffuseColour ) ;
 	( (E3View*) theView )->instanceData.viewStack->attributeDiffuseColor = *theData ;
 
 
@@ -3508,6 +3735,7 @@ E3View_State_SetAttributeSpecularColor(TQ3ViewObject theView, const TQ3ColorRGB
 
 
 	// Set the value
+	e3view_stack_save ( (E3View*) theView, kQ3ViewStateAttributeSpecularColour ) ;
 	( (E3View*) theView )->instanceData.viewStack->attributeSpecularColor = *theData ;
 
 
@@ -3532,6 +3760,7 @@ E3View_State_SetAttributeSpecularControl(TQ3ViewObject theView, const float *the
 
 
 	// Set the value
+	e3view_stack_save ( (E3View*) theView, kQ3ViewStateAttributeSpecularControl ) ;
 	( (E3View*) theView )->instanceData.viewStack->attributeSpecularControl = *theData ;
 
 
@@ -3556,6 +3785,7 @@ E3View_State_SetAttributeMetallic(TQ3ViewObject theView, const float *theData)
 
 
 	// Set the value
+	e3view_stack_save ( (E3View*) theView, kQ3ViewStateAttributeMetallic ) ;
 	( (E3View*) theView )->instanceData.viewStack->attributeMetallic = *theData ;
 
 
@@ -3580,6 +3810,7 @@ E3View_State_SetAttributeTransparencyColor(TQ3ViewObject theView, const TQ3Color
 
 
 	// Set the value
+	e3view_stack_save ( (E3View*) theView, kQ3ViewStateAttributeTransparencyColour ) ;
 	( (E3View*) theView )->instanceData.viewStack->attributeTransparencyColor = *theData ;
 
 
@@ -3604,6 +3835,7 @@ E3View_State_SetAttributeEmissiveColor(TQ3ViewObject theView, const TQ3ColorRGB
 
 
 	// Set the value
+	e3view_stack_save ( (E3View*) theView, kQ3ViewStateAttributeEmissiveColor ) ;
 	( (E3View*) theView )->instanceData.viewStack->attributeEmissiveColor = *theData ;
 
 
@@ -3628,6 +3860,7 @@ E3View_State_SetAttributeSurfaceTangent(TQ3ViewObject theView, const TQ3Tangent2
 
 
 	// Set the value
+	e3view_stack_save ( (E3View*) theView, kQ3ViewStateAttributeSurfaceTangent ) ;
 	( (E3View*) theView )->instanceData.viewStack->attributeSurfaceTangent = *theData ;
 
 
@@ -3652,6 +3885,7 @@ E3View_State_SetAttributeHighlightState(TQ3ViewObject theView, const TQ3Switch *
 
 
 	// Set the value
+	e3view_stack_save ( (E3View*) theView, kQ3ViewStateAttributeHighlightState ) ;
 	( (E3View*) theView )->instanceData.viewStack->attributeHighlightState = *theData ;
 
 
@@ -3676,6 +3910,7 @@ E3View_State_SetAttributeSurfaceShader(TQ3ViewObject theView, const TQ3SurfaceSh
 
 
 	// Set the value
+	e3view_stack_save ( (E3View*) theView, kQ3ViewStateShaderSurface ) ;
 	E3Shared_Replace ( & ( (E3View*) theView )->instanceData.viewStack->shaderSurface, *theData ) ;
 
 
@@ -4652,6 +4887,36 @@ E3View_IsGroupCullingAllowed( TQ3ViewObject theView )
 
 
 
+//=============================================================================
+//      E3View_AllowAutomaticGroupCulling : Set automatic group culling
+//				behaviour.
+//-----------------------------------------------------------------------------
+TQ3Status
+E3View_AllowAutomaticGroupCulling( TQ3ViewObject theView, TQ3Boolean allowCulling )
+{
+	( (E3View*) theView )->instanceData.allowAutomaticGroupCulling = allowCulling;
+
+	return kQ3Success;
+}
+
+
+
+
+
+//=============================================================================
+//      E3View_IsAutomaticGroupCullingAllowed : Access automatic group
+//				culling state.
+//-----------------------------------------------------------------------------
+TQ3Boolean
+E3View_IsAutomaticGroupCullingAllowed( TQ3ViewObject theView )
+{
+	return ( (E3View*) theView )->instanceData.allowAutomaticGroupCulling;
+}
+
+
+
+
+
 //=============================================================================
 //      E3View_TransformLocalToWorld : Transform a point from local->world.
 //-----------------------------------------------------------------------------
@@ -120,6 +120,7 @@ TQ3ViewMode				E3View_GetViewMode(TQ3ViewObject theView);
 TQ3ViewState			E3View_GetViewState(TQ3ViewObject theView);
 TQ3BoundingMethod		E3View_GetBoundingMethod(TQ3ViewObject theView);
 void					E3View_GetRayThroughPickPoint(TQ3ViewObject theView, TQ3Ray3D *theRay);
+TQ3Uns32				E3View_GetPickGeometryCount(TQ3ViewObject theView);
 void					E3View_UpdateBounds(TQ3ViewObject theView, TQ3Uns32 numPoints, TQ3Uns32 pointStride, const TQ3Point3D *thePoints);
 TQ3Status				E3View_PickStack_PushGroup(TQ3ViewObject theView, TQ3GroupObject theGroup);
 TQ3HitPath				*E3View_PickStack_GetPickedPath(TQ3ViewObject theView);
@@ -201,6 +202,8 @@ TQ3Status				E3View_SetEndFrameMethod(TQ3ViewObject theView, TQ3ViewEndFrameMeth
 TQ3Boolean				E3View_IsBoundingBoxVisible(TQ3ViewObject theView, const TQ3BoundingBox *theBBox);
 TQ3Status				E3View_AllowAllGroupCulling(TQ3ViewObject theView, TQ3Boolean allowCulling);
 TQ3Boolean				E3View_IsGroupCullingAllowed( TQ3ViewObject theView );
+TQ3Status				E3View_AllowAutomaticGroupCulling( TQ3ViewObject theView, TQ3Boolean allowCulling );
+TQ3Boolean				E3View_IsAutomaticGroupCullingAllowed( TQ3ViewObject theView );
 TQ3Status				E3View_TransformLocalToWorld(TQ3ViewObject theView, const TQ3Point3D *localPoint, TQ3Point3D *worldPoint);
 TQ3Status				E3View_TransformLocalToWindow(TQ3ViewObject theView, const TQ3Point3D *localPoint, TQ3Point2D *windowPoint);
 TQ3Status				E3View_TransformLocalToFrustum(TQ3ViewObject theView, const TQ3Point3D *localPoint, TQ3Point3D *frustumPoint);
@@ -48,6 +48,8 @@
 #include "E3IOFileFormat.h"
 #include "E3FFR_3DMF.h"
 #include "E3View.h"
+#include "E3Storage.h"
+#include "E3Utils.h"
 
 
 
@@ -419,6 +421,55 @@ E3FileFormat_GenericReadBinary_Raw(TQ3FileFormatObject format, unsigned char* da
 
 
 
+//=============================================================================
+//      e3fileformat_read_swapped_array : Reads and byte swaps an array.
+//-----------------------------------------------------------------------------
+//		Note :	If the storage can lend us its data, we swap directly from the
+//				storage into the caller's array, saving a copy. Otherwise we
+//				read the array with a single storage read and swap in place.
+//-----------------------------------------------------------------------------
+static TQ3Status
+e3fileformat_read_swapped_array(TQ3FileFormatObject format, TQ3Uns32 numNums,
+								TQ3Uns32 valueSize, void* data)
+{
+	TQ3FFormatBaseData*	instanceData = (TQ3FFormatBaseData *) format->FindLeafInstanceData ();
+	E3Storage*			theStorage   = (E3Storage*) instanceData->storage;
+	TQ3Uns32			length       = numNums * valueSize;
+	const TQ3Uns8*		srcData      = nullptr;
+	TQ3Status			result;
+
+
+
+	// Try and borrow the data from the storage
+	if ( theStorage->BorrowData( instanceData->currentStoragePosition, length, &srcData ) == kQ3Success )
+	{
+		instanceData->currentStoragePosition += length;
+		result = kQ3Success;
+	}
+	else
+	{
+		result = E3FileFormat_GenericReadBinary_Raw( format, (unsigned char*) data, length );
+		srcData = (const TQ3Uns8*) data;
+	}
+	
+	
+	
+	// Swap the data
+	if (result == kQ3Success)
+	{
+		if (valueSize == 2)
+			E3EndianSwapArray16( numNums, srcData, data );
+		else
+			E3EndianSwapArray32( numNums, srcData, data );
+	}
+	
+	return result;
+}
+
+
+
+
+
 //=============================================================================
 //      E3FileFormat_GenericReadBinSwap_16 : Reads 16 bits from storage,
 //											 swapping the byte order.
@@ -463,18 +514,7 @@ E3FileFormat_GenericReadBinSwap_32(TQ3FileFormatObject format, TQ3Int32* data)
 TQ3Status
 E3FileFormat_GenericReadBinSwapArray_16(TQ3FileFormatObject format, TQ3Uns32 numNums, TQ3Int16* data)
 {
-	TQ3Status result;
-	TQ3Uns32	n;
-	result = E3FileFormat_GenericReadBinary_Raw (format, (unsigned char*)data, numNums * 2);
-	
-	if (result == kQ3Success)
-	{
-		for (n = 0; n < numNums; ++n)
-		{
-			data[n] = E3EndianSwap16( data[n] );
-		}
-	}
-	return result;
+	return e3fileformat_read_swapped_array( format, numNums, 2, data );
 }
 
 
@@ -487,18 +527,7 @@ E3FileFormat_GenericReadBinSwapArray_16(TQ3FileFormatObject format, TQ3Uns32 num
 TQ3Status
 E3FileFormat_GenericReadBinSwapArray_32(TQ3FileFormatObject format, TQ3Uns32 numNums, TQ3Int32* data)
 {
-	TQ3Status result;
-	TQ3Uns32	n;
-	result = E3FileFormat_GenericReadBinary_Raw (format, (unsigned char*)data, numNums * 4);
-	
-	if (result == kQ3Success)
-	{
-		for (n = 0; n < numNums; ++n)
-		{
-			data[n] = E3EndianSwap32( data[n] );
-		}
-	}
-	return result;
+	return e3fileformat_read_swapped_array( format, numNums, 4, data );
 }
 
 
@@ -46,7 +46,7 @@
 //      Include files
 //-----------------------------------------------------------------------------
 #include "E3IOFileFormat.h"
-#include <map>
+#include <unordered_map>
 
 
 
@@ -101,7 +101,7 @@ typedef struct TQ33DMFWStackItem {
 	TQ3XDataDeleteMethod 			deleteData;
 } TQ33DMFWStackItem;
 
-typedef std::map< TQ3Object, TQ3Uns32 > TE3FFormatW3DMF_Map;
+typedef std::unordered_map< TQ3Object, TQ3Uns32 > TE3FFormatW3DMF_Map;
 
 typedef struct TE3FFormatW3DMF_Data {
 	TQ3FFormatBaseData				baseData;
@@ -113,7 +113,12 @@ typedef struct TE3FFormatW3DMF_Data {
 	TQ3Uns32						lastTocIndex;
 	// objects stack
 	TQ3Uns32						stackCount;
+	TQ3Uns32						stackCapacity;
 	TQ33DMFWStackItem				*stack;
+	// write buffer, flushed to the storage as it fills
+	TQ3Uns8							*writeBuffer;
+	TQ3Uns32						writeBufferStart;
+	TQ3Uns32						writeBufferUsed;
 } TE3FFormatW3DMF_Data;
 
 
@@ -48,6 +48,15 @@
 #include "E3IO.h"
 #include "E3IOData.h"
 #include "E3FFR_3DMF_Geometry.h"
+#include "E3Storage.h"
+#include "E3Parallel.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <vector>
 
 
 
@@ -90,6 +99,19 @@
 
 
 
+//=============================================================================
+//      Internal constants
+//-----------------------------------------------------------------------------
+// Initial size of the TOC lookup tables, which grow to fit the TOC
+#define kE3FFormat3DMFBinTOCTableSize						32
+
+// Position of the first object, after the file header
+#define kE3FFormat3DMFBinFirstObject						24
+
+
+
+
+
 //=============================================================================
 //      Internal types
 //-----------------------------------------------------------------------------
@@ -119,6 +141,50 @@ public :
 
 	TE3FFormat3DMF_Bin_Data					instanceData ;
 	} ;
+
+
+
+// A top-level object read ahead, along with any type objects before it and,
+// for a group, the objects up to its end group.  The TOC entries it owns are
+// those of the objects inside it, and it refers to entries owned by earlier
+// items.
+struct TE3FFormat3DMF_Bin_Item {
+	TQ3Uns32								start;
+	TQ3Uns32								end;
+	TQ3Uns32								typesBefore;
+	TQ3Uns32								typesAfter;
+	std::vector<TQ3Uns32>					owned;
+	std::vector<TQ3Uns32>					refs;
+	TQ3Object								object;
+};
+
+
+
+// The objects of a file read ahead on several threads
+struct TE3FFormat3DMF_Bin_Prefetch {
+	std::vector<TE3FFormat3DMF_Bin_Item>	items;
+	std::vector<TE3FFormat3DMF_TypeEntry>	types;
+	TQ3Uns32								nextItem;
+	TQ3Boolean								readInGroup;
+	
+	// The file, borrowed from the storage or copied
+	TQ3Uns8*								fileData;
+	TQ3Uns32								fileSize;
+	TQ3Uns8*								fileCopy;
+	
+	// For each TOC entry, the item which owns it, and its object and type
+	// once that item has been read
+	std::vector<TQ3Int32>					owner;
+	std::vector<TQ3Object>					objects;
+	std::vector<TQ3ObjectType>				objTypes;
+	
+	// Progress of the worker threads
+	std::atomic<TQ3Uns32>					nextToRead;
+	std::atomic<bool>						failed;
+	std::vector<TQ3Uns8>					isDone;
+	std::mutex								doneMutex;
+	std::condition_variable					doneCondition;
+};
 	
 
 
@@ -422,35 +488,39 @@ e3fformat_3dmf_bin_read_toc(TQ3FileFormatObject format)
 				return (kQ3Failure);
 
 			}
-		// read in the tocEntries
+		// read in the tocEntries, appending them to those of any previous TOC
+		TE3FFormat3DMF_TOCEntry* newEntries = &instanceData->MFData.toc->tocEntries[instanceData->MFData.toc->nEntries];
+		
 		if(tocEntryType == 0) // QD3D 1.0 3DMF
 			for(i = 0; i < nEntries;i++){
-				instanceData->MFData.toc->tocEntries[i].object = nullptr;
-				instanceData->MFData.toc->tocEntries[i].objType = 0;
+				newEntries[i].object = nullptr;
+				newEntries[i].objType = 0;
 				
-				status = int32Read(format, (TQ3Int32*)&instanceData->MFData.toc->tocEntries[i].refID);
+				status = int32Read(format, (TQ3Int32*)&newEntries[i].refID);
 				if(status == kQ3Success)
-					status = int64Read(format, (TQ3Int64*)&instanceData->MFData.toc->tocEntries[i].objLocation);
+					status = int64Read(format, (TQ3Int64*)&newEntries[i].objLocation);
 					
 				if(status != kQ3Success)
 					return status;
+				
+				instanceData->MFData.toc->nEntries++;
 			}
 			
 		if(tocEntryType == 1) // QD3D 1.5 3DMF
 			for(i = 0; i < nEntries;i++){
-				instanceData->MFData.toc->tocEntries[i].object = nullptr;
+				newEntries[i].object = nullptr;
 				
-				status = int32Read(format, (TQ3Int32*)&instanceData->MFData.toc->tocEntries[i].refID);
+				status = int32Read(format, (TQ3Int32*)&newEntries[i].refID);
 				if(status == kQ3Success)
-					status = int64Read(format, (TQ3Int64*)&instanceData->MFData.toc->tocEntries[i].objLocation);
+					status = int64Read(format, (TQ3Int64*)&newEntries[i].objLocation);
 				if(status == kQ3Success)
-					status = int32Read(format, &instanceData->MFData.toc->tocEntries[i].objType);
+					status = int32Read(format, &newEntries[i].objType);
 					
 				if(status != kQ3Success)
 					return status;
+				
+				instanceData->MFData.toc->nEntries++;
 			}
-			
-		instanceData->MFData.toc->nEntries += nEntries;
 		}
 	
 	if((instanceData->MFData.baseData.currentStoragePosition + 8) 
@@ -472,6 +542,102 @@ e3fformat_3dmf_bin_read_toc(TQ3FileFormatObject format)
 
 
 
+//=============================================================================
+//      e3fformat_3dmf_bin_index_toc : Build the TOC lookup tables.
+//-----------------------------------------------------------------------------
+//		Note :	Objects are looked up in the TOC by reference ID when resolving
+//				references, and by location whenever any object is read, so a
+//				linear search makes reading a database file quadratic.
+//
+//				The tables map keys to entry index + 1, since a hash table item
+//				can't be nullptr. Where a key is repeated the first entry wins,
+//				as it did with a linear search. Keys of zero can't be hashed,
+//				so they are left to the linear search in the lookup functions.
+//-----------------------------------------------------------------------------
+static TQ3Status
+e3fformat_3dmf_bin_index_toc(TE3FFormat3DMF_Bin_Data *instanceData)
+{
+	TE3FFormat3DMF_TOC*		toc = instanceData->MFData.toc;
+	TQ3ObjectType			theKey;
+	TQ3Uns32				i;
+
+
+
+	// Create the tables
+	if (toc == nullptr || toc->nEntries == 0)
+		return kQ3Success;
+
+	instanceData->tocByRefID    = E3HashTable_Create(kE3FFormat3DMFBinTOCTableSize);
+	instanceData->tocByLocation = E3HashTable_Create(kE3FFormat3DMFBinTOCTableSize);
+	if (instanceData->tocByRefID == nullptr || instanceData->tocByLocation == nullptr)
+		return kQ3Failure;
+
+	if (E3HashTable_Reserve(instanceData->tocByRefID,    toc->nEntries) != kQ3Success ||
+		E3HashTable_Reserve(instanceData->tocByLocation, toc->nEntries) != kQ3Success)
+		return kQ3Failure;
+
+
+
+	// Add the entries
+	for (i = 0; i < toc->nEntries; i++)
+		{
+		theKey = (TQ3ObjectType) toc->tocEntries[i].refID;
+		if (theKey != 0 && E3HashTable_Find(instanceData->tocByRefID, theKey) == nullptr)
+			E3HashTable_Add(instanceData->tocByRefID, theKey, (void *) (uintptr_t) (i + 1));
+
+		theKey = (TQ3ObjectType) toc->tocEntries[i].objLocation.lo;
+		if (theKey != 0 && E3HashTable_Find(instanceData->tocByLocation, theKey) == nullptr)
+			E3HashTable_Add(instanceData->tocByLocation, theKey, (void *) (uintptr_t) (i + 1));
+		}
+
+	return kQ3Success;
+}
+
+
+
+
+
+//=============================================================================
+//      e3fformat_3dmf_bin_find_toc_entry : Find a TOC entry by ID or location.
+//-----------------------------------------------------------------------------
+//		Note :	Returns the entry index, or -1 if there is no such entry.
+//-----------------------------------------------------------------------------
+static TQ3Int32
+e3fformat_3dmf_bin_find_toc_entry(TE3FFormat3DMF_Bin_Data *instanceData,
+									TQ3Boolean byRefID, TQ3Uns32 theValue)
+{
+	TE3FFormat3DMF_TOC*		toc = instanceData->MFData.toc;
+	E3HashTablePtr			theTable = byRefID ? instanceData->tocByRefID : instanceData->tocByLocation;
+	TQ3Uns32				i;
+
+
+
+	// Look up the entry in the table if we can
+	if (toc == nullptr)
+		return -1;
+	
+	if (theTable != nullptr && theValue != 0)
+		{
+		uintptr_t theIndex = (uintptr_t) E3HashTable_Find(theTable, (TQ3ObjectType) theValue);
+		return ((TQ3Int32) theIndex) - 1;
+		}
+
+
+
+	// Otherwise fall back to a linear search
+	for (i = 0; i < toc->nEntries; i++)
+		{
+		if (theValue == (byRefID ? toc->tocEntries[i].refID : toc->tocEntries[i].objLocation.lo))
+			return (TQ3Int32) i;
+		}
+
+	return -1;
+}
+
+
+
+
+
 //=============================================================================
 //      e3fformat_3dmf_bin_read_header : Initialize the reader.
 //-----------------------------------------------------------------------------
@@ -496,6 +662,10 @@ e3fformat_3dmf_bin_read_header ( TQ3FileObject inFile )
 	
 	instanceData->typesNum = 0;
 	instanceData->types = nullptr;
+	instanceData->tocByRefID = nullptr;
+	instanceData->tocByLocation = nullptr;
+	instanceData->prefetch = nullptr;
+	instanceData->prefetchTried = kQ3False;
 
 
 
@@ -529,9 +699,12 @@ e3fformat_3dmf_bin_read_header ( TQ3FileObject inFile )
 		{
 			instanceData->MFData.baseData.currentStoragePosition = tocPosition.lo;
 			result = (TQ3Status)(e3fformat_3dmf_bin_read_toc(format) != kQ3Failure);
+			
+			if (result == kQ3Success)
+				result = e3fformat_3dmf_bin_index_toc(instanceData);
 		}
 		
-		instanceData->MFData.baseData.currentStoragePosition = 24;// reset the file mark
+		instanceData->MFData.baseData.currentStoragePosition = kE3FFormat3DMFBinFirstObject;// reset the file mark
 	
 		E3FFormat_3DMF_Bin_Check_MoreObjects(instanceData);
 	}
@@ -662,6 +835,693 @@ static void CopyElementsToShape( TQ3SetObject inSet, TQ3ShapeObject ioShape )
 
 
 
+//=============================================================================
+//      e3fformat_3dmf_bin_prefetch_dispose : Dispose of the objects read ahead.
+//-----------------------------------------------------------------------------
+static void
+e3fformat_3dmf_bin_prefetch_dispose(TE3FFormat3DMF_Bin_Data *instanceData)
+{
+	TE3FFormat3DMF_Bin_Prefetch*	prefetch = instanceData->prefetch;
+
+
+
+	// Release the objects which haven't been handed out
+	if (prefetch == nullptr)
+		return;
+
+	for (TE3FFormat3DMF_Bin_Item& theItem : prefetch->items)
+		Q3Object_CleanDispose(&theItem.object);
+
+	for (TQ3Object& theObject : prefetch->objects)
+		Q3Object_CleanDispose(&theObject);
+
+	if (prefetch->fileCopy != nullptr)
+		Q3Memory_Free(&prefetch->fileCopy);
+
+	delete prefetch;
+	instanceData->prefetch = nullptr;
+}
+
+
+
+
+
+//=============================================================================
+//      e3fformat_3dmf_bin_peek_header : Read the header of an object.
+//-----------------------------------------------------------------------------
+//		Note :	Leaves the position after the header.
+//-----------------------------------------------------------------------------
+static TQ3Status
+e3fformat_3dmf_bin_peek_header(TQ3FileFormatObject format, TQ3Uns32 thePosition,
+								TQ3Uns32 theLimit, TQ3ObjectType *objectType, TQ3Uns32 *objectSize)
+{
+	TE3FFormat3DMF_Bin_Data*	instanceData = e3read_3dmf_bin_getinstancedata(format);
+	TQ3XFFormatInt32ReadMethod	int32Read = (TQ3XFFormatInt32ReadMethod) format->GetMethod ( kQ3XMethodTypeFFormatInt32Read ) ;
+
+
+
+	// Read the type and size, and check the object fits
+	if (thePosition + 8 > theLimit)
+		return kQ3Failure;
+
+	instanceData->MFData.baseData.currentStoragePosition = thePosition;
+	if (int32Read(format, (TQ3Int32 *) objectType) != kQ3Success ||
+		int32Read(format, (TQ3Int32 *) objectSize) != kQ3Success)
+		return kQ3Failure;
+
+	if (*objectSize > theLimit - thePosition - 8)
+		return kQ3Failure;
+
+	return kQ3Success;
+}
+
+
+
+
+
+//=============================================================================
+//      e3fformat_3dmf_bin_scan_object : Find the TOC entries an object owns
+//				and refers to.
+//-----------------------------------------------------------------------------
+//		Note :	Fails for anything the parallel reader can't handle in the
+//				same way as the sequential reader: a reference to an object
+//				which hasn't been seen yet, or a type object inside another
+//				object.
+//-----------------------------------------------------------------------------
+static TQ3Status
+e3fformat_3dmf_bin_scan_object(TQ3FileFormatObject format, TQ3Uns32 itemIndex,
+								TE3FFormat3DMF_Bin_Item& theItem, TQ3Uns32 thePosition,
+								TQ3Uns32 theLimit, TQ3ObjectType *objectType, TQ3Uns32 *nextPosition)
+{
+	TE3FFormat3DMF_Bin_Data*		instanceData = e3read_3dmf_bin_getinstancedata(format);
+	TE3FFormat3DMF_Bin_Prefetch*	prefetch     = instanceData->prefetch;
+	TQ3XFFormatInt32ReadMethod		int32Read    = (TQ3XFFormatInt32ReadMethod) format->GetMethod ( kQ3XMethodTypeFFormatInt32Read ) ;
+	TQ3Uns32						objectSize;
+	TQ3Uns32						refID;
+	TQ3Int32						entryIndex;
+
+
+
+	// Read the header
+	if (e3fformat_3dmf_bin_peek_header(format, thePosition, theLimit, objectType, &objectSize) != kQ3Success)
+		return kQ3Failure;
+
+	*nextPosition = thePosition + 8 + objectSize;
+
+
+
+	// Record the entries
+	switch (*objectType) {
+		case 0x7266726E: /* rfrn - Reference */
+			if (objectSize < 4 || int32Read(format, (TQ3Int32 *) &refID) != kQ3Success)
+				return kQ3Failure;
+			
+			entryIndex = e3fformat_3dmf_bin_find_toc_entry(instanceData, kQ3True, refID);
+			if (entryIndex >= 0)
+				{
+				if (prefetch->owner[entryIndex] < 0)
+					return kQ3Failure;
+				
+				if (prefetch->owner[entryIndex] != (TQ3Int32) itemIndex)
+					theItem.refs.push_back((TQ3Uns32) entryIndex);
+				}
+			break;
+
+		case 0x74797065: /* type - Type */
+			return kQ3Failure;
+
+		default:
+			entryIndex = e3fformat_3dmf_bin_find_toc_entry(instanceData, kQ3False, thePosition);
+			if (entryIndex >= 0)
+				{
+				if (prefetch->owner[entryIndex] >= 0)
+					return kQ3Failure;
+				
+				prefetch->owner[entryIndex] = (TQ3Int32) itemIndex;
+				theItem.owned.push_back((TQ3Uns32) entryIndex);
+				}
+			
+			if (*objectType == 0x636E7472 /* cntr - Container */ ||
+				*objectType == 0x62676E67 /* bgng - BeginGroup */)
+				{
+				for (TQ3Uns32 childPosition = thePosition + 8; childPosition + 8 <= *nextPosition; )
+					{
+					TQ3ObjectType	childType;
+					
+					if (e3fformat_3dmf_bin_scan_object(format, itemIndex, theItem, childPosition,
+														*nextPosition, &childType, &childPosition) != kQ3Success)
+						return kQ3Failure;
+					}
+				}
+			break;
+		}
+	
+	return kQ3Success;
+}
+
+
+
+
+
+//=============================================================================
+//      e3fformat_3dmf_bin_scan_types : Collect the type objects at a position.
+//-----------------------------------------------------------------------------
+static TQ3Status
+e3fformat_3dmf_bin_scan_types(E3File *theFile, TQ3Uns32 *thePosition)
+{
+	TQ3FileFormatObject				format       = theFile->GetFileFormat();
+	TE3FFormat3DMF_Bin_Data*		instanceData = e3read_3dmf_bin_getinstancedata(format);
+	TE3FFormat3DMF_Bin_Prefetch*	prefetch     = instanceData->prefetch;
+	TQ3Uns32						theLimit     = instanceData->MFData.baseData.logicalEOF;
+	TQ3ObjectType					objectType;
+	TQ3Uns32						objectSize;
+
+
+
+	// Read the type objects as the sequential reader would, up to the next
+	// object, which there must be
+	for (;;)
+		{
+		if (e3fformat_3dmf_bin_peek_header(format, *thePosition, theLimit, &objectType, &objectSize) != kQ3Success)
+			return kQ3Failure;
+		
+		if (objectType != 0x74797065 /* type - Type */)
+			break;
+		
+		TE3FFormat3DMF_TypeEntry	theEntry;
+		TQ3Uns32					nameLength = kQ3StringMaximumLength;
+		Q3Int32_Read(&theEntry.typeID, theFile);
+		Q3String_Read(theEntry.typeName, &nameLength, theFile);
+		prefetch->types.push_back(theEntry);
+		
+		*thePosition += 8 + objectSize;
+		}
+	
+	return kQ3Success;
+}
+
+
+
+
+
+//=============================================================================
+//      e3fformat_3dmf_bin_scan_is_group : Is the root of a begin group a
+//				group?
+//-----------------------------------------------------------------------------
+static TQ3Boolean
+e3fformat_3dmf_bin_scan_is_group(TQ3FileFormatObject format, TQ3Uns32 thePosition)
+{
+	TE3FFormat3DMF_Bin_Data*		instanceData = e3read_3dmf_bin_getinstancedata(format);
+	TE3FFormat3DMF_Bin_Prefetch*	prefetch     = instanceData->prefetch;
+	E3ClassInfoPtr					theClass     = nullptr;
+	TQ3ObjectType					objectType;
+	TQ3Uns32						objectSize;
+
+
+
+	// Find the class of the root object, as the sequential reader would
+	if (e3fformat_3dmf_bin_peek_header(format, thePosition, instanceData->MFData.baseData.logicalEOF, &objectType, &objectSize) != kQ3Success ||
+		e3fformat_3dmf_bin_peek_header(format, thePosition + 8, thePosition + 8 + objectSize, &objectType, &objectSize) != kQ3Success)
+		return kQ3False;
+
+	if (objectType < 0)
+		{
+		for (const TE3FFormat3DMF_TypeEntry& theEntry : prefetch->types)
+			{
+			if (theEntry.typeID == (TQ3Int32) objectType)
+				{
+				theClass = E3ClassTree::GetClass ( theEntry.typeName ) ;
+				break;
+				}
+			}
+		}
+	else if (objectType != 0x7266726E /* rfrn - Reference */)
+		theClass = E3ClassTree::GetClass ( objectType ) ;
+	
+	return (TQ3Boolean) (theClass != nullptr && theClass->IsType ( kQ3ShapeTypeGroup ));
+}
+
+
+
+
+
+//=============================================================================
+//      e3fformat_3dmf_bin_scan : Split the file into items.
+//-----------------------------------------------------------------------------
+//		Note :	Walks the object headers from the first object, without
+//				reading any objects, in the order the sequential reader
+//				would meet them.
+//-----------------------------------------------------------------------------
+static TQ3Status
+e3fformat_3dmf_bin_scan(E3File *theFile)
+{
+	TQ3FileFormatObject				format       = theFile->GetFileFormat();
+	TE3FFormat3DMF_Bin_Data*		instanceData = e3read_3dmf_bin_getinstancedata(format);
+	TE3FFormat3DMF_Bin_Prefetch*	prefetch     = instanceData->prefetch;
+	TQ3Uns32						theLimit     = instanceData->MFData.baseData.logicalEOF;
+	TQ3Uns32						thePosition  = kE3FFormat3DMFBinFirstObject;
+	TQ3ObjectType					objectType;
+
+
+
+	// Walk the top-level objects
+	while (thePosition + 8 <= theLimit)
+		{
+		TQ3Uns32	itemIndex = (TQ3Uns32) prefetch->items.size();
+		prefetch->items.push_back(TE3FFormat3DMF_Bin_Item());
+		
+		TE3FFormat3DMF_Bin_Item& theItem = prefetch->items.back();
+		theItem.start       = thePosition;
+		theItem.typesBefore = (TQ3Uns32) prefetch->types.size();
+		theItem.object      = nullptr;
+		
+		if (e3fformat_3dmf_bin_scan_types(theFile, &thePosition) != kQ3Success)
+			return kQ3Failure;
+		
+		TQ3Uns32 objectPosition = thePosition;
+		if (e3fformat_3dmf_bin_scan_object(format, itemIndex, theItem, objectPosition,
+											theLimit, &objectType, &thePosition) != kQ3Success)
+			return kQ3Failure;
+
+
+
+		// A group is read along with the objects up to its end group
+		if (objectType == 0x62676E67 /* bgng - BeginGroup */ &&
+			prefetch->readInGroup == kQ3True &&
+			e3fformat_3dmf_bin_scan_is_group(format, objectPosition))
+			{
+			TQ3Uns32 groupDepth = 1;
+			
+			while (groupDepth != 0 && thePosition + 8 <= theLimit)
+				{
+				if (e3fformat_3dmf_bin_scan_types(theFile, &thePosition) != kQ3Success)
+					return kQ3Failure;
+				
+				objectPosition = thePosition;
+				if (e3fformat_3dmf_bin_scan_object(format, itemIndex, theItem, objectPosition,
+													theLimit, &objectType, &thePosition) != kQ3Success)
+					return kQ3Failure;
+				
+				if (objectType == kQ3SharedTypeEndGroup)
+					groupDepth--;
+				
+				else if (objectType == 0x62676E67 /* bgng - BeginGroup */ &&
+						 e3fformat_3dmf_bin_scan_is_group(format, objectPosition))
+					groupDepth++;
+				}
+			}
+		
+		theItem.end        = thePosition;
+		theItem.typesAfter = (TQ3Uns32) prefetch->types.size();
+		
+		std::sort(theItem.refs.begin(), theItem.refs.end());
+		theItem.refs.erase(std::unique(theItem.refs.begin(), theItem.refs.end()), theItem.refs.end());
+		}
+	
+	return kQ3Success;
+}
+
+
+
+
+
+//=============================================================================
+//      e3fformat_3dmf_bin_new_worker : Open a file for a worker thread.
+//-----------------------------------------------------------------------------
+//		Note :	The file reads from the data of the original file, which
+//				outlives it and is not changed while it is read.
+//-----------------------------------------------------------------------------
+static TQ3FileObject
+e3fformat_3dmf_bin_new_worker(TE3FFormat3DMF_Bin_Prefetch *prefetch)
+{
+	TQ3StorageObject	theStorage;
+	TQ3FileObject		theFile;
+
+
+
+	// Open a file on the data
+	theStorage = E3MemoryStorage_NewBuffer(prefetch->fileData, prefetch->fileSize, prefetch->fileSize);
+	theFile    = E3File_New();
+	
+	if (theStorage == nullptr || theFile == nullptr ||
+		((E3File*) theFile)->SetStorage(theStorage) != kQ3Success ||
+		((E3File*) theFile)->OpenRead(nullptr) != kQ3Success)
+		Q3Object_CleanDispose(&theFile);
+	
+	Q3Object_CleanDispose(&theStorage);
+	
+	if (theFile != nullptr)
+		{
+		TE3FFormat3DMF_Bin_Data* instanceData = e3read_3dmf_bin_getinstancedata(((E3File*) theFile)->GetFileFormat());
+		instanceData->MFData.baseData.readInGroup = prefetch->readInGroup;
+		}
+	
+	return theFile;
+}
+
+
+
+
+
+//=============================================================================
+//      e3fformat_3dmf_bin_read_item : Read an item on a worker thread.
+//-----------------------------------------------------------------------------
+//		Note :	The worker starts with the TOC entries the item refers to set
+//				as they would be when it was read sequentially, and with the
+//				types declared before it.  Every other entry the item uses is
+//				one it owns, which the sequential reader would not have set
+//				yet either.
+//
+//				Once the item has been read, the entries it owns are published
+//				for later items, and the entries it used are cleared for the
+//				next item on the same thread.
+//-----------------------------------------------------------------------------
+static void
+e3fformat_3dmf_bin_read_item(TE3FFormat3DMF_Bin_Prefetch *prefetch, TE3FFormat3DMF_TOC *mainTOC,
+								E3File *theFile, TQ3Uns32 itemIndex)
+{
+	TE3FFormat3DMF_Bin_Data*	instanceData = e3read_3dmf_bin_getinstancedata(theFile->GetFileFormat());
+	TE3FFormat3DMF_TOC*			theTOC       = instanceData->MFData.toc;
+	TE3FFormat3DMF_Bin_Item&	theItem      = prefetch->items[itemIndex];
+
+
+
+	// Wait for the items which own the entries we refer to
+	for (TQ3Uns32 entryIndex : theItem.refs)
+		{
+		TQ3Uns32 ownerIndex = (TQ3Uns32) prefetch->owner[entryIndex];
+		
+		std::unique_lock<std::mutex> theLock(prefetch->doneMutex);
+		prefetch->doneCondition.wait(theLock, [&] { return prefetch->isDone[ownerIndex] != 0; });
+		
+		if (prefetch->objects[entryIndex] == nullptr)
+			prefetch->failed = true;
+		}
+
+
+
+	// Set up the reader as it would be for the item
+	if (! prefetch->failed)
+		{
+		for (TQ3Uns32 entryIndex : theItem.refs)
+			{
+			E3Shared_Replace(&theTOC->tocEntries[entryIndex].object, prefetch->objects[entryIndex]);
+			theTOC->tocEntries[entryIndex].objType = prefetch->objTypes[entryIndex];
+			}
+		
+		if (instanceData->types != nullptr)
+			Q3Memory_Free(&instanceData->types);
+		
+		instanceData->typesNum = 0;
+		if (theItem.typesBefore != 0)
+			{
+			instanceData->types = (TE3FFormat3DMF_TypeEntry *) Q3Memory_Allocate(
+				static_cast<TQ3Uns32>(theItem.typesBefore * sizeof(TE3FFormat3DMF_TypeEntry)));
+			
+			if (instanceData->types != nullptr)
+				{
+				Q3Memory_Copy(prefetch->types.data(), instanceData->types,
+					static_cast<TQ3Uns32>(theItem.typesBefore * sizeof(TE3FFormat3DMF_TypeEntry)));
+				instanceData->typesNum = theItem.typesBefore;
+				}
+			else
+				prefetch->failed = true;
+			}
+		}
+
+
+
+	// Read the item, and check it ended where the sequential reader would
+	// have ended it
+	if (! prefetch->failed)
+		{
+		instanceData->MFData.baseData.currentStoragePosition = theItem.start;
+		instanceData->containerEnd = 0;
+		E3FFormat_3DMF_Bin_Check_MoreObjects(instanceData);
+		E3FFormat_3DMF_Bin_Check_ContainerEnd(instanceData);
+		
+		theItem.object = theFile->ReadObject();
+		
+		if (instanceData->MFData.baseData.currentStoragePosition != theItem.end ||
+			instanceData->typesNum != theItem.typesAfter)
+			prefetch->failed = true;
+		
+		for (TQ3Uns32 entryIndex : theItem.owned)
+			{
+			if (theTOC->tocEntries[entryIndex].object != nullptr)
+				prefetch->objects[entryIndex] = Q3Shared_GetReference(theTOC->tocEntries[entryIndex].object);
+			
+			prefetch->objTypes[entryIndex] = theTOC->tocEntries[entryIndex].objType;
+			}
+		}
+
+
+
+	// Clear the entries we used
+	for (const std::vector<TQ3Uns32>* theEntries : { &theItem.refs, &theItem.owned })
+		{
+		for (TQ3Uns32 entryIndex : *theEntries)
+			{
+			E3Shared_Replace(&theTOC->tocEntries[entryIndex].object, nullptr);
+			theTOC->tocEntries[entryIndex].objType = mainTOC->tocEntries[entryIndex].objType;
+			}
+		}
+}
+
+
+
+
+
+//=============================================================================
+//      e3fformat_3dmf_bin_read_items : Read items on a worker thread.
+//-----------------------------------------------------------------------------
+//		Note :	Items are taken in file order, so an item only waits for
+//				items which have already been taken by a running thread.
+//-----------------------------------------------------------------------------
+static void
+e3fformat_3dmf_bin_read_items(TE3FFormat3DMF_Bin_Prefetch *prefetch, TE3FFormat3DMF_TOC *mainTOC)
+{
+	TQ3FileObject	theFile  = nullptr;
+	TQ3Uns32		numItems = (TQ3Uns32) prefetch->items.size();
+
+
+
+	// Read items until there are none left
+	for (;;)
+		{
+		TQ3Uns32 itemIndex = prefetch->nextToRead.fetch_add(1);
+		if (itemIndex >= numItems)
+			break;
+		
+		try
+			{
+			if (theFile == nullptr && ! prefetch->failed)
+				{
+				theFile = e3fformat_3dmf_bin_new_worker(prefetch);
+				if (theFile == nullptr)
+					prefetch->failed = true;
+				}
+			
+			if (! prefetch->failed)
+				e3fformat_3dmf_bin_read_item(prefetch, mainTOC, (E3File*) theFile, itemIndex);
+			}
+		catch (...)
+			{
+			prefetch->failed = true;
+			}
+		
+		{
+			std::lock_guard<std::mutex> theLock(prefetch->doneMutex);
+			prefetch->isDone[itemIndex] = 1;
+		}
+		prefetch->doneCondition.notify_all();
+		}
+	
+	Q3Object_CleanDispose(&theFile);
+}
+
+
+
+
+
+//=============================================================================
+//      e3fformat_3dmf_bin_prefetch : Read the whole file on several threads.
+//-----------------------------------------------------------------------------
+//		Note :	The file is split into items, each of which is read from its
+//				own start by a worker as the sequential reader would read it
+//				from the same point.  TOC entries set by earlier items are
+//				handed to the workers which refer to them, so shared objects
+//				stay shared.  Anything the scan or the workers find they can't
+//				handle identically leaves the file to the sequential reader.
+//-----------------------------------------------------------------------------
+static void
+e3fformat_3dmf_bin_prefetch(E3File *theFile)
+{
+	TQ3FileFormatObject				format       = theFile->GetFileFormat();
+	TE3FFormat3DMF_Bin_Data*		instanceData = e3read_3dmf_bin_getinstancedata(format);
+	TE3FFormat3DMF_TOC*				theTOC       = instanceData->MFData.toc;
+	TQ3StorageObject				theStorage   = instanceData->MFData.baseData.storage;
+	TE3FFormat3DMF_Bin_Prefetch*	prefetch;
+	TQ3Uns32						numEntries   = (theTOC != nullptr) ? theTOC->nEntries : 0;
+	TQ3Uns32						sizeRead;
+	const TQ3Uns8*					theData;
+	TQ3Status						qd3dStatus   = kQ3Failure;
+
+
+
+	// Set up
+	try
+		{
+		prefetch = new TE3FFormat3DMF_Bin_Prefetch;
+		}
+	catch (...)
+		{
+		return;
+		}
+
+	instanceData->prefetch  = prefetch;
+	prefetch->nextItem      = 0;
+	prefetch->readInGroup   = instanceData->MFData.baseData.readInGroup;
+	prefetch->fileData      = nullptr;
+	prefetch->fileSize      = 0;
+	prefetch->fileCopy      = nullptr;
+	prefetch->nextToRead    = 0;
+	prefetch->failed        = false;
+
+	try
+		{
+		// Get the data of the whole file, borrowing it if we can
+		if (Q3Storage_GetSize(theStorage, &prefetch->fileSize) == kQ3Success)
+			{
+			if (((E3Storage*) theStorage)->BorrowData(0, prefetch->fileSize, &theData) == kQ3Success)
+				prefetch->fileData = const_cast<TQ3Uns8*>(theData);
+			else
+				{
+				prefetch->fileCopy = (TQ3Uns8 *) Q3Memory_Allocate(prefetch->fileSize);
+				if (prefetch->fileCopy != nullptr &&
+					Q3Storage_GetData(theStorage, 0, prefetch->fileSize, prefetch->fileCopy, &sizeRead) == kQ3Success &&
+					sizeRead == prefetch->fileSize)
+					prefetch->fileData = prefetch->fileCopy;
+				}
+			}
+
+
+
+		// Split the file into items, and read them
+		if (prefetch->fileData != nullptr)
+			{
+			prefetch->owner.assign(numEntries, -1);
+			prefetch->objects.assign(numEntries, nullptr);
+			prefetch->objTypes.assign(numEntries, 0);
+			
+			qd3dStatus = e3fformat_3dmf_bin_scan(theFile);
+			}
+		
+		if (qd3dStatus == kQ3Success && prefetch->items.size() > 1)
+			{
+			prefetch->isDone.assign(prefetch->items.size(), 0);
+			
+			E3Parallel_For(E3Parallel_GetThreadCount(), 1,
+				[prefetch, theTOC]( TQ3Uns32 inStart, TQ3Uns32 inEnd )
+				{
+					for (TQ3Uns32 n = inStart; n < inEnd; ++n)
+						e3fformat_3dmf_bin_read_items(prefetch, theTOC);
+				} );
+			
+			if (prefetch->failed)
+				qd3dStatus = kQ3Failure;
+			}
+		else
+			qd3dStatus = kQ3Failure;
+		}
+	catch (...)
+		{
+		qd3dStatus = kQ3Failure;
+		}
+
+
+
+	// Leave the file to the sequential reader if we couldn't read it all
+	if (qd3dStatus != kQ3Success)
+		e3fformat_3dmf_bin_prefetch_dispose(instanceData);
+
+	instanceData->MFData.baseData.currentStoragePosition = kE3FFormat3DMFBinFirstObject;
+	E3FFormat_3DMF_Bin_Check_MoreObjects(instanceData);
+	E3FFormat_3DMF_Bin_Check_ContainerEnd(instanceData);
+}
+
+
+
+
+
+//=============================================================================
+//      e3fformat_3dmf_bin_take_prefetched : Take the next object read ahead.
+//-----------------------------------------------------------------------------
+//		Note :	Returns false, after disposing of the objects read ahead, if
+//				the file has not been read in order.  The TOC and types are
+//				brought to the state the sequential reader would leave them
+//				in, so that it can carry on where we stop.
+//-----------------------------------------------------------------------------
+static TQ3Boolean
+e3fformat_3dmf_bin_take_prefetched(TE3FFormat3DMF_Bin_Data *instanceData, TQ3Object *theObject)
+{
+	TE3FFormat3DMF_Bin_Prefetch*	prefetch = instanceData->prefetch;
+	TE3FFormat3DMF_Bin_Item&		theItem  = prefetch->items[prefetch->nextItem];
+
+
+
+	// Check we're where the item starts, in the same state
+	if (instanceData->MFData.baseData.currentStoragePosition != theItem.start ||
+		instanceData->MFData.baseData.readInGroup != prefetch->readInGroup ||
+		instanceData->typesNum != theItem.typesBefore)
+		{
+		e3fformat_3dmf_bin_prefetch_dispose(instanceData);
+		return kQ3False;
+		}
+
+
+
+	// Declare the item's types
+	if (theItem.typesAfter != theItem.typesBefore)
+		{
+		if (Q3Memory_Reallocate(&instanceData->types,
+				static_cast<TQ3Uns32>(theItem.typesAfter * sizeof(TE3FFormat3DMF_TypeEntry))) != kQ3Success)
+			{
+			e3fformat_3dmf_bin_prefetch_dispose(instanceData);
+			return kQ3False;
+			}
+		
+		Q3Memory_Copy(&prefetch->types[theItem.typesBefore], &instanceData->types[theItem.typesBefore],
+			static_cast<TQ3Uns32>((theItem.typesAfter - theItem.typesBefore) * sizeof(TE3FFormat3DMF_TypeEntry)));
+		instanceData->typesNum = theItem.typesAfter;
+		}
+
+
+
+	// Save the item's entries in the TOC, and hand out its object
+	for (TQ3Uns32 entryIndex : theItem.owned)
+		{
+		E3Shared_Replace(&instanceData->MFData.toc->tocEntries[entryIndex].object, prefetch->objects[entryIndex]);
+		instanceData->MFData.toc->tocEntries[entryIndex].objType = prefetch->objTypes[entryIndex];
+		}
+
+	*theObject     = theItem.object;
+	theItem.object = nullptr;
+
+	instanceData->MFData.baseData.currentStoragePosition = theItem.end;
+	E3FFormat_3DMF_Bin_Check_MoreObjects(instanceData);
+	E3FFormat_3DMF_Bin_Check_ContainerEnd(instanceData);
+
+	if (++prefetch->nextItem == prefetch->items.size())
+		e3fformat_3dmf_bin_prefetch_dispose(instanceData);
+
+	return kQ3True;
+}
+
+
+
+
+
 //=============================================================================
 //      e3fformat_3dmf_bin_readobject : Reads the next object from storage.
 //-----------------------------------------------------------------------------
@@ -686,6 +1546,25 @@ e3fformat_3dmf_bin_readobject ( TQ3FileObject inFile )
 
 	TQ3Uns32 objLocation = instanceData->MFData.baseData.currentStoragePosition ;
 
+
+
+	// Read the whole file on several threads, if asked to, and hand out the
+	// objects read ahead
+	if (instanceData->prefetchTried == kQ3False && objLocation == kE3FFormat3DMFBinFirstObject)
+		{
+		TQ3Boolean readInParallel = kQ3False;
+		theFile->GetReadInParallel(&readInParallel);
+		
+		instanceData->prefetchTried = kQ3True;
+		if (readInParallel && E3Parallel_GetThreadCount() > 1)
+			e3fformat_3dmf_bin_prefetch(theFile);
+		}
+	
+	if (instanceData->prefetch != nullptr && e3fformat_3dmf_bin_take_prefetched(instanceData, &result))
+		return result;
+
+
+
 	TQ3ObjectType objectType ;
 	TQ3Status status = int32Read ( format, (TQ3Int32*) &objectType ) ;
 	
@@ -699,35 +1578,31 @@ e3fformat_3dmf_bin_readobject ( TQ3FileObject inFile )
 			{
 			TQ3Uns32 refID ;
 			status = int32Read ( format, (TQ3Int32*) &refID ) ;
+			
+			TQ3Int32 refEntryIndex = -1 ;
+			if(status == kQ3Success)
+				refEntryIndex = e3fformat_3dmf_bin_find_toc_entry(instanceData, kQ3True, refID);
 		
-			if(status == kQ3Success) for(i = 0; i < instanceData->MFData.toc->nEntries; i++)
+			if(refEntryIndex >= 0)
 				{
-					if(instanceData->MFData.toc->tocEntries[i].refID == refID){
-						// found
-						if(instanceData->MFData.toc->tocEntries[i].object != nullptr)
-							result = Q3Shared_GetReference(instanceData->MFData.toc->tocEntries[i].object);
-						else{
-							// still not read, read it
-							previousContainer = instanceData->MFData.baseData.currentStoragePosition;
-							instanceData->MFData.baseData.currentStoragePosition = instanceData->MFData.toc->tocEntries[i].objLocation.lo;
-							result = theFile->ReadObject();
-							instanceData->MFData.baseData.currentStoragePosition = previousContainer;
-							}
-						// return a shared object;
-						E3FFormat_3DMF_Bin_Check_MoreObjects(instanceData);
-						E3FFormat_3DMF_Bin_Check_ContainerEnd(instanceData);
-						return (result);
-						}
+				TE3FFormat3DMF_TOCEntry* refEntry = &instanceData->MFData.toc->tocEntries[refEntryIndex];
+				if(refEntry->object != nullptr)
+					result = Q3Shared_GetReference(refEntry->object);
+				else{
+					// still not read, read it
+					previousContainer = instanceData->MFData.baseData.currentStoragePosition;
+					instanceData->MFData.baseData.currentStoragePosition = refEntry->objLocation.lo;
+					result = theFile->ReadObject();
+					instanceData->MFData.baseData.currentStoragePosition = previousContainer;
+					}
+				// return a shared object;
+				E3FFormat_3DMF_Bin_Check_MoreObjects(instanceData);
+				E3FFormat_3DMF_Bin_Check_ContainerEnd(instanceData);
+				return (result);
 				}
 			}
 		else{ // objectType != 0x7266726E /*rfrn - Reference*/
-			if(status == kQ3Success) for(i = 0; i < instanceData->MFData.toc->nEntries; i++)
-				{
-					if(instanceData->MFData.toc->tocEntries[i].objLocation.lo == objLocation){
-						tocEntryIndex = i;
-						break;
-						}
-				}
+			tocEntryIndex = e3fformat_3dmf_bin_find_toc_entry(instanceData, kQ3False, objLocation);
 			}
 		}
 
@@ -958,18 +1833,17 @@ e3fformat_3dmf_bin_get_nexttype ( TQ3FileObject inFile )
 		instanceData->MFData.baseData.currentStoragePosition += 4;// jump past reference size
 		TQ3Int32 refID ;
 		int32Read(format, &refID);
-		for(i=0;i<instanceData->MFData.toc->nEntries;i++){
-			if(instanceData->MFData.toc->tocEntries[i].refID == (TQ3Uns32) refID){
-				if(instanceData->MFData.toc->tocEntries[i].objType != 0)
-					result = instanceData->MFData.toc->tocEntries[i].objType;
-				else{ // We have to read the object to get the type
-					// position the file mark
-					instanceData->MFData.baseData.currentStoragePosition = instanceData->MFData.toc->tocEntries[i].objLocation.lo;
-					result = e3fformat_3dmf_bin_get_nexttype (theFile);
-					// cache the result
-					instanceData->MFData.toc->tocEntries[i].objType = result;
-					}
-				break;
+		TQ3Int32 entryIndex = e3fformat_3dmf_bin_find_toc_entry(instanceData, kQ3True, (TQ3Uns32) refID);
+		if(entryIndex >= 0){
+			TE3FFormat3DMF_TOCEntry* theEntry = &instanceData->MFData.toc->tocEntries[entryIndex];
+			if(theEntry->objType != 0)
+				result = theEntry->objType;
+			else{ // We have to read the object to get the type
+				// position the file mark
+				instanceData->MFData.baseData.currentStoragePosition = theEntry->objLocation.lo;
+				result = e3fformat_3dmf_bin_get_nexttype (theFile);
+				// cache the result
+				theEntry->objType = result;
 				}
 			}
 		}
@@ -1033,10 +1907,18 @@ e3fformat_3dmf_bin_close(TQ3FileFormatObject format, TQ3Boolean abort)
 		Q3Memory_Free(&instanceData->MFData.toc);
 		}
 	
+	if(instanceData->tocByRefID != nullptr)
+		E3HashTable_Destroy(&instanceData->tocByRefID);
+	
+	if(instanceData->tocByLocation != nullptr)
+		E3HashTable_Destroy(&instanceData->tocByLocation);
+	
 	if(instanceData->types != nullptr){
 		Q3Memory_Free(&instanceData->types);
 		}
 	
+	e3fformat_3dmf_bin_prefetch_dispose(instanceData);
+	
 	return (status);
 
 }
@@ -47,6 +47,7 @@
 //-----------------------------------------------------------------------------
 #include "E3IOFileFormat.h"
 #include "E3FFR_3DMF.h"
+#include "E3HashTable.h"
 
 
 
@@ -71,11 +72,19 @@ typedef struct TE3FFormat3DMF_TypeEntry {
 	char							typeName[kQ3StringMaximumLength];
 } TE3FFormat3DMF_TypeEntry;
 
+struct TE3FFormat3DMF_Bin_Prefetch;
+
 typedef struct TE3FFormat3DMF_Bin_Data {
 	TE3FFormat3DMF_Data				MFData;
 	TQ3Uns32						containerEnd;
 	TQ3Uns32						typesNum;
 	TE3FFormat3DMF_TypeEntry*		types;
+	E3HashTablePtr					tocByRefID;
+	E3HashTablePtr					tocByLocation;
+	
+	// objects read ahead on several threads
+	struct TE3FFormat3DMF_Bin_Prefetch*	prefetch;
+	TQ3Boolean						prefetchTried;
 } TE3FFormat3DMF_Bin_Data;
 
 
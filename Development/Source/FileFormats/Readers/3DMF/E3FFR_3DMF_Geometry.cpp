@@ -304,6 +304,87 @@ e3read_3dmf_spreadarray_uns8to32( TQ3Uns32 numNums, void* ioData )
 
 
 
+//=============================================================================
+//      e3read_3dmf_read_vertex_points : Read the points of an array of vertices.
+//-----------------------------------------------------------------------------
+//		Note :	The points are read with a single array read into the start of
+//				the vertex array, then spread out into the vertices in place.
+//				The attribute sets of the vertices are cleared.
+//-----------------------------------------------------------------------------
+static TQ3Status
+e3read_3dmf_read_vertex_points( TQ3Uns32 numVertices, TQ3Vertex3D* vertices, TQ3FileObject theFile )
+{
+	TQ3Point3D*	packedPoints = (TQ3Point3D*)vertices;
+	TQ3Point3D	thePoint;
+	TQ3Int32	n;
+	
+	if (Q3Float32_ReadArray( numVertices * 3, (TQ3Float32*)packedPoints, theFile ) != kQ3Success)
+		return kQ3Failure;
+	
+	for (n = (TQ3Int32)numVertices - 1; n >= 0; --n)
+	{
+		thePoint = packedPoints[ n ];
+		vertices[ n ].point        = thePoint;
+		vertices[ n ].attributeSet = nullptr;
+	}
+	
+	return kQ3Success;
+}
+
+
+
+//=============================================================================
+//      e3read_3dmf_read_edge_indices : Read TriMesh edges with a single array read.
+//-----------------------------------------------------------------------------
+//		Note :	Only possible when point and triangle indices have the same
+//				size, so that the edges form one packed array of indices.
+//				Missing triangles are stored as all-ones, whatever the size.
+//-----------------------------------------------------------------------------
+static TQ3Status
+e3read_3dmf_read_edge_indices( TQ3Uns32 numEdges, TQ3Uns32 indexSize,
+								TQ3TriMeshEdgeData* edges, TQ3FileObject theFile )
+{
+	TQ3Uns32	numNums = numEdges * 4;
+	TQ3Uns32	noTriangle;
+	TQ3Uns32	n;
+	TQ3Status	qd3dStatus;
+	
+	
+	
+	// Read the indices
+	if (indexSize == 4)
+		return Q3Uns32_ReadArray( numNums, (TQ3Uns32*)edges, theFile );
+	
+	if (indexSize == 2)
+	{
+		qd3dStatus = Q3Uns16_ReadArray( numNums, (TQ3Uns16*)edges, theFile );
+		e3read_3dmf_spreadarray_uns16to32( numNums, edges );
+		noTriangle = 0xFFFFU;
+	}
+	else
+	{
+		qd3dStatus = Q3Uns8_ReadArray( numNums, (TQ3Uns8*)edges, theFile );
+		e3read_3dmf_spreadarray_uns8to32( numNums, edges );
+		noTriangle = 0xFFU;
+	}
+	
+	
+	
+	// Widen the missing triangle markers
+	for (n = 0; n < numEdges; ++n)
+	{
+		if (edges[ n ].triangleIndices[ 0 ] == noTriangle)
+			edges[ n ].triangleIndices[ 0 ] = 0xFFFFFFFFU;
+
+		if (edges[ n ].triangleIndices[ 1 ] == noTriangle)
+			edges[ n ].triangleIndices[ 1 ] = 0xFFFFFFFFU;
+	}
+	
+	return qd3dStatus;
+}
+
+
+
 //=============================================================================
 //      e3read_3dmf_group_subobjects : read the subobjects of a BeginGroup object.
 //-----------------------------------------------------------------------------
@@ -2663,10 +2744,8 @@ E3Read_3DMF_Geom_GeneralPolygon(TQ3FileObject theFile)
 		if(geomData.contours[j].vertices == nullptr)
 			goto cleanup;
 	
-		for(i = 0; i< geomData.contours[j].numVertices; i++){
-			if(Q3Point3D_Read(&geomData.contours[j].vertices[i].point, theFile)!= kQ3Success)
-				goto cleanup;
-			}
+		if (e3read_3dmf_read_vertex_points(geomData.contours[j].numVertices, geomData.contours[j].vertices, theFile) != kQ3Success)
+			goto cleanup;
 		}
 	
 	
@@ -2915,16 +2994,18 @@ E3Read_3DMF_Geom_Mesh(TQ3FileObject theFile)
 	TQ3Uns32 			absFaceVertexIndices; // absolute of above
 	
 	TQ3Vertex3D			vertex;
+	TQ3Point3D*			points = nullptr;
 	
 	TQ3MeshVertex*		vertices = nullptr;
 	TQ3MeshVertex*		faceVertices = nullptr;
+	TQ3Uns32*			faceIndices = nullptr;
 	TQ3Uns32			allocatedFaceIndices = 0L;
 	
 	TQ3MeshFace			lastFace = nullptr;
 	TQ3MeshFace*		faces = nullptr;
 	TQ3Uns32			faceCount = 0L;
 	
-	TQ3Uns32			i,j,index;
+	TQ3Uns32			i,j;
 	TQ3Boolean			readFailed = kQ3False;
 	
 	TQ3AttributeSet		attributeSet;
@@ -2950,18 +3031,23 @@ E3Read_3DMF_Geom_Mesh(TQ3FileObject theFile)
 	
 	
 	// read the vertices
+	points = (TQ3Point3D *) Q3Memory_Allocate(sizeof(TQ3Point3D) * numVertices);
+	if (points == nullptr ||
+		Q3Float32_ReadArray(numVertices * 3, (TQ3Float32*)points, theFile) != kQ3Success)
+		{
+		readFailed = kQ3True;
+		goto cleanUp;
+		}
 	
 	vertex.attributeSet = nullptr;
 	
 	for(i = 0; i< numVertices; i++){
-		if(Q3Point3D_Read(&vertex.point, theFile)!= kQ3Success)
-			{
-			readFailed = kQ3True;
-			goto cleanUp;
-			}
+		vertex.point = points[i];
 		vertices[i] = Q3Mesh_VertexNew (mesh, &vertex);
 		}
 	
+	Q3Memory_Free(&points);
+	
 	// read the number of faces
 	if(Q3Uns32_Read(&numFaces, theFile)!= kQ3Success)
 		{
@@ -2999,17 +3085,24 @@ E3Read_3DMF_Geom_Mesh(TQ3FileObject theFile)
 		if(allocatedFaceIndices < absFaceVertexIndices){
 			if(Q3Memory_Reallocate (&faceVertices, (absFaceVertexIndices*sizeof(TQ3MeshVertex))) != kQ3Success)
 				goto cleanUp;
+			if(Q3Memory_Reallocate (&faceIndices, (absFaceVertexIndices*sizeof(TQ3Uns32))) != kQ3Success)
+				goto cleanUp;
 			allocatedFaceIndices = absFaceVertexIndices;
 			}
 			
 		//read the Indices
+		if(Q3Uns32_ReadArray(absFaceVertexIndices, faceIndices, theFile)!= kQ3Success)
+			{
+			readFailed = kQ3True;
+			goto cleanUp;
+			}
 		for(j = 0; j < absFaceVertexIndices; j++){
-			if(Q3Uns32_Read(&index, theFile)!= kQ3Success)
+			if(faceIndices[j] >= numVertices)
 				{
 				readFailed = kQ3True;
 				goto cleanUp;
 				}
-			faceVertices[j] = vertices[index];
+			faceVertices[j] = vertices[faceIndices[j]];
 			}
 		// create the face
 		if(numFaceVertexIndices > 0) // it's a face
@@ -3095,8 +3188,10 @@ cleanUp:
 		}
 
 	
+	Q3Memory_Free(&points);
 	Q3Memory_Free(&vertices);
 	Q3Memory_Free(&faceVertices);
+	Q3Memory_Free(&faceIndices);
 	Q3Memory_Free(&faces);
 	
 	return mesh;
@@ -3116,7 +3211,6 @@ E3Read_3DMF_Geom_NURBCurve(TQ3FileObject theFile)
 	TQ3Object			childObject;
 	TQ3Status			qd3dStatus;
 	TQ3NURBCurveData	geomData;
-	TQ3Uns32			i;
 	TQ3SetObject			elementSet = nullptr;
 
 
@@ -3147,10 +3241,8 @@ E3Read_3DMF_Geom_NURBCurve(TQ3FileObject theFile)
 
 	
 	// Read in vertices
-	for(i = 0; i< geomData.numPoints; i++)
-	{
-		Q3RationalPoint4D_Read(&geomData.controlPoints[i],theFile);
-	}
+	if (Q3Float32_ReadArray( geomData.numPoints * 4, (TQ3Float32*)geomData.controlPoints, theFile ) != kQ3Success)
+		goto cleanup;
 		
 	// Allocate memory to hold knots
 	geomData.knots =
@@ -3159,10 +3251,8 @@ E3Read_3DMF_Geom_NURBCurve(TQ3FileObject theFile)
 		goto cleanup;
 			
 	// Read in knots
-	for(i = 0; i< (geomData.numPoints+geomData.order); i++)
-	{
-		Q3Float32_Read(&geomData.knots[i],theFile);
-	}
+	if (Q3Float32_ReadArray( geomData.numPoints + geomData.order, geomData.knots, theFile ) != kQ3Success)
+		goto cleanup;
 
 	// Read in the attributes
 	while(Q3File_IsEndOfContainer(theFile,nullptr) == kQ3False){
@@ -3217,7 +3307,6 @@ E3Read_3DMF_Geom_NURBPatch(TQ3FileObject theFile)
 {
 	TQ3Object 			theObject = nullptr ;
 	TQ3Object			childObject ;
-	TQ3Uns32			i ;
 	TQ3Uns32			numPoints ;
 	TQ3SetObject		elementSet = nullptr ;
 	TQ3NURBPatchData	geomData ;
@@ -3243,8 +3332,8 @@ E3Read_3DMF_Geom_NURBPatch(TQ3FileObject theFile)
 		return nullptr ;
 	
 	// Read in vertices
-	for ( i = 0 ; i < numPoints ; ++i )
-		Q3RationalPoint4D_Read ( &geomData.controlPoints [ i ] , theFile ) ;
+	if ( Q3Float32_ReadArray ( numPoints * 4 , (TQ3Float32*) geomData.controlPoints , theFile ) != kQ3Success )
+		goto cleanup ;
 		
 	// Allocate memory to hold knots
 	geomData.uKnots = (float *) Q3Memory_AllocateClear ( ( geomData.numColumns + geomData.uOrder ) * sizeof( float ) ) ;
@@ -3253,10 +3342,9 @@ E3Read_3DMF_Geom_NURBPatch(TQ3FileObject theFile)
 		goto cleanup ;
 			
 	// Read in knots
-	for ( i = 0 ; i < geomData.numColumns + geomData.uOrder ; ++i )
-		Q3Float32_Read ( &geomData.uKnots [ i ] , theFile ) ;
-	for ( i = 0 ; i < geomData.numRows + geomData.vOrder ; ++i )
-		Q3Float32_Read ( &geomData.vKnots [ i ] , theFile ) ;
+	if ( ( Q3Float32_ReadArray ( geomData.numColumns + geomData.uOrder , geomData.uKnots , theFile ) == kQ3Failure )
+	||	 ( Q3Float32_ReadArray ( geomData.numRows + geomData.vOrder , geomData.vKnots , theFile ) == kQ3Failure ) )
+		goto cleanup ;
 
 
 	
@@ -3490,9 +3578,7 @@ E3Read_3DMF_Geom_PolyLine(TQ3FileObject theFile)
 
 	
 	// Read in vertices
-	for(i = 0; i< geomData.numVertices; i++){
-		Q3Point3D_Read(&geomData.vertices[i].point,theFile);
-		}
+	e3read_3dmf_read_vertex_points(geomData.numVertices, geomData.vertices, theFile);
 
 
 
@@ -3592,10 +3678,8 @@ E3Read_3DMF_Geom_Polygon(TQ3FileObject theFile)
 	if(geomData.vertices == nullptr)
 		return (nullptr);
 	
-	for(i = 0; i< geomData.numVertices; i++){
-		if(Q3Point3D_Read(&geomData.vertices[i].point, theFile)!= kQ3Success)
-			goto cleanup;
-		}
+	if (e3read_3dmf_read_vertex_points(geomData.numVertices, geomData.vertices, theFile) != kQ3Success)
+		goto cleanup;
 	
 	
 
@@ -3818,10 +3902,8 @@ E3Read_3DMF_Geom_TriGrid(TQ3FileObject theFile)
 	if(geomData.vertices == nullptr)
 		return (nullptr);
 	
-	for(i = 0; i< numVertices; i++){
-		if(Q3Point3D_Read(&geomData.vertices[i].point, theFile)!= kQ3Success)
-			goto cleanup;
-		}
+	if (e3read_3dmf_read_vertex_points(numVertices, geomData.vertices, theFile) != kQ3Success)
+		goto cleanup;
 	
 	
 
@@ -3906,6 +3988,7 @@ E3Read_3DMF_Geom_TriMesh(TQ3FileObject theFile)
 	TQ3Uns16				temp16;
 	TQ3Uns8					temp8;
 	TQ3Uns32				i;
+	TQ3Uns32				pointIndexSize, triangleIndexSize;
 	TQ3Object				elementSet = nullptr;
 	TQ3StorageObject		theStorage = nullptr;
 	TQ3Uns32				storageSize;
@@ -3977,7 +4060,14 @@ E3Read_3DMF_Geom_TriMesh(TQ3FileObject theFile)
 		geomData.edges = (TQ3TriMeshEdgeData *)Q3Memory_Allocate(sizeof(TQ3TriMeshEdgeData)*geomData.numEdges);
 		if(geomData.edges == nullptr)
 			goto cleanUp;
-		if(geomData.numPoints >= 0x00010000U)
+		pointIndexSize    = (geomData.numPoints    >= 0x00010000U) ? 4 : ((geomData.numPoints    >= 0x00000100U) ? 2 : 1);
+		triangleIndexSize = (geomData.numTriangles >= 0x00010000U) ? 4 : ((geomData.numTriangles >= 0x00000100U) ? 2 : 1);
+		if(pointIndexSize == triangleIndexSize)
+			{
+			if(e3read_3dmf_read_edge_indices(geomData.numEdges, pointIndexSize, geomData.edges, theFile) != kQ3Success)
+				goto cleanUp;
+			}
+		else if(geomData.numPoints >= 0x00010000U)
 			for(i = 0; i < geomData.numEdges; i++)
 				{
 				if(Q3Uns32_Read(&geomData.edges[i].pointIndices[0], theFile)!= kQ3Success)
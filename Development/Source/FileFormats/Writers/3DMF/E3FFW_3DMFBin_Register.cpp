@@ -517,35 +517,35 @@ e3ffw_3dmfbin_metahandler(TQ3XMethodType methodType)
 	// Return our methods
 	switch (methodType) {
 		case kQ3XMethodTypeFFormatFloat32Write:
-			theMethod = (TQ3XFunctionPointer) E3FileFormat_GenericWriteBinary_32;
+			theMethod = (TQ3XFunctionPointer) E3FFW_3DMF_WriteBinary_32;
 			break;
 
 		case kQ3XMethodTypeFFormatFloat64Write:
-			theMethod = (TQ3XFunctionPointer) E3FileFormat_GenericWriteBinary_64;
+			theMethod = (TQ3XFunctionPointer) E3FFW_3DMF_WriteBinary_64;
 			break;
 
 		case kQ3XMethodTypeFFormatInt8Write:
-			theMethod = (TQ3XFunctionPointer) E3FileFormat_GenericWriteBinary_8;
+			theMethod = (TQ3XFunctionPointer) E3FFW_3DMF_WriteBinary_8;
 			break;
 
 		case kQ3XMethodTypeFFormatInt16Write:
-			theMethod = (TQ3XFunctionPointer) E3FileFormat_GenericWriteBinary_16;
+			theMethod = (TQ3XFunctionPointer) E3FFW_3DMF_WriteBinary_16;
 			break;
 
 		case kQ3XMethodTypeFFormatInt32Write:
-			theMethod = (TQ3XFunctionPointer) E3FileFormat_GenericWriteBinary_32;
+			theMethod = (TQ3XFunctionPointer) E3FFW_3DMF_WriteBinary_32;
 			break;
 
 		case kQ3XMethodTypeFFormatInt64Write:
-			theMethod = (TQ3XFunctionPointer) E3FileFormat_GenericWriteBinary_64;
+			theMethod = (TQ3XFunctionPointer) E3FFW_3DMF_WriteBinary_64;
 			break;
 
 		case kQ3XMethodTypeFFormatStringWrite:
-			theMethod = (TQ3XFunctionPointer) E3FileFormat_GenericWriteBinary_String;
+			theMethod = (TQ3XFunctionPointer) E3FFW_3DMF_WriteBinary_String;
 			break;
 
 		case kQ3XMethodTypeFFormatRawWrite:
-			theMethod = (TQ3XFunctionPointer) E3FileFormat_GenericWriteBinary_Raw;
+			theMethod = (TQ3XFunctionPointer) E3FFW_3DMF_WriteBinary_Raw;
 			break;
 
 		default: // get the common methods
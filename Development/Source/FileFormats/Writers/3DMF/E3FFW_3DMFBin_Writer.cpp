@@ -76,6 +76,52 @@ e3ffw_3DMF_TraverseObject_CheckRef(TQ3ViewObject			theView,
 
 
 
+
+//=============================================================================
+//      Internal constants
+//-----------------------------------------------------------------------------
+const TQ3Uns32 kE3FFW3DMFWriteBufferSize					= 64 * 1024;
+const TQ3Uns32 kE3FFW3DMFStackGrowSize						= 64;
+
+
+
+
+//=============================================================================
+//      Internal functions
+//-----------------------------------------------------------------------------
+//      e3ffw_3DMF_flush_buffer : Write any buffered data to the storage.
+//-----------------------------------------------------------------------------
+static TQ3Status
+e3ffw_3DMF_flush_buffer(TE3FFormatW3DMF_Data *instanceData)
+{
+	if (instanceData->writeBufferUsed == 0)
+		return (kQ3Success);
+
+
+	TQ3Status	result    = kQ3Failure;
+	TQ3Uns32	sizeWrite = 0;
+	TQ3XStorageWriteDataMethod dataWrite = (TQ3XStorageWriteDataMethod)
+		instanceData->baseData.storage->GetMethod ( kQ3XMethodTypeStorageWriteData ) ;
+
+	if (dataWrite != nullptr)
+		result = dataWrite(instanceData->baseData.storage,
+							instanceData->writeBufferStart,
+							instanceData->writeBufferUsed,
+							instanceData->writeBuffer, &sizeWrite);
+
+	// A short write means the storage is full, so report it here rather
+	// than losing the tail of the file silently
+	Q3_ASSERT(sizeWrite == instanceData->writeBufferUsed);
+	if (sizeWrite != instanceData->writeBufferUsed)
+		result = kQ3Failure;
+
+	instanceData->writeBufferUsed = 0;
+	
+	return (result);
+}
+
+
+
 //=============================================================================
 //      e3ffw_3DMF_filter_in_toc : Adds the object to the TOC if needed and
 //      returns a reference object
@@ -135,6 +181,7 @@ e3ffw_3DMF_filter_in_toc(TE3FFormatW3DMF_Data *fileFormatPrivate,  TQ3Object the
 	if (fileFormatPrivate->index == nullptr)
 	{
 		fileFormatPrivate->index = new TE3FFormatW3DMF_Map;
+		fileFormatPrivate->index->reserve( TOC_GROW_SIZE );
 	}
 	
 	
@@ -354,6 +401,8 @@ E3FFW_3DMF_EndPass(TQ3ViewObject				theView,
 		
 		if((status == kQ3Success) && (pos.lo != fileFormatPrivate->baseData.currentStoragePosition))// something has been written 
 			{
+				// Patch the TOC location into the header, which flushes
+				// the buffered objects ahead of it
 				fileFormatPrivate->baseData.currentStoragePosition = 16;
 				Q3Uns64_Write(pos, theFile);
 			}
@@ -361,6 +410,9 @@ E3FFW_3DMF_EndPass(TQ3ViewObject				theView,
 		}
 	
 	
+	// Push out whatever is still buffered
+	e3ffw_3DMF_flush_buffer(fileFormatPrivate);
+	
 	return kQ3ViewStatusDone;
 }
 
@@ -467,13 +519,183 @@ E3FFW_3DMF_Close( TQ3FileFormatObject format, TQ3Boolean abort )
 	if (instanceData->index != nullptr)
 	{
 		delete instanceData->index;
+		instanceData->index = nullptr;
 	}
+	
+	
+	// Flush the write buffer before the storage is closed
+	if (!abort)
+		status = e3ffw_3DMF_flush_buffer(instanceData);
+	
+	instanceData->writeBufferUsed = 0;
+	Q3Memory_Free(&instanceData->writeBuffer);
+	
+	instanceData->stackCount    = 0;
+	instanceData->stackCapacity = 0;
+	Q3Memory_Free(&instanceData->stack);
 		
 			
 	return status;
 }
 
 
+//=============================================================================
+//      E3FFW_3DMF_WriteBinary_Raw : Buffered raw write method.
+//-----------------------------------------------------------------------------
+//		Note :	The binary writer's primitive write methods all come through
+//				here. Data is copied into a fixed size buffer, which is
+//				written to the storage each time it fills, so the file is
+//				streamed out in large sequential chunks whatever the size of
+//				the individual writes.
+//
+//				A write that does not follow on from the buffered data (such
+//				as the TOC location patch in the header) flushes the buffer
+//				first.
+//-----------------------------------------------------------------------------
+TQ3Status
+E3FFW_3DMF_WriteBinary_Raw(TQ3FileFormatObject format, const unsigned char* data, TQ3Uns32 length)
+{
+	TE3FFormatW3DMF_Data*	instanceData = (TE3FFormatW3DMF_Data*) format->FindLeafInstanceData () ;
+	TQ3Status				result;
+	TQ3Uns32				theChunk;
+
+
+
+	// Flush if this write doesn't continue the buffered data
+	if ((instanceData->writeBufferUsed != 0) &&
+		(instanceData->baseData.currentStoragePosition !=
+			instanceData->writeBufferStart + instanceData->writeBufferUsed))
+		{
+		result = e3ffw_3DMF_flush_buffer(instanceData);
+		if (result != kQ3Success)
+			return (result);
+		}
+
+
+
+	// Allocate the buffer on first use, writing unbuffered if we can't
+	if (instanceData->writeBuffer == nullptr)
+		{
+		instanceData->writeBuffer = (TQ3Uns8 *) Q3Memory_Allocate(kE3FFW3DMFWriteBufferSize);
+		if (instanceData->writeBuffer == nullptr)
+			return (E3FileFormat_GenericWriteBinary_Raw(format, data, length));
+		}
+
+
+
+	// Copy the data into the buffer, writing it out each time it fills
+	while (length != 0)
+		{
+		if (instanceData->writeBufferUsed == 0)
+			instanceData->writeBufferStart = instanceData->baseData.currentStoragePosition;
+
+		theChunk = E3Num_Min(length, kE3FFW3DMFWriteBufferSize - instanceData->writeBufferUsed);
+		memcpy(instanceData->writeBuffer + instanceData->writeBufferUsed, data, theChunk);
+
+		instanceData->writeBufferUsed                 += theChunk;
+		instanceData->baseData.currentStoragePosition += theChunk;
+		data   += theChunk;
+		length -= theChunk;
+
+		if (instanceData->writeBufferUsed == kE3FFW3DMFWriteBufferSize)
+			{
+			result = e3ffw_3DMF_flush_buffer(instanceData);
+			if (result != kQ3Success)
+				return (result);
+			}
+		}
+
+	return (kQ3Success);
+}
+
+
+
+
+
+//=============================================================================
+//      E3FFW_3DMF_WriteBinary_8 : Buffered 8 bit write method.
+//-----------------------------------------------------------------------------
+TQ3Status
+E3FFW_3DMF_WriteBinary_8(TQ3FileFormatObject format, const TQ3Int8 *data)
+{
+	return E3FFW_3DMF_WriteBinary_Raw (format, (const unsigned char*)data, 1);
+}
+
+
+
+
+
+//=============================================================================
+//      E3FFW_3DMF_WriteBinary_16 : Buffered 16 bit write method.
+//-----------------------------------------------------------------------------
+TQ3Status
+E3FFW_3DMF_WriteBinary_16(TQ3FileFormatObject format, const TQ3Int16 *data)
+{
+	return E3FFW_3DMF_WriteBinary_Raw (format, (const unsigned char*)data, 2);
+}
+
+
+
+
+
+//=============================================================================
+//      E3FFW_3DMF_WriteBinary_32 : Buffered 32 bit write method.
+//-----------------------------------------------------------------------------
+TQ3Status
+E3FFW_3DMF_WriteBinary_32(TQ3FileFormatObject format, const TQ3Int32 *data)
+{
+	return E3FFW_3DMF_WriteBinary_Raw (format, (const unsigned char*)data, 4);
+}
+
+
+
+
+
+//=============================================================================
+//      E3FFW_3DMF_WriteBinary_64 : Buffered 64 bit write method.
+//-----------------------------------------------------------------------------
+TQ3Status
+E3FFW_3DMF_WriteBinary_64(TQ3FileFormatObject format, const TQ3Int64 *data)
+{
+	return E3FFW_3DMF_WriteBinary_Raw (format, (const unsigned char*)data, 8);
+}
+
+
+
+
+
+//=============================================================================
+//      E3FFW_3DMF_WriteBinary_String : Buffered string write method.
+//-----------------------------------------------------------------------------
+//		Note :	Writes a zero terminated string, padded to a multiple of 4
+//				bytes, as E3FileFormat_GenericWriteBinary_String does.
+//-----------------------------------------------------------------------------
+TQ3Status
+E3FFW_3DMF_WriteBinary_String(TQ3FileFormatObject format, const char *data, TQ3Uns32 *length)
+{
+#pragma unused(length)
+	TQ3Status	result;
+	TQ3Size		theLength, paddedLength;
+	TQ3Uns32	pad = 0;
+
+
+
+	theLength    = static_cast<TQ3Uns32>(strlen( data ) + 1);	// 1 for the trailing NUL byte
+	paddedLength = Q3Size_Pad( theLength );
+
+	result = E3FFW_3DMF_WriteBinary_Raw( format, (const unsigned char *)data, theLength );
+
+	if ( (result == kQ3Success) && (paddedLength > theLength) )
+		result = E3FFW_3DMF_WriteBinary_Raw( format, (const unsigned char *)&pad,
+			paddedLength - theLength );
+
+	return (result);
+}
+
+
+
+
+
 //=============================================================================
 //      e3ffw_3DMF_write_objects: unroll the stack and do the real write.
 //-----------------------------------------------------------------------------
@@ -705,9 +927,8 @@ e3ffw_3DMF_TraverseObject_CheckRef(TQ3ViewObject			theView,
 	if((fileFormatPrivate->baseData.groupDeepCounter == 0) && (qd3dStatus == kQ3Success)){ // we're again in the root object
 		if(fileFormatPrivate->stackCount != 0){
 			qd3dStatus = e3ffw_3DMF_write_objects (fileFormatPrivate,theFile);
-			// clean the stack
+			// clean the stack, keeping its storage for the next object
 			fileFormatPrivate->stackCount = 0;
-			Q3Memory_Free(&fileFormatPrivate->stack);
 			}
 		}
 exit:
@@ -765,10 +986,18 @@ E3XView_SubmitWriteData(TQ3ViewObject view, TQ3Size size, void *data, TQ3XDataDe
 		}
 
 	// Grow the view stack to the hold the new item
-	qd3dStatus = Q3Memory_Reallocate(&instanceData->stack,
-									  static_cast<TQ3Uns32>(sizeof(TQ33DMFWStackItem) * (instanceData->stackCount+1)));
-	if (qd3dStatus != kQ3Success)
-		return(qd3dStatus);
+	if (instanceData->stackCount == instanceData->stackCapacity)
+		{
+		TQ3Uns32 newCapacity = (instanceData->stackCapacity < kE3FFW3DMFStackGrowSize) ?
+								kE3FFW3DMFStackGrowSize : (instanceData->stackCapacity * 2);
+		
+		qd3dStatus = Q3Memory_Reallocate(&instanceData->stack,
+										  static_cast<TQ3Uns32>(sizeof(TQ33DMFWStackItem) * newCapacity));
+		if (qd3dStatus != kQ3Success)
+			return(qd3dStatus);
+		
+		instanceData->stackCapacity = newCapacity;
+		}
 	
 	newItem = &instanceData->stack[instanceData->stackCount];
 	
@@ -843,9 +1072,8 @@ E3XView_SubmitSubObjectData(TQ3ViewObject view, TQ3XObjectClass objectClass, TQ3
 	if((instanceData->baseData.groupDeepCounter == 0) && (qd3dStatus == kQ3Success)){
 		if(instanceData->stackCount != 0){
 			qd3dStatus = e3ffw_3DMF_write_objects (instanceData,theFile);
-			// clean the stack
+			// clean the stack, keeping its storage for the next object
 			instanceData->stackCount = 0;
-			Q3Memory_Free(&instanceData->stack);
 			}
 		}
 	return (qd3dStatus);
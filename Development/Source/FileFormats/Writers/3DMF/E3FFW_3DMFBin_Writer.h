@@ -84,6 +84,13 @@ void				E3FFW_3DMF_Cancel(
 
 TQ3Status			E3FFW_3DMF_Close( TQ3FileFormatObject format, TQ3Boolean abort );
 
+TQ3Status			E3FFW_3DMF_WriteBinary_8(TQ3FileFormatObject format, const TQ3Int8 *data);
+TQ3Status			E3FFW_3DMF_WriteBinary_16(TQ3FileFormatObject format, const TQ3Int16 *data);
+TQ3Status			E3FFW_3DMF_WriteBinary_32(TQ3FileFormatObject format, const TQ3Int32 *data);
+TQ3Status			E3FFW_3DMF_WriteBinary_64(TQ3FileFormatObject format, const TQ3Int64 *data);
+TQ3Status			E3FFW_3DMF_WriteBinary_String(TQ3FileFormatObject format, const char *data, TQ3Uns32 *length);
+TQ3Status			E3FFW_3DMF_WriteBinary_Raw(TQ3FileFormatObject format, const unsigned char* data, TQ3Uns32 length);
+
 TQ3Status
 E3FFW_3DMF_Group(TQ3ViewObject       theView,
 						void                *fileFormatPrivate,
@@ -56,7 +56,9 @@
 #endif
 
 #include <vector>
+#include <deque>
 #include <cstring>
+#include <mutex>
 using namespace std;
 
 extern int gDebugMode;
@@ -220,7 +222,7 @@ public:
 
 	virtual bool		BindFrameBuffer( GLenum inTarget, GLuint inFrameBufferID );
 
-private:
+protected:
 	void				Cleanup();
 	void				InitColor(
 								TQ3Uns32 inPaneWidth,
@@ -250,6 +252,7 @@ private:
 								GLsizei height );
 
 	CQ3WeakObjectRef		masterDrawContext;
+	bool					hasMasterDrawContext;
 	TQ3GLContext			masterContext;
 	GLint					fboViewPort[4];
 	GLint					masterViewPort[4];
@@ -309,6 +312,140 @@ public:
 #endif
 
 
+#if QUESA_OS_UNIX && QUESA_USE_EGL
+#ifndef GL_PIXEL_PACK_BUFFER
+	#define GL_PIXEL_PACK_BUFFER				0x88EB
+	#define GL_STREAM_READ						0x88E1
+	#define GL_READ_ONLY						0x88B8
+#endif
+
+typedef void (APIENTRY* glGenBuffersProcPtr) (GLsizei n, GLuint *buffers);
+typedef void (APIENTRY* glDeleteBuffersProcPtr) (GLsizei n, const GLuint *buffers);
+typedef void (APIENTRY* glBindBufferProcPtr) (GLenum target, GLuint buffer);
+typedef void (APIENTRY* glBufferDataProcPtr) (GLenum target, GLsizeiptr size,
+											const GLvoid *data, GLenum usage);
+typedef GLvoid* (APIENTRY* glMapBufferProcPtr) (GLenum target, GLenum access);
+typedef GLboolean (APIENTRY* glUnmapBufferProcPtr) (GLenum target);
+
+/*!
+	@class		EGLHeadlessContext
+	@abstract	OpenGL context on an EGL display, needing neither an X server
+				nor a window.
+	@discussion	One such context is shared by every pixmap draw context in the
+				process.  Each pixmap draw context renders into its own FBO on
+				it, and finished frames are read back through pixel pack
+				buffers owned by this context, so that a readback can still be
+				in flight while later frames render.
+				
+				The context lives until GLDrawContext_Terminate, so that
+				textures and other shared data survive the rebuilding of GL
+				contexts that happens whenever a pixmap is changed.
+				
+				Headless rendering is single-threaded.  An EGL context can
+				only be current on one thread, so every headless pixmap draw
+				context must be rendered on the same thread.  sSharedMutex
+				only guards creating the shared context and counting its
+				users, so that draw contexts may be created and disposed on
+				other threads.
+*/
+class EGLHeadlessContext : public CQ3GLContext
+{
+public:
+	static EGLHeadlessContext*	Acquire();
+	
+	static void			Terminate();
+	
+	void				Release();
+	
+	virtual void		SwapBuffers() {}
+
+	virtual void		SetCurrentBase( TQ3Boolean inForceSet );
+	
+	virtual void		SetCurrent( TQ3Boolean inForceSet );
+	
+						// Start reading the pane of the current read buffer
+						// into a pixel pack buffer, then finish the oldest
+						// readbacks until at most inFramesInFlight are pending.
+	void				QueueReadback(
+								const void* inOwner,
+								TQ3DrawContextObject inPixmapDrawContext,
+								TQ3Uns32 inWidth,
+								TQ3Uns32 inHeight,
+								TQ3Uns32 inFramesInFlight );
+	
+						// Copy pending readbacks of one owner, or of all owners
+						// if inOwner is nullptr, into their pixmaps.
+	void				FinishReadbacks( const void* inOwner );
+
+private:
+	struct PixelReadback
+	{
+		GLuint			bufferID;
+		GLsizeiptr		capacity;
+		const void*		owner;			// nullptr when not pending
+		TQ3Uns8*		destPixels;
+		TQ3Uns32		destRowBytes;
+		TQ3Uns32		width;
+		TQ3Uns32		height;
+		TQ3Uns32		bytesPerPixel;
+	};
+
+						EGLHeadlessContext();
+	virtual				~EGLHeadlessContext();
+	
+	void				Cleanup();
+	void				FinishReadback( PixelReadback& ioReadback );
+
+	static EGLHeadlessContext*	sShared;
+	static std::mutex			sSharedMutex;
+
+	EGLDisplay				display;
+	EGLContext				context;
+	EGLSurface				surface;
+	bool					ownsDisplay;
+	TQ3Uns32				clientCount;
+	std::vector<PixelReadback>	readbacks;
+	std::deque<TQ3Uns32>	pendingReadbacks;	// oldest first
+
+	glGenBuffersProcPtr		glGenBuffers;
+	glDeleteBuffersProcPtr	glDeleteBuffers;
+	glBindBufferProcPtr		glBindBuffer;
+	glBufferDataProcPtr		glBufferData;
+	glMapBufferProcPtr		glMapBuffer;
+	glUnmapBufferProcPtr	glUnmapBuffer;
+};
+
+/*!
+	@class		EGLPixmapContext
+	@abstract	FBO on the headless EGL context standing in for a pixmap draw
+				context.  Swapping buffers queues a readback into the pixmap.
+*/
+class EGLPixmapContext : public FBORec
+{
+public:
+						EGLPixmapContext(
+								TQ3DrawContextObject theDrawContext,
+								TQ3Uns32 inPaneWidth,
+								TQ3Uns32 inPaneHeight,
+								const TQ3GLExtensions& inExtensionInfo,
+								TQ3Uns32 depthBits,
+								TQ3Uns32 stencilBits,
+								EGLHeadlessContext* inHeadlessContext,
+								TQ3Uns32 inSamples );
+	
+	virtual				~EGLPixmapContext();
+	
+	virtual void		SwapBuffers();
+	
+	virtual void		StartFrame( QORenderer::PerPixelLighting& inPPL );
+
+private:
+	EGLHeadlessContext*		headlessContext;
+	bool					hasNewFrame;
+};
+#endif
+
+
 #if QUESA_OS_WIN32
 class WinGLContext : public CQ3GLContext
 {
@@ -584,6 +721,7 @@ FBORec::FBORec(
 		TQ3Uns32 inSamples )
 	: CQ3GLContext( theDrawContext )
 	, masterDrawContext( inMasterDrawContext )
+	, hasMasterDrawContext( inMasterDrawContext != nullptr )
 	, masterContext( inMasterGLContext )
 	, copyToPixMapOnSwapBuffer( inCopyOnSwapBuffer )
 	, frameBufferID( 0 )
@@ -919,7 +1057,7 @@ FBORec::~FBORec()
 
 void	FBORec::SetCurrent( TQ3Boolean inForceSet )
 {
-	Q3_ASSERT_MESSAGE( masterDrawContext.isvalid(),
+	Q3_ASSERT_MESSAGE( masterDrawContext.isvalid() || ! hasMasterDrawContext,
 		"FBO being used after master context destroyed" );
 	SetCurrentBase( inForceSet );
 	
@@ -1148,6 +1286,543 @@ gldrawcontext_fbo_new(	TQ3DrawContextObject theDrawContext,
 
 
 
+#pragma mark -
+#if QUESA_OS_UNIX && QUESA_USE_EGL
+
+EGLHeadlessContext*	EGLHeadlessContext::sShared = nullptr;
+std::mutex			EGLHeadlessContext::sSharedMutex;
+
+const TQ3Uns32	kMaxFramesInFlight	= 8;
+
+
+/*!
+	@function	gldrawcontext_egl_has_extension
+	@abstract	Test whether a space-separated EGL extension list contains
+				a given extension name.
+*/
+static bool
+gldrawcontext_egl_has_extension( const char* inList, const char* inName )
+{
+	bool	hasExtension = false;
+	
+	if (inList != nullptr)
+	{
+		size_t	nameLen = strlen( inName );
+		const char*	found = inList;
+		
+		while ( (! hasExtension) &&
+			((found = strstr( found, inName )) != nullptr) )
+		{
+			hasExtension = ((found == inList) || (found[-1] == ' ')) &&
+				((found[nameLen] == ' ') || (found[nameLen] == '\0'));
+			found += nameLen;
+		}
+	}
+	
+	return hasExtension;
+}
+
+EGLHeadlessContext::EGLHeadlessContext()
+	: CQ3GLContext( nullptr )
+	, display( EGL_NO_DISPLAY )
+	, context( EGL_NO_CONTEXT )
+	, surface( EGL_NO_SURFACE )
+	, ownsDisplay( false )
+	, clientCount( 0 )
+{
+	// Prefer Mesa's surfaceless platform, which needs no X server and no
+	// GPU, and otherwise take whatever the default display is.
+#ifdef EGL_PLATFORM_SURFACELESS_MESA
+	PFNEGLGETPLATFORMDISPLAYEXTPROC	getPlatformDisplay =
+		(PFNEGLGETPLATFORMDISPLAYEXTPROC) eglGetProcAddress( "eglGetPlatformDisplayEXT" );
+	if ( (getPlatformDisplay != nullptr) &&
+		gldrawcontext_egl_has_extension( eglQueryString( EGL_NO_DISPLAY, EGL_EXTENSIONS ),
+			"EGL_MESA_platform_surfaceless" ) )
+	{
+		display = getPlatformDisplay( EGL_PLATFORM_SURFACELESS_MESA,
+			EGL_DEFAULT_DISPLAY, nullptr );
+		ownsDisplay = (display != EGL_NO_DISPLAY);
+	}
+#endif
+	if (display == EGL_NO_DISPLAY)
+	{
+		display = eglGetDisplay( EGL_DEFAULT_DISPLAY );
+	}
+	
+	EGLint	majorVersion, minorVersion;
+	if ( (display == EGL_NO_DISPLAY) ||
+		(! eglInitialize( display, &majorVersion, &minorVersion )) )
+	{
+		Q3_LOG_FMT( "Failed to initialize an EGL display." );
+		throw std::exception();
+	}
+	Q3_MESSAGE_FMT( "Headless EGL %d.%d", (int)majorVersion, (int)minorVersion );
+	
+	
+	
+	// Choose a configuration.  The color, depth, and stencil buffers all
+	// belong to FBOs, so there is little to ask for.
+	const EGLint	configAttribs[] =
+	{
+		EGL_SURFACE_TYPE,		EGL_PBUFFER_BIT,
+		EGL_RENDERABLE_TYPE,	EGL_OPENGL_BIT,
+		EGL_RED_SIZE,			8,
+		EGL_GREEN_SIZE,			8,
+		EGL_BLUE_SIZE,			8,
+		EGL_NONE
+	};
+	EGLConfig	theConfig;
+	EGLint		numConfigs = 0;
+	if ( (! eglBindAPI( EGL_OPENGL_API )) ||
+		(! eglChooseConfig( display, configAttribs, &theConfig, 1, &numConfigs )) ||
+		(numConfigs == 0) )
+	{
+		Q3_LOG_FMT( "No suitable EGL configuration for desktop OpenGL." );
+		Cleanup();
+		throw std::exception();
+	}
+	
+	
+	
+	// Create the context, and a tiny pbuffer to make it current with if
+	// surfaceless contexts are not supported.
+	context = eglCreateContext( display, theConfig, EGL_NO_CONTEXT, nullptr );
+	if (context == EGL_NO_CONTEXT)
+	{
+		Q3_LOG_FMT( "eglCreateContext failed, error %X.", (int)eglGetError() );
+		Cleanup();
+		throw std::exception();
+	}
+	
+	if (! gldrawcontext_egl_has_extension( eglQueryString( display, EGL_EXTENSIONS ),
+		"EGL_KHR_surfaceless_context" ))
+	{
+		const EGLint	pbufferAttribs[] =
+		{
+			EGL_WIDTH,		1,
+			EGL_HEIGHT,		1,
+			EGL_NONE
+		};
+		surface = eglCreatePbufferSurface( display, theConfig, pbufferAttribs );
+		if (surface == EGL_NO_SURFACE)
+		{
+			Q3_LOG_FMT( "eglCreatePbufferSurface failed, error %X.", (int)eglGetError() );
+			Cleanup();
+			throw std::exception();
+		}
+	}
+	
+	if (! eglMakeCurrent( display, surface, surface, context ))
+	{
+		Q3_LOG_FMT( "eglMakeCurrent failed, error %X.", (int)eglGetError() );
+		Cleanup();
+		throw std::exception();
+	}
+	
+	
+	
+	// Get function pointers, now that the context is current
+	GLGetProcAddress( bindFrameBufferFunc, "glBindFramebuffer", "glBindFramebufferEXT" );
+	GLGetProcAddress( glGenBuffers, "glGenBuffers", "glGenBuffersARB" );
+	GLGetProcAddress( glDeleteBuffers, "glDeleteBuffers", "glDeleteBuffersARB" );
+	GLGetProcAddress( glBindBuffer, "glBindBuffer", "glBindBufferARB" );
+	GLGetProcAddress( glBufferData, "glBufferData", "glBufferDataARB" );
+	GLGetProcAddress( glMapBuffer, "glMapBuffer", "glMapBufferARB" );
+	GLGetProcAddress( glUnmapBuffer, "glUnmapBuffer", "glUnmapBufferARB" );
+	if ( (bindFrameBufferFunc == nullptr) || (glGenBuffers == nullptr) ||
+		(glDeleteBuffers == nullptr) || (glBindBuffer == nullptr) ||
+		(glBufferData == nullptr) || (glMapBuffer == nullptr) ||
+		(glUnmapBuffer == nullptr) )
+	{
+		Q3_LOG_FMT( "Headless EGL context lacks FBO or buffer object functions." );
+		Cleanup();
+		throw std::exception();
+	}
+	
+	GLGPUSharing_AddContext( this, nullptr );
+}
+
+EGLHeadlessContext::~EGLHeadlessContext()
+{
+	SetCurrentBase( kQ3True );
+	FinishReadbacks( nullptr );
+	
+	for (TQ3Uns32 i = 0; i < readbacks.size(); ++i)
+	{
+		glDeleteBuffers( 1, &readbacks[i].bufferID );
+	}
+	
+	// Forgetting the last context of a sharing group deletes its textures,
+	// which needs the context to still be current.
+	GLGPUSharing_RemoveContext( this );
+	
+	Cleanup();
+}
+
+void	EGLHeadlessContext::Cleanup()
+{
+	if (context != EGL_NO_CONTEXT)
+	{
+		eglMakeCurrent( display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT );
+		eglDestroyContext( display, context );
+		context = EGL_NO_CONTEXT;
+	}
+	
+	if (surface != EGL_NO_SURFACE)
+	{
+		eglDestroySurface( display, surface );
+		surface = EGL_NO_SURFACE;
+	}
+	
+	// The default display may also be in use by the application, so only
+	// terminate a display that we opened for ourselves.
+	if (ownsDisplay)
+	{
+		eglTerminate( display );
+	}
+	display = EGL_NO_DISPLAY;
+}
+
+/*!
+	@function	Acquire
+	@abstract	Get the shared headless context, creating it if need be, and
+				count another user of it.  Returns nullptr if EGL cannot give
+				us a context.
+*/
+EGLHeadlessContext*	EGLHeadlessContext::Acquire()
+{
+	std::lock_guard<std::mutex>	sharedLock( sSharedMutex );
+	
+	if (sShared == nullptr)
+	{
+		try
+		{
+			sShared = new EGLHeadlessContext;
+		}
+		catch (...)
+		{
+			Q3_LOG_FMT( "Failed to create a headless EGL context." );
+		}
+	}
+	
+	if (sShared != nullptr)
+	{
+		sShared->clientCount += 1;
+	}
+	
+	return sShared;
+}
+
+void	EGLHeadlessContext::Release()
+{
+	std::lock_guard<std::mutex>	sharedLock( sSharedMutex );
+	
+	Q3_ASSERT( clientCount > 0 );
+	clientCount -= 1;
+}
+
+/*!
+	@function	Terminate
+	@abstract	Destroy the shared headless context, if nobody is using it.
+*/
+void	EGLHeadlessContext::Terminate()
+{
+	std::lock_guard<std::mutex>	sharedLock( sSharedMutex );
+	
+	if ( (sShared != nullptr) && (sShared->clientCount == 0) )
+	{
+		delete sShared;
+		sShared = nullptr;
+	}
+}
+
+void	EGLHeadlessContext::SetCurrentBase( TQ3Boolean inForceSet )
+{
+	if (inForceSet || (eglGetCurrentContext() != context))
+	{
+		if (! eglMakeCurrent( display, surface, surface, context ))
+		{
+			// EGL_BAD_ACCESS means that another thread is rendering
+			// headless, which is not supported.
+			Q3_LOG_FMT( "eglMakeCurrent failed, error %X.", (int)eglGetError() );
+		}
+	}
+}
+
+void	EGLHeadlessContext::SetCurrent( TQ3Boolean inForceSet )
+{
+	SetCurrentBase( inForceSet );
+	
+	// Make sure that no FBO is active
+	if (GetCurrentFrameBuffer() != 0)
+	{
+		BindFrameBuffer( GL_FRAMEBUFFER_EXT, 0 );
+	}
+}
+
+void	EGLHeadlessContext::QueueReadback(
+								const void* inOwner,
+								TQ3DrawContextObject inPixmapDrawContext,
+								TQ3Uns32 inWidth,
+								TQ3Uns32 inHeight,
+								TQ3Uns32 inFramesInFlight )
+{
+	// Find a pack buffer that is not waiting to be read, or make one
+	TQ3Uns32	slot = 0;
+	while ( (slot < readbacks.size()) && (readbacks[slot].owner != nullptr) )
+	{
+		++slot;
+	}
+	if (slot == readbacks.size())
+	{
+		PixelReadback	newReadback = {};
+		glGenBuffers( 1, &newReadback.bufferID );
+		CHECK_GL_ERROR;
+		readbacks.push_back( newReadback );
+	}
+	PixelReadback&	theReadback( readbacks[ slot ] );
+	
+	
+	// Record where the pixels are to go
+	TQ3Pixmap	thePixMap;
+	Q3PixmapDrawContext_GetPixmap( inPixmapDrawContext, &thePixMap );
+	TQ3Area		thePane;
+	Q3DrawContext_GetPane( inPixmapDrawContext, &thePane );
+	theReadback.bytesPerPixel = thePixMap.pixelSize / 8;
+	theReadback.destRowBytes = thePixMap.rowBytes;
+	theReadback.destPixels = static_cast<TQ3Uns8*>( thePixMap.image ) +
+		static_cast<TQ3Uns32>( thePane.min.y ) * thePixMap.rowBytes +
+		static_cast<TQ3Uns32>( thePane.min.x ) * theReadback.bytesPerPixel;
+	theReadback.width = inWidth;
+	theReadback.height = inHeight;
+	
+	GLenum	pixelType, pixelFormat;
+	gldrawcontext_fbo_convert_pixel_format( theReadback.bytesPerPixel,
+		thePixMap.byteOrder, pixelFormat, pixelType );
+	GLsizeiptr	imageSize = static_cast<GLsizeiptr>( inWidth ) * inHeight *
+		theReadback.bytesPerPixel;
+	
+	
+	// Start the transfer.  With a pack buffer bound, glReadPixels returns
+	// without waiting for rendering to finish.
+	glBindBuffer( GL_PIXEL_PACK_BUFFER, theReadback.bufferID );
+	if (imageSize > theReadback.capacity)
+	{
+		glBufferData( GL_PIXEL_PACK_BUFFER, imageSize, nullptr, GL_STREAM_READ );
+		theReadback.capacity = imageSize;
+	}
+	glPixelStorei( GL_PACK_ROW_LENGTH, 0 );
+	glPixelStorei( GL_PACK_ALIGNMENT, 1 );
+	glPixelStorei( GL_PACK_SKIP_ROWS, 0 );
+	glPixelStorei( GL_PACK_SKIP_PIXELS, 0 );
+	glPixelStorei( GL_PACK_SWAP_BYTES, GL_FALSE );
+	glReadBuffer( GL_COLOR_ATTACHMENT0_EXT );
+	glReadPixels( 0, 0, inWidth, inHeight, pixelFormat, pixelType, nullptr );
+	glBindBuffer( GL_PIXEL_PACK_BUFFER, 0 );
+	CHECK_GL_ERROR;
+	glFlush();
+	
+	theReadback.owner = inOwner;
+	pendingReadbacks.push_back( slot );
+	
+	
+	// Wait for whatever exceeds the allowed depth of the pipeline
+	inFramesInFlight = E3Num_Min( inFramesInFlight, kMaxFramesInFlight );
+	while (pendingReadbacks.size() > inFramesInFlight)
+	{
+		FinishReadback( readbacks[ pendingReadbacks.front() ] );
+		pendingReadbacks.pop_front();
+	}
+}
+
+void	EGLHeadlessContext::FinishReadbacks( const void* inOwner )
+{
+	std::deque<TQ3Uns32>::iterator	i = pendingReadbacks.begin();
+	
+	while (i != pendingReadbacks.end())
+	{
+		if ( (inOwner == nullptr) || (readbacks[ *i ].owner == inOwner) )
+		{
+			FinishReadback( readbacks[ *i ] );
+			i = pendingReadbacks.erase( i );
+		}
+		else
+		{
+			++i;
+		}
+	}
+}
+
+void	EGLHeadlessContext::FinishReadback( PixelReadback& ioReadback )
+{
+	glBindBuffer( GL_PIXEL_PACK_BUFFER, ioReadback.bufferID );
+	const TQ3Uns8*	thePixels = static_cast<const TQ3Uns8*>(
+		glMapBuffer( GL_PIXEL_PACK_BUFFER, GL_READ_ONLY ) );
+	CHECK_GL_ERROR;
+	
+	if (thePixels != nullptr)
+	{
+		// Flip the rows on the way, since glReadPixels goes bottom to top.
+		TQ3Uns32	srcRowBytes = ioReadback.width * ioReadback.bytesPerPixel;
+		
+		for (TQ3Uns32 row = 0; row < ioReadback.height; ++row)
+		{
+			memcpy( ioReadback.destPixels + row * ioReadback.destRowBytes,
+				thePixels + (ioReadback.height - 1 - row) * srcRowBytes,
+				srcRowBytes );
+		}
+		
+		glUnmapBuffer( GL_PIXEL_PACK_BUFFER );
+	}
+	glBindBuffer( GL_PIXEL_PACK_BUFFER, 0 );
+	
+	ioReadback.owner = nullptr;
+}
+
+
+
+EGLPixmapContext::EGLPixmapContext(
+		TQ3DrawContextObject theDrawContext,
+		TQ3Uns32 inPaneWidth,
+		TQ3Uns32 inPaneHeight,
+		const TQ3GLExtensions& inExtensionInfo,
+		TQ3Uns32 depthBits,
+		TQ3Uns32 stencilBits,
+		EGLHeadlessContext* inHeadlessContext,
+		TQ3Uns32 inSamples )
+	: FBORec( theDrawContext, inPaneWidth, inPaneHeight, inExtensionInfo,
+		depthBits, stencilBits, nullptr,
+		static_cast<CQ3GLContext*>( inHeadlessContext ), false, inSamples )
+	, headlessContext( inHeadlessContext )
+	, hasNewFrame( false )
+{
+}
+
+EGLPixmapContext::~EGLPixmapContext()
+{
+	// The pixmap may not outlive this context, so deliver what is pending.
+	headlessContext->FinishReadbacks( this );
+	headlessContext->Release();
+}
+
+/*!
+	@function	StartFrame
+	@abstract	Note that there will be a frame to read back.
+*/
+void	EGLPixmapContext::StartFrame( QORenderer::PerPixelLighting& /*inPPL*/ )
+{
+	hasNewFrame = true;
+}
+
+/*!
+	@function	SwapBuffers
+	@abstract	Queue a readback of the new frame into the pixmap, or, if
+				nothing has been rendered since the last swap (as when
+				Q3View_Sync asks for one), finish all pending readbacks.
+*/
+void	EGLPixmapContext::SwapBuffers()
+{
+	SetCurrent( kQ3False );
+	
+	if (hasNewFrame)
+	{
+		hasNewFrame = false;
+		
+		if (frameBufferID_single != 0) // multisampling?
+		{
+			ResolveSamples();
+		}
+		
+		TQ3Uns32	framesInFlight = 0;
+		Q3Object_GetProperty( quesaDrawContext,
+			kQ3DrawContextPropertyGLAsyncReadback,
+			sizeof(framesInFlight), nullptr, &framesInFlight );
+		
+		headlessContext->QueueReadback( this, quesaDrawContext,
+			fboViewPort[2], fboViewPort[3], framesInFlight );
+	}
+	else
+	{
+		headlessContext->FinishReadbacks( nullptr );
+	}
+}
+
+
+
+/*!
+	@function	gldrawcontext_egl_new
+	@abstract	Create an FBO on the shared headless EGL context for a pixmap
+				draw context.  Returns nullptr on failure.
+*/
+static TQ3GLContext
+gldrawcontext_egl_new(	TQ3DrawContextObject theDrawContext,
+						TQ3Uns32 depthBits,
+						TQ3Uns32 stencilBits )
+{
+	TQ3GLContext	theContext = nullptr;
+	
+	if (! gldrawcontext_fbo_is_compatible_pixmap_format( theDrawContext ))
+	{
+		Q3_LOG_FMT( "Pixmap format not supported by headless EGL rendering." );
+		return nullptr;
+	}
+	
+	EGLHeadlessContext*	headlessContext = EGLHeadlessContext::Acquire();
+	if (headlessContext != nullptr)
+	{
+		TQ3Uns32 samples = 0;
+		Q3Object_GetProperty( theDrawContext,
+			kQ3DrawContextPropertyAccelOffscreenSamples,
+			sizeof(samples), nullptr, &samples );
+		
+		headlessContext->SetCurrent( kQ3False );
+		
+		TQ3GLExtensions		extFlags;
+		GLUtils_CheckExtensions( &extFlags );
+		
+		GLint	maxDimen;
+		glGetIntegerv( GL_MAX_RENDERBUFFER_SIZE_EXT, &maxDimen );
+		TQ3Uns32	paneWidth, paneHeight;
+		gldrawcontext_fbo_get_size( theDrawContext, paneWidth, paneHeight );
+		GLint	paneSize = E3Num_Max( paneWidth, paneHeight );
+		if ( (paneSize != 0) && (paneSize <= maxDimen) )
+		{
+			try
+			{
+				theContext = new EGLPixmapContext( theDrawContext,
+					paneWidth, paneHeight, extFlags,
+					depthBits, stencilBits,
+					headlessContext, samples );
+			}
+			catch (...)
+			{
+				Q3_LOG_FMT("Failed to set up %dx%d headless FBO.",
+					(int)paneWidth, (int)paneHeight );
+			}
+		}
+		else
+		{
+			Q3_LOG_FMT( "Pane size %dx%d too big for FBO.",
+				(int)paneWidth, (int)paneHeight );
+		}
+		
+		if (theContext == nullptr)
+		{
+			headlessContext->Release();
+		}
+	}
+	
+	return theContext;
+}
+
+#endif // QUESA_OS_UNIX && QUESA_USE_EGL
+
+
+
+
+
+
+
 #pragma mark -
 #if QUESA_OS_UNIX
 
@@ -1912,7 +2587,13 @@ GLDrawContext_New(TQ3ViewObject theView, TQ3DrawContextObject theDrawContext, GL
 			}
 		
 		#elif QUESA_OS_UNIX
-			glContext = new X11GLContext(theDrawContext);
+			#if QUESA_USE_EGL
+			if (dcType == kQ3DrawContextTypePixmap)
+				glContext = gldrawcontext_egl_new( theDrawContext,
+					preferredDepthBits, preferredStencilBits );
+			else
+			#endif
+				glContext = new X11GLContext(theDrawContext);
 
 		#elif QUESA_OS_WIN32
 			glContext = new WinGLContext( theDrawContext, preferredDepthBits,
@@ -2298,3 +2979,22 @@ TQ3Status			GLDrawContext_UpdateSize(
 	
 	return didUpdate;
 }
+
+
+
+
+
+//=============================================================================
+//		GLDrawContext_Terminate : Release OpenGL state kept between contexts.
+//-----------------------------------------------------------------------------
+//		Note :	Called when the OpenGL renderer is unregistered.  The headless
+//				EGL context used by pixmap draw contexts outlives the contexts
+//				built on it, so that its textures can be reused.
+//-----------------------------------------------------------------------------
+void
+GLDrawContext_Terminate()
+{
+#if QUESA_OS_UNIX && QUESA_USE_EGL
+	EGLHeadlessContext::Terminate();
+#endif
+}
@@ -107,6 +107,8 @@ TQ3Status			GLDrawContext_UpdateSize(
 								TQ3DrawContextObject	theDrawContext,
 								void					*glContext );
 
+void				GLDrawContext_Terminate(void);
+
 
 
 //=============================================================================
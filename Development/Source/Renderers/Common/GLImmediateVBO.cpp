@@ -270,6 +270,7 @@ void			RenderImmediateVBO(
 		{
 			(*inRenderer.Funcs().glBindBufferProc)( GL_ELEMENT_ARRAY_BUFFER, 0 );
 			glDrawArrays( inMode, 0, inNumPoints );
+			inRenderer.CountDrawCall();
 		}
 		else
 		{
@@ -283,6 +284,7 @@ void			RenderImmediateVBO(
 			
 			// Draw the elements
 			glDrawElements( inMode, inNumIndices, GL_UNSIGNED_INT, GLBufferObPtr( 0U ) );
+			inRenderer.CountDrawCall();
 		}
 		
 		(*inRenderer.Funcs().glBindBufferProc)( GL_ARRAY_BUFFER, 0 );
@@ -405,6 +407,7 @@ void			RenderImmediateTransVBO(
 		{
 			(*inRenderer.Funcs().glBindBufferProc)( GL_ELEMENT_ARRAY_BUFFER, 0 );
 			glDrawArrays( inMode, 0, inNumPoints );
+			inRenderer.CountDrawCall();
 		}
 		else
 		{
@@ -418,6 +421,7 @@ void			RenderImmediateTransVBO(
 			
 			// Draw the elements
 			glDrawElements( inMode, inNumIndices, GL_UNSIGNED_INT, GLBufferObPtr( 0U ) );
+			inRenderer.CountDrawCall();
 		}
 		
 		(*inRenderer.Funcs().glBindBufferProc)( GL_ARRAY_BUFFER, 0 );
@@ -480,6 +484,7 @@ void			RenderImmediateShadowVolumeVBO(
 		
 		// Draw the elements
 		glDrawElements( GL_TRIANGLES, inNumIndices, GL_UNSIGNED_INT, GLBufferObPtr( 0U ) );
+		inRenderer.CountDrawCall();
 		
 		(*inRenderer.Funcs().glBindBufferProc)( GL_ARRAY_BUFFER, 0 );
 		(*inRenderer.Funcs().glBindBufferProc)( GL_ELEMENT_ARRAY_BUFFER, 0 );
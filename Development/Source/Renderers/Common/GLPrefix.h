@@ -74,6 +74,16 @@
     #include <GL/glx.h>
     #include <GL/glu.h>
 
+// Headless EGL contexts for pixmap draw contexts (link with -lEGL)
+    #ifndef QUESA_USE_EGL
+        #define QUESA_USE_EGL 0
+    #endif
+
+    #if QUESA_USE_EGL
+        #include <EGL/egl.h>
+        #include <EGL/eglext.h>
+    #endif
+
 #endif
 
 
@@ -124,7 +134,7 @@ public:
 	
 	virtual void		SwapBuffers() = 0;
 	
-	virtual void		StartFrame( QORenderer::PerPixelLighting& inPPL ) {}
+	virtual void		StartFrame( QORenderer::PerPixelLighting& /*inPPL*/ ) {}
 
 						// Make the platform OpenGL context current, but
 						// do not alter the framebuffer binding.
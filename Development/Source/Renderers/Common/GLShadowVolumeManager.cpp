@@ -436,6 +436,7 @@ void	ShadowVolCache::RenderVBO( ShadowVBO* inCachedVBO, const QORenderer::Render
 		{
 			glDrawElements( GL_TRIANGLES, inCachedVBO->mNumTriIndices,
 				GL_UNSIGNED_INT, GLBufferObPtr( 0U ) );
+			inRenderer.CountDrawCall();
 		}
 
 		(*inRenderer.Funcs().glBindBufferProc)( GL_ARRAY_BUFFER, 0 );
@@ -471,6 +471,14 @@ void*	GLGetProcAddress( const char* funcName )
 
 void*	GLGetProcAddress( const char* funcName )
 {
+#if QUESA_USE_EGL
+	// A headless pixmap context is an EGL context, not a GLX one
+	if (eglGetCurrentContext() != EGL_NO_CONTEXT)
+	{
+		return (void*)eglGetProcAddress( funcName );
+	}
+#endif
+
 	return (void*)glXGetProcAddressARB( (const GLubyte*)funcName );
 }
 
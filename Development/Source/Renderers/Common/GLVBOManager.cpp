@@ -689,6 +689,7 @@ void VBOCache::RenderVBO( const QORenderer::Renderer& inRenderer, const CachedVB
 	glDrawElements( inCachedVBO->mGLMode, inCachedVBO->mNumIndices,
 		GL_UNSIGNED_INT, GLBufferObPtr( 0U ) );
 	CHECK_GL_ERROR;
+	inRenderer.CountDrawCall();
 		
 	(*inRenderer.Funcs().glBindBufferProc)( GL_ARRAY_BUFFER, 0 );
 	(*inRenderer.Funcs().glBindBufferProc)( GL_ELEMENT_ARRAY_BUFFER, 0 );
@@ -51,165 +51,89 @@
 //-----------------------------------------------------------------------------
 #include "StripMaker.h"
 
-#include <algorithm>
-
-
-//=============================================================================
-//      Local Types
-//-----------------------------------------------------------------------------
-
-namespace StripMaker
-{
-	/*!
-		@struct		Edge
-		@abstract	An edge.  Used to compute face adjacencies.
-		@field		vertex		Vertex indices in increasing order.
-		@field		ownerFace	Index of face from which we obtained the edge.
-		@field		isFlipped	True if the order of vertices here is the
-								opposite of the orientation order of the
-								vertices in the owner face.
-		@field		edgeIndex	Which edge of the owner, 0, 1, or 2.
-	*/
-	struct Edge
-	{
-		TQ3Uns32	vertex[2];
-		TQ3Uns32	ownerFace;
-		bool		isFlipped;
-		TQ3Uns32	edgeIndex;
-	};
-	
-	/*!
-		@typedef	EdgeVec
-		@abstract	Vector of edges.
-	*/
-	typedef std::vector< Edge >	EdgeVec;
+#include "E3EdgeAdjacency.h"
 
 
 //=============================================================================
 //      Local Functions
 //-----------------------------------------------------------------------------
 
-	static bool operator<( const Edge& A, const Edge& B )
-	{
-		return
-			(A.vertex[0] < B.vertex[0])
-			||
-			(
-				(A.vertex[0] == B.vertex[0])
-				&&
-				(
-					(A.vertex[1] < B.vertex[1])
-					||
-					(
-						(A.vertex[1] == B.vertex[1])
-						&&
-						(A.isFlipped < B.isFlipped)
-					)
-				)
-			);
-	}
-}
-
 using namespace StripMaker;
 
-static bool HasSameEnds( const Edge& A, const Edge& B )
+static void MakeAdjacent( TQ3Uns32 inHalfEdgeA, TQ3Uns32 inHalfEdgeB,
+							FaceVec& ioFaces )
 {
-	return
-		(A.vertex[0] == B.vertex[0])
-		&&
-		(A.vertex[1] == B.vertex[1]);
-}
-
-static void MakeEdge(
-					TQ3Uns32 inFaceIndex,
-					TQ3Uns32 inEdgeIndex,
-					TQ3Uns32 inStart,
-					TQ3Uns32 inEnd,
-					EdgeVec& ioEdges )
-{
-	Edge	theEdge;
-	theEdge.ownerFace = inFaceIndex;
-	theEdge.edgeIndex = inEdgeIndex;
+	// Half edge 3 * f + k runs from vertex k to vertex k+1, which is the
+	// edge (k + 2) % 3 of a Face.
+	TQ3Uns32	faceIndexA = inHalfEdgeA / 3;
+	TQ3Uns32	faceIndexB = inHalfEdgeB / 3;
+	TQ3Uns32	edgeIndexA = (inHalfEdgeA + 2) % 3;
+	TQ3Uns32	edgeIndexB = (inHalfEdgeB + 2) % 3;
+	Face&	faceA( ioFaces[ faceIndexA ] );
+	Face&	faceB( ioFaces[ faceIndexB ] );
 	
-	if (inStart < inEnd)
-	{
-		theEdge.vertex[0] = inStart;
-		theEdge.vertex[1] = inEnd;
-		theEdge.isFlipped = false;
-	}
-	else
-	{
-		theEdge.vertex[0] = inEnd;
-		theEdge.vertex[1] = inStart;
-		theEdge.isFlipped = true;
-	}
-	ioEdges.push_back( theEdge );
-}
-
-static void CreateEdges( const FaceVec& inFaces, EdgeVec& outEdges )
-{
-	outEdges.clear();
-	outEdges.reserve( 3 * inFaces.size() );
-	const TQ3Uns32	kNumFaces = static_cast<TQ3Uns32>(inFaces.size());
-	
-	for (TQ3Uns32 i = 0; i < kNumFaces; ++i)
-	{
-		const Face& theFace( inFaces[i] );
-		MakeEdge( i, 2, theFace.vertex[0], theFace.vertex[1], outEdges );
-		MakeEdge( i, 0, theFace.vertex[1], theFace.vertex[2], outEdges );
-		MakeEdge( i, 1, theFace.vertex[2], theFace.vertex[0], outEdges );
-	}
-}
-
-static void MakeAdjacent( const Edge& inA, const Edge& inB, FaceVec& ioFaces )
-{
-	Face&	faceA( ioFaces[ inA.ownerFace ] );
-	Face&	faceB( ioFaces[ inB.ownerFace ] );
-	
-	faceA.adjFace[ inA.edgeIndex ] = inB.ownerFace;
-	faceA.adjEdge[ inA.edgeIndex ] = inB.edgeIndex;
+	faceA.adjFace[ edgeIndexA ] = faceIndexB;
+	faceA.adjEdge[ edgeIndexA ] = edgeIndexB;
 	
-	faceB.adjFace[ inB.edgeIndex ] = inA.ownerFace;
-	faceB.adjEdge[ inB.edgeIndex ] = inA.edgeIndex;
+	faceB.adjFace[ edgeIndexB ] = faceIndexA;
+	faceB.adjEdge[ edgeIndexB ] = edgeIndexA;
 }
 
 	/*!
 		@function	FindAdjacencies
 		@abstract	Initialize the adjFace and adjEdge links in a vector of
 					faces.
+		@discussion	Among the faces sharing an edge, each face using the edge
+					in one direction is paired with a face using it in the
+					other direction, as long as both kinds remain.
 	*/
 void StripMaker::FindAdjacencies( FaceVec& ioFaces )
 {
-	EdgeVec	theEdges;
-	CreateEdges( ioFaces, theEdges );
-	std::sort( theEdges.begin(), theEdges.end() );
+	const TQ3Uns32 kNumFaces = static_cast<TQ3Uns32>(ioFaces.size());
+	std::vector<TQ3Uns32>	faceVerts( 3 * kNumFaces );
+	for (TQ3Uns32 i = 0; i < kNumFaces; ++i)
+	{
+		faceVerts[ 3 * i ] = ioFaces[i].vertex[0];
+		faceVerts[ 3 * i + 1 ] = ioFaces[i].vertex[1];
+		faceVerts[ 3 * i + 2 ] = ioFaces[i].vertex[2];
+	}
+	const TQ3Uns32*	theVerts = (kNumFaces == 0)? nullptr : &faceVerts[0];
+	
+	TE3EdgeAdjacency	theAdjacency;
+	E3EdgeAdjacency_Build( kNumFaces, theVerts, theAdjacency );
 	
-	const TQ3Uns32 kNumEdges = static_cast<TQ3Uns32>(theEdges.size());
-	TQ3Uns32	runStart, nextRunStart;
-	runStart = 0;
+	const TQ3Uns32 kNumEdges = static_cast<TQ3Uns32>(
+		theAdjacency.edgeEnds.size() / 2 );
 	
-	while (runStart < kNumEdges)
+	for (TQ3Uns32 e = 0; e < kNumEdges; ++e)
 	{
-		nextRunStart = runStart + 1;
-		while ( (nextRunStart < kNumEdges) &&
-			HasSameEnds( theEdges[runStart], theEdges[nextRunStart] ) )
+		const TQ3Uns32*	halfEdges = &theAdjacency.edgeHalfEdges[0] +
+			theAdjacency.edgeHalfEdgeStart[ e ];
+		const TQ3Uns32	kNumHalfEdges = theAdjacency.edgeHalfEdgeStart[ e + 1 ] -
+			theAdjacency.edgeHalfEdgeStart[ e ];
+		TQ3Uns32	forward = 0;
+		TQ3Uns32	backward = 0;
+		
+		for (;;)
 		{
-			++nextRunStart;
-		}
-		// At this point, the edges with index runStart to nextRunStart-1 all
-		// have the same ends.  The ones with isFlipped == true will be
-		// grouped at the end of that run.
-		TQ3Uns32	pairFirst = runStart;
-		TQ3Uns32	pairLast = nextRunStart-1;
-		while ( (pairFirst < pairLast) &&
-			(theEdges[pairFirst].isFlipped != theEdges[pairLast].isFlipped) )
-		{
-			MakeAdjacent( theEdges[pairFirst], theEdges[pairLast], ioFaces );
+			while ( (forward < kNumHalfEdges) &&
+				E3EdgeAdjacency_IsFlipped( theVerts, halfEdges[ forward ] ) )
+			{
+				++forward;
+			}
+			while ( (backward < kNumHalfEdges) &&
+				! E3EdgeAdjacency_IsFlipped( theVerts, halfEdges[ backward ] ) )
+			{
+				++backward;
+			}
+			if ( (forward == kNumHalfEdges) || (backward == kNumHalfEdges) )
+			{
+				break;
+			}
 			
-			++pairFirst;
-			--pairLast;
+			MakeAdjacent( halfEdges[ forward ], halfEdges[ backward ], ioFaces );
+			++forward;
+			++backward;
 		}
-		runStart = nextRunStart;
 	}
 }
-
@@ -0,0 +1,433 @@
+/*  NAME:
+        VertexCacheOptimizer.cpp
+
+    DESCRIPTION:
+        Quesa vertex cache optimizer.
+
+    REMARKS:
+    	The triangle ordering is based on Tom Forsyth's article "Linear-Speed
+    	Vertex Cache Optimisation" at
+    	<https://tomforsyth1000.github.io/papers/fast_vert_cache_opt.html>,
+    	but is not based on his source code.
+
+    COPYRIGHT:
+        Copyright (c) 2026, Quesa Developers. All rights reserved.
+
+        For the current release of Quesa, please see:
+
+            <https://github.com/jwwalker/Quesa>
+        
+        Redistribution and use in source and binary forms, with or without
+        modification, are permitted provided that the following conditions
+        are met:
+        
+            o Redistributions of source code must retain the above copyright
+              notice, this list of conditions and the following disclaimer.
+        
+            o Redistributions in binary form must reproduce the above
+              copyright notice, this list of conditions and the following
+              disclaimer in the documentation and/or other materials provided
+              with the distribution.
+        
+            o Neither the name of Quesa nor the names of its contributors
+              may be used to endorse or promote products derived from this
+              software without specific prior written permission.
+        
+        THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+        "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+        LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+        A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+        OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+        SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+        TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+        PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+        LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+        NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+        SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+    ___________________________________________________________________________
+*/
+
+
+//=============================================================================
+//      Include files
+//-----------------------------------------------------------------------------
+
+#include "VertexCacheOptimizer.h"
+
+#include <algorithm>
+#include <cmath>
+
+
+
+//=============================================================================
+//      Internal constants
+//-----------------------------------------------------------------------------
+
+namespace
+{
+	// Scoring parameters from Forsyth's article.
+	const float		kCacheDecayPower	= 1.5f;
+	const float		kLastTriScore		= 0.75f;
+	const float		kValenceBoostScale	= 2.0f;
+	const float		kValenceBoostPower	= 0.5f;
+	
+	const TQ3Uns32	kInvalidIndex		= 0xFFFFFFFFU;
+	const TQ3Int32	kNotInCache			= -1;
+
+
+
+//=============================================================================
+//      Internal types
+//-----------------------------------------------------------------------------
+
+	struct VertInfo
+	{
+		TQ3Int32	cachePos;		// kNotInCache or position in the cache
+		TQ3Uns32	firstTri;		// start of this vertex's faces in triList
+		TQ3Uns32	numActiveTris;	// faces using this vertex not yet output
+		float		score;
+	};
+}
+
+
+
+//=============================================================================
+//      Local Functions
+//-----------------------------------------------------------------------------
+
+/*!
+	@function	CalcVertexScore
+	
+	@abstract	Score a vertex by how much we want to output a face using it.
+	
+	@discussion	The 3 vertices of the last face output score a fixed amount, so
+				that we do not favor any particular order of them.  Beyond that
+				the score falls off with the position in the cache.  Vertices
+				with few faces left get a boost, so that we finish off lone
+				faces rather than leaving them for later.
+*/
+static float CalcVertexScore( const VertInfo& inVert )
+{
+	if (inVert.numActiveTris == 0)
+	{
+		return -1.0f;	// no faces left to output
+	}
+	
+	float	theScore = 0.0f;
+	
+	if (inVert.cachePos < 3)
+	{
+		if (inVert.cachePos >= 0)
+		{
+			theScore = kLastTriScore;
+		}
+	}
+	else
+	{
+		const float	kScaler = 1.0f / (kVertexCacheOptimizerCacheSize - 3);
+		theScore = 1.0f - (inVert.cachePos - 3) * kScaler;
+		theScore = std::pow( theScore, kCacheDecayPower );
+	}
+	
+	theScore += kValenceBoostScale * std::pow(
+		static_cast<float>(inVert.numActiveTris), -kValenceBoostPower );
+	
+	return theScore;
+}
+
+
+/*!
+	@function	RemoveActiveTri
+	
+	@abstract	Remove one occurrence of a face from the list of faces of a
+				vertex that have not been output.
+*/
+static void RemoveActiveTri( VertInfo& ioVert, TQ3Uns32 inTri,
+							std::vector<TQ3Uns32>& ioTriList )
+{
+	TQ3Uns32*	theTris = &ioTriList[ ioVert.firstTri ];
+	
+	for (TQ3Uns32 i = 0; i < ioVert.numActiveTris; ++i)
+	{
+		if (theTris[i] == inTri)
+		{
+			ioVert.numActiveTris -= 1;
+			std::swap( theTris[i], theTris[ ioVert.numActiveTris ] );
+			break;
+		}
+	}
+}
+
+
+
+//=============================================================================
+//      Public Functions
+//-----------------------------------------------------------------------------
+
+/*!
+	@function	OptimizeTriangleOrder
+	
+	@abstract	Reorder the faces of an indexed triangle list so that vertices
+				are reused while they are still in a post-transform vertex
+				cache.
+	
+	@discussion	This is a greedy algorithm.  Each vertex gets a score from its
+				position in a simulated LRU cache and from the number of its
+				faces not yet output, each face gets the sum of the scores of
+				its vertices, and we repeatedly output the face with the best
+				score.  Only the faces of vertices in the cache change score
+				after each step, so the best face is normally found among
+				them.  When none of them has any faces left, we take the next
+				face not yet output in the original order.
+	
+	@param		inNumFaces	Number of faces in following array.
+	@param		inFaces		Vertex indices of faces.  The size of this array
+							must be 3 times inNumFaces.
+	@param		inNumPoints	Number of vertices.  Every index in inFaces must
+							be less than this.
+	@param		outFaces	Receives the vertex indices of the reordered
+							faces.
+*/
+void	OptimizeTriangleOrder(
+					TQ3Uns32 inNumFaces,
+					const TQ3Uns32* inFaces,
+					TQ3Uns32 inNumPoints,
+					std::vector<TQ3Uns32>& outFaces )
+{
+	outFaces.clear();
+	outFaces.reserve( 3 * inNumFaces );
+	
+	if (inNumFaces == 0)
+	{
+		return;
+	}
+	
+	
+	// Find the faces of each vertex, as slices of one array.
+	const VertInfo	kInitVert = { kNotInCache, 0, 0, 0.0f };
+	std::vector<VertInfo>	theVerts( inNumPoints, kInitVert );
+	std::vector<TQ3Uns32>	triList( 3 * inNumFaces );
+	TQ3Uns32	i, j;
+	
+	for (i = 0; i < 3 * inNumFaces; ++i)
+	{
+		theVerts[ inFaces[i] ].numActiveTris += 1;
+	}
+	
+	TQ3Uns32	sliceStart = 0;
+	for (i = 0; i < inNumPoints; ++i)
+	{
+		theVerts[i].firstTri = sliceStart;
+		sliceStart += theVerts[i].numActiveTris;
+		theVerts[i].numActiveTris = 0;
+	}
+	
+	for (i = 0; i < 3 * inNumFaces; ++i)
+	{
+		VertInfo&	theVert( theVerts[ inFaces[i] ] );
+		triList[ theVert.firstTri + theVert.numActiveTris ] = i / 3;
+		theVert.numActiveTris += 1;
+	}
+	
+	
+	// Initial scores
+	for (i = 0; i < inNumPoints; ++i)
+	{
+		theVerts[i].score = CalcVertexScore( theVerts[i] );
+	}
+	
+	std::vector<float>	triScores( inNumFaces );
+	std::vector<bool>	isTriAdded( inNumFaces, false );
+	TQ3Uns32	bestTri = 0;
+	
+	for (i = 0; i < inNumFaces; ++i)
+	{
+		triScores[i] = theVerts[ inFaces[3*i] ].score +
+			theVerts[ inFaces[3*i+1] ].score +
+			theVerts[ inFaces[3*i+2] ].score;
+		
+		if (triScores[i] > triScores[ bestTri ])
+		{
+			bestTri = i;
+		}
+	}
+	
+	
+	// Output faces one at a time.
+	std::vector<TQ3Uns32>	theCache, newCache;
+	theCache.reserve( kVertexCacheOptimizerCacheSize + 3 );
+	newCache.reserve( kVertexCacheOptimizerCacheSize + 3 );
+	TQ3Uns32	scanCursor = 0;
+	
+	for (TQ3Uns32 numAdded = 0; numAdded < inNumFaces; ++numAdded)
+	{
+		if (bestTri == kInvalidIndex)
+		{
+			while (isTriAdded[ scanCursor ])
+			{
+				++scanCursor;
+			}
+			bestTri = scanCursor;
+		}
+		
+		const TQ3Uns32*	theFace = &inFaces[ 3 * bestTri ];
+		outFaces.insert( outFaces.end(), theFace, theFace + 3 );
+		isTriAdded[ bestTri ] = true;
+		
+		
+		// Put the vertices of the face at the front of the cache.
+		newCache.clear();
+		for (j = 0; j < 3; ++j)
+		{
+			RemoveActiveTri( theVerts[ theFace[j] ], bestTri, triList );
+			
+			if (std::find( newCache.begin(), newCache.end(), theFace[j] ) ==
+				newCache.end())
+			{
+				newCache.push_back( theFace[j] );
+			}
+		}
+		for (i = 0; i < theCache.size(); ++i)
+		{
+			if ( (theCache[i] != theFace[0]) && (theCache[i] != theFace[1]) &&
+				(theCache[i] != theFace[2]) )
+			{
+				newCache.push_back( theCache[i] );
+			}
+		}
+		
+		
+		// Rescore the vertices in the cache, and those just pushed out of
+		// it.
+		for (i = 0; i < newCache.size(); ++i)
+		{
+			VertInfo&	theVert( theVerts[ newCache[i] ] );
+			theVert.cachePos = (i < kVertexCacheOptimizerCacheSize)?
+				static_cast<TQ3Int32>( i ) : kNotInCache;
+			theVert.score = CalcVertexScore( theVert );
+		}
+		
+		
+		// Rescore the faces of those vertices, and find the best one.
+		bestTri = kInvalidIndex;
+		float	bestScore = -1.0f;
+		
+		for (i = 0; i < newCache.size(); ++i)
+		{
+			const VertInfo&	theVert( theVerts[ newCache[i] ] );
+			
+			for (j = 0; j < theVert.numActiveTris; ++j)
+			{
+				TQ3Uns32	theTri = triList[ theVert.firstTri + j ];
+				triScores[ theTri ] = theVerts[ inFaces[3*theTri] ].score +
+					theVerts[ inFaces[3*theTri+1] ].score +
+					theVerts[ inFaces[3*theTri+2] ].score;
+				
+				if (triScores[ theTri ] > bestScore)
+				{
+					bestScore = triScores[ theTri ];
+					bestTri = theTri;
+				}
+			}
+		}
+		
+		if (newCache.size() > kVertexCacheOptimizerCacheSize)
+		{
+			newCache.resize( kVertexCacheOptimizerCacheSize );
+		}
+		theCache.swap( newCache );
+	}
+}
+
+
+/*!
+	@function	OptimizeVertexOrder
+	
+	@abstract	Renumber vertices in the order in which the faces first use
+				them, for locality of vertex fetches.
+	
+	@param		inNumPoints		Number of vertices.
+	@param		ioFaces			Vertex indices of faces, renumbered in place.
+	@param		outNewToOld		Receives the old index of each new vertex.
+*/
+void	OptimizeVertexOrder(
+					TQ3Uns32 inNumPoints,
+					std::vector<TQ3Uns32>& ioFaces,
+					std::vector<TQ3Uns32>& outNewToOld )
+{
+	std::vector<TQ3Uns32>	oldToNew( inNumPoints, kInvalidIndex );
+	outNewToOld.clear();
+	outNewToOld.reserve( inNumPoints );
+	
+	for (TQ3Uns32& theIndex : ioFaces)
+	{
+		if (oldToNew[ theIndex ] == kInvalidIndex)
+		{
+			oldToNew[ theIndex ] = static_cast<TQ3Uns32>( outNewToOld.size() );
+			outNewToOld.push_back( theIndex );
+		}
+		theIndex = oldToNew[ theIndex ];
+	}
+	
+	for (TQ3Uns32 i = 0; i < inNumPoints; ++i)
+	{
+		if (oldToNew[i] == kInvalidIndex)
+		{
+			outNewToOld.push_back( i );
+		}
+	}
+}
+
+
+/*!
+	@function	SimulateVertexCache
+	
+	@abstract	Count the transformed vertices needed to draw an indexed
+				triangle list through a FIFO vertex cache.
+	
+	@discussion	A vertex enters the cache on a miss and leaves it after
+				inCacheSize more misses, so we only need to record the miss
+				count at which each vertex last entered the cache.
+	
+	@param		inNumFaces	Number of faces in following array.
+	@param		inFaces		Vertex indices of faces.  The size of this array
+							must be 3 times inNumFaces.
+	@param		inNumPoints	Number of vertices.  Every index in inFaces must
+							be less than this.
+	@param		inCacheSize	Number of entries in the simulated cache.
+	@param		outACMR		Receives the average cache miss ratio.
+	@param		outATVR		Receives the average transform to vertex ratio.
+*/
+void	SimulateVertexCache(
+					TQ3Uns32 inNumFaces,
+					const TQ3Uns32* inFaces,
+					TQ3Uns32 inNumPoints,
+					TQ3Uns32 inCacheSize,
+					float& outACMR,
+					float& outATVR )
+{
+	// Miss count just after each vertex entered the cache, or 0 if never.
+	std::vector<TQ3Uns32>	entryTime( inNumPoints, 0 );
+	TQ3Uns32	numMisses = 0;
+	TQ3Uns32	numUsedVerts = 0;
+	
+	for (TQ3Uns32 i = 0; i < 3 * inNumFaces; ++i)
+	{
+		TQ3Uns32&	theTime( entryTime[ inFaces[i] ] );
+		
+		if ( (theTime == 0) || (numMisses - theTime >= inCacheSize) )
+		{
+			if (theTime == 0)
+			{
+				++numUsedVerts;
+			}
+			++numMisses;
+			theTime = numMisses;
+		}
+	}
+	
+	outACMR = (inNumFaces == 0)? 0.0f :
+		static_cast<float>( numMisses ) / inNumFaces;
+	outATVR = (numUsedVerts == 0)? 0.0f :
+		static_cast<float>( numMisses ) / numUsedVerts;
+}
@@ -0,0 +1,154 @@
+/*  NAME:
+        VertexCacheOptimizer.h
+
+    DESCRIPTION:
+        Header for Quesa vertex cache optimizer.
+
+    REMARKS:
+    	The triangle ordering is based on Tom Forsyth's article "Linear-Speed
+    	Vertex Cache Optimisation" at
+    	<https://tomforsyth1000.github.io/papers/fast_vert_cache_opt.html>,
+    	but is not based on his source code.
+
+    COPYRIGHT:
+        Copyright (c) 2026, Quesa Developers. All rights reserved.
+
+        For the current release of Quesa, please see:
+
+            <https://github.com/jwwalker/Quesa>
+        
+        Redistribution and use in source and binary forms, with or without
+        modification, are permitted provided that the following conditions
+        are met:
+        
+            o Redistributions of source code must retain the above copyright
+              notice, this list of conditions and the following disclaimer.
+        
+            o Redistributions in binary form must reproduce the above
+              copyright notice, this list of conditions and the following
+              disclaimer in the documentation and/or other materials provided
+              with the distribution.
+        
+            o Neither the name of Quesa nor the names of its contributors
+              may be used to endorse or promote products derived from this
+              software without specific prior written permission.
+        
+        THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+        "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+        LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+        A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+        OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+        SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+        TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+        PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+        LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+        NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+        SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+    ___________________________________________________________________________
+*/
+
+
+#ifndef	VERTEXCACHEOPTIMIZER_HDR
+#define	VERTEXCACHEOPTIMIZER_HDR
+
+//=============================================================================
+//      Include files
+//-----------------------------------------------------------------------------
+
+#include "E3Prefix.h"
+
+#include <vector>
+
+
+
+//=============================================================================
+//      Constants
+//-----------------------------------------------------------------------------
+
+// Size of the post-transform vertex cache that the optimizer aims at.
+const TQ3Uns32	kVertexCacheOptimizerCacheSize	= 32;
+
+
+
+//=============================================================================
+//      Function declarations
+//-----------------------------------------------------------------------------
+
+/*!
+	@function	OptimizeTriangleOrder
+	
+	@abstract	Reorder the faces of an indexed triangle list so that vertices
+				are reused while they are still in a post-transform vertex
+				cache.
+	
+	@discussion	The set of faces is given as a single array, as in MakeStrip.
+				Each face keeps its vertex indices in the same order, so the
+				result draws the same triangles, with the same orientations,
+				in a different order.
+	
+	@param		inNumFaces	Number of faces in following array.
+	@param		inFaces		Vertex indices of faces.  The size of this array
+							must be 3 times inNumFaces.
+	@param		inNumPoints	Number of vertices.  Every index in inFaces must
+							be less than this.
+	@param		outFaces	Receives the vertex indices of the reordered
+							faces.
+*/
+void	OptimizeTriangleOrder(
+					TQ3Uns32 inNumFaces,
+					const TQ3Uns32* inFaces,
+					TQ3Uns32 inNumPoints,
+					std::vector<TQ3Uns32>& outFaces );
+
+
+/*!
+	@function	OptimizeVertexOrder
+	
+	@abstract	Renumber vertices in the order in which the faces first use
+				them, for locality of vertex fetches.
+	
+	@discussion	Vertices that are not used by any face keep their data but
+				are moved after all used vertices.  The caller must reorder
+				each per-vertex array to match, so that new vertex i takes the
+				data of old vertex outNewToOld[i].
+	
+	@param		inNumPoints		Number of vertices.
+	@param		ioFaces			Vertex indices of faces, renumbered in place.
+	@param		outNewToOld		Receives the old index of each new vertex.
+*/
+void	OptimizeVertexOrder(
+					TQ3Uns32 inNumPoints,
+					std::vector<TQ3Uns32>& ioFaces,
+					std::vector<TQ3Uns32>& outNewToOld );
+
+
+/*!
+	@function	SimulateVertexCache
+	
+	@abstract	Count the transformed vertices needed to draw an indexed
+				triangle list through a FIFO vertex cache.
+	
+	@discussion	The average cache miss ratio (ACMR) is the number of cache
+				misses per triangle, which is at best about 0.5 for a large
+				regular mesh and at worst 3.  The average transform to vertex
+				ratio (ATVR) is the number of cache misses per vertex used by
+				the faces, which is at best 1.
+	
+	@param		inNumFaces	Number of faces in following array.
+	@param		inFaces		Vertex indices of faces.  The size of this array
+							must be 3 times inNumFaces.
+	@param		inNumPoints	Number of vertices.  Every index in inFaces must
+							be less than this.
+	@param		inCacheSize	Number of entries in the simulated cache.
+	@param		outACMR		Receives the average cache miss ratio.
+	@param		outATVR		Receives the average transform to vertex ratio.
+*/
+void	SimulateVertexCache(
+					TQ3Uns32 inNumFaces,
+					const TQ3Uns32* inFaces,
+					TQ3Uns32 inNumPoints,
+					TQ3Uns32 inCacheSize,
+					float& outACMR,
+					float& outATVR );
+
+#endif	// VERTEXCACHEOPTIMIZER_HDR
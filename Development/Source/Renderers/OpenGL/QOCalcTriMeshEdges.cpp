@@ -42,10 +42,9 @@
 */
 #include "QOCalcTriMeshEdges.h"
 #include "E3Main.h"
+#include "E3EdgeAdjacency.h"
 #include "CQ3ObjectRef.h"
 
-#include <algorithm>
-
 
 namespace
 {
@@ -60,93 +59,8 @@ namespace
 		// Variable-size array of TQ3EdgeEnds
 		// Variable-size array of TQ3TriangleEdges
 	};
-	
-	struct EdgeIndexCompare
-	{
-				EdgeIndexCompare( const TQ3EdgeEnds* inEdges )
-					: mEdges( inEdges ) {}
-				EdgeIndexCompare( const EdgeIndexCompare& inOther )
-					: mEdges( inOther.mEdges ) {}
-		
-		bool	operator()( TQ3Uns32 inA, TQ3Uns32 inB ) const
-					{
-						const TQ3EdgeEnds&	ea( mEdges[inA] );
-						const TQ3EdgeEnds&	eb( mEdges[inB] );
-						
-						return
-							(ea.pointIndices[0] < eb.pointIndices[0])
-							||
-							(
-								(ea.pointIndices[0] == eb.pointIndices[0])
-								&&
-								(ea.pointIndices[1] < eb.pointIndices[1])
-							);
-					}
-		
-		const TQ3EdgeEnds*	mEdges;
-	};
-}
-
-
-static bool HasSameEnds( const TQ3EdgeEnds& A, const TQ3EdgeEnds& B )
-{
-	return
-		(A.pointIndices[0] == B.pointIndices[0])
-		&&
-		(A.pointIndices[1] == B.pointIndices[1]);
-}
-
-
-
-static void SetEdge(
-						TQ3Uns32 inStart,
-						TQ3Uns32 inEnd,
-						TQ3EdgeEnds& outEdge )
-{
-	TQ3Uns32	lessPt, greaterPt;
-	if (inStart < inEnd)
-	{
-		lessPt = inStart;
-		greaterPt = inEnd;
-	}
-	else
-	{
-		lessPt = inEnd;
-		greaterPt = inStart;
-	}
-	outEdge.pointIndices[0] = lessPt;
-	outEdge.pointIndices[1] = greaterPt;
 }
 
-/*!
-	@function	CreateRedundantEdges
-	@abstract	Create 3 edges for each face.  This will often create multiple
-				copies of each physical edge.
-*/
-static void CreateRedundantEdges(
-							const TQ3TriMeshData& inData,
-							TQ3EdgeVec& outEdges,
-							TQ3TriangleToEdgeVec& outFacesToEdges )
-{
-	outEdges.resizeNotPreserving( 3 * inData.numTriangles );
-	outFacesToEdges.resizeNotPreserving( inData.numTriangles );
-	
-	TQ3Uns32	edgeNum = 0;
-	TQ3Uns32	faceNum = 0;
-	
-	for ( TQ3Uns32 i = 0; i < inData.numTriangles; ++i )
-	{
-		TQ3TriangleEdges	theEdges = {{
-			edgeNum, edgeNum + 1, edgeNum + 2
-		}};
-		outFacesToEdges[ faceNum++ ] = theEdges;
-		
-		const TQ3TriMeshTriangleData& theFace( inData.triangles[i] );
-		SetEdge( theFace.pointIndices[0], theFace.pointIndices[1], outEdges[edgeNum++] );
-		SetEdge( theFace.pointIndices[1], theFace.pointIndices[2], outEdges[edgeNum++] );
-		SetEdge( theFace.pointIndices[2], theFace.pointIndices[0], outEdges[edgeNum++] );
-	}
-}
 
 /*!
 	@function	QOCalcTriMeshEdges
@@ -168,78 +82,38 @@ void QOCalcTriMeshEdges( 	const TQ3TriMeshData& inData,
 {
 	outEdges.clear();
 	
-	// First create edges and faces without regard to making edges unique.
-	TQ3EdgeVec				edgesWithCopies;
-	TQ3TriangleToEdgeVec	facesWithCopies;
-	
-	CreateRedundantEdges( inData, edgesWithCopies, facesWithCopies );
-	
-	// Make edge indices, and sort the indices by edge ends.
-	const TQ3Uns32	kNumEdgesWithCopies = edgesWithCopies.size();
-	E3FastArray<TQ3Uns32>	edgeNumVec( kNumEdgesWithCopies );
-	TQ3Uns32*	edgeNums = (kNumEdgesWithCopies == 0)? nullptr : &edgeNumVec[0];	// optimization
-	for (TQ3Uns32 i = 0; i < kNumEdgesWithCopies; ++i)
-	{
-		edgeNums[i] = i;
-	}
-	if (kNumEdgesWithCopies > 0)
-	{
-		EdgeIndexCompare	comparator( &edgesWithCopies[0] );
-		std::sort( &edgeNums[0], &edgeNums[kNumEdgesWithCopies], comparator );
-	}
-	
-	// We will construct an array that maps indices of old edges with copies
-	// to new uniquified edges.
-	E3FastArray<TQ3Uns32>	edgeToUniqueEdge( kNumEdgesWithCopies );
+	const TQ3Uns32*	theFaces = (inData.numTriangles == 0)? nullptr :
+		&inData.triangles[0].pointIndices[0];
+	TE3EdgeAdjacency	theAdjacency;
+	E3EdgeAdjacency_Build( inData.numTriangles, theFaces, theAdjacency );
 	
-	TQ3Uns32	runStart, nextRunStart;
-	runStart = 0;
+	// Copy the distinct edges.
+	const TQ3Uns32	kNumEdges = static_cast<TQ3Uns32>(
+		theAdjacency.edgeEnds.size() / 2 );
+	outEdges.resizeNotPreserving( kNumEdges );
 	
-	while (runStart < kNumEdgesWithCopies)
+	for (TQ3Uns32 e = 0; e < kNumEdges; ++e)
 	{
-		nextRunStart = runStart + 1;
-		while ( (nextRunStart < kNumEdgesWithCopies) &&
-			HasSameEnds( edgesWithCopies[ edgeNums[ runStart ] ],
-				edgesWithCopies[ edgeNums[ nextRunStart ] ] ) )
-		{
-			++nextRunStart;
-		}
-		// At this point, the edges with index runStart to nextRunStart-1 all
-		// have the same ends.
-		
-		// Save one copy of the edge.
-		outEdges.push_back( edgesWithCopies[ edgeNums[ runStart ] ] );
-		
-		// Map old to new indices.
-		TQ3Uns32	uniqueEdgeIndex = outEdges.size() - 1;
-		for (TQ3Uns32 j = runStart; j < nextRunStart; ++j)
-		{
-			edgeToUniqueEdge[ edgeNums[j] ] = uniqueEdgeIndex;
-		}
-		
-		runStart = nextRunStart;
+		outEdges[e].pointIndices[0] = theAdjacency.edgeEnds[ 2 * e ];
+		outEdges[e].pointIndices[1] = theAdjacency.edgeEnds[ 2 * e + 1 ];
 	}
 	
-	// Create faces with new indices.
+	// Side k of a face joins corners k and k+1, as TQ3TriangleEdges requires.
 	if (outFacesToEdges != nullptr)
 	{
-		const TQ3Uns32 kNumFaces = facesWithCopies.size();
+		const TQ3Uns32 kNumFaces = inData.numTriangles;
 		outFacesToEdges->resizeNotPreserving( kNumFaces );
 		
-		if (kNumEdgesWithCopies > 0) // get rid of a static analyzer warning
+		for (TQ3Uns32 f = 0; f < kNumFaces; ++f)
 		{
-			for (TQ3Uns32 f = 0; f < kNumFaces; ++f)
-			{
-				const TQ3TriangleEdges& oldFace( facesWithCopies[f] );
-				TQ3TriangleEdges	newFace = {
-					{
-						edgeToUniqueEdge[ oldFace.edgeIndices[ 0 ] ],
-						edgeToUniqueEdge[ oldFace.edgeIndices[ 1 ] ],
-						edgeToUniqueEdge[ oldFace.edgeIndices[ 2 ] ]
-					}
-				};
-				(*outFacesToEdges)[f] = newFace;
-			}
+			TQ3TriangleEdges	newFace = {
+				{
+					theAdjacency.halfEdgeToEdge[ 3 * f ],
+					theAdjacency.halfEdgeToEdge[ 3 * f + 1 ],
+					theAdjacency.halfEdgeToEdge[ 3 * f + 2 ]
+				}
+			};
+			(*outFacesToEdges)[f] = newFace;
 		}
 	}
 }
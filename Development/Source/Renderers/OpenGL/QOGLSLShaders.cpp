@@ -1846,4 +1846,76 @@ const char* kMainFragmentShaderEndSource = R"(
 	fragColor.a = alpha;
 }
 )";
+
+
+#pragma mark kFragmentShaderWeightedOutput
+const char* kFragmentShaderWeightedOutput = R"(
+// Weighted alpha out, for order-independent transparency
+out vec4 fragWeightedAlpha;
+
+)";
+
+
+#pragma mark kMainFragmentShaderEndWeightedSource
+/*
+	Weighted, blended order-independent transparency, as described by
+	McGuire and Bavoil.  Output 0 accumulates the weighted premultiplied
+	color by additive blending, while its alpha is blended so as to keep the
+	product of (1 - alpha), the fraction of the background that shows through.
+	Output 1 accumulates the weighted alpha.  The weight falls off with depth,
+	so that nearer fragments count for more.
+*/
+const char* kMainFragmentShaderEndWeightedSource = R"(
+	float weight = clamp( pow( min( 1.0, alpha * 10.0 ) + 0.01, 3.0 ) * 1.0e8 *
+		pow( 1.0 - gl_FragCoord.z * 0.9, 3.0 ), 1.0e-2, 3.0e3 );
+	fragColor.rgb = color * weight;
+	fragColor.a = alpha;
+	fragWeightedAlpha = vec4( alpha * weight );
+}
+)";
+
+
+#pragma mark kWeightedCompositeVertexShader
+const char* kWeightedCompositeVertexShader = R"(
+#version 150 core
+
+// A triangle that covers the viewport
+in vec2 quesaCorner;
+
+void main()
+{
+	gl_Position = vec4( quesaCorner, 0.0, 1.0 );
+}
+)";
+
+
+#pragma mark kWeightedCompositeFragmentShader
+/*
+	The average color of the transparent fragments is written with an alpha
+	equal to the revealage, to be blended with
+	glBlendFunc( GL_ONE_MINUS_SRC_ALPHA, GL_SRC_ALPHA ).
+*/
+const char* kWeightedCompositeFragmentShader = R"(
+#version 150 core
+
+uniform sampler2D accumTex;
+uniform sampler2D weightTex;
+uniform vec2 viewportOrigin;
+
+out vec4 fragColor;
+
+void main()
+{
+	ivec2 texel = ivec2( gl_FragCoord.xy - viewportOrigin );
+	vec4 accum = texelFetch( accumTex, texel, 0 );
+	float revealage = accum.a;
+	if (revealage >= 1.0)
+	{
+		discard;
+	}
+	float weightedAlpha = texelFetch( weightTex, texel, 0 ).r;
+	fragColor.rgb = accum.rgb / clamp( weightedAlpha, 1.0e-4, 5.0e4 );
+	fragColor.a = revealage;
+}
+)";
 }
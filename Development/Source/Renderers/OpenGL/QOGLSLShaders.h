@@ -100,6 +100,13 @@ namespace QOGLSLShader
 	extern const char* kMixFog;
 	extern const char*	kAngleAffectOnAlpha;
 	extern const char* kMainFragmentShaderEndSource;
+	extern const char* kFragmentShaderWeightedOutput;
+	extern const char* kMainFragmentShaderEndWeightedSource;
+	
+	
+	// Weighted transparency composite
+	extern const char* kWeightedCompositeVertexShader;
+	extern const char* kWeightedCompositeFragmentShader;
 	
 }
 
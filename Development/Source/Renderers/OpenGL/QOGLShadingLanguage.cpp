@@ -361,8 +361,10 @@ void	QORenderer::GLSLFuncs::SetNULL()
 	glEnableVertexAttribArray = nullptr;
 	glDisableVertexAttribArray = nullptr;
 	glVertexAttrib3fv = nullptr;
+	glVertexAttrib4fv = nullptr;
 	glVertexAttribPointer = nullptr;
 	glBindAttribLocation = nullptr;
+	glBindFragDataLocation = nullptr;
 }
 
 void	QORenderer::GLSLFuncs::Initialize( const TQ3GLExtensions& inExts )
@@ -400,8 +402,11 @@ void	QORenderer::GLSLFuncs::Initialize( const TQ3GLExtensions& inExts )
 		GLGetProcAddress( glEnableVertexAttribArray, "glEnableVertexAttribArray" );
 		GLGetProcAddress( glDisableVertexAttribArray, "glDisableVertexAttribArray" );
 		GLGetProcAddress( glVertexAttrib3fv, "glVertexAttrib3fv" );
+		GLGetProcAddress( glVertexAttrib4fv, "glVertexAttrib4fv" );
 		GLGetProcAddress( glVertexAttribPointer, "glVertexAttribPointer" );
 		GLGetProcAddress(glBindAttribLocation, "glBindAttribLocation");
+		GLGetProcAddress( glBindFragDataLocation, "glBindFragDataLocation",
+			"glBindFragDataLocationEXT" );
 
 		if ( (glCreateShader == nullptr) ||
 			(glShaderSource == nullptr) ||
@@ -431,6 +436,7 @@ void	QORenderer::GLSLFuncs::Initialize( const TQ3GLExtensions& inExts )
 			(glEnableVertexAttribArray == nullptr) ||
 			(glDisableVertexAttribArray == nullptr) ||
 			(glVertexAttrib3fv == nullptr) ||
+			(glVertexAttrib4fv == nullptr) ||
 			(glVertexAttribPointer == nullptr) ||
 			(glBindAttribLocation == nullptr)
 			)
@@ -690,6 +696,11 @@ static void BuildFragmentShaderSource(	const QORenderer::ProgramCharacteristic&
 		}
 	}
 	
+	if (inProgramRec.mIsWeightedBlended)
+	{
+		outSource += kFragmentShaderWeightedOutput;
+	}
+	
 	outSource += kMainFragmentShaderStart;
 
 	if (inProgramRec.mIsUsingClippingPlane)
@@ -793,7 +804,14 @@ static void BuildFragmentShaderSource(	const QORenderer::ProgramCharacteristic&
 		outSource += kAngleAffectOnAlpha;
 	}
 	
-	outSource += kMainFragmentShaderEndSource;
+	if (inProgramRec.mIsWeightedBlended)
+	{
+		outSource += kMainFragmentShaderEndWeightedSource;
+	}
+	else
+	{
+		outSource += kMainFragmentShaderEndSource;
+	}
 }
 
 /*!
@@ -1084,6 +1102,8 @@ void	QORenderer::PerPixelLighting::StartPass( TQ3CameraObject inCamera )
 		sizeof(TQ3Boolean), nullptr, &angleAffectsAlpha );
 	mProgramCharacteristic.mAngleAffectsAlpha = (angleAffectsAlpha == kQ3True);
 	
+	mProgramCharacteristic.mIsWeightedBlended = false;
+	
 	mAlphaThreshold = 0.0f;
 	
 	Q3Camera_GetWorldToView( inCamera, &mWorldToView );
@@ -1103,6 +1123,10 @@ static std::string DescribeProgram( const QORenderer::ProgramRec& inProgram )
 	std::ostringstream desc;
 	DescribeLights( inProgram.mCharacteristic, desc );
 	desc << (inProgram.mCharacteristic.mIsTextured? "T+" : "T-");
+	if (inProgram.mCharacteristic.mIsWeightedBlended)
+	{
+		desc << "W+";
+	}
 	switch (inProgram.mCharacteristic.mIlluminationType)
 	{
 	case kQ3IlluminationTypePhong:
@@ -1161,6 +1185,7 @@ void	QORenderer::PerPixelLighting::ChooseProgram()
 				(void)glGetError();	// discard any previous unknown error
 				mFuncs.glUseProgram( theProgram->mProgram );
 				CHECK_GL_ERROR_MSG("glUseProgram");
+				mRenderer.CountProgramSwitch();
 			#if Q3_DEBUG
 				std::string desc( DescribeProgram( *theProgram ) );
 				Q3_MESSAGE_FMT("Using program ID %u, of type %s",
@@ -1704,6 +1729,14 @@ void	QORenderer::PerPixelLighting::InitProgram()
 			// a disabled array.
 			mFuncs.glBindAttribLocation(newProgram.mProgram, 0, "quesaVertex");
 			
+			// A weighted transparency program has two color outputs, which
+			// must go to the attachments in a known order.
+			if (newProgram.mCharacteristic.mIsWeightedBlended)
+			{
+				mFuncs.glBindFragDataLocation( newProgram.mProgram, 0, "fragColor" );
+				mFuncs.glBindFragDataLocation( newProgram.mProgram, 1, "fragWeightedAlpha" );
+			}
+			
 			// Link program
 			mFuncs.glLinkProgram( newProgram.mProgram );
 			CHECK_GL_ERROR;
@@ -2056,6 +2089,9 @@ void	QORenderer::PerPixelLighting::UpdateSpecularMapping( bool inSpecularMapped
 void	QORenderer::PerPixelLighting::PreGeomSubmit( TQ3GeometryObject inGeom,
 													int inDimension )
 {
+	// A texture activated since the last geometry is bound just in time
+	mRenderer.BindPendingTexture();
+	
 	CQ3ObjectRef lightGroup( CQ3View_GetLightGroup( mView.get() ) );
 	TQ3Uns32 lightGroupEditIndex = Q3Shared_GetEditIndex( lightGroup.get() );
 	if (lightGroupEditIndex != mLightGroupEditIndex)
@@ -2139,6 +2175,22 @@ void	QORenderer::PerPixelLighting::SetAlphaThreshold( float inThreshold )
 }
 
 
+/*!
+	@function	SetWeightedBlending
+	@abstract	Set whether fragments are written for weighted, blended
+				order-independent transparency.
+	@param		inWeighted		Whether to write weighted outputs.
+*/
+void	QORenderer::PerPixelLighting::SetWeightedBlending( bool inWeighted )
+{
+	if (inWeighted != mProgramCharacteristic.mIsWeightedBlended)
+	{
+		mProgramCharacteristic.mIsWeightedBlended = inWeighted;
+		mMayNeedProgramChange = true;
+	}
+}
+
+
 
 /*!
 	@function	SetModelViewMatrix
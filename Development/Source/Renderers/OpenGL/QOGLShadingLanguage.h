@@ -157,6 +157,7 @@ typedef GLint (QO_PROCPTR_TYPE glGetAttribLocationProc)( GLuint program, const c
 typedef void (QO_PROCPTR_TYPE glEnableVertexAttribArrayProc)( GLuint index );
 typedef void (QO_PROCPTR_TYPE glDisableVertexAttribArrayProc)( GLuint index );
 typedef void (QO_PROCPTR_TYPE glVertexAttrib3fvProc)( GLuint index, const GLfloat *v );
+typedef void (QO_PROCPTR_TYPE glVertexAttrib4fvProc)( GLuint index, const GLfloat *v );
 typedef void (QO_PROCPTR_TYPE glVertexAttribPointerProc)(
 													GLuint index,
 													GLint size,
@@ -165,6 +166,7 @@ typedef void (QO_PROCPTR_TYPE glVertexAttribPointerProc)(
 													GLsizei stride,
 													const GLvoid *pointer );
 typedef void (QO_PROCPTR_TYPE glBindAttribLocationProc)(GLuint program, GLuint index, const char* name);
+typedef void (QO_PROCPTR_TYPE glBindFragDataLocationProc)(GLuint program, GLuint colorNumber, const char* name);
 
 
 /*!
@@ -214,8 +216,10 @@ struct GLSLFuncs
 	glEnableVertexAttribArrayProc	glEnableVertexAttribArray;
 	glDisableVertexAttribArrayProc	glDisableVertexAttribArray;
 	glVertexAttrib3fvProc			glVertexAttrib3fv;
+	glVertexAttrib4fvProc			glVertexAttrib4fv;
 	glVertexAttribPointerProc		glVertexAttribPointer;
 	glBindAttribLocationProc		glBindAttribLocation;
+	glBindFragDataLocationProc		glBindFragDataLocation;	// may be nullptr
 
 private:
 	void						SetNULL();
@@ -385,6 +389,16 @@ public:
 	*/
 	void						SetAlphaThreshold( float inThreshold );
 
+	/*!
+		@function	SetWeightedBlending
+		@abstract	Set whether fragments are written for weighted, blended
+					order-independent transparency, as a premultiplied color
+					and alpha scaled by a depth weight in output 0 and the
+					weighted alpha in output 1.
+		@param		inWeighted		Whether to write weighted outputs.
+	*/
+	void						SetWeightedBlending( bool inWeighted );
+
 	/*!
 		@function	SetModelViewMatrix
 		@abstract	Supply a new value for the model-view matrix.  It will be passed
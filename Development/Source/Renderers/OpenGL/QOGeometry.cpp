@@ -51,6 +51,7 @@
 #include "GLUtils.h"
 #include "GLVBOManager.h"
 #include "MakeStrip.h"
+#include "VertexCacheOptimizer.h"
 #include "OptimizedTriMeshElement.h"
 #include "E3GeometryTriMesh.h"
 #include "E3Memory.h"
@@ -827,6 +828,79 @@ static void GetCachedTriangleStrip(
 }
 
 
+/*!
+	@function	PermuteVertexArray
+	@abstract	Copy per-vertex data in a new vertex order.
+*/
+template <typename T>
+static const T* PermuteVertexArray(
+								const T* inData,
+								const std::vector<TQ3Uns32>& inNewToOld,
+								std::vector<T>& outData )
+{
+	if (inData == nullptr)
+	{
+		return nullptr;
+	}
+	
+	outData.resize( inNewToOld.size() );
+	for (TQ3Uns32 i = 0; i < inNewToOld.size(); ++i)
+	{
+		outData[i] = inData[ inNewToOld[i] ];
+	}
+	return &outData[0];
+}
+
+
+/*!
+	@function	AddVertexCacheOptimizedVBO
+	@abstract	Cache a TriMesh as a triangle list reordered for the
+				post-transform vertex cache.
+	@discussion	The faces are reordered, and unless the geometry has layer
+				shifts, whose per-vertex data the VBO manager reads from the
+				geometry itself, the vertices are renumbered in order of first
+				use so that the GPU fetches them in order too.
+*/
+static void AddVertexCacheOptimizedVBO(
+								const QORenderer::Renderer& inRenderer,
+								TQ3GeometryObject inNakedMesh,
+								const TQ3TriMeshData& inGeomData,
+								const TQ3Vector3D* inVertNormals,
+								const TQ3ColorRGB* inVertColors,
+								const TQ3Param2D* inVertUVs,
+								bool inHasLayerShifts )
+{
+	std::vector<TQ3Uns32>	theFaces;
+	OptimizeTriangleOrder( inGeomData.numTriangles,
+		&inGeomData.triangles[0].pointIndices[0], inGeomData.numPoints,
+		theFaces );
+	
+	const TQ3Point3D*	thePoints = inGeomData.points;
+	std::vector<TQ3Point3D>		newPoints;
+	std::vector<TQ3Vector3D>	newNormals;
+	std::vector<TQ3ColorRGB>	newColors;
+	std::vector<TQ3Param2D>		newUVs;
+	
+	if (! inHasLayerShifts)
+	{
+		std::vector<TQ3Uns32>	newToOld;
+		OptimizeVertexOrder( inGeomData.numPoints, theFaces, newToOld );
+		
+		thePoints = PermuteVertexArray( thePoints, newToOld, newPoints );
+		inVertNormals = PermuteVertexArray( inVertNormals, newToOld, newNormals );
+		inVertColors = PermuteVertexArray( inVertColors, newToOld, newColors );
+		inVertUVs = PermuteVertexArray( inVertUVs, newToOld, newUVs );
+	}
+	
+	Q3_CHECK_DRAW_ELEMENTS( inGeomData.numPoints,
+		static_cast<TQ3Uns32>(theFaces.size()), &theFaces[0] );
+	AddVBOToCache( inRenderer, inNakedMesh, inGeomData.numPoints,
+		thePoints, inVertNormals, inVertColors, inVertUVs,
+		GL_TRIANGLES, static_cast<TQ3Uns32>(theFaces.size()),
+		&theFaces[0] );
+}
+
+
 /*!
 	@function	CalcTriMeshVertState
 	@abstract	Fill in attribute data for a vertex of a decomposed TriMesh.
@@ -1128,6 +1202,35 @@ void	QORenderer::Renderer::RenderSlowPathTriMesh(
 	}
 }
 
+/*!
+	@function	SetFastPathColor
+	
+	@abstract	Set the color attribute for a fast-path TriMesh without vertex
+				colors.
+	@discussion	Normally the alpha of the attribute is left at 1.  When
+				WeightedTransparency is drawing a transparent TriMesh, the
+				color is premultiplied by the geometry alpha, as TransBuffer
+				does for its vertices.
+	@param		inIsTextured	Whether a texture replaces the diffuse color.
+*/
+void	QORenderer::Renderer::SetFastPathColor( bool inIsTextured )
+{
+	const TQ3ColorRGB&	theColor( inIsTextured? kWhiteColor : *mGeomState.diffuseColor );
+	
+	if (mIsPremultiplyingFastPathColor)
+	{
+		const float	alpha = mGeomState.alpha;
+		const GLfloat	premultiplied[4] = {
+			theColor.r * alpha, theColor.g * alpha, theColor.b * alpha, alpha
+		};
+		mSLFuncs.glVertexAttrib4fv( Shader().CurrentProgram()->mColorAttribLoc, premultiplied );
+	}
+	else
+	{
+		mSLFuncs.glVertexAttrib3fv( Shader().CurrentProgram()->mColorAttribLoc, &theColor.r );
+	}
+}
+
 /*!
 	@function	RenderFastPathTriMesh
 	
@@ -1146,14 +1249,14 @@ void	QORenderer::Renderer::RenderFastPathTriMesh(
 		(mViewIllumination != kQ3IlluminationTypeNULL) &&
 		(inVertUVs != nullptr) )
 	{
-		mSLFuncs.glVertexAttrib3fv( Shader().CurrentProgram()->mColorAttribLoc, &kWhiteColor.r );
+		SetFastPathColor( true );
 		inVertColors = nullptr;
 	}
 	
 	// If no vertex colors, set the color.
 	else if (inVertColors == nullptr)
 	{
-		mSLFuncs.glVertexAttrib3fv( Shader().CurrentProgram()->mColorAttribLoc, &mGeomState.diffuseColor->r );
+		SetFastPathColor( false );
 	}
 	
 	// Enable/disable array states.
@@ -1175,7 +1278,9 @@ void	QORenderer::Renderer::RenderFastPathTriMesh(
 		{
 			// In edge fill style, the degenerate triangles created by
 			// MakeStrip draw bogus edges.
-			GLenum	mode = (mStyleState.mFill == kQ3FillStyleEdges)?
+			// A mesh optimized for the vertex cache is drawn as a list.
+			GLenum	mode = ( (mStyleState.mFill == kQ3FillStyleEdges) ||
+				mIsVertexCacheOptimizing )?
 				GL_TRIANGLES : GL_TRIANGLE_STRIP;
 			
 			if (kQ3False == RenderCachedVBO( *this, nakedMesh.get(), mode ))
@@ -1186,7 +1291,13 @@ void	QORenderer::Renderer::RenderFastPathTriMesh(
 						inGeomData, triangleStrip );
 				}
 				
-				if (triangleStrip.empty())
+				if (mIsVertexCacheOptimizing)
+				{
+					AddVertexCacheOptimizedVBO( *this, nakedMesh.get(),
+						inGeomData, inVertNormals, inVertColors, inVertUVs,
+						hasLayers == kQ3Success );
+				}
+				else if (triangleStrip.empty())
 				{
 					Q3_CHECK_DRAW_ELEMENTS( inGeomData.numPoints,
 						3 * inGeomData.numTriangles,
@@ -1221,6 +1332,28 @@ void	QORenderer::Renderer::RenderFastPathTriMesh(
 }
 
 
+/*!
+	@function	RenderQueuedTriMesh
+	
+	@abstract	Draw a fast-path TriMesh that was deferred by the render queue,
+				which has already restored the state it was queued with.
+*/
+void	QORenderer::Renderer::RenderQueuedTriMesh( TQ3GeometryObject inTriMesh )
+{
+	CLockTriMeshData	locker;
+	const TQ3TriMeshData*	geomData = locker.Lock( inTriMesh );
+	
+	MeshArrays	dataArrays;
+	FindTriMeshData( *geomData, dataArrays );
+	
+	mTextures.HandlePendingTextureRemoval();
+	mPPLighting.PreGeomSubmit( inTriMesh, 2 );
+	
+	RenderFastPathTriMesh( inTriMesh, *geomData, dataArrays.vertNormal,
+		dataArrays.vertUV, dataArrays.vertColor );
+}
+
+
 /*!
 	@function	FindExplicitEdgesOfFrontFaces
 	
@@ -1472,6 +1605,22 @@ static void	ImmediateModePop(
 
 
 
+/*!
+	@function		IsBatchableAttributeSet
+	
+	@abstract		Test whether the attribute set of a TriMesh leaves the
+					OpenGL state alone, so that the TriMesh can share a draw call
+					with its neighbors.  A diffuse color is allowed, since the
+					mesh batch stores colors per vertex.
+*/
+static bool IsBatchableAttributeSet( TQ3AttributeSet inAttSet )
+{
+	return (inAttSet == nullptr) ||
+		((Q3XAttributeSet_GetMask( inAttSet ) &
+			~kQ3XAttributeMaskDiffuseColor) == 0);
+}
+
+
 /*!
 	@function		SubmitTriMesh
 	
@@ -1519,6 +1668,23 @@ bool	QORenderer::Renderer::SubmitTriMesh(
 	// Activate our context
 	GLDrawContext_SetCurrent( mGLContext, kQ3False );
 	
+	// See whether this TriMesh may join the batch of small TriMeshes.  If not,
+	// draw the batch before we change any state for this TriMesh.
+	TQ3Uns32	nonCartoonSize = 0;
+	bool	mayBatch = mIsBatchingSmallMeshes &&
+		(inGeomData->numTriangles < kMinTrianglesToCache) &&
+		(mStyleState.mFill == kQ3FillStyleFilled) &&
+		(! mLights.IsShadowMarkingPass()) &&
+		IsBatchableAttributeSet( inGeomData->triMeshAttributeSet ) &&
+		! ( mStyleState.mHilite.isvalid() && (mViewState.highlightState == kQ3On) ) &&
+		( (inTriMesh == nullptr) ||
+			(kQ3Failure == Q3Object_GetProperty( inTriMesh,
+				kQ3GeometryPropertyNonCartoon, 0, &nonCartoonSize, nullptr )) );
+	if (! mayBatch)
+	{
+		mMeshBatch.Flush();
+	}
+	
 	// Allow usual lighting
 	mLights.SetLowDimensionalMode( false, mViewIllumination );
 
@@ -1569,6 +1735,13 @@ bool	QORenderer::Renderer::SubmitTriMesh(
 		}
 	}
 	
+	if ( mayBatch && ( (whyNotFastPath != kSlowPathMask_FastPath) ||
+		(inGeomData->numTriangles >= kMinTrianglesToCache) ) )
+	{
+		mayBatch = false;
+		mMeshBatch.Flush();
+	}
+	
 	// Special handling when shadow marking
 	if (mLights.IsShadowMarkingPass())
 	{
@@ -1602,12 +1775,54 @@ bool	QORenderer::Renderer::SubmitTriMesh(
 		}
 	}
 
+	// With order-independent transparency, a TriMesh that is transparent
+	// only because of its material alpha or texture is drawn whole at the
+	// end of the pass, rather than being broken into sorted triangles.
+	// Like TransBuffer, we only collect transparency in the first pass.
+	if ( (! didHandle) && mWeightedTrans.IsActive() &&
+		(whyNotFastPath == kSlowPathMask_Transparency) &&
+		(inTriMesh != nullptr) &&
+		(mStyleState.mFill == kQ3FillStyleFilled) &&
+		IsSimplyTransparent( mAlphaThreshold, dataArrays, mTextures, mGeomState ) )
+	{
+		if ( (! IsFirstPass()) || mWeightedTrans.AddTriMesh( inTriMesh ) )
+		{
+			didHandle = true;
+		}
+	}
+
 	if ( (whyNotFastPath == kSlowPathMask_FastPath) && (! didHandle) )
 	{
-		mPPLighting.PreGeomSubmit( inTriMesh, 2 );
-		
-		RenderFastPathTriMesh( inTriMesh, *inGeomData, dataArrays.vertNormal,
-			dataArrays.vertUV, dataArrays.vertColor );
+		// A TriMesh that will be cached in a VBO may be queued, to be drawn
+		// later in order of surface shader and material.
+		if ( mIsSortingOpaqueTriMeshes && (inTriMesh != nullptr) &&
+			(inGeomData->numTriangles >= kMinTrianglesToCache) &&
+			(mStyleState.mFill == kQ3FillStyleFilled) &&
+			(! mLights.IsShadowMarkingPass()) )
+		{
+			mRenderQueue.AddTriMesh( inTriMesh );
+		}
+		else
+		{
+			// The program of a batch is chosen for its first TriMesh.  Any
+			// state change that could choose another program flushes the
+			// batch.
+			if ( (! mayBatch) || mMeshBatch.IsEmpty() )
+			{
+				mPPLighting.PreGeomSubmit( inTriMesh, 2 );
+			}
+			
+			if (mayBatch)
+			{
+				mMeshBatch.AddTriMesh( *inGeomData, dataArrays.vertNormal,
+					dataArrays.vertUV, dataArrays.vertColor );
+			}
+			else
+			{
+				RenderFastPathTriMesh( inTriMesh, *inGeomData, dataArrays.vertNormal,
+					dataArrays.vertUV, dataArrays.vertColor );
+			}
+		}
 		
 		didHandle = true;
 	}
@@ -1652,6 +1867,9 @@ void	QORenderer::Renderer::SubmitTriangle(
 
 	// Activate our context
 	GLDrawContext_SetCurrent( mGLContext, kQ3False );
+
+	// Draw any batched TriMeshes before changing state
+	mMeshBatch.Flush();
 	
 	// Allow usual lighting
 	mLights.SetLowDimensionalMode( false, mViewIllumination );
@@ -1791,6 +2009,9 @@ void	QORenderer::Renderer::SubmitPoint(
 
 	// Activate our context
 	GLDrawContext_SetCurrent( mGLContext, kQ3False );
+
+	// Draw any batched TriMeshes before changing state
+	mMeshBatch.Flush();
 	
 	// update color from geometry attribute set
 	HandleGeometryAttributes( inGeomData->pointAttributeSet, nullptr,
@@ -1855,6 +2076,9 @@ void	QORenderer::Renderer::SubmitLine(
 
 	// Activate our context
 	GLDrawContext_SetCurrent( mGLContext, kQ3False );
+
+	// Draw any batched TriMeshes before changing state
+	mMeshBatch.Flush();
 	
 	// update color from geometry attribute set
 	HandleGeometryAttributes( inGeomData->lineAttributeSet, nullptr,
@@ -1998,6 +2222,9 @@ void	QORenderer::Renderer::SubmitPolyLine(
 
 	// Activate our context
 	GLDrawContext_SetCurrent( mGLContext, kQ3False );
+
+	// Draw any batched TriMeshes before changing state
+	mMeshBatch.Flush();
 	
 	// update color from geometry attribute set
 	HandleGeometryAttributes( inGeomData->polyLineAttributeSet, nullptr,
@@ -212,15 +212,24 @@ TQ3Status	QORenderer::Renderer::UpdateLocalToCamera(
 	// Activate our context
 	GLDrawContext_SetCurrent( mGLContext, kQ3False );
 	
-	// flush any buffered triangles
+	// flush any buffered triangles.  The mesh batch is in camera
+	// coordinates, so it can stay.
 	mTriBuffer.Flush();
 	
 	// Update my matrix state
 	mMatrixState.SetLocalToCamera( inMatrix );
 	
 	
-	// Set the model-view transform
-	GLCamera_SetModelView( &inMatrix, mPPLighting );
+	// Set the model-view transform.  While small TriMeshes are being
+	// batched, that waits until some other geometry flushes the batch.
+	if (mIsBatchingSmallMeshes)
+	{
+		mMeshBatch.SetModelViewPending();
+	}
+	else
+	{
+		GLCamera_SetModelView( &inMatrix, mPPLighting );
+	}
 	
 	
 	
@@ -244,6 +253,8 @@ TQ3Status	QORenderer::Renderer::UpdateCameraToFrustum(
 	
 	// flush any buffered triangles
 	mTriBuffer.Flush();
+	mMeshBatch.Flush();
+	mRenderQueue.Flush();
 
 	// Update my matrix state
 	mMatrixState.SetCameraToFrustum( inMatrix );
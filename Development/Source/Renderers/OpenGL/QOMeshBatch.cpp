@@ -0,0 +1,206 @@
+/*  NAME:
+        QOMeshBatch.cpp
+
+    DESCRIPTION:
+        Source for Quesa OpenGL renderer class.
+
+    COPYRIGHT:
+        Copyright (c) 2026, Quesa Developers. All rights reserved.
+
+        For the current release of Quesa, please see:
+
+            <https://github.com/jwwalker/Quesa>
+        
+        Redistribution and use in source and binary forms, with or without
+        modification, are permitted provided that the following conditions
+        are met:
+        
+            o Redistributions of source code must retain the above copyright
+              notice, this list of conditions and the following disclaimer.
+        
+            o Redistributions in binary form must reproduce the above
+              copyright notice, this list of conditions and the following
+              disclaimer in the documentation and/or other materials provided
+              with the distribution.
+        
+            o Neither the name of Quesa nor the names of its contributors
+              may be used to endorse or promote products derived from this
+              software without specific prior written permission.
+        
+        THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+        "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+        LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+        A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+        OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+        SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+        TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+        PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+        LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+        NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+        SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+    ___________________________________________________________________________
+*/
+
+
+
+//=============================================================================
+//      Include files
+//-----------------------------------------------------------------------------
+#include "QORenderer.h"
+#include "GLCamera.h"
+#include "GLImmediateVBO.h"
+
+#include <algorithm>
+
+
+//=============================================================================
+//      Local constants
+//-----------------------------------------------------------------------------
+namespace
+{
+	// Bound on the number of vertices in one draw call, so that a long run
+	// of meshes does not make one huge upload.
+	const TQ3Uns32	kMaxBatchPoints		= 65536;
+	
+	const TQ3ColorRGB	kWhiteColor = { 1.0f, 1.0f, 1.0f };
+}
+
+
+//=============================================================================
+//      Class Implementation
+//-----------------------------------------------------------------------------
+
+/*!
+	@function	MeshBatch (constructor)
+	@abstract	Initialize the batch.
+*/
+QORenderer::MeshBatch::MeshBatch(
+									Renderer& inRenderer  )
+	: mRenderer( inRenderer )
+	, mHasUVs( false )
+	, mIsModelViewPending( false )
+{
+}
+
+
+/*!
+	@function	Flush
+	@abstract	Draw and empty the batch, and bring the model-view transform
+				up to date.
+*/
+void	QORenderer::MeshBatch::Flush()
+{
+	if (! mIndices.empty())
+	{
+		// The vertices are already in camera coordinates.
+		TQ3Matrix4x4	identity;
+		Q3Matrix4x4_SetIdentity( &identity );
+		GLCamera_SetModelView( &identity, mRenderer.mPPLighting );
+		
+		mRenderer.mGLClientStates.EnableNormalArray( true );
+		mRenderer.mGLClientStates.EnableTextureArray( mHasUVs );
+		mRenderer.mGLClientStates.EnableColorArray( true );
+		mRenderer.mGLClientStates.EnableLayerShiftArray( false );
+		
+		RenderImmediateVBO( GL_TRIANGLES, mRenderer,
+			static_cast<TQ3Uns32>( mPoints.size() ), &mPoints[0], &mNormals[0],
+			&mColors[0], mHasUVs? &mUVs[0] : nullptr,
+			static_cast<TQ3Uns32>( mIndices.size() ), &mIndices[0] );
+		
+		mPoints.clear();
+		mNormals.clear();
+		mColors.clear();
+		mUVs.clear();
+		mIndices.clear();
+		
+		mIsModelViewPending = true;
+	}
+	
+	if (mIsModelViewPending)
+	{
+		GLCamera_SetModelView( &mRenderer.mMatrixState.GetLocalToCamera(),
+			mRenderer.mPPLighting );
+		mIsModelViewPending = false;
+	}
+}
+
+
+/*!
+	@function	AddTriMesh
+	@abstract	Add a fast-path TriMesh to the batch.
+	@discussion	The caller is responsible for seeing that the TriMesh has the
+				same material as what is already in the batch.  The color
+				that RenderFastPathTriMesh would have set as a constant
+				attribute is stored with each vertex instead.
+*/
+void	QORenderer::MeshBatch::AddTriMesh(
+									const TQ3TriMeshData& inGeomData,
+									const TQ3Vector3D* _Nonnull inVertNormals,
+									const TQ3Param2D* _Nullable inVertUVs,
+									const TQ3ColorRGB* _Nullable inVertColors )
+{
+	if (inGeomData.numTriangles == 0)
+	{
+		return;
+	}
+	
+	const TQ3Uns32	kNumPoints = inGeomData.numPoints;
+	const bool		hasUVs = (inVertUVs != nullptr);
+	
+	// Flush the batch if the vertex format has changed or it would get too big
+	if ( (! mIndices.empty()) &&
+		( (hasUVs != mHasUVs) ||
+		(mPoints.size() + kNumPoints > kMaxBatchPoints) ) )
+	{
+		Flush();
+	}
+	mHasUVs = hasUVs;
+	
+	const TQ3Uns32	kBase = static_cast<TQ3Uns32>( mPoints.size() );
+	mPoints.resize( kBase + kNumPoints );
+	mNormals.resize( kBase + kNumPoints );
+	mColors.resize( kBase + kNumPoints );
+	
+	// Transform points and normals to camera coordinates
+	const MatrixState&	theMatrices( mRenderer.mMatrixState );
+	Q3Point3D_To3DTransformArray( inGeomData.points,
+		&theMatrices.GetLocalToCamera(), &mPoints[ kBase ], kNumPoints,
+		sizeof(TQ3Point3D), sizeof(TQ3Point3D) );
+	Q3Vector3D_To3DTransformArray( inVertNormals,
+		&theMatrices.GetLocalToCameraInverseTranspose(), &mNormals[ kBase ],
+		kNumPoints, sizeof(TQ3Vector3D), sizeof(TQ3Vector3D) );
+	
+	// If there is a texture, and illumination is not nullptr, use white as the
+	// underlying color.
+	if ( mRenderer.mTextures.IsTextureActive() &&
+		(mRenderer.mViewIllumination != kQ3IlluminationTypeNULL) &&
+		hasUVs )
+	{
+		std::fill( mColors.begin() + kBase, mColors.end(), kWhiteColor );
+	}
+	else if (inVertColors == nullptr)
+	{
+		std::fill( mColors.begin() + kBase, mColors.end(),
+			*mRenderer.mGeomState.diffuseColor );
+	}
+	else
+	{
+		std::copy( inVertColors, inVertColors + kNumPoints,
+			mColors.begin() + kBase );
+	}
+	
+	if (hasUVs)
+	{
+		mUVs.insert( mUVs.end(), inVertUVs, inVertUVs + kNumPoints );
+	}
+	
+	// Append the triangles, renumbering their vertices
+	const TQ3Uns32*	pointIndices = inGeomData.triangles[0].pointIndices;
+	const TQ3Uns32	kNumIndices = 3 * inGeomData.numTriangles;
+	const TQ3Uns32	kIndexBase = static_cast<TQ3Uns32>( mIndices.size() );
+	mIndices.resize( kIndexBase + kNumIndices );
+	for (TQ3Uns32 i = 0; i < kNumIndices; ++i)
+	{
+		mIndices[ kIndexBase + i ] = pointIndices[i] + kBase;
+	}
+}
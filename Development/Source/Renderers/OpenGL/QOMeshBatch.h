@@ -0,0 +1,139 @@
+/*!
+	@header		QOMeshBatch.h
+	
+	Class to merge small opaque TriMeshes into shared draw calls for the
+	Quesa OpenGL renderer.
+*/
+
+/*  NAME:
+        QOMeshBatch.h
+
+    DESCRIPTION:
+        Header for Quesa OpenGL renderer class.
+
+    COPYRIGHT:
+        Copyright (c) 2026, Quesa Developers. All rights reserved.
+
+        For the current release of Quesa, please see:
+
+            <https://github.com/jwwalker/Quesa>
+        
+        Redistribution and use in source and binary forms, with or without
+        modification, are permitted provided that the following conditions
+        are met:
+        
+            o Redistributions of source code must retain the above copyright
+              notice, this list of conditions and the following disclaimer.
+        
+            o Redistributions in binary form must reproduce the above
+              copyright notice, this list of conditions and the following
+              disclaimer in the documentation and/or other materials provided
+              with the distribution.
+        
+            o Neither the name of Quesa nor the names of its contributors
+              may be used to endorse or promote products derived from this
+              software without specific prior written permission.
+        
+        THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+        "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+        LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+        A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+        OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+        SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+        TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+        PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+        LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+        NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+        SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+    ___________________________________________________________________________
+*/
+
+
+
+
+#ifndef QOMESHBATCH_HDR
+#define QOMESHBATCH_HDR
+
+//=============================================================================
+//      Include files
+//-----------------------------------------------------------------------------
+
+#include "QOPrefix.h"
+
+#include <vector>
+
+
+//=============================================================================
+//      Class Declaration
+//-----------------------------------------------------------------------------
+
+namespace QORenderer
+{
+
+class Renderer;
+
+/*!
+	@class		MeshBatch
+	@abstract	Buffer that collects small fast-path TriMeshes submitted one
+				after another with the same material, and draws them with one
+				draw call.
+	@discussion	The vertices are transformed to camera coordinates as they are
+				added, so the batch need not be flushed when the local to
+				camera matrix changes.  It is drawn with an identity model-view
+				matrix.  The renderer must flush the batch before changing any
+				other state that affects drawing.
+*/
+class MeshBatch
+{
+public:
+							MeshBatch(
+									Renderer& inRenderer );
+	
+	/*!
+		@function	Flush
+		@abstract	Draw and empty the batch, and bring the model-view
+					transform up to date.
+	*/
+	void					Flush();
+	
+	/*!
+		@function	SetModelViewPending
+		@abstract	Note that the local to camera matrix has changed, but has
+					not been passed to OpenGL.
+		@discussion	Batched TriMeshes do not use the model-view transform,
+					and any other geometry flushes the batch before it is
+					drawn, so the transform need only be set then.
+	*/
+	void					SetModelViewPending() { mIsModelViewPending = true; }
+	
+	/*!
+		@function	AddTriMesh
+		@abstract	Add a fast-path TriMesh to the batch, flushing it first if
+					the TriMesh cannot share its draw call.
+		@param		inGeomData		Data of the TriMesh.
+		@param		inVertNormals	Vertex normals.
+		@param		inVertUVs		Vertex texture coordinates, or nullptr.
+		@param		inVertColors	Vertex colors, or nullptr.
+	*/
+	void					AddTriMesh(
+									const TQ3TriMeshData& inGeomData,
+									const TQ3Vector3D* _Nonnull inVertNormals,
+									const TQ3Param2D* _Nullable inVertUVs,
+									const TQ3ColorRGB* _Nullable inVertColors );
+	
+	bool					IsEmpty() const { return mIndices.empty(); }
+
+private:
+	Renderer&				mRenderer;
+	bool					mHasUVs;
+	bool					mIsModelViewPending;
+	std::vector<TQ3Point3D>		mPoints;
+	std::vector<TQ3Vector3D>	mNormals;
+	std::vector<TQ3ColorRGB>	mColors;
+	std::vector<TQ3Param2D>		mUVs;
+	std::vector<TQ3Uns32>		mIndices;
+};
+
+}
+
+#endif
@@ -149,6 +149,7 @@ void	QORenderer::OpaqueTriBuffer::Flush()
 			
 			// Draw
 			glDrawArrays( GL_TRIANGLES, 0, kNumVertices );
+			mRenderer.CountDrawCall();
 			
 			(*mRenderer.mFuncs.glBindBufferProc)( GL_ARRAY_BUFFER, 0 );
 			(*mRenderer.mFuncs.glBindBufferProc)( GL_ELEMENT_ARRAY_BUFFER, 0 );
@@ -50,6 +50,7 @@
 #include "E3Compatibility.h"
 #include "QORenderer.h"
 #include "QOStatics.h"
+#include "GLDrawContext.h"
 
 
 //=============================================================================
@@ -96,4 +97,7 @@ void				QORenderer_Unregister(void)
 		// Unregister the class
 		Q3XObjectHierarchy_UnregisterClass( theClass );
 	}
+	
+	// Dispose of any OpenGL context kept alive between renderers
+	GLDrawContext_Terminate();
 }
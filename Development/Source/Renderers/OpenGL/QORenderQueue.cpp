@@ -0,0 +1,227 @@
+/*  NAME:
+        QORenderQueue.cpp
+
+    DESCRIPTION:
+        Source for Quesa OpenGL renderer class.
+
+    COPYRIGHT:
+        Copyright (c) 2026, Quesa Developers. All rights reserved.
+
+        For the current release of Quesa, please see:
+
+            <https://github.com/jwwalker/Quesa>
+        
+        Redistribution and use in source and binary forms, with or without
+        modification, are permitted provided that the following conditions
+        are met:
+        
+            o Redistributions of source code must retain the above copyright
+              notice, this list of conditions and the following disclaimer.
+        
+            o Redistributions in binary form must reproduce the above
+              copyright notice, this list of conditions and the following
+              disclaimer in the documentation and/or other materials provided
+              with the distribution.
+        
+            o Neither the name of Quesa nor the names of its contributors
+              may be used to endorse or promote products derived from this
+              software without specific prior written permission.
+        
+        THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+        "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+        LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+        A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+        OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+        SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+        TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+        PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+        LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+        NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+        SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+    ___________________________________________________________________________
+*/
+
+
+
+//=============================================================================
+//      Include files
+//-----------------------------------------------------------------------------
+#include "QORenderer.h"
+#include "GLCamera.h"
+
+#include <algorithm>
+
+
+//=============================================================================
+//      Class Implementation
+//-----------------------------------------------------------------------------
+
+/*!
+	@function	RenderQueue (constructor)
+	@abstract	Initialize the queue.
+*/
+QORenderer::RenderQueue::RenderQueue(
+									Renderer& inRenderer  )
+	: mRenderer( inRenderer )
+{
+}
+
+
+/*!
+	@function	AddTriMesh
+	@abstract	Queue a fast-path TriMesh with the current state.
+	@discussion	The material colors are those that HandleGeometryAttributes
+				has just made current for this TriMesh.
+*/
+void	QORenderer::RenderQueue::AddTriMesh(
+									TQ3GeometryObject _Nonnull inTriMesh )
+{
+	mEntries.push_back( Entry() );
+	Entry&	theEntry( mEntries.back() );
+	
+	theEntry.mTriMesh = CQ3ObjectRef( Q3Shared_GetReference( inTriMesh ) );
+	theEntry.mSurfaceShader = mRenderer.mSurfaceShader;
+	theEntry.mLocalToCamera = mRenderer.mMatrixState.GetLocalToCamera();
+	theEntry.mDiffuseColor = *mRenderer.mGeomState.diffuseColor;
+	theEntry.mSpecularColor = mRenderer.mCurrentSpecularColor;
+	theEntry.mEmissiveColor = mRenderer.mCurrentEmissiveColor;
+	theEntry.mSpecularControl = mRenderer.mCurrentSpecularControl;
+	theEntry.mMetallic = mRenderer.mCurrentMetallic;
+	
+	// The shader decides the texture and hence the program, so it is the
+	// more significant part of the key.
+	theEntry.mSortKey = (static_cast<unsigned long long>(
+		FindShaderIndex( theEntry.mSurfaceShader.get() ) ) << 32) |
+		FindMaterialIndex( theEntry );
+}
+
+
+/*!
+	@function	Material::operator<
+	@abstract	Compare materials value by value.
+*/
+bool	QORenderer::RenderQueue::Material::operator<( const Material& inOther ) const
+{
+	return std::lexicographical_compare( mValues, mValues + 8,
+		inOther.mValues, inOther.mValues + 8 );
+}
+
+
+/*!
+	@function	FindShaderIndex
+	@abstract	Number surface shaders in order of first appearance in the
+				queue.
+*/
+TQ3Uns32	QORenderer::RenderQueue::FindShaderIndex(
+									TQ3ShaderObject _Nullable inShader )
+{
+	TQ3Uns32	newIndex = static_cast<TQ3Uns32>( mShaderIndices.size() );
+	
+	return mShaderIndices.insert( std::make_pair( inShader, newIndex ) ).first->second;
+}
+
+
+/*!
+	@function	FindMaterialIndex
+	@abstract	Number materials in order of first appearance in the queue.
+	@discussion	The diffuse color is not part of the material, since it is
+				passed as a vertex attribute and costs nothing to change.
+*/
+TQ3Uns32	QORenderer::RenderQueue::FindMaterialIndex( const Entry& inEntry )
+{
+	Material	theMaterial = {
+		{
+			inEntry.mSpecularColor.r, inEntry.mSpecularColor.g,
+			inEntry.mSpecularColor.b,
+			inEntry.mEmissiveColor.r, inEntry.mEmissiveColor.g,
+			inEntry.mEmissiveColor.b,
+			inEntry.mSpecularControl, inEntry.mMetallic
+		}
+	};
+	TQ3Uns32	newIndex = static_cast<TQ3Uns32>( mMaterialIndices.size() );
+	
+	return mMaterialIndices.insert( std::make_pair( theMaterial, newIndex ) ).first->second;
+}
+
+
+/*!
+	@function	Flush
+	@abstract	Draw the queued TriMeshes in sorted order and empty the queue.
+	@discussion	Each TriMesh is drawn with the surface shader, materials and
+				transform that were current when it was queued.  Afterward the
+				state that was current when Flush was called is restored, so
+				that the rest of the frame is not affected.
+*/
+void	QORenderer::RenderQueue::Flush()
+{
+	if (mEntries.empty())
+	{
+		return;
+	}
+	
+	const TQ3Uns32	kNumEntries = static_cast<TQ3Uns32>( mEntries.size() );
+	TQ3Uns32	i;
+	
+	// Sort, keeping submission order among equals.
+	mOrder.resize( kNumEntries );
+	for (i = 0; i < kNumEntries; ++i)
+	{
+		mOrder[i] = i;
+	}
+	std::stable_sort( mOrder.begin(), mOrder.end(),
+		[this]( TQ3Uns32 a, TQ3Uns32 b )
+		{
+			return mEntries[a].mSortKey < mEntries[b].mSortKey;
+		} );
+	
+	// Remember the current state.
+	CQ3ObjectRef	liveShader( mRenderer.mSurfaceShader );
+	TQ3Matrix4x4	liveLocalToCamera( mRenderer.mMatrixState.GetLocalToCamera() );
+	ColorState		liveGeomState( mRenderer.mGeomState );
+	TQ3ColorRGB		liveSpecularColor( mRenderer.mCurrentSpecularColor );
+	TQ3ColorRGB		liveEmissiveColor( mRenderer.mCurrentEmissiveColor );
+	float			liveSpecularControl = mRenderer.mCurrentSpecularControl;
+	float			liveMetallic = mRenderer.mCurrentMetallic;
+	TQ3ShaderObject	currentShader = liveShader.get();
+	
+	mRenderer.mLights.SetLowDimensionalMode( false, mRenderer.mViewIllumination );
+	
+	for (i = 0; i < kNumEntries; ++i)
+	{
+		const Entry&	theEntry( mEntries[ mOrder[i] ] );
+		
+		if (theEntry.mSurfaceShader.get() != currentShader)
+		{
+			currentShader = theEntry.mSurfaceShader.get();
+			mRenderer.ApplySurfaceShader( currentShader );
+		}
+		
+		mRenderer.SetSpecularColor( theEntry.mSpecularColor );
+		mRenderer.SetSpecularControl( theEntry.mSpecularControl );
+		mRenderer.SetMetallic( theEntry.mMetallic );
+		mRenderer.SetEmissiveMaterial( theEntry.mEmissiveColor );
+		mRenderer.mGeomState.diffuseColor = &theEntry.mDiffuseColor;
+		
+		mRenderer.mMatrixState.SetLocalToCamera( theEntry.mLocalToCamera );
+		GLCamera_SetModelView( &theEntry.mLocalToCamera, mRenderer.mPPLighting );
+		
+		mRenderer.RenderQueuedTriMesh( theEntry.mTriMesh.get() );
+	}
+	
+	// Restore the current state.
+	if (currentShader != liveShader.get())
+	{
+		mRenderer.ApplySurfaceShader( liveShader.get() );
+	}
+	mRenderer.SetSpecularColor( liveSpecularColor );
+	mRenderer.SetSpecularControl( liveSpecularControl );
+	mRenderer.SetMetallic( liveMetallic );
+	mRenderer.SetEmissiveMaterial( liveEmissiveColor );
+	mRenderer.mGeomState = liveGeomState;
+	mRenderer.mMatrixState.SetLocalToCamera( liveLocalToCamera );
+	GLCamera_SetModelView( &liveLocalToCamera, mRenderer.mPPLighting );
+	
+	mEntries.clear();
+	mShaderIndices.clear();
+	mMaterialIndices.clear();
+}
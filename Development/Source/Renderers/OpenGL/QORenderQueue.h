@@ -0,0 +1,142 @@
+/*!
+	@header		QORenderQueue.h
+	
+	Class to defer and sort opaque TriMeshes for the Quesa OpenGL renderer.
+*/
+
+/*  NAME:
+        QORenderQueue.h
+
+    DESCRIPTION:
+        Header for Quesa OpenGL renderer class.
+
+    COPYRIGHT:
+        Copyright (c) 2026, Quesa Developers. All rights reserved.
+
+        For the current release of Quesa, please see:
+
+            <https://github.com/jwwalker/Quesa>
+        
+        Redistribution and use in source and binary forms, with or without
+        modification, are permitted provided that the following conditions
+        are met:
+        
+            o Redistributions of source code must retain the above copyright
+              notice, this list of conditions and the following disclaimer.
+        
+            o Redistributions in binary form must reproduce the above
+              copyright notice, this list of conditions and the following
+              disclaimer in the documentation and/or other materials provided
+              with the distribution.
+        
+            o Neither the name of Quesa nor the names of its contributors
+              may be used to endorse or promote products derived from this
+              software without specific prior written permission.
+        
+        THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+        "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+        LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+        A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+        OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+        SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+        TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+        PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+        LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+        NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+        SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+    ___________________________________________________________________________
+*/
+
+
+
+
+#ifndef QORENDERQUEUE_HDR
+#define QORENDERQUEUE_HDR
+
+//=============================================================================
+//      Include files
+//-----------------------------------------------------------------------------
+
+#include "QOPrefix.h"
+#include "CQ3ObjectRef.h"
+
+#include <map>
+#include <vector>
+
+
+//=============================================================================
+//      Class Declaration
+//-----------------------------------------------------------------------------
+
+namespace QORenderer
+{
+
+class Renderer;
+
+/*!
+	@class		RenderQueue
+	@abstract	Queue of fast-path TriMeshes whose drawing is deferred, so that
+				they can be drawn sorted by surface shader and material.
+	@discussion	Each entry records the state that may vary from one TriMesh
+				to the next: the surface shader, the material colors and the
+				local to camera matrix.  The renderer must flush the queue
+				before changing any other state that affects drawing.
+*/
+class RenderQueue
+{
+public:
+							RenderQueue(
+									Renderer& inRenderer );
+	
+	/*!
+		@function	Flush
+		@abstract	Draw the queued TriMeshes in sorted order and empty the
+					queue, then restore the renderer's current state.
+	*/
+	void					Flush();
+	
+	/*!
+		@function	AddTriMesh
+		@abstract	Queue a fast-path TriMesh with the current state.
+		@param		inTriMesh		A TriMesh object.
+	*/
+	void					AddTriMesh(
+									TQ3GeometryObject _Nonnull inTriMesh );
+	
+	bool					IsEmpty() const { return mEntries.empty(); }
+
+private:
+	struct Entry
+	{
+		CQ3ObjectRef		mTriMesh;
+		CQ3ObjectRef		mSurfaceShader;
+		TQ3Matrix4x4		mLocalToCamera;
+		TQ3ColorRGB			mDiffuseColor;
+		TQ3ColorRGB			mSpecularColor;
+		TQ3ColorRGB			mEmissiveColor;
+		float				mSpecularControl;
+		float				mMetallic;
+		unsigned long long	mSortKey;
+	};
+	
+	// Material values, ordered so that they can key a map
+	struct Material
+	{
+		bool				operator<( const Material& inOther ) const;
+		
+		float				mValues[8];
+	};
+	
+	TQ3Uns32				FindMaterialIndex( const Entry& inEntry );
+	TQ3Uns32				FindShaderIndex( TQ3ShaderObject _Nullable inShader );
+	
+	Renderer&				mRenderer;
+	std::vector<Entry>		mEntries;
+	std::vector<TQ3Uns32>	mOrder;
+	std::map<TQ3ShaderObject, TQ3Uns32>	mShaderIndices;
+	std::map<Material, TQ3Uns32>		mMaterialIndices;
+};
+
+}
+
+#endif
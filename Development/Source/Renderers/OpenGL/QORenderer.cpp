@@ -192,16 +192,28 @@ QORenderer::Renderer::Renderer( TQ3RendererObject inRenderer )
 	, mPassIndex( 0 )
 	, mNumPasses( 1 )
 	, mAllowLineSmooth( true )
+	, mIsVertexCacheOptimizing( false )
 	, mIsCachingShadows( false )
+	, mIsBatchingSmallMeshes( false )
 	, mNumPrimitivesRenderedInFrame( 0 )
+	, mNumDrawCallsInFrame( 0 )
+	, mIsSortingOpaqueTriMeshes( false )
+	, mNumProgramSwitchesInFrame( 0 )
+	, mNumTextureBindsInFrame( 0 )
+	, mTransparencySortMicrosecondsInFrame( 0 )
+	, mIsUsingWeightedTransparency( false )
+	, mIsPremultiplyingFastPathColor( false )
 	, mLineWidth( 1.0f )
 	, mAttributesMask( kQ3XAttributeMaskAll )
 	, mUpdateShader( true )
 	, mGLClientStates( mSLFuncs, mPPLighting )
 	, mLights( *this )
 	, mTriBuffer( *this )
+	, mMeshBatch( *this )
 	, mTransBuffer( *this, mPPLighting )
 	, mTextures( *this )
+	, mRenderQueue( *this )
+	, mWeightedTrans( *this )
 {
 	Q3Object_AddElement( mRendererObject, kQ3ElementTypeDepthBits,
 		&kDefaultDepthBits );
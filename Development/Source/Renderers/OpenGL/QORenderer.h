@@ -61,6 +61,9 @@
 #include "QOClientStates.h"
 #include "QOMatrix.h"
 #include "QOOpaqueTriBuffer.h"
+#include "QOMeshBatch.h"
+#include "QORenderQueue.h"
+#include "QOWeightedTransparency.h"
 #include "QOTransBuffer.h"
 #include "QOGLShadingLanguage.h"
 #include "QOCalcTriMeshEdges.h"
@@ -275,6 +278,12 @@ public:
 	float					LineWidth() const { return mLineWidth; }
 	
 	void					RefreshMaterials();
+	void					BindPendingTexture() { mTextures.HandlePendingTextureBind(); }
+	void					CountDrawCall() const { ++mNumDrawCallsInFrame; }
+	void					CountProgramSwitch() const { ++mNumProgramSwitchesInFrame; }
+	void					CountTextureBind() const { ++mNumTextureBindsInFrame; }
+	void					CountTransparencySortTime( unsigned long long inMicroseconds )
+								{ mTransparencySortMicrosecondsInFrame += inMicroseconds; }
 
 protected:
 							Renderer( TQ3RendererObject inRenderer );
@@ -283,6 +292,9 @@ protected:
 	friend class Statics;
 	friend class TransBuffer;
 	friend class OpaqueTriBuffer;
+	friend class MeshBatch;
+	friend class RenderQueue;
+	friend class WeightedTransparency;
 	
 	//
 	//	non-static methods that implement static methods
@@ -345,6 +357,8 @@ protected:
 									const TQ3Switch* inAttState );
 	void					UpdateSurfaceShader(
 									TQ3ShaderObject inShader );
+	void					ApplySurfaceShader(
+									TQ3ShaderObject inShader );
 	void					UpdateIlluminationShader(
 									TQ3ShaderObject inShader );
 
@@ -402,6 +416,9 @@ protected:
 									const TQ3Vector3D* inVertNormals,
 									const TQ3Param2D* inVertUVs,
 									const TQ3ColorRGB* inVertColors );
+	void					RenderQueuedTriMesh(
+									TQ3GeometryObject inTriMesh );
+	void					SetFastPathColor( bool inIsTextured );
 	void					RenderSlowPathTriMesh(
 									TQ3GeometryObject inTriMesh,
 									TQ3ViewObject inView,
@@ -433,8 +450,17 @@ protected:
 	TQ3Int32				mPassIndex;
 	TQ3Int32				mNumPasses;
 	bool					mAllowLineSmooth;
+	bool					mIsVertexCacheOptimizing; // cached value of kQ3RendererPropertyVertexCacheOptimization
 	bool					mIsCachingShadows;
+	bool					mIsBatchingSmallMeshes; // cached value of kQ3RendererPropertyBatchSmallTriMeshes
 	unsigned long long		mNumPrimitivesRenderedInFrame;
+	mutable unsigned long long	mNumDrawCallsInFrame;
+	bool					mIsSortingOpaqueTriMeshes; // cached value of kQ3RendererPropertySortOpaqueTriMeshes
+	mutable unsigned long long	mNumProgramSwitchesInFrame;
+	mutable unsigned long long	mNumTextureBindsInFrame;
+	unsigned long long		mTransparencySortMicrosecondsInFrame;
+	bool					mIsUsingWeightedTransparency; // cached value of kQ3RendererPropertyOrderIndependentTransparency
+	bool					mIsPremultiplyingFastPathColor;
 	
 	// Buffers used temporarily in QOGeometry.cpp, only members to reduce
 	// memory allocation
@@ -467,11 +493,23 @@ protected:
 	// Buffer for opaque triangles
 	OpaqueTriBuffer			mTriBuffer;
 	
+	// Buffer for small opaque TriMeshes
+	MeshBatch				mMeshBatch;
+	
 	// Buffer for transparent stuff
 	TransBuffer				mTransBuffer;
 	
 	// Texture state
 	Texture					mTextures;
+	CQ3ObjectRef			mSurfaceShader;
+	
+	// Queue of opaque TriMeshes to draw sorted by state
+	RenderQueue				mRenderQueue;
+	
+	// Queue of transparent TriMeshes for order-independent transparency.
+	// Declared last, so that its OpenGL objects are deleted while the
+	// context still exists.
+	WeightedTransparency	mWeightedTrans;
 };
 
 }	// end QORenderer namespace
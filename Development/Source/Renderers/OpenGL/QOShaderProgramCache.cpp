@@ -81,6 +81,7 @@ QORenderer::ProgramCharacteristic::ProgramCharacteristic()
 	, mFogModeCombined( kFogModeOff )
 	, mIsUsingClippingPlane( false )
 	, mAngleAffectsAlpha( true )
+	, mIsWeightedBlended( false )
 	, mDimension( 2 )
 {
 }
@@ -97,6 +98,7 @@ QORenderer::ProgramCharacteristic::ProgramCharacteristic(
 	, mFogModeCombined( inOther.mFogModeCombined )
 	, mIsUsingClippingPlane( inOther.mIsUsingClippingPlane )
 	, mAngleAffectsAlpha( inOther.mAngleAffectsAlpha )
+	, mIsWeightedBlended( inOther.mIsWeightedBlended )
 	, mDimension( inOther.mDimension )
 {
 }
@@ -114,6 +116,7 @@ bool	QORenderer::ProgramCharacteristic::operator==(
 			(mFogModeCombined == inOther.mFogModeCombined ) &&
 			(mIsUsingClippingPlane == inOther.mIsUsingClippingPlane) &&
 			(mAngleAffectsAlpha == inOther.mAngleAffectsAlpha) &&
+			(mIsWeightedBlended == inOther.mIsWeightedBlended) &&
 			(mDimension == inOther.mDimension);
 }
 
@@ -131,6 +134,7 @@ void	QORenderer::ProgramCharacteristic::swap(
 	std::swap( mFogModeCombined, ioOther.mFogModeCombined );
 	std::swap( mIsUsingClippingPlane, ioOther.mIsUsingClippingPlane );
 	std::swap( mAngleAffectsAlpha, ioOther.mAngleAffectsAlpha );
+	std::swap( mIsWeightedBlended, ioOther.mIsWeightedBlended );
 	std::swap( mDimension, ioOther.mDimension );
 	std::swap( mProjectionType, ioOther.mProjectionType );
 }
@@ -136,6 +136,7 @@ struct ProgramCharacteristic
 	EFogModeCombined		mFogModeCombined;
 	bool					mIsUsingClippingPlane;
 	bool					mAngleAffectsAlpha;
+	bool					mIsWeightedBlended;
 	int						mDimension;
 	
 	void					swap( ProgramCharacteristic& ioOther );
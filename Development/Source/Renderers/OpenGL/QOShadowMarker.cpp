@@ -103,78 +103,6 @@ TQ3RationalPoint4D		QORenderer::ShadowMarker::CalcLocalLightPosition()
 	return localLightPos;
 }
 
-/*!
-	@function	ComputeFaceNormals
-	@abstract	Compute a normal (which need not be unit length) for
-				each triangle.
-*/
-static void ComputeFaceNormals( const TQ3TriMeshData& inTMData,
-								E3FastArray<TQ3Vector3D>& outNormals )
-{
-	const TQ3Uns32 kNumFaces = inTMData.numTriangles;
-	outNormals.resizeNotPreserving( kNumFaces );
-	
-	for (TQ3Uns32 i = 0; i < kNumFaces; ++i)
-	{
-		Q3FastPoint3D_CrossProductTri(
-			&inTMData.points[ inTMData.triangles[i].pointIndices[0] ],
-			&inTMData.points[ inTMData.triangles[i].pointIndices[1] ],
-			&inTMData.points[ inTMData.triangles[i].pointIndices[2] ],
-			&outNormals[i] );
-	}
-}
-
-/*!
-	@function	FindLitFaces
-	@abstract	Determine which of the triangles face toward the light.
-*/
-static void FindLitFaces( const TQ3RationalPoint4D& inLightPos,
-						const TQ3TriMeshData& inTMData,
-						const TQ3Vector3D* inFaceNormals,
-						TQ3Uns8* outFlags )
-{
-	const TQ3Uns32 kNumFaces = inTMData.numTriangles;
-
-	// Compute face normals if we do not have them.
-	E3FastArray<TQ3Vector3D>	faceNormals;
-	if (inFaceNormals == nullptr)
-	{
-		ComputeFaceNormals( inTMData, faceNormals );
-		inFaceNormals = &faceNormals[0];
-	}
-	
-	TQ3Vector3D	toLight;
-	TQ3Uns32	faceNum;
-	
-	if (inLightPos.w == 0.0f)	// directional
-	{
-		toLight.x = inLightPos.x;
-		toLight.y = inLightPos.y;
-		toLight.z = inLightPos.z;
-		
-		for (faceNum = 0; faceNum < kNumFaces; ++faceNum)
-		{
-			outFlags[ faceNum ] = Q3FastVector3D_Dot( &toLight,
-				&inFaceNormals[ faceNum ] ) > 0.0f;
-		}
-	}
-	else // point or spot
-	{
-		TQ3Point3D	lightPos3 = { inLightPos.x, inLightPos.y, inLightPos.z };
-		
-		for (faceNum = 0; faceNum < kNumFaces; ++faceNum)
-		{
-			Q3FastPoint3D_Subtract( &lightPos3,
-				&inTMData.points[ inTMData.triangles[faceNum].pointIndices[0] ],
-				&toLight  );
-			
-			outFlags[ faceNum ] = Q3FastVector3D_Dot( &toLight,
-				&inFaceNormals[ faceNum ] ) > 0.0f;
-		}
-	}
-}
-
-
 /*!
 	@function	GetTriMeshEdges
 	@abstract	Retrieve or compute data about the edges and how they are
@@ -196,31 +124,6 @@ void QORenderer::ShadowMarker::GetTriMeshEdges( TQ3GeometryObject inTMObject,
 }
 
 
-/*!
-	@function	FlipTowardLight
-	@abstract	Reverse the orientation of triangles that do not face the
-				light.
-*/
-static void FlipTowardLight(
-							const TQ3Uns32 inNumFaces,
-							const TQ3Uns8* inLitFaceFlags,
-							TQ3TriMeshTriangleData* ioFaces,
-							TQ3TriangleToEdgeVec& ioFacesToEdges )
-{
-	TQ3Uns32	i;
-	for (i = 0; i < inNumFaces; ++i)
-	{
-		if (! inLitFaceFlags[ i ])
-		{
-			std::swap( ioFaces[i].pointIndices[0], ioFaces[i].pointIndices[2] );
-			std::swap( ioFacesToEdges[i].edgeIndices[0],
-				ioFacesToEdges[i].edgeIndices[1] );
-		}
-	}
-}
-
-
-
 static bool IsFaceVisible( TQ3BackfacingStyle inBackfacing, bool inFrontFace )
 {
 	bool	isVis = true;
@@ -244,6 +147,59 @@ static bool IsFaceVisible( TQ3BackfacingStyle inBackfacing, bool inFrontFace )
 }
 
 
+/*!
+	@function	AddCapFaces
+	@abstract	Add the faces that cast shadows, oriented toward the light, to
+				the shadow geometry as the front cap, and optionally the same
+				faces reversed and extruded to infinity as the back cap.
+	@result		Number of indices added.
+*/
+TQ3Uns32	QORenderer::ShadowMarker::AddCapFaces(
+								const TQ3TriMeshData& inTMData,
+								const SilhouetteState& inSilhouette,
+								bool inAddBackCap,
+								GLuint* ioVertIndices )
+{
+	const TQ3Uns32	kNumFaces = inTMData.numTriangles;
+	const TQ3Uns32	kNumPoints = inTMData.numPoints;
+	const TQ3Uns8*	litFaceFlags = inSilhouette.mLitFaceFlags.data();
+	
+	// If we are not removing backfaces, all faces are flipped toward the light.
+	const bool		isFlipping = (mStyleState.mBackfacing != kQ3BackfacingStyleRemove);
+	TQ3Uns32		numVertIndices = 0;
+	
+	for (TQ3Uns32 i = 0; i < kNumFaces; ++i)
+	{
+		if ( IsFaceVisible( mStyleState.mBackfacing, litFaceFlags[i] != 0 ) )
+		{
+			const TQ3TriMeshTriangleData& theFace( inTMData.triangles[i] );
+			TQ3Uns32	first = theFace.pointIndices[0];
+			TQ3Uns32	last = theFace.pointIndices[2];
+			
+			if (isFlipping && (litFaceFlags[i] == 0))
+			{
+				std::swap( first, last );
+			}
+			
+			// Add front cap
+			ioVertIndices[ numVertIndices++ ] = first;
+			ioVertIndices[ numVertIndices++ ] = theFace.pointIndices[1];
+			ioVertIndices[ numVertIndices++ ] = last;
+			
+			// Add back cap.
+			if (inAddBackCap)
+			{
+				ioVertIndices[ numVertIndices++ ] = last + kNumPoints;
+				ioVertIndices[ numVertIndices++ ] = theFace.pointIndices[1] + kNumPoints;
+				ioVertIndices[ numVertIndices++ ] = first + kNumPoints;
+			}
+		}
+	}
+	
+	return numVertIndices;
+}
+
+
 /*!
 	@function	BuildShadowOfTriMeshDirectional
 	@abstract	Compute the shadow geometry for a TriMesh, using a directional
@@ -252,8 +208,7 @@ static bool IsFaceVisible( TQ3BackfacingStyle inBackfacing, bool inFrontFace )
 */
 void	QORenderer::ShadowMarker::BuildShadowOfTriMeshDirectional(
 								const TQ3TriMeshData& inTMData,
-								const TQ3TriMeshTriangleData* inFaces,
-								const TQ3TriangleEdges* inFacesToEdges,
+								const SilhouetteState& inSilhouette,
 								const TQ3RationalPoint4D& inLocalLightPos,
 								TQ3Uns32& outNumTriIndices )
 {
@@ -281,16 +236,6 @@ void	QORenderer::ShadowMarker::BuildShadowOfTriMeshDirectional(
 		0.0f
 	};
 	verts[ kNumPoints ] = oppositePt;
-
-	// Set up edge counters.
-	const TQ3Uns32	kNumEdges = mShadowEdges.size();
-	const TQ3EdgeEnds* theEdges = mShadowEdges.data();
-	if (mShadowEdgeCounters.size() < kNumEdges)
-	{
-		mShadowEdgeCounters.resizeNotPreserving( kNumEdges );
-	}
-	TQ3Int32*	edgeCounter = &mShadowEdgeCounters[0];
-	std::fill( edgeCounter, edgeCounter + kNumEdges, 0 );
 	
 	// Make the array of shadow vertices big enough.
 	// The number of faces in the front cap is at most the number of faces in
@@ -305,61 +250,32 @@ void	QORenderer::ShadowMarker::BuildShadowOfTriMeshDirectional(
 	}
 
 	// Build front cap.
-	TQ3Uns32	numVertIndices = 0;
 	GLuint*		vertIndices = &mShadowVertIndices[0];
-	const TQ3Uns8* litFaceFlags = &mLitFaceFlags[0];
-	TQ3Uns32 e;
-	for (i = 0; i < kNumFaces; ++i)
-	{
-		if ( IsFaceVisible( mStyleState.mBackfacing, litFaceFlags[i] != 0 ) )
-		{
-			const TQ3TriMeshTriangleData& theFace( inFaces[i] );
-			
-			// Render front cap
-			vertIndices[ numVertIndices++ ] = theFace.pointIndices[0];
-			vertIndices[ numVertIndices++ ] = theFace.pointIndices[1];
-			vertIndices[ numVertIndices++ ] = theFace.pointIndices[2];
-
-			// Update edges of this face.
-			const TQ3TriangleEdges& faceEdges( inFacesToEdges[ i ] );
-			for (e = 0; e < 3; ++e)
-			{
-				TQ3Uns32	whichEdge = faceEdges.edgeIndices[e];
-				
-				if (theEdges[ whichEdge ].pointIndices[0] ==
-					theFace.pointIndices[e])
-				{
-					// edge is directed the same as triangle winding
-					edgeCounter[ whichEdge ] += 1;
-				}
-				else
-				{
-					edgeCounter[ whichEdge ] -= 1;
-				}
-			}
-		}
-	}	
+	TQ3Uns32	numVertIndices = AddCapFaces( inTMData, inSilhouette, false,
+		vertIndices );
 	
 	// Build side triangles.
-	for (i = 0; i < kNumEdges; ++i)
+	const TQ3EdgeEnds* theEdges = mShadowEdges.data();
+	const TQ3Uns32	kNumSilhouetteEdges = inSilhouette.mSilhouetteEdges.size();
+	for (i = 0; i < kNumSilhouetteEdges; ++i)
 	{
-		const TQ3EdgeEnds&	theEdge( theEdges[ i ] );
+		TQ3Uns32	whichEdge = inSilhouette.mSilhouetteEdges[i];
+		const TQ3EdgeEnds&	theEdge( theEdges[ whichEdge ] );
 		TQ3Uns32	edgeStart = theEdge.pointIndices[0];
 		TQ3Uns32	edgeEnd = theEdge.pointIndices[1];
+		TQ3Int32	edgeCounter = inSilhouette.mEdgeCounters[ whichEdge ];
 
-		while (edgeCounter[i] > 0)
+		for (; edgeCounter > 0; --edgeCounter)
 		{
 			vertIndices[ numVertIndices++ ] = edgeEnd;
 			vertIndices[ numVertIndices++ ] = edgeStart;
 			vertIndices[ numVertIndices++ ] = kNumPoints;
-			edgeCounter[i] -= 1;
 		}
-		while (edgeCounter[i] < 0)
+		for (; edgeCounter < 0; ++edgeCounter)
 		{
 			vertIndices[ numVertIndices++ ] = edgeStart;
 			vertIndices[ numVertIndices++ ] = edgeEnd;
 			vertIndices[ numVertIndices++ ] = kNumPoints;
-			edgeCounter[i] += 1;
 		}
 	}
 	
@@ -375,8 +291,7 @@ void	QORenderer::ShadowMarker::BuildShadowOfTriMeshDirectional(
 */
 void	QORenderer::ShadowMarker::BuildShadowOfTriMeshPositional(
 								const TQ3TriMeshData& inTMData,
-								const TQ3TriMeshTriangleData* inFaces,
-								const TQ3TriangleEdges* inFacesToEdges,
+								const SilhouetteState& inSilhouette,
 								const TQ3RationalPoint4D& inLocalLightPos,
 								TQ3Uns32& outNumTriIndices )
 {
@@ -410,16 +325,6 @@ void	QORenderer::ShadowMarker::BuildShadowOfTriMeshPositional(
 		verts[ i + kNumPoints ] = diffPt;
 	}
 	
-	// Set up edge counters.
-	const TQ3Uns32	kNumEdges = mShadowEdges.size();
-	const TQ3EdgeEnds* theEdges = mShadowEdges.data();
-	if (mShadowEdgeCounters.size() < kNumEdges)
-	{
-		mShadowEdgeCounters.resizeNotPreserving( kNumEdges );
-	}
-	TQ3Int32*	edgeCounter = &mShadowEdgeCounters[0];
-	std::fill( edgeCounter, edgeCounter + kNumEdges, 0 );
-	
 	// Allocate space for indices.
 	// The front and back cap may contain up to 2 triangles for each original
 	// triangle, and the side silhouette may have up to 3 quads (6 triangles) for each original
@@ -432,54 +337,22 @@ void	QORenderer::ShadowMarker::BuildShadowOfTriMeshPositional(
 	}
 	
 	// Build front and back caps.
-	TQ3Uns32	numVertIndices = 0;
 	GLuint*		vertIndices = &mShadowVertIndices[0];
-	const TQ3Uns8* litFaceFlags = &mLitFaceFlags[0];
-	TQ3Uns32 e;
-	for (i = 0; i < kNumFaces; ++i)
-	{
-		if ( IsFaceVisible( mStyleState.mBackfacing, litFaceFlags[i] != 0 ) )
-		{
-			const TQ3TriMeshTriangleData& theFace( inFaces[i] );
-			
-			// Add front cap
-			vertIndices[ numVertIndices++ ] = theFace.pointIndices[0];
-			vertIndices[ numVertIndices++ ] = theFace.pointIndices[1];
-			vertIndices[ numVertIndices++ ] = theFace.pointIndices[2];
-
-			// Add back cap.
-			vertIndices[ numVertIndices++ ] = theFace.pointIndices[2] + kNumPoints;
-			vertIndices[ numVertIndices++ ] = theFace.pointIndices[1] + kNumPoints;
-			vertIndices[ numVertIndices++ ] = theFace.pointIndices[0] + kNumPoints;
-			
-			// Update edges of this face.
-			const TQ3TriangleEdges& faceEdges( inFacesToEdges[ i ] );
-			for (e = 0; e < 3; ++e)
-			{
-				TQ3Uns32	whichEdge = faceEdges.edgeIndices[e];
-				
-				if (theEdges[ whichEdge ].pointIndices[0] ==
-					theFace.pointIndices[e])
-				{
-					// edge is directed the same as triangle winding
-					edgeCounter[ whichEdge ] += 1;
-				}
-				else
-				{
-					edgeCounter[ whichEdge ] -= 1;
-				}
-			}
-		}
-	}
+	TQ3Uns32	numVertIndices = AddCapFaces( inTMData, inSilhouette, true,
+		vertIndices );
 
 	// Build side silhouette quads.
-	for (i = 0; i < kNumEdges; ++i)
+	const TQ3EdgeEnds* theEdges = mShadowEdges.data();
+	const TQ3Uns32	kNumSilhouetteEdges = inSilhouette.mSilhouetteEdges.size();
+	for (i = 0; i < kNumSilhouetteEdges; ++i)
 	{
-		const TQ3EdgeEnds&	theEdge( theEdges[ i ] );
+		TQ3Uns32	whichEdge = inSilhouette.mSilhouetteEdges[i];
+		const TQ3EdgeEnds&	theEdge( theEdges[ whichEdge ] );
 		TQ3Uns32	edgeStart = theEdge.pointIndices[0];
 		TQ3Uns32	edgeEnd = theEdge.pointIndices[1];
+		TQ3Int32	edgeCounter = inSilhouette.mEdgeCounters[ whichEdge ];
 
-		while (edgeCounter[i] > 0)
+		for (; edgeCounter > 0; --edgeCounter)
 		{
 			// quad edgeEnd, edgeStart, edgeStart + kNumPoints, edgeEnd + kNumPoints
 			vertIndices[ numVertIndices++ ] = edgeEnd;
@@ -489,9 +362,8 @@ void	QORenderer::ShadowMarker::BuildShadowOfTriMeshPositional(
 			vertIndices[ numVertIndices++ ] = edgeEnd;
 			vertIndices[ numVertIndices++ ] = edgeStart + kNumPoints;
 			vertIndices[ numVertIndices++ ] = edgeEnd + kNumPoints;
-			edgeCounter[i] -= 1;
 		}
-		while (edgeCounter[i] < 0)
+		for (; edgeCounter < 0; ++edgeCounter)
 		{
 			// quad edgeStart, edgeEnd, edgeEnd + kNumPoints, edgeStart + kNumPoints
 			vertIndices[ numVertIndices++ ] = edgeStart;
@@ -501,7 +373,6 @@ void	QORenderer::ShadowMarker::BuildShadowOfTriMeshPositional(
 			vertIndices[ numVertIndices++ ] = edgeStart;
 			vertIndices[ numVertIndices++ ] = edgeEnd + kNumPoints;
 			vertIndices[ numVertIndices++ ] = edgeStart + kNumPoints;
-			edgeCounter[i] += 1;
 		}
 	}
 	outNumTriIndices = numVertIndices;
@@ -510,31 +381,35 @@ void	QORenderer::ShadowMarker::BuildShadowOfTriMeshPositional(
 
 /*!
 	@function	BuildShadowOfTriMesh
-	@abstract	Compute the shadow geometry for a TriMesh, using a positional
-				light.  Store the vertices in mShadowPoints and the triangle
-				and quad indices in mShadowVertIndices.
+	@abstract	Compute the shadow geometry for a TriMesh.  Store the vertices
+				in mShadowPoints and the triangle and quad indices in
+				mShadowVertIndices.
+	@discussion	The silhouette is kept from the last time this TriMesh was
+				shadowed by this light, and only updated for the faces that
+				have turned toward or away from the light since then.
 */
 void	QORenderer::ShadowMarker::BuildShadowOfTriMesh(
 								TQ3GeometryObject inTMObject,
 								const TQ3TriMeshData& inTMData,
 								const TQ3Vector3D* inFaceNormals,
+								TQ3LightObject inLight,
 								const TQ3RationalPoint4D& inLocalLightPos,
 								TQ3Uns32& outNumTriIndices )
 {
-	const TQ3TriMeshTriangleData*	faces;
-	const TQ3TriangleEdges* facesToEdges;
-
-	CalcFacesAndEdgesForShadows( inTMObject, inTMData, inFaceNormals,
-			inLocalLightPos, faces, facesToEdges );
+	GetTriMeshEdges( inTMObject, inTMData );
+	
+	const SilhouetteState&	theSilhouette( mSilhouettes.Update( inTMObject,
+		inLight, inTMData, inFaceNormals, mShadowEdges, mShadowFacesToEdges,
+		inLocalLightPos, mStyleState.mBackfacing ) );
 
 	if (inLocalLightPos.w == 0.0f)
 	{
-		BuildShadowOfTriMeshDirectional( inTMData, faces, facesToEdges,
+		BuildShadowOfTriMeshDirectional( inTMData, theSilhouette,
 			inLocalLightPos, outNumTriIndices );
 	}
 	else
 	{
-		BuildShadowOfTriMeshPositional( inTMData, faces, facesToEdges,
+		BuildShadowOfTriMeshPositional( inTMData, theSilhouette,
 			inLocalLightPos, outNumTriIndices );
 	}
 }
@@ -544,64 +419,18 @@ void	QORenderer::ShadowMarker::MarkShadowOfTriMeshImmediate(
 								TQ3GeometryObject inTMObject,
 								const TQ3TriMeshData& inTMData,
 								const TQ3Vector3D* inFaceNormals,
+								TQ3LightObject inLight,
 								const TQ3RationalPoint4D& inLocalLightPos )
 {
 	TQ3Uns32 numTriIndices;
 	
-	BuildShadowOfTriMesh( inTMObject, inTMData, inFaceNormals, inLocalLightPos,
-		numTriIndices );
+	BuildShadowOfTriMesh( inTMObject, inTMData, inFaceNormals, inLight,
+		inLocalLightPos, numTriIndices );
 
 	RenderImmediateShadowVolumeVBO( mRenderer,	
 		mShadowPoints.size(), &mShadowPoints[0], numTriIndices, &mShadowVertIndices[0] );
 }
 
-
-/*!
-	@function	CalcFacesAndEdgesForShadows
-	@abstract	Compute information about faces and edges of a TriMesh, which
-				will be needed for shadow marking unless we are able to use a
-				previously cached shadow volume from a VBO.
-	@discussion	Besides returning two array pointers, this function has side
-				effects on several member variables:
-				mShadowEdges
-				mShadowFacesToEdges
-				mLitFaceFlags
-				mFlippedFaces
-				mFlippedFacesToEdges
-*/
-void	QORenderer::ShadowMarker::CalcFacesAndEdgesForShadows(
-								TQ3GeometryObject inTMObject,
-								const TQ3TriMeshData& inTMData,
-								const TQ3Vector3D* inFaceNormals,
-								const TQ3RationalPoint4D& inLocalLightPos,
-								const TQ3TriMeshTriangleData*& outFaces,
-								const TQ3TriangleEdges*& outFacesToEdges )
-{
-	GetTriMeshEdges( inTMObject, inTMData );
-	
-	const TQ3Uns32	kNumFaces = inTMData.numTriangles;
-	mLitFaceFlags.resizeNotPreserving( kNumFaces );
-	FindLitFaces( inLocalLightPos, inTMData, inFaceNormals, &mLitFaceFlags[0] );
-	
-	outFaces = inTMData.triangles;
-	outFacesToEdges = mShadowFacesToEdges.data();
-
-	// If we are not removing backfaces, flip all faces toward the light.
-	if (mStyleState.mBackfacing != kQ3BackfacingStyleRemove)
-	{
-		mFlippedFaces.resizeNotPreserving( kNumFaces );
-		std::copy( outFaces, outFaces + kNumFaces, &mFlippedFaces[0] );
-		
-		mFlippedFacesToEdges = mShadowFacesToEdges;		// make a mutable copy
-		
-		FlipTowardLight( kNumFaces, &mLitFaceFlags[0], &mFlippedFaces[0],
-			mFlippedFacesToEdges );
-		
-		outFaces = &mFlippedFaces[0];
-		outFacesToEdges = &mFlippedFacesToEdges[0];
-	}
-}
-
 /*!
 	@function	MarkShadowOfTriMesh
 	@abstract	Mark the shadow of a TriMesh in the stencil buffer.
@@ -641,7 +470,7 @@ void	QORenderer::ShadowMarker::MarkShadowOfTriMesh(
 		(! mIsCachingShadows) )
 	{
 		MarkShadowOfTriMeshImmediate( inTMObject, inTMData, inFaceNormals,
-			localLightPos );
+			inLight, localLightPos );
 	}
 	else
 	{
@@ -651,7 +480,7 @@ void	QORenderer::ShadowMarker::MarkShadowOfTriMesh(
 			TQ3Uns32 numTriIndices;
 			
 			BuildShadowOfTriMesh( inTMObject, inTMData, inFaceNormals,
-				localLightPos, numTriIndices );
+				inLight, localLightPos, numTriIndices );
 			
 			Q3_CHECK_DRAW_ELEMENTS( mShadowPoints.size(),
 				numTriIndices, (const TQ3Uns32*)&mShadowVertIndices[0] );
@@ -54,6 +54,7 @@
 //-----------------------------------------------------------------------------
 #include "QOPrefix.h"
 #include "QOCalcTriMeshEdges.h"
+#include "QOShadowSilhouette.h"
 #include "GLVBOManager.h"
 
 
@@ -111,34 +112,32 @@ private:
 									const TQ3TriMeshData& inTMData );
 	void					BuildShadowOfTriMeshDirectional(
 									const TQ3TriMeshData& inTMData,
-									const TQ3TriMeshTriangleData* inFaces,
-									const TQ3TriangleEdges* inFacesToEdges,
+									const SilhouetteState& inSilhouette,
 									const TQ3RationalPoint4D& inLocalLightPos,
 									TQ3Uns32& outNumTriIndices );
 	void					BuildShadowOfTriMeshPositional(
 									const TQ3TriMeshData& inTMData,
-									const TQ3TriMeshTriangleData* inFaces,
-									const TQ3TriangleEdges* inFacesToEdges,
+									const SilhouetteState& inSilhouette,
 									const TQ3RationalPoint4D& inLocalLightPos,
 									TQ3Uns32& outNumTriIndices );
 	void					BuildShadowOfTriMesh(
 									TQ3GeometryObject inTMObject,
 									const TQ3TriMeshData& inTMData,
 									const TQ3Vector3D* inFaceNormals,
+									TQ3LightObject inLight,
 									const TQ3RationalPoint4D& inLocalLightPos,
 									TQ3Uns32& outNumTriIndices );
 	void					MarkShadowOfTriMeshImmediate(
 									TQ3GeometryObject inTMObject,
 									const TQ3TriMeshData& inTMData,
 									const TQ3Vector3D* inFaceNormals,
+									TQ3LightObject inLight,
 									const TQ3RationalPoint4D& inLocalLightPos );
-	void					CalcFacesAndEdgesForShadows(
-									TQ3GeometryObject inTMObject,
+	TQ3Uns32				AddCapFaces(
 									const TQ3TriMeshData& inTMData,
-									const TQ3Vector3D* inFaceNormals,
-									const TQ3RationalPoint4D& inLocalLightPos,
-									const TQ3TriMeshTriangleData*& outFaces,
-									const TQ3TriangleEdges*& outFacesToEdges );
+									const SilhouetteState& inSilhouette,
+									bool inAddBackCap,
+									GLuint* ioVertIndices );
 
 	const Renderer&			mRenderer;
 	const MatrixState&		mMatrixState;
@@ -152,11 +151,8 @@ private:
 	E3FastArray<char>		mScratchBuffer;
 	TQ3EdgeVec				mShadowEdges;
 	TQ3TriangleToEdgeVec	mShadowFacesToEdges;
-	TQ3TriangleToEdgeVec	mFlippedFacesToEdges;
-	E3FastArray<TQ3TriMeshTriangleData>	mFlippedFaces;
+	SilhouetteCache			mSilhouettes;
 	E3FastArray<TQ3RationalPoint4D>		mShadowPoints;
-	E3FastArray<TQ3Uns8>	mLitFaceFlags;
-	E3FastArray<TQ3Int32>	mShadowEdgeCounters;
 	E3FastArray<GLuint>		mShadowVertIndices;
 };
 
@@ -0,0 +1,563 @@
+/*!
+	@header		QOShadowSilhouette.cpp
+	
+	Incremental shadow silhouettes for use in Quesa OpenGL renderer.
+*/
+
+/*  NAME:
+        QOShadowSilhouette.cpp
+
+    DESCRIPTION:
+        Incremental shadow silhouettes for the Quesa OpenGL renderer.
+
+    COPYRIGHT:
+        Copyright (c) 2026, Quesa Developers. All rights reserved.
+
+        For the current release of Quesa, please see:
+
+            <https://github.com/jwwalker/Quesa>
+        
+        Redistribution and use in source and binary forms, with or without
+        modification, are permitted provided that the following conditions
+        are met:
+        
+            o Redistributions of source code must retain the above copyright
+              notice, this list of conditions and the following disclaimer.
+        
+            o Redistributions in binary form must reproduce the above
+              copyright notice, this list of conditions and the following
+              disclaimer in the documentation and/or other materials provided
+              with the distribution.
+        
+            o Neither the name of Quesa nor the names of its contributors
+              may be used to endorse or promote products derived from this
+              software without specific prior written permission.
+        
+        THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+        "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+        LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+        A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+        OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+        SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+        TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+        PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+        LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+        NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+        SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+    ___________________________________________________________________________
+*/
+
+
+
+//=============================================================================
+//      Include files
+//-----------------------------------------------------------------------------
+#include "QOShadowSilhouette.h"
+#include "E3Main.h"
+#include "E3Parallel.h"
+
+#include <algorithm>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	#include <emmintrin.h>
+	#define QUESA_SHADOW_SSE2		1
+#elif (defined(__ARM_NEON) || defined(__ARM_NEON__)) && (defined(__aarch64__) || defined(_M_ARM64))
+	#include <arm_neon.h>
+	#define QUESA_SHADOW_NEON		1
+#endif
+
+
+namespace
+{
+	const TQ3ObjectType	kPropertyTypeFacePlaneCache	= Q3_OBJECT_TYPE('t', 'm', 'f', 'p');
+	
+	// Fewest faces worth handing to another thread for the light test.
+	const TQ3Uns32		kMinFacesPerTask		= 16384;
+	
+	// Fewest states kept before we look for stale ones.
+	const TQ3Uns32		kMinFlushSize			= 64;
+	
+	struct FacePlaneCacheRec
+	{
+		TQ3Uns32			faceCount;
+		TQ3Uns32			editIndex;
+		// Followed by 4 arrays of PaddedFaceCount( faceCount ) floats: the
+		// x, y, and z components of the face normals, and the plane
+		// constants.
+	};
+}
+
+
+/*!
+	@function	PaddedFaceCount
+	@abstract	Round a number of faces up to a multiple of 4, the number of
+				faces tested at once.
+*/
+static inline TQ3Uns32 PaddedFaceCount( TQ3Uns32 inNumFaces )
+{
+	return (inNumFaces + 3) & ~3U;
+}
+
+
+/*!
+	@function	ComputeFacePlanes
+	@abstract	Compute the plane of each face, in structure of arrays form.
+	@discussion	The normals need not be of unit length.  A face faces a light
+				at the homogeneous position L if nx*L.x + ny*L.y + nz*L.z +
+				d*L.w > 0.  Padding faces get zero planes, so they never face
+				the light.
+*/
+static void ComputeFacePlanes( const TQ3TriMeshData& inTMData,
+								const TQ3Vector3D* inFaceNormals,
+								float* outPlanes )
+{
+	const TQ3Uns32	kNumFaces = inTMData.numTriangles;
+	const TQ3Uns32	kStride = PaddedFaceCount( kNumFaces );
+	float*	nx = outPlanes;
+	float*	ny = nx + kStride;
+	float*	nz = ny + kStride;
+	float*	d = nz + kStride;
+	
+	for (TQ3Uns32 i = 0; i < kNumFaces; ++i)
+	{
+		const TQ3Point3D&	p0( inTMData.points[ inTMData.triangles[i].pointIndices[0] ] );
+		TQ3Vector3D	theNormal;
+		
+		if (inFaceNormals != nullptr)
+		{
+			theNormal = inFaceNormals[i];
+		}
+		else
+		{
+			Q3FastPoint3D_CrossProductTri( &p0,
+				&inTMData.points[ inTMData.triangles[i].pointIndices[1] ],
+				&inTMData.points[ inTMData.triangles[i].pointIndices[2] ],
+				&theNormal );
+		}
+		
+		nx[i] = theNormal.x;
+		ny[i] = theNormal.y;
+		nz[i] = theNormal.z;
+		d[i] = - (theNormal.x * p0.x + theNormal.y * p0.y + theNormal.z * p0.z);
+	}
+	
+	for (TQ3Uns32 i = kNumFaces; i < kStride; ++i)
+	{
+		nx[i] = ny[i] = nz[i] = d[i] = 0.0f;
+	}
+}
+
+
+/*!
+	@function	FindLitFacesInBlocks
+	@abstract	Test blocks of 4 faces against the light.
+*/
+static void FindLitFacesInBlocks( const float* inPlanes,
+								TQ3Uns32 inStride,
+								TQ3Uns32 inStartBlock,
+								TQ3Uns32 inEndBlock,
+								const TQ3RationalPoint4D& inLightPos,
+								TQ3Uns8* outFlags )
+{
+	const float*	nx = inPlanes;
+	const float*	ny = nx + inStride;
+	const float*	nz = ny + inStride;
+	const float*	d = nz + inStride;
+	
+#if QUESA_SHADOW_SSE2
+	const __m128	lx = _mm_set1_ps( inLightPos.x );
+	const __m128	ly = _mm_set1_ps( inLightPos.y );
+	const __m128	lz = _mm_set1_ps( inLightPos.z );
+	const __m128	lw = _mm_set1_ps( inLightPos.w );
+	const __m128	zero = _mm_setzero_ps();
+	
+	for (TQ3Uns32 i = 4 * inStartBlock; i < 4 * inEndBlock; i += 4)
+	{
+		__m128	dot = _mm_add_ps(
+			_mm_add_ps( _mm_mul_ps( _mm_loadu_ps( nx + i ), lx ),
+				_mm_mul_ps( _mm_loadu_ps( ny + i ), ly ) ),
+			_mm_add_ps( _mm_mul_ps( _mm_loadu_ps( nz + i ), lz ),
+				_mm_mul_ps( _mm_loadu_ps( d + i ), lw ) ) );
+		int	mask = _mm_movemask_ps( _mm_cmpgt_ps( dot, zero ) );
+		
+		outFlags[ i ] = static_cast<TQ3Uns8>( mask & 1 );
+		outFlags[ i + 1 ] = static_cast<TQ3Uns8>( (mask >> 1) & 1 );
+		outFlags[ i + 2 ] = static_cast<TQ3Uns8>( (mask >> 2) & 1 );
+		outFlags[ i + 3 ] = static_cast<TQ3Uns8>( (mask >> 3) & 1 );
+	}
+#elif QUESA_SHADOW_NEON
+	const float32x4_t	lx = vdupq_n_f32( inLightPos.x );
+	const float32x4_t	ly = vdupq_n_f32( inLightPos.y );
+	const float32x4_t	lz = vdupq_n_f32( inLightPos.z );
+	const float32x4_t	lw = vdupq_n_f32( inLightPos.w );
+	const float32x4_t	zero = vdupq_n_f32( 0.0f );
+	
+	for (TQ3Uns32 i = 4 * inStartBlock; i < 4 * inEndBlock; i += 4)
+	{
+		float32x4_t	dot = vaddq_f32(
+			vaddq_f32( vmulq_f32( vld1q_f32( nx + i ), lx ),
+				vmulq_f32( vld1q_f32( ny + i ), ly ) ),
+			vaddq_f32( vmulq_f32( vld1q_f32( nz + i ), lz ),
+				vmulq_f32( vld1q_f32( d + i ), lw ) ) );
+		uint32x4_t	isLit = vcgtq_f32( dot, zero );
+		
+		outFlags[ i ] = static_cast<TQ3Uns8>( vgetq_lane_u32( isLit, 0 ) & 1 );
+		outFlags[ i + 1 ] = static_cast<TQ3Uns8>( vgetq_lane_u32( isLit, 1 ) & 1 );
+		outFlags[ i + 2 ] = static_cast<TQ3Uns8>( vgetq_lane_u32( isLit, 2 ) & 1 );
+		outFlags[ i + 3 ] = static_cast<TQ3Uns8>( vgetq_lane_u32( isLit, 3 ) & 1 );
+	}
+#else
+	for (TQ3Uns32 i = 4 * inStartBlock; i < 4 * inEndBlock; ++i)
+	{
+		float	dot = (nx[i] * inLightPos.x + ny[i] * inLightPos.y) +
+			(nz[i] * inLightPos.z + d[i] * inLightPos.w);
+		outFlags[ i ] = dot > 0.0f;
+	}
+#endif
+}
+
+
+/*!
+	@function	FindLitFaces
+	@abstract	Determine which of the triangles face toward the light.
+	@discussion	Large meshes are split across the worker threads.  The flag
+				array must have room for PaddedFaceCount( inNumFaces ) flags.
+*/
+static void FindLitFaces( const float* inPlanes,
+						TQ3Uns32 inNumFaces,
+						const TQ3RationalPoint4D& inLightPos,
+						TQ3Uns8* outFlags )
+{
+	const TQ3Uns32	kStride = PaddedFaceCount( inNumFaces );
+	
+	E3Parallel_For( kStride / 4, kMinFacesPerTask / 4,
+		[=,&inLightPos]( TQ3Uns32 inStart, TQ3Uns32 inEnd )
+		{
+			FindLitFacesInBlocks( inPlanes, kStride, inStart, inEnd,
+				inLightPos, outFlags );
+		} );
+}
+
+
+/*!
+	@function	IsFaceShadowing
+	@abstract	Whether a face with the given light status casts a shadow.
+*/
+static inline bool IsFaceShadowing( TQ3BackfacingStyle inBackfacing,
+									bool inIsLit )
+{
+	return ! ( ( (inBackfacing == kQ3BackfacingStyleRemove) && ! inIsLit ) ||
+		( (inBackfacing == kQ3BackfacingStyleRemoveFront) && inIsLit ) );
+}
+
+
+/*!
+	@function	AddFaceToCounters
+	@abstract	Add or subtract the contribution of a face to the counters of
+				its edges, listing any edge not yet listed.
+	@discussion	A face that does not face the light is flipped toward it,
+				unless back faces are removed.  Flipping reverses the direction
+				in which the face traverses each edge.
+*/
+static void AddFaceToCounters( const TQ3TriMeshTriangleData& inFace,
+							const TQ3TriangleEdges& inFaceEdges,
+							const TQ3EdgeEnds* inEdges,
+							bool inIsFlipped,
+							TQ3Int32 inSign,
+							QORenderer::SilhouetteState& ioState )
+{
+	for (TQ3Uns32 k = 0; k < 3; ++k)
+	{
+		TQ3Uns32	whichEdge = inFaceEdges.edgeIndices[k];
+		TQ3Uns32	sideStart = inIsFlipped?
+			inFace.pointIndices[ (k + 1) % 3 ] : inFace.pointIndices[k];
+		
+		if (inEdges[ whichEdge ].pointIndices[0] == sideStart)
+		{
+			// edge is directed the same as triangle winding
+			ioState.mEdgeCounters[ whichEdge ] += inSign;
+		}
+		else
+		{
+			ioState.mEdgeCounters[ whichEdge ] -= inSign;
+		}
+		
+		if (ioState.mIsSilhouetteEdge[ whichEdge ] == 0)
+		{
+			ioState.mIsSilhouetteEdge[ whichEdge ] = 1;
+			ioState.mSilhouetteEdges.push_back( whichEdge );
+		}
+	}
+}
+
+
+#pragma mark -
+
+QORenderer::SilhouetteCache::SilhouetteCache()
+	: mFlushSize( kMinFlushSize )
+{
+}
+
+
+/*!
+	@function	FlushStaleStates
+	@abstract	Forget the states of TriMeshes or lights that no longer exist.
+*/
+void	QORenderer::SilhouetteCache::FlushStaleStates()
+{
+	StateMap::iterator i = mStates.begin();
+	
+	while (i != mStates.end())
+	{
+		if ( i->second.mGeom.isvalid() && i->second.mLight.isvalid() )
+		{
+			++i;
+		}
+		else
+		{
+			i = mStates.erase( i );
+		}
+	}
+}
+
+
+/*!
+	@function	FindState
+	@abstract	Find or create the state for a TriMesh and light.
+	@discussion	Stale states are only looked for when the number of states
+				has doubled since the last time, so that the cost is spread
+				out.  A state left behind by a deleted object whose address
+				has been reused is recognized by its weak references and
+				started afresh.
+*/
+QORenderer::SilhouetteState&	QORenderer::SilhouetteCache::FindState(
+									TQ3GeometryObject inTMObject,
+									TQ3LightObject inLight )
+{
+	GeomAndLight	key( inTMObject, inLight );
+	StateMap::iterator	found = mStates.find( key );
+	
+	if (found == mStates.end())
+	{
+		if (mStates.size() >= mFlushSize)
+		{
+			FlushStaleStates();
+			mFlushSize = std::max( kMinFlushSize,
+				static_cast<TQ3Uns32>( 2 * mStates.size() ) );
+		}
+		
+		found = mStates.insert( StateMap::value_type( key, SilhouetteState() ) ).first;
+	}
+	
+	SilhouetteState&	theState( found->second );
+	
+	if ( (theState.mGeom.get() != inTMObject) || (theState.mLight.get() != inLight) )
+	{
+		theState.mGeom.Assign( inTMObject );
+		theState.mLight.Assign( inLight );
+		theState.mIsValid = false;
+	}
+	
+	return theState;
+}
+
+
+/*!
+	@function	GetFacePlanes
+	@abstract	Retrieve or compute the face planes of a TriMesh.
+	@discussion	For a TriMesh object, the planes are cached in a property of
+				the object, since the face normals may be attributes of the
+				TriMesh rather than of its naked geometry.
+*/
+const float*	QORenderer::SilhouetteCache::GetFacePlanes(
+									TQ3GeometryObject inTMObject,
+									const TQ3TriMeshData& inTMData,
+									const TQ3Vector3D* inFaceNormals )
+{
+	const TQ3Uns32	kNumFaces = inTMData.numTriangles;
+	const TQ3Uns32	kNumFloats = 4 * PaddedFaceCount( kNumFaces );
+	
+	if (inTMObject == nullptr)
+	{
+		mImmediatePlanes.resizeNotPreserving( kNumFloats );
+		ComputeFacePlanes( inTMData, inFaceNormals, &mImmediatePlanes[0] );
+		return &mImmediatePlanes[0];
+	}
+	
+	TQ3Uns32	geomEdits = Q3Shared_GetEditIndex( inTMObject );
+	const char*	propData = reinterpret_cast<const char*>(
+		inTMObject->GetPropertyAddress( kPropertyTypeFacePlaneCache ) );
+	
+	if (propData != nullptr)
+	{
+		const FacePlaneCacheRec*	cacheData =
+			reinterpret_cast<const FacePlaneCacheRec*>( propData );
+		if ( (cacheData->editIndex == geomEdits) &&
+			(cacheData->faceCount == kNumFaces) )
+		{
+			return reinterpret_cast<const float*>( propData + sizeof(FacePlaneCacheRec) );
+		}
+	}
+	
+	// Lock the edit index, so that adding a property won't change it.
+	StLockEditIndex lockIndex( inTMObject );
+	
+	TQ3Uns32	propSize = static_cast<TQ3Uns32>( sizeof(FacePlaneCacheRec) +
+		kNumFloats * sizeof(float) );
+	if (mScratchBuffer.size() < propSize)
+	{
+		mScratchBuffer.resizeNotPreserving( propSize );
+	}
+	FacePlaneCacheRec*	cacheData = reinterpret_cast<FacePlaneCacheRec*>( &mScratchBuffer[0] );
+	cacheData->faceCount = kNumFaces;
+	cacheData->editIndex = geomEdits;
+	ComputeFacePlanes( inTMData, inFaceNormals,
+		reinterpret_cast<float*>( &mScratchBuffer[0] + sizeof(FacePlaneCacheRec) ) );
+	Q3Object_SetProperty( inTMObject, kPropertyTypeFacePlaneCache, propSize,
+		cacheData );
+	
+	propData = reinterpret_cast<const char*>(
+		inTMObject->GetPropertyAddress( kPropertyTypeFacePlaneCache ) );
+	if (propData == nullptr)	// could not set the property, use our copy
+	{
+		propData = &mScratchBuffer[0];
+	}
+	return reinterpret_cast<const float*>( propData + sizeof(FacePlaneCacheRec) );
+}
+
+
+/*!
+	@function	Update
+	@abstract	Bring the silhouette state of a TriMesh up to date for a
+				light position.
+	@discussion	Every face is tested against the light, but only the faces
+				whose status has changed since the last update for the same
+				TriMesh and light touch the edge counters.  The state is
+				rebuilt from scratch if the TriMesh has been edited or the
+				backfacing style has changed.  A TriMesh without an object
+				(immediate mode) always gets a fresh state.
+	@param		inTMObject		A TriMesh object, or nullptr.
+	@param		inLight			The light.
+	@param		inTMData		Data of the TriMesh.
+	@param		inFaceNormals	Face normals of the TriMesh, or nullptr.
+	@param		inEdges			Edges of the TriMesh.
+	@param		inFacesToEdges	Edges of each face of the TriMesh.
+	@param		inLocalLightPos	Light position in local coordinates, with w
+								equal to 0 or 1.
+	@param		inBackfacing	Current backfacing style.
+	@result		The updated state.
+*/
+const QORenderer::SilhouetteState&	QORenderer::SilhouetteCache::Update(
+									TQ3GeometryObject inTMObject,
+									TQ3LightObject inLight,
+									const TQ3TriMeshData& inTMData,
+									const TQ3Vector3D* inFaceNormals,
+									const TQ3EdgeVec& inEdges,
+									const TQ3TriangleToEdgeVec& inFacesToEdges,
+									const TQ3RationalPoint4D& inLocalLightPos,
+									TQ3BackfacingStyle inBackfacing )
+{
+	SilhouetteState&	theState( (inTMObject == nullptr)? mImmediateState :
+		FindState( inTMObject, inLight ) );
+	const TQ3Uns32	kNumFaces = inTMData.numTriangles;
+	const TQ3Uns32	kNumEdges = inEdges.size();
+	const TQ3Uns32	kNumFlags = PaddedFaceCount( kNumFaces );
+	TQ3Uns32	geomEdits = (inTMObject == nullptr)? 0 :
+		Q3Shared_GetEditIndex( inTMObject );
+	TQ3Uns32	i;
+	
+	if ( (inTMObject == nullptr) ||
+		(theState.mGeomEditIndex != geomEdits) ||
+		(theState.mBackfacing != inBackfacing) ||
+		(theState.mEdgeCounters.size() != kNumEdges) ||
+		(theState.mLitFaceFlags.size() != kNumFlags) )
+	{
+		theState.mIsValid = false;
+	}
+	
+	
+	// Test the faces against the light.
+	const float*	thePlanes = GetFacePlanes( inTMObject, inTMData, inFaceNormals );
+	mNewLitFaceFlags.resizeNotPreserving( kNumFlags );
+	if (kNumFaces > 0)
+	{
+		FindLitFaces( thePlanes, kNumFaces, inLocalLightPos, &mNewLitFaceFlags[0] );
+	}
+	
+	
+	// Start afresh if need be, as if no face had cast a shadow before.
+	if (! theState.mIsValid)
+	{
+		theState.mEdgeCounters.resizeNotPreserving( kNumEdges );
+		theState.mIsSilhouetteEdge.resizeNotPreserving( kNumEdges );
+		theState.mSilhouetteEdges.clear();
+		if (kNumEdges > 0)
+		{
+			std::fill( &theState.mEdgeCounters[0],
+				&theState.mEdgeCounters[0] + kNumEdges, 0 );
+			std::fill( &theState.mIsSilhouetteEdge[0],
+				&theState.mIsSilhouetteEdge[0] + kNumEdges, 0 );
+		}
+	}
+	
+	
+	// Update the edges of faces whose contribution has changed.
+	const TQ3EdgeEnds*	theEdges = inEdges.data();
+	const TQ3TriangleEdges*	facesToEdges = inFacesToEdges.data();
+	const TQ3Uns8*	newFlags = (kNumFaces == 0)? nullptr : &mNewLitFaceFlags[0];
+	const TQ3Uns8*	oldFlags = ( (kNumFaces == 0) || ! theState.mIsValid )?
+		nullptr : &theState.mLitFaceFlags[0];
+	const bool		isFlipping = (inBackfacing != kQ3BackfacingStyleRemove);
+	
+	for (i = 0; i < kNumFaces; ++i)
+	{
+		bool	isNowLit = (newFlags[i] != 0);
+		bool	isNowShadowing = IsFaceShadowing( inBackfacing, isNowLit );
+		
+		if (theState.mIsValid)
+		{
+			if (oldFlags[i] == newFlags[i])
+			{
+				continue;
+			}
+			
+			if (IsFaceShadowing( inBackfacing, ! isNowLit ))
+			{
+				AddFaceToCounters( inTMData.triangles[i], facesToEdges[i],
+					theEdges, isFlipping && isNowLit, -1, theState );
+			}
+		}
+		
+		if (isNowShadowing)
+		{
+			AddFaceToCounters( inTMData.triangles[i], facesToEdges[i],
+				theEdges, isFlipping && ! isNowLit, 1, theState );
+		}
+	}
+	
+	theState.mLitFaceFlags.swap( mNewLitFaceFlags );
+	
+	
+	// Drop listed edges that are no longer on the silhouette.
+	TQ3Uns32	numListed = 0;
+	for (i = 0; i < theState.mSilhouetteEdges.size(); ++i)
+	{
+		TQ3Uns32	whichEdge = theState.mSilhouetteEdges[i];
+		
+		if (theState.mEdgeCounters[ whichEdge ] == 0)
+		{
+			theState.mIsSilhouetteEdge[ whichEdge ] = 0;
+		}
+		else
+		{
+			theState.mSilhouetteEdges[ numListed++ ] = whichEdge;
+		}
+	}
+	theState.mSilhouetteEdges.resize( numListed );
+	
+	theState.mGeomEditIndex = geomEdits;
+	theState.mBackfacing = inBackfacing;
+	theState.mIsValid = true;
+	
+	return theState;
+}
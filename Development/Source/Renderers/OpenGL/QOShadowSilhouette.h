@@ -0,0 +1,170 @@
+/*!
+	@header		QOShadowSilhouette.h
+	
+	Incremental shadow silhouettes for use in Quesa OpenGL renderer.
+*/
+
+/*  NAME:
+        QOShadowSilhouette.h
+
+    DESCRIPTION:
+        Header for incremental shadow silhouettes.
+
+    COPYRIGHT:
+        Copyright (c) 2026, Quesa Developers. All rights reserved.
+
+        For the current release of Quesa, please see:
+
+            <https://github.com/jwwalker/Quesa>
+        
+        Redistribution and use in source and binary forms, with or without
+        modification, are permitted provided that the following conditions
+        are met:
+        
+            o Redistributions of source code must retain the above copyright
+              notice, this list of conditions and the following disclaimer.
+        
+            o Redistributions in binary form must reproduce the above
+              copyright notice, this list of conditions and the following
+              disclaimer in the documentation and/or other materials provided
+              with the distribution.
+        
+            o Neither the name of Quesa nor the names of its contributors
+              may be used to endorse or promote products derived from this
+              software without specific prior written permission.
+        
+        THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+        "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+        LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+        A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+        OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+        SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+        TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+        PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+        LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+        NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+        SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+    ___________________________________________________________________________
+*/
+
+
+#ifndef QOSHADOWSILHOUETTE_HDR
+#define QOSHADOWSILHOUETTE_HDR
+
+//=============================================================================
+//      Include files
+//-----------------------------------------------------------------------------
+#include "QOPrefix.h"
+#include "QOCalcTriMeshEdges.h"
+#include "CQ3WeakObjectRef.h"
+
+#include <map>
+#include <utility>
+
+
+//=============================================================================
+//      Class Declaration
+//-----------------------------------------------------------------------------
+
+namespace QORenderer
+{
+
+/*!
+	@struct		SilhouetteState
+	@abstract	Which faces of a TriMesh face a light, and the resulting
+				silhouette edges.
+	@discussion	Each face that casts a shadow, oriented toward the light,
+				contributes +1 to the counter of an edge that it traverses
+				from the first end of the edge to the second, and -1 to the
+				counter of an edge that it traverses the other way.  An edge
+				with a nonzero counter needs that many shadow sides.
+*/
+struct SilhouetteState
+{
+	CQ3WeakObjectRef		mGeom;
+	CQ3WeakObjectRef		mLight;
+	TQ3Uns32				mGeomEditIndex;
+	TQ3BackfacingStyle		mBackfacing;
+	bool					mIsValid;
+	
+	/*!
+		@var		mLitFaceFlags
+		@abstract	Whether each face faces the light.
+	*/
+	E3FastArray<TQ3Uns8>	mLitFaceFlags;
+
+	/*!
+		@var		mEdgeCounters
+		@abstract	Signed count of shadow sides for each edge.
+	*/
+	E3FastArray<TQ3Int32>	mEdgeCounters;
+
+	/*!
+		@var		mSilhouetteEdges
+		@abstract	Indices of the edges with nonzero counters.
+	*/
+	E3FastArray<TQ3Uns32>	mSilhouetteEdges;
+
+	/*!
+		@var		mIsSilhouetteEdge
+		@abstract	Whether each edge is listed in mSilhouetteEdges.
+	*/
+	E3FastArray<TQ3Uns8>	mIsSilhouetteEdge;
+	
+							SilhouetteState()
+								: mGeomEditIndex( 0 )
+								, mBackfacing( kQ3BackfacingStyleBoth )
+								, mIsValid( false ) {}
+};
+
+
+/*!
+	@class		SilhouetteCache
+	@abstract	Silhouette states of TriMeshes for lights, kept from frame to
+				frame.
+	@discussion	When a light or TriMesh moves a little, only a few faces
+				change between facing toward the light and away from it.  By
+				keeping the state for each pair of TriMesh and light, only the
+				edges of those faces need to be updated.  The face planes used
+				to test which faces face the light are cached on the TriMesh.
+*/
+class SilhouetteCache
+{
+public:
+							SilhouetteCache();
+	
+	const SilhouetteState&	Update(
+									TQ3GeometryObject inTMObject,
+									TQ3LightObject inLight,
+									const TQ3TriMeshData& inTMData,
+									const TQ3Vector3D* inFaceNormals,
+									const TQ3EdgeVec& inEdges,
+									const TQ3TriangleToEdgeVec& inFacesToEdges,
+									const TQ3RationalPoint4D& inLocalLightPos,
+									TQ3BackfacingStyle inBackfacing );
+
+private:
+	typedef std::pair< TQ3GeometryObject, TQ3LightObject >	GeomAndLight;
+	typedef std::map< GeomAndLight, SilhouetteState >		StateMap;
+	
+	SilhouetteState&		FindState(
+									TQ3GeometryObject inTMObject,
+									TQ3LightObject inLight );
+	void					FlushStaleStates();
+	const float*			GetFacePlanes(
+									TQ3GeometryObject inTMObject,
+									const TQ3TriMeshData& inTMData,
+									const TQ3Vector3D* inFaceNormals );
+
+	StateMap				mStates;
+	TQ3Uns32				mFlushSize;
+	SilhouetteState			mImmediateState;
+	E3FastArray<char>		mScratchBuffer;
+	E3FastArray<float>		mImmediatePlanes;
+	E3FastArray<TQ3Uns8>	mNewLitFaceFlags;
+};
+
+}
+
+
+#endif
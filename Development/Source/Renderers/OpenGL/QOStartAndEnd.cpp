@@ -153,6 +153,40 @@ TQ3Status	QORenderer::Renderer::StartFrame(
 		mAllowLineSmooth = false;
 	}
 	
+	// Check whether TriMeshes should be optimized for the vertex cache
+	// rather than made into triangle strips
+	TQ3Boolean	isCacheOptimizing = kQ3False;
+	Q3Object_GetProperty( mRendererObject,
+		kQ3RendererPropertyVertexCacheOptimization, sizeof(isCacheOptimizing),
+		nullptr, &isCacheOptimizing );
+	mIsVertexCacheOptimizing = (isCacheOptimizing == kQ3True);
+	
+	// Check whether small TriMeshes should be merged into shared draw calls
+	TQ3Boolean	isBatching = kQ3False;
+	Q3Object_GetProperty( mRendererObject,
+		kQ3RendererPropertyBatchSmallTriMeshes, sizeof(isBatching),
+		nullptr, &isBatching );
+	mIsBatchingSmallMeshes = (isBatching == kQ3True);
+	
+	// Check whether opaque TriMeshes should be drawn sorted by state
+	TQ3Boolean	isSorting = kQ3False;
+	Q3Object_GetProperty( mRendererObject,
+		kQ3RendererPropertySortOpaqueTriMeshes, sizeof(isSorting),
+		nullptr, &isSorting );
+	mIsSortingOpaqueTriMeshes = (isSorting == kQ3True);
+	
+	// Check whether transparent TriMeshes may be drawn unsorted
+	TQ3Boolean	isWeighted = kQ3False;
+	Q3Object_GetProperty( mRendererObject,
+		kQ3RendererPropertyOrderIndependentTransparency, sizeof(isWeighted),
+		nullptr, &isWeighted );
+	mIsUsingWeightedTransparency = (isWeighted == kQ3True);
+	
+	mNumDrawCallsInFrame = 0;
+	mNumProgramSwitchesInFrame = 0;
+	mNumTextureBindsInFrame = 0;
+	mTransparencySortMicrosecondsInFrame = 0;
+	
 	if (isShadowingRequested)
 	{
 		if (AdjustStencilAndDepthForShadows( mRendererObject, inDrawContext ))
@@ -227,6 +261,7 @@ TQ3Status	QORenderer::Renderer::StartFrame(
 			// Dispose of the old GL context
 			if (mGLContext != nullptr)
 			{
+				mWeightedTrans.Cleanup();
 				mPPLighting.Cleanup();
 				GLDrawContext_Destroy( &mGLContext );
 			}
@@ -269,6 +304,7 @@ TQ3Status	QORenderer::Renderer::StartFrame(
 	CHECK_GL_ERROR;
 	GLDrawContext_StartFrame( mGLContext, mPPLighting );
 	CHECK_GL_ERROR;
+	mWeightedTrans.StartFrame( mIsUsingWeightedTransparency );
 
 	
 	// If shadows are desired, check whether we got a stencil buffer,
@@ -401,6 +437,7 @@ void		QORenderer::Renderer::StartPass(
 	mPPLighting.StartPass( inCamera );
 	mLights.StartPass( inCamera, mRendererObject );
 	mTextures.StartPass();
+	mSurfaceShader = CQ3ObjectRef();
 }
 
 static bool IsSwapWanted( TQ3ViewObject inView )
@@ -437,6 +474,7 @@ void	QORenderer::Renderer::RenderTransparent( TQ3ViewObject inView )
 		mLights.StartPass( theCamera.get(), mRendererObject );
 		mTextures.StartPass();
 		
+		mWeightedTrans.Draw( inView, passNum == 1 );
 		mTransBuffer.DrawTransparency( inView, GL_ONE, dstFactor );
 		dstFactor = GL_ONE;	// for next mini-pass
 		
@@ -451,6 +489,9 @@ void	QORenderer::Renderer::RenderTransparent( TQ3ViewObject inView )
 	mTransBuffer.DrawDepth( inView );
 	
 	mTransBuffer.Cleanup();
+	
+	// Blend the order-independent transparency over everything else.
+	mWeightedTrans.Composite();
 }
 
 TQ3ViewStatus		QORenderer::Renderer::EndPass(
@@ -461,11 +502,14 @@ TQ3ViewStatus		QORenderer::Renderer::EndPass(
 	
 	// Flush any remaining triangles
 	mTriBuffer.Flush();
+	mMeshBatch.Flush();
+	mRenderQueue.Flush();
 	
 	// Transparency is drawn at the end of the last lighting pass.
 	// If there was only one lighting pass, we can do it now.
 	bool isFirstLightingPass = mLights.IsFirstPass();
-	if (isFirstLightingPass && mLights.IsLastLightingPass() && mTransBuffer.HasContent())
+	if (isFirstLightingPass && mLights.IsLastLightingPass() &&
+		(mTransBuffer.HasContent() || mWeightedTrans.HasContent()))
 	{
 		mPPLighting.EndPass();
 
@@ -485,12 +529,14 @@ TQ3ViewStatus		QORenderer::Renderer::EndPass(
 		
 		glDepthFunc( compareFunc );
 		//Q3_MESSAGE_FMT("Transparency in one pass");
+		mWeightedTrans.Draw( inView, true );
 		mTransBuffer.DrawTransparency( inView, GL_ONE, GL_ONE_MINUS_SRC_ALPHA );
 
 		glDepthFunc( GL_LESS );
 		mTransBuffer.DrawDepth( inView );
 		
 		mTransBuffer.Cleanup();
+		mWeightedTrans.Composite();
 	}
 	
 	// don't increment the pass count if we have to make another pass because of lighting
@@ -509,7 +555,8 @@ TQ3ViewStatus		QORenderer::Renderer::EndPass(
 	
 	// If this is the end of several lighting passes, handling transparency is
 	// trickier.
-	if (mLights.IsLastLightingPass() && (! isFirstLightingPass) && mTransBuffer.HasContent())
+	if (mLights.IsLastLightingPass() && (! isFirstLightingPass) &&
+		(mTransBuffer.HasContent() || mWeightedTrans.HasContent()))
 	{
 		RenderTransparent( inView );
 	}
@@ -532,6 +579,14 @@ TQ3ViewStatus		QORenderer::Renderer::EndPass(
 	// Copy the primitive render count to a property where the user can get it
 	Q3Object_SetProperty( mRendererObject, kQ3RendererPropertyPrimitivesRenderedCount,
 		sizeof(TQ3Uns64), &mNumPrimitivesRenderedInFrame );
+	Q3Object_SetProperty( mRendererObject, kQ3RendererPropertyDrawCallCount,
+		sizeof(TQ3Uns64), &mNumDrawCallsInFrame );
+	Q3Object_SetProperty( mRendererObject, kQ3RendererPropertyProgramSwitchCount,
+		sizeof(TQ3Uns64), &mNumProgramSwitchesInFrame );
+	Q3Object_SetProperty( mRendererObject, kQ3RendererPropertyTextureBindCount,
+		sizeof(TQ3Uns64), &mNumTextureBindsInFrame );
+	Q3Object_SetProperty( mRendererObject, kQ3RendererPropertyTransparencySortTime,
+		sizeof(TQ3Uns64), &mTransparencySortMicrosecondsInFrame );
 	
 	return allDone;
 }
@@ -181,6 +181,7 @@ Texture::Texture(
 	: mRenderer( inRenderer )
 	, mTextureCache( nullptr )
 	, mPendingTextureRemoval( true )
+	, mPendingTextureBind( false )
 {
 	mState.Reset();
 }
@@ -327,6 +328,8 @@ void	Texture::StartPass()
 {
 	mState.Reset();
 	mPendingTextureRemoval = true;
+	mPendingTextureBind = false;
+	mPendingShader = CQ3ObjectRef();
 }
 
 
@@ -389,9 +392,35 @@ void	Texture::HandlePendingTextureRemoval()
 	}
 }
 
+/*!
+	@function			HandlePendingTextureBind
+	@abstract			If a texture has been activated since the last
+						rendering, bind it, just in time for rendering.
+*/
+void	Texture::HandlePendingTextureBind()
+{
+	if (mPendingTextureBind)
+	{
+		GLDrawContext_SetCurrent( mRenderer.GLContext(), kQ3False );
+		
+		glBindTexture( GL_TEXTURE_2D, mState.mGLTextureObject );
+		mRenderer.CountTextureBind();
+		
+		SetSpecularMap( mPendingShader.get() );
+		SetOpenGLTexturingParameters();
+		
+		mPendingTextureBind = false;
+		mPendingShader = CQ3ObjectRef();
+	}
+}
+
 /*!
 	@function			SetCurrentTexture
 	@abstract			Activate a texture.
+	@discussion			The texture is bound just in time for rendering, by
+						HandlePendingTextureBind, so that a texture which is
+						replaced before anything is drawn with it, such as one
+						whose TriMeshes were queued for sorting, costs no bind.
 */
 void	Texture::SetCurrentTexture(
 								TQ3TextureObject inTexture,
@@ -404,6 +433,8 @@ void	Texture::SetCurrentTexture(
 	{
 		mState.mIsTextureActive = false;
 		mPendingTextureRemoval = true;
+		mPendingTextureBind = false;
+		mPendingShader = CQ3ObjectRef();
 		Q3Matrix3x3_SetIdentity( &mState.mUVTransform );
 		mState.mIsTextureAlphaTest = false;
 	}
@@ -437,10 +468,11 @@ void	Texture::SetCurrentTexture(
 				(pixelType == kQ3PixelTypeARGB16));
 			mState.mIsTextureMipmapped = IsTextureMipmapped( inTexture );
 			
-			glBindTexture( GL_TEXTURE_2D, mState.mGLTextureObject );
-			
 			mPendingTextureRemoval = false;
-			SetSpecularMap( inShader );
+			mPendingTextureBind = true;
+			mPendingShader = CQ3ObjectRef( (inShader == nullptr)? nullptr :
+				Q3Shared_GetReference( inShader ) );
+			return;
 		}
 		else
 		{
@@ -479,6 +511,7 @@ void	Texture::SetSpecularMap( TQ3ShaderObject inShader )
 				GLuint textureName = GLTextureMgr_GetOpenGLTexture( cachedTexture );
 				(*mRenderer.Funcs().glActiveTexture)( GL_TEXTURE1_ARB );
 				glBindTexture( GL_TEXTURE_2D, textureName );
+				mRenderer.CountTextureBind();
 				SetOpenGLTexturingParameters();
 				(*mRenderer.Funcs().glActiveTexture)( GL_TEXTURE0_ARB );
 				mRenderer.Shader().UpdateSpecularMapping( true );
@@ -49,6 +49,7 @@
 #include "E3Prefix.h"
 #include "GLPrefix.h"
 #include "GLTextureManager.h"
+#include "CQ3ObjectRef.h"
 
 #include <vector>
 
@@ -112,6 +113,13 @@ public:
 							about it, just in time for rendering.
 	*/
 	void					HandlePendingTextureRemoval();
+
+	/*!
+		@function			HandlePendingTextureBind
+		@abstract			If a texture has been activated since the last
+							rendering, bind it, just in time for rendering.
+	*/
+	void					HandlePendingTextureBind();
 	
 	/*!
 		@function			IsTextureActive
@@ -176,6 +184,8 @@ private:
 	std::vector<TQ3Uns8>	mSrcImageData;
 	std::vector<GLubyte>	mGLFormatWork;
 	bool					mPendingTextureRemoval;
+	bool					mPendingTextureBind;
+	CQ3ObjectRef			mPendingShader;
 };
 
 }
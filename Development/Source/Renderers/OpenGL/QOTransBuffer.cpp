@@ -51,9 +51,12 @@
 #include "GLImmediateVBO.h"
 #include "QOGLShadingLanguage.h"
 #include "QuesaMathOperators.hpp"
+#include "E3Parallel.h"
 
 #include <algorithm>
+#include <chrono>
 #include <stdint.h>
+#include <string.h>
 
 using namespace QORenderer;
 
@@ -86,15 +89,29 @@ namespace
 	
 	const TQ3Uns32				kRenderGroupReserve = 10000;
 	const TQ3Uns32				kBlockUnionReserve = 1000;
+	
+	// Depth sorting.  Blocks with fewer prims than kMinPrimsToRadixSort are
+	// sorted by comparison, larger ones by an 8-bit LSD radix sort, split into
+	// chunks of at least kMinPrimsPerSortTask prims for the worker threads.
+	const TQ3Uns32				kRadixBits = 8;
+	const TQ3Uns32				kRadixSize = 1 << kRadixBits;
+	const TQ3Uns32				kMinPrimsToRadixSort = 256;
+	const TQ3Uns32				kMinPrimsPerSortTask = 32768;
+	const TQ3Uns32				kMinBlocksPerSortTask = 64;
+	const TQ3Uns32				kMinTrianglesPerBuildTask = 4096;
 
-	struct PtrCompare
+	struct KeyCompare
 	{
+		explicit		KeyCompare( const TQ3Uns32* inKeys )
+							: mKeys( inKeys ) {}
+		
 		inline
-		bool	operator()( const TransparentPrim* inOne,
-							const TransparentPrim* inTwo ) const
+		bool	operator()( TQ3Uns32 inOne, TQ3Uns32 inTwo ) const
 					{
-						return inOne->mSortingDepth < inTwo->mSortingDepth;
+						return mKeys[ inOne ] < mKeys[ inTwo ];
 					}
+		
+		const TQ3Uns32*	mKeys;
 	};
 	
 	struct NonNullBlock
@@ -162,36 +179,192 @@ static bool IsSame4x4( const TQ3Matrix4x4& inA, const TQ3Matrix4x4& inB )
 		IsNearZero( inA.value[3][3] - inB.value[3][3] );
 }
 
-static float CalcPrimDepth( const TransparentPrim& inPrim )
+static float CalcPrimDepth( const TQ3Point3D* inPoints, TQ3Uns32 inNumVerts )
 {
 	float	theDepth;
 	
-	if (inPrim.mNumVerts == 3)
+	if (inNumVerts == 3)
 	{
-		theDepth = inPrim.mVerts[0].point.z + inPrim.mVerts[1].point.z +
-			inPrim.mVerts[2].point.z;
+		theDepth = inPoints[0].z + inPoints[1].z + inPoints[2].z;
 	}
-	else if (inPrim.mNumVerts == 2)
+	else if (inNumVerts == 2)
 	{
-		theDepth = inPrim.mVerts[0].point.z + inPrim.mVerts[1].point.z;
+		theDepth = inPoints[0].z + inPoints[1].z;
 		theDepth *= 1.5f;
 	}
 	else
 	{
-		theDepth = inPrim.mVerts[0].point.z;
+		theDepth = inPoints[0].z;
 		theDepth *= 3;
 	}
 	return theDepth;
 }
 
-static TQ3ColorRGB EmissiveColor( const TransparentPrim& inPrim )
+static inline TQ3ColorRGBA PremultipliedColor( const Vertex& inVertex )
+{
+	TQ3ColorRGBA theColor =
+	{
+		inVertex.diffuseColor.r * inVertex.vertAlpha,
+		inVertex.diffuseColor.g * inVertex.vertAlpha,
+		inVertex.diffuseColor.b * inVertex.vertAlpha,
+		inVertex.vertAlpha
+	};
+	return theColor;
+}
+
+/*!
+	@function	DepthToSortKey
+	@abstract	Map a sorting depth to an unsigned integer with the same order.
+	@discussion	Flipping the sign bit of a non-negative float, or all bits of a
+				negative one, makes the bit patterns compare like the floats.
+*/
+static inline TQ3Uns32 DepthToSortKey( float inDepth )
+{
+	TQ3Uns32	bits;
+	memcpy( &bits, &inDepth, sizeof(bits) );
+	
+	return ((bits & 0x80000000U) != 0)? ~bits : (bits | 0x80000000U);
+}
+
+
+/*!
+	@function	ChunkStart
+	@abstract	First index of one of several nearly equal chunks of a range.
+*/
+static inline TQ3Uns32 ChunkStart( TQ3Uns32 inCount, TQ3Uns32 inNumChunks,
+									TQ3Uns32 inChunk )
+{
+	return static_cast<TQ3Uns32>( (static_cast<unsigned long long>( inCount ) *
+		inChunk) / inNumChunks );
+}
+
+
+/*!
+	@function	RadixSortKeys
+	@abstract	Sort keys together with their indices, in ascending order of key.
+	@discussion	This is a stable LSD radix sort.  Each pass counts the digits
+				of each chunk of the range, turns the counts into offsets, and
+				scatters each chunk, with the chunks being counted and scattered
+				by the worker threads.  A pass in which all keys have the same
+				digit is skipped, which is common since nearby depths share
+				their high bits.
+	@param		ioKeys			The keys.  Replaced by the sorted keys.
+	@param		ioIndices		The indices.  Replaced by the indices in order.
+	@param		inNumChunks		Number of chunks, at least 1.
+*/
+static void RadixSortKeys( E3FastArray<TQ3Uns32>& ioKeys,
+							E3FastArray<TQ3Uns32>& ioIndices,
+							TQ3Uns32 inNumChunks )
+{
+	const TQ3Uns32 kCount = ioKeys.size();
+	E3FastArray<TQ3Uns32>	workKeys( kCount );
+	E3FastArray<TQ3Uns32>	workIndices( kCount );
+	E3FastArray<TQ3Uns32>	offsets( inNumChunks * kRadixSize );
+	
+	for (TQ3Uns32 shift = 0; shift < 32; shift += kRadixBits)
+	{
+		const TQ3Uns32* srcKeys = &ioKeys[0];
+		const TQ3Uns32* srcIndices = &ioIndices[0];
+		TQ3Uns32* dstKeys = &workKeys[0];
+		TQ3Uns32* dstIndices = &workIndices[0];
+		TQ3Uns32* chunkOffsets = &offsets[0];
+		
+		// Count the digits in each chunk.
+		E3Parallel_For( inNumChunks, 1,
+			[=]( TQ3Uns32 inStart, TQ3Uns32 inEnd )
+			{
+				for (TQ3Uns32 c = inStart; c < inEnd; ++c)
+				{
+					TQ3Uns32* counts = chunkOffsets + c * kRadixSize;
+					memset( counts, 0, kRadixSize * sizeof(TQ3Uns32) );
+					const TQ3Uns32 kEnd = ChunkStart( kCount, inNumChunks, c + 1 );
+					for (TQ3Uns32 i = ChunkStart( kCount, inNumChunks, c ); i < kEnd; ++i)
+					{
+						counts[ (srcKeys[i] >> shift) & (kRadixSize - 1) ] += 1;
+					}
+				}
+			} );
+		
+		// If every key has the same digit, the pass would not move anything.
+		TQ3Uns32 digit, c;
+		TQ3Uns32 digitTotal = 0;
+		for (digit = 0; (digit < kRadixSize) && (digitTotal == 0); ++digit)
+		{
+			for (c = 0; c < inNumChunks; ++c)
+			{
+				digitTotal += chunkOffsets[ c * kRadixSize + digit ];
+			}
+		}
+		if (digitTotal == kCount)
+		{
+			continue;
+		}
+		
+		// Turn the counts into offsets, ordered by digit and then by chunk so
+		// that the sort is stable.
+		TQ3Uns32 offset = 0;
+		for (digit = 0; digit < kRadixSize; ++digit)
+		{
+			for (c = 0; c < inNumChunks; ++c)
+			{
+				TQ3Uns32 count = chunkOffsets[ c * kRadixSize + digit ];
+				chunkOffsets[ c * kRadixSize + digit ] = offset;
+				offset += count;
+			}
+		}
+		
+		// Scatter each chunk.
+		E3Parallel_For( inNumChunks, 1,
+			[=]( TQ3Uns32 inStart, TQ3Uns32 inEnd )
+			{
+				for (TQ3Uns32 c = inStart; c < inEnd; ++c)
+				{
+					TQ3Uns32* nextSlot = chunkOffsets + c * kRadixSize;
+					const TQ3Uns32 kEnd = ChunkStart( kCount, inNumChunks, c + 1 );
+					for (TQ3Uns32 i = ChunkStart( kCount, inNumChunks, c ); i < kEnd; ++i)
+					{
+						TQ3Uns32 slot = nextSlot[ (srcKeys[i] >> shift) & (kRadixSize - 1) ]++;
+						dstKeys[ slot ] = srcKeys[i];
+						dstIndices[ slot ] = srcIndices[i];
+					}
+				}
+			} );
+		
+		ioKeys.swap( workKeys );
+		ioIndices.swap( workIndices );
+	}
+}
+
+/*!
+	@function	AppendArray
+	@abstract	Append the contents of one array to another.
+*/
+template <typename T>
+static void AppendArray( E3FastArray<T>& ioArray, const E3FastArray<T>& inOther )
+{
+	TQ3Uns32 oldSize = ioArray.size();
+	TQ3Uns32 newSize = oldSize + inOther.size();
+	if (ioArray.capacity() < newSize)
+	{
+		// If we must grow it, make it worth our while.
+		ioArray.reserve( E3Num_Max( 2 * newSize, kBlockUnionReserve ) );
+	}
+	ioArray.resize( newSize );
+	if (inOther.size() > 0)
+	{
+		E3Memory_Copy( &inOther[0], &ioArray[oldSize],
+			inOther.size() * sizeof(T) );
+	}
+}
+
+static TQ3ColorRGB EmissiveColor( const Vertex& inVertex )
 {
 	TQ3ColorRGB theColor;
 	
 	// We are not doing per-vertex emissive color.  See comments in UpdateEmission.
-	if ((inPrim.mVerts[0].flags & kVertexHaveEmissive) != 0)
+	if ((inVertex.flags & kVertexHaveEmissive) != 0)
 	{
-		theColor = inPrim.mVerts[0].emissiveColor;
+		theColor = inVertex.emissiveColor;
 	}
 	else
 	{
@@ -233,7 +406,7 @@ static bool IsSameState( const TransparentPrim& inA, const TransparentPrim& inB
 		(inA.mCameraToFrustumIndex == inB.mCameraToFrustumIndex) &&
 		(fabsf( inA.mSpecularControl - inB.mSpecularControl ) < kQ3RealZero) &&
 		IsSameColor( inA.mSpecularColor, inB.mSpecularColor ) &&
-		IsSameColor( EmissiveColor( inA ), EmissiveColor( inB ) );
+		IsSameColor( inA.mEmissiveColor, inB.mEmissiveColor );
 	
 	// UV transform and U, V boundary only matter if there is a texture.
 	if ( isSame && (inA.mTextureName != 0) )
@@ -247,18 +420,18 @@ static bool IsSameState( const TransparentPrim& inA, const TransparentPrim& inB
 	// have the same flags.
 	if (isSame)
 	{
-		isSame = (inA.mVerts[0].flags == inB.mVerts[0].flags);
+		isSame = (inA.mVertFlags[0] == inB.mVertFlags[0]);
 		
 		if (isSame)
 		{
 			for (unsigned int i = 1; i < inA.mNumVerts; ++i)
 			{
-				if (inA.mVerts[i].flags != inA.mVerts[0].flags)
+				if (inA.mVertFlags[i] != inA.mVertFlags[0])
 				{
 					isSame = false;
 					break;
 				}
-				if (inB.mVerts[i].flags != inA.mVerts[0].flags)
+				if (inB.mVertFlags[i] != inA.mVertFlags[0])
 				{
 					isSame = false;
 					break;
@@ -294,18 +467,18 @@ static bool IsSameStateForDepth( const TransparentPrim& inA, const TransparentPr
 	// have the same flags.
 	if (isSame)
 	{
-		isSame = (inA.mVerts[0].flags == inB.mVerts[0].flags);
+		isSame = (inA.mVertFlags[0] == inB.mVertFlags[0]);
 		
 		if (isSame)
 		{
 			for (unsigned int i = 1; i < inA.mNumVerts; ++i)
 			{
-				if (inA.mVerts[i].flags != inA.mVerts[0].flags)
+				if (inA.mVertFlags[i] != inA.mVertFlags[0])
 				{
 					isSame = false;
 					break;
 				}
-				if (inB.mVerts[i].flags != inA.mVerts[0].flags)
+				if (inB.mVertFlags[i] != inA.mVertFlags[0])
 				{
 					isSame = false;
 					break;
@@ -340,16 +513,12 @@ void	TransparentBlock::Union( const TransparentBlock& inOther )
 {
 	E3BoundingBox_Union( &mFrustumBounds, &inOther.mFrustumBounds, &mFrustumBounds );
 	
-	TQ3Uns32 oldSize = mPrims.size();
-	TQ3Uns32 newSize = oldSize + inOther.mPrims.size();
-	if (mPrims.capacity() < newSize)
-	{
-		// If we must grow it, make it worth our while.
-		mPrims.reserve( E3Num_Max( 2 * newSize, kBlockUnionReserve ) );
-	}
-	mPrims.resize( newSize );
-	E3Memory_Copy( &inOther.mPrims[0], &mPrims[oldSize],
-		inOther.mPrims.size() * sizeof(TransparentPrim) );
+	AppendArray( mPrims, inOther.mPrims );
+	AppendArray( mSortKeys, inOther.mSortKeys );
+	AppendArray( mPoints, inOther.mPoints );
+	AppendArray( mNormals, inOther.mNormals );
+	AppendArray( mUVs, inOther.mUVs );
+	AppendArray( mColors, inOther.mColors );
 	
 	mHasUniformVertexFlags = false;
 }
@@ -377,22 +546,78 @@ bool	TransparentBlock::Occludes( const TransparentBlock& inOther ) const
 }
 
 /*!
-	@function	SortPrimPtrs
-	@abstract	Sort pointers to the primitives, in back to front order.
+	@function	AddPrim
+	@abstract	Append a primitive, along with its vertices and sort key.
+	@discussion	Unused vertex slots of lines and points are filled with
+				copies of the first vertex.
+*/
+void	TransparentBlock::AddPrim( const TransparentPrim& inPrim,
+									const Vertex* inVertices )
+{
+	const TQ3Uns32 kFirstVert = mPoints.size();
+	
+	mPrims.push_back( inPrim );
+	for (TQ3Uns32 i = 0; i < 3; ++i)
+	{
+		const Vertex& theVertex( inVertices[ (i < inPrim.mNumVerts)? i : 0 ] );
+		mPoints.push_back( theVertex.point );
+		mNormals.push_back( theVertex.normal );
+		mUVs.push_back( theVertex.uv );
+		mColors.push_back( PremultipliedColor( theVertex ) );
+	}
+	mSortKeys.push_back( DepthToSortKey( CalcPrimDepth( &mPoints[ kFirstVert ],
+		inPrim.mNumVerts ) ) );
+}
+
+/*!
+	@function	ResizeNotPreserving
+	@abstract	Make room for a number of primitives, to be filled in place.
+*/
+void	TransparentBlock::ResizeNotPreserving( TQ3Uns32 inNumPrims )
+{
+	mPrims.resizeNotPreserving( inNumPrims );
+	mSortKeys.resizeNotPreserving( inNumPrims );
+	mPoints.resizeNotPreserving( 3 * inNumPrims );
+	mNormals.resizeNotPreserving( 3 * inNumPrims );
+	mUVs.resizeNotPreserving( 3 * inNumPrims );
+	mColors.resizeNotPreserving( 3 * inNumPrims );
+}
+
+/*!
+	@function	SortPrimOrder
+	@abstract	Find the order of the primitives from back to front.
+	@discussion	Only the sort keys and indices are moved while sorting, so
+				the primitives and their vertices are not touched.  Large
+				blocks are sorted by the worker threads, unless this is called
+				from one of them.
 */
-void	TransparentBlock::SortPrimPtrs()
+void	TransparentBlock::SortPrimOrder()
 {
 	const TQ3Uns32 kNumPrims = static_cast<TQ3Uns32>(mPrims.size());
-	mPrimPtrs.resize( kNumPrims );
+	mPrimOrder.resizeNotPreserving( kNumPrims );
+	if (kNumPrims == 0)
+	{
+		return;
+	}
 	
 	for (TQ3Uns32 i = 0; i < kNumPrims; ++i)
 	{
-		mPrimPtrs[i] = &mPrims[i];
+		mPrimOrder[i] = i;
 	}
 	
-	PtrCompare	comparator;
-	const TransparentPrim**	ptrArray = &mPrimPtrs[0];
-	std::sort( ptrArray, ptrArray + kNumPrims, comparator );
+	if (kNumPrims < kMinPrimsToRadixSort)
+	{
+		TQ3Uns32* orderArray = &mPrimOrder[0];
+		std::sort( orderArray, orderArray + kNumPrims,
+			KeyCompare( &mSortKeys[0] ) );
+	}
+	else
+	{
+		E3FastArray<TQ3Uns32>	keys( mSortKeys );
+		TQ3Uns32 numChunks = E3Num_Min( E3Parallel_GetThreadCount(),
+			kNumPrims / kMinPrimsPerSortTask );
+		RadixSortKeys( keys, mPrimOrder, E3Num_Max( numChunks, 1U ) );
+	}
 }
 
 #pragma mark -
@@ -410,10 +635,11 @@ void	TransBuffer::AddPrim(
 {
 	int	i;
 	
-	// Copy vertices to new primitive structure
+	// Copy vertices, and start a new primitive structure
+	Vertex				theVerts[3];
+	memcpy( theVerts, inVertices, inNumVerts * sizeof(Vertex) );
 	TransparentPrim		thePrim;
 	thePrim.mNumVerts = inNumVerts;
-	memcpy( thePrim.mVerts, inVertices, inNumVerts * sizeof(Vertex) );
 	
 	// Transform vertex locations to camera space.
 	// If all z values are positive (behind the camera), we can bail early.
@@ -422,9 +648,9 @@ void	TransBuffer::AddPrim(
 	bool	isBehindCamera = true;
 	for (i = 0; i < inNumVerts; ++i)
 	{
-		E3Point3D_Transform( &thePrim.mVerts[i].point, &localToCamera,
-			&thePrim.mVerts[i].point );
-		if (thePrim.mVerts[i].point.z <= 0.0f)
+		E3Point3D_Transform( &theVerts[i].point, &localToCamera,
+			&theVerts[i].point );
+		if (theVerts[i].point.z <= 0.0f)
 		{
 			// I initially thought the comparison above should be <,
 			// but then the rasterize test in Geom Test failed.
@@ -437,25 +663,25 @@ void	TransBuffer::AddPrim(
 		return;
 	}
 	
-	// Transform vertex normals to camera coordinates, and also compute
-	// average z coordinate for depth sorting.
+	// Transform vertex normals to camera coordinates, and record the flags.
 	const TQ3Matrix4x4&	localToCameraInverseTranspose(
 		mRenderer.mMatrixState.GetLocalToCameraInverseTranspose() );
 	const TQ3Matrix4x4&	cameraToFrustum(
 		mRenderer.mMatrixState.GetCameraToFrustum() );
 	for (i = 0; i < inNumVerts; ++i)
 	{
-		if ( (thePrim.mVerts[i].flags & kVertexHaveNormal) != 0 )
+		if ( (theVerts[i].flags & kVertexHaveNormal) != 0 )
 		{
-			E3Vector3D_Transform( &thePrim.mVerts[i].normal,
+			E3Vector3D_Transform( &theVerts[i].normal,
 				&localToCameraInverseTranspose,
-				&thePrim.mVerts[i].normal );
+				&theVerts[i].normal );
 			
-			Q3FastVector3D_Normalize( &thePrim.mVerts[i].normal,
-				&thePrim.mVerts[i].normal );
+			Q3FastVector3D_Normalize( &theVerts[i].normal,
+				&theVerts[i].normal );
 		}
+		thePrim.mVertFlags[i] = theVerts[i].flags;
 	}
-	thePrim.mSortingDepth = CalcPrimDepth( thePrim );
+	thePrim.mEmissiveColor = EmissiveColor( theVerts[0] );
 	
 	// Record texture state
 	const Texture::TextureState&	textureState(
@@ -513,14 +739,14 @@ void	TransBuffer::AddPrim(
 	TQ3Point3D frustumPts[3];
 	for (i = 0; i < inNumVerts; ++i)
 	{
-		E3Point3D_Transform( &thePrim.mVerts[i].point, &cameraToFrustum,
+		E3Point3D_Transform( &theVerts[i].point, &cameraToFrustum,
 			&frustumPts[i] );
 	}
 	E3BoundingBox_SetFromPoints3D( &theBlock->mFrustumBounds, frustumPts,
 		inNumVerts, sizeof(TQ3Point3D) );
 	
 	// Record the primitive.
-	theBlock->mPrims.push_back( thePrim );
+	theBlock->AddPrim( thePrim, theVerts );
 	mIsSortNeeded = true;
 	
 	AddBlock( theBlock );
@@ -733,11 +959,15 @@ void	TransBuffer::AddTriMesh(
 		inGeomData.numPoints, sizeof(TQ3Vector3D), sizeof(TQ3Vector3D) );
 	
 	// Normalize the normals.
-	TQ3Uns32 i;
-	for (i = 0; i < inGeomData.numPoints; ++i)
-	{
-		Q3FastVector3D_Normalize( &mWorkCameraNormals[i], &mWorkCameraNormals[i] );
-	}
+	TQ3Vector3D* cameraNormals = &mWorkCameraNormals[0];
+	E3Parallel_For( inGeomData.numPoints, kMinTrianglesPerBuildTask,
+		[=]( TQ3Uns32 inStart, TQ3Uns32 inEnd )
+		{
+			for (TQ3Uns32 i = inStart; i < inEnd; ++i)
+			{
+				Q3FastVector3D_Normalize( &cameraNormals[i], &cameraNormals[i] );
+			}
+		} );
 	
 	// Record camera to frustum matrix
 	const TQ3Matrix4x4&	cameraToFrustum(
@@ -751,7 +981,6 @@ void	TransBuffer::AddTriMesh(
 	
 	// Make a new block.
 	TransparentBlock* theBlock = new TransparentBlock;
-	theBlock->mPrims.reserve( inGeomData.numTriangles );
 	
 	if ((inData.faceColor == nullptr) || (inData.vertColor != nullptr))
 	{
@@ -788,11 +1017,14 @@ void	TransBuffer::AddTriMesh(
 	// not change.
 	Vertex protoVert;
 	MakeVertexPrototype( inData, protoVert );
+	const TQ3ColorRGBA protoColor( PremultipliedColor( protoVert ) );
+	const TQ3Param2D kZeroUV = { 0.0f, 0.0f };
 	TransparentPrim thePrim;
 	thePrim.mNumVerts = 3;
-	thePrim.mVerts[0] = protoVert;
-	thePrim.mVerts[1] = protoVert;
-	thePrim.mVerts[2] = protoVert;
+	thePrim.mVertFlags[0] = protoVert.flags;
+	thePrim.mVertFlags[1] = protoVert.flags;
+	thePrim.mVertFlags[2] = protoVert.flags;
+	thePrim.mEmissiveColor = EmissiveColor( protoVert );
 	thePrim.mCameraToFrustumIndex = cameraToFrustumIndex;
 	thePrim.mSpecularColor = *mRenderer.mGeomState.specularColor;
 	thePrim.mSpecularControl = mRenderer.mCurrentSpecularControl;
@@ -818,24 +1050,38 @@ void	TransBuffer::AddTriMesh(
 		thePrim.mUVTransformIndex = static_cast<TQ3Uns32>(mUVTransforms.size() - 1);
 	}
 	
-	// Add the primitives, filling in the varying fields mVerts, mSortingDepth.
-	for (i = 0; i < inGeomData.numTriangles; ++i)
-	{
-		const TQ3Uns32* vertIndices = inGeomData.triangles[ i ].pointIndices;
-		thePrim.mVerts[0].point = mWorkCameraPts[ vertIndices[0] ];
-		thePrim.mVerts[1].point = mWorkCameraPts[ vertIndices[1] ];
-		thePrim.mVerts[2].point = mWorkCameraPts[ vertIndices[2] ];
-		thePrim.mVerts[0].normal = mWorkCameraNormals[ vertIndices[0] ];
-		thePrim.mVerts[1].normal = mWorkCameraNormals[ vertIndices[1] ];
-		thePrim.mVerts[2].normal = mWorkCameraNormals[ vertIndices[2] ];
-		if (inData.vertUV != nullptr)
-		{
-			thePrim.mVerts[0].uv = inData.vertUV[ vertIndices[0] ];
-			thePrim.mVerts[1].uv = inData.vertUV[ vertIndices[1] ];
-			thePrim.mVerts[2].uv = inData.vertUV[ vertIndices[2] ];
-		}
-		thePrim.mSortingDepth = CalcPrimDepth( thePrim );
-		theBlock->mPrims.push_back( thePrim );
+	// Add the primitives, filling in their vertices and sort keys.  Each
+	// triangle only reads the work arrays and writes its own slots, so the
+	// triangles can be split across the worker threads.
+	if (inGeomData.numTriangles > 0)
+	{
+		theBlock->ResizeNotPreserving( inGeomData.numTriangles );
+		TransparentPrim* prims = &theBlock->mPrims[0];
+		TQ3Uns32* sortKeys = &theBlock->mSortKeys[0];
+		TQ3Point3D* points = &theBlock->mPoints[0];
+		TQ3Vector3D* normals = &theBlock->mNormals[0];
+		TQ3Param2D* uvs = &theBlock->mUVs[0];
+		TQ3ColorRGBA* colors = &theBlock->mColors[0];
+		const TQ3Point3D* cameraPts = &mWorkCameraPts[0];
+		E3Parallel_For( inGeomData.numTriangles, kMinTrianglesPerBuildTask,
+			[=,&inGeomData,&inData]( TQ3Uns32 inStart, TQ3Uns32 inEnd )
+			{
+				for (TQ3Uns32 i = inStart; i < inEnd; ++i)
+				{
+					const TQ3Uns32* vertIndices = inGeomData.triangles[ i ].pointIndices;
+					for (TQ3Uns32 j = 0; j < 3; ++j)
+					{
+						points[ 3 * i + j ] = cameraPts[ vertIndices[j] ];
+						normals[ 3 * i + j ] = cameraNormals[ vertIndices[j] ];
+						uvs[ 3 * i + j ] = (inData.vertUV != nullptr)?
+							inData.vertUV[ vertIndices[j] ] : kZeroUV;
+						colors[ 3 * i + j ] = protoColor;
+					}
+					prims[i] = thePrim;
+					sortKeys[i] = DepthToSortKey( CalcPrimDepth( &points[ 3 * i ], 3 ) );
+				}
+			} );
+		
 		mIsSortNeeded = true;
 	}
 	
@@ -866,26 +1112,72 @@ void	TransBuffer::AddPoint( const Vertex& inVertex )
 	}
 }
 
+/*!
+	@function	SortIndices
+	@abstract	Sort the blocks, and the primitives in each block, if that has
+				not been done since primitives were added.
+	@discussion	The time taken is added to the renderer's count for the frame.
+*/
 void	TransBuffer::SortIndices()
 {
 	if (mIsSortNeeded)
 	{
+		std::chrono::steady_clock::time_point startTime(
+			std::chrono::steady_clock::now() );
+		
 		//Q3_LOG_FMT( "TransBuffer::SortIndices 1" );
 		SortBlocks();
 		//Q3_LOG_FMT( "TransBuffer::SortIndices 2" );
-		SortPrimPtrsInEachBlock();
+		SortPrimsInEachBlock();
 		//Q3_LOG_FMT( "TransBuffer::SortIndices 3" );
 
 		mIsSortNeeded = false;
+		
+		mRenderer.CountTransparencySortTime( static_cast<unsigned long long>(
+			std::chrono::duration_cast<std::chrono::microseconds>(
+				std::chrono::steady_clock::now() - startTime ).count() ) );
 	}
 }
 
-void	TransBuffer::SortPrimPtrsInEachBlock()
+/*!
+	@function	SortPrimsInEachBlock
+	
+	@abstract	Sort the primitives of each block back to front.
+	
+	@discussion	A block big enough to split across the worker threads is
+				sorted by itself.  The many small blocks, such as those made by
+				AddPrim, are instead handed out to the threads a batch of
+				blocks at a time.
+*/
+void	TransBuffer::SortPrimsInEachBlock()
 {
-	for (TQ3Uns32 i = 0; i < mBlocks.size(); ++i)
+	const TQ3Uns32 kNumBlocks = mBlocks.size();
+	if (kNumBlocks == 0)
 	{
-		mBlocks[i]->SortPrimPtrs();
+		return;
+	}
+	
+	TQ3Uns32 i;
+	for (i = 0; i < kNumBlocks; ++i)
+	{
+		if (mBlocks[i]->mPrims.size() >= 2 * kMinPrimsPerSortTask)
+		{
+			mBlocks[i]->SortPrimOrder();
+		}
 	}
+	
+	TransparentBlock** blocks = &mBlocks[0];
+	E3Parallel_For( kNumBlocks, kMinBlocksPerSortTask,
+		[=]( TQ3Uns32 inStart, TQ3Uns32 inEnd )
+		{
+			for (TQ3Uns32 j = inStart; j < inEnd; ++j)
+			{
+				if (blocks[j]->mPrims.size() < 2 * kMinPrimsPerSortTask)
+				{
+					blocks[j]->SortPrimOrder();
+				}
+			}
+		} );
 }
 
 void	TransBuffer::SearchBlock( TQ3Uns32 inToVisit,
@@ -1034,6 +1326,7 @@ void	TransBuffer::UpdateTexture( const TransparentPrim& inPrim )
 		if (mCurTexture != 0)
 		{
 			glBindTexture( GL_TEXTURE_2D, mCurTexture );
+			mRenderer.CountTextureBind();
 		}
 		
 		mPerPixelLighting.UpdateTexture( mCurTexture != 0 );
@@ -1131,14 +1424,14 @@ void	TransBuffer::UpdateEmission( const TransparentPrim& inPrim )
 	// using per-pixel lighting.
 	// Setting the emissive color before glBegin fixes that problem, and I think
 	// we can live without per-vertex emissive color.
-	SetEmissiveColor( EmissiveColor( inPrim ) );
+	SetEmissiveColor( inPrim.mEmissiveColor );
 }
 
 
 void	TransBuffer::RenderPrimGroupForDepth(
 										TQ3ViewObject inView )
 {
-	const TransparentPrim& leader( *mRenderGroup[0] );
+	const TransparentPrim& leader( mRenderGroup[0].mBlock->mPrims[ mRenderGroup[0].mIndex ] );
 	
 	UpdateCameraToFrustum( leader, inView );
 	UpdateTexture( leader );
@@ -1148,7 +1441,7 @@ void	TransBuffer::RenderPrimGroupForDepth(
 	UpdateLineWidth( leader );
 
 	{
-		VertexFlags flags = leader.mVerts[0].flags;
+		VertexFlags flags = leader.mVertFlags[0];
 		TQ3Uns32 vertsPerPrim = leader.mNumVerts;
 		TQ3Uns32 pointsExpected = vertsPerPrim * mRenderGroup.size();
 		mGroupPts.clear();
@@ -1179,26 +1472,19 @@ void	TransBuffer::RenderPrimGroupForDepth(
 		TQ3Uns32 i, j;
 		for (i = 0; i < mRenderGroup.size(); ++i)
 		{
-			const TransparentPrim& aPrim( *mRenderGroup[i] );
+			const TransparentBlock& aBlock( *mRenderGroup[i].mBlock );
+			const TQ3Uns32 kFirstVert = 3 * mRenderGroup[i].mIndex;
 			
-			for (j = 0; j < vertsPerPrim; ++j)
+			for (j = kFirstVert; j < kFirstVert + vertsPerPrim; ++j)
 			{
-				const Vertex& aVertex( aPrim.mVerts[j] );
-				mGroupPts.push_back( aVertex.point );
+				mGroupPts.push_back( aBlock.mPoints[j] );
 				if ( haveUV )
 				{
-					mGroupUVs.push_back( aVertex.uv );
+					mGroupUVs.push_back( aBlock.mUVs[j] );
 				}
 				if ( haveColor )
 				{
-					TQ3ColorRGBA theColor =
-					{
-						aVertex.diffuseColor.r * aVertex.vertAlpha,
-						aVertex.diffuseColor.g * aVertex.vertAlpha,
-						aVertex.diffuseColor.b * aVertex.vertAlpha,
-						aVertex.vertAlpha
-					};
-					mGroupColors.push_back( theColor );
+					mGroupColors.push_back( aBlock.mColors[j] );
 				}
 			}
 		}
@@ -1247,7 +1533,7 @@ void	TransBuffer::UpdateSpecular( const TransparentPrim& inPrim )
 void	TransBuffer::RenderPrimGroup(
 											TQ3ViewObject inView )
 {
-	const TransparentPrim& leader( *mRenderGroup[0] );
+	const TransparentPrim& leader( mRenderGroup[0].mBlock->mPrims[ mRenderGroup[0].mIndex ] );
 	
 	UpdateCameraToFrustum( leader, inView );
 	UpdateTexture( leader );
@@ -1263,7 +1549,7 @@ void	TransBuffer::RenderPrimGroup(
 	mForceUpdate = false;
 
 	{
-		VertexFlags flags = leader.mVerts[0].flags;
+		VertexFlags flags = leader.mVertFlags[0];
 		TQ3Uns32 vertsPerPrim = leader.mNumVerts;
 		TQ3Uns32 pointsExpected = vertsPerPrim * mRenderGroup.size();
 		mGroupPts.clear();
@@ -1303,30 +1589,23 @@ void	TransBuffer::RenderPrimGroup(
 		TQ3Uns32 i, j;
 		for (i = 0; i < mRenderGroup.size(); ++i)
 		{
-			const TransparentPrim& aPrim( *mRenderGroup[i] );
+			const TransparentBlock& aBlock( *mRenderGroup[i].mBlock );
+			const TQ3Uns32 kFirstVert = 3 * mRenderGroup[i].mIndex;
 			
-			for (j = 0; j < vertsPerPrim; ++j)
+			for (j = kFirstVert; j < kFirstVert + vertsPerPrim; ++j)
 			{
-				const Vertex& aVertex( aPrim.mVerts[j] );
-				mGroupPts.push_back( aVertex.point );
+				mGroupPts.push_back( aBlock.mPoints[j] );
 				if (haveNormal)
 				{
-					mGroupNormals.push_back( aVertex.normal );
+					mGroupNormals.push_back( aBlock.mNormals[j] );
 				}
 				if ( haveUV )
 				{
-					mGroupUVs.push_back( aVertex.uv );
+					mGroupUVs.push_back( aBlock.mUVs[j] );
 				}
 				if ( haveColor )
 				{
-					TQ3ColorRGBA theColor =
-					{
-						aVertex.diffuseColor.r * aVertex.vertAlpha,
-						aVertex.diffuseColor.g * aVertex.vertAlpha,
-						aVertex.diffuseColor.b * aVertex.vertAlpha,
-						aVertex.vertAlpha
-					};
-					mGroupColors.push_back( theColor );
+					mGroupColors.push_back( aBlock.mColors[j] );
 				}
 			}
 		}
@@ -1370,26 +1649,27 @@ void	TransBuffer::DrawTransparency( TQ3ViewObject inView,
 
 		for (TQ3Uns32 blockNum = 0; blockNum < mBlocks.size(); ++blockNum)
 		{
-			TransparentBlock& block( *mBlocks[blockNum] );
+			const TransparentBlock& block( *mBlocks[blockNum] );
 			for (TQ3Uns32 primNum = 0; primNum < block.mPrims.size(); ++primNum)
 			{
-				const TransparentPrim& thePrim( *block.mPrimPtrs[primNum] );
+				const TransparentPrimRef thePrimRef = { &block, block.mPrimOrder[primNum] };
+				const TransparentPrim& thePrim( block.mPrims[ thePrimRef.mIndex ] );
 				if (gpLeader == nullptr)
 				{
 					gpLeader = &thePrim;
-					mRenderGroup.push_back( gpLeader );
+					mRenderGroup.push_back( thePrimRef );
 				}
 				else if ( ((primNum > 0) && block.mHasUniformVertexFlags) ||
 					IsSameState( thePrim, *gpLeader ) )
 				{
-					mRenderGroup.push_back( &thePrim );
+					mRenderGroup.push_back( thePrimRef );
 				}
 				else // finish the group and start another
 				{
 					RenderPrimGroup( inView );
 					mRenderGroup.clear();
 					gpLeader = &thePrim;
-					mRenderGroup.push_back( gpLeader );
+					mRenderGroup.push_back( thePrimRef );
 				}
 			}
 		}
@@ -1489,26 +1769,27 @@ void	TransBuffer::DrawDepth( TQ3ViewObject inView )
 
 		for (TQ3Uns32 blockNum = 0; blockNum < mBlocks.size(); ++blockNum)
 		{
-			TransparentBlock& block( *mBlocks[blockNum] );
+			const TransparentBlock& block( *mBlocks[blockNum] );
 			for (TQ3Uns32 primNum = 0; primNum < block.mPrims.size(); ++primNum)
 			{
-				const TransparentPrim& thePrim( *block.mPrimPtrs[primNum] );
+				const TransparentPrimRef thePrimRef = { &block, block.mPrimOrder[primNum] };
+				const TransparentPrim& thePrim( block.mPrims[ thePrimRef.mIndex ] );
 				if (gpLeader == nullptr)
 				{
 					gpLeader = &thePrim;
-					mRenderGroup.push_back( gpLeader );
+					mRenderGroup.push_back( thePrimRef );
 				}
 				else if ( ((primNum > 0) && block.mHasUniformVertexFlags) ||
 					IsSameStateForDepth( thePrim, *gpLeader ) )
 				{
-					mRenderGroup.push_back( &thePrim );
+					mRenderGroup.push_back( thePrimRef );
 				}
 				else // finish the group and start another
 				{
 					RenderPrimGroupForDepth( inView );
 					mRenderGroup.clear();
 					gpLeader = &thePrim;
-					mRenderGroup.push_back( gpLeader );
+					mRenderGroup.push_back( thePrimRef );
 				}
 			}
 		}
@@ -72,11 +72,20 @@ struct PrimStyleState
 	float				mLineWidthStyle;
 };
 
+/*!
+	@struct		TransparentPrim
+	
+	@abstract	State of a buffered transparent primitive.
+	
+	@discussion	The vertices are not kept here, but in arrays of the block
+				holding the primitive, so that sorting and grouping the
+				primitives does not drag their vertices through the cache.
+*/
 struct TransparentPrim
 {
 	TQ3Uns32			mNumVerts;
-	Vertex				mVerts[3];	// points and normals in camera coordinates
-	float				mSortingDepth;
+	VertexFlags			mVertFlags[3];
+	TQ3ColorRGB			mEmissiveColor;	// black unless the first vertex has one
 	
 	GLuint				mTextureName;
 	bool				mIsTextureTransparent;
@@ -96,6 +105,10 @@ struct TransparentPrim
 	@abstract			Buffer for a group of transparent primitives, whose
 						bounding box in frustum space should be disjoint from
 						each other such block.
+	
+	@discussion			The primitives are stored as parallel arrays.  Each
+						primitive has a sort key, and 3 slots in each of the
+						vertex arrays, whether or not it uses all of them.
 */
 class TransparentBlock
 {
@@ -108,11 +121,21 @@ public:
 	
 	bool				Occludes( const TransparentBlock& inOther ) const;
 	
-	void				SortPrimPtrs();
+	void				AddPrim( const TransparentPrim& inPrim,
+								const Vertex* inVertices );
+	
+	void				ResizeNotPreserving( TQ3Uns32 inNumPrims );
+	
+	void				SortPrimOrder();
 						
 	E3FastArray<TransparentPrim>			mPrims;
+	E3FastArray<TQ3Uns32>					mSortKeys;	// parallel to mPrims
+	E3FastArray<TQ3Point3D>					mPoints;	// camera coordinates
+	E3FastArray<TQ3Vector3D>				mNormals;	// camera coordinates
+	E3FastArray<TQ3Param2D>					mUVs;
+	E3FastArray<TQ3ColorRGBA>				mColors;	// premultiplied by alpha
 	TQ3BoundingBox							mFrustumBounds;
-	E3FastArray<const TransparentPrim*>		mPrimPtrs;
+	E3FastArray<TQ3Uns32>					mPrimOrder;	// back to front
 	TQ3Int32								mVisitOrder;
 	bool									mHasUniformVertexFlags;
 
@@ -121,6 +144,16 @@ private:
 	TransparentBlock&	operator=( const TransparentBlock& inOther );
 };
 
+/*!
+	@struct		TransparentPrimRef
+	@abstract	Location of a primitive within its block.
+*/
+struct TransparentPrimRef
+{
+	const TransparentBlock*	mBlock;
+	TQ3Uns32				mIndex;
+};
+
 /*!
 	@class		TransBuffer
 	
@@ -175,7 +208,7 @@ private:
 											const TQ3TriMeshData& inGeomData );
 	bool							FindPointsInFrontOfCamera();
 
-	void							SortPrimPtrsInEachBlock();
+	void							SortPrimsInEachBlock();
 	void							SortBlocks();
 	void							SearchBlock( TQ3Uns32 inToVisit,
 												TQ3Int32& ioNextID );
@@ -245,7 +278,7 @@ private:
 	GLenum							mSrcBlendFactor;
 	GLenum							mDstBlendFactor;
 	
-	E3FastArray<const TransparentPrim*>	mRenderGroup;
+	E3FastArray<TransparentPrimRef>	mRenderGroup;
 	E3FastArray<TQ3Point3D>			mGroupPts;
 	E3FastArray<TQ3Vector3D>		mGroupNormals;
 	E3FastArray<TQ3Param2D>			mGroupUVs;
@@ -191,9 +191,21 @@ void	QORenderer::Renderer::UpdateSurfaceShader(
 	GLDrawContext_SetCurrent( mGLContext, kQ3False );
 	
 	
+	// Queued TriMeshes record their own surface shader, so the render queue
+	// need not be flushed.
 	mTriBuffer.Flush();
+	mMeshBatch.Flush();
 	
+	mSurfaceShader = CQ3ObjectRef( (inShader == nullptr)? nullptr :
+		Q3Shared_GetReference( inShader ) );
 	
+	ApplySurfaceShader( inShader );
+}
+
+
+void	QORenderer::Renderer::ApplySurfaceShader(
+								TQ3ShaderObject inShader )
+{
 	// If this is a texture shader, get the texture from the shader
 	CQ3ObjectRef	theTexture;
 	if (inShader != nullptr && ( (mAttributesMask & kQ3XAttributeMaskDiffuseColor) != 0))
@@ -228,6 +240,8 @@ void	QORenderer::Renderer::UpdateIlluminationShader(
 	
 	
 	mTriBuffer.Flush();
+	mMeshBatch.Flush();
+	mRenderQueue.Flush();
 	
 	
 	// Update our state
@@ -258,6 +272,8 @@ void	QORenderer::Renderer::UpdateInterpolationStyle(
 	
 	
 	mTriBuffer.Flush();
+	mMeshBatch.Flush();
+	mRenderQueue.Flush();
 	
 	
 	mStyleState.mInterpolation = *inStyleData;
@@ -280,6 +296,8 @@ void	QORenderer::Renderer::UpdateBackfacingStyle(
 	
 	
 	mTriBuffer.Flush();
+	mMeshBatch.Flush();
+	mRenderQueue.Flush();
 	
 	
 	mStyleState.mBackfacing = *inStyleData;
@@ -321,6 +339,8 @@ void	QORenderer::Renderer::UpdateFillStyle(
 	
 	
 	mTriBuffer.Flush();
+	mMeshBatch.Flush();
+	mRenderQueue.Flush();
 	
 	
 	mStyleState.mFill = *inStyleData;
@@ -361,6 +381,8 @@ void	QORenderer::Renderer::UpdateOrientationStyle(
 	
 	
 	mTriBuffer.Flush();
+	mMeshBatch.Flush();
+	mRenderQueue.Flush();
 	
 	
 	mStyleState.mOrientation = *inStyleData;
@@ -392,6 +414,8 @@ void	QORenderer::Renderer::UpdateHighlightStyle(
 	
 	
 	mTriBuffer.Flush();
+	mMeshBatch.Flush();
+	mRenderQueue.Flush();
 	
 	
 	if (*inStyleData == nullptr)
@@ -418,6 +442,8 @@ void	QORenderer::Renderer::UpdateAntiAliasStyle(
 	
 	
 	mTriBuffer.Flush();
+	mMeshBatch.Flush();
+	mRenderQueue.Flush();
 	
 	
 	// Currently there is no way to vary point size.
@@ -476,6 +502,8 @@ void	QORenderer::Renderer::UpdateFogStyle(
 	
 	
 	mTriBuffer.Flush();
+	mMeshBatch.Flush();
+	mRenderQueue.Flush();
 	
 	
 	// Update fog state in my instance data.  This is needed for buffered
@@ -512,6 +540,8 @@ void	QORenderer::Renderer::UpdateCastShadowsStyle(
 	
 	
 	mTriBuffer.Flush();
+	mMeshBatch.Flush();
+	mRenderQueue.Flush();
 	
 	
 	mStyleState.mIsCastingShadows = (inStyleData == kQ3True);
@@ -531,6 +561,8 @@ void	QORenderer::Renderer::UpdateReceiveShadowsStyle(
 		
 		
 		mTriBuffer.Flush();
+		mMeshBatch.Flush();
+		mRenderQueue.Flush();
 		
 		
 		if (inStyleData) // do receive shadows
@@ -553,6 +585,8 @@ void	QORenderer::Renderer::UpdateLineWidthStyle(
 	
 	
 	mTriBuffer.Flush();
+	mMeshBatch.Flush();
+	mRenderQueue.Flush();
 	
 	
 	mLineWidth = inStyleData;
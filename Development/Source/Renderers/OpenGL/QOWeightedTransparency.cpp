@@ -0,0 +1,906 @@
+/*  NAME:
+        QOWeightedTransparency.cpp
+
+    DESCRIPTION:
+        Source for Quesa OpenGL renderer class.
+
+    COPYRIGHT:
+        Copyright (c) 2026, Quesa Developers. All rights reserved.
+
+        For the current release of Quesa, please see:
+
+            <https://github.com/jwwalker/Quesa>
+        
+        Redistribution and use in source and binary forms, with or without
+        modification, are permitted provided that the following conditions
+        are met:
+        
+            o Redistributions of source code must retain the above copyright
+              notice, this list of conditions and the following disclaimer.
+        
+            o Redistributions in binary form must reproduce the above
+              copyright notice, this list of conditions and the following
+              disclaimer in the documentation and/or other materials provided
+              with the distribution.
+        
+            o Neither the name of Quesa nor the names of its contributors
+              may be used to endorse or promote products derived from this
+              software without specific prior written permission.
+        
+        THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+        "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+        LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+        A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+        OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+        SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+        TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+        PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+        LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+        NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+        SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+    ___________________________________________________________________________
+*/
+
+
+
+
+
+//=============================================================================
+//      Include files
+//-----------------------------------------------------------------------------
+#include "QOWeightedTransparency.h"
+#include "QORenderer.h"
+#include "QOGLSLShaders.h"
+#include "GLCamera.h"
+#include "GLUtils.h"
+
+#include <cstring>
+
+
+// In lieu of glext.h
+#ifndef GL_VERSION_3_0
+	#define GL_RGBA16F						0x881A
+	#define GL_R16F							0x822D
+	#define GL_HALF_FLOAT					0x140B
+	#define GL_FRAMEBUFFER					0x8D40
+	#define GL_READ_FRAMEBUFFER				0x8CA8
+	#define GL_DRAW_FRAMEBUFFER				0x8CA9
+	#define GL_DRAW_FRAMEBUFFER_BINDING		0x8CA6
+	#define GL_FRAMEBUFFER_COMPLETE			0x8CD5
+	#define GL_RENDERBUFFER					0x8D41
+	#define GL_COLOR_ATTACHMENT0			0x8CE0
+	#define GL_COLOR_ATTACHMENT1			0x8CE1
+	#define GL_DEPTH_ATTACHMENT				0x8D00
+	#define GL_STENCIL_ATTACHMENT			0x8D20
+	#define GL_DEPTH_STENCIL_ATTACHMENT		0x821A
+	#define GL_DEPTH24_STENCIL8				0x88F0
+	#define GL_DEPTH_COMPONENT32F			0x8CAC
+	#define GL_DEPTH32F_STENCIL8			0x8CAD
+	#define GL_FRAMEBUFFER_ATTACHMENT_OBJECT_TYPE		0x8CD0
+	#define GL_FRAMEBUFFER_ATTACHMENT_COMPONENT_TYPE	0x8211
+	#define GL_FRAMEBUFFER_ATTACHMENT_DEPTH_SIZE		0x8216
+	#define GL_FRAMEBUFFER_ATTACHMENT_STENCIL_SIZE		0x8217
+#endif
+
+#ifndef GL_DEPTH_COMPONENT16
+	#define GL_DEPTH_COMPONENT16			0x81A5
+	#define GL_DEPTH_COMPONENT24			0x81A6
+	#define GL_DEPTH_COMPONENT32			0x81A7
+#endif
+
+#ifndef GL_ARRAY_BUFFER
+	#define GL_ARRAY_BUFFER					0x8892
+	#define GL_STATIC_DRAW					0x88E4
+#endif
+
+#ifndef GL_CLAMP_TO_EDGE
+	#define GL_CLAMP_TO_EDGE				0x812F
+#endif
+
+#ifndef GL_SAMPLES
+	#define GL_SAMPLES						0x80A9
+#endif
+
+#ifndef GL_TEXTURE0
+	#define GL_TEXTURE0						0x84C0
+#endif
+
+
+//=============================================================================
+//      Internal constants
+//-----------------------------------------------------------------------------
+namespace
+{
+	// Texture units for the composite, chosen to stay clear of the units
+	// used by the Texture class.
+	const GLenum	kAccumTextureUnit	= GL_TEXTURE0 + 2;
+	const GLenum	kWeightTextureUnit	= GL_TEXTURE0 + 3;
+	
+	const GLenum	kDrawBuffers[2] =
+	{
+		GL_COLOR_ATTACHMENT0, GL_COLOR_ATTACHMENT1
+	};
+	
+	// One triangle that covers the viewport, in clip coordinates.
+	const GLfloat	kCorners[6] =
+	{
+		-1.0f, -1.0f,
+		3.0f, -1.0f,
+		-1.0f, 3.0f
+	};
+	
+	const GLfloat	kClearAccum[4] = { 0.0f, 0.0f, 0.0f, 1.0f };
+	const GLfloat	kClearWeight[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+}
+
+
+//=============================================================================
+//      Local functions
+//-----------------------------------------------------------------------------
+
+/*!
+	@function	FindDepthFormat
+	@abstract	Choose a depth format matching that of the framebuffer bound
+				for drawing, since a depth blit requires matching formats.
+	@result		A renderbuffer format, or GL_NONE if there is no depth buffer.
+*/
+static GLenum FindDepthFormat( const QORenderer::FramebufferFuncs& inFuncs,
+								GLint inFramebuffer )
+{
+	const GLenum	depthAttachment = (inFramebuffer == 0)? GL_DEPTH :
+		GL_DEPTH_ATTACHMENT;
+	const GLenum	stencilAttachment = (inFramebuffer == 0)? GL_STENCIL :
+		GL_STENCIL_ATTACHMENT;
+	
+	GLint	objectType = GL_NONE;
+	inFuncs.glGetFramebufferAttachmentParameteriv( GL_DRAW_FRAMEBUFFER,
+		depthAttachment, GL_FRAMEBUFFER_ATTACHMENT_OBJECT_TYPE, &objectType );
+	if (objectType == GL_NONE)
+	{
+		return GL_NONE;
+	}
+	
+	GLint	depthBits = 0;
+	GLint	componentType = GL_NONE;
+	inFuncs.glGetFramebufferAttachmentParameteriv( GL_DRAW_FRAMEBUFFER,
+		depthAttachment, GL_FRAMEBUFFER_ATTACHMENT_DEPTH_SIZE, &depthBits );
+	inFuncs.glGetFramebufferAttachmentParameteriv( GL_DRAW_FRAMEBUFFER,
+		depthAttachment, GL_FRAMEBUFFER_ATTACHMENT_COMPONENT_TYPE, &componentType );
+	
+	GLint	stencilBits = 0;
+	objectType = GL_NONE;
+	inFuncs.glGetFramebufferAttachmentParameteriv( GL_DRAW_FRAMEBUFFER,
+		stencilAttachment, GL_FRAMEBUFFER_ATTACHMENT_OBJECT_TYPE, &objectType );
+	if (objectType != GL_NONE)
+	{
+		inFuncs.glGetFramebufferAttachmentParameteriv( GL_DRAW_FRAMEBUFFER,
+			stencilAttachment, GL_FRAMEBUFFER_ATTACHMENT_STENCIL_SIZE, &stencilBits );
+	}
+	
+	GLenum	theFormat;
+	if (componentType == GL_FLOAT)
+	{
+		theFormat = (stencilBits > 0)? GL_DEPTH32F_STENCIL8 : GL_DEPTH_COMPONENT32F;
+	}
+	else if (stencilBits > 0)
+	{
+		theFormat = GL_DEPTH24_STENCIL8;
+	}
+	else if (depthBits <= 16)
+	{
+		theFormat = GL_DEPTH_COMPONENT16;
+	}
+	else if (depthBits <= 24)
+	{
+		theFormat = GL_DEPTH_COMPONENT24;
+	}
+	else
+	{
+		theFormat = GL_DEPTH_COMPONENT32;
+	}
+	return theFormat;
+}
+
+
+/*!
+	@function	CompileShader
+	@abstract	Create and compile a shader.
+	@result		A shader ID, or 0 on failure.
+*/
+static GLuint CompileShader( GLenum inShaderType, const char* inSource,
+							const QORenderer::GLSLFuncs& inFuncs )
+{
+	GLuint	shaderID = inFuncs.glCreateShader( inShaderType );
+	if (shaderID != 0)
+	{
+		GLint	sourceLen = (GLint) std::strlen( inSource );
+		inFuncs.glShaderSource( shaderID, 1, &inSource, &sourceLen );
+		inFuncs.glCompileShader( shaderID );
+		
+		GLint	status = GL_FALSE;
+		inFuncs.glGetShaderiv( shaderID, GL_COMPILE_STATUS, &status );
+		if (status == GL_FALSE)
+		{
+			Q3_MESSAGE( "Failed to compile weighted transparency shader.\n" );
+			inFuncs.glDeleteShader( shaderID );
+			shaderID = 0;
+		}
+	}
+	return shaderID;
+}
+
+
+#pragma mark -
+//=============================================================================
+//      FramebufferFuncs implementation
+//-----------------------------------------------------------------------------
+
+QORenderer::FramebufferFuncs::FramebufferFuncs()
+	: glGenFramebuffers( nullptr )
+	, glDeleteFramebuffers( nullptr )
+	, glBindFramebuffer( nullptr )
+	, glCheckFramebufferStatus( nullptr )
+	, glFramebufferTexture2D( nullptr )
+	, glFramebufferRenderbuffer( nullptr )
+	, glGetFramebufferAttachmentParameteriv( nullptr )
+	, glGenRenderbuffers( nullptr )
+	, glDeleteRenderbuffers( nullptr )
+	, glBindRenderbuffer( nullptr )
+	, glRenderbufferStorage( nullptr )
+	, glBlitFramebuffer( nullptr )
+	, glDrawBuffers( nullptr )
+	, glColorMaski( nullptr )
+	, glBlendFuncSeparate( nullptr )
+	, glClearBufferfv( nullptr )
+{
+}
+
+/*!
+	@function	Initialize
+	@abstract	Get the function pointers.  This should be called while the
+				OpenGL context is current.
+	@discussion	We use the core OpenGL 3.0 names, since the framebuffer
+				functions of the older EXT extensions do not support separate
+				read and draw framebuffers.
+	@result		True if all of the functions are available.
+*/
+bool	QORenderer::FramebufferFuncs::Initialize()
+{
+	GLGetProcAddress( glGenFramebuffers, "glGenFramebuffers" );
+	GLGetProcAddress( glDeleteFramebuffers, "glDeleteFramebuffers" );
+	GLGetProcAddress( glBindFramebuffer, "glBindFramebuffer" );
+	GLGetProcAddress( glCheckFramebufferStatus, "glCheckFramebufferStatus" );
+	GLGetProcAddress( glFramebufferTexture2D, "glFramebufferTexture2D" );
+	GLGetProcAddress( glFramebufferRenderbuffer, "glFramebufferRenderbuffer" );
+	GLGetProcAddress( glGetFramebufferAttachmentParameteriv,
+		"glGetFramebufferAttachmentParameteriv" );
+	GLGetProcAddress( glGenRenderbuffers, "glGenRenderbuffers" );
+	GLGetProcAddress( glDeleteRenderbuffers, "glDeleteRenderbuffers" );
+	GLGetProcAddress( glBindRenderbuffer, "glBindRenderbuffer" );
+	GLGetProcAddress( glRenderbufferStorage, "glRenderbufferStorage" );
+	GLGetProcAddress( glBlitFramebuffer, "glBlitFramebuffer" );
+	GLGetProcAddress( glDrawBuffers, "glDrawBuffers", "glDrawBuffersARB" );
+	GLGetProcAddress( glColorMaski, "glColorMaski", "glColorMaskIndexedEXT" );
+	GLGetProcAddress( glBlendFuncSeparate, "glBlendFuncSeparate" );
+	GLGetProcAddress( glClearBufferfv, "glClearBufferfv" );
+	
+	return (glGenFramebuffers != nullptr) &&
+		(glDeleteFramebuffers != nullptr) &&
+		(glBindFramebuffer != nullptr) &&
+		(glCheckFramebufferStatus != nullptr) &&
+		(glFramebufferTexture2D != nullptr) &&
+		(glFramebufferRenderbuffer != nullptr) &&
+		(glGetFramebufferAttachmentParameteriv != nullptr) &&
+		(glGenRenderbuffers != nullptr) &&
+		(glDeleteRenderbuffers != nullptr) &&
+		(glBindRenderbuffer != nullptr) &&
+		(glRenderbufferStorage != nullptr) &&
+		(glBlitFramebuffer != nullptr) &&
+		(glDrawBuffers != nullptr) &&
+		(glColorMaski != nullptr) &&
+		(glBlendFuncSeparate != nullptr) &&
+		(glClearBufferfv != nullptr);
+}
+
+
+#pragma mark -
+//=============================================================================
+//      WeightedTransparency implementation
+//-----------------------------------------------------------------------------
+
+/*!
+	@function	WeightedTransparency (constructor)
+	@abstract	Initialize, without creating any OpenGL objects.
+*/
+QORenderer::WeightedTransparency::WeightedTransparency( Renderer& inRenderer )
+	: mRenderer( inRenderer )
+	, mFuncs()
+	, mIsActive( false )
+	, mIsSupported( true )
+	, mHaveFuncs( false )
+	, mHasTargets( false )
+	, mTargetWidth( 0 )
+	, mTargetHeight( 0 )
+	, mDepthFormat( GL_NONE )
+	, mFramebuffer( 0 )
+	, mAccumTexture( 0 )
+	, mWeightTexture( 0 )
+	, mDepthRenderbuffer( 0 )
+	, mCornerBuffer( 0 )
+	, mProgram( 0 )
+	, mViewportOriginLoc( -1 )
+{
+	mViewport[0] = mViewport[1] = mViewport[2] = mViewport[3] = 0;
+}
+
+QORenderer::WeightedTransparency::~WeightedTransparency()
+{
+	Cleanup();
+}
+
+
+/*!
+	@function	Cleanup
+	@abstract	Delete OpenGL objects.  This should be called while the
+				OpenGL context is current, before it is destroyed.
+	@discussion	Function pointers are looked up again for the next context.
+*/
+void	QORenderer::WeightedTransparency::Cleanup()
+{
+	if (mFramebuffer != 0)
+	{
+		mFuncs.glDeleteFramebuffers( 1, &mFramebuffer );
+		mFuncs.glDeleteRenderbuffers( 1, &mDepthRenderbuffer );
+		glDeleteTextures( 1, &mAccumTexture );
+		glDeleteTextures( 1, &mWeightTexture );
+		mFramebuffer = mDepthRenderbuffer = mAccumTexture = mWeightTexture = 0;
+	}
+	if (mCornerBuffer != 0)
+	{
+		(*mRenderer.mFuncs.glDeleteBuffersProc)( 1, &mCornerBuffer );
+		mCornerBuffer = 0;
+	}
+	if (mProgram != 0)
+	{
+		mRenderer.mSLFuncs.glDeleteProgram( mProgram );
+		mProgram = 0;
+	}
+	mTargetWidth = mTargetHeight = 0;
+	mDepthFormat = GL_NONE;
+	mEntries.clear();
+	mIsActive = false;
+	mHasTargets = false;
+	mHaveFuncs = false;
+	mIsSupported = true;
+}
+
+
+/*!
+	@function	StartFrame
+	@abstract	Decide whether weighted transparency can be used for this
+				frame.  The draw context must already be current.
+	@discussion	Weighted transparency needs OpenGL 3 framebuffer functions.
+				It is not used with a multisampled draw context, whose
+				depth buffer cannot be copied to the offscreen buffers.
+*/
+void	QORenderer::WeightedTransparency::StartFrame( bool inRequested )
+{
+	mEntries.clear();
+	mHasTargets = false;
+	mIsActive = false;
+	
+	if (inRequested && mIsSupported)
+	{
+		if (! mHaveFuncs)
+		{
+			mHaveFuncs = true;
+			mIsSupported = mFuncs.Initialize() &&
+				(mRenderer.mSLFuncs.glBindFragDataLocation != nullptr);
+		}
+		
+		GLint	numSamples = 0;
+		glGetIntegerv( GL_SAMPLES, &numSamples );
+		
+		mIsActive = mIsSupported && (numSamples == 0);
+	}
+}
+
+
+/*!
+	@function	AddTriMesh
+	@abstract	Queue a transparent TriMesh with the current state.
+	@discussion	The material colors are those that HandleGeometryAttributes
+				has just made current for this TriMesh.
+*/
+bool	QORenderer::WeightedTransparency::AddTriMesh(
+									TQ3GeometryObject _Nonnull inTriMesh )
+{
+	const TQ3Matrix4x4&	cameraToFrustum(
+		mRenderer.mMatrixState.GetCameraToFrustum() );
+	
+	if (mEntries.empty())
+	{
+		mCameraToFrustum = cameraToFrustum;
+	}
+	else if (std::memcmp( &mCameraToFrustum, &cameraToFrustum,
+		sizeof(TQ3Matrix4x4) ) != 0)
+	{
+		return false;
+	}
+	
+	mEntries.push_back( Entry() );
+	Entry&	theEntry( mEntries.back() );
+	
+	theEntry.mTriMesh = CQ3ObjectRef( Q3Shared_GetReference( inTriMesh ) );
+	theEntry.mSurfaceShader = mRenderer.mSurfaceShader;
+	theEntry.mLocalToCamera = mRenderer.mMatrixState.GetLocalToCamera();
+	theEntry.mDiffuseColor = *mRenderer.mGeomState.diffuseColor;
+	theEntry.mSpecularColor = mRenderer.mCurrentSpecularColor;
+	theEntry.mEmissiveColor = mRenderer.mCurrentEmissiveColor;
+	theEntry.mAlpha = mRenderer.mGeomState.alpha;
+	theEntry.mSpecularControl = mRenderer.mCurrentSpecularControl;
+	theEntry.mMetallic = mRenderer.mCurrentMetallic;
+	theEntry.mIlluminationType = mRenderer.mViewIllumination;
+	theEntry.mInterpolationStyle = mRenderer.mStyleState.mInterpolation;
+	theEntry.mBackfacingStyle = mRenderer.mStyleState.mBackfacing;
+	theEntry.mOrientationStyle = mRenderer.mStyleState.mOrientation;
+	theEntry.mFogStyleIndex = mRenderer.mStyleState.mCurFogStyleIndex;
+	
+	return true;
+}
+
+
+/*!
+	@function	UpdateTargets
+	@abstract	Make sure that the offscreen framebuffer exists with the
+				given size and depth format.
+	@result		True if the framebuffer is complete.
+*/
+bool	QORenderer::WeightedTransparency::UpdateTargets( GLint inWidth,
+														GLint inHeight,
+														GLenum inDepthFormat )
+{
+	if ( (mFramebuffer != 0) && (inWidth == mTargetWidth) &&
+		(inHeight == mTargetHeight) && (inDepthFormat == mDepthFormat) )
+	{
+		return true;
+	}
+	
+	// Start over, rather than trying to change the attachments in place.
+	if (mFramebuffer != 0)
+	{
+		mFuncs.glDeleteFramebuffers( 1, &mFramebuffer );
+		mFuncs.glDeleteRenderbuffers( 1, &mDepthRenderbuffer );
+		glDeleteTextures( 1, &mAccumTexture );
+		glDeleteTextures( 1, &mWeightTexture );
+		mFramebuffer = mDepthRenderbuffer = mAccumTexture = mWeightTexture = 0;
+	}
+	mTargetWidth = inWidth;
+	mTargetHeight = inHeight;
+	mDepthFormat = inDepthFormat;
+	
+	// The textures are set up on a unit that the Texture class does not use,
+	// so that its idea of the current texture stays right.
+	(*mRenderer.mFuncs.glActiveTexture)( kAccumTextureUnit );
+	
+	glGenTextures( 1, &mAccumTexture );
+	glBindTexture( GL_TEXTURE_2D, mAccumTexture );
+	glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST );
+	glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST );
+	glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE );
+	glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE );
+	glTexImage2D( GL_TEXTURE_2D, 0, GL_RGBA16F, inWidth, inHeight, 0,
+		GL_RGBA, GL_HALF_FLOAT, nullptr );
+	
+	glGenTextures( 1, &mWeightTexture );
+	glBindTexture( GL_TEXTURE_2D, mWeightTexture );
+	glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST );
+	glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST );
+	glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE );
+	glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE );
+	glTexImage2D( GL_TEXTURE_2D, 0, GL_R16F, inWidth, inHeight, 0,
+		GL_RED, GL_HALF_FLOAT, nullptr );
+	
+	glBindTexture( GL_TEXTURE_2D, 0 );
+	(*mRenderer.mFuncs.glActiveTexture)( GL_TEXTURE0 );
+	
+	mFuncs.glGenRenderbuffers( 1, &mDepthRenderbuffer );
+	mFuncs.glBindRenderbuffer( GL_RENDERBUFFER, mDepthRenderbuffer );
+	mFuncs.glRenderbufferStorage( GL_RENDERBUFFER, inDepthFormat, inWidth,
+		inHeight );
+	mFuncs.glBindRenderbuffer( GL_RENDERBUFFER, 0 );
+	
+	const bool	hasStencil = (inDepthFormat == GL_DEPTH24_STENCIL8) ||
+		(inDepthFormat == GL_DEPTH32F_STENCIL8);
+	
+	mFuncs.glGenFramebuffers( 1, &mFramebuffer );
+	mFuncs.glBindFramebuffer( GL_DRAW_FRAMEBUFFER, mFramebuffer );
+	mFuncs.glFramebufferTexture2D( GL_DRAW_FRAMEBUFFER, GL_COLOR_ATTACHMENT0,
+		GL_TEXTURE_2D, mAccumTexture, 0 );
+	mFuncs.glFramebufferTexture2D( GL_DRAW_FRAMEBUFFER, GL_COLOR_ATTACHMENT1,
+		GL_TEXTURE_2D, mWeightTexture, 0 );
+	mFuncs.glFramebufferRenderbuffer( GL_DRAW_FRAMEBUFFER,
+		hasStencil? GL_DEPTH_STENCIL_ATTACHMENT : GL_DEPTH_ATTACHMENT,
+		GL_RENDERBUFFER, mDepthRenderbuffer );
+	mFuncs.glDrawBuffers( 2, kDrawBuffers );	// part of framebuffer state
+	
+	return mFuncs.glCheckFramebufferStatus( GL_DRAW_FRAMEBUFFER ) ==
+		GL_FRAMEBUFFER_COMPLETE;
+}
+
+
+/*!
+	@function	PrepareTargets
+	@abstract	Set up the offscreen buffers for a frame, copying the depth of
+				the opaque geometry and clearing the color buffers.
+	@result		True if the offscreen buffers are ready.
+*/
+bool	QORenderer::WeightedTransparency::PrepareTargets()
+{
+	(void) glGetError();	// discard any previous unknown error
+	
+	glGetIntegerv( GL_VIEWPORT, mViewport );
+	GLint	sourceFramebuffer = 0;
+	glGetIntegerv( GL_DRAW_FRAMEBUFFER_BINDING, &sourceFramebuffer );
+	
+	GLenum	depthFormat = FindDepthFormat( mFuncs, sourceFramebuffer );
+	if ( (depthFormat == GL_NONE) || (mViewport[2] <= 0) || (mViewport[3] <= 0) )
+	{
+		return false;
+	}
+	
+	bool	isReady = UpdateTargets( mViewport[2], mViewport[3], depthFormat );
+	
+	if (isReady)
+	{
+		// UpdateTargets only binds the offscreen framebuffer when it
+		// creates it.
+		mFuncs.glBindFramebuffer( GL_DRAW_FRAMEBUFFER, mFramebuffer );
+		
+		// Blits and clears are limited by the scissor box, which is in
+		// the coordinates of the source framebuffer.
+		GLboolean	wasScissoring = glIsEnabled( GL_SCISSOR_TEST );
+		glDisable( GL_SCISSOR_TEST );
+		
+		mFuncs.glBindFramebuffer( GL_READ_FRAMEBUFFER, sourceFramebuffer );
+		mFuncs.glBlitFramebuffer( mViewport[0], mViewport[1],
+			mViewport[0] + mViewport[2], mViewport[1] + mViewport[3],
+			0, 0, mViewport[2], mViewport[3], GL_DEPTH_BUFFER_BIT, GL_NEAREST );
+		
+		glColorMask( GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE );
+		mFuncs.glClearBufferfv( GL_COLOR, 0, kClearAccum );
+		mFuncs.glClearBufferfv( GL_COLOR, 1, kClearWeight );
+		
+		if (wasScissoring)
+		{
+			glEnable( GL_SCISSOR_TEST );
+		}
+		
+		isReady = (glGetError() == GL_NO_ERROR);
+	}
+	
+	mFuncs.glBindFramebuffer( GL_FRAMEBUFFER, sourceFramebuffer );
+	
+	return isReady;
+}
+
+
+/*!
+	@function	Draw
+	@abstract	Draw the queued TriMeshes into the offscreen buffers.
+	@discussion	The first lighting pass accumulates the weighted color,
+				the weighted alpha, and the revealage, the product of
+				(1 - alpha) over all fragments.  Later lighting passes only
+				add their light to the weighted color.
+				
+				If the offscreen buffers cannot be set up, the TriMeshes are
+				blended directly into the frame in submission order, and
+				weighted transparency is not attempted again with this
+				OpenGL context.
+*/
+void	QORenderer::WeightedTransparency::Draw(
+									TQ3ViewObject _Nonnull inView,
+									bool inIsFirstLightPass )
+{
+	if (mEntries.empty())
+	{
+		return;
+	}
+	
+	if (inIsFirstLightPass)
+	{
+		mHasTargets = PrepareTargets();
+		if (! mHasTargets)
+		{
+			Q3_MESSAGE( "Weighted transparency is not available.\n" );
+			mIsSupported = false;
+		}
+	}
+	
+	GLint	savedFramebuffer = 0;
+	if (mHasTargets)
+	{
+		glGetIntegerv( GL_DRAW_FRAMEBUFFER_BINDING, &savedFramebuffer );
+		mFuncs.glBindFramebuffer( GL_DRAW_FRAMEBUFFER, mFramebuffer );
+		glViewport( 0, 0, mTargetWidth, mTargetHeight );
+		
+		if (inIsFirstLightPass)
+		{
+			glColorMask( GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE );
+		}
+		else
+		{
+			mFuncs.glColorMaski( 0, GL_TRUE, GL_TRUE, GL_TRUE, GL_FALSE );
+			mFuncs.glColorMaski( 1, GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE );
+		}
+		
+		// Colors and weights add up, while the alpha of the first target
+		// is multiplied by (1 - alpha).
+		mFuncs.glBlendFuncSeparate( GL_ONE, GL_ONE, GL_ZERO,
+			GL_ONE_MINUS_SRC_ALPHA );
+	}
+	else
+	{
+		glBlendFunc( GL_ONE, inIsFirstLightPass? GL_ONE_MINUS_SRC_ALPHA : GL_ONE );
+	}
+	glEnable( GL_BLEND );
+	glDepthMask( GL_FALSE );
+	
+	mRenderer.mPPLighting.SetWeightedBlending( mHasTargets );
+	mRenderer.mIsPremultiplyingFastPathColor = true;
+	
+	DrawEntries( inView, inIsFirstLightPass );
+	
+	mRenderer.mIsPremultiplyingFastPathColor = false;
+	mRenderer.mPPLighting.SetWeightedBlending( false );
+	
+	if (mHasTargets)
+	{
+		glColorMask( GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE );
+		mFuncs.glBindFramebuffer( GL_DRAW_FRAMEBUFFER, savedFramebuffer );
+		glViewport( mViewport[0], mViewport[1], mViewport[2], mViewport[3] );
+	}
+}
+
+
+/*!
+	@function	DrawEntries
+	@abstract	Draw each queued TriMesh with the state that was current when
+				it was queued, in submission order.
+	@discussion	The queued transforms are local to camera, so the camera
+				transform is replaced by one with only the projection.
+				Afterward the surface shader, materials and transforms that
+				were current are restored, as in RenderQueue::Flush.
+*/
+void	QORenderer::WeightedTransparency::DrawEntries(
+									TQ3ViewObject _Nonnull inView,
+									bool inIsFirstLightPass )
+{
+	TQ3CameraTransformData	cameraTransform;
+	Q3Matrix4x4_SetIdentity( &cameraTransform.localToWorld );
+	Q3Matrix4x4_SetIdentity( &cameraTransform.worldToCamera );
+	cameraTransform.cameraToFrustum = mCameraToFrustum;
+	Q3CameraTransform_Submit( &cameraTransform, inView );
+	
+	if (mRenderer.mStyleState.mFill != kQ3FillStyleFilled)
+	{
+		TQ3FillStyle	theFillStyle = kQ3FillStyleFilled;
+		mRenderer.UpdateFillStyle( &theFillStyle );
+	}
+	
+	// Remember the current state.
+	CQ3ObjectRef	liveShader( mRenderer.mSurfaceShader );
+	TQ3Matrix4x4	liveLocalToCamera( mRenderer.mMatrixState.GetLocalToCamera() );
+	ColorState		liveGeomState( mRenderer.mGeomState );
+	TQ3ColorRGB		liveSpecularColor( mRenderer.mCurrentSpecularColor );
+	TQ3ColorRGB		liveEmissiveColor( mRenderer.mCurrentEmissiveColor );
+	float			liveSpecularControl = mRenderer.mCurrentSpecularControl;
+	float			liveMetallic = mRenderer.mCurrentMetallic;
+	TQ3ObjectType	liveIllumination = mRenderer.mViewIllumination;
+	TQ3ShaderObject	currentShader = liveShader.get();
+	
+	mRenderer.mLights.SetLowDimensionalMode( false, mRenderer.mViewIllumination );
+	
+	for (const Entry& theEntry : mEntries)
+	{
+		// As with other geometry, NULL illumination contributes only to the
+		// first lighting pass.
+		if ( (! inIsFirstLightPass) &&
+			(theEntry.mIlluminationType == kQ3IlluminationTypeNULL) )
+		{
+			continue;
+		}
+		
+		if (theEntry.mFogStyleIndex != mRenderer.mStyleState.mCurFogStyleIndex)
+		{
+			mRenderer.UpdateFogStyle( inView,
+				&mRenderer.mStyleState.mFogStyles[ theEntry.mFogStyleIndex ] );
+		}
+		if (theEntry.mOrientationStyle != mRenderer.mStyleState.mOrientation)
+		{
+			mRenderer.UpdateOrientationStyle( &theEntry.mOrientationStyle );
+		}
+		if (theEntry.mBackfacingStyle != mRenderer.mStyleState.mBackfacing)
+		{
+			mRenderer.UpdateBackfacingStyle( &theEntry.mBackfacingStyle );
+		}
+		if (theEntry.mInterpolationStyle != mRenderer.mStyleState.mInterpolation)
+		{
+			mRenderer.UpdateInterpolationStyle( &theEntry.mInterpolationStyle );
+		}
+		if (theEntry.mIlluminationType != mRenderer.mViewIllumination)
+		{
+			mRenderer.mViewIllumination = theEntry.mIlluminationType;
+			mRenderer.mPPLighting.UpdateIllumination( theEntry.mIlluminationType );
+		}
+		
+		if (theEntry.mSurfaceShader.get() != currentShader)
+		{
+			currentShader = theEntry.mSurfaceShader.get();
+			mRenderer.ApplySurfaceShader( currentShader );
+		}
+		
+		mRenderer.SetSpecularColor( theEntry.mSpecularColor );
+		mRenderer.SetSpecularControl( theEntry.mSpecularControl );
+		mRenderer.SetMetallic( theEntry.mMetallic );
+		mRenderer.SetEmissiveMaterial( theEntry.mEmissiveColor );
+		mRenderer.mGeomState.diffuseColor = &theEntry.mDiffuseColor;
+		mRenderer.mGeomState.alpha = theEntry.mAlpha;
+		
+		mRenderer.mMatrixState.SetLocalToCamera( theEntry.mLocalToCamera );
+		GLCamera_SetModelView( &theEntry.mLocalToCamera, mRenderer.mPPLighting );
+		
+		// Changing the state may make the draw context current again, which
+		// binds its own framebuffer if it is an FBO, so bind the texture now
+		// and then bind the offscreen buffers again.
+		mRenderer.BindPendingTexture();
+		if (mHasTargets)
+		{
+			mFuncs.glBindFramebuffer( GL_DRAW_FRAMEBUFFER, mFramebuffer );
+			glViewport( 0, 0, mTargetWidth, mTargetHeight );
+		}
+		
+		mRenderer.RenderQueuedTriMesh( theEntry.mTriMesh.get() );
+	}
+	
+	// Restore the current state.
+	if (currentShader != liveShader.get())
+	{
+		mRenderer.ApplySurfaceShader( liveShader.get() );
+	}
+	if (liveIllumination != mRenderer.mViewIllumination)
+	{
+		mRenderer.mViewIllumination = liveIllumination;
+		mRenderer.mPPLighting.UpdateIllumination( liveIllumination );
+	}
+	mRenderer.SetSpecularColor( liveSpecularColor );
+	mRenderer.SetSpecularControl( liveSpecularControl );
+	mRenderer.SetMetallic( liveMetallic );
+	mRenderer.SetEmissiveMaterial( liveEmissiveColor );
+	mRenderer.mGeomState = liveGeomState;
+	mRenderer.mMatrixState.SetLocalToCamera( liveLocalToCamera );
+	GLCamera_SetModelView( &liveLocalToCamera, mRenderer.mPPLighting );
+}
+
+
+/*!
+	@function	InitCompositeProgram
+	@abstract	Create the program and vertex buffer used for compositing,
+				if they do not exist yet.
+	@result		True if they exist.
+*/
+bool	QORenderer::WeightedTransparency::InitCompositeProgram()
+{
+	const GLSLFuncs&	slFuncs( mRenderer.mSLFuncs );
+	
+	if (mProgram == 0)
+	{
+		GLuint	vertShader = CompileShader( GL_VERTEX_SHADER,
+			QOGLSLShader::kWeightedCompositeVertexShader, slFuncs );
+		GLuint	fragShader = CompileShader( GL_FRAGMENT_SHADER,
+			QOGLSLShader::kWeightedCompositeFragmentShader, slFuncs );
+		
+		if ( (vertShader != 0) && (fragShader != 0) )
+		{
+			GLuint	theProgram = slFuncs.glCreateProgram();
+			slFuncs.glAttachShader( theProgram, vertShader );
+			slFuncs.glAttachShader( theProgram, fragShader );
+			slFuncs.glBindAttribLocation( theProgram, 0, "quesaCorner" );
+			slFuncs.glBindFragDataLocation( theProgram, 0, "fragColor" );
+			slFuncs.glLinkProgram( theProgram );
+			
+			GLint	linkStatus = GL_FALSE;
+			slFuncs.glGetProgramiv( theProgram, GL_LINK_STATUS, &linkStatus );
+			if (linkStatus == GL_TRUE)
+			{
+				mProgram = theProgram;
+				
+				// The texture units never change, so set them once.
+				slFuncs.glUseProgram( mProgram );
+				slFuncs.glUniform1i( slFuncs.glGetUniformLocation( mProgram,
+					"accumTex" ), kAccumTextureUnit - GL_TEXTURE0 );
+				slFuncs.glUniform1i( slFuncs.glGetUniformLocation( mProgram,
+					"weightTex" ), kWeightTextureUnit - GL_TEXTURE0 );
+				mViewportOriginLoc = slFuncs.glGetUniformLocation( mProgram,
+					"viewportOrigin" );
+			}
+			else
+			{
+				Q3_MESSAGE( "Failed to link weighted transparency program.\n" );
+				slFuncs.glDeleteProgram( theProgram );
+			}
+		}
+		
+		// The program keeps the shaders for as long as it needs them.
+		if (vertShader != 0)
+		{
+			slFuncs.glDeleteShader( vertShader );
+		}
+		if (fragShader != 0)
+		{
+			slFuncs.glDeleteShader( fragShader );
+		}
+	}
+	
+	if ( (mProgram != 0) && (mCornerBuffer == 0) )
+	{
+		(*mRenderer.mFuncs.glGenBuffersProc)( 1, &mCornerBuffer );
+		(*mRenderer.mFuncs.glBindBufferProc)( GL_ARRAY_BUFFER, mCornerBuffer );
+		(*mRenderer.mFuncs.glBufferDataProc)( GL_ARRAY_BUFFER, sizeof(kCorners),
+			kCorners, GL_STATIC_DRAW );
+		(*mRenderer.mFuncs.glBindBufferProc)( GL_ARRAY_BUFFER, 0 );
+	}
+	
+	return mProgram != 0;
+}
+
+
+/*!
+	@function	Composite
+	@abstract	Blend the accumulated transparency over the frame, and
+				empty the queue.
+	@discussion	This leaves the composite program in use, so it must be
+				followed by PerPixelLighting::EndPass.
+*/
+void	QORenderer::WeightedTransparency::Composite()
+{
+	if (mHasTargets && (! mEntries.empty()) && InitCompositeProgram())
+	{
+		const GLSLFuncs&	slFuncs( mRenderer.mSLFuncs );
+		
+		slFuncs.glUseProgram( mProgram );
+		mRenderer.CountProgramSwitch();
+		const GLfloat	origin[2] = {
+			static_cast<GLfloat>( mViewport[0] ),
+			static_cast<GLfloat>( mViewport[1] )
+		};
+		slFuncs.glUniform2fv( mViewportOriginLoc, 1, origin );
+		
+		(*mRenderer.mFuncs.glActiveTexture)( kAccumTextureUnit );
+		glBindTexture( GL_TEXTURE_2D, mAccumTexture );
+		(*mRenderer.mFuncs.glActiveTexture)( kWeightTextureUnit );
+		glBindTexture( GL_TEXTURE_2D, mWeightTexture );
+		(*mRenderer.mFuncs.glActiveTexture)( GL_TEXTURE0 );
+		
+		GLboolean	wasDepthTesting = glIsEnabled( GL_DEPTH_TEST );
+		glDisable( GL_DEPTH_TEST );
+		glDepthMask( GL_FALSE );
+		glEnable( GL_BLEND );
+		glBlendFunc( GL_ONE_MINUS_SRC_ALPHA, GL_SRC_ALPHA );
+		
+		(*mRenderer.mFuncs.glBindBufferProc)( GL_ARRAY_BUFFER, mCornerBuffer );
+		slFuncs.glEnableVertexAttribArray( 0 );
+		slFuncs.glVertexAttribPointer( 0, 2, GL_FLOAT, GL_FALSE, 0, nullptr );
+		glDrawArrays( GL_TRIANGLES, 0, 3 );
+		mRenderer.CountDrawCall();
+		(*mRenderer.mFuncs.glBindBufferProc)( GL_ARRAY_BUFFER, 0 );
+		
+		if (wasDepthTesting)
+		{
+			glEnable( GL_DEPTH_TEST );
+		}
+	}
+	
+	mEntries.clear();
+	mHasTargets = false;
+}
@@ -0,0 +1,279 @@
+/*!
+	@header		QOWeightedTransparency.h
+	
+	Weighted, blended order-independent transparency for the Quesa OpenGL
+	renderer.
+*/
+
+/*  NAME:
+        QOWeightedTransparency.h
+
+    DESCRIPTION:
+        Header for Quesa OpenGL renderer class.
+
+    COPYRIGHT:
+        Copyright (c) 2026, Quesa Developers. All rights reserved.
+
+        For the current release of Quesa, please see:
+
+            <https://github.com/jwwalker/Quesa>
+        
+        Redistribution and use in source and binary forms, with or without
+        modification, are permitted provided that the following conditions
+        are met:
+        
+            o Redistributions of source code must retain the above copyright
+              notice, this list of conditions and the following disclaimer.
+        
+            o Redistributions in binary form must reproduce the above
+              copyright notice, this list of conditions and the following
+              disclaimer in the documentation and/or other materials provided
+              with the distribution.
+        
+            o Neither the name of Quesa nor the names of its contributors
+              may be used to endorse or promote products derived from this
+              software without specific prior written permission.
+        
+        THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+        "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+        LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+        A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+        OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+        SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+        TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+        PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+        LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+        NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+        SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+    ___________________________________________________________________________
+*/
+
+
+#ifndef QOWEIGHTEDTRANSPARENCY_HDR
+#define QOWEIGHTEDTRANSPARENCY_HDR
+
+//=============================================================================
+//      Include files
+//-----------------------------------------------------------------------------
+
+#include "QOPrefix.h"
+#include "QuesaStyle.h"
+#include "CQ3ObjectRef.h"
+
+#include <vector>
+
+
+//=============================================================================
+//      Function pointer types
+//-----------------------------------------------------------------------------
+
+typedef void (QO_PROCPTR_TYPE GenFramebuffersProcPtr) (GLsizei n, GLuint *framebuffers);
+typedef void (QO_PROCPTR_TYPE DeleteFramebuffersProcPtr) (GLsizei n, const GLuint *framebuffers);
+typedef void (QO_PROCPTR_TYPE BindFramebufferProcPtr) (GLenum target, GLuint framebuffer);
+typedef GLenum (QO_PROCPTR_TYPE CheckFramebufferStatusProcPtr) (GLenum target);
+typedef void (QO_PROCPTR_TYPE FramebufferTexture2DProcPtr) (GLenum target,
+							GLenum attachment, GLenum textarget, GLuint texture,
+							GLint level);
+typedef void (QO_PROCPTR_TYPE FramebufferRenderbufferProcPtr) (GLenum target,
+							GLenum attachment, GLenum renderbuffertarget,
+							GLuint renderbuffer);
+typedef void (QO_PROCPTR_TYPE GetFramebufferAttachmentParameterivProcPtr) (
+							GLenum target, GLenum attachment, GLenum pname,
+							GLint *params);
+typedef void (QO_PROCPTR_TYPE GenRenderbuffersProcPtr) (GLsizei n, GLuint *renderbuffers);
+typedef void (QO_PROCPTR_TYPE DeleteRenderbuffersProcPtr) (GLsizei n, const GLuint *renderbuffers);
+typedef void (QO_PROCPTR_TYPE BindRenderbufferProcPtr) (GLenum target, GLuint renderbuffer);
+typedef void (QO_PROCPTR_TYPE RenderbufferStorageProcPtr) (GLenum target,
+							GLenum internalformat, GLsizei width, GLsizei height);
+typedef void (QO_PROCPTR_TYPE BlitFramebufferProcPtr) (GLint srcX0, GLint srcY0,
+							GLint srcX1, GLint srcY1, GLint dstX0, GLint dstY0,
+							GLint dstX1, GLint dstY1, GLbitfield mask, GLenum filter);
+typedef void (QO_PROCPTR_TYPE DrawBuffersProcPtr) (GLsizei n, const GLenum *bufs);
+typedef void (QO_PROCPTR_TYPE ColorMaskiProcPtr) (GLuint index, GLboolean r,
+							GLboolean g, GLboolean b, GLboolean a);
+typedef void (QO_PROCPTR_TYPE BlendFuncSeparateProcPtr) (GLenum sfactorRGB,
+							GLenum dfactorRGB, GLenum sfactorAlpha, GLenum dfactorAlpha);
+typedef void (QO_PROCPTR_TYPE ClearBufferfvProcPtr) (GLenum buffer,
+							GLint drawbuffer, const GLfloat *value);
+
+
+//=============================================================================
+//      Class Declaration
+//-----------------------------------------------------------------------------
+
+namespace QORenderer
+{
+
+class Renderer;
+
+/*!
+	@struct		FramebufferFuncs
+	@abstract	Function pointers needed for weighted transparency, which are
+				not present in OpenGL 1.1.
+*/
+struct FramebufferFuncs
+{
+								FramebufferFuncs();
+
+	/*!
+		@function	Initialize
+		@abstract	Get the function pointers.
+		@result		True if all of the functions are available.
+	*/
+	bool						Initialize();
+
+	GenFramebuffersProcPtr						glGenFramebuffers;
+	DeleteFramebuffersProcPtr					glDeleteFramebuffers;
+	BindFramebufferProcPtr						glBindFramebuffer;
+	CheckFramebufferStatusProcPtr				glCheckFramebufferStatus;
+	FramebufferTexture2DProcPtr					glFramebufferTexture2D;
+	FramebufferRenderbufferProcPtr				glFramebufferRenderbuffer;
+	GetFramebufferAttachmentParameterivProcPtr	glGetFramebufferAttachmentParameteriv;
+	GenRenderbuffersProcPtr						glGenRenderbuffers;
+	DeleteRenderbuffersProcPtr					glDeleteRenderbuffers;
+	BindRenderbufferProcPtr						glBindRenderbuffer;
+	RenderbufferStorageProcPtr					glRenderbufferStorage;
+	BlitFramebufferProcPtr						glBlitFramebuffer;
+	DrawBuffersProcPtr							glDrawBuffers;
+	ColorMaskiProcPtr							glColorMaski;
+	BlendFuncSeparateProcPtr					glBlendFuncSeparate;
+	ClearBufferfvProcPtr						glClearBufferfv;
+};
+
+/*!
+	@class		WeightedTransparency
+	@abstract	Weighted, blended order-independent transparency.
+	@discussion	TriMeshes that are transparent only because of their material
+				alpha or texture are queued as they are submitted, and drawn
+				after the opaque geometry in submission order from their VBOs,
+				without being broken into sorted triangles.  Each fragment is
+				accumulated into offscreen color and weight buffers, which are
+				then composited over the frame.  The result approximates
+				sorted blending, and is exact where transparent surfaces do
+				not overlap.
+				
+				Everything else that is transparent still goes through
+				TransBuffer.
+*/
+class WeightedTransparency
+{
+public:
+							WeightedTransparency(
+									Renderer& inRenderer );
+							~WeightedTransparency();
+	
+	/*!
+		@function	StartFrame
+		@abstract	Decide whether weighted transparency can be used for this
+					frame.  The draw context must already be current.
+		@param		inRequested		Whether the client asked for weighted
+									transparency.
+	*/
+	void					StartFrame( bool inRequested );
+	
+	/*!
+		@function	IsActive
+		@abstract	Whether transparent TriMeshes should be queued here in
+					this frame.
+	*/
+	bool					IsActive() const { return mIsActive; }
+	
+	/*!
+		@function	HasContent
+		@abstract	Whether any TriMeshes are queued.
+	*/
+	bool					HasContent() const { return ! mEntries.empty(); }
+	
+	/*!
+		@function	AddTriMesh
+		@abstract	Queue a transparent TriMesh with the current state.
+		@discussion	All queued TriMeshes share one camera to frustum matrix.
+					If the current one differs from that of the queue, the
+					TriMesh is not queued.
+		@param		inTriMesh		A TriMesh object.
+		@result		True if the TriMesh was queued.
+	*/
+	bool					AddTriMesh(
+									TQ3GeometryObject _Nonnull inTriMesh );
+	
+	/*!
+		@function	Draw
+		@abstract	Draw the queued TriMeshes into the offscreen buffers.
+		@discussion	This should be called once in each transparency lighting
+					pass.  In the first pass, the offscreen buffers are set up
+					and the depth of the opaque geometry is copied to them.
+		@param		inView				The view being rendered.
+		@param		inIsFirstLightPass	Whether this is the first lighting
+										pass for transparency.
+	*/
+	void					Draw(
+									TQ3ViewObject _Nonnull inView,
+									bool inIsFirstLightPass );
+	
+	/*!
+		@function	Composite
+		@abstract	Blend the accumulated transparency over the frame, and
+					empty the queue.
+	*/
+	void					Composite();
+	
+	/*!
+		@function	Cleanup
+		@abstract	Delete OpenGL objects.  This should be called while the
+					OpenGL context is current, before it is destroyed.
+	*/
+	void					Cleanup();
+
+private:
+	struct Entry
+	{
+		CQ3ObjectRef		mTriMesh;
+		CQ3ObjectRef		mSurfaceShader;
+		TQ3Matrix4x4		mLocalToCamera;
+		TQ3ColorRGB			mDiffuseColor;
+		TQ3ColorRGB			mSpecularColor;
+		TQ3ColorRGB			mEmissiveColor;
+		float				mAlpha;
+		float				mSpecularControl;
+		float				mMetallic;
+		TQ3ObjectType		mIlluminationType;
+		TQ3InterpolationStyle	mInterpolationStyle;
+		TQ3BackfacingStyle	mBackfacingStyle;
+		TQ3OrientationStyle	mOrientationStyle;
+		TQ3Uns32			mFogStyleIndex;
+	};
+	
+	bool					PrepareTargets();
+	bool					UpdateTargets(
+									GLint inWidth,
+									GLint inHeight,
+									GLenum inDepthFormat );
+	bool					InitCompositeProgram();
+	void					DrawEntries(
+									TQ3ViewObject _Nonnull inView,
+									bool inIsFirstLightPass );
+	
+	Renderer&				mRenderer;
+	FramebufferFuncs		mFuncs;
+	std::vector<Entry>		mEntries;
+	TQ3Matrix4x4			mCameraToFrustum;
+	bool					mIsActive;
+	bool					mIsSupported;	// false once a failure is seen
+	bool					mHaveFuncs;
+	bool					mHasTargets;	// offscreen buffers are ready this frame
+	GLint					mViewport[4];
+	GLint					mTargetWidth;
+	GLint					mTargetHeight;
+	GLenum					mDepthFormat;
+	GLuint					mFramebuffer;
+	GLuint					mAccumTexture;
+	GLuint					mWeightTexture;
+	GLuint					mDepthRenderbuffer;
+	GLuint					mCornerBuffer;
+	GLuint					mProgram;
+	GLint					mViewportOriginLoc;
+};
+
+}
+
+#endif
@@ -0,0 +1,817 @@
+/*  NAME:
+        SWGeometry.cpp
+
+    DESCRIPTION:
+        Source for Quesa software renderer class.
+
+    COPYRIGHT:
+        Copyright (c) 2026, Quesa Developers. All rights reserved.
+
+        For the current release of Quesa, please see:
+
+            <https://github.com/jwwalker/Quesa>
+        
+        Redistribution and use in source and binary forms, with or without
+        modification, are permitted provided that the following conditions
+        are met:
+        
+            o Redistributions of source code must retain the above copyright
+              notice, this list of conditions and the following disclaimer.
+        
+            o Redistributions in binary form must reproduce the above
+              copyright notice, this list of conditions and the following
+              disclaimer in the documentation and/or other materials provided
+              with the distribution.
+        
+            o Neither the name of Quesa nor the names of its contributors
+              may be used to endorse or promote products derived from this
+              software without specific prior written permission.
+        
+        THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+        "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+        LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+        A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+        OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+        SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+        TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+        PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+        LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+        NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+        SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+    ___________________________________________________________________________
+*/
+//=============================================================================
+//      Include files
+//-----------------------------------------------------------------------------
+#include "SWRenderer.h"
+#include "E3Math.h"
+#include "E3Parallel.h"
+
+#include <algorithm>
+#include <cstring>
+
+
+
+//=============================================================================
+//      Local constants
+//-----------------------------------------------------------------------------
+namespace
+{
+	const float			kOneThird = 1.0f / 3.0f;
+	const TQ3ColorRGB	kWhiteColor = { 1.0f, 1.0f, 1.0f };
+	
+	// The clip space inside test is -w <= x <= w, -w <= y <= w, -w <= z <= 0.
+	const TQ3Uns32		kNumClipPlanes = 6;
+	
+	// Each clip plane can add at most one vertex to a convex polygon.
+	const TQ3Uns32		kMaxClippedVerts = 3 + kNumClipPlanes;
+	
+	// Meshes with fewer points than this are transformed on one thread.
+	const TQ3Uns32		kPointsPerTask = 2048;
+}
+
+
+
+//=============================================================================
+//      Local functions
+//-----------------------------------------------------------------------------
+
+/*!
+	@function	ClipDistance
+	@abstract	Signed distance of a clip space point from one of the clip
+				planes, nonnegative on the inside.
+*/
+static inline float ClipDistance( const TQ3RationalPoint4D& inPt, TQ3Uns32 inPlane )
+{
+	float	dist;
+	switch (inPlane)
+	{
+		case 0:		dist = inPt.w + inPt.x; break;	// left
+		case 1:		dist = inPt.w - inPt.x; break;	// right
+		case 2:		dist = inPt.w + inPt.y; break;	// bottom
+		case 3:		dist = inPt.w - inPt.y; break;	// top
+		case 4:		dist = - inPt.z; break;			// near
+		default:	dist = inPt.w + inPt.z; break;	// far
+	}
+	return dist;
+}
+
+/*!
+	@function	ClipCode
+	@abstract	Mask with a bit set for each clip plane that a point is
+				outside of.
+*/
+static inline TQ3Uns32 ClipCode( const TQ3RationalPoint4D& inPt )
+{
+	TQ3Uns32	theCode = 0;
+	for (TQ3Uns32 i = 0; i < kNumClipPlanes; ++i)
+	{
+		if (ClipDistance( inPt, i ) < 0.0f)
+		{
+			theCode |= (1U << i);
+		}
+	}
+	return theCode;
+}
+
+/*!
+	@function	SpecularControlToShininess
+	@abstract	Map Quesa specular control to a specular exponent, in the
+				same way as the OpenGL renderer.
+*/
+static float SpecularControlToShininess( float inSpecControl )
+{
+	if (inSpecControl < 0.0f)
+		inSpecControl = 0.0f;
+	
+	return 128.0f - (20.0f * 128.0f)/(inSpecControl + 20.0f);
+}
+
+/*!
+	@function	FindTriMeshAttribute
+	@abstract	Find the data of an attribute type in a TriMesh attribute
+				array, or nullptr.
+*/
+static const TQ3TriMeshAttributeData* FindTriMeshAttribute(
+								TQ3Uns32 inNumTypes,
+								const TQ3TriMeshAttributeData* inAtts,
+								TQ3AttributeType inType )
+{
+	const TQ3TriMeshAttributeData*	theData = nullptr;
+	
+	for (TQ3Uns32 i = 0; i < inNumTypes; ++i)
+	{
+		if ( (inAtts[i].attributeType == inType) &&
+			(inAtts[i].data != nullptr) )
+		{
+			theData = &inAtts[i];
+			break;
+		}
+	}
+	return theData;
+}
+
+/*!
+	@function	IsAttributeUsed
+	@abstract	Whether an entry of a TriMesh attribute array is in use.
+*/
+static inline bool IsAttributeUsed( const TQ3TriMeshAttributeData* inAtt,
+									TQ3Uns32 inIndex )
+{
+	return (inAtt != nullptr) &&
+		( (inAtt->attributeUseArray == nullptr) ||
+		(inAtt->attributeUseArray[ inIndex ] != 0) );
+}
+
+static inline float AverageColor( const TQ3ColorRGB& inColor )
+{
+	return (inColor.r + inColor.g + inColor.b) * kOneThird;
+}
+
+
+
+//=============================================================================
+//      Class methods
+//-----------------------------------------------------------------------------
+
+/*!
+	@function	AdjustGeomState
+	@abstract	Update the geometry state with data from an attribute set.
+*/
+void	SWRenderer::Renderer::AdjustGeomState( TQ3AttributeSet inAttSet )
+{
+	TQ3XAttributeMask	attMask = Q3XAttributeSet_GetMask( inAttSet );
+	
+	if ( (attMask & kQ3XAttributeMaskDiffuseColor) != 0 )
+	{
+		mGeomState.diffuseColor = * (const TQ3ColorRGB*) 
+			Q3XAttributeSet_GetPointer( inAttSet,
+				kQ3AttributeTypeDiffuseColor );
+	}
+
+	if ( (attMask & kQ3XAttributeMaskSpecularColor) != 0 )
+	{
+		mGeomState.specularColor = * (const TQ3ColorRGB*) 
+			Q3XAttributeSet_GetPointer( inAttSet,
+				kQ3AttributeTypeSpecularColor );
+	}
+	
+	if ( (attMask & kQ3XAttributeMaskTransparencyColor) != 0 )
+	{
+		mGeomState.alpha = AverageColor( * (const TQ3ColorRGB*)
+			Q3XAttributeSet_GetPointer( inAttSet,
+				kQ3AttributeTypeTransparencyColor ) );
+	}
+	
+	if ( (attMask & kQ3XAttributeMaskEmissiveColor) != 0 )
+	{
+		mGeomState.emissiveColor = * (const TQ3ColorRGB*) 
+			Q3XAttributeSet_GetPointer( inAttSet,
+				kQ3AttributeTypeEmissiveColor );
+	}
+	
+	if ( (attMask & kQ3XAttributeMaskSpecularControl) != 0 )
+	{
+		mGeomState.specularControl = * (const float *)
+			Q3XAttributeSet_GetPointer( inAttSet,
+				kQ3AttributeTypeSpecularControl );
+	}
+	
+	if ( (attMask & kQ3XAttributeMaskMetallic) != 0 )
+	{
+		mGeomState.metallic = * (const float *)
+			Q3XAttributeSet_GetPointer( inAttSet,
+				kQ3AttributeTypeMetallic );
+	}
+	
+	if ( (attMask & kQ3XAttributeMaskSurfaceShader) != 0 )
+	{
+		const TQ3ShaderObject*	theShader = (const TQ3ShaderObject*)
+			Q3XAttributeSet_GetPointer( inAttSet,
+				kQ3AttributeTypeSurfaceShader );
+		SetTextureState( *theShader, mGeomTexture );
+	}
+}
+
+/*!
+	@function	HandleGeometryAttributes
+	@abstract	Set the geometry state from the view state, the attribute set
+				of the geometry, and the highlight style attribute set when
+				the geometry is highlighted.
+*/
+void	SWRenderer::Renderer::HandleGeometryAttributes(
+								TQ3AttributeSet inGeomAttSet )
+{
+	mGeomState = mViewState;
+	mGeomTexture = mViewTexture;
+	
+	TQ3Switch	highlightSwitch = mGeomState.highlightState;
+	if (inGeomAttSet != nullptr)
+	{
+		if ( (Q3XAttributeSet_GetMask( inGeomAttSet ) &
+			kQ3XAttributeMaskHighlightState) != 0 )
+		{
+			highlightSwitch = * (const TQ3Switch*) Q3XAttributeSet_GetPointer(
+				inGeomAttSet, kQ3AttributeTypeHighlightState );
+		}
+		
+		AdjustGeomState( inGeomAttSet );
+	}
+	
+	if ( mStyleState.mHilite.isvalid() && (kQ3On == highlightSwitch) )
+	{
+		TQ3AttributeSet		hiliteAtts = mStyleState.mHilite.get();
+		TQ3XAttributeMask	hiliteMask = Q3XAttributeSet_GetMask( hiliteAtts );
+		
+		// A highlight color without a texture overrides any texture.
+		if ( ((hiliteMask & kQ3XAttributeMaskDiffuseColor) != 0) &&
+			((hiliteMask & kQ3XAttributeMaskSurfaceShader) == 0) )
+		{
+			mGeomTexture.Reset();
+		}
+		
+		AdjustGeomState( hiliteAtts );
+	}
+}
+
+/*!
+	@function	AddGeomMaterial
+	@abstract	Give the rasterizer the material of the current geometry.
+*/
+TQ3Uns32	SWRenderer::Renderer::AddGeomMaterial( bool inIsTextured )
+{
+	Material	theMaterial;
+	
+	theMaterial.texture = inIsTextured? mGeomTexture.texture : nullptr;
+	theMaterial.wrapU = mGeomTexture.wrapU;
+	theMaterial.wrapV = mGeomTexture.wrapV;
+	theMaterial.alphaTestThreshold = inIsTextured?
+		mGeomTexture.alphaTestThreshold : 0.0f;
+	theMaterial.specularColor = mGeomState.specularColor;
+	theMaterial.shininess = SpecularControlToShininess( mGeomState.specularControl );
+	theMaterial.metallic = mGeomState.metallic;
+	theMaterial.illumination = mViewIllumination;
+	theMaterial.isPixelLit = (mStyleState.mInterpolation == kQ3InterpolationStylePixel) &&
+		(mViewIllumination != kQ3IlluminationTypeNULL);
+	
+	return mRasterizer.AddMaterial( theMaterial );
+}
+
+/*!
+	@function	TransformVertex
+	@abstract	Transform a point to camera and clip space, and give it the
+				colors of the geometry.
+	@discussion	This may be called from worker threads, so it uses the E3
+				math functions, which skip the system bottleneck.
+*/
+void	SWRenderer::Renderer::TransformVertex(
+								const TQ3Point3D& inPoint,
+								InputVertex& outVertex ) const
+{
+	TQ3RationalPoint4D	thePoint( Q3ToRational4D( inPoint ) );
+	E3RationalPoint4D_Transform( &thePoint, &mLocalToFrustum, &outVertex.clip );
+	E3Point3D_Transform( &inPoint, &mLocalToCamera, &outVertex.position );
+	outVertex.normal.x = outVertex.normal.y = outVertex.normal.z = 0.0f;
+	outVertex.diffuse = mGeomState.diffuseColor;
+	outVertex.emissive = mGeomState.emissiveColor;
+	outVertex.alpha = mGeomState.alpha;
+	outVertex.uv.u = outVertex.uv.v = 0.0f;
+}
+
+void	SWRenderer::Renderer::TransformNormal(
+								const TQ3Vector3D& inNormal,
+								InputVertex& ioVertex ) const
+{
+	TQ3Vector3D	theNormal;
+	E3Vector3D_Transform( &inNormal, &mNormalMatrix, &theNormal );
+	ioVertex.normal = Q3Normalize3D( theNormal );
+}
+
+/*!
+	@function	ApplyVertexAttributes
+	@abstract	Override the attributes of a vertex with those of its
+				attribute set.
+*/
+void	SWRenderer::Renderer::ApplyVertexAttributes(
+								TQ3AttributeSet inAtts,
+								InputVertex& ioVertex,
+								bool& outHasNormal,
+								bool& outHasUV ) const
+{
+	TQ3XAttributeMask	attMask = Q3XAttributeSet_GetMask( inAtts );
+	
+	outHasNormal = (attMask & kQ3XAttributeMaskNormal) != 0;
+	if (outHasNormal)
+	{
+		TransformNormal( * (const TQ3Vector3D*) Q3XAttributeSet_GetPointer(
+			inAtts, kQ3AttributeTypeNormal ), ioVertex );
+	}
+	
+	outHasUV = true;
+	if ( (attMask & kQ3XAttributeMaskSurfaceUV) != 0 )
+	{
+		ioVertex.uv = * (const TQ3Param2D*) Q3XAttributeSet_GetPointer(
+			inAtts, kQ3AttributeTypeSurfaceUV );
+	}
+	else if ( (attMask & kQ3XAttributeMaskShadingUV) != 0 )
+	{
+		ioVertex.uv = * (const TQ3Param2D*) Q3XAttributeSet_GetPointer(
+			inAtts, kQ3AttributeTypeShadingUV );
+	}
+	else
+	{
+		outHasUV = false;
+	}
+	
+	if ( (attMask & kQ3XAttributeMaskDiffuseColor) != 0 )
+	{
+		ioVertex.diffuse = * (const TQ3ColorRGB*) Q3XAttributeSet_GetPointer(
+			inAtts, kQ3AttributeTypeDiffuseColor );
+	}
+	
+	if ( (attMask & kQ3XAttributeMaskTransparencyColor) != 0 )
+	{
+		ioVertex.alpha = AverageColor( * (const TQ3ColorRGB*)
+			Q3XAttributeSet_GetPointer( inAtts,
+				kQ3AttributeTypeTransparencyColor ) );
+	}
+	
+	if ( (attMask & kQ3XAttributeMaskEmissiveColor) != 0 )
+	{
+		ioVertex.emissive = * (const TQ3ColorRGB*) Q3XAttributeSet_GetPointer(
+			inAtts, kQ3AttributeTypeEmissiveColor );
+	}
+}
+
+/*!
+	@function	ShadeVertex
+	@abstract	Compute the varyings of a vertex.
+	@discussion	Unless the material is lit per pixel, the vertex is lit
+				here and the rasterizer only has to interpolate the colors
+				and modulate them by the texture.
+*/
+void	SWRenderer::Renderer::ShadeVertex(
+								const InputVertex& inVertex,
+								bool inIsTextured,
+								ClipVertex& outVertex ) const
+{
+	outVertex.clip = inVertex.clip;
+	float*	v = outVertex.varying;
+	std::memset( v, 0, sizeof(outVertex.varying) );
+	
+	// A texture replaces the diffuse color, unless lighting is off
+	const TQ3ColorRGB&	kd( (inIsTextured && (mViewIllumination != kQ3IlluminationTypeNULL))?
+		kWhiteColor : inVertex.diffuse );
+	const TQ3ColorRGB&	ks( mGeomState.specularColor );
+	const TQ3ColorRGB&	emissive( inVertex.emissive );
+	
+	if (mViewIllumination == kQ3IlluminationTypeNULL)
+	{
+		v[ kVaryingColor + 0 ] = kd.r + emissive.r;
+		v[ kVaryingColor + 1 ] = kd.g + emissive.g;
+		v[ kVaryingColor + 2 ] = kd.b + emissive.b;
+	}
+	else if (mStyleState.mInterpolation == kQ3InterpolationStylePixel)
+	{
+		v[ kVaryingColor + 0 ] = kd.r;
+		v[ kVaryingColor + 1 ] = kd.g;
+		v[ kVaryingColor + 2 ] = kd.b;
+		v[ kVaryingSpecular + 0 ] = emissive.r;
+		v[ kVaryingSpecular + 1 ] = emissive.g;
+		v[ kVaryingSpecular + 2 ] = emissive.b;
+		v[ kVaryingNormal + 0 ] = inVertex.normal.x;
+		v[ kVaryingNormal + 1 ] = inVertex.normal.y;
+		v[ kVaryingNormal + 2 ] = inVertex.normal.z;
+		v[ kVaryingPosition + 0 ] = inVertex.position.x;
+		v[ kVaryingPosition + 1 ] = inVertex.position.y;
+		v[ kVaryingPosition + 2 ] = inVertex.position.z;
+	}
+	else
+	{
+		TQ3ColorRGB	diffuse, specular;
+		mLights.Shade( inVertex.position, inVertex.normal, mViewIllumination,
+			SpecularControlToShininess( mGeomState.specularControl ),
+			diffuse, specular );
+		
+		const TQ3ColorRGB&	ambient( mLights.GetAmbient() );
+		float	matte = 1.0f - mGeomState.metallic;
+		float	metal = mGeomState.metallic;
+		
+		v[ kVaryingColor + 0 ] = (ambient.r + diffuse.r) * matte * kd.r + emissive.r;
+		v[ kVaryingColor + 1 ] = (ambient.g + diffuse.g) * matte * kd.g + emissive.g;
+		v[ kVaryingColor + 2 ] = (ambient.b + diffuse.b) * matte * kd.b + emissive.b;
+		v[ kVaryingSpecular + 0 ] = (specular.r + metal * ambient.r) * ks.r;
+		v[ kVaryingSpecular + 1 ] = (specular.g + metal * ambient.g) * ks.g;
+		v[ kVaryingSpecular + 2 ] = (specular.b + metal * ambient.b) * ks.b;
+	}
+	
+	v[ kVaryingAlpha ] = inVertex.alpha;
+	
+	if (inIsTextured)
+	{
+		const TQ3Matrix3x3&	m( mGeomTexture.uvTransform );
+		v[ kVaryingU ] = inVertex.uv.u * m.value[0][0] +
+			inVertex.uv.v * m.value[1][0] + m.value[2][0];
+		v[ kVaryingV ] = inVertex.uv.u * m.value[0][1] +
+			inVertex.uv.v * m.value[1][1] + m.value[2][1];
+	}
+}
+
+/*!
+	@function	ClipPolygon
+	@abstract	Clip a convex polygon against the clip planes for which the
+				corresponding bits of inClipCodes are set.
+	@param		inClipCodes		Union of the clip codes of the vertices.
+	@param		ioPoly			Vertices, with room for kMaxClippedVerts.
+	@param		inNumVerts		Number of vertices.
+	@param		inScratch		Room for kMaxClippedVerts vertices.
+	@result		Number of vertices of the clipped polygon.
+*/
+TQ3Uns32	SWRenderer::Renderer::ClipPolygon(
+								TQ3Uns32 inClipCodes,
+								ClipVertex* ioPoly,
+								TQ3Uns32 inNumVerts,
+								ClipVertex* inScratch ) const
+{
+	ClipVertex*	src = ioPoly;
+	ClipVertex*	dst = inScratch;
+	TQ3Uns32	numVerts = inNumVerts;
+	
+	for (TQ3Uns32 plane = 0; (plane < kNumClipPlanes) && (numVerts >= 3); ++plane)
+	{
+		if ( (inClipCodes & (1U << plane)) == 0 )
+		{
+			continue;
+		}
+		
+		TQ3Uns32	outCount = 0;
+		for (TQ3Uns32 i = 0; i < numVerts; ++i)
+		{
+			const ClipVertex&	a( src[i] );
+			const ClipVertex&	b( src[ (i + 1) % numVerts ] );
+			float	distA = ClipDistance( a.clip, plane );
+			float	distB = ClipDistance( b.clip, plane );
+			
+			if (distA >= 0.0f)
+			{
+				dst[ outCount++ ] = a;
+			}
+			
+			if ( (distA >= 0.0f) != (distB >= 0.0f) )
+			{
+				float		t = distA / (distA - distB);
+				ClipVertex&	c( dst[ outCount++ ] );
+				c.clip.x = a.clip.x + t * (b.clip.x - a.clip.x);
+				c.clip.y = a.clip.y + t * (b.clip.y - a.clip.y);
+				c.clip.z = a.clip.z + t * (b.clip.z - a.clip.z);
+				c.clip.w = a.clip.w + t * (b.clip.w - a.clip.w);
+				for (int j = 0; j < kNumVaryings; ++j)
+				{
+					c.varying[j] = a.varying[j] + t * (b.varying[j] - a.varying[j]);
+				}
+			}
+		}
+		
+		std::swap( src, dst );
+		numVerts = outCount;
+	}
+	
+	if (src != ioPoly)
+	{
+		std::copy( src, src + numVerts, ioPoly );
+	}
+	
+	return numVerts;
+}
+
+/*!
+	@function	ProjectVertex
+	@abstract	Map a vertex from clip space to pixels of the pane.
+*/
+void	SWRenderer::Renderer::ProjectVertex(
+								const ClipVertex& inVertex,
+								RasterVertex& outVertex ) const
+{
+	float	oneOverW = 1.0f / inVertex.clip.w;
+	
+	outVertex.x = (inVertex.clip.x * oneOverW + 1.0f) * 0.5f * mPaneWidth;
+	outVertex.y = (1.0f - inVertex.clip.y * oneOverW) * 0.5f * mPaneHeight;
+	outVertex.depth = - inVertex.clip.z * oneOverW;
+	outVertex.oneOverW = oneOverW;
+	std::copy( inVertex.varying, inVertex.varying + kNumVaryings,
+		outVertex.varying );
+}
+
+/*!
+	@function	DrawTriangle
+	@abstract	Cull, light, clip and project a triangle, and queue it in
+				the rasterizer.
+	@param		ioVerts				The 3 vertices.  Their normals may be
+									changed.
+	@param		inHasVertexNormals	Whether every vertex has a normal.
+	@param		inIsTextured		Whether the texture of the geometry
+									state applies.
+	@param		inMaterial			Material index from AddGeomMaterial.
+*/
+void	SWRenderer::Renderer::DrawTriangle(
+								InputVertex* ioVerts,
+								bool inHasVertexNormals,
+								bool inIsTextured,
+								TQ3Uns32 inMaterial )
+{
+	// Reject triangles that are entirely outside one clip plane
+	TQ3Uns32	code0 = ClipCode( ioVerts[0].clip );
+	TQ3Uns32	code1 = ClipCode( ioVerts[1].clip );
+	TQ3Uns32	code2 = ClipCode( ioVerts[2].clip );
+	if ( (code0 & code1 & code2) != 0 )
+	{
+		return;
+	}
+	
+	
+	// Decide which way the triangle faces
+	TQ3Vector3D	faceNormal = Q3Cross3D( ioVerts[1].position - ioVerts[0].position,
+		ioVerts[2].position - ioVerts[0].position );
+	if (mStyleState.mOrientation == kQ3OrientationStyleClockwise)
+	{
+		faceNormal = - faceNormal;
+	}
+	TQ3Vector3D	toEye = { 0.0f, 0.0f, 1.0f };
+	if (mIsLocalViewer)
+	{
+		toEye.x = - ioVerts[0].position.x;
+		toEye.y = - ioVerts[0].position.y;
+		toEye.z = - ioVerts[0].position.z;
+	}
+	float	facing = Q3Dot3D( faceNormal, toEye );
+	if (facing == 0.0f)
+	{
+		return;		// edge on, or degenerate
+	}
+	bool	isFlipped = false;
+	if (facing < 0.0f)
+	{
+		if (mStyleState.mBackfacing == kQ3BackfacingStyleRemove)
+		{
+			return;
+		}
+		isFlipped = (mStyleState.mBackfacing == kQ3BackfacingStyleFlip);
+	}
+	
+	
+	// Choose the normals
+	if ( (! inHasVertexNormals) ||
+		(mStyleState.mInterpolation == kQ3InterpolationStyleNone) )
+	{
+		TQ3Vector3D	theNormal = Q3Normalize3D( isFlipped? - faceNormal : faceNormal );
+		ioVerts[0].normal = ioVerts[1].normal = ioVerts[2].normal = theNormal;
+	}
+	else if (isFlipped)
+	{
+		for (int i = 0; i < 3; ++i)
+		{
+			ioVerts[i].normal = - ioVerts[i].normal;
+		}
+	}
+	
+	
+	// Light the vertices, then clip
+	ClipVertex	poly[ kMaxClippedVerts ];
+	ClipVertex	scratch[ kMaxClippedVerts ];
+	for (int i = 0; i < 3; ++i)
+	{
+		ShadeVertex( ioVerts[i], inIsTextured, poly[i] );
+	}
+	TQ3Uns32	numVerts = 3;
+	TQ3Uns32	clipCodes = code0 | code1 | code2;
+	if (clipCodes != 0)
+	{
+		numVerts = ClipPolygon( clipCodes, poly, numVerts, scratch );
+	}
+	
+	
+	// Decide whether the triangle needs blending
+	bool	isTransparent = (ioVerts[0].alpha < kAlphaThreshold) ||
+		(ioVerts[1].alpha < kAlphaThreshold) ||
+		(ioVerts[2].alpha < kAlphaThreshold);
+	if ( inIsTextured && mGeomTexture.texture->HasAlpha() &&
+		(mGeomTexture.alphaTestThreshold <= 0.0f) )
+	{
+		isTransparent = true;
+	}
+	
+	
+	// Project and queue the triangles of the clipped polygon
+	RasterVertex	rasterVerts[ kMaxClippedVerts ];
+	for (TQ3Uns32 i = 0; i < numVerts; ++i)
+	{
+		if (poly[i].clip.w <= 0.0f)
+		{
+			return;
+		}
+		ProjectVertex( poly[i], rasterVerts[i] );
+	}
+	for (TQ3Uns32 i = 2; i < numVerts; ++i)
+	{
+		mRasterizer.AddTriangle( rasterVerts[0], rasterVerts[i - 1],
+			rasterVerts[i], inMaterial, isTransparent );
+	}
+}
+
+void	SWRenderer::Renderer::SubmitTriangle(
+								const TQ3TriangleData* inGeomData )
+{
+	HandleGeometryAttributes( inGeomData->triangleAttributeSet );
+	
+	InputVertex	theVerts[3];
+	bool		hasNormals = true;
+	bool		hasUVs = true;
+	for (int i = 0; i < 3; ++i)
+	{
+		const TQ3Vertex3D&	theVertex( inGeomData->vertices[i] );
+		TransformVertex( theVertex.point, theVerts[i] );
+		
+		bool	hasNormal = false;
+		bool	hasUV = false;
+		if (theVertex.attributeSet != nullptr)
+		{
+			ApplyVertexAttributes( theVertex.attributeSet, theVerts[i],
+				hasNormal, hasUV );
+		}
+		hasNormals = hasNormals && hasNormal;
+		hasUVs = hasUVs && hasUV;
+	}
+	
+	bool		isTextured = hasUVs && (mGeomTexture.texture != nullptr);
+	TQ3Uns32	theMaterial = AddGeomMaterial( isTextured );
+	
+	DrawTriangle( theVerts, hasNormals, isTextured, theMaterial );
+}
+
+/*!
+	@function	SubmitTriMesh
+	@abstract	Draw a TriMesh.
+	@discussion	Each point is transformed once, in parallel for large
+				meshes, before the triangles are drawn.  Vertex colors take
+				precedence over face colors.  Face surface shaders are not
+				supported.
+*/
+void	SWRenderer::Renderer::SubmitTriMesh(
+								const TQ3TriMeshData* inGeomData )
+{
+	HandleGeometryAttributes( inGeomData->triMeshAttributeSet );
+	
+	// Find the attribute arrays
+	const TQ3TriMeshAttributeData*	vertNormals = FindTriMeshAttribute(
+		inGeomData->numVertexAttributeTypes, inGeomData->vertexAttributeTypes,
+		kQ3AttributeTypeNormal );
+	const TQ3TriMeshAttributeData*	vertUVs = FindTriMeshAttribute(
+		inGeomData->numVertexAttributeTypes, inGeomData->vertexAttributeTypes,
+		kQ3AttributeTypeSurfaceUV );
+	if (vertUVs == nullptr)
+	{
+		vertUVs = FindTriMeshAttribute(
+			inGeomData->numVertexAttributeTypes, inGeomData->vertexAttributeTypes,
+			kQ3AttributeTypeShadingUV );
+	}
+	const TQ3TriMeshAttributeData*	vertDiffuse = FindTriMeshAttribute(
+		inGeomData->numVertexAttributeTypes, inGeomData->vertexAttributeTypes,
+		kQ3AttributeTypeDiffuseColor );
+	const TQ3TriMeshAttributeData*	vertTransparency = FindTriMeshAttribute(
+		inGeomData->numVertexAttributeTypes, inGeomData->vertexAttributeTypes,
+		kQ3AttributeTypeTransparencyColor );
+	const TQ3TriMeshAttributeData*	vertEmissive = FindTriMeshAttribute(
+		inGeomData->numVertexAttributeTypes, inGeomData->vertexAttributeTypes,
+		kQ3AttributeTypeEmissiveColor );
+	const TQ3TriMeshAttributeData*	faceDiffuse = FindTriMeshAttribute(
+		inGeomData->numTriangleAttributeTypes, inGeomData->triangleAttributeTypes,
+		kQ3AttributeTypeDiffuseColor );
+	const TQ3TriMeshAttributeData*	faceTransparency = FindTriMeshAttribute(
+		inGeomData->numTriangleAttributeTypes, inGeomData->triangleAttributeTypes,
+		kQ3AttributeTypeTransparencyColor );
+	const TQ3TriMeshAttributeData*	faceEmissive = FindTriMeshAttribute(
+		inGeomData->numTriangleAttributeTypes, inGeomData->triangleAttributeTypes,
+		kQ3AttributeTypeEmissiveColor );
+	
+	bool		hasNormals = (vertNormals != nullptr);
+	bool		isTextured = (vertUVs != nullptr) && (mGeomTexture.texture != nullptr);
+	TQ3Uns32	theMaterial = AddGeomMaterial( isTextured );
+	
+	
+	// Transform the points.  This only touches plain data, so it may be
+	// split across threads.
+	const TQ3Uns32	numPoints = inGeomData->numPoints;
+	mMeshVertices.resize( numPoints );
+	InputVertex*	meshVerts = mMeshVertices.data();
+	
+	E3Parallel_For( numPoints, kPointsPerTask,
+		[&]( TQ3Uns32 inStart, TQ3Uns32 inEnd )
+		{
+			for (TQ3Uns32 i = inStart; i < inEnd; ++i)
+			{
+				InputVertex&	theVert( meshVerts[i] );
+				TransformVertex( inGeomData->points[i], theVert );
+				
+				if (vertNormals != nullptr)
+				{
+					TransformNormal( static_cast<const TQ3Vector3D*>(
+						vertNormals->data )[i], theVert );
+				}
+				if (vertUVs != nullptr)
+				{
+					theVert.uv = static_cast<const TQ3Param2D*>( vertUVs->data )[i];
+				}
+				if (IsAttributeUsed( vertDiffuse, i ))
+				{
+					theVert.diffuse = static_cast<const TQ3ColorRGB*>(
+						vertDiffuse->data )[i];
+				}
+				if (IsAttributeUsed( vertTransparency, i ))
+				{
+					theVert.alpha = AverageColor( static_cast<const TQ3ColorRGB*>(
+						vertTransparency->data )[i] );
+				}
+				if (IsAttributeUsed( vertEmissive, i ))
+				{
+					theVert.emissive = static_cast<const TQ3ColorRGB*>(
+						vertEmissive->data )[i];
+				}
+			}
+		} );
+	
+	
+	// Draw the triangles
+	for (TQ3Uns32 t = 0; t < inGeomData->numTriangles; ++t)
+	{
+		const TQ3Uns32*	indices = inGeomData->triangles[t].pointIndices;
+		InputVertex		theVerts[3] = {
+			meshVerts[ indices[0] ],
+			meshVerts[ indices[1] ],
+			meshVerts[ indices[2] ]
+		};
+		
+		for (int k = 0; k < 3; ++k)
+		{
+			if ( IsAttributeUsed( faceDiffuse, t ) &&
+				! IsAttributeUsed( vertDiffuse, indices[k] ) )
+			{
+				theVerts[k].diffuse = static_cast<const TQ3ColorRGB*>(
+					faceDiffuse->data )[t];
+			}
+			if ( IsAttributeUsed( faceTransparency, t ) &&
+				! IsAttributeUsed( vertTransparency, indices[k] ) )
+			{
+				theVerts[k].alpha = AverageColor( static_cast<const TQ3ColorRGB*>(
+					faceTransparency->data )[t] );
+			}
+			if ( IsAttributeUsed( faceEmissive, t ) &&
+				! IsAttributeUsed( vertEmissive, indices[k] ) )
+			{
+				theVerts[k].emissive = static_cast<const TQ3ColorRGB*>(
+					faceEmissive->data )[t];
+			}
+		}
+		
+		DrawTriangle( theVerts, hasNormals, isTextured, theMaterial );
+	}
+}
@@ -0,0 +1,301 @@
+/*  NAME:
+        SWLights.cpp
+
+    DESCRIPTION:
+        Source for lighting in the Quesa software renderer.
+
+    COPYRIGHT:
+        Copyright (c) 2026, Quesa Developers. All rights reserved.
+
+        For the current release of Quesa, please see:
+
+            <https://github.com/jwwalker/Quesa>
+        
+        Redistribution and use in source and binary forms, with or without
+        modification, are permitted provided that the following conditions
+        are met:
+        
+            o Redistributions of source code must retain the above copyright
+              notice, this list of conditions and the following disclaimer.
+        
+            o Redistributions in binary form must reproduce the above
+              copyright notice, this list of conditions and the following
+              disclaimer in the documentation and/or other materials provided
+              with the distribution.
+        
+            o Neither the name of Quesa nor the names of its contributors
+              may be used to endorse or promote products derived from this
+              software without specific prior written permission.
+        
+        THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+        "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+        LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+        A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+        OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+        SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+        TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+        PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+        LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+        NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+        SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+    ___________________________________________________________________________
+*/
+//=============================================================================
+//      Include files
+//-----------------------------------------------------------------------------
+#include "SWLights.h"
+
+#include "QuesaCamera.h"
+#include "QuesaLight.h"
+#include "Q3GroupIterator.h"
+
+#include <algorithm>
+#include <cmath>
+
+
+
+//=============================================================================
+//      Local Functions
+//-----------------------------------------------------------------------------
+
+namespace
+{
+	TQ3Vector3D	AttenuationFactors( TQ3AttenuationType inAttenuation )
+	{
+		TQ3Vector3D	factors = { 1.0f, 0.0f, 0.0f };
+		
+		switch (inAttenuation)
+		{
+			case kQ3AttenuationTypeInverseDistance:
+				factors.x = 0.0f;
+				factors.y = 1.0f;
+				break;
+			
+			case kQ3AttenuationTypeInverseDistanceSquared:
+				factors.x = 0.0f;
+				factors.z = 1.0f;
+				break;
+			
+			default:
+				break;
+		}
+		
+		return factors;
+	}
+	
+	/*!
+		@function	SpotFalloff
+		@abstract	Falloff between the hot angle and the outer angle, as
+					in the spot light shader of the OpenGL renderer.
+		@param		inFallOff	Falloff type.
+		@param		inFrac		Position between the hot angle (0) and the
+								outer angle (1).
+	*/
+	float	SpotFalloff( TQ3FallOffType inFallOff, float inFrac )
+	{
+		float	factor = 1.0f;
+		
+		switch (inFallOff)
+		{
+			case kQ3FallOffTypeLinear:
+				factor = 1.0f - inFrac;
+				break;
+			
+			case kQ3FallOffTypeExponential:
+				factor = (std::pow( 10.0f, 1.0f - inFrac ) - 1.0f) / 9.0f;
+				break;
+			
+			case kQ3FallOffTypeCosine:
+				factor = std::cos( inFrac * kQ3PiOver2 );
+				break;
+			
+			case kQ3FallOffTypeSmoothCubic:
+				factor = 1.0f - inFrac * inFrac * (3.0f - 2.0f * inFrac);
+				break;
+			
+			default:
+				break;
+		}
+		
+		return factor;
+	}
+}
+
+
+
+//=============================================================================
+//      Class Implementation
+//-----------------------------------------------------------------------------
+
+SWRenderer::Lights::Lights()
+	: mIsLocalViewer( true )
+{
+	mAmbient.r = mAmbient.g = mAmbient.b = 0.0f;
+}
+
+void	SWRenderer::Lights::StartPass(
+								TQ3CameraObject inCamera,
+								TQ3GroupObject inLights )
+{
+	mLights.clear();
+	mAmbient.r = mAmbient.g = mAmbient.b = 0.0f;
+	
+	if (inLights == nullptr)
+	{
+		return;
+	}
+	
+	TQ3Matrix4x4	worldToView;
+	Q3Camera_GetWorldToView( inCamera, &worldToView );
+	
+	Q3GroupIterator		iter( inLights, kQ3ShapeTypeLight );
+	CQ3ObjectRef		theLight;
+	
+	while ( (theLight = iter.NextObject()).isvalid() )
+	{
+		TQ3Boolean	isOn;
+		float		brightness;
+		TQ3ColorRGB	color;
+		Q3Light_GetState( theLight.get(), &isOn );
+		Q3Light_GetBrightness( theLight.get(), &brightness );
+		Q3Light_GetColor( theLight.get(), &color );
+		
+		if ( (isOn == kQ3False) || (brightness <= kQ3RealZero) )
+		{
+			continue;
+		}
+		
+		Light	theData;
+		E3Memory_Clear( &theData, sizeof(theData) );
+		theData.type = Q3Light_GetType( theLight.get() );
+		theData.color.r = color.r * brightness;
+		theData.color.g = color.g * brightness;
+		theData.color.b = color.b * brightness;
+		
+		switch (theData.type)
+		{
+			case kQ3LightTypeAmbient:
+				mAmbient.r += theData.color.r;
+				mAmbient.g += theData.color.g;
+				mAmbient.b += theData.color.b;
+				break;
+			
+			case kQ3LightTypeDirectional:
+				{
+					TQ3DirectionalLightData	dirData;
+					Q3DirectionalLight_GetData( theLight.get(), &dirData );
+					theData.direction = Q3Normalize3D( dirData.direction * worldToView );
+					mLights.push_back( theData );
+				}
+				break;
+			
+			case kQ3LightTypePoint:
+				{
+					TQ3PointLightData	pointData;
+					Q3PointLight_GetData( theLight.get(), &pointData );
+					theData.location = pointData.location * worldToView;
+					theData.attenuation = AttenuationFactors( pointData.attenuation );
+					mLights.push_back( theData );
+				}
+				break;
+			
+			case kQ3LightTypeSpot:
+				{
+					TQ3SpotLightData	spotData;
+					Q3SpotLight_GetData( theLight.get(), &spotData );
+					theData.location = spotData.location * worldToView;
+					theData.direction = Q3Normalize3D( spotData.direction * worldToView );
+					theData.attenuation = AttenuationFactors( spotData.attenuation );
+					theData.hotAngle = spotData.hotAngle;
+					theData.outerAngle = spotData.outerAngle;
+					theData.fallOff = spotData.fallOff;
+					mLights.push_back( theData );
+				}
+				break;
+		}
+	}
+}
+
+void	SWRenderer::Lights::Shade(
+								const TQ3Point3D& inPosition,
+								const TQ3Vector3D& inNormal,
+								TQ3ObjectType inIllumination,
+								float inShininess,
+								TQ3ColorRGB& outDiffuse,
+								TQ3ColorRGB& outSpecular ) const
+{
+	outDiffuse.r = outDiffuse.g = outDiffuse.b = 0.0f;
+	outSpecular.r = outSpecular.g = outSpecular.b = 0.0f;
+	
+	bool	isDirectional = (inIllumination != kQ3IlluminationTypeNondirectional);
+	bool	isSpecular = (inIllumination == kQ3IlluminationTypePhong);
+	
+	TQ3Vector3D		toEye = { 0.0f, 0.0f, 1.0f };
+	if (mIsLocalViewer)
+	{
+		toEye = Q3Normalize3D( - Q3PointToVector3D( inPosition ) );
+	}
+	
+	for (const Light& theLight : mLights)
+	{
+		TQ3Vector3D	toLight;
+		float		attenuation = 1.0f;
+		
+		if (theLight.type == kQ3LightTypeDirectional)
+		{
+			toLight = - theLight.direction;
+		}
+		else
+		{
+			toLight = theLight.location - inPosition;
+			float	d = Q3Length3D( toLight );
+			if (d <= kQ3RealZero)
+			{
+				continue;
+			}
+			toLight *= 1.0f / d;
+			attenuation = 1.0f / (theLight.attenuation.x +
+				theLight.attenuation.y * d + theLight.attenuation.z * d * d);
+			
+			if (theLight.type == kQ3LightTypeSpot)
+			{
+				float	spotDot = Q3Dot3D( - toLight, theLight.direction );
+				float	spotAngle = std::acos( std::max( -1.0f, std::min( spotDot, 1.0f ) ) );
+				
+				if (spotAngle > theLight.outerAngle)
+				{
+					continue;
+				}
+				if ( (spotAngle > theLight.hotAngle) &&
+					(theLight.outerAngle > theLight.hotAngle) )
+				{
+					attenuation *= SpotFalloff( theLight.fallOff,
+						(spotAngle - theLight.hotAngle) /
+						(theLight.outerAngle - theLight.hotAngle) );
+				}
+			}
+		}
+		
+		float	nDotL = isDirectional? Q3Dot3D( inNormal, toLight ) : 1.0f;
+		if (nDotL <= 0.0f)
+		{
+			continue;
+		}
+		
+		outDiffuse.r += theLight.color.r * attenuation * nDotL;
+		outDiffuse.g += theLight.color.g * attenuation * nDotL;
+		outDiffuse.b += theLight.color.b * attenuation * nDotL;
+		
+		if (isSpecular)
+		{
+			TQ3Vector3D	halfVector = Q3Normalize3D( toLight + toEye );
+			float		nDotHalf = std::max( 0.0f, Q3Dot3D( inNormal, halfVector ) );
+			float		pf = (inShininess <= 0.0f)? 1.0f :
+				std::pow( nDotHalf, inShininess );
+			
+			outSpecular.r += theLight.color.r * attenuation * pf;
+			outSpecular.g += theLight.color.g * attenuation * pf;
+			outSpecular.b += theLight.color.b * attenuation * pf;
+		}
+	}
+}
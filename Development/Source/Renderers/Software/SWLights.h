@@ -0,0 +1,140 @@
+/*!
+	@header		SWLights.h
+	
+	Lights class for use in Quesa software renderer.
+*/
+
+/*  NAME:
+        SWLights.h
+
+    DESCRIPTION:
+        Header for lighting in the Quesa software renderer.
+
+    COPYRIGHT:
+        Copyright (c) 2026, Quesa Developers. All rights reserved.
+
+        For the current release of Quesa, please see:
+
+            <https://github.com/jwwalker/Quesa>
+        
+        Redistribution and use in source and binary forms, with or without
+        modification, are permitted provided that the following conditions
+        are met:
+        
+            o Redistributions of source code must retain the above copyright
+              notice, this list of conditions and the following disclaimer.
+        
+            o Redistributions in binary form must reproduce the above
+              copyright notice, this list of conditions and the following
+              disclaimer in the documentation and/or other materials provided
+              with the distribution.
+        
+            o Neither the name of Quesa nor the names of its contributors
+              may be used to endorse or promote products derived from this
+              software without specific prior written permission.
+        
+        THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+        "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+        LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+        A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+        OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+        SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+        TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+        PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+        LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+        NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+        SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+    ___________________________________________________________________________
+*/
+#ifndef SWLIGHTS_HDR
+#define SWLIGHTS_HDR
+
+//=============================================================================
+//      Include files
+//-----------------------------------------------------------------------------
+
+#include "SWPrefix.h"
+
+
+
+//=============================================================================
+//      Class Declaration
+//-----------------------------------------------------------------------------
+
+namespace SWRenderer
+{
+
+/*!
+	@class		Lights
+	
+	@abstract	The lights of a view, in camera coordinates, and the lighting
+				model that applies them to a point on a surface.
+	
+	@discussion	The lighting model matches the per-pixel lighting of the
+				OpenGL renderer.  Once StartPass has been called, Shade only
+				reads plain data, so it can be called from several threads.
+*/
+class Lights
+{
+public:
+							Lights();
+
+	/*!
+		@function	StartPass
+		@abstract	Collect the lights that are switched on.
+	*/
+	void					StartPass(
+									TQ3CameraObject inCamera,
+									TQ3GroupObject inLights );
+	
+	/*!
+		@function	SetLocalViewer
+		@abstract	Set whether the eye is at the origin of camera space, as
+					for a perspective camera, or infinitely far along the
+					positive z axis, as for an orthographic camera.
+	*/
+	void					SetLocalViewer( bool inLocalViewer )
+									{ mIsLocalViewer = inLocalViewer; }
+	
+	const TQ3ColorRGB&		GetAmbient() const { return mAmbient; }
+	
+	/*!
+		@function	Shade
+		@abstract	Add up the light falling on a point.
+		@param		inPosition		Point in camera coordinates.
+		@param		inNormal		Unit normal vector, facing the eye.
+		@param		inIllumination	Illumination shader type.
+		@param		inShininess		Specular exponent.
+		@param		outDiffuse		Receives the diffuse light, not
+									including ambient light.
+		@param		outSpecular		Receives the specular light.
+	*/
+	void					Shade(
+									const TQ3Point3D& inPosition,
+									const TQ3Vector3D& inNormal,
+									TQ3ObjectType inIllumination,
+									float inShininess,
+									TQ3ColorRGB& outDiffuse,
+									TQ3ColorRGB& outSpecular ) const;
+
+private:
+	struct Light
+	{
+		TQ3ObjectType			type;
+		TQ3ColorRGB				color;			// includes brightness
+		TQ3Point3D				location;
+		TQ3Vector3D				direction;		// unit, away from light
+		TQ3Vector3D				attenuation;	// constant, linear, quadratic
+		float					hotAngle;
+		float					outerAngle;
+		TQ3FallOffType			fallOff;
+	};
+	
+	std::vector<Light>		mLights;
+	TQ3ColorRGB				mAmbient;
+	bool					mIsLocalViewer;
+};
+
+}	// end SWRenderer namespace
+
+#endif	// SWLIGHTS_HDR
@@ -0,0 +1,113 @@
+/*!
+	@header		SWPrefix.h
+	
+	Common types for the Quesa software renderer.
+*/
+
+/*  NAME:
+        SWPrefix.h
+
+    DESCRIPTION:
+        Prefix header for the Quesa software renderer.
+
+    COPYRIGHT:
+        Copyright (c) 2026, Quesa Developers. All rights reserved.
+
+        For the current release of Quesa, please see:
+
+            <https://github.com/jwwalker/Quesa>
+        
+        Redistribution and use in source and binary forms, with or without
+        modification, are permitted provided that the following conditions
+        are met:
+        
+            o Redistributions of source code must retain the above copyright
+              notice, this list of conditions and the following disclaimer.
+        
+            o Redistributions in binary form must reproduce the above
+              copyright notice, this list of conditions and the following
+              disclaimer in the documentation and/or other materials provided
+              with the distribution.
+        
+            o Neither the name of Quesa nor the names of its contributors
+              may be used to endorse or promote products derived from this
+              software without specific prior written permission.
+        
+        THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+        "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+        LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+        A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+        OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+        SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+        TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+        PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+        LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+        NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+        SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+    ___________________________________________________________________________
+*/
+#ifndef SWPREFIX_HDR
+#define SWPREFIX_HDR
+
+
+//=============================================================================
+//      Include files
+//-----------------------------------------------------------------------------
+
+#include "E3Prefix.h"
+#include "CQ3ObjectRef.h"
+#include "QuesaMathOperators.hpp"
+
+#include <vector>
+
+
+
+//=============================================================================
+//      Common constants and types
+//-----------------------------------------------------------------------------
+
+namespace SWRenderer
+{
+	/*!
+		@struct		Color4
+		@abstract	Floating point color with alpha, as held in the color
+					buffer and returned by texture lookups.
+	*/
+	struct Color4
+	{
+		float			r;
+		float			g;
+		float			b;
+		float			a;
+	};
+	
+	/*!
+		@enum		EVarying
+		@abstract	Indices of the values interpolated across a triangle.
+		@discussion	With vertex lighting, the color slots hold the lit
+					color that is modulated by the texture, and the specular
+					slots hold the color added after texturing.  With pixel
+					lighting, the color slots hold the diffuse color, the
+					specular slots hold the emissive color, and the normal
+					and position are interpolated so that lighting can be
+					done for each pixel.
+	*/
+	enum EVarying
+	{
+		kVaryingColor		= 0,
+		kVaryingSpecular	= 3,
+		kVaryingAlpha		= 6,
+		kVaryingU			= 7,
+		kVaryingV			= 8,
+		kVaryingNormal		= 9,
+		kVaryingPosition	= 12,
+		
+		kNumVertexLitVaryings	= 9,
+		kNumVaryings			= 15
+	};
+	
+	// Alpha values below this make a triangle transparent
+	const float			kAlphaThreshold = 0.999f;
+}
+
+#endif	// SWPREFIX_HDR
@@ -0,0 +1,508 @@
+/*  NAME:
+        SWRasterizer.cpp
+
+    DESCRIPTION:
+        Source for the tiled triangle rasterizer of the Quesa software renderer.
+
+    COPYRIGHT:
+        Copyright (c) 2026, Quesa Developers. All rights reserved.
+
+        For the current release of Quesa, please see:
+
+            <https://github.com/jwwalker/Quesa>
+        
+        Redistribution and use in source and binary forms, with or without
+        modification, are permitted provided that the following conditions
+        are met:
+        
+            o Redistributions of source code must retain the above copyright
+              notice, this list of conditions and the following disclaimer.
+        
+            o Redistributions in binary form must reproduce the above
+              copyright notice, this list of conditions and the following
+              disclaimer in the documentation and/or other materials provided
+              with the distribution.
+        
+            o Neither the name of Quesa nor the names of its contributors
+              may be used to endorse or promote products derived from this
+              software without specific prior written permission.
+        
+        THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+        "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+        LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+        A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+        OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+        SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+        TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+        PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+        LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+        NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+        SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+    ___________________________________________________________________________
+*/
+//=============================================================================
+//      Include files
+//-----------------------------------------------------------------------------
+#include "SWRasterizer.h"
+#include "SWLights.h"
+#include "SWTexture.h"
+
+#include "E3Parallel.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+
+
+//=============================================================================
+//      Local constants
+//-----------------------------------------------------------------------------
+
+namespace
+{
+	// Width and height of a tile, in pixels
+	const TQ3Int32		kTileSize = 64;
+	
+	// Number of pixels whose coverage is computed together
+	const TQ3Int32		kSpan = 4;
+	
+	inline bool		IsInside( float inEdge, bool inIsTopLeft )
+	{
+		// Pixels exactly on an edge belong to the triangle on the top or
+		// left of it, so that shared edges are drawn exactly once.
+		return (inEdge > 0.0f) || ((inEdge == 0.0f) && inIsTopLeft);
+	}
+}
+
+
+
+//=============================================================================
+//      Material Implementation
+//-----------------------------------------------------------------------------
+
+bool	SWRenderer::Material::operator==( const Material& inOther ) const
+{
+	return (texture == inOther.texture) &&
+		(wrapU == inOther.wrapU) &&
+		(wrapV == inOther.wrapV) &&
+		(alphaTestThreshold == inOther.alphaTestThreshold) &&
+		(specularColor.r == inOther.specularColor.r) &&
+		(specularColor.g == inOther.specularColor.g) &&
+		(specularColor.b == inOther.specularColor.b) &&
+		(shininess == inOther.shininess) &&
+		(metallic == inOther.metallic) &&
+		(illumination == inOther.illumination) &&
+		(isPixelLit == inOther.isPixelLit);
+}
+
+
+
+//=============================================================================
+//      Rasterizer Implementation
+//-----------------------------------------------------------------------------
+
+SWRenderer::Rasterizer::Rasterizer( const Lights& inLights )
+	: mLights( inLights )
+	, mWidth( 0 )
+	, mHeight( 0 )
+	, mTilesAcross( 0 )
+	, mTilesDown( 0 )
+{
+}
+
+void	SWRenderer::Rasterizer::StartPass(
+								TQ3Uns32 inWidth,
+								TQ3Uns32 inHeight,
+								const Color4* inClearColor )
+{
+	mWidth = inWidth;
+	mHeight = inHeight;
+	mTilesAcross = (inWidth + kTileSize - 1) / kTileSize;
+	mTilesDown = (inHeight + kTileSize - 1) / kTileSize;
+	
+	mColor.resize( inWidth * inHeight );
+	if (inClearColor != nullptr)
+	{
+		std::fill( mColor.begin(), mColor.end(), *inClearColor );
+	}
+	mDepth.assign( inWidth * inHeight, 1.0f );
+	
+	Cancel();
+	
+	mOpaqueBins.resize( mTilesAcross * mTilesDown );
+	mTransparentBins.resize( mTilesAcross * mTilesDown );
+}
+
+void	SWRenderer::Rasterizer::Cancel()
+{
+	mMaterials.clear();
+	mOpaque.clear();
+	mTransparent.clear();
+	
+	for (auto& theBin : mOpaqueBins)
+		theBin.clear();
+	for (auto& theBin : mTransparentBins)
+		theBin.clear();
+}
+
+TQ3Uns32	SWRenderer::Rasterizer::AddMaterial( const Material& inMaterial )
+{
+	if ( mMaterials.empty() || ! (mMaterials.back() == inMaterial) )
+	{
+		mMaterials.push_back( inMaterial );
+	}
+	
+	return static_cast<TQ3Uns32>( mMaterials.size() - 1 );
+}
+
+void	SWRenderer::Rasterizer::AddTriangle(
+								const RasterVertex& inVert0,
+								const RasterVertex& inVert1,
+								const RasterVertex& inVert2,
+								TQ3Uns32 inMaterial,
+								bool inIsTransparent )
+{
+	// Twice the signed area.  Make it positive by swapping two vertices,
+	// so that the inside of each edge is where its edge function is positive.
+	float	area2 = (inVert1.x - inVert0.x) * (inVert2.y - inVert0.y) -
+		(inVert1.y - inVert0.y) * (inVert2.x - inVert0.x);
+	if ( (area2 == 0.0f) || ! std::isfinite( area2 ) )
+	{
+		return;
+	}
+	
+	Triangle	theTri;
+	theTri.vert[0] = inVert0;
+	theTri.vert[1] = (area2 > 0.0f)? inVert1 : inVert2;
+	theTri.vert[2] = (area2 > 0.0f)? inVert2 : inVert1;
+	area2 = std::fabs( area2 );
+	theTri.oneOverArea = 1.0f / area2;
+	
+	
+	// Bounding box, clamped to the image
+	float	minX = std::min( std::min( inVert0.x, inVert1.x ), inVert2.x );
+	float	maxX = std::max( std::max( inVert0.x, inVert1.x ), inVert2.x );
+	float	minY = std::min( std::min( inVert0.y, inVert1.y ), inVert2.y );
+	float	maxY = std::max( std::max( inVert0.y, inVert1.y ), inVert2.y );
+	theTri.minX = std::max( 0, (TQ3Int32) std::floor( minX ) );
+	theTri.minY = std::max( 0, (TQ3Int32) std::floor( minY ) );
+	theTri.maxX = std::min( (TQ3Int32) mWidth - 1, (TQ3Int32) std::ceil( maxX ) );
+	theTri.maxY = std::min( (TQ3Int32) mHeight - 1, (TQ3Int32) std::ceil( maxY ) );
+	if ( (theTri.minX > theTri.maxX) || (theTri.minY > theTri.maxY) )
+	{
+		return;
+	}
+	
+	
+	// Edge functions, E(x, y) = A x + B y + C
+	for (int i = 0; i < 3; ++i)
+	{
+		const RasterVertex&	from( theTri.vert[ (i + 1) % 3 ] );
+		const RasterVertex&	to( theTri.vert[ (i + 2) % 3 ] );
+		theTri.edgeA[i] = from.y - to.y;
+		theTri.edgeB[i] = to.x - from.x;
+		theTri.edgeC[i] = - (theTri.edgeA[i] * from.x + theTri.edgeB[i] * from.y);
+		theTri.isTopLeft[i] = (theTri.edgeA[i] > 0.0f) ||
+			((theTri.edgeA[i] == 0.0f) && (theTri.edgeB[i] > 0.0f));
+	}
+	
+	
+	// Divide the varyings by w
+	const Material&	theMaterial( mMaterials[ inMaterial ] );
+	int		numVaryings = theMaterial.isPixelLit? kNumVaryings : kNumVertexLitVaryings;
+	for (int i = 0; i < 3; ++i)
+	{
+		RasterVertex&	theVert( theTri.vert[i] );
+		for (int j = 0; j < numVaryings; ++j)
+		{
+			theVert.varying[j] *= theVert.oneOverW;
+		}
+	}
+	
+	
+	// Choose a mipmap level from the ratio of texels to pixels
+	theTri.textureLevel = 0;
+	if (theMaterial.texture != nullptr)
+	{
+		TQ3Param2D	uv[3];
+		for (int i = 0; i < 3; ++i)
+		{
+			uv[i].u = theTri.vert[i].varying[ kVaryingU ] / theTri.vert[i].oneOverW;
+			uv[i].v = theTri.vert[i].varying[ kVaryingV ] / theTri.vert[i].oneOverW;
+		}
+		float	uvArea2 = std::fabs( (uv[1].u - uv[0].u) * (uv[2].v - uv[0].v) -
+			(uv[1].v - uv[0].v) * (uv[2].u - uv[0].u) );
+		float	texelArea2 = uvArea2 * theMaterial.texture->Width() *
+			theMaterial.texture->Height();
+		
+		if (texelArea2 > area2)
+		{
+			float	lod = 0.5f * std::log2( texelArea2 / area2 );
+			theTri.textureLevel = std::min( (int) (lod + 0.5f),
+				theMaterial.texture->CountLevels() - 1 );
+		}
+	}
+	
+	theTri.material = inMaterial;
+	theTri.sortDepth = inVert0.depth + inVert1.depth + inVert2.depth;
+	
+	if (inIsTransparent)
+	{
+		mTransparent.push_back( theTri );
+	}
+	else
+	{
+		mOpaque.push_back( theTri );
+	}
+}
+
+void	SWRenderer::Rasterizer::BinTriangles(
+								const std::vector<Triangle>& inTriangles,
+								const std::vector<TQ3Uns32>& inOrder,
+								std::vector< std::vector<TQ3Uns32> >& outBins )
+{
+	for (TQ3Uns32 triIndex : inOrder)
+	{
+		const Triangle&	theTri( inTriangles[ triIndex ] );
+		TQ3Int32	tileLeft = theTri.minX / kTileSize;
+		TQ3Int32	tileRight = theTri.maxX / kTileSize;
+		TQ3Int32	tileTop = theTri.minY / kTileSize;
+		TQ3Int32	tileBottom = theTri.maxY / kTileSize;
+		
+		for (TQ3Int32 ty = tileTop; ty <= tileBottom; ++ty)
+		{
+			for (TQ3Int32 tx = tileLeft; tx <= tileRight; ++tx)
+			{
+				outBins[ ty * mTilesAcross + tx ].push_back( triIndex );
+			}
+		}
+	}
+}
+
+void	SWRenderer::Rasterizer::Render()
+{
+	if ( (mWidth == 0) || (mHeight == 0) )
+	{
+		return;
+	}
+	
+	
+	// Opaque triangles keep their submission order, transparent triangles
+	// are sorted from back to front.
+	std::vector<TQ3Uns32>	order( mOpaque.size() );
+	std::iota( order.begin(), order.end(), 0 );
+	BinTriangles( mOpaque, order, mOpaqueBins );
+	
+	order.resize( mTransparent.size() );
+	std::iota( order.begin(), order.end(), 0 );
+	std::stable_sort( order.begin(), order.end(),
+		[this]( TQ3Uns32 inA, TQ3Uns32 inB )
+		{
+			return mTransparent[ inA ].sortDepth > mTransparent[ inB ].sortDepth;
+		} );
+	BinTriangles( mTransparent, order, mTransparentBins );
+	
+	
+	// Fill the tiles
+	E3Parallel_For( mTilesAcross * mTilesDown, 1,
+		[this]( TQ3Uns32 inStart, TQ3Uns32 inEnd )
+		{
+			for (TQ3Uns32 i = inStart; i < inEnd; ++i)
+			{
+				RenderTile( i );
+			}
+		} );
+}
+
+void	SWRenderer::Rasterizer::RenderTile( TQ3Uns32 inTileIndex )
+{
+	TQ3Int32	tileLeft = (inTileIndex % mTilesAcross) * kTileSize;
+	TQ3Int32	tileTop = (inTileIndex / mTilesAcross) * kTileSize;
+	
+	for (TQ3Uns32 triIndex : mOpaqueBins[ inTileIndex ])
+	{
+		DrawTriangle( mOpaque[ triIndex ], tileLeft, tileTop, false );
+	}
+	
+	for (TQ3Uns32 triIndex : mTransparentBins[ inTileIndex ])
+	{
+		DrawTriangle( mTransparent[ triIndex ], tileLeft, tileTop, true );
+	}
+}
+
+void	SWRenderer::Rasterizer::DrawTriangle(
+								const Triangle& inTri,
+								TQ3Int32 inTileLeft,
+								TQ3Int32 inTileTop,
+								bool inIsTransparent )
+{
+	TQ3Int32	left = std::max( inTri.minX, inTileLeft );
+	TQ3Int32	right = std::min( inTri.maxX, inTileLeft + kTileSize - 1 );
+	TQ3Int32	top = std::max( inTri.minY, inTileTop );
+	TQ3Int32	bottom = std::min( inTri.maxY, inTileTop + kTileSize - 1 );
+	
+	for (TQ3Int32 y = top; y <= bottom; ++y)
+	{
+		float		py = y + 0.5f;
+		float		rowEdge[3];
+		for (int i = 0; i < 3; ++i)
+		{
+			rowEdge[i] = inTri.edgeB[i] * py + inTri.edgeC[i];
+		}
+		
+		Color4*		colorRow = &mColor[ y * mWidth ];
+		float*		depthRow = &mDepth[ y * mWidth ];
+		
+		for (TQ3Int32 x = left; x <= right; x += kSpan)
+		{
+			// Coverage and depth for a span of pixels
+			float	edge[3][kSpan];
+			float	depth[kSpan];
+			bool	isDrawn[kSpan];
+			bool	isAnyDrawn = false;
+			
+			for (int i = 0; i < 3; ++i)
+			{
+				for (int k = 0; k < kSpan; ++k)
+				{
+					edge[i][k] = inTri.edgeA[i] * (x + k + 0.5f) + rowEdge[i];
+				}
+			}
+			
+			for (int k = 0; k < kSpan; ++k)
+			{
+				depth[k] = (inTri.vert[0].depth * edge[0][k] +
+					inTri.vert[1].depth * edge[1][k] +
+					inTri.vert[2].depth * edge[2][k]) * inTri.oneOverArea;
+				
+				isDrawn[k] = (x + k <= right) &&
+					IsInside( edge[0][k], inTri.isTopLeft[0] ) &&
+					IsInside( edge[1][k], inTri.isTopLeft[1] ) &&
+					IsInside( edge[2][k], inTri.isTopLeft[2] ) &&
+					(depth[k] < depthRow[ std::min( x + k, right ) ]);
+				
+				isAnyDrawn = isAnyDrawn || isDrawn[k];
+			}
+			
+			if (! isAnyDrawn)
+			{
+				continue;
+			}
+			
+			
+			// Shade the pixels that passed
+			for (int k = 0; k < kSpan; ++k)
+			{
+				if (! isDrawn[k])
+				{
+					continue;
+				}
+				
+				float	bary[3] = {
+					edge[0][k] * inTri.oneOverArea,
+					edge[1][k] * inTri.oneOverArea,
+					edge[2][k] * inTri.oneOverArea
+				};
+				Color4	theColor;
+				if (! ShadePixel( inTri, bary, theColor ))
+				{
+					continue;
+				}
+				
+				Color4&	dst( colorRow[ x + k ] );
+				if (inIsTransparent)
+				{
+					float	oneMinusAlpha = 1.0f - theColor.a;
+					dst.r = theColor.r * theColor.a + dst.r * oneMinusAlpha;
+					dst.g = theColor.g * theColor.a + dst.g * oneMinusAlpha;
+					dst.b = theColor.b * theColor.a + dst.b * oneMinusAlpha;
+					dst.a = theColor.a + dst.a * oneMinusAlpha;
+				}
+				else
+				{
+					dst.r = theColor.r;
+					dst.g = theColor.g;
+					dst.b = theColor.b;
+					dst.a = 1.0f;
+					depthRow[ x + k ] = depth[k];
+				}
+			}
+		}
+	}
+}
+
+bool	SWRenderer::Rasterizer::ShadePixel(
+								const Triangle& inTri,
+								const float* inBary,
+								Color4& outColor ) const
+{
+	const Material&	theMaterial( mMaterials[ inTri.material ] );
+	
+	
+	// Perspective correct interpolation
+	float	w = 1.0f / (inBary[0] * inTri.vert[0].oneOverW +
+		inBary[1] * inTri.vert[1].oneOverW +
+		inBary[2] * inTri.vert[2].oneOverW);
+	float	b0 = inBary[0] * w;
+	float	b1 = inBary[1] * w;
+	float	b2 = inBary[2] * w;
+	int		numVaryings = theMaterial.isPixelLit? kNumVaryings : kNumVertexLitVaryings;
+	float	v[ kNumVaryings ];
+	
+	for (int j = 0; j < numVaryings; ++j)
+	{
+		v[j] = b0 * inTri.vert[0].varying[j] + b1 * inTri.vert[1].varying[j] +
+			b2 * inTri.vert[2].varying[j];
+	}
+	
+	Color4	texColor = { 1.0f, 1.0f, 1.0f, 1.0f };
+	if (theMaterial.texture != nullptr)
+	{
+		theMaterial.texture->Sample( v[ kVaryingU ], v[ kVaryingV ],
+			inTri.textureLevel, theMaterial.wrapU, theMaterial.wrapV, texColor );
+	}
+	
+	outColor.a = v[ kVaryingAlpha ] * texColor.a;
+	if ( (theMaterial.alphaTestThreshold > 0.0f) &&
+		(outColor.a < theMaterial.alphaTestThreshold) )
+	{
+		return false;
+	}
+	
+	
+	if (! theMaterial.isPixelLit)
+	{
+		// The color was lit at the vertices
+		outColor.r = v[ kVaryingColor + 0 ] * texColor.r + v[ kVaryingSpecular + 0 ];
+		outColor.g = v[ kVaryingColor + 1 ] * texColor.g + v[ kVaryingSpecular + 1 ];
+		outColor.b = v[ kVaryingColor + 2 ] * texColor.b + v[ kVaryingSpecular + 2 ];
+	}
+	else
+	{
+		TQ3Vector3D	normal = { v[ kVaryingNormal + 0 ], v[ kVaryingNormal + 1 ],
+			v[ kVaryingNormal + 2 ] };
+		TQ3Point3D	position = { v[ kVaryingPosition + 0 ], v[ kVaryingPosition + 1 ],
+			v[ kVaryingPosition + 2 ] };
+		TQ3ColorRGB	diffuse, specular;
+		
+		mLights.Shade( position, Q3Normalize3D( normal ), theMaterial.illumination,
+			theMaterial.shininess, diffuse, specular );
+		
+		const TQ3ColorRGB&	ambient( mLights.GetAmbient() );
+		float	matte = 1.0f - theMaterial.metallic;
+		float	metal = theMaterial.metallic;
+		
+		outColor.r = ((ambient.r + diffuse.r) * matte * v[ kVaryingColor + 0 ] +
+			v[ kVaryingSpecular + 0 ]) * texColor.r +
+			(specular.r + metal * ambient.r) * theMaterial.specularColor.r;
+		outColor.g = ((ambient.g + diffuse.g) * matte * v[ kVaryingColor + 1 ] +
+			v[ kVaryingSpecular + 1 ]) * texColor.g +
+			(specular.g + metal * ambient.g) * theMaterial.specularColor.g;
+		outColor.b = ((ambient.b + diffuse.b) * matte * v[ kVaryingColor + 2 ] +
+			v[ kVaryingSpecular + 2 ]) * texColor.b +
+			(specular.b + metal * ambient.b) * theMaterial.specularColor.b;
+	}
+	
+	return true;
+}
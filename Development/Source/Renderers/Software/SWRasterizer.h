@@ -0,0 +1,223 @@
+/*!
+	@header		SWRasterizer.h
+	
+	Rasterizer class for use in Quesa software renderer.
+*/
+
+/*  NAME:
+        SWRasterizer.h
+
+    DESCRIPTION:
+        Header for the tiled triangle rasterizer of the Quesa software renderer.
+
+    COPYRIGHT:
+        Copyright (c) 2026, Quesa Developers. All rights reserved.
+
+        For the current release of Quesa, please see:
+
+            <https://github.com/jwwalker/Quesa>
+        
+        Redistribution and use in source and binary forms, with or without
+        modification, are permitted provided that the following conditions
+        are met:
+        
+            o Redistributions of source code must retain the above copyright
+              notice, this list of conditions and the following disclaimer.
+        
+            o Redistributions in binary form must reproduce the above
+              copyright notice, this list of conditions and the following
+              disclaimer in the documentation and/or other materials provided
+              with the distribution.
+        
+            o Neither the name of Quesa nor the names of its contributors
+              may be used to endorse or promote products derived from this
+              software without specific prior written permission.
+        
+        THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+        "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+        LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+        A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+        OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+        SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+        TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+        PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+        LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+        NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+        SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+    ___________________________________________________________________________
+*/
+#ifndef SWRASTERIZER_HDR
+#define SWRASTERIZER_HDR
+
+//=============================================================================
+//      Include files
+//-----------------------------------------------------------------------------
+
+#include "SWPrefix.h"
+
+
+
+//=============================================================================
+//      Class Declaration
+//-----------------------------------------------------------------------------
+
+namespace SWRenderer
+{
+
+class Lights;
+class Texture;
+
+/*!
+	@struct		RasterVertex
+	@abstract	A vertex of a triangle that has been clipped and projected.
+*/
+struct RasterVertex
+{
+	float			x;				// pixels, from the left of the image
+	float			y;				// pixels, from the top of the image
+	float			depth;			// 0 at the near plane, 1 at the far plane
+	float			oneOverW;
+	float			varying[ kNumVaryings ];
+};
+
+/*!
+	@struct		Material
+	@abstract	Values that are the same across a triangle.
+*/
+struct Material
+{
+	bool				operator==( const Material& inOther ) const;
+	
+	const Texture*		texture;
+	bool				wrapU;
+	bool				wrapV;
+	float				alphaTestThreshold;		// 0 for no alpha test
+	TQ3ColorRGB			specularColor;
+	float				shininess;
+	float				metallic;
+	TQ3ObjectType		illumination;
+	bool				isPixelLit;
+};
+
+/*!
+	@class		Rasterizer
+	
+	@abstract	Tiled, multi-threaded triangle rasterizer with a depth buffer.
+	
+	@discussion	Triangles are queued during a pass.  When the pass ends,
+				they are sorted into square tiles of the image, and the
+				tiles are filled in parallel.  Each tile draws its opaque
+				triangles in submission order, then blends its transparent
+				triangles from back to front, so no two threads ever touch
+				the same pixel.
+				
+				Coverage and depth are computed for four pixels at a time,
+				in plain loops that the compiler can turn into vector code.
+*/
+class Rasterizer
+{
+public:
+							Rasterizer( const Lights& inLights );
+	
+	/*!
+		@function	StartPass
+		@abstract	Size the buffers, clear the depth buffer, and forget
+					the triangles of the previous pass.
+		@param		inWidth			Width of the image in pixels.
+		@param		inHeight		Height of the image in pixels.
+		@param		inClearColor	Color to clear to, or nullptr to leave
+									the color buffer for the caller to fill.
+	*/
+	void					StartPass(
+									TQ3Uns32 inWidth,
+									TQ3Uns32 inHeight,
+									const Color4* inClearColor );
+	
+	/*!
+		@function	AddMaterial
+		@abstract	Record a material, reusing the previous one if it is
+					the same.
+		@result		Index to pass to AddTriangle.
+	*/
+	TQ3Uns32				AddMaterial( const Material& inMaterial );
+	
+	/*!
+		@function	AddTriangle
+		@abstract	Queue a triangle.
+		@discussion	The varyings of the vertices are given as they are; they
+					are divided by w here for perspective correct
+					interpolation.  Either winding is accepted, so any back
+					face culling must be done by the caller.
+	*/
+	void					AddTriangle(
+									const RasterVertex& inVert0,
+									const RasterVertex& inVert1,
+									const RasterVertex& inVert2,
+									TQ3Uns32 inMaterial,
+									bool inIsTransparent );
+	
+	/*!
+		@function	Render
+		@abstract	Draw the queued triangles into the color buffer.
+	*/
+	void					Render();
+	
+	/*!
+		@function	Cancel
+		@abstract	Forget the queued triangles.
+	*/
+	void					Cancel();
+	
+	TQ3Uns32				Width() const { return mWidth; }
+	TQ3Uns32				Height() const { return mHeight; }
+	Color4*					ColorBuffer() { return mColor.data(); }
+	const Color4*			ColorBuffer() const { return mColor.data(); }
+
+private:
+	struct Triangle
+	{
+		RasterVertex		vert[3];
+		float				edgeA[3];		// edge i is opposite vertex i
+		float				edgeB[3];
+		float				edgeC[3];
+		bool				isTopLeft[3];
+		float				oneOverArea;
+		TQ3Int32			minX, minY, maxX, maxY;
+		TQ3Uns32			material;
+		int					textureLevel;
+		float				sortDepth;
+	};
+	
+	void					BinTriangles(
+									const std::vector<Triangle>& inTriangles,
+									const std::vector<TQ3Uns32>& inOrder,
+									std::vector< std::vector<TQ3Uns32> >& outBins );
+	void					RenderTile( TQ3Uns32 inTileIndex );
+	void					DrawTriangle(
+									const Triangle& inTri,
+									TQ3Int32 inTileLeft,
+									TQ3Int32 inTileTop,
+									bool inIsTransparent );
+	bool					ShadePixel(
+									const Triangle& inTri,
+									const float* inBary,
+									Color4& outColor ) const;
+
+	const Lights&			mLights;
+	TQ3Uns32				mWidth;
+	TQ3Uns32				mHeight;
+	TQ3Uns32				mTilesAcross;
+	TQ3Uns32				mTilesDown;
+	std::vector<Color4>		mColor;
+	std::vector<float>		mDepth;
+	
+	std::vector<Material>	mMaterials;
+	std::vector<Triangle>	mOpaque;
+	std::vector<Triangle>	mTransparent;
+	std::vector< std::vector<TQ3Uns32> >	mOpaqueBins;
+	std::vector< std::vector<TQ3Uns32> >	mTransparentBins;
+};
+
+}	// end SWRenderer namespace
+
+#endif	// SWRASTERIZER_HDR
@@ -0,0 +1,98 @@
+/*  NAME:
+        SWRegister.cpp
+
+    DESCRIPTION:
+        Quesa software renderer registration.
+
+    COPYRIGHT:
+        Copyright (c) 2026, Quesa Developers. All rights reserved.
+
+        For the current release of Quesa, please see:
+
+            <https://github.com/jwwalker/Quesa>
+        
+        Redistribution and use in source and binary forms, with or without
+        modification, are permitted provided that the following conditions
+        are met:
+        
+            o Redistributions of source code must retain the above copyright
+              notice, this list of conditions and the following disclaimer.
+        
+            o Redistributions in binary form must reproduce the above
+              copyright notice, this list of conditions and the following
+              disclaimer in the documentation and/or other materials provided
+              with the distribution.
+        
+            o Neither the name of Quesa nor the names of its contributors
+              may be used to endorse or promote products derived from this
+              software without specific prior written permission.
+        
+        THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+        "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+        LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+        A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+        OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+        SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+        TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+        PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+        LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+        NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+        SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+    ___________________________________________________________________________
+*/
+
+//=============================================================================
+//      Include files
+//-----------------------------------------------------------------------------
+#include "SWRegister.h"
+
+#include "E3Prefix.h"
+#include "E3Compatibility.h"
+#include "SWRenderer.h"
+#include "SWStatics.h"
+
+
+//=============================================================================
+//      Internal constants
+//-----------------------------------------------------------------------------
+#define kRendererClassName							"Quesa:Shared:Renderer:Software"
+
+
+
+
+//=============================================================================
+//      External Functions
+//-----------------------------------------------------------------------------
+
+
+TQ3Status			SWRenderer_Register(void)
+{
+	// Register the class
+	//
+	// As with the OpenGL renderer, we use the undocumented registration
+	// routine so that the class gets its documented type.
+	TQ3XObjectClass theClass = EiObjectHierarchy_RegisterClassByType(
+											kQ3SharedTypeRenderer,
+											kQ3RendererTypeSoftware,
+											kRendererClassName,
+											&SWRenderer::Statics::MetaHandler,
+											nullptr,
+											0,
+											sizeof(SWRenderer::Renderer*));
+
+	return(theClass == nullptr ? kQ3Failure : kQ3Success);
+}
+
+
+void				SWRenderer_Unregister(void)
+{
+	// Find the renderer class
+	TQ3XObjectClass theClass = Q3XObjectHierarchy_FindClassByType(
+		kQ3RendererTypeSoftware );
+	
+	if (theClass != nullptr)
+	{
+		// Unregister the class
+		Q3XObjectHierarchy_UnregisterClass( theClass );
+	}
+}
@@ -0,0 +1,301 @@
+/*  NAME:
+        SWRenderer.cpp
+
+    DESCRIPTION:
+        Source for Quesa software renderer class.
+
+    COPYRIGHT:
+        Copyright (c) 2026, Quesa Developers. All rights reserved.
+
+        For the current release of Quesa, please see:
+
+            <https://github.com/jwwalker/Quesa>
+        
+        Redistribution and use in source and binary forms, with or without
+        modification, are permitted provided that the following conditions
+        are met:
+        
+            o Redistributions of source code must retain the above copyright
+              notice, this list of conditions and the following disclaimer.
+        
+            o Redistributions in binary form must reproduce the above
+              copyright notice, this list of conditions and the following
+              disclaimer in the documentation and/or other materials provided
+              with the distribution.
+        
+            o Neither the name of Quesa nor the names of its contributors
+              may be used to endorse or promote products derived from this
+              software without specific prior written permission.
+        
+        THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+        "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+        LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+        A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+        OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+        SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+        TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+        PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+        LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+        NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+        SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+    ___________________________________________________________________________
+*/
+//=============================================================================
+//      Include files
+//-----------------------------------------------------------------------------
+#include "SWRenderer.h"
+
+#include "E3ErrorManager.h"
+#include "E3Math_Intersect.h"
+#include "E3Parallel.h"
+
+#include <algorithm>
+#include <cmath>
+
+
+
+//=============================================================================
+//      Internal constants
+//-----------------------------------------------------------------------------
+namespace
+{
+	const TQ3ColorRGB	kDefaultDiffuseColor = { 1.0f, 1.0f, 1.0f };
+	const TQ3ColorRGB	kDefaultSpecularColor = { 0.5f, 0.5f, 0.5f };
+	const float			kDefaultSpecularControl = 4.0f;
+	const float			kDefaultMetallic = 0.0f;
+	const float			kDefaultAlpha = 1.0f;
+	const TQ3ColorRGB	kDefaultEmissiveColor = { 0.0f, 0.0f, 0.0f };
+	
+	// Rows of the image written to the pixmap by each task
+	const TQ3Uns32		kRowsPerTask = 16;
+}
+
+
+//=============================================================================
+//     Subsidiary Class Implementations
+//-----------------------------------------------------------------------------
+void	SWRenderer::ColorState::Reset()
+{
+	diffuseColor = kDefaultDiffuseColor;
+	specularColor = kDefaultSpecularColor;
+	specularControl = kDefaultSpecularControl;
+	metallic = kDefaultMetallic;
+	emissiveColor = kDefaultEmissiveColor;
+	alpha = kDefaultAlpha;
+	highlightState = kQ3Off;
+}
+
+void	SWRenderer::TextureState::Reset()
+{
+	texture = nullptr;
+	wrapU = true;
+	wrapV = true;
+	alphaTestThreshold = 0.0f;
+	Q3Matrix3x3_SetIdentity( &uvTransform );
+}
+
+
+
+#pragma mark -
+//=============================================================================
+//     Main Class Constructor/destructor Implementations
+//-----------------------------------------------------------------------------
+
+SWRenderer::Renderer::Renderer( TQ3RendererObject inRenderer )
+	: mRendererObject( inRenderer )
+	, mPaneLeft( 0 )
+	, mPaneTop( 0 )
+	, mPaneWidth( 0 )
+	, mPaneHeight( 0 )
+	, mClearMethod( kQ3ClearMethodWithColor )
+	, mIsLocalViewer( true )
+	, mViewIllumination( kQ3IlluminationTypeNULL )
+	, mRasterizer( mLights )
+{
+	Q3Memory_Clear( &mPixmap, sizeof(mPixmap) );
+	Q3Matrix4x4_SetIdentity( &mLocalToCamera );
+	Q3Matrix4x4_SetIdentity( &mCameraToFrustum );
+	Q3Matrix4x4_SetIdentity( &mLocalToFrustum );
+	Q3Matrix4x4_SetIdentity( &mNormalMatrix );
+	mViewState.Reset();
+	mGeomState.Reset();
+	mViewTexture.Reset();
+	mGeomTexture.Reset();
+	mStyleState.mInterpolation = kQ3InterpolationStyleVertex;
+	mStyleState.mBackfacing = kQ3BackfacingStyleBoth;
+	mStyleState.mOrientation = kQ3OrientationStyleCounterClockwise;
+	mClearColor.r = mClearColor.g = mClearColor.b = mClearColor.a = 0.0f;
+}
+
+SWRenderer::Renderer::~Renderer()
+{
+}
+
+bool	SWRenderer::Renderer::IsBoundingBoxVisible(
+								TQ3ViewObject inView,
+								const TQ3BoundingBox& inBounds )
+{
+	return (kQ3False == inBounds.isEmpty) &&
+		E3BoundingBox_IntersectViewFrustum( inView, inBounds );
+}
+
+
+
+#pragma mark -
+//=============================================================================
+//     Frame and pass Implementations
+//-----------------------------------------------------------------------------
+
+/*!
+	@function	StartFrame
+	@abstract	Find the pixmap and the part of it that we draw into.
+*/
+TQ3Status	SWRenderer::Renderer::StartFrame(
+								TQ3DrawContextObject inDrawContext )
+{
+	if (Q3DrawContext_GetType( inDrawContext ) != kQ3DrawContextTypePixmap)
+	{
+		E3ErrorManager_PostError( kQ3ErrorBadDrawContextType, kQ3False );
+		return kQ3Failure;
+	}
+	
+	Q3PixmapDrawContext_GetPixmap( inDrawContext, &mPixmap );
+	if ( (mPixmap.image == nullptr) ||
+		(BytesPerPixel( mPixmap.pixelType ) == 0) )
+	{
+		E3ErrorManager_PostError( kQ3ErrorUnsupportedPixelDepth, kQ3False );
+		return kQ3Failure;
+	}
+	
+	// Find the pane, limited to the pixmap
+	TQ3Int32	left = 0;
+	TQ3Int32	top = 0;
+	TQ3Int32	right = static_cast<TQ3Int32>( mPixmap.width );
+	TQ3Int32	bottom = static_cast<TQ3Int32>( mPixmap.height );
+	TQ3Boolean	hasPane = kQ3False;
+	TQ3Area		thePane;
+	if ( (kQ3Success == Q3DrawContext_GetPaneState( inDrawContext, &hasPane )) &&
+		hasPane &&
+		(kQ3Success == Q3DrawContext_GetPane( inDrawContext, &thePane )) )
+	{
+		left = std::max( left, static_cast<TQ3Int32>( floorf( thePane.min.x ) ) );
+		top = std::max( top, static_cast<TQ3Int32>( floorf( thePane.min.y ) ) );
+		right = std::min( right, static_cast<TQ3Int32>( ceilf( thePane.max.x ) ) );
+		bottom = std::min( bottom, static_cast<TQ3Int32>( ceilf( thePane.max.y ) ) );
+	}
+	mPaneLeft = static_cast<TQ3Uns32>( left );
+	mPaneTop = static_cast<TQ3Uns32>( top );
+	mPaneWidth = static_cast<TQ3Uns32>( std::max( right - left, 0 ) );
+	mPaneHeight = static_cast<TQ3Uns32>( std::max( bottom - top, 0 ) );
+	
+	// Find how to clear
+	mClearMethod = kQ3ClearMethodWithColor;
+	Q3DrawContext_GetClearImageMethod( inDrawContext, &mClearMethod );
+	TQ3ColorARGB	clearColor = { 1.0f, 0.0f, 0.0f, 0.0f };
+	Q3DrawContext_GetClearImageColor( inDrawContext, &clearColor );
+	mClearColor.r = clearColor.r;
+	mClearColor.g = clearColor.g;
+	mClearColor.b = clearColor.b;
+	mClearColor.a = clearColor.a;
+	
+	// Forget textures that have been disposed or changed
+	mTextures.StartFrame();
+	
+	return kQ3Success;
+}
+
+TQ3Status	SWRenderer::Renderer::EndFrame(
+								TQ3ViewObject inView )
+{
+	// The image was written to the pixmap at the end of the pass, so just
+	// let the view know that we're done
+	TQ3Status qd3dStatus = Q3XView_EndFrame( inView );
+
+	return(qd3dStatus);
+}
+
+void		SWRenderer::Renderer::StartPass(
+								TQ3CameraObject inCamera,
+								TQ3GroupObject inLights )
+{
+	mViewState.Reset();
+	mGeomState.Reset();
+	mViewTexture.Reset();
+	mGeomTexture.Reset();
+	mViewIllumination = kQ3IlluminationTypeNULL;
+	
+	mLights.StartPass( inCamera, inLights );
+	
+	if (mClearMethod == kQ3ClearMethodWithColor)
+	{
+		mRasterizer.StartPass( mPaneWidth, mPaneHeight, &mClearColor );
+	}
+	else
+	{
+		// Start with what is already in the pixmap
+		mRasterizer.StartPass( mPaneWidth, mPaneHeight, nullptr );
+		
+		Color4*		dstColor = mRasterizer.ColorBuffer();
+		TQ3Uns32	bytesPerPixel = BytesPerPixel( mPixmap.pixelType );
+		
+		for (TQ3Uns32 y = 0; y < mPaneHeight; ++y)
+		{
+			const TQ3Uns8*	srcRow = static_cast<const TQ3Uns8*>( mPixmap.image ) +
+				(mPaneTop + y) * mPixmap.rowBytes + mPaneLeft * bytesPerPixel;
+			
+			for (TQ3Uns32 x = 0; x < mPaneWidth; ++x)
+			{
+				TQ3Uns8	rgba[4];
+				ReadPixel( srcRow + x * bytesPerPixel, mPixmap.pixelType,
+					mPixmap.byteOrder, rgba );
+				
+				Color4&	theColor( dstColor[ y * mPaneWidth + x ] );
+				theColor.r = rgba[0] / 255.0f;
+				theColor.g = rgba[1] / 255.0f;
+				theColor.b = rgba[2] / 255.0f;
+				theColor.a = rgba[3] / 255.0f;
+			}
+		}
+	}
+}
+
+/*!
+	@function	EndPass
+	@abstract	Rasterize the queued triangles and copy the image to the
+				pixmap.
+*/
+TQ3ViewStatus		SWRenderer::Renderer::EndPass()
+{
+	mRasterizer.Render();
+	
+	const Color4*	srcColor = mRasterizer.ColorBuffer();
+	const TQ3Pixmap&	thePixmap( mPixmap );
+	const TQ3Uns32	paneLeft = mPaneLeft;
+	const TQ3Uns32	paneTop = mPaneTop;
+	const TQ3Uns32	paneWidth = mPaneWidth;
+	const TQ3Uns32	bytesPerPixel = BytesPerPixel( mPixmap.pixelType );
+	
+	E3Parallel_For( mPaneHeight, kRowsPerTask,
+		[&]( TQ3Uns32 inStart, TQ3Uns32 inEnd )
+		{
+			for (TQ3Uns32 y = inStart; y < inEnd; ++y)
+			{
+				TQ3Uns8*	dstRow = static_cast<TQ3Uns8*>( thePixmap.image ) +
+					(paneTop + y) * thePixmap.rowBytes + paneLeft * bytesPerPixel;
+				const Color4*	srcRow = srcColor + y * paneWidth;
+				
+				for (TQ3Uns32 x = 0; x < paneWidth; ++x)
+				{
+					WritePixel( srcRow[x], thePixmap.pixelType,
+						thePixmap.byteOrder, dstRow + x * bytesPerPixel );
+				}
+			}
+		} );
+	
+	return kQ3ViewStatusDone;
+}
+
+void	SWRenderer::Renderer::Cancel()
+{
+	mRasterizer.Cancel();
+}
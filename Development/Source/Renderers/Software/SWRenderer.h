@@ -0,0 +1,307 @@
+/*!
+	@header		SWRenderer.h
+	
+	This is the header for the main class of the Quesa software renderer.
+*/
+
+/*  NAME:
+        SWRenderer.h
+
+    DESCRIPTION:
+        Header for Quesa software renderer class.
+
+    COPYRIGHT:
+        Copyright (c) 2026, Quesa Developers. All rights reserved.
+
+        For the current release of Quesa, please see:
+
+            <https://github.com/jwwalker/Quesa>
+        
+        Redistribution and use in source and binary forms, with or without
+        modification, are permitted provided that the following conditions
+        are met:
+        
+            o Redistributions of source code must retain the above copyright
+              notice, this list of conditions and the following disclaimer.
+        
+            o Redistributions in binary form must reproduce the above
+              copyright notice, this list of conditions and the following
+              disclaimer in the documentation and/or other materials provided
+              with the distribution.
+        
+            o Neither the name of Quesa nor the names of its contributors
+              may be used to endorse or promote products derived from this
+              software without specific prior written permission.
+        
+        THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+        "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+        LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+        A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+        OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+        SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+        TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+        PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+        LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+        NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+        SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+    ___________________________________________________________________________
+*/
+#ifndef SWRENDERER_HDR
+#define SWRENDERER_HDR
+
+//=============================================================================
+//      Include files
+//-----------------------------------------------------------------------------
+
+#include "SWPrefix.h"
+#include "SWLights.h"
+#include "SWRasterizer.h"
+#include "SWTexture.h"
+
+
+
+//=============================================================================
+//      Class Declarations
+//-----------------------------------------------------------------------------
+
+namespace SWRenderer
+{
+
+/*!
+	@struct		ColorState
+	@abstract	Structure to hold current values of color-related attributes.
+*/
+struct ColorState
+{
+	void				Reset();
+
+	TQ3ColorRGB			diffuseColor;
+	TQ3ColorRGB			specularColor;
+	TQ3ColorRGB			emissiveColor;
+	float				specularControl;
+	float				metallic;
+	float				alpha;
+	TQ3Switch			highlightState;
+};
+
+/*!
+	@struct		TextureState
+	@abstract	Structure to hold the texture of the current texture shader,
+				and the shader parameters that go with it.
+*/
+struct TextureState
+{
+	void				Reset();
+
+	const Texture*		texture;
+	bool				wrapU;
+	bool				wrapV;
+	float				alphaTestThreshold;		// 0 for no alpha test
+	TQ3Matrix3x3		uvTransform;
+};
+
+/*!
+	@struct		StyleState
+	@abstract	Structure to hold current values of styles.
+*/
+struct StyleState
+{
+	TQ3InterpolationStyle	mInterpolation;
+	TQ3BackfacingStyle		mBackfacing;
+	TQ3OrientationStyle		mOrientation;
+	CQ3ObjectRef			mHilite;	
+};
+
+/*!
+	@class		Renderer
+	
+	@abstract	Main class of the software renderer.
+	
+	@discussion	The renderer draws into a pixmap draw context.  Geometry is
+				transformed, clipped and lit as it is submitted, and the
+				resulting triangles are queued in the Rasterizer.  At the end
+				of each pass the rasterizer fills the image on the threads of
+				E3Parallel, and the result is written to the pixmap.
+				
+				Points and lines are not drawn, and fill styles and fog are
+				ignored.
+*/
+class Renderer
+{
+protected:
+							Renderer( TQ3RendererObject inRenderer );
+							~Renderer();
+
+	friend class Statics;
+	
+	//
+	// Methods called by Statics
+	//
+	TQ3Status				StartFrame(
+									TQ3DrawContextObject inDrawContext );
+	
+	TQ3Status				EndFrame(
+									TQ3ViewObject inView );
+	
+	void					StartPass(
+									TQ3CameraObject inCamera,
+									TQ3GroupObject inLights );
+	
+	TQ3ViewStatus			EndPass();
+	
+	void					Cancel();
+	
+	bool					IsBoundingBoxVisible(
+									TQ3ViewObject inView,
+									const TQ3BoundingBox& inBounds );
+	
+	void					SubmitTriangle(
+									const TQ3TriangleData* inGeomData );
+	
+	void					SubmitTriMesh(
+									const TQ3TriMeshData* inGeomData );
+	
+	void					UpdateLocalToCamera(
+									const TQ3Matrix4x4& inMatrix );
+	
+	void					UpdateCameraToFrustum(
+									const TQ3Matrix4x4& inMatrix );
+	
+	void					UpdateDiffuseColor(
+									const TQ3ColorRGB* inAttColor );
+	
+	void					UpdateSpecularColor(
+									const TQ3ColorRGB* inAttColor );
+	
+	void					UpdateSpecularControl(
+									const float* inAttValue );
+	
+	void					UpdateMetallic(
+									const float* inAttValue );
+	
+	void					UpdateTransparencyColor(
+									const TQ3ColorRGB* inAttColor );
+	
+	void					UpdateEmissiveColor(
+									const TQ3ColorRGB* inAttColor );
+	
+	void					UpdateHiliteState(
+									const TQ3Switch* inAttHilite );
+	
+	void					UpdateSurfaceShader(
+									TQ3ShaderObject inShader );
+	
+	void					UpdateIlluminationShader(
+									TQ3ShaderObject inShader );
+	
+	void					UpdateInterpolationStyle(
+									const TQ3InterpolationStyle* inStyle );
+	
+	void					UpdateBackfacingStyle(
+									const TQ3BackfacingStyle* inStyle );
+	
+	void					UpdateOrientationStyle(
+									const TQ3OrientationStyle* inStyle );
+	
+	void					UpdateHighlightStyle(
+									const TQ3AttributeSet* inStyle );
+
+private:
+	/*!
+		@struct		InputVertex
+		@abstract	A vertex in camera space, with the attributes that it
+					brings to lighting.
+	*/
+	struct InputVertex
+	{
+		TQ3RationalPoint4D	clip;
+		TQ3Point3D			position;
+		TQ3Vector3D			normal;
+		TQ3ColorRGB			diffuse;
+		TQ3ColorRGB			emissive;
+		float				alpha;
+		TQ3Param2D			uv;
+	};
+	
+	/*!
+		@struct		ClipVertex
+		@abstract	A lit vertex in clip space.
+	*/
+	struct ClipVertex
+	{
+		TQ3RationalPoint4D	clip;
+		float				varying[ kNumVaryings ];
+	};
+	
+	void					HandleGeometryAttributes(
+									TQ3AttributeSet inGeomAttSet );
+	void					AdjustGeomState(
+									TQ3AttributeSet inAttSet );
+	void					SetTextureState(
+									TQ3ShaderObject inShader,
+									TextureState& outState );
+	TQ3Uns32				AddGeomMaterial( bool inIsTextured );
+	void					TransformVertex(
+									const TQ3Point3D& inPoint,
+									InputVertex& outVertex ) const;
+	void					TransformNormal(
+									const TQ3Vector3D& inNormal,
+									InputVertex& ioVertex ) const;
+	void					ApplyVertexAttributes(
+									TQ3AttributeSet inAtts,
+									InputVertex& ioVertex,
+									bool& outHasNormal,
+									bool& outHasUV ) const;
+	void					ShadeVertex(
+									const InputVertex& inVertex,
+									bool inIsTextured,
+									ClipVertex& outVertex ) const;
+	void					DrawTriangle(
+									InputVertex* ioVerts,
+									bool inHasVertexNormals,
+									bool inIsTextured,
+									TQ3Uns32 inMaterial );
+	TQ3Uns32				ClipPolygon(
+									TQ3Uns32 inClipCodes,
+									ClipVertex* ioPoly,
+									TQ3Uns32 inNumVerts,
+									ClipVertex* inScratch ) const;
+	void					ProjectVertex(
+									const ClipVertex& inVertex,
+									RasterVertex& outVertex ) const;
+	
+	TQ3RendererObject		mRendererObject;
+	
+	// Frame state
+	TQ3Pixmap				mPixmap;
+	TQ3Uns32				mPaneLeft;
+	TQ3Uns32				mPaneTop;
+	TQ3Uns32				mPaneWidth;
+	TQ3Uns32				mPaneHeight;
+	TQ3DrawContextClearImageMethod	mClearMethod;
+	Color4					mClearColor;
+	
+	// Matrix state
+	TQ3Matrix4x4			mLocalToCamera;
+	TQ3Matrix4x4			mCameraToFrustum;
+	TQ3Matrix4x4			mLocalToFrustum;
+	TQ3Matrix4x4			mNormalMatrix;
+	bool					mIsLocalViewer;
+	
+	// Attribute, shader and style state
+	ColorState				mViewState;
+	ColorState				mGeomState;
+	TextureState			mViewTexture;
+	TextureState			mGeomTexture;
+	StyleState				mStyleState;
+	TQ3ObjectType			mViewIllumination;
+	
+	Lights					mLights;
+	Rasterizer				mRasterizer;
+	TextureCache			mTextures;
+	std::vector<InputVertex>	mMeshVertices;
+};
+
+}
+
+#endif
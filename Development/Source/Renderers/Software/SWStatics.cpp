@@ -0,0 +1,640 @@
+/*  NAME:
+        SWStatics.cpp
+
+    DESCRIPTION:
+        Source for Quesa software renderer class.
+
+    COPYRIGHT:
+        Copyright (c) 2026, Quesa Developers. All rights reserved.
+
+        For the current release of Quesa, please see:
+
+            <https://github.com/jwwalker/Quesa>
+        
+        Redistribution and use in source and binary forms, with or without
+        modification, are permitted provided that the following conditions
+        are met:
+        
+            o Redistributions of source code must retain the above copyright
+              notice, this list of conditions and the following disclaimer.
+        
+            o Redistributions in binary form must reproduce the above
+              copyright notice, this list of conditions and the following
+              disclaimer in the documentation and/or other materials provided
+              with the distribution.
+        
+            o Neither the name of Quesa nor the names of its contributors
+              may be used to endorse or promote products derived from this
+              software without specific prior written permission.
+        
+        THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+        "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+        LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+        A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+        OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+        SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+        TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+        PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+        LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+        NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+        SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+    ___________________________________________________________________________
+*/
+
+
+//=============================================================================
+//      Include files
+//-----------------------------------------------------------------------------
+#include "SWRenderer.h"
+#include "SWStatics.h"
+
+
+
+//=============================================================================
+//      Local constants
+//-----------------------------------------------------------------------------
+
+namespace
+{
+	const char*	kSWRendererNickName = "Quesa Software";
+}
+
+
+
+//=============================================================================
+//      Local Functions
+//-----------------------------------------------------------------------------
+
+
+static TQ3Status
+SWRenderer_nickname(unsigned char *dataBuffer, TQ3Uns32 bufferSize, TQ3Uns32 *actualDataSize)
+{
+	// Return the amount of space we need
+    *actualDataSize = static_cast<TQ3Uns32>(strlen( kSWRendererNickName ) + 1);
+
+
+
+	// If we have a buffer, return the nick name
+	if (dataBuffer != nullptr)
+	{
+		// Clamp the buffer size
+		if (bufferSize < *actualDataSize)
+			*actualDataSize = bufferSize;
+
+
+		// Return the string
+		Q3Memory_Copy( kSWRendererNickName, dataBuffer, *actualDataSize );
+	}
+
+    return(kQ3Success);
+}
+
+
+
+//=============================================================================
+//      Method Implementations
+//-----------------------------------------------------------------------------
+
+TQ3Status	SWRenderer::Statics::ObjectNewMethod(
+									TQ3Object theObject,
+									void *privateData,
+									const void* /*paramData*/ )
+{
+	TQ3Status	status = kQ3Failure;
+	try
+	{
+		SWRenderer::Renderer*	theRenderer = new SWRenderer::Renderer( theObject );
+		*(SWRenderer::Renderer**)privateData = theRenderer;
+		status = kQ3Success;
+	}
+	catch (...)
+	{
+	}
+	return status;
+}
+
+void		SWRenderer::Statics::ObjectDeleteMethod(
+									TQ3Object /*object*/,
+                           			void* privateData )
+{
+	SWRenderer::Renderer*	theRenderer = *(SWRenderer::Renderer**)privateData;
+	
+	delete theRenderer;
+}
+
+TQ3Status	SWRenderer::Statics::StartFrameMethod(
+								TQ3ViewObject /*inView*/,
+								void* privateData,
+								TQ3DrawContextObject inDrawContext )
+{
+	SWRenderer::Renderer*	me = *(SWRenderer::Renderer**)privateData;
+	TQ3Status	result = kQ3Success;
+	try
+	{
+		result = me->StartFrame( inDrawContext );
+	}
+	catch (...)
+	{
+		result = kQ3Failure;
+	}
+	return result;
+}
+
+TQ3Status	SWRenderer::Statics::EndFrameMethod(
+								TQ3ViewObject inView,
+								void* privateData,
+								TQ3DrawContextObject /*inDrawContext*/ )
+{
+	SWRenderer::Renderer*	me = *(SWRenderer::Renderer**)privateData;
+	TQ3Status	result = kQ3Success;
+	try
+	{
+		result = me->EndFrame( inView );
+	}
+	catch (...)
+	{
+		result = kQ3Failure;
+	}
+	return result;
+}
+
+TQ3Status	SWRenderer::Statics::StartPassMethod(
+								TQ3ViewObject /*inView*/,
+								void* privateData,
+								TQ3CameraObject inCamera,
+								TQ3GroupObject inLights )
+{
+	SWRenderer::Renderer*	me = *(SWRenderer::Renderer**)privateData;
+	TQ3Status	result = kQ3Success;
+	try
+	{
+		me->StartPass( inCamera, inLights );
+	}
+	catch (...)
+	{
+		result = kQ3Failure;
+	}
+	return result;
+}
+
+TQ3ViewStatus	SWRenderer::Statics::EndPassMethod(
+								TQ3ViewObject /*inView*/,
+								void* privateData )
+{
+	TQ3ViewStatus	theStatus = kQ3ViewStatusError;
+	SWRenderer::Renderer*	me = *(SWRenderer::Renderer**)privateData;
+	try
+	{
+		theStatus = me->EndPass();
+	}
+	catch (...)
+	{
+	}
+	return theStatus;
+}
+
+void		SWRenderer::Statics::CancelMethod(
+								TQ3ViewObject /*inView*/,
+								void* privateData )
+{
+	SWRenderer::Renderer*	me = *(SWRenderer::Renderer**)privateData;
+	me->Cancel();
+}
+
+TQ3Boolean	SWRenderer::Statics::IsBoundingBoxVisibleMethod(
+									TQ3ViewObject           theView,
+		                            void                    *rendererPrivate,
+		                            const TQ3BoundingBox    *theBounds )
+{
+	TQ3Boolean	shouldSubmit = kQ3True;
+	SWRenderer::Renderer*	me = *(SWRenderer::Renderer**)rendererPrivate;
+	try
+	{
+		shouldSubmit = me->IsBoundingBoxVisible( theView, *theBounds )?
+			kQ3True : kQ3False;
+	}
+	catch (...)
+	{
+	}
+	return shouldSubmit;
+}
+
+TQ3Status	SWRenderer::Statics::SubmitTriMeshMethod(
+									TQ3ViewObject /*inView*/,
+									void* privateData,
+									TQ3GeometryObject /*inGeomObject*/,
+									const void* inGeomData )
+{
+	SWRenderer::Renderer*	me = *(SWRenderer::Renderer**)privateData;
+	TQ3Status	result = kQ3Success;
+	
+	try
+	{
+		me->SubmitTriMesh(
+			reinterpret_cast<const TQ3TriMeshData*>(inGeomData) );
+	}
+	catch (...)
+	{
+		result = kQ3Failure;
+	}
+	return result;
+}
+
+TQ3Status	SWRenderer::Statics::SubmitTriangleMethod(
+									TQ3ViewObject /*inView*/,
+									void* privateData,
+									TQ3GeometryObject /*inGeomObject*/,
+									const void* inGeomData )
+{
+	SWRenderer::Renderer*	me = *(SWRenderer::Renderer**)privateData;
+	TQ3Status	result = kQ3Success;
+	
+	try
+	{
+		me->SubmitTriangle(
+			reinterpret_cast<const TQ3TriangleData*>(inGeomData) );
+	}
+	catch (...)
+	{
+		result = kQ3Failure;
+	}
+	return result;
+}
+
+TQ3XRendererSubmitGeometryMethod SWRenderer::Statics::SubmitGeometrySubMetaHandler(
+    								TQ3ObjectType inGeomType )
+{
+	TQ3XRendererSubmitGeometryMethod	theMethod = nullptr;
+	
+	switch (inGeomType)
+	{
+		case kQ3GeometryTypeTriMesh:
+			theMethod = &SWRenderer::Statics::SubmitTriMeshMethod;
+			break;
+		
+		case kQ3GeometryTypeTriangle:
+			theMethod = &SWRenderer::Statics::SubmitTriangleMethod;
+			break;
+	}
+	
+	return theMethod;
+}
+
+TQ3Status	SWRenderer::Statics::UpdateLocalToCameraMethod(
+									TQ3ViewObject /*inView*/,
+									void* privateData,
+									const TQ3Matrix4x4* inMatrix )
+{
+	SWRenderer::Renderer*	me = *(SWRenderer::Renderer**)privateData;
+	me->UpdateLocalToCamera( *inMatrix );
+	return kQ3Success;
+}
+
+TQ3Status	SWRenderer::Statics::UpdateCameraToFrustumMethod(
+									TQ3ViewObject /*inView*/,
+									void* privateData,
+									const TQ3Matrix4x4* inMatrix )
+{
+	SWRenderer::Renderer*	me = *(SWRenderer::Renderer**)privateData;
+	me->UpdateCameraToFrustum( *inMatrix );
+	return kQ3Success;
+}
+
+TQ3XRendererUpdateMatrixMethod
+							SWRenderer::Statics::UpdateMatrixSubMetaHandler(
+									TQ3ObjectType inMatrixType )
+{
+	TQ3XRendererUpdateMatrixMethod	theMethod = nullptr;
+	
+	switch (inMatrixType)
+	{
+		case kQ3XMethodTypeRendererUpdateMatrixLocalToCamera:
+			theMethod = &SWRenderer::Statics::UpdateLocalToCameraMethod;
+			break;
+		
+		case kQ3XMethodTypeRendererUpdateMatrixCameraToFrustum:
+			theMethod = &SWRenderer::Statics::UpdateCameraToFrustumMethod;
+			break;
+	}
+	
+	return theMethod;
+}
+
+TQ3Status	SWRenderer::Statics::UpdateDiffuseColorMethod(
+									TQ3ViewObject /*inView*/,
+									void* privateData,
+									const void* inAttColor )
+{
+	SWRenderer::Renderer*	me = *(SWRenderer::Renderer**)privateData;
+	me->UpdateDiffuseColor( (const TQ3ColorRGB*) inAttColor );
+	return kQ3Success;
+}
+
+TQ3Status	SWRenderer::Statics::UpdateSpecularColorMethod(
+									TQ3ViewObject /*inView*/,
+									void* privateData,
+									const void* inAttColor )
+{
+	SWRenderer::Renderer*	me = *(SWRenderer::Renderer**)privateData;
+	me->UpdateSpecularColor( (const TQ3ColorRGB*) inAttColor );
+	return kQ3Success;
+}
+
+TQ3Status	SWRenderer::Statics::UpdateSpecularControlMethod(
+									TQ3ViewObject /*inView*/,
+									void* privateData,
+									const void* inAttValue )
+{
+	SWRenderer::Renderer*	me = *(SWRenderer::Renderer**)privateData;
+	me->UpdateSpecularControl( (const float*) inAttValue );
+	return kQ3Success;
+}
+
+TQ3Status	SWRenderer::Statics::UpdateMetallicMethod(
+									TQ3ViewObject /*inView*/,
+									void* privateData,
+									const void* inAttValue )
+{
+	SWRenderer::Renderer*	me = *(SWRenderer::Renderer**)privateData;
+	me->UpdateMetallic( (const float*) inAttValue );
+	return kQ3Success;
+}
+
+TQ3Status	SWRenderer::Statics::UpdateTransparencyColorMethod(
+									TQ3ViewObject /*inView*/,
+									void* privateData,
+									const void* inAttColor )
+{
+	SWRenderer::Renderer*	me = *(SWRenderer::Renderer**)privateData;
+	me->UpdateTransparencyColor( (const TQ3ColorRGB*) inAttColor );
+	return kQ3Success;
+}
+
+TQ3Status	SWRenderer::Statics::UpdateEmissiveColorMethod(
+									TQ3ViewObject /*inView*/,
+									void* privateData,
+									const void* inAttColor )
+{
+	SWRenderer::Renderer*	me = *(SWRenderer::Renderer**)privateData;
+	me->UpdateEmissiveColor( (const TQ3ColorRGB*) inAttColor );
+	return kQ3Success;
+}
+
+TQ3Status	SWRenderer::Statics::UpdateHiliteStateMethod(
+									TQ3ViewObject /*inView*/,
+									void* privateData,
+									const void* inAttState )
+{
+	SWRenderer::Renderer*	me = *(SWRenderer::Renderer**)privateData;
+	me->UpdateHiliteState( (const TQ3Switch*) inAttState );
+	return kQ3Success;
+}
+
+TQ3Status	SWRenderer::Statics::UpdateSurfaceShaderMethod(
+									TQ3ViewObject /*inView*/,
+									void* privateData,
+									TQ3ShaderObject* inAttShader )
+{
+	TQ3Status	result = kQ3Success;
+	SWRenderer::Renderer*	me = *(SWRenderer::Renderer**)privateData;
+	try
+	{
+		TQ3ShaderObject	theShader = (inAttShader == nullptr)? nullptr : *inAttShader;
+		me->UpdateSurfaceShader( theShader );
+	}
+	catch (...)
+	{
+		result = kQ3Failure;
+	}
+	return result;
+}
+
+TQ3Status	SWRenderer::Statics::UpdateIlluminationShaderMethod(
+									TQ3ViewObject /*inView*/,
+									void* privateData,
+									TQ3ShaderObject* inShader )
+{
+	SWRenderer::Renderer*	me = *(SWRenderer::Renderer**)privateData;
+	TQ3ShaderObject	theShader = (inShader == nullptr)? nullptr : *inShader;
+	me->UpdateIlluminationShader( theShader );
+	return kQ3Success;
+}
+
+TQ3XRendererUpdateAttributeMethod
+							SWRenderer::Statics::UpdateAttributeSubMetaHandler(
+									TQ3AttributeType inAttrType )
+{
+	TQ3XRendererUpdateAttributeMethod	theMethod = nullptr;
+	
+	switch (inAttrType)
+	{
+		case kQ3AttributeTypeDiffuseColor:
+			theMethod = (TQ3XRendererUpdateAttributeMethod)
+				&SWRenderer::Statics::UpdateDiffuseColorMethod;
+			break;
+		
+		case kQ3AttributeTypeSpecularColor:
+			theMethod = (TQ3XRendererUpdateAttributeMethod)
+				&SWRenderer::Statics::UpdateSpecularColorMethod;
+			break;
+		
+		case kQ3AttributeTypeSpecularControl:
+			theMethod = (TQ3XRendererUpdateAttributeMethod)
+				&SWRenderer::Statics::UpdateSpecularControlMethod;
+			break;
+		
+		case kQ3AttributeTypeMetallic:
+			theMethod = (TQ3XRendererUpdateAttributeMethod)
+				&SWRenderer::Statics::UpdateMetallicMethod;
+			break;
+		
+		case kQ3AttributeTypeTransparencyColor:
+			theMethod = (TQ3XRendererUpdateAttributeMethod)
+				&SWRenderer::Statics::UpdateTransparencyColorMethod;
+			break;
+		
+		case kQ3AttributeTypeEmissiveColor:
+			theMethod = (TQ3XRendererUpdateAttributeMethod)
+				&SWRenderer::Statics::UpdateEmissiveColorMethod;
+			break;
+		
+		case kQ3AttributeTypeHighlightState:
+			theMethod = (TQ3XRendererUpdateAttributeMethod)
+				&SWRenderer::Statics::UpdateHiliteStateMethod;
+			break;
+		
+		case kQ3AttributeTypeSurfaceShader:
+			theMethod = (TQ3XRendererUpdateAttributeMethod)
+				&SWRenderer::Statics::UpdateSurfaceShaderMethod;
+			break;
+	}
+	
+	return theMethod;
+}
+
+TQ3XRendererUpdateShaderMethod
+							SWRenderer::Statics::UpdateShaderSubMetaHandler(
+									TQ3ObjectType inShaderType )
+{
+	TQ3XRendererUpdateShaderMethod	theMethod = nullptr;
+	
+	switch (inShaderType)
+	{
+		case kQ3ShaderTypeIllumination:
+			theMethod = &SWRenderer::Statics::UpdateIlluminationShaderMethod;
+			break;
+		
+		case kQ3ShaderTypeSurface:
+			theMethod = &SWRenderer::Statics::UpdateSurfaceShaderMethod;
+			break;
+	}
+	
+	return theMethod;
+}
+
+TQ3Status	SWRenderer::Statics::UpdateInterpolationStyleMethod(
+								TQ3ViewObject /*inView*/,
+								void* privateData,
+								const void* publicData )
+{
+	SWRenderer::Renderer*	me = *(SWRenderer::Renderer**)privateData;
+	me->UpdateInterpolationStyle( (const TQ3InterpolationStyle*) publicData );
+	return kQ3Success;
+}
+
+TQ3Status	SWRenderer::Statics::UpdateBackfacingStyleMethod(
+								TQ3ViewObject /*inView*/,
+								void* privateData,
+								const void* publicData )
+{
+	SWRenderer::Renderer*	me = *(SWRenderer::Renderer**)privateData;
+	me->UpdateBackfacingStyle( (const TQ3BackfacingStyle*) publicData );
+	return kQ3Success;
+}
+
+TQ3Status	SWRenderer::Statics::UpdateOrientationStyleMethod(
+								TQ3ViewObject /*inView*/,
+								void* privateData,
+								const void* publicData )
+{
+	SWRenderer::Renderer*	me = *(SWRenderer::Renderer**)privateData;
+	me->UpdateOrientationStyle( (const TQ3OrientationStyle*) publicData );
+	return kQ3Success;
+}
+
+TQ3Status	SWRenderer::Statics::UpdateHighlightStyleMethod(
+								TQ3ViewObject /*inView*/,
+								void* privateData,
+								const void* publicData )
+{
+	SWRenderer::Renderer*	me = *(SWRenderer::Renderer**)privateData;
+	me->UpdateHighlightStyle( (const TQ3AttributeSet*) publicData );
+	return kQ3Success;
+}
+
+TQ3XRendererUpdateStyleMethod
+							SWRenderer::Statics::UpdateStyleSubMetaHandler(
+									TQ3ObjectType inStyleType )
+{
+	TQ3XRendererUpdateStyleMethod	theMethod = nullptr;
+	
+	switch (inStyleType)
+	{
+		case kQ3StyleTypeInterpolation:
+			theMethod = (TQ3XRendererUpdateStyleMethod)
+				&SWRenderer::Statics::UpdateInterpolationStyleMethod;
+			break;
+		
+		case kQ3StyleTypeBackfacing:
+			theMethod = (TQ3XRendererUpdateStyleMethod)
+				&SWRenderer::Statics::UpdateBackfacingStyleMethod;
+			break;
+		
+		case kQ3StyleTypeOrientation:
+			theMethod = (TQ3XRendererUpdateStyleMethod)
+				&SWRenderer::Statics::UpdateOrientationStyleMethod;
+			break;
+		
+		case kQ3StyleTypeHighlight:
+			theMethod = (TQ3XRendererUpdateStyleMethod)
+				&SWRenderer::Statics::UpdateHighlightStyleMethod;
+			break;
+	}
+	
+	return theMethod;
+}
+
+TQ3XFunctionPointer		SWRenderer::Statics::MetaHandler( TQ3XMethodType inMethodType )
+{
+	TQ3XFunctionPointer		theMethod = nullptr;
+	
+	switch (inMethodType)
+	{
+		case kQ3XMethodTypeObjectNew:
+			theMethod = (TQ3XFunctionPointer) &SWRenderer::Statics::ObjectNewMethod;
+			break;
+		
+		case kQ3XMethodTypeObjectDelete:
+			theMethod = (TQ3XFunctionPointer) &SWRenderer::Statics::ObjectDeleteMethod;
+			break;
+		
+		case kQ3XMethodTypeRendererGetNickNameString:
+			theMethod = (TQ3XFunctionPointer) &SWRenderer_nickname;
+			break;
+		
+		case kQ3XMethodTypeRendererIsInteractive:
+			theMethod = (TQ3XFunctionPointer) kQ3True;
+			break;
+		
+		case kQ3XMethodTypeRendererIsBoundingBoxVisible:
+			theMethod = (TQ3XFunctionPointer) &SWRenderer::Statics::IsBoundingBoxVisibleMethod;
+			break;
+		
+		case kQ3XMethodTypeRendererStartFrame:
+			theMethod = (TQ3XFunctionPointer) &SWRenderer::Statics::StartFrameMethod;
+			break;
+		
+		case kQ3XMethodTypeRendererEndFrame:
+			theMethod = (TQ3XFunctionPointer) &SWRenderer::Statics::EndFrameMethod;
+			break;
+		
+		case kQ3XMethodTypeRendererStartPass:
+			theMethod = (TQ3XFunctionPointer) &SWRenderer::Statics::StartPassMethod;
+			break;
+		
+		case kQ3XMethodTypeRendererEndPass:
+			theMethod = (TQ3XFunctionPointer) &SWRenderer::Statics::EndPassMethod;
+			break;
+		
+		case kQ3XMethodTypeRendererCancel:
+			theMethod = (TQ3XFunctionPointer) &SWRenderer::Statics::CancelMethod;
+			break;
+		
+		case kQ3XMethodTypeRendererSubmitGeometryMetaHandler:
+			theMethod = (TQ3XFunctionPointer)
+				&SWRenderer::Statics::SubmitGeometrySubMetaHandler;
+			break;
+		
+		case kQ3XMethodTypeRendererUpdateMatrixMetaHandler:
+			theMethod = (TQ3XFunctionPointer)
+				&SWRenderer::Statics::UpdateMatrixSubMetaHandler;
+			break;
+		
+		case kQ3XMethodTypeRendererUpdateAttributeMetaHandler:
+			theMethod = (TQ3XFunctionPointer)
+				&SWRenderer::Statics::UpdateAttributeSubMetaHandler;
+			break;
+		
+		case kQ3XMethodTypeRendererUpdateShaderMetaHandler:
+			theMethod = (TQ3XFunctionPointer)
+				&SWRenderer::Statics::UpdateShaderSubMetaHandler;
+			break;
+		
+		case kQ3XMethodTypeRendererUpdateStyleMetaHandler:
+			theMethod = (TQ3XFunctionPointer)
+				&SWRenderer::Statics::UpdateStyleSubMetaHandler;
+			break;
+	}
+	
+	return theMethod;
+}
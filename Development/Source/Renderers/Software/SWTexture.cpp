@@ -0,0 +1,630 @@
+/*  NAME:
+        SWTexture.cpp
+
+    DESCRIPTION:
+        Source for textures in the Quesa software renderer.
+
+    COPYRIGHT:
+        Copyright (c) 2026, Quesa Developers. All rights reserved.
+
+        For the current release of Quesa, please see:
+
+            <https://github.com/jwwalker/Quesa>
+        
+        Redistribution and use in source and binary forms, with or without
+        modification, are permitted provided that the following conditions
+        are met:
+        
+            o Redistributions of source code must retain the above copyright
+              notice, this list of conditions and the following disclaimer.
+        
+            o Redistributions in binary form must reproduce the above
+              copyright notice, this list of conditions and the following
+              disclaimer in the documentation and/or other materials provided
+              with the distribution.
+        
+            o Neither the name of Quesa nor the names of its contributors
+              may be used to endorse or promote products derived from this
+              software without specific prior written permission.
+        
+        THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+        "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+        LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+        A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+        OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+        SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+        TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+        PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+        LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+        NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+        SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+    ___________________________________________________________________________
+*/
+//=============================================================================
+//      Include files
+//-----------------------------------------------------------------------------
+#include "SWTexture.h"
+
+#include "QuesaCustomElements.h"
+#include "QuesaShader.h"
+#include "QuesaStorage.h"
+
+#include <algorithm>
+#include <cmath>
+
+
+
+//=============================================================================
+//      Local Functions
+//-----------------------------------------------------------------------------
+
+namespace
+{
+	inline TQ3Uns32	ReadUns16( const TQ3Uns8* inSrc, TQ3Endian inByteOrder )
+	{
+		return (inByteOrder == kQ3EndianBig)?
+			((((TQ3Uns32) inSrc[0]) << 8) | inSrc[1]) :
+			((((TQ3Uns32) inSrc[1]) << 8) | inSrc[0]);
+	}
+	
+	inline void		WriteUns16( TQ3Uns32 inValue, TQ3Endian inByteOrder,
+								TQ3Uns8* outDst )
+	{
+		if (inByteOrder == kQ3EndianBig)
+		{
+			outDst[0] = (TQ3Uns8) (inValue >> 8);
+			outDst[1] = (TQ3Uns8) inValue;
+		}
+		else
+		{
+			outDst[0] = (TQ3Uns8) inValue;
+			outDst[1] = (TQ3Uns8) (inValue >> 8);
+		}
+	}
+	
+	inline TQ3Uns32	ToBits( float inValue, TQ3Uns32 inMax )
+	{
+		if (inValue <= 0.0f)
+			return 0;
+		if (inValue >= 1.0f)
+			return inMax;
+		return (TQ3Uns32) (inValue * inMax + 0.5f);
+	}
+	
+	inline TQ3Int32	WrapIndex( TQ3Int32 inIndex, TQ3Int32 inSize )
+	{
+		inIndex %= inSize;
+		return (inIndex < 0)? inIndex + inSize : inIndex;
+	}
+	
+	inline TQ3Int32	ClampIndex( TQ3Int32 inIndex, TQ3Int32 inSize )
+	{
+		return (inIndex < 0)? 0 : ((inIndex >= inSize)? inSize - 1 : inIndex);
+	}
+	
+	/*!
+		@function	CountImagesInMipmap
+		@abstract	The images of a mipmap are halved in size, down to 1 by 1.
+	*/
+	int		CountImagesInMipmap( const TQ3Mipmap& inMipmap )
+	{
+		int	numImages = 1;
+		
+		if (inMipmap.useMipmapping == kQ3True)
+		{
+			TQ3Uns32 n = std::max( inMipmap.mipmaps[0].width,
+				inMipmap.mipmaps[0].height );
+			
+			while ( (n > 1) && (numImages < 32) )
+			{
+				n /= 2;
+				numImages += 1;
+			}
+		}
+		
+		return numImages;
+	}
+}
+
+
+
+//=============================================================================
+//      Pixel Conversion
+//-----------------------------------------------------------------------------
+
+TQ3Uns32	SWRenderer::BytesPerPixel( TQ3PixelType inPixelType )
+{
+	TQ3Uns32	theSize = 0;
+	
+	switch (inPixelType)
+	{
+		case kQ3PixelTypeRGB32:
+		case kQ3PixelTypeARGB32:
+			theSize = 4;
+			break;
+		
+		case kQ3PixelTypeRGB24:
+			theSize = 3;
+			break;
+		
+		case kQ3PixelTypeRGB16:
+		case kQ3PixelTypeARGB16:
+		case kQ3PixelTypeRGB16_565:
+			theSize = 2;
+			break;
+		
+		default:
+			break;
+	}
+	
+	return theSize;
+}
+
+void	SWRenderer::ReadPixel(
+							const TQ3Uns8* inSrc,
+							TQ3PixelType inPixelType,
+							TQ3Endian inByteOrder,
+							TQ3Uns8* outRGBA )
+{
+	bool		isBig = (inByteOrder == kQ3EndianBig);
+	TQ3Uns32	value;
+	
+	switch (inPixelType)
+	{
+		case kQ3PixelTypeRGB32:
+		case kQ3PixelTypeARGB32:
+			if (isBig)
+			{
+				outRGBA[0] = inSrc[1];
+				outRGBA[1] = inSrc[2];
+				outRGBA[2] = inSrc[3];
+				outRGBA[3] = inSrc[0];
+			}
+			else
+			{
+				outRGBA[0] = inSrc[2];
+				outRGBA[1] = inSrc[1];
+				outRGBA[2] = inSrc[0];
+				outRGBA[3] = inSrc[3];
+			}
+			if (inPixelType == kQ3PixelTypeRGB32)
+				outRGBA[3] = 0xFF;
+			break;
+		
+		case kQ3PixelTypeRGB24:
+			outRGBA[0] = isBig? inSrc[0] : inSrc[2];
+			outRGBA[1] = inSrc[1];
+			outRGBA[2] = isBig? inSrc[2] : inSrc[0];
+			outRGBA[3] = 0xFF;
+			break;
+		
+		case kQ3PixelTypeRGB16:
+		case kQ3PixelTypeARGB16:
+			value = ReadUns16( inSrc, inByteOrder );
+			outRGBA[0] = (TQ3Uns8) (((value >> 10) & 0x1F) << 3);
+			outRGBA[1] = (TQ3Uns8) (((value >>  5) & 0x1F) << 3);
+			outRGBA[2] = (TQ3Uns8) (((value >>  0) & 0x1F) << 3);
+			outRGBA[3] = ((inPixelType == kQ3PixelTypeRGB16) || ((value & 0x8000) != 0))?
+				0xFF : 0;
+			break;
+		
+		case kQ3PixelTypeRGB16_565:
+			value = ReadUns16( inSrc, inByteOrder );
+			outRGBA[0] = (TQ3Uns8) (((value >> 11) & 0x1F) << 3);
+			outRGBA[1] = (TQ3Uns8) (((value >>  5) & 0x3F) << 2);
+			outRGBA[2] = (TQ3Uns8) (((value >>  0) & 0x1F) << 3);
+			outRGBA[3] = 0xFF;
+			break;
+		
+		default:
+			outRGBA[0] = outRGBA[1] = outRGBA[2] = outRGBA[3] = 0xFF;
+			break;
+	}
+}
+
+void	SWRenderer::WritePixel(
+							const Color4& inColor,
+							TQ3PixelType inPixelType,
+							TQ3Endian inByteOrder,
+							TQ3Uns8* outDst )
+{
+	bool		isBig = (inByteOrder == kQ3EndianBig);
+	TQ3Uns32	value;
+	
+	switch (inPixelType)
+	{
+		case kQ3PixelTypeRGB32:
+		case kQ3PixelTypeARGB32:
+			{
+				TQ3Uns8	a = (inPixelType == kQ3PixelTypeARGB32)?
+					(TQ3Uns8) ToBits( inColor.a, 0xFF ) : 0xFF;
+				if (isBig)
+				{
+					outDst[0] = a;
+					outDst[1] = (TQ3Uns8) ToBits( inColor.r, 0xFF );
+					outDst[2] = (TQ3Uns8) ToBits( inColor.g, 0xFF );
+					outDst[3] = (TQ3Uns8) ToBits( inColor.b, 0xFF );
+				}
+				else
+				{
+					outDst[0] = (TQ3Uns8) ToBits( inColor.b, 0xFF );
+					outDst[1] = (TQ3Uns8) ToBits( inColor.g, 0xFF );
+					outDst[2] = (TQ3Uns8) ToBits( inColor.r, 0xFF );
+					outDst[3] = a;
+				}
+			}
+			break;
+		
+		case kQ3PixelTypeRGB24:
+			outDst[isBig? 0 : 2] = (TQ3Uns8) ToBits( inColor.r, 0xFF );
+			outDst[1]            = (TQ3Uns8) ToBits( inColor.g, 0xFF );
+			outDst[isBig? 2 : 0] = (TQ3Uns8) ToBits( inColor.b, 0xFF );
+			break;
+		
+		case kQ3PixelTypeRGB16:
+		case kQ3PixelTypeARGB16:
+			value = (ToBits( inColor.r, 0x1F ) << 10) |
+					(ToBits( inColor.g, 0x1F ) << 5) |
+					ToBits( inColor.b, 0x1F );
+			if ( (inPixelType == kQ3PixelTypeRGB16) || (inColor.a >= 0.5f) )
+				value |= 0x8000;
+			WriteUns16( value, inByteOrder, outDst );
+			break;
+		
+		case kQ3PixelTypeRGB16_565:
+			value = (ToBits( inColor.r, 0x1F ) << 11) |
+					(ToBits( inColor.g, 0x3F ) << 5) |
+					ToBits( inColor.b, 0x1F );
+			WriteUns16( value, inByteOrder, outDst );
+			break;
+		
+		default:
+			break;
+	}
+}
+
+
+
+//=============================================================================
+//      Texture Implementation
+//-----------------------------------------------------------------------------
+
+SWRenderer::Texture::Texture()
+	: mHasAlpha( false )
+{
+}
+
+bool	SWRenderer::Texture::Load( TQ3TextureObject inTexture )
+{
+	mLevels.clear();
+	mHasAlpha = false;
+	
+	bool	didLoad = false;
+	bool	rowsAreFlipped = (CETextureFlippedRowsElement_IsPresent( inTexture ) == kQ3True);
+	
+	switch (Q3Texture_GetType( inTexture ))
+	{
+		case kQ3TextureTypePixmap:
+			{
+				TQ3StoragePixmap	thePixmap;
+				if (kQ3Success == Q3PixmapTexture_GetPixmap( inTexture, &thePixmap ))
+				{
+					CQ3ObjectRef	storageHolder( thePixmap.image );
+					
+					if (kQ3Success == Q3Storage_Open( thePixmap.image, kQ3False ))
+					{
+						didLoad = AddLevel( thePixmap.image, 0, thePixmap.pixelType,
+							thePixmap.byteOrder, thePixmap.width, thePixmap.height,
+							thePixmap.rowBytes, rowsAreFlipped );
+						
+						Q3Storage_Close( thePixmap.image );
+					}
+					
+					// Pixmap textures are mipmapped automatically
+					if (didLoad)
+					{
+						BuildMipmaps();
+						mHasAlpha = (thePixmap.pixelType == kQ3PixelTypeARGB32) ||
+							(thePixmap.pixelType == kQ3PixelTypeARGB16);
+					}
+				}
+			}
+			break;
+		
+		case kQ3TextureTypeMipmap:
+			{
+				TQ3Mipmap	theMipmap;
+				if (kQ3Success == Q3MipmapTexture_GetMipmap( inTexture, &theMipmap ))
+				{
+					CQ3ObjectRef	storageHolder( theMipmap.image );
+					
+					if (kQ3Success == Q3Storage_Open( theMipmap.image, kQ3False ))
+					{
+						int	numImages = CountImagesInMipmap( theMipmap );
+						didLoad = true;
+						
+						for (int i = 0; didLoad && (i < numImages); ++i)
+						{
+							didLoad = AddLevel( theMipmap.image,
+								theMipmap.mipmaps[i].offset, theMipmap.pixelType,
+								theMipmap.byteOrder, theMipmap.mipmaps[i].width,
+								theMipmap.mipmaps[i].height,
+								theMipmap.mipmaps[i].rowBytes, rowsAreFlipped );
+						}
+						
+						Q3Storage_Close( theMipmap.image );
+					}
+					
+					if (didLoad)
+					{
+						mHasAlpha = (theMipmap.pixelType == kQ3PixelTypeARGB32) ||
+							(theMipmap.pixelType == kQ3PixelTypeARGB16);
+					}
+				}
+			}
+			break;
+		
+		default:
+			break;
+	}
+	
+	if (! didLoad)
+	{
+		mLevels.clear();
+	}
+	
+	return didLoad;
+}
+
+bool	SWRenderer::Texture::AddLevel(
+								TQ3StorageObject inStorage,
+								TQ3Uns32 inOffset,
+								TQ3PixelType inPixelType,
+								TQ3Endian inByteOrder,
+								TQ3Uns32 inWidth,
+								TQ3Uns32 inHeight,
+								TQ3Uns32 inRowBytes,
+								bool inRowsAreFlipped )
+{
+	TQ3Uns32	pixelBytes = BytesPerPixel( inPixelType );
+	
+	if ( (pixelBytes == 0) || (inWidth == 0) || (inHeight == 0) ||
+		(inRowBytes < inWidth * pixelBytes) )
+	{
+		return false;
+	}
+	
+	
+	// Get at the image, without copying it if it is in memory
+	TQ3Uns32				dataSize = inRowBytes * inHeight;
+	const TQ3Uns8*			srcData = nullptr;
+	std::vector<TQ3Uns8>	readBuffer;
+	
+	if (Q3Object_IsType( inStorage, kQ3StorageTypeMemory ))
+	{
+		TQ3Uns8*	bufferAddr = nullptr;
+		TQ3Uns32	bufferSize = 0;
+		Q3MemoryStorage_GetBuffer( inStorage, &bufferAddr, nullptr, &bufferSize );
+		if ( (bufferAddr != nullptr) && (inOffset + dataSize <= bufferSize) )
+		{
+			srcData = bufferAddr + inOffset;
+		}
+	}
+	else
+	{
+		TQ3Uns32	sizeRead = 0;
+		readBuffer.resize( dataSize );
+		if ( (kQ3Success == Q3Storage_GetData( inStorage, inOffset, dataSize,
+			readBuffer.data(), &sizeRead )) && (sizeRead == dataSize) )
+		{
+			srcData = readBuffer.data();
+		}
+	}
+	
+	if (srcData == nullptr)
+	{
+		return false;
+	}
+	
+	
+	// Convert to RGBA, turning the rows upside down unless they already are
+	mLevels.emplace_back();
+	Level&	theLevel( mLevels.back() );
+	theLevel.width = inWidth;
+	theLevel.height = inHeight;
+	theLevel.texels.resize( 4 * inWidth * inHeight );
+	
+	for (TQ3Uns32 row = 0; row < inHeight; ++row)
+	{
+		const TQ3Uns8*	srcRow = srcData + inRowBytes *
+			(inRowsAreFlipped? row : inHeight - 1 - row);
+		TQ3Uns8*		dstRow = &theLevel.texels[ 4 * inWidth * row ];
+		
+		for (TQ3Uns32 col = 0; col < inWidth; ++col)
+		{
+			ReadPixel( srcRow + col * pixelBytes, inPixelType, inByteOrder,
+				dstRow + 4 * col );
+		}
+	}
+	
+	return true;
+}
+
+void	SWRenderer::Texture::BuildMipmaps()
+{
+	while ( (mLevels.back().width > 1) || (mLevels.back().height > 1) )
+	{
+		const Level&	src( mLevels.back() );
+		Level			dst;
+		dst.width = std::max( src.width / 2, 1U );
+		dst.height = std::max( src.height / 2, 1U );
+		dst.texels.resize( 4 * dst.width * dst.height );
+		
+		TQ3Uns32	lastX = src.width - 1;
+		TQ3Uns32	lastY = src.height - 1;
+		
+		for (TQ3Uns32 y = 0; y < dst.height; ++y)
+		{
+			const TQ3Uns8*	row0 = &src.texels[ 4 * src.width * std::min( 2 * y, lastY ) ];
+			const TQ3Uns8*	row1 = &src.texels[ 4 * src.width * std::min( 2 * y + 1, lastY ) ];
+			TQ3Uns8*		dstRow = &dst.texels[ 4 * dst.width * y ];
+			
+			for (TQ3Uns32 x = 0; x < dst.width; ++x)
+			{
+				TQ3Uns32	x0 = 4 * std::min( 2 * x, lastX );
+				TQ3Uns32	x1 = 4 * std::min( 2 * x + 1, lastX );
+				
+				for (TQ3Uns32 c = 0; c < 4; ++c)
+				{
+					dstRow[ 4 * x + c ] = (TQ3Uns8) ((row0[x0 + c] + row0[x1 + c] +
+						row1[x0 + c] + row1[x1 + c] + 2) / 4);
+				}
+			}
+		}
+		
+		mLevels.push_back( std::move( dst ) );
+	}
+}
+
+void	SWRenderer::Texture::Sample(
+								float inU,
+								float inV,
+								int inLevel,
+								bool inWrapU,
+								bool inWrapV,
+								Color4& outColor ) const
+{
+	if (mLevels.empty())
+	{
+		outColor.r = outColor.g = outColor.b = outColor.a = 1.0f;
+		return;
+	}
+	
+	inLevel = std::max( 0, std::min( inLevel, CountLevels() - 1 ) );
+	const Level&	theLevel( mLevels[ inLevel ] );
+	TQ3Int32		width = (TQ3Int32) theLevel.width;
+	TQ3Int32		height = (TQ3Int32) theLevel.height;
+	
+	
+	// Bring the coordinates into range before converting them to integers
+	if (inWrapU)
+		inU -= std::floor( inU );
+	else
+		inU = std::max( 0.0f, std::min( inU, 1.0f ) );
+	
+	if (inWrapV)
+		inV -= std::floor( inV );
+	else
+		inV = std::max( 0.0f, std::min( inV, 1.0f ) );
+	
+	float		x = inU * width - 0.5f;
+	float		y = inV * height - 0.5f;
+	float		fx = std::floor( x );
+	float		fy = std::floor( y );
+	float		tx = x - fx;
+	float		ty = y - fy;
+	TQ3Int32	x0 = (TQ3Int32) fx;
+	TQ3Int32	y0 = (TQ3Int32) fy;
+	TQ3Int32	x1 = x0 + 1;
+	TQ3Int32	y1 = y0 + 1;
+	
+	if (inWrapU)
+	{
+		x0 = WrapIndex( x0, width );
+		x1 = WrapIndex( x1, width );
+	}
+	else
+	{
+		x0 = ClampIndex( x0, width );
+		x1 = ClampIndex( x1, width );
+	}
+	
+	if (inWrapV)
+	{
+		y0 = WrapIndex( y0, height );
+		y1 = WrapIndex( y1, height );
+	}
+	else
+	{
+		y0 = ClampIndex( y0, height );
+		y1 = ClampIndex( y1, height );
+	}
+	
+	
+	// Blend the four texels
+	const TQ3Uns8*	t00 = &theLevel.texels[ 4 * (y0 * width + x0) ];
+	const TQ3Uns8*	t10 = &theLevel.texels[ 4 * (y0 * width + x1) ];
+	const TQ3Uns8*	t01 = &theLevel.texels[ 4 * (y1 * width + x0) ];
+	const TQ3Uns8*	t11 = &theLevel.texels[ 4 * (y1 * width + x1) ];
+	float			w00 = (1.0f - tx) * (1.0f - ty) * (1.0f / 255.0f);
+	float			w10 = tx * (1.0f - ty) * (1.0f / 255.0f);
+	float			w01 = (1.0f - tx) * ty * (1.0f / 255.0f);
+	float			w11 = tx * ty * (1.0f / 255.0f);
+	
+	outColor.r = w00 * t00[0] + w10 * t10[0] + w01 * t01[0] + w11 * t11[0];
+	outColor.g = w00 * t00[1] + w10 * t10[1] + w01 * t01[1] + w11 * t11[1];
+	outColor.b = w00 * t00[2] + w10 * t10[2] + w01 * t01[2] + w11 * t11[2];
+	outColor.a = w00 * t00[3] + w10 * t10[3] + w01 * t01[3] + w11 * t11[3];
+}
+
+
+
+//=============================================================================
+//      TextureCache Implementation
+//-----------------------------------------------------------------------------
+
+/*!
+	@function	Find
+	@abstract	Get the converted form of a texture, converting it if need be.
+	@result		The texture, or nullptr if it could not be converted.
+*/
+const SWRenderer::Texture*	SWRenderer::TextureCache::Find( TQ3TextureObject inTexture )
+{
+	TQ3Uns32	editIndex = Q3Shared_GetEditIndex( inTexture );
+	
+	auto	found = std::find_if( mEntries.begin(), mEntries.end(),
+		[inTexture]( const Entry& inEntry ) { return inEntry.texture.get() == inTexture; } );
+	
+	if (found != mEntries.end())
+	{
+		if (found->editIndex == editIndex)
+		{
+			return found->data.get();
+		}
+		
+		// The texture has changed, but triangles queued earlier in this
+		// frame may still point at the old data.
+		mRetired.push_back( std::move( found->data ) );
+		mEntries.erase( found );
+	}
+	
+	
+	std::unique_ptr<Texture>	theData( new Texture );
+	if (! theData->Load( inTexture ))
+	{
+		return nullptr;
+	}
+	
+	Entry	newEntry;
+	newEntry.texture = CQ3WeakObjectRef( inTexture );
+	newEntry.editIndex = editIndex;
+	newEntry.data = std::move( theData );
+	mEntries.push_back( std::move( newEntry ) );
+	
+	return mEntries.back().data.get();
+}
+
+/*!
+	@function	StartFrame
+	@abstract	Forget textures that have been disposed.
+*/
+void	SWRenderer::TextureCache::StartFrame()
+{
+	mRetired.clear();
+	
+	mEntries.erase( std::remove_if( mEntries.begin(), mEntries.end(),
+		[]( const Entry& inEntry )
+		{
+			return ! inEntry.texture.isvalid();
+		} ), mEntries.end() );
+}
@@ -0,0 +1,203 @@
+/*!
+	@header		SWTexture.h
+	
+	Texture class for use in Quesa software renderer.
+*/
+
+/*  NAME:
+        SWTexture.h
+
+    DESCRIPTION:
+        Header for textures in the Quesa software renderer.
+
+    COPYRIGHT:
+        Copyright (c) 2026, Quesa Developers. All rights reserved.
+
+        For the current release of Quesa, please see:
+
+            <https://github.com/jwwalker/Quesa>
+        
+        Redistribution and use in source and binary forms, with or without
+        modification, are permitted provided that the following conditions
+        are met:
+        
+            o Redistributions of source code must retain the above copyright
+              notice, this list of conditions and the following disclaimer.
+        
+            o Redistributions in binary form must reproduce the above
+              copyright notice, this list of conditions and the following
+              disclaimer in the documentation and/or other materials provided
+              with the distribution.
+        
+            o Neither the name of Quesa nor the names of its contributors
+              may be used to endorse or promote products derived from this
+              software without specific prior written permission.
+        
+        THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+        "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+        LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+        A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+        OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+        SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+        TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+        PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+        LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+        NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+        SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+    ___________________________________________________________________________
+*/
+#ifndef SWTEXTURE_HDR
+#define SWTEXTURE_HDR
+
+//=============================================================================
+//      Include files
+//-----------------------------------------------------------------------------
+
+#include "SWPrefix.h"
+#include "CQ3WeakObjectRef.h"
+
+#include <memory>
+
+
+
+//=============================================================================
+//      Class Declarations
+//-----------------------------------------------------------------------------
+
+namespace SWRenderer
+{
+
+/*!
+	@function	BytesPerPixel
+	@abstract	Size of a pixel of a given type, or 0 if it is not known.
+*/
+TQ3Uns32	BytesPerPixel( TQ3PixelType inPixelType );
+
+/*!
+	@function	ReadPixel
+	@abstract	Convert a pixel of a pixmap to 8-bit RGBA.
+	@discussion	Pixel types without alpha are read as opaque.
+*/
+void		ReadPixel(
+					const TQ3Uns8* inSrc,
+					TQ3PixelType inPixelType,
+					TQ3Endian inByteOrder,
+					TQ3Uns8* outRGBA );
+
+/*!
+	@function	WritePixel
+	@abstract	Store a color, clamped to [0, 1], as a pixel of a pixmap.
+*/
+void		WritePixel(
+					const Color4& inColor,
+					TQ3PixelType inPixelType,
+					TQ3Endian inByteOrder,
+					TQ3Uns8* outDst );
+
+
+
+/*!
+	@class		Texture
+	
+	@abstract	A Quesa pixmap or mipmap texture, converted to 8-bit RGBA
+				images ready for sampling.
+	
+	@discussion	Rows are stored bottom to top, so that v = 0 is the first
+				row.  Pixmap textures get a chain of box filtered mipmap
+				images, mipmap textures use the images they provide.
+				
+				Once loaded, a texture is plain data, so it can be sampled
+				from several threads at once.
+*/
+class Texture
+{
+public:
+							Texture();
+	
+	/*!
+		@function	Load
+		@abstract	Convert the image data of a texture object.
+		@result		True if the texture type and pixel type are supported.
+	*/
+	bool					Load( TQ3TextureObject inTexture );
+	
+	/*!
+		@function	Sample
+		@abstract	Look up a color with bilinear filtering.
+		@param		inU			U coordinate.
+		@param		inV			V coordinate.
+		@param		inLevel		Mipmap level, clamped to the levels
+								that exist.
+		@param		inWrapU		Whether U wraps rather than clamps.
+		@param		inWrapV		Whether V wraps rather than clamps.
+		@param		outColor	Receives the color.
+	*/
+	void					Sample(
+									float inU,
+									float inV,
+									int inLevel,
+									bool inWrapU,
+									bool inWrapV,
+									Color4& outColor ) const;
+	
+	TQ3Uns32				Width() const { return mLevels.empty()? 0 : mLevels[0].width; }
+	TQ3Uns32				Height() const { return mLevels.empty()? 0 : mLevels[0].height; }
+	int						CountLevels() const { return static_cast<int>( mLevels.size() ); }
+	bool					HasAlpha() const { return mHasAlpha; }
+
+private:
+	struct Level
+	{
+		TQ3Uns32				width;
+		TQ3Uns32				height;
+		std::vector<TQ3Uns8>	texels;		// RGBA
+	};
+	
+	bool					AddLevel(
+									TQ3StorageObject inStorage,
+									TQ3Uns32 inOffset,
+									TQ3PixelType inPixelType,
+									TQ3Endian inByteOrder,
+									TQ3Uns32 inWidth,
+									TQ3Uns32 inHeight,
+									TQ3Uns32 inRowBytes,
+									bool inRowsAreFlipped );
+	void					BuildMipmaps();
+
+	std::vector<Level>		mLevels;
+	bool					mHasAlpha;
+};
+
+
+/*!
+	@class		TextureCache
+	
+	@abstract	Converted textures, kept from frame to frame.
+	
+	@discussion	A texture is converted again if it has been edited.  Entries
+				hold a weak reference to their texture object, and are
+				dropped at the start of a frame once the texture has been
+				disposed.  A Texture returned by Find stays valid until the
+				next call to StartFrame.
+*/
+class TextureCache
+{
+public:
+	const Texture*			Find( TQ3TextureObject inTexture );
+	void					StartFrame();
+
+private:
+	struct Entry
+	{
+		CQ3WeakObjectRef			texture;
+		TQ3Uns32					editIndex;
+		std::unique_ptr<Texture>	data;
+	};
+	
+	std::vector<Entry>							mEntries;
+	std::vector< std::unique_ptr<Texture> >		mRetired;
+};
+
+}	// end SWRenderer namespace
+
+#endif	// SWTEXTURE_HDR
@@ -0,0 +1,234 @@
+/*  NAME:
+        SWUpdate.cpp
+
+    DESCRIPTION:
+        Source for Quesa software renderer class.
+
+    COPYRIGHT:
+        Copyright (c) 2026, Quesa Developers. All rights reserved.
+
+        For the current release of Quesa, please see:
+
+            <https://github.com/jwwalker/Quesa>
+        
+        Redistribution and use in source and binary forms, with or without
+        modification, are permitted provided that the following conditions
+        are met:
+        
+            o Redistributions of source code must retain the above copyright
+              notice, this list of conditions and the following disclaimer.
+        
+            o Redistributions in binary form must reproduce the above
+              copyright notice, this list of conditions and the following
+              disclaimer in the documentation and/or other materials provided
+              with the distribution.
+        
+            o Neither the name of Quesa nor the names of its contributors
+              may be used to endorse or promote products derived from this
+              software without specific prior written permission.
+        
+        THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+        "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+        LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+        A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+        OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+        SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+        TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+        PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+        LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+        NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+        SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+    ___________________________________________________________________________
+*/
+
+//=============================================================================
+//      Include files
+//-----------------------------------------------------------------------------
+#include "SWRenderer.h"
+#include "CQ3ObjectRef_Gets.h"
+#include "E3Shader.h"
+
+
+
+//=============================================================================
+//      Class methods
+//-----------------------------------------------------------------------------
+
+void	SWRenderer::Renderer::UpdateLocalToCamera(
+								const TQ3Matrix4x4& inMatrix )
+{
+	mLocalToCamera = inMatrix;
+	mLocalToFrustum = mLocalToCamera * mCameraToFrustum;
+	
+	// Normals transform by the inverse transpose
+	TQ3Matrix4x4	theInverse( Q3Invert( mLocalToCamera ) );
+	Q3Matrix4x4_Transpose( &theInverse, &mNormalMatrix );
+}
+
+void	SWRenderer::Renderer::UpdateCameraToFrustum(
+								const TQ3Matrix4x4& inMatrix )
+{
+	mCameraToFrustum = inMatrix;
+	mLocalToFrustum = mLocalToCamera * mCameraToFrustum;
+	
+	// A perspective projection puts the eye at the origin of camera space,
+	// while an orthographic one puts it infinitely far away.
+	mIsLocalViewer = (inMatrix.value[2][3] != 0.0f);
+	mLights.SetLocalViewer( mIsLocalViewer );
+}
+
+void	SWRenderer::Renderer::UpdateDiffuseColor(
+								const TQ3ColorRGB* inAttColor )
+{
+	if (inAttColor != nullptr)
+	{
+		mViewState.diffuseColor = *inAttColor;
+	}
+}
+
+void	SWRenderer::Renderer::UpdateSpecularColor(
+								const TQ3ColorRGB* inAttColor )
+{
+	if (inAttColor != nullptr)
+	{
+		mViewState.specularColor = *inAttColor;
+	}
+}
+
+void	SWRenderer::Renderer::UpdateSpecularControl(
+								const float* inAttValue )
+{
+	if (inAttValue != nullptr)
+	{
+		mViewState.specularControl = *inAttValue;
+	}
+}
+
+void	SWRenderer::Renderer::UpdateMetallic(
+								const float* inAttValue )
+{
+	if (inAttValue != nullptr)
+	{
+		mViewState.metallic = *inAttValue;
+	}
+}
+
+void	SWRenderer::Renderer::UpdateTransparencyColor(
+								const TQ3ColorRGB* inAttColor )
+{
+	if (inAttColor != nullptr)
+	{
+		mViewState.alpha = (inAttColor->r + inAttColor->g + inAttColor->b) /
+			3.0f;
+	}
+}
+
+void	SWRenderer::Renderer::UpdateEmissiveColor(
+								const TQ3ColorRGB* inAttColor )
+{
+	if (inAttColor != nullptr)
+	{
+		mViewState.emissiveColor = *inAttColor;
+	}
+}
+
+void	SWRenderer::Renderer::UpdateHiliteState(
+								const TQ3Switch* inAttHilite )
+{
+	if (inAttHilite != nullptr)
+	{
+		mViewState.highlightState = *inAttHilite;
+	}
+}
+
+/*!
+	@function	SetTextureState
+	@abstract	Find the texture of a texture shader, loading it if need be,
+				and the parameters that go with it.
+*/
+void	SWRenderer::Renderer::SetTextureState(
+								TQ3ShaderObject inShader,
+								TextureState& outState )
+{
+	outState.Reset();
+	
+	if ( (inShader == nullptr) ||
+		(Q3SurfaceShader_GetType( inShader ) != kQ3SurfaceShaderTypeTexture) )
+	{
+		return;
+	}
+	
+	CQ3ObjectRef	theTexture( CQ3TextureShader_GetTexture( inShader ) );
+	if (theTexture.isvalid())
+	{
+		outState.texture = mTextures.Find( theTexture.get() );
+	}
+	
+	if (outState.texture != nullptr)
+	{
+		E3Shader* theShader = (E3Shader*) inShader;
+		TQ3ShaderUVBoundary	uBoundary, vBoundary;
+		theShader->GetUBoundary( &uBoundary );
+		theShader->GetVBoundary( &vBoundary );
+		theShader->GetUVTransform( &outState.uvTransform );
+		outState.wrapU = (uBoundary == kQ3ShaderUVBoundaryWrap);
+		outState.wrapV = (vBoundary == kQ3ShaderUVBoundaryWrap);
+		
+		TQ3Float32	threshold;
+		if (kQ3Success == Q3Object_GetElement( inShader,
+			kQ3ElementTypeTextureShaderAlphaTest, &threshold ))
+		{
+			outState.alphaTestThreshold = threshold;
+		}
+	}
+}
+
+void	SWRenderer::Renderer::UpdateSurfaceShader(
+								TQ3ShaderObject inShader )
+{
+	SetTextureState( inShader, mViewTexture );
+}
+
+void	SWRenderer::Renderer::UpdateIlluminationShader(
+								TQ3ShaderObject inShader )
+{
+	if (inShader != nullptr)
+	{
+		mViewIllumination = Q3IlluminationShader_GetType( inShader );
+	}
+	else
+	{
+		mViewIllumination = kQ3IlluminationTypeNULL;
+	}
+}
+
+void	SWRenderer::Renderer::UpdateInterpolationStyle(
+								const TQ3InterpolationStyle* inStyle )
+{
+	mStyleState.mInterpolation = *inStyle;
+}
+
+void	SWRenderer::Renderer::UpdateBackfacingStyle(
+								const TQ3BackfacingStyle* inStyle )
+{
+	mStyleState.mBackfacing = *inStyle;
+}
+
+void	SWRenderer::Renderer::UpdateOrientationStyle(
+								const TQ3OrientationStyle* inStyle )
+{
+	mStyleState.mOrientation = *inStyle;
+}
+
+void	SWRenderer::Renderer::UpdateHighlightStyle(
+								const TQ3AttributeSet* inStyleData )
+{
+	if (*inStyleData == nullptr)
+	{
+		mStyleState.mHilite = CQ3ObjectRef();
+	}
+	else
+	{
+		mStyleState.mHilite = CQ3ObjectRef( Q3Shared_GetReference( *inStyleData ) );
+	}
+}
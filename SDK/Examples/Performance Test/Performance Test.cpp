@@ -0,0 +1,4576 @@
+/*  NAME:
+        Performance Test.cpp
+
+    DESCRIPTION:
+        Console benchmarks and regression checks for the Quesa library.
+
+        Each test builds its own scene and prints its timings. Tests which
+        compare two code paths, such as one worker thread against several,
+        fail if their results are not identical, and the program then
+        returns a non-zero status.
+
+        Usage: Performance Test [testName ...]
+
+        With no test names, every test is run.
+
+    COPYRIGHT:
+        Copyright (c) 1999-2019, Quesa Developers. All rights reserved.
+
+        For the current release of Quesa, please see:
+
+            <https://github.com/jwwalker/Quesa>
+
+        Redistribution and use in source and binary forms, with or without
+        modification, are permitted provided that the following conditions
+        are met:
+
+            o Redistributions of source code must retain the above copyright
+              notice, this list of conditions and the following disclaimer.
+
+            o Redistributions in binary form must reproduce the above
+              copyright notice, this list of conditions and the following
+              disclaimer in the documentation and/or other materials provided
+              with the distribution.
+
+            o Neither the name of Quesa nor the names of its contributors
+              may be used to endorse or promote products derived from this
+              software without specific prior written permission.
+
+        THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+        "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+        LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+        A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+        OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+        SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+        TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+        PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+        LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+        NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+        SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+    ___________________________________________________________________________
+*/
+//=============================================================================
+//      Include files
+//-----------------------------------------------------------------------------
+#include "Quesa.h"
+#include "QuesaErrors.h"
+#include "QuesaCamera.h"
+#include "QuesaDrawContext.h"
+#include "QuesaExtension.h"
+#include "QuesaGeometry.h"
+#include "QuesaGroup.h"
+#include "QuesaIO.h"
+#include "QuesaLight.h"
+#include "QuesaMemory.h"
+#include "QuesaPick.h"
+#include "QuesaRenderer.h"
+#include "QuesaMath.h"
+#include "QuesaSet.h"
+#include "QuesaShader.h"
+#include "QuesaStorage.h"
+#include "QuesaStyle.h"
+#include "QuesaTransform.h"
+#include "QuesaView.h"
+
+#include "E3EdgeAdjacency.h"
+#include "E3GeometryTriMeshBVH.h"
+#include "E3HashTable.h"
+#include "E3View.h"
+#include "QOCalcTriMeshEdges.h"
+#include "QOShadowSilhouette.h"
+#include "StripMaker.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <new>
+#include <random>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <thread>
+#include <vector>
+
+#if QUESA_OS_MACINTOSH
+	#include <malloc/malloc.h>
+#else
+	#include <malloc.h>
+#endif
+
+
+
+
+
+//=============================================================================
+//      Internal constants
+//-----------------------------------------------------------------------------
+#define kScratchFileName						"Performance Test.3dmf"
+#define kGoldenImageDir							"../../Models/Test/Images/"
+
+
+
+
+
+//=============================================================================
+//      Internal types
+//-----------------------------------------------------------------------------
+typedef bool (*TestFunction)(void);
+
+typedef struct TestEntry {
+	const char*			name;
+	TestFunction		function;
+	const char*			description;
+} TestEntry;
+
+
+
+
+
+//=============================================================================
+//      Internal functions
+//-----------------------------------------------------------------------------
+//      Initialize : Initialize ourselves.
+//-----------------------------------------------------------------------------
+static void
+Initialize(void)
+{
+
+
+	// Initialize Quesa
+	TQ3Status qd3dStatus = Q3Initialize();
+	if (qd3dStatus != kQ3Success)
+		exit(-1);
+}
+
+
+
+
+
+//=============================================================================
+//      Terminate : Terminate ourselves.
+//-----------------------------------------------------------------------------
+static void
+Terminate(void)
+{
+
+
+	// Terminate Quesa
+	Q3Exit();
+}
+
+
+
+
+
+//=============================================================================
+//      Seconds : Return a monotonic time in seconds.
+//-----------------------------------------------------------------------------
+#pragma mark -
+static double
+Seconds(void)
+{
+	return std::chrono::duration<double>(
+				std::chrono::steady_clock::now().time_since_epoch() ).count();
+}
+
+
+
+
+
+//=============================================================================
+//      Report : Print a timing, with a rate if one is given.
+//-----------------------------------------------------------------------------
+static void
+Report(const char* label, double seconds, double amount = 0.0, const char* units = nullptr)
+{
+	if (units != nullptr && seconds > 0.0)
+		printf("    %-40s %9.2f ms %12.1f %s/s\n", label, seconds * 1000.0, amount / seconds, units);
+	else
+		printf("    %-40s %9.2f ms\n", label, seconds * 1000.0);
+}
+
+
+
+
+
+//=============================================================================
+//      Check : Report a failed condition.
+//-----------------------------------------------------------------------------
+static bool
+Check(bool condition, const char* what)
+{
+	if (!condition)
+		printf("    FAILED: %s\n", what);
+
+	return condition;
+}
+
+
+
+
+
+//=============================================================================
+//      Heap tracking
+//-----------------------------------------------------------------------------
+//		Note :	The global operator new and delete are replaced so that tests
+//				can measure the heap used while rendering.  The renderers
+//				allocate their buffers with new rather than with
+//				Q3Memory_Allocate, so Q3Memory_GetStatistics does not see
+//				them.  Blocks come straight from malloc, since the OpenGL
+//				libraries may free with one what they allocated with the
+//				other, and their sizes are asked of the allocator.
+//-----------------------------------------------------------------------------
+static std::atomic<long long>	gHeapBytes( 0 );
+static std::atomic<long long>	gHeapPeak( 0 );
+
+static long long
+HeapBlockSize(void* thePtr)
+{
+#if QUESA_OS_MACINTOSH
+	return (long long) malloc_size(thePtr);
+#elif QUESA_OS_WIN32
+	return (long long) _msize(thePtr);
+#else
+	return (long long) malloc_usable_size(thePtr);
+#endif
+}
+
+void*
+operator new(std::size_t theSize, const std::nothrow_t&) noexcept
+{	void*		thePtr = malloc(theSize == 0 ? 1 : theSize);
+	long long	nowBytes, peakBytes;
+
+
+
+	if (thePtr == nullptr)
+		return nullptr;
+
+	nowBytes  = (gHeapBytes += HeapBlockSize(thePtr));
+	peakBytes = gHeapPeak.load();
+	while (nowBytes > peakBytes && !gHeapPeak.compare_exchange_weak(peakBytes, nowBytes))
+		{ }
+
+	return thePtr;
+}
+
+void*
+operator new(std::size_t theSize)
+{	void*	thePtr = operator new(theSize, std::nothrow);
+
+	if (thePtr == nullptr)
+		throw std::bad_alloc();
+
+	return thePtr;
+}
+
+void*
+operator new[](std::size_t theSize, const std::nothrow_t&) noexcept
+{
+	return operator new(theSize, std::nothrow);
+}
+
+void*
+operator new[](std::size_t theSize)
+{
+	return operator new(theSize);
+}
+
+void
+operator delete(void* thePtr) noexcept
+{
+	if (thePtr == nullptr)
+		return;
+
+	gHeapBytes -= HeapBlockSize(thePtr);
+	free(thePtr);
+}
+
+void
+operator delete(void* thePtr, const std::nothrow_t&) noexcept
+{
+	operator delete(thePtr);
+}
+
+void
+operator delete[](void* thePtr) noexcept
+{
+	operator delete(thePtr);
+}
+
+void
+operator delete[](void* thePtr, const std::nothrow_t&) noexcept
+{
+	operator delete(thePtr);
+}
+
+
+
+
+
+//=============================================================================
+//      ResetHeapPeak : Start measuring a new heap high-water mark.
+//-----------------------------------------------------------------------------
+static long long
+ResetHeapPeak(void)
+{	long long	nowBytes = gHeapBytes.load();
+
+
+
+	gHeapPeak = nowBytes;
+
+	return nowBytes;
+}
+
+
+
+
+
+//=============================================================================
+//      CreateGridTriMesh : Create a TriMesh grid of quads.
+//-----------------------------------------------------------------------------
+//		Note :	The grid lies in the xy plane, with its corner at the origin
+//				and cells of unit size. It has normals and UVs, so that it
+//				exercises the attribute paths as well as the points.
+//-----------------------------------------------------------------------------
+static TQ3GeometryObject
+CreateGridTriMesh(TQ3Uns32 numCols, TQ3Uns32 numRows)
+{	std::vector<TQ3Point3D>			thePoints;
+	std::vector<TQ3Vector3D>		theNormals;
+	std::vector<TQ3Param2D>			theUVs;
+	std::vector<TQ3TriMeshTriangleData>	theTriangles;
+	TQ3TriMeshAttributeData			vertexAttributes[2];
+	TQ3TriMeshData					triMeshData;
+	TQ3Uns32						x, y, n;
+
+
+
+	// Build the vertices
+	for (y = 0; y <= numRows; ++y)
+		{
+		for (x = 0; x <= numCols; ++x)
+			{
+			TQ3Point3D	thePoint  = { (float) x, (float) y, 0.0f };
+			TQ3Vector3D	theNormal = { 0.0f, 0.0f, 1.0f };
+			TQ3Param2D	theUV     = { (float) x / numCols, (float) y / numRows };
+
+			thePoints.push_back(thePoint);
+			theNormals.push_back(theNormal);
+			theUVs.push_back(theUV);
+			}
+		}
+
+
+
+	// Build the triangles
+	for (y = 0; y < numRows; ++y)
+		{
+		for (x = 0; x < numCols; ++x)
+			{
+			n = y * (numCols + 1) + x;
+
+			TQ3TriMeshTriangleData	lower = { { n, n + 1, n + numCols + 2 } };
+			TQ3TriMeshTriangleData	upper = { { n, n + numCols + 2, n + numCols + 1 } };
+
+			theTriangles.push_back(lower);
+			theTriangles.push_back(upper);
+			}
+		}
+
+
+
+	// Create the TriMesh
+	vertexAttributes[0].attributeType     = kQ3AttributeTypeNormal;
+	vertexAttributes[0].data              = &theNormals[0];
+	vertexAttributes[0].attributeUseArray = nullptr;
+	vertexAttributes[1].attributeType     = kQ3AttributeTypeSurfaceUV;
+	vertexAttributes[1].data              = &theUVs[0];
+	vertexAttributes[1].attributeUseArray = nullptr;
+
+	memset(&triMeshData, 0, sizeof(triMeshData));
+	triMeshData.numTriangles              = (TQ3Uns32) theTriangles.size();
+	triMeshData.triangles                 = &theTriangles[0];
+	triMeshData.numPoints                 = (TQ3Uns32) thePoints.size();
+	triMeshData.points                    = &thePoints[0];
+	triMeshData.numVertexAttributeTypes   = 2;
+	triMeshData.vertexAttributeTypes      = vertexAttributes;
+
+	Q3BoundingBox_SetFromPoints3D(&triMeshData.bBox, &thePoints[0],
+									triMeshData.numPoints, sizeof(TQ3Point3D));
+
+	return Q3TriMesh_New(&triMeshData);
+}
+
+
+
+
+
+//=============================================================================
+//      WriteModels : Write some top-level objects to a storage object.
+//-----------------------------------------------------------------------------
+static bool
+WriteModels(const std::vector<TQ3Object>& theObjects, TQ3StorageObject theStorage, TQ3FileMode theMode)
+{	TQ3ViewStatus		viewStatus = kQ3ViewStatusError;
+	TQ3FileObject		theFile;
+	TQ3ViewObject		theView;
+
+
+
+	// Create the file and view
+	theFile = Q3File_New();
+	theView = Q3View_New();
+	if (theFile == nullptr || theView == nullptr)
+		{
+		Q3Object_CleanDispose(&theFile);
+		Q3Object_CleanDispose(&theView);
+		return false;
+		}
+
+
+
+	// Write the object
+	Q3File_SetStorage(theFile, theStorage);
+
+	if (Q3File_OpenWrite(theFile, theMode) == kQ3Success)
+		{
+		if (Q3View_StartWriting(theView, theFile) == kQ3Success)
+			{
+			do
+				{
+				for (TQ3Object theObject : theObjects)
+					Q3Object_Submit(theObject, theView);
+				viewStatus = Q3View_EndWriting(theView);
+				}
+			while (viewStatus == kQ3ViewStatusRetraverse);
+			}
+
+		Q3File_Close(theFile);
+		}
+
+	Q3Object_Dispose(theView);
+	Q3Object_Dispose(theFile);
+
+	return viewStatus == kQ3ViewStatusDone;
+}
+
+
+
+
+
+//=============================================================================
+//      WriteModel : Write an object to a storage object.
+//-----------------------------------------------------------------------------
+static bool
+WriteModel(TQ3Object theObject, TQ3StorageObject theStorage, TQ3FileMode theMode)
+{
+	return WriteModels(std::vector<TQ3Object>(1, theObject), theStorage, theMode);
+}
+
+
+
+
+
+//=============================================================================
+//      ReadModel : Read every object in a storage object into a group.
+//-----------------------------------------------------------------------------
+static TQ3GroupObject
+ReadModel(TQ3StorageObject theStorage, bool inParallel = false)
+{	TQ3GroupObject		theGroup;
+	TQ3FileObject		theFile;
+	TQ3FileMode			theMode;
+	TQ3Object			theObject;
+
+
+
+	// Create the file and group
+	theFile  = Q3File_New();
+	theGroup = Q3DisplayGroup_New();
+	if (theFile == nullptr || theGroup == nullptr)
+		{
+		Q3Object_CleanDispose(&theFile);
+		Q3Object_CleanDispose(&theGroup);
+		return nullptr;
+		}
+
+
+
+	// Read the objects
+	Q3File_SetStorage(theFile, theStorage);
+	Q3File_SetReadInParallel(theFile, inParallel ? kQ3True : kQ3False);
+
+	if (Q3File_OpenRead(theFile, &theMode) == kQ3Success)
+		{
+		while (Q3File_IsEndOfFile(theFile) == kQ3False)
+			{
+			theObject = Q3File_ReadObject(theFile);
+			if (theObject == nullptr)
+				continue;
+
+			if (Q3Object_IsDrawable(theObject))
+				Q3Group_AddObject(theGroup, theObject);
+
+			Q3Object_Dispose(theObject);
+			}
+
+		Q3File_Close(theFile);
+		}
+
+	Q3Object_Dispose(theFile);
+
+	return theGroup;
+}
+
+
+
+
+
+//=============================================================================
+//      WriteToMemory : Write some top-level objects to a buffer.
+//-----------------------------------------------------------------------------
+static bool
+WriteToMemory(const std::vector<TQ3Object>& theObjects, TQ3FileMode theMode, std::vector<TQ3Uns8>& outData)
+{	TQ3StorageObject	theStorage;
+	unsigned char*		theBuffer  = nullptr;
+	TQ3Uns32			validSize  = 0;
+	bool				didWrite   = false;
+
+
+
+	// Write the object to memory storage
+	outData.clear();
+
+	theStorage = Q3MemoryStorage_New(nullptr, 0);
+	if (theStorage == nullptr)
+		return false;
+
+	if (WriteModels(theObjects, theStorage, theMode) &&
+		Q3MemoryStorage_GetBuffer(theStorage, &theBuffer, &validSize, nullptr) == kQ3Success)
+		{
+		outData.assign(theBuffer, theBuffer + validSize);
+		didWrite = true;
+		}
+
+	Q3Object_Dispose(theStorage);
+
+	return didWrite;
+}
+
+
+
+
+
+//=============================================================================
+//      WriteToMemory : Write an object to a buffer.
+//-----------------------------------------------------------------------------
+static bool
+WriteToMemory(TQ3Object theObject, TQ3FileMode theMode, std::vector<TQ3Uns8>& outData)
+{
+	return WriteToMemory(std::vector<TQ3Object>(1, theObject), theMode, outData);
+}
+
+
+
+
+
+//=============================================================================
+//      FlattenToMemory : Write an object to a buffer, for comparisons.
+//-----------------------------------------------------------------------------
+//		Note :	Two object graphs are considered identical if they write out
+//				to the same bytes.
+//-----------------------------------------------------------------------------
+static bool
+FlattenToMemory(TQ3Object theObject, std::vector<TQ3Uns8>& outData)
+{
+	return WriteToMemory(theObject, kQ3FileModeNormal, outData);
+}
+
+
+
+
+
+//=============================================================================
+//      ReadFromMemory : Read every object in a buffer into a group.
+//-----------------------------------------------------------------------------
+static TQ3GroupObject
+ReadFromMemory(const std::vector<TQ3Uns8>& theData, bool inParallel = false)
+{	TQ3StorageObject	theStorage;
+	TQ3GroupObject		theGroup;
+
+
+
+	// Read from a copy of the data
+	theStorage = Q3MemoryStorage_New(&theData[0], (TQ3Uns32) theData.size());
+	if (theStorage == nullptr)
+		return nullptr;
+
+	theGroup = ReadModel(theStorage, inParallel);
+	Q3Object_Dispose(theStorage);
+
+	return theGroup;
+}
+
+
+
+
+
+//=============================================================================
+//      FileSize : Return the size of a file.
+//-----------------------------------------------------------------------------
+static long
+FileSize(const char* thePath)
+{	FILE*	theFile = fopen(thePath, "rb");
+	long	theSize = 0;
+
+	if (theFile != nullptr)
+		{
+		fseek(theFile, 0, SEEK_END);
+		theSize = ftell(theFile);
+		fclose(theFile);
+		}
+
+	return theSize;
+}
+
+
+
+
+
+//=============================================================================
+//      CreateView : Create a view which renders into an image in memory.
+//-----------------------------------------------------------------------------
+//		Note :	The image is 32-bit ARGB in host byte order, and must outlive
+//				the view.  The camera looks down the -z axis at the origin,
+//				and the scene is lit by an ambient and a directional light.
+//-----------------------------------------------------------------------------
+static TQ3ViewObject
+CreateView(TQ3ObjectType rendererType, TQ3Uns32 theWidth, TQ3Uns32 theHeight,
+			std::vector<TQ3Uns32>& theImage)
+{	TQ3ViewAngleAspectCameraData	cameraData;
+	TQ3PixmapDrawContextData		pixmapData;
+	TQ3DirectionalLightData			directionalData;
+	TQ3LightData					ambientData;
+	TQ3DrawContextObject			theDrawContext;
+	TQ3CameraObject					theCamera;
+	TQ3GroupObject					theLights;
+	TQ3LightObject					theLight;
+	TQ3ViewObject					theView;
+
+
+
+	// Create the view
+	theView = Q3View_New();
+	if (theView == nullptr)
+		return nullptr;
+
+	if (Q3View_SetRendererByType(theView, rendererType) != kQ3Success)
+		{
+		Q3Object_Dispose(theView);
+		return nullptr;
+		}
+
+
+
+	// Create the draw context
+	theImage.assign(theWidth * theHeight, 0);
+
+	memset(&pixmapData, 0, sizeof(pixmapData));
+	pixmapData.drawContextData.clearImageMethod  = kQ3ClearMethodWithColor;
+	pixmapData.drawContextData.clearImageColor.a = 1.0f;
+	pixmapData.drawContextData.clearImageColor.r = 0.2f;
+	pixmapData.drawContextData.clearImageColor.g = 0.2f;
+	pixmapData.drawContextData.clearImageColor.b = 0.2f;
+	pixmapData.drawContextData.paneState         = kQ3False;
+	pixmapData.drawContextData.maskState         = kQ3False;
+	pixmapData.drawContextData.doubleBufferState = kQ3False;
+
+	pixmapData.pixmap.image     = &theImage[0];
+	pixmapData.pixmap.width     = theWidth;
+	pixmapData.pixmap.height    = theHeight;
+	pixmapData.pixmap.rowBytes  = theWidth * 4;
+	pixmapData.pixmap.pixelSize = 32;
+	pixmapData.pixmap.pixelType = kQ3PixelTypeARGB32;
+#if QUESA_HOST_IS_BIG_ENDIAN
+	pixmapData.pixmap.bitOrder  = kQ3EndianBig;
+	pixmapData.pixmap.byteOrder = kQ3EndianBig;
+#else
+	pixmapData.pixmap.bitOrder  = kQ3EndianLittle;
+	pixmapData.pixmap.byteOrder = kQ3EndianLittle;
+#endif
+
+	theDrawContext = Q3PixmapDrawContext_New(&pixmapData);
+	if (theDrawContext != nullptr)
+		{
+		Q3View_SetDrawContext(theView, theDrawContext);
+		Q3Object_Dispose(theDrawContext);
+		}
+
+
+
+	// Create the camera
+	memset(&cameraData, 0, sizeof(cameraData));
+	cameraData.cameraData.placement.cameraLocation.z  = 10.0f;
+	cameraData.cameraData.placement.upVector.y        = 1.0f;
+	cameraData.cameraData.range.hither                = 0.1f;
+	cameraData.cameraData.range.yon                   = 100.0f;
+	cameraData.cameraData.viewPort.origin.x           = -1.0f;
+	cameraData.cameraData.viewPort.origin.y           =  1.0f;
+	cameraData.cameraData.viewPort.width              =  2.0f;
+	cameraData.cameraData.viewPort.height             =  2.0f;
+	cameraData.fov                                    = 0.8f;
+	cameraData.aspectRatioXToY                        = (float) theWidth / (float) theHeight;
+
+	theCamera = Q3ViewAngleAspectCamera_New(&cameraData);
+	if (theCamera != nullptr)
+		{
+		Q3View_SetCamera(theView, theCamera);
+		Q3Object_Dispose(theCamera);
+		}
+
+
+
+	// Create the lights
+	theLights = Q3LightGroup_New();
+	if (theLights != nullptr)
+		{
+		ambientData.isOn       = kQ3True;
+		ambientData.brightness = 0.3f;
+		ambientData.color.r    = ambientData.color.g = ambientData.color.b = 1.0f;
+		
+		theLight = Q3AmbientLight_New(&ambientData);
+		if (theLight != nullptr)
+			{
+			Q3Group_AddObject(theLights, theLight);
+			Q3Object_Dispose(theLight);
+			}
+		
+		directionalData.lightData          = ambientData;
+		directionalData.lightData.brightness = 1.0f;
+		directionalData.castsShadows       = kQ3False;
+		directionalData.direction.x        = -0.5f;
+		directionalData.direction.y        = -0.5f;
+		directionalData.direction.z        = -1.0f;
+		Q3Vector3D_Normalize(&directionalData.direction, &directionalData.direction);
+		
+		theLight = Q3DirectionalLight_New(&directionalData);
+		if (theLight != nullptr)
+			{
+			Q3Group_AddObject(theLights, theLight);
+			Q3Object_Dispose(theLight);
+			}
+		
+		Q3View_SetLightGroup(theView, theLights);
+		Q3Object_Dispose(theLights);
+		}
+
+	return theView;
+}
+
+
+
+
+
+//=============================================================================
+//      Chained hash table
+//-----------------------------------------------------------------------------
+//		Note :	This is the hash table that E3HashTable used to be, kept as a
+//				reference for Test_HashTable.  Each slot holds an array of
+//				items which grows by one item at a time, and the collision
+//				statistics are recalculated after every add and remove.
+//-----------------------------------------------------------------------------
+typedef struct ChainedTableItem {
+	TQ3ObjectType		theKey;
+	void*				theItem;
+} ChainedTableItem;
+
+typedef struct ChainedTableNode {
+	TQ3Uns32			numItems;
+	ChainedTableItem*	theItems;
+} ChainedTableNode;
+
+typedef struct ChainedTable {
+	TQ3Uns32			collisionMax;
+	float				collisionAverage;
+	TQ3Uns32			numItems;
+	TQ3Uns32			tableSize;
+	ChainedTableNode**	theTable;
+} ChainedTable;
+
+static ChainedTableNode**
+ChainedTable_FindNode(ChainedTable* theTable, TQ3ObjectType theKey)
+{	TQ3Uns8*	thePtr = (TQ3Uns8*) &theKey;
+
+
+
+	return &theTable->theTable[ (27*thePtr[0] + 9*thePtr[1] + 3*thePtr[2] + thePtr[3]) &
+								(theTable->tableSize - 1) ];
+}
+
+static void
+ChainedTable_UpdateStats(ChainedTable* theTable)
+{	TQ3Uns32	n, itemCount = 0, slotCount = 0;
+
+
+
+	theTable->collisionMax = 0;
+	for (n = 0; n < theTable->tableSize; n++)
+		{
+		if (theTable->theTable[n] != nullptr)
+			{
+			if (theTable->theTable[n]->numItems > theTable->collisionMax)
+				theTable->collisionMax = theTable->theTable[n]->numItems;
+			
+			itemCount += theTable->theTable[n]->numItems;
+			slotCount++;
+			}
+		}
+
+	theTable->collisionAverage = (slotCount != 0) ? (float) itemCount / (float) slotCount : 0.0f;
+}
+
+static ChainedTable*
+ChainedTable_Create(TQ3Uns32 tableSize)
+{	ChainedTable*	theTable = (ChainedTable*) Q3Memory_AllocateClear(sizeof(ChainedTable));
+
+
+
+	if (theTable != nullptr)
+		{
+		theTable->tableSize = tableSize;
+		theTable->theTable  = (ChainedTableNode**) Q3Memory_AllocateClear(
+									static_cast<TQ3Uns32>(sizeof(ChainedTableNode*) * tableSize));
+		if (theTable->theTable == nullptr)
+			Q3Memory_Free(&theTable);
+		}
+
+	return theTable;
+}
+
+static void
+ChainedTable_Destroy(ChainedTable** theTable)
+{	TQ3Uns32	n;
+
+
+
+	for (n = 0; n < (*theTable)->tableSize; n++)
+		{
+		if ((*theTable)->theTable[n] != nullptr)
+			{
+			Q3Memory_Free(&(*theTable)->theTable[n]->theItems);
+			Q3Memory_Free(&(*theTable)->theTable[n]);
+			}
+		}
+
+	Q3Memory_Free(&(*theTable)->theTable);
+	Q3Memory_Free(theTable);
+}
+
+static TQ3Status
+ChainedTable_Add(ChainedTable* theTable, TQ3ObjectType theKey, void* theItem)
+{	ChainedTableNode**	theNode = ChainedTable_FindNode(theTable, theKey);
+
+
+
+	if (*theNode == nullptr)
+		{
+		*theNode = (ChainedTableNode*) Q3Memory_AllocateClear(sizeof(ChainedTableNode));
+		if (*theNode == nullptr)
+			return kQ3Failure;
+		}
+
+	if (Q3Memory_Reallocate(&(*theNode)->theItems,
+			static_cast<TQ3Uns32>(sizeof(ChainedTableItem) * ((*theNode)->numItems + 1))) != kQ3Success)
+		return kQ3Failure;
+
+	(*theNode)->theItems[(*theNode)->numItems].theKey  = theKey;
+	(*theNode)->theItems[(*theNode)->numItems].theItem = theItem;
+	(*theNode)->numItems++;
+
+	theTable->numItems++;
+	ChainedTable_UpdateStats(theTable);
+
+	return kQ3Success;
+}
+
+static void*
+ChainedTable_Find(ChainedTable* theTable, TQ3ObjectType theKey)
+{	ChainedTableNode*	theNode = *ChainedTable_FindNode(theTable, theKey);
+	TQ3Uns32			n;
+
+
+
+	if (theNode != nullptr)
+		{
+		for (n = 0; n < theNode->numItems; ++n)
+			if (theNode->theItems[n].theKey == theKey)
+				return theNode->theItems[n].theItem;
+		}
+
+	return nullptr;
+}
+
+static void
+ChainedTable_Remove(ChainedTable* theTable, TQ3ObjectType theKey)
+{	ChainedTableNode*	theNode = *ChainedTable_FindNode(theTable, theKey);
+	TQ3Uns32			n;
+
+
+
+	if (theNode == nullptr)
+		return;
+
+	for (n = 0; n < theNode->numItems; ++n)
+		{
+		if (theNode->theItems[n].theKey == theKey)
+			{
+			memmove(&theNode->theItems[n], &theNode->theItems[n + 1],
+					(theNode->numItems - n - 1) * sizeof(ChainedTableItem));
+			theNode->numItems--;
+			theTable->numItems--;
+			ChainedTable_UpdateStats(theTable);
+			return;
+			}
+		}
+}
+
+
+
+
+
+//=============================================================================
+//      Tests
+//-----------------------------------------------------------------------------
+//      Test_HashTable : Time hash table operations, new table against old.
+//-----------------------------------------------------------------------------
+//		Note :	Both tables start with 32 slots, the size the 3DMF reader
+//				uses for its tables of contents, and are filled with
+//				consecutive keys, as reference IDs are.  Misses look up
+//				keys which were never added.  The open addressing table
+//				grows as it fills, while the chained table's chains grow.
+//
+//				E3HashTable is internal to Quesa, so this test relies on
+//				the library exporting it, as it does on Unix.  The chained
+//				table is compiled into the test and may be inlined, which
+//				flatters it for small tables.
+//-----------------------------------------------------------------------------
+#pragma mark -
+static bool
+Test_HashTable(void)
+{	const TQ3Uns32				kNumItems[] = { 64, 1024, 16384 };
+	const TQ3Uns32				kTableSize = 32, kNumFinds = 2000000;
+	TQ3Uns32					n, theKey, numPasses, numWrong;
+	E3HashTablePtr				openTable;
+	ChainedTable*				chainedTable;
+	double						startTime, openTimes[4], chainedTimes[4];
+	const char*					opNames[4] = { "insert", "find hit", "find miss", "remove" };
+	char						theLabel[64];
+	bool						passed = true;
+
+
+
+	for (TQ3Uns32 numItems : kNumItems)
+		{
+		// Time the open addressing table
+		numPasses = kNumFinds / numItems;
+		numWrong  = 0;
+		openTable = E3HashTable_Create(kTableSize);
+		if (!Check(openTable != nullptr, "create hash table"))
+			return false;
+		
+		startTime = Seconds();
+		for (theKey = 1; theKey <= numItems; ++theKey)
+			if (E3HashTable_Add(openTable, theKey, (void*) (uintptr_t) theKey) != kQ3Success)
+				numWrong++;
+		openTimes[0] = Seconds() - startTime;
+		
+		startTime = Seconds();
+		for (n = 0; n < numPasses; ++n)
+			for (theKey = 1; theKey <= numItems; ++theKey)
+				if (E3HashTable_Find(openTable, theKey) != (void*) (uintptr_t) theKey)
+					numWrong++;
+		openTimes[1] = Seconds() - startTime;
+		
+		startTime = Seconds();
+		for (n = 0; n < numPasses; ++n)
+			for (theKey = numItems + 1; theKey <= 2 * numItems; ++theKey)
+				if (E3HashTable_Find(openTable, theKey) != nullptr)
+					numWrong++;
+		openTimes[2] = Seconds() - startTime;
+		
+		startTime = Seconds();
+		for (theKey = 1; theKey <= numItems; ++theKey)
+			E3HashTable_Remove(openTable, theKey);
+		openTimes[3] = Seconds() - startTime;
+		
+		passed = Check(numWrong == 0 && E3HashTable_GetNumItems(openTable) == 0,
+						"open addressing table finds every key") && passed;
+		E3HashTable_Destroy(&openTable);
+
+
+
+		// Time the chained table
+		numWrong     = 0;
+		chainedTable = ChainedTable_Create(kTableSize);
+		if (!Check(chainedTable != nullptr, "create chained table"))
+			return false;
+		
+		startTime = Seconds();
+		for (theKey = 1; theKey <= numItems; ++theKey)
+			if (ChainedTable_Add(chainedTable, theKey, (void*) (uintptr_t) theKey) != kQ3Success)
+				numWrong++;
+		chainedTimes[0] = Seconds() - startTime;
+		
+		startTime = Seconds();
+		for (n = 0; n < numPasses; ++n)
+			for (theKey = 1; theKey <= numItems; ++theKey)
+				if (ChainedTable_Find(chainedTable, theKey) != (void*) (uintptr_t) theKey)
+					numWrong++;
+		chainedTimes[1] = Seconds() - startTime;
+		
+		startTime = Seconds();
+		for (n = 0; n < numPasses; ++n)
+			for (theKey = numItems + 1; theKey <= 2 * numItems; ++theKey)
+				if (ChainedTable_Find(chainedTable, theKey) != nullptr)
+					numWrong++;
+		chainedTimes[2] = Seconds() - startTime;
+		
+		startTime = Seconds();
+		for (theKey = 1; theKey <= numItems; ++theKey)
+			ChainedTable_Remove(chainedTable, theKey);
+		chainedTimes[3] = Seconds() - startTime;
+		
+		passed = Check(numWrong == 0 && chainedTable->numItems == 0,
+						"chained table finds every key") && passed;
+		ChainedTable_Destroy(&chainedTable);
+
+
+
+		// Report the rates
+		for (n = 0; n < 4; ++n)
+			{
+			double	numOps = (n == 1 || n == 2) ? (double) numPasses * numItems : (double) numItems;
+			
+			snprintf(theLabel, sizeof(theLabel), "%s, %u items, open addressing", opNames[n], (unsigned int) numItems);
+			Report(theLabel, openTimes[n], numOps / 1.0e6, "M ops");
+			
+			snprintf(theLabel, sizeof(theLabel), "%s, %u items, chained", opNames[n], (unsigned int) numItems);
+			Report(theLabel, chainedTimes[n], numOps / 1.0e6, "M ops");
+			}
+		}
+
+	return passed;
+}
+
+
+
+
+
+//=============================================================================
+//      Test_StorageRead : Compare read speeds of path and mapped storage.
+//-----------------------------------------------------------------------------
+static bool
+Test_StorageRead(void)
+
+{	TQ3StorageObject			theStorage;
+	TQ3GroupObject				theGroup;
+	TQ3GeometryObject			theMesh;
+	std::vector<TQ3Uns8>		pathData, mappedData;
+	double						megabytes, startTime;
+	bool						passed = true;
+
+
+
+	// Write a 2M triangle model in binary
+	theMesh    = CreateGridTriMesh(1000, 1000);
+	theStorage = Q3PathStorage_New(kScratchFileName);
+	passed     = Check(WriteModel(theMesh, theStorage, kQ3FileModeNormal), "write model");
+	Q3Object_Dispose(theStorage);
+	Q3Object_Dispose(theMesh);
+
+	megabytes = FileSize(kScratchFileName) / (1024.0 * 1024.0);
+
+
+
+	// Read it through path storage
+	startTime  = Seconds();
+	theStorage = Q3PathStorage_New(kScratchFileName);
+	theGroup   = ReadModel(theStorage);
+	Report("path storage", Seconds() - startTime, megabytes, "MB");
+
+	passed = Check(FlattenToMemory(theGroup, pathData), "path storage read") && passed;
+	Q3Object_Dispose(theGroup);
+	Q3Object_Dispose(theStorage);
+
+
+
+	// Read it through mapped path storage
+	startTime  = Seconds();
+	theStorage = Q3MappedPathStorage_New(kScratchFileName);
+	theGroup   = ReadModel(theStorage);
+	Report("mapped path storage", Seconds() - startTime, megabytes, "MB");
+
+	passed = Check(FlattenToMemory(theGroup, mappedData), "mapped path storage read") && passed;
+	Q3Object_Dispose(theGroup);
+	Q3Object_Dispose(theStorage);
+
+
+
+	// Both must give the same model
+	passed = Check(pathData == mappedData, "mapped storage reads the same model") && passed;
+
+	remove(kScratchFileName);
+
+	return passed;
+}
+
+
+
+
+
+//=============================================================================
+//      Test_SwappedRead : Time reading geometry arrays in each byte order.
+//-----------------------------------------------------------------------------
+static bool
+Test_SwappedRead(void)
+{	std::vector<TQ3Uns8>		nativeFile, swappedFile, nativeData, swappedData;
+	std::vector<TQ3Vertex3D>	theVertices;
+	TQ3GroupObject				theModel, theGroup;
+	TQ3GeometryObject			theGeom;
+	TQ3TriGridData				triGridData;
+	TQ3Uns32					x, y;
+	double						megabytes, startTime;
+	bool						passed = true;
+
+
+
+	// Build a model with a TriMesh and a TriGrid, which are read as arrays
+	theModel = Q3DisplayGroup_New();
+
+	theGeom = CreateGridTriMesh(500, 500);
+	Q3Group_AddObject(theModel, theGeom);
+	Q3Object_Dispose(theGeom);
+
+	for (y = 0; y < 500; ++y)
+		{
+		for (x = 0; x < 500; ++x)
+			{
+			TQ3Vertex3D	theVertex = { { (float) x, (float) y, (float) ((x ^ y) & 7) }, nullptr };
+			theVertices.push_back(theVertex);
+			}
+		}
+
+	triGridData.numRows             = 500;
+	triGridData.numColumns          = 500;
+	triGridData.vertices            = &theVertices[0];
+	triGridData.facetAttributeSet   = nullptr;
+	triGridData.triGridAttributeSet = nullptr;
+
+	theGeom = Q3TriGrid_New(&triGridData);
+	Q3Group_AddObject(theModel, theGeom);
+	Q3Object_Dispose(theGeom);
+
+	passed = Check(WriteToMemory(theModel, kQ3FileModeNormal, nativeFile), "write native file");
+	passed = Check(WriteToMemory(theModel, kQ3FileModeNormal | kQ3FileModeSwap, swappedFile), "write swapped file") && passed;
+	Q3Object_Dispose(theModel);
+
+	megabytes = nativeFile.size() / (1024.0 * 1024.0);
+
+
+
+	// Read each file
+	startTime = Seconds();
+	theGroup  = ReadFromMemory(nativeFile);
+	Report("native byte order", Seconds() - startTime, megabytes, "MB");
+
+	passed = Check(FlattenToMemory(theGroup, nativeData), "read native file") && passed;
+	Q3Object_CleanDispose(&theGroup);
+
+	startTime = Seconds();
+	theGroup  = ReadFromMemory(swappedFile);
+	Report("swapped byte order", Seconds() - startTime, megabytes, "MB");
+
+	passed = Check(FlattenToMemory(theGroup, swappedData), "read swapped file") && passed;
+	Q3Object_CleanDispose(&theGroup);
+
+
+
+	// Both must give the same model
+	passed = Check(nativeData == swappedData, "swapped file reads the same model") && passed;
+
+	return passed;
+}
+
+
+
+
+
+//=============================================================================
+//      Test_ParallelRead : Time reading a database file on 1..N threads.
+//-----------------------------------------------------------------------------
+//		Note :	The file has many top-level groups, which share meshes and
+//				attribute sets through the table of contents.  Each read must
+//				give the same model as reading one object at a time, with the
+//				same objects shared, which the database mode comparison checks.
+//-----------------------------------------------------------------------------
+static bool
+Test_ParallelRead(void)
+{	const TQ3Uns32				kNumGroups = 2048, kNumMeshes = 64, kNumSets = 8;
+	const TQ3Uns32				kThreadCounts[] = { 1, 2, 4, 8 };
+	std::vector<TQ3Object>		theObjects, theMeshes, theSets;
+	std::vector<TQ3Uns8>		theFile, sequentialData, parallelData;
+	TQ3GroupObject				theGroup;
+	TQ3Object					theObject;
+	TQ3Uns32					n;
+	double						megabytes, startTime;
+	bool						passed = true;
+	char						theLabel[64];
+
+
+
+	// Build the model, with each mesh and set used by several groups
+	for (n = 0; n < kNumMeshes; ++n)
+		theMeshes.push_back(CreateGridTriMesh(40, 40));
+
+	for (n = 0; n < kNumSets; ++n)
+		{
+		TQ3ColorRGB	theColor = { (float) n / kNumSets, 0.5f, 1.0f - (float) n / kNumSets };
+		
+		theObject = Q3AttributeSet_New();
+		Q3AttributeSet_Add(theObject, kQ3AttributeTypeDiffuseColor, &theColor);
+		theSets.push_back(theObject);
+		}
+
+	for (n = 0; n < kNumGroups; ++n)
+		{
+		TQ3Vector3D	theOffset = { (float) (n % 64) * 50.0f, (float) (n / 64) * 50.0f, 0.0f };
+		
+		theGroup  = Q3DisplayGroup_New();
+		theObject = Q3TranslateTransform_New(&theOffset);
+		Q3Group_AddObject(theGroup, theObject);
+		Q3Object_Dispose(theObject);
+		
+		Q3Group_AddObject(theGroup, theSets[n % kNumSets]);
+		Q3Group_AddObject(theGroup, theMeshes[n % kNumMeshes]);
+		theObjects.push_back(theGroup);
+		}
+
+	passed = Check(WriteToMemory(theObjects, kQ3FileModeDatabase, theFile), "write database file");
+
+	for (TQ3Object& theItem : theObjects)
+		Q3Object_CleanDispose(&theItem);
+	for (TQ3Object& theItem : theMeshes)
+		Q3Object_CleanDispose(&theItem);
+	for (TQ3Object& theItem : theSets)
+		Q3Object_CleanDispose(&theItem);
+
+	if (!passed)
+		return false;
+
+	megabytes = theFile.size() / (1024.0 * 1024.0);
+
+
+
+	// Read it one object at a time
+	startTime = Seconds();
+	theGroup  = ReadFromMemory(theFile);
+	Report("one object at a time", Seconds() - startTime, megabytes, "MB");
+
+	passed = Check(WriteToMemory(theGroup, kQ3FileModeDatabase, sequentialData), "sequential read");
+	Q3Object_CleanDispose(&theGroup);
+
+
+
+	// Read it in parallel on each number of threads
+	for (TQ3Uns32 numThreads : kThreadCounts)
+		{
+		Q3SetThreadCount(numThreads);
+		
+		startTime = Seconds();
+		theGroup  = ReadFromMemory(theFile, true);
+		snprintf(theLabel, sizeof(theLabel), "in parallel, %u thread%s",
+					(unsigned int) numThreads, (numThreads == 1) ? "" : "s");
+		Report(theLabel, Seconds() - startTime, megabytes, "MB");
+		
+		passed = Check(WriteToMemory(theGroup, kQ3FileModeDatabase, parallelData), "parallel read") && passed;
+		passed = Check(parallelData == sequentialData, "parallel read gives the same model") && passed;
+		Q3Object_CleanDispose(&theGroup);
+		}
+
+	Q3SetThreadCount(0);
+
+	return passed;
+}
+
+
+
+
+
+//=============================================================================
+//      Test_RoundTrip : Time writing a binary file and reading it back.
+//-----------------------------------------------------------------------------
+//		Note :	The model is made of many small objects, so the file is built
+//				from a great many small writes.  Writing the model that was
+//				read back must give the same bytes as the original file.
+//-----------------------------------------------------------------------------
+static bool
+Test_RoundTrip(void)
+{	const TQ3Uns32				kNumGroups = 20000;
+	std::vector<TQ3Object>		theObjects;
+	std::vector<TQ3Uns8>		fileData, memoryData, rewrittenData;
+	TQ3StorageObject			theStorage;
+	TQ3GroupObject				theGroup;
+	TQ3Object					theObject;
+	TQ3Uns32					n;
+	double						megabytes, startTime;
+	bool						passed = true;
+	FILE*						theFile;
+
+
+
+	// Build the model
+	for (n = 0; n < kNumGroups; ++n)
+		{
+		TQ3Vector3D	theOffset = { (float) (n % 200) * 10.0f, (float) (n / 200) * 10.0f, 0.0f };
+		
+		theGroup  = Q3DisplayGroup_New();
+		theObject = Q3TranslateTransform_New(&theOffset);
+		Q3Group_AddObject(theGroup, theObject);
+		Q3Object_Dispose(theObject);
+		
+		theObject = CreateGridTriMesh(4, 4);
+		Q3Group_AddObject(theGroup, theObject);
+		Q3Object_Dispose(theObject);
+		theObjects.push_back(theGroup);
+		}
+
+
+
+	// Write it to a file
+	startTime  = Seconds();
+	theStorage = Q3PathStorage_New(kScratchFileName);
+	passed     = Check(WriteModels(theObjects, theStorage, kQ3FileModeNormal), "write model");
+	Q3Object_Dispose(theStorage);
+
+	megabytes = FileSize(kScratchFileName) / (1024.0 * 1024.0);
+	Report("write to path storage", Seconds() - startTime, megabytes, "MB");
+
+	passed = Check(WriteToMemory(theObjects, kQ3FileModeNormal, memoryData), "write to memory") && passed;
+
+	for (TQ3Object& theItem : theObjects)
+		Q3Object_CleanDispose(&theItem);
+
+	if (!passed)
+		{
+		remove(kScratchFileName);
+		return false;
+		}
+
+
+
+	// The file must hold the same bytes as the memory copy
+	fileData.resize(memoryData.size());
+	theFile = fopen(kScratchFileName, "rb");
+	passed  = Check(theFile != nullptr && FileSize(kScratchFileName) == (long) memoryData.size() &&
+					fread(&fileData[0], 1, fileData.size(), theFile) == fileData.size(),
+					"read back the file");
+	if (theFile != nullptr)
+		fclose(theFile);
+
+	passed = Check(fileData == memoryData, "path and memory storage get the same bytes") && passed;
+
+
+
+	// Read it back, and write what was read
+	startTime  = Seconds();
+	theStorage = Q3PathStorage_New(kScratchFileName);
+	theGroup   = ReadModel(theStorage);
+	Report("read from path storage", Seconds() - startTime, megabytes, "MB");
+	Q3Object_Dispose(theStorage);
+
+	theObjects.clear();
+	if (theGroup != nullptr)
+		{
+		TQ3GroupPosition	thePosition = nullptr;
+		
+		Q3Group_GetFirstPosition(theGroup, &thePosition);
+		while (thePosition != nullptr)
+			{
+			Q3Group_GetPositionObject(theGroup, thePosition, &theObject);
+			theObjects.push_back(theObject);
+			Q3Group_GetNextPosition(theGroup, &thePosition);
+			}
+		}
+
+	passed = Check(theObjects.size() == kNumGroups, "read every object") && passed;
+	passed = Check(WriteToMemory(theObjects, kQ3FileModeNormal, rewrittenData), "rewrite model") && passed;
+	passed = Check(rewrittenData == memoryData, "rewriting the model gives the same bytes") && passed;
+
+	for (TQ3Object& theItem : theObjects)
+		Q3Object_CleanDispose(&theItem);
+
+	Q3Object_CleanDispose(&theGroup);
+	remove(kScratchFileName);
+
+	return passed;
+}
+
+
+
+
+
+//=============================================================================
+//      PickHit : A hit found by a pick.
+//-----------------------------------------------------------------------------
+typedef struct PickHit {
+	TQ3Uns32			theFace;
+	TQ3Point3D			thePoint;
+	float				theDistance;
+} PickHit;
+
+
+
+
+
+//=============================================================================
+//      PickScene : Pick a scene, and get the hits.
+//-----------------------------------------------------------------------------
+//		Note :	Details which the pick did not record are left as zero, so
+//				that two lists of hits can be compared with memcmp.
+//-----------------------------------------------------------------------------
+static bool
+PickScene(TQ3ViewObject theView, TQ3PickObject thePick, TQ3Object theScene,
+			std::vector<PickHit>& theHits)
+{	TQ3PickDetail		validMask;
+	TQ3ViewStatus		viewStatus;
+	TQ3Uns32			n, numHits = 0;
+
+
+
+	// Pick the scene
+	theHits.clear();
+	Q3Pick_EmptyHitList(thePick);
+
+	if (Q3View_StartPicking(theView, thePick) != kQ3Success)
+		return false;
+
+	do
+		{
+		Q3Object_Submit(theScene, theView);
+		viewStatus = Q3View_EndPicking(theView);
+		}
+	while (viewStatus == kQ3ViewStatusRetraverse);
+
+	if (viewStatus != kQ3ViewStatusDone)
+		return false;
+
+
+
+	// Collect the hits
+	Q3Pick_GetNumHits(thePick, &numHits);
+	theHits.resize(numHits);
+	memset(theHits.data(), 0, numHits * sizeof(PickHit));
+
+	for (n = 0; n < numHits; ++n)
+		{
+		Q3Pick_GetPickDetailValidMask(thePick, n, &validMask);
+		
+		if ((validMask & kQ3PickDetailMaskTriMeshFace) != 0)
+			Q3Pick_GetPickDetailData(thePick, n, kQ3PickDetailMaskTriMeshFace, &theHits[n].theFace);
+		
+		if ((validMask & kQ3PickDetailMaskXYZ) != 0)
+			Q3Pick_GetPickDetailData(thePick, n, kQ3PickDetailMaskXYZ, &theHits[n].thePoint);
+		
+		if ((validMask & kQ3PickDetailMaskDistance) != 0)
+			Q3Pick_GetPickDetailData(thePick, n, kQ3PickDetailMaskDistance, &theHits[n].theDistance);
+		}
+
+	return true;
+}
+
+
+
+
+
+//=============================================================================
+//      Test_PickTriMesh : Time picking a large TriMesh, with and without a BVH.
+//-----------------------------------------------------------------------------
+//		Note :	The scene is two copies of a 131k triangle grid, one behind
+//				the other, so that most rays hit both.  It is picked on a
+//				grid of locations with a world ray, with a window point and
+//				a face tolerance, and with a window rect.
+//
+//				Each pick is done with the TriMesh hierarchies, and then
+//				again with them turned off through E3TriMeshBVH, which is
+//				internal to Quesa, so that every triangle is tested.  The
+//				hits must be identical.  A first pick, which builds the
+//				hierarchy, is timed separately.
+//-----------------------------------------------------------------------------
+static bool
+Test_PickTriMesh(void)
+{	const TQ3Uns32				kGridSize = 256, kPickGrid = 10;
+	const char*					pickNames[3] = { "world ray", "window point", "window rect" };
+	std::vector<PickHit>		bvhHits, bruteHits;
+	std::vector<TQ3Uns32>		theImage;
+	TQ3WorldRayPickData			rayData;
+	TQ3WindowPointPickData		pointData;
+	TQ3WindowRectPickData		rectData;
+	TQ3PickObject				thePicks[3];
+	TQ3GroupObject				theScene;
+	TQ3Object					theObject, theMesh;
+	TQ3Vector3D					theOffset, theScale;
+	TQ3ViewObject				theView;
+	TQ3Uns32					n, x, y, numHits, numDifferent;
+	double						startTime, bvhTime, bruteTime;
+	char						theLabel[64];
+	bool						passed = true;
+
+
+
+	// Create the view and scene
+	theView = CreateView(kQ3RendererTypeGeneric, 512, 512, theImage);
+	if (!Check(theView != nullptr, "create view"))
+		return false;
+
+	theScene = Q3DisplayGroup_New();
+	theMesh  = CreateGridTriMesh(kGridSize, kGridSize);
+
+	Q3Vector3D_Set(&theOffset, -4.0f, -4.0f, 0.0f);
+	theObject = Q3TranslateTransform_New(&theOffset);
+	Q3Group_AddObject(theScene, theObject);
+	Q3Object_Dispose(theObject);
+
+	Q3Vector3D_Set(&theScale, 8.0f / kGridSize, 8.0f / kGridSize, 1.0f);
+	theObject = Q3ScaleTransform_New(&theScale);
+	Q3Group_AddObject(theScene, theObject);
+	Q3Object_Dispose(theObject);
+
+	Q3Group_AddObject(theScene, theMesh);
+
+	Q3Vector3D_Set(&theOffset, 0.5f, 0.5f, -1.0f);
+	theObject = Q3TranslateTransform_New(&theOffset);
+	Q3Group_AddObject(theScene, theObject);
+	Q3Object_Dispose(theObject);
+
+	Q3Group_AddObject(theScene, theMesh);
+	Q3Object_Dispose(theMesh);
+
+
+
+	// Create the picks
+	memset(&rayData, 0, sizeof(rayData));
+	rayData.data.sort            = kQ3PickSortNearToFar;
+	rayData.data.mask            = kQ3PickDetailMaskTriMeshFace | kQ3PickDetailMaskXYZ | kQ3PickDetailMaskDistance;
+	rayData.data.numHitsToReturn = kQ3ReturnAllHits;
+	rayData.ray.origin.z         = 10.0f;
+	thePicks[0] = Q3WorldRayPick_New(&rayData);
+
+	memset(&pointData, 0, sizeof(pointData));
+	pointData.data = rayData.data;
+	thePicks[1] = Q3WindowPointPick_New(&pointData);
+	Q3Pick_SetFaceTolerance(thePicks[1], 3.0f);
+
+	memset(&rectData, 0, sizeof(rectData));
+	rectData.data = rayData.data;
+	thePicks[2] = Q3WindowRectPick_New(&rectData);
+
+
+
+	// Time the first pick, which builds the hierarchy, through the middle
+	// of the mesh
+	Q3Vector3D_Set(&rayData.ray.direction, 0.0f, 0.0f, -1.0f);
+	Q3WorldRayPick_SetRay(thePicks[0], &rayData.ray);
+
+	startTime = Seconds();
+	passed    = Check(PickScene(theView, thePicks[0], theScene, bvhHits), "first pick") && passed;
+	Report("first pick, building the hierarchy", Seconds() - startTime);
+	passed    = Check(!bvhHits.empty(), "first pick hits the mesh") && passed;
+
+
+
+	// Pick each way, with and without the hierarchies
+	for (n = 0; n < 3; ++n)
+		{
+		bvhTime      = bruteTime = 0.0;
+		numHits      = 0;
+		numDifferent = 0;
+		
+		for (y = 0; y < kPickGrid; ++y)
+			{
+			for (x = 0; x < kPickGrid; ++x)
+				{
+				// Aim at the next location
+				float	u = (x + 0.5f) / kPickGrid;
+				float	v = (y + 0.5f) / kPickGrid;
+				
+				if (n == 0)
+					{
+					rayData.ray.origin.x = 8.0f * u - 4.0f;
+					rayData.ray.origin.y = 8.0f * v - 4.0f;
+					Q3Vector3D_Set(&rayData.ray.direction, 0.1f * (u - 0.5f), 0.1f * (v - 0.5f), -1.0f);
+					Q3Vector3D_Normalize(&rayData.ray.direction, &rayData.ray.direction);
+					Q3WorldRayPick_SetRay(thePicks[0], &rayData.ray);
+					}
+				else if (n == 1)
+					{
+					Q3Point2D_Set(&pointData.point, 40.0f + 432.0f * u, 40.0f + 432.0f * v);
+					Q3WindowPointPick_SetPoint(thePicks[1], &pointData.point);
+					}
+				else
+					{
+					Q3Point2D_Set(&rectData.rect.min, 40.0f + 432.0f * u, 40.0f + 432.0f * v);
+					Q3Point2D_Set(&rectData.rect.max, rectData.rect.min.x + 8.0f, rectData.rect.min.y + 8.0f);
+					Q3WindowRectPick_SetRect(thePicks[2], &rectData.rect);
+					}
+				
+				
+				// Pick with the hierarchies
+				startTime = Seconds();
+				passed    = Check(PickScene(theView, thePicks[n], theScene, bvhHits), "pick with hierarchy") && passed;
+				bvhTime  += Seconds() - startTime;
+				
+				
+				// Pick again testing every triangle
+				E3TriMeshBVH_SetMinTriangles(0xFFFFFFFF);
+				startTime  = Seconds();
+				passed     = Check(PickScene(theView, thePicks[n], theScene, bruteHits), "pick without hierarchy") && passed;
+				bruteTime += Seconds() - startTime;
+				E3TriMeshBVH_SetMinTriangles(0);
+				
+				numHits += (TQ3Uns32) bvhHits.size();
+				if (bvhHits.size() != bruteHits.size() ||
+					(!bvhHits.empty() && memcmp(bvhHits.data(), bruteHits.data(), bvhHits.size() * sizeof(PickHit)) != 0))
+					numDifferent++;
+				}
+			}
+		
+		snprintf(theLabel, sizeof(theLabel), "%s, hierarchy (%u hits)", pickNames[n], (unsigned int) numHits);
+		Report(theLabel, bvhTime, kPickGrid * kPickGrid, "picks");
+		
+		snprintf(theLabel, sizeof(theLabel), "%s, every triangle", pickNames[n]);
+		Report(theLabel, bruteTime, kPickGrid * kPickGrid, "picks");
+		
+		passed = Check(numHits != 0, "picks hit the mesh") && passed;
+		passed = Check(numDifferent == 0, "hierarchy finds the same hits") && passed;
+		}
+
+
+
+	// Clean up
+	for (n = 0; n < 3; ++n)
+		Q3Object_Dispose(thePicks[n]);
+
+	Q3Object_Dispose(theView);
+	Q3Object_Dispose(theScene);
+
+	return passed;
+}
+
+
+
+
+
+//=============================================================================
+//      Test_PickIndex : Time picking a large scene, with and without a pick
+//				index on its top group.
+//-----------------------------------------------------------------------------
+//		Note :	The scene is a grid of 4096 display groups, each holding a
+//				translation and its own box.  Each pick is done without and
+//				then with the kQ3DisplayGroupPropertyPickIndex property, and
+//				the hits must be identical.  The number of geometry pick
+//				methods invoked per pick is read from the view, which is
+//				internal to Quesa.
+//
+//				Finally one building is moved and the scene picked again,
+//				which rebuilds the index of the top group, and must find the
+//				building in its new place.
+//-----------------------------------------------------------------------------
+static bool
+Test_PickIndex(void)
+{	const TQ3Uns32				kGridSize = 64, kPickGrid = 10;
+	std::vector<PickHit>		indexHits;
+	std::vector<TQ3Uns32>		theImage;
+	std::vector<TQ3Object>		theMoves;
+	TQ3WorldRayPickData			rayData;
+	TQ3PickObject				thePick;
+	TQ3GroupObject				theScene, theBuilding;
+	TQ3Object					theObject;
+	TQ3BoxData					boxData;
+	TQ3Vector3D					theOffset;
+	TQ3ViewObject				theView;
+	TQ3Boolean					useIndex;
+	TQ3Uns32					n, x, y, numHits = 0, numDifferent = 0;
+	TQ3Uns32					thePicked[2];
+	double						startTime, theTimes[2];
+	bool						passed = true;
+
+
+
+	// Create the view and scene
+	theView = CreateView(kQ3RendererTypeGeneric, 64, 64, theImage);
+	if (!Check(theView != nullptr, "create view"))
+		return false;
+
+	memset(&boxData, 0, sizeof(boxData));
+	boxData.orientation.z = 2.0f;
+	boxData.majorAxis.y   = 0.8f;
+	boxData.minorAxis.x   = 0.8f;
+
+	theScene = Q3DisplayGroup_New();
+
+	for (y = 0; y < kGridSize; ++y)
+		{
+		for (x = 0; x < kGridSize; ++x)
+			{
+			theBuilding = Q3DisplayGroup_New();
+
+			Q3Vector3D_Set(&theOffset, (float) x, (float) y, 0.0f);
+			theObject = Q3TranslateTransform_New(&theOffset);
+			Q3Group_AddObject(theBuilding, theObject);
+			theMoves.push_back(theObject);
+
+			theObject = Q3Box_New(&boxData);
+			Q3Group_AddObject(theBuilding, theObject);
+			Q3Object_Dispose(theObject);
+
+			Q3Group_AddObject(theScene, theBuilding);
+			Q3Object_Dispose(theBuilding);
+			}
+		}
+
+
+
+	// Create the pick
+	memset(&rayData, 0, sizeof(rayData));
+	rayData.data.sort            = kQ3PickSortNearToFar;
+	rayData.data.mask            = kQ3PickDetailMaskXYZ | kQ3PickDetailMaskDistance;
+	rayData.data.numHitsToReturn = kQ3ReturnAllHits;
+	rayData.ray.origin.z         = 10.0f;
+	rayData.ray.direction.z      = -1.0f;
+	thePick = Q3WorldRayPick_New(&rayData);
+
+
+
+	// Pick without and then with the index, once through the middle of
+	// each of a grid of buildings.  Setting the property is an edit of the
+	// group, so each way picks every location in turn.
+	std::vector<std::vector<PickHit>>	plainHits(kPickGrid * kPickGrid);
+
+	for (n = 0; n < 2; ++n)
+		{
+		useIndex = (n == 0) ? kQ3False : kQ3True;
+		Q3Object_SetProperty(theScene, kQ3DisplayGroupPropertyPickIndex, sizeof(useIndex), &useIndex);
+
+		if (useIndex)
+			{
+			startTime = Seconds();
+			passed    = Check(PickScene(theView, thePick, theScene, indexHits), "first pick with index") && passed;
+			Report("first pick, building the index", Seconds() - startTime);
+			}
+
+		thePicked[n] = 0;
+		theTimes[n]  = 0.0;
+
+		for (y = 0; y < kPickGrid; ++y)
+			{
+			for (x = 0; x < kPickGrid; ++x)
+				{
+				rayData.ray.origin.x = (float) (x * kGridSize / kPickGrid) + 0.4f;
+				rayData.ray.origin.y = (float) (y * kGridSize / kPickGrid) + 0.4f;
+				Q3WorldRayPick_SetRay(thePick, &rayData.ray);
+
+				std::vector<PickHit>& theHits = useIndex ? indexHits : plainHits[y * kPickGrid + x];
+
+				startTime     = Seconds();
+				passed        = Check(PickScene(theView, thePick, theScene, theHits), "pick") && passed;
+				theTimes[n]  += Seconds() - startTime;
+				thePicked[n] += E3View_GetPickGeometryCount(theView);
+
+				if (useIndex)
+					{
+					const std::vector<PickHit>& otherHits = plainHits[y * kPickGrid + x];
+
+					numHits += (TQ3Uns32) indexHits.size();
+					if (indexHits.size() != otherHits.size() ||
+						(!indexHits.empty() && memcmp(indexHits.data(), otherHits.data(), indexHits.size() * sizeof(PickHit)) != 0))
+						numDifferent++;
+					}
+				}
+			}
+		}
+
+	Report("without index", theTimes[0], kPickGrid * kPickGrid, "picks");
+	Report("with index",    theTimes[1], kPickGrid * kPickGrid, "picks");
+	printf("    geometry pick methods per pick: %.1f without index, %.1f with\n",
+			(double) thePicked[0] / (kPickGrid * kPickGrid), (double) thePicked[1] / (kPickGrid * kPickGrid));
+
+	passed = Check(numHits != 0, "picks hit the buildings") && passed;
+	passed = Check(numDifferent == 0, "index finds the same hits") && passed;
+
+
+
+	// Move a building off the grid, where only an up to date index finds it
+	Q3Vector3D_Set(&theOffset, (float) (kGridSize + 8), (float) (kGridSize + 8), 0.0f);
+	Q3TranslateTransform_Set(theMoves.back(), &theOffset);
+
+	rayData.ray.origin.x = theOffset.x + 0.4f;
+	rayData.ray.origin.y = theOffset.y + 0.4f;
+	Q3WorldRayPick_SetRay(thePick, &rayData.ray);
+
+	startTime = Seconds();
+	passed    = Check(PickScene(theView, thePick, theScene, indexHits), "pick after an edit") && passed;
+	Report("pick after moving a building", Seconds() - startTime);
+
+	passed = Check(!indexHits.empty(), "moved building is found") && passed;
+
+
+
+	// Clean up
+	for (n = 0; n < theMoves.size(); ++n)
+		Q3Object_Dispose(theMoves[n]);
+
+	Q3Object_Dispose(thePick);
+	Q3Object_Dispose(theView);
+	Q3Object_Dispose(theScene);
+
+	return passed;
+}
+
+
+
+
+
+//=============================================================================
+//      Test_PushPop : Time pushing and popping the view state.
+//-----------------------------------------------------------------------------
+//		Note :	Each push changes a style and an attribute before popping
+//				them again, at several levels of nesting, and the state after
+//				each pop must be the state before the push.
+//-----------------------------------------------------------------------------
+static bool
+Test_PushPop(void)
+{	const TQ3Uns32				kNumPushes = 200000, kDepth = 8;
+	const TQ3FillStyle			kFillStyles[] = { kQ3FillStyleFilled, kQ3FillStyleEdges, kQ3FillStylePoints };
+	std::vector<TQ3Uns32>		theImage;
+	TQ3ViewObject				theView;
+	TQ3FillStyle				fillStyle, outerStyle;
+	const TQ3ColorRGB*			theColor;
+	TQ3ColorRGB					outerColor = { 0.0f, 0.0f, 0.0f };
+	TQ3Uns32					n, d;
+	double						startTime;
+	bool						passed = true;
+
+
+
+	// Create the view
+	theView = CreateView(kQ3RendererTypeGeneric, 32, 32, theImage);
+	if (!Check(theView != nullptr, "create view"))
+		return false;
+
+
+
+	// Push and pop, checking the state is restored
+	startTime = Seconds();
+
+	if (Q3View_StartRendering(theView) == kQ3Success)
+		{
+		do
+			{
+			theColor = nullptr;
+			Q3View_GetFillStyleState(theView, &outerStyle);
+			Q3View_GetAttributeState(theView, kQ3AttributeTypeDiffuseColor, &theColor);
+			passed = Check(theColor != nullptr, "get diffuse colour") && passed;
+			if (theColor != nullptr)
+				outerColor = *theColor;
+			
+			for (n = 0; n < kNumPushes; n += kDepth)
+				{
+				for (d = 0; d < kDepth; ++d)
+					{
+					TQ3ColorRGB	newColor = { (float) d / kDepth, 0.5f, 0.5f };
+					
+					Q3Push_Submit(theView);
+					Q3FillStyle_Submit(kFillStyles[d % 3], theView);
+					Q3Attribute_Submit(kQ3AttributeTypeDiffuseColor, &newColor, theView);
+					}
+				
+				for (d = 0; d < kDepth; ++d)
+					Q3Pop_Submit(theView);
+				}
+			
+			theColor = nullptr;
+			Q3View_GetFillStyleState(theView, &fillStyle);
+			Q3View_GetAttributeState(theView, kQ3AttributeTypeDiffuseColor, &theColor);
+			passed = Check(fillStyle == outerStyle, "fill style restored") && passed;
+			passed = Check(theColor != nullptr && memcmp(theColor, &outerColor, sizeof(outerColor)) == 0,
+							"diffuse colour restored") && passed;
+			}
+		while (Q3View_EndRendering(theView) == kQ3ViewStatusRetraverse);
+		}
+
+	Report("push, change and pop", Seconds() - startTime, kNumPushes / 1.0e6, "M pushes");
+
+	Q3Object_Dispose(theView);
+
+	return passed;
+}
+
+
+
+
+
+//=============================================================================
+//      RenderFrame : Render a scene into the image of a view.
+//-----------------------------------------------------------------------------
+static bool
+RenderFrame(TQ3ViewObject theView, TQ3Object theScene)
+{	TQ3ViewStatus		viewStatus;
+
+
+
+	if (Q3View_StartRendering(theView) != kQ3Success)
+		return false;
+
+	do
+		{
+		Q3Object_Submit(theScene, theView);
+		viewStatus = Q3View_EndRendering(theView);
+		}
+	while (viewStatus == kQ3ViewStatusRetraverse);
+
+	return (viewStatus == kQ3ViewStatusDone);
+}
+
+
+
+
+
+//=============================================================================
+//      SetRendererFlag : Set a boolean property of a view's renderer.
+//-----------------------------------------------------------------------------
+static void
+SetRendererFlag(TQ3ViewObject theView, TQ3ObjectType theProperty, TQ3Boolean theValue)
+{	TQ3RendererObject	theRenderer = nullptr;
+
+
+
+	Q3View_GetRenderer(theView, &theRenderer);
+	if (theRenderer != nullptr)
+		{
+		Q3Object_SetProperty(theRenderer, theProperty, sizeof(theValue), &theValue);
+		Q3Object_Dispose(theRenderer);
+		}
+}
+
+
+
+
+
+//=============================================================================
+//      GetRendererCount : Get a per-frame count reported by a view's renderer.
+//-----------------------------------------------------------------------------
+static unsigned long long
+GetRendererCount(TQ3ViewObject theView, TQ3ObjectType theProperty)
+{	TQ3RendererObject	theRenderer = nullptr;
+	TQ3Uns64			theCount    = { 0, 0 };
+
+
+
+	Q3View_GetRenderer(theView, &theRenderer);
+	if (theRenderer != nullptr)
+		{
+		Q3Object_GetProperty(theRenderer, theProperty, sizeof(theCount), nullptr, &theCount);
+		Q3Object_Dispose(theRenderer);
+		}
+
+	return ((unsigned long long) theCount.hi << 32) | theCount.lo;
+}
+
+
+
+
+
+//=============================================================================
+//      CountDifferentPixels : Count the pixels that differ between images.
+//-----------------------------------------------------------------------------
+//		Note :	A pixel differs if any channel differs by more than the
+//				tolerance.  A tolerance of 0 counts every change.
+//-----------------------------------------------------------------------------
+static TQ3Uns32
+CountDifferentPixels(const std::vector<TQ3Uns32>& imageA, const std::vector<TQ3Uns32>& imageB,
+						TQ3Uns32 tolerance)
+{	TQ3Uns32	n, shift, numDifferent = 0;
+
+
+
+	if (imageA.size() != imageB.size())
+		return (TQ3Uns32) std::max(imageA.size(), imageB.size());
+
+	for (n = 0; n < imageA.size(); ++n)
+		{
+		for (shift = 0; shift < 32; shift += 8)
+			{
+			int	channelA = (int) ((imageA[n] >> shift) & 0xFF);
+			int	channelB = (int) ((imageB[n] >> shift) & 0xFF);
+			
+			if ((TQ3Uns32) abs(channelA - channelB) > tolerance)
+				{
+				numDifferent++;
+				break;
+				}
+			}
+		}
+
+	return numDifferent;
+}
+
+
+
+
+
+//=============================================================================
+//      ReadPPM : Read a binary PPM file into an image.
+//-----------------------------------------------------------------------------
+//		Note :	The image is 32-bit ARGB in host byte order, as drawn by
+//				CreateView, with an opaque alpha.  Returns false if the file
+//				cannot be read, or is not of the given size.
+//-----------------------------------------------------------------------------
+static bool
+ReadPPM(const char* thePath, TQ3Uns32 theWidth, TQ3Uns32 theHeight, std::vector<TQ3Uns32>& theImage)
+{	FILE*			theFile = fopen(thePath, "rb");
+	unsigned int	fileWidth = 0, fileHeight = 0, maxValue = 0;
+	TQ3Uns8			thePixel[3];
+	TQ3Uns32		n;
+	bool			isValid;
+
+
+
+	if (theFile == nullptr)
+		return false;
+
+	isValid = (fscanf(theFile, "P6 %u %u %u", &fileWidth, &fileHeight, &maxValue) == 3 &&
+				fgetc(theFile) != EOF &&
+				fileWidth == theWidth && fileHeight == theHeight && maxValue == 255);
+
+	theImage.assign(theWidth * theHeight, 0);
+	for (n = 0; n < theImage.size() && isValid; ++n)
+		{
+		isValid     = (fread(thePixel, 1, 3, theFile) == 3);
+		theImage[n] = 0xFF000000 | (thePixel[0] << 16) | (thePixel[1] << 8) | thePixel[2];
+		}
+
+	fclose(theFile);
+	return isValid;
+}
+
+
+
+
+
+//=============================================================================
+//      WritePPM : Write an image to a binary PPM file.
+//-----------------------------------------------------------------------------
+static bool
+WritePPM(const char* thePath, TQ3Uns32 theWidth, TQ3Uns32 theHeight, const std::vector<TQ3Uns32>& theImage)
+{	FILE*			theFile = fopen(thePath, "wb");
+	TQ3Uns8			thePixel[3];
+	bool			isValid;
+
+
+
+	if (theFile == nullptr)
+		return false;
+
+	isValid = (fprintf(theFile, "P6\n%u %u\n255\n", (unsigned int) theWidth, (unsigned int) theHeight) > 0);
+
+	for (TQ3Uns32 theColor : theImage)
+		{
+		thePixel[0] = (TQ3Uns8) (theColor >> 16);
+		thePixel[1] = (TQ3Uns8) (theColor >>  8);
+		thePixel[2] = (TQ3Uns8) (theColor >>  0);
+		isValid = (fwrite(thePixel, 1, 3, theFile) == 3) && isValid;
+		}
+
+	return (fclose(theFile) == 0) && isValid;
+}
+
+
+
+
+
+//=============================================================================
+//      CreateOpenGLView : Create a view for the OpenGL renderer.
+//-----------------------------------------------------------------------------
+//		Note :	The OpenGL renderer needs a working OpenGL, which headless
+//				machines may provide through software Mesa.  If no frame can
+//				be rendered, the test is skipped rather than failed.
+//-----------------------------------------------------------------------------
+static TQ3ViewObject
+CreateOpenGLView(TQ3Uns32 theWidth, TQ3Uns32 theHeight, std::vector<TQ3Uns32>& theImage)
+{	TQ3GroupObject		emptyGroup;
+	TQ3ViewObject		theView;
+
+
+
+	theView    = CreateView(kQ3RendererTypeOpenGL, theWidth, theHeight, theImage);
+	emptyGroup = Q3DisplayGroup_New();
+
+	if (theView != nullptr && !RenderFrame(theView, emptyGroup))
+		Q3Object_CleanDispose(&theView);
+
+	Q3Object_Dispose(emptyGroup);
+
+	if (theView == nullptr)
+		printf("    skipped, the OpenGL renderer is not available\n");
+
+	return theView;
+}
+
+
+
+
+
+//=============================================================================
+//      Test_GroupBounds : Time automatic group culling of a city grid.
+//-----------------------------------------------------------------------------
+//		Note :	The city is a grid of blocks, each a grid of buildings, and
+//				each building is a display group with a translate and one of
+//				a few shared boxes.  Only a few blocks are in view.  Moving a
+//				building into view must invalidate the bounds of its block,
+//				so the image must be the same with culling as without.
+//
+//				A camera sweep times frames with more and more of the city in
+//				view, to show how the gain falls as less can be culled.
+//-----------------------------------------------------------------------------
+static bool
+Test_GroupBounds(void)
+{	const TQ3Uns32				kNumBlocks = 10, kBlockSize = 32, kNumMeshes = 8;
+	const TQ3Uns32				kCitySize = kNumBlocks * kBlockSize;
+	const TQ3Uns32				kNumFrames = 20;
+	const float					kVisibleFractions[] = { 0.001f, 0.01f, 0.1f, 0.25f, 0.5f, 1.0f };
+	std::vector<TQ3GeometryObject>	theMeshes;
+	std::vector<TQ3TransformObject>	theTransforms;
+	std::vector<TQ3Uns32>		theImage, culledImage, movedImage;
+	TQ3GroupObject				theCity, theBlock, theBuilding;
+	TQ3BoxData					boxData;
+	TQ3Vector3D					theOffset;
+	TQ3ViewObject				theView;
+	TQ3CameraObject				theCamera;
+	TQ3CameraPlacement			oldPlacement;
+	TQ3CameraRange				oldRange;
+	TQ3Uns32					bx, by, x, y, n;
+	double						startTime;
+	bool						passed = true;
+	char						theLabel[64];
+
+
+
+	// Create the buildings
+	memset(&boxData, 0, sizeof(boxData));
+	boxData.majorAxis.x = 0.6f;
+	boxData.minorAxis.y = 0.6f;
+
+	for (n = 0; n < kNumMeshes; ++n)
+		{
+		boxData.orientation.z = 0.25f * (n + 1);
+		theMeshes.push_back(Q3Box_New(&boxData));
+		}
+
+	theCity = Q3DisplayGroup_New();
+	if (!Check(theCity != nullptr, "create city"))
+		return false;
+
+	for (by = 0; by < kNumBlocks; ++by)
+		{
+		for (bx = 0; bx < kNumBlocks; ++bx)
+			{
+			theBlock = Q3DisplayGroup_New();
+			
+			for (y = by * kBlockSize; y < (by + 1) * kBlockSize; ++y)
+				{
+				for (x = bx * kBlockSize; x < (bx + 1) * kBlockSize; ++x)
+					{
+					Q3Vector3D_Set(&theOffset, (float) x - kCitySize / 2.0f,
+											(float) y - kCitySize / 2.0f, 0.0f);
+					theTransforms.push_back(Q3TranslateTransform_New(&theOffset));
+					
+					theBuilding = Q3DisplayGroup_New();
+					Q3Group_AddObject(theBuilding, theTransforms.back());
+					Q3Group_AddObject(theBuilding, theMeshes[(x * 7 + y * 3) % kNumMeshes]);
+					Q3Group_AddObject(theBlock, theBuilding);
+					Q3Object_Dispose(theBuilding);
+					}
+				}
+			
+			Q3Group_AddObject(theCity, theBlock);
+			Q3Object_Dispose(theBlock);
+			}
+		}
+
+
+
+	// Create the view
+	theView = CreateView(kQ3RendererTypeSoftware, 64, 64, theImage);
+	if (!Check(theView != nullptr, "create view"))
+		{
+		Q3Object_Dispose(theCity);
+		return false;
+		}
+
+
+
+	// Time frames without culling, and with culling before and after the
+	// bounds have been computed
+	Q3View_AllowAutomaticGroupCulling(theView, kQ3False);
+	startTime = Seconds();
+	passed = Check(RenderFrame(theView, theCity), "render without culling") && passed;
+	Report("frame without culling", Seconds() - startTime, theTransforms.size() / 1.0e6, "M groups");
+
+	Q3View_AllowAutomaticGroupCulling(theView, kQ3True);
+	startTime = Seconds();
+	passed = Check(RenderFrame(theView, theCity), "render with culling") && passed;
+	Report("first frame with culling", Seconds() - startTime, theTransforms.size() / 1.0e6, "M groups");
+
+	startTime = Seconds();
+	for (n = 0; n < kNumFrames; ++n)
+		RenderFrame(theView, theCity);
+	Report("frame with cached bounds", (Seconds() - startTime) / kNumFrames);
+
+
+
+	// Sweep the camera up over the city, so that more of it is in view, and
+	// time frames with and without culling.  The camera sees a square of
+	// ground whose side is 2 tan(fov / 2) times its height.
+	Q3View_GetCamera(theView, &theCamera);
+	Q3Camera_GetPlacement(theCamera, &oldPlacement);
+	Q3Camera_GetRange(theCamera, &oldRange);
+
+	for (n = 0; n < sizeof(kVisibleFractions) / sizeof(kVisibleFractions[0]); ++n)
+		{
+		TQ3CameraPlacement	thePlacement = oldPlacement;
+		TQ3CameraRange		theRange     = oldRange;
+		float				theSide      = kCitySize * sqrtf(kVisibleFractions[n]);
+		
+		thePlacement.cameraLocation.z = theSide / (2.0f * tanf(0.4f));
+		theRange.yon                  = thePlacement.cameraLocation.z + 10.0f;
+		Q3Camera_SetPlacement(theCamera, &thePlacement);
+		Q3Camera_SetRange(theCamera, &theRange);
+		
+		for (x = 0; x < 2; ++x)
+			{
+			Q3View_AllowAutomaticGroupCulling(theView, (x == 0) ? kQ3False : kQ3True);
+			RenderFrame(theView, theCity);
+			
+			startTime = Seconds();
+			passed = Check(RenderFrame(theView, theCity), "render camera sweep") && passed;
+			
+			snprintf(theLabel, sizeof(theLabel), "%5.1f%% in view, %s", 100.0f * kVisibleFractions[n],
+					(x == 0) ? "without culling" : "with culling");
+			Report(theLabel, Seconds() - startTime);
+			}
+		}
+
+	Q3Camera_SetPlacement(theCamera, &oldPlacement);
+	Q3Camera_SetRange(theCamera, &oldRange);
+	Q3Object_Dispose(theCamera);
+
+
+
+	// Time frames after editing a building far out of view, and a shared box
+	startTime = Seconds();
+	for (n = 0; n < kNumFrames; ++n)
+		{
+		Q3Vector3D_Set(&theOffset, -(float) (kCitySize / 2), (float) n - kCitySize / 2.0f, 0.0f);
+		Q3TranslateTransform_Set(theTransforms[n * kCitySize], &theOffset);
+		RenderFrame(theView, theCity);
+		}
+	Report("frame after moving one building", (Seconds() - startTime) / kNumFrames);
+
+	startTime = Seconds();
+	for (n = 0; n < kNumFrames; ++n)
+		{
+		boxData.orientation.z = 0.25f + 0.01f * n;
+		Q3Box_SetData(theMeshes[0], &boxData);
+		RenderFrame(theView, theCity);
+		}
+	Report("frame after editing a shared box", (Seconds() - startTime) / kNumFrames);
+
+
+
+	// Move a building from the corner of the city into view, and check it
+	// is drawn the same with culling as without
+	culledImage = theImage;
+
+	Q3Vector3D_Set(&theOffset, 0.5f, 0.5f, 0.0f);
+	Q3TranslateTransform_Set(theTransforms[0], &theOffset);
+	passed = Check(RenderFrame(theView, theCity), "render moved building") && passed;
+	movedImage = theImage;
+
+	Q3View_AllowAutomaticGroupCulling(theView, kQ3False);
+	passed = Check(RenderFrame(theView, theCity), "render moved building without culling") && passed;
+
+	passed = Check(movedImage != culledImage, "moved building drawn") && passed;
+	passed = Check(movedImage == theImage, "culled image matches unculled image") && passed;
+
+
+
+	// Clean up
+	Q3Object_Dispose(theView);
+	Q3Object_Dispose(theCity);
+
+	for (n = 0; n < theTransforms.size(); ++n)
+		Q3Object_Dispose(theTransforms[n]);
+
+	for (n = 0; n < kNumMeshes; ++n)
+		Q3Object_Dispose(theMeshes[n]);
+
+	return passed;
+}
+
+
+
+
+
+//=============================================================================
+//      Test_OptimizeHierarchy : Time optimizing a scene's TriMeshes on 1..N threads.
+//-----------------------------------------------------------------------------
+//		Note :	The scene has many small TriMeshes, which are optimized several
+//				at once, and a few large ones, whose work is split across
+//				threads.  The meshes have no vertex normals, so every mesh must
+//				be rebuilt.  Marking each mesh as edited throws away its cached
+//				result before the next run.
+//-----------------------------------------------------------------------------
+static bool
+Test_OptimizeHierarchy(void)
+{	const TQ3Uns32				kNumSmall = 512, kNumLarge = 4;
+	const TQ3Uns32				kThreadCounts[] = { 1, 2, 4, 8 };
+	std::vector<TQ3Object>		theMeshes;
+	std::vector<TQ3Uns8>		serialData, parallelData;
+	TQ3TriMeshData				triMeshData;
+	TQ3GroupObject				theScene;
+	TQ3Object					theObject, optimizedMesh;
+	TQ3Uns32					n, numTriangles = 0;
+	double						startTime;
+	bool						passed = true;
+	char						theLabel[64];
+
+
+
+	// Build the scene, from grids with their vertex normals removed
+	theScene = Q3DisplayGroup_New();
+
+	for (n = 0; n < kNumSmall + kNumLarge; ++n)
+		{
+		TQ3Uns32	theSize = (n < kNumSmall) ? 32 : 256;
+		
+		theObject = CreateGridTriMesh(theSize, theSize);
+		Q3TriMesh_GetData(theObject, &triMeshData);
+		Q3Object_Dispose(theObject);
+		
+		triMeshData.numVertexAttributeTypes = 0;
+		theObject = Q3TriMesh_New(&triMeshData);
+		triMeshData.numVertexAttributeTypes = 2;
+		Q3TriMesh_EmptyData(&triMeshData);
+		
+		Q3Group_AddObject(theScene, theObject);
+		theMeshes.push_back(theObject);
+		numTriangles += 2 * theSize * theSize;
+		}
+
+
+
+	// Optimize the scene on each number of threads
+	for (TQ3Uns32 numThreads : kThreadCounts)
+		{
+		Q3SetThreadCount(numThreads);
+		
+		for (TQ3Object theMesh : theMeshes)
+			Q3Shared_Edited(theMesh);
+		
+		startTime = Seconds();
+		passed    = Check(Q3TriMesh_OptimizeHierarchy(theScene) == kQ3Success, "optimize scene") && passed;
+		snprintf(theLabel, sizeof(theLabel), "%u thread%s",
+					(unsigned int) numThreads, (numThreads == 1) ? "" : "s");
+		Report(theLabel, Seconds() - startTime, numTriangles / 1000.0, "ktriangles");
+		}
+
+	startTime = Seconds();
+	passed    = Check(Q3TriMesh_OptimizeHierarchy(theScene) == kQ3Success, "optimize scene again") && passed;
+	Report("already optimized", Seconds() - startTime);
+
+
+
+	// Splitting a large mesh across threads must give the same mesh
+	Q3SetThreadCount(1);
+	optimizedMesh = Q3TriMesh_Optimize(theMeshes.back());
+	passed = Check(optimizedMesh != nullptr && FlattenToMemory(optimizedMesh, serialData),
+					"optimize large mesh on 1 thread") && passed;
+	Q3Object_CleanDispose(&optimizedMesh);
+
+	Q3SetThreadCount(0);
+	optimizedMesh = Q3TriMesh_Optimize(theMeshes.back());
+	passed = Check(optimizedMesh != nullptr && FlattenToMemory(optimizedMesh, parallelData),
+					"optimize large mesh on all threads") && passed;
+	Q3Object_CleanDispose(&optimizedMesh);
+
+	passed = Check(parallelData == serialData, "parallel optimization gives the same mesh") && passed;
+
+
+
+	// Clean up
+	Q3Object_Dispose(theScene);
+
+	for (TQ3Object& theMesh : theMeshes)
+		Q3Object_CleanDispose(&theMesh);
+
+	return passed;
+}
+
+
+
+
+
+//=============================================================================
+//      Test_VertexCache : Measure the vertex cache use of a shuffled grid,
+//				before and after reordering its triangles.
+//-----------------------------------------------------------------------------
+//		Note :	The triangles of a 256 x 256 grid are shuffled, which makes
+//				nearly every vertex a cache miss.  Q3TriMesh_OptimizeTriangleOrder
+//				must bring the average cache miss ratio well below that of the
+//				shuffled order, and keep each triangle with its points in the
+//				same order.
+//-----------------------------------------------------------------------------
+static bool
+Test_VertexCache(void)
+{	const TQ3Uns32				kGridSize = 256, kNumRuns = 5;
+	const TQ3Uns32				kCacheSizes[] = { 16, 32 };
+	const TQ3Uns32				numPoints = (kGridSize + 1) * (kGridSize + 1);
+	std::vector<TQ3Uns32>		shuffled, optimized;
+	std::vector<TQ3Uns32>		theOrder;
+	std::mt19937				theRandom(14);
+	float						shuffledACMR, optimizedACMR, theATVR;
+	TQ3Uns32					x, y, n, numTriangles;
+	double						startTime, bestTime = 0.0;
+	bool						passed = true;
+	char						theLabel[64];
+
+
+
+	// Build the grid, and shuffle its triangles
+	for (y = 0; y < kGridSize; ++y)
+		{
+		for (x = 0; x < kGridSize; ++x)
+			{
+			n = y * (kGridSize + 1) + x;
+			theOrder.push_back(n);
+			theOrder.push_back(n + 1);
+			theOrder.push_back(n + kGridSize + 2);
+			theOrder.push_back(n);
+			theOrder.push_back(n + kGridSize + 2);
+			theOrder.push_back(n + kGridSize + 1);
+			}
+		}
+
+	numTriangles = (TQ3Uns32) theOrder.size() / 3;
+
+	std::vector<TQ3Uns32>	triangleIndex(numTriangles);
+	for (n = 0; n < numTriangles; ++n)
+		triangleIndex[n] = n;
+	std::shuffle(triangleIndex.begin(), triangleIndex.end(), theRandom);
+
+	for (n = 0; n < numTriangles; ++n)
+		shuffled.insert(shuffled.end(), &theOrder[3 * triangleIndex[n]], &theOrder[3 * triangleIndex[n]] + 3);
+
+
+
+	// Reorder them, keeping the best of several runs
+	optimized.resize(shuffled.size());
+
+	for (n = 0; n < kNumRuns; ++n)
+		{
+		startTime = Seconds();
+		passed = Check(Q3TriMesh_OptimizeTriangleOrder(numTriangles, &shuffled[0], numPoints,
+						&optimized[0]) == kQ3Success, "optimize triangle order") && passed;
+		startTime = Seconds() - startTime;
+		
+		if (n == 0 || startTime < bestTime)
+			bestTime = startTime;
+		}
+
+	Report("optimize triangle order", bestTime, numTriangles / 1.0e6, "M triangles");
+
+
+
+	// Check the triangles are the same, with the same orientation
+	std::vector<std::array<TQ3Uns32, 3>>	inTriangles(numTriangles), outTriangles(numTriangles);
+
+	for (n = 0; n < numTriangles; ++n)
+		{
+		const TQ3Uns32*	inTri  = &shuffled[3 * n];
+		const TQ3Uns32*	outTri = &optimized[3 * n];
+		TQ3Uns32		inFirst  = (TQ3Uns32) (std::min_element(inTri,  inTri  + 3) - inTri);
+		TQ3Uns32		outFirst = (TQ3Uns32) (std::min_element(outTri, outTri + 3) - outTri);
+		
+		for (x = 0; x < 3; ++x)
+			{
+			inTriangles[n][x]  = inTri[(inFirst + x) % 3];
+			outTriangles[n][x] = outTri[(outFirst + x) % 3];
+			}
+		}
+
+	std::sort(inTriangles.begin(),  inTriangles.end());
+	std::sort(outTriangles.begin(), outTriangles.end());
+	passed = Check(inTriangles == outTriangles, "same triangles with the same orientation") && passed;
+
+
+
+	// Measure the cache use before and after
+	for (TQ3Uns32 cacheSize : kCacheSizes)
+		{
+		Q3TriMesh_SimulateVertexCache(numTriangles, &shuffled[0], numPoints, cacheSize,
+										&shuffledACMR, &theATVR);
+		Q3TriMesh_SimulateVertexCache(numTriangles, &optimized[0], numPoints, cacheSize,
+										&optimizedACMR, &theATVR);
+		
+		snprintf(theLabel, sizeof(theLabel), "%u entry cache", (unsigned int) cacheSize);
+		printf("    %-40s ACMR %.3f shuffled, %.3f optimized (ATVR %.3f)\n",
+				theLabel, shuffledACMR, optimizedACMR, theATVR);
+		
+		passed = Check(optimizedACMR < 0.5f * shuffledACMR, "optimized ACMR is less than half the shuffled ACMR") && passed;
+		passed = Check(optimizedACMR < 0.8f, "optimized ACMR is below 0.8") && passed;
+		}
+
+	return passed;
+}
+
+
+
+
+
+//=============================================================================
+//      Test_EdgeAdjacency : Time finding the edges and face links of 1M faces.
+//-----------------------------------------------------------------------------
+//		Note :	The faces are a 1024 x 512 grid with some faces repeated, some
+//				reversed and some degenerate, shuffled and with their corners
+//				rotated.  The results of E3EdgeAdjacency_Build,
+//				QOCalcTriMeshEdges and StripMaker::FindAdjacencies are compared
+//				with a reference that sorts the half edges, including the order
+//				of the edges: by smaller point index, then by first use.
+//-----------------------------------------------------------------------------
+static bool
+Test_EdgeAdjacency(void)
+{	const TQ3Uns32							kCols = 1024, kRows = 512, kNumDefects = 1000, kNumRuns = 3;
+	typedef std::array<TQ3Uns32, 3>			TripleRec;
+	std::vector<TQ3Uns32>					theFaces, theOrder;
+	std::vector<TripleRec>					halfEdges, theGroups;
+	std::vector<TQ3Uns32>					groupOfHalfEdge, groupStart, edgeOfGroup;
+	std::mt19937							theRandom(15);
+	TQ3Uns32								x, y, n, k, numFaces, numEdges;
+	double									startTime, bestTime = 0.0;
+	bool									passed = true;
+
+
+
+	// Build the grid and its defects, then shuffle the faces
+	for (y = 0; y < kRows; ++y)
+		{
+		for (x = 0; x < kCols; ++x)
+			{
+			n = y * (kCols + 1) + x;
+			theOrder.insert(theOrder.end(), { n, n + 1, n + kCols + 2 });
+			theOrder.insert(theOrder.end(), { n, n + kCols + 2, n + kCols + 1 });
+			}
+		}
+
+	for (n = 0; n < kNumDefects; ++n)
+		{
+		TQ3Uns32	repeated = 3 * (7 * n);
+		TQ3Uns32	reversed = 3 * (7 * n + 3);
+		theOrder.insert(theOrder.end(), { theOrder[repeated], theOrder[repeated + 1], theOrder[repeated + 2] });
+		theOrder.insert(theOrder.end(), { theOrder[reversed], theOrder[reversed + 2], theOrder[reversed + 1] });
+		theOrder.insert(theOrder.end(), { theOrder[reversed], theOrder[reversed], theOrder[reversed + 1] });
+		}
+
+	numFaces = (TQ3Uns32) theOrder.size() / 3;
+
+	std::vector<TQ3Uns32>	faceIndex(numFaces);
+	for (n = 0; n < numFaces; ++n)
+		faceIndex[n] = n;
+	std::shuffle(faceIndex.begin(), faceIndex.end(), theRandom);
+
+	for (n = 0; n < numFaces; ++n)
+		{
+		TQ3Uns32	theRotation = theRandom() % 3;
+		for (k = 0; k < 3; ++k)
+			theFaces.push_back(theOrder[3 * faceIndex[n] + (k + theRotation) % 3]);
+		}
+
+	printf("    %u faces, %u points\n", (unsigned int) numFaces, (unsigned int) ((kCols + 1) * (kRows + 1)));
+
+
+
+	// Time the edge adjacency, keeping the best of several runs
+	TE3EdgeAdjacency	theAdjacency;
+
+	for (n = 0; n < kNumRuns; ++n)
+		{
+		startTime = Seconds();
+		E3EdgeAdjacency_Build(numFaces, &theFaces[0], theAdjacency);
+		startTime = Seconds() - startTime;
+		
+		if (n == 0 || startTime < bestTime)
+			bestTime = startTime;
+		}
+
+	Report("E3EdgeAdjacency_Build", bestTime, numFaces / 1.0e6, "M faces");
+
+
+
+	// Find the reference edges by sorting the half edges by their ends.  A
+	// run of equal ends is one edge, and the edges are ordered by their
+	// smaller point index and then by their first half edge.
+	startTime = Seconds();
+	halfEdges.resize(3 * numFaces);
+	for (n = 0; n < 3 * numFaces; ++n)
+		{
+		TQ3Uns32	startPt = theFaces[n];
+		TQ3Uns32	endPt   = theFaces[n - n % 3 + (n % 3 + 1) % 3];
+		halfEdges[n] = { std::min(startPt, endPt), std::max(startPt, endPt), n };
+		}
+
+	std::sort(halfEdges.begin(), halfEdges.end());
+
+	groupOfHalfEdge.resize(3 * numFaces);
+	for (n = 0; n < 3 * numFaces; ++n)
+		{
+		if (n == 0 || halfEdges[n][0] != halfEdges[n - 1][0] || halfEdges[n][1] != halfEdges[n - 1][1])
+			{
+			theGroups.push_back({ halfEdges[n][0], halfEdges[n][2], (TQ3Uns32) groupStart.size() });
+			groupStart.push_back(n);
+			}
+		
+		groupOfHalfEdge[halfEdges[n][2]] = (TQ3Uns32) groupStart.size() - 1;
+		}
+
+	numEdges = (TQ3Uns32) groupStart.size();
+	groupStart.push_back(3 * numFaces);
+	std::sort(theGroups.begin(), theGroups.end());
+
+	edgeOfGroup.resize(numEdges);
+	for (n = 0; n < numEdges; ++n)
+		edgeOfGroup[theGroups[n][2]] = n;
+
+	Report("reference sort", Seconds() - startTime, numFaces / 1.0e6, "M faces");
+	printf("    %u edges\n", (unsigned int) numEdges);
+
+
+
+	// Compare the edges, in order, and the half edges of each edge
+	bool	sameEdges = (theAdjacency.edgeEnds.size() == 2 * numEdges) &&
+						(theAdjacency.edgeHalfEdgeStart.size() == numEdges + 1);
+
+	for (n = 0; sameEdges && n < numEdges; ++n)
+		{
+		TQ3Uns32	theGroup = theGroups[n][2];
+		TQ3Uns32	theStart = groupStart[theGroup];
+		TQ3Uns32	theCount = groupStart[theGroup + 1] - theStart;
+		
+		sameEdges = theAdjacency.edgeEnds[2 * n]     == halfEdges[theStart][0] &&
+					theAdjacency.edgeEnds[2 * n + 1] == halfEdges[theStart][1] &&
+					theAdjacency.edgeHalfEdgeStart[n + 1] - theAdjacency.edgeHalfEdgeStart[n] == theCount;
+		
+		for (k = 0; sameEdges && k < theCount; ++k)
+			sameEdges = theAdjacency.edgeHalfEdges[theAdjacency.edgeHalfEdgeStart[n] + k] == halfEdges[theStart + k][2];
+		}
+
+	for (n = 0; sameEdges && n < 3 * numFaces; ++n)
+		sameEdges = theAdjacency.halfEdgeToEdge[n] == edgeOfGroup[groupOfHalfEdge[n]];
+
+	passed = Check(sameEdges, "edge adjacency matches the reference") && passed;
+
+
+
+	// Compare the OpenGL renderer's edges and face to edge map
+	std::vector<TQ3TriMeshTriangleData>	theTriangles(numFaces);
+	TQ3TriMeshData						theData;
+	TQ3EdgeVec							theEdges;
+	TQ3TriangleToEdgeVec				facesToEdges;
+
+	for (n = 0; n < numFaces; ++n)
+		for (k = 0; k < 3; ++k)
+			theTriangles[n].pointIndices[k] = theFaces[3 * n + k];
+
+	memset(&theData, 0, sizeof(theData));
+	theData.numTriangles = numFaces;
+	theData.triangles    = &theTriangles[0];
+
+	startTime = Seconds();
+	QOCalcTriMeshEdges(theData, theEdges, &facesToEdges);
+	Report("QOCalcTriMeshEdges", Seconds() - startTime, numFaces / 1.0e6, "M faces");
+
+	sameEdges = (theEdges.size() == numEdges) && (facesToEdges.size() == numFaces);
+
+	for (n = 0; sameEdges && n < numEdges; ++n)
+		sameEdges = theEdges[n].pointIndices[0] == theAdjacency.edgeEnds[2 * n] &&
+					theEdges[n].pointIndices[1] == theAdjacency.edgeEnds[2 * n + 1];
+
+	for (n = 0; sameEdges && n < numFaces; ++n)
+		for (k = 0; k < 3; ++k)
+			sameEdges = sameEdges && facesToEdges[n].edgeIndices[k] == edgeOfGroup[groupOfHalfEdge[3 * n + k]];
+
+	passed = Check(sameEdges, "TriMesh edges and face to edge map match the reference") && passed;
+
+
+
+	// Compare the strip links.  Within each edge, the half edges running
+	// from the smaller point are paired in order with those running from
+	// the larger point.  Half edge 3 * f + k is edge (k + 2) % 3 of a face.
+	StripMaker::FaceVec		stripFaces, expectedFaces;
+	std::vector<TQ3Uns32>	forward, backward;
+
+	StripMaker::InitFaces(numFaces, &theFaces[0], expectedFaces);
+
+	for (n = 0; n < numEdges; ++n)
+		{
+		forward.clear();
+		backward.clear();
+		
+		for (k = groupStart[n]; k < groupStart[n + 1]; ++k)
+			{
+			TQ3Uns32	halfEdge = halfEdges[k][2];
+			if (E3EdgeAdjacency_IsFlipped(&theFaces[0], halfEdge))
+				backward.push_back(halfEdge);
+			else
+				forward.push_back(halfEdge);
+			}
+		
+		for (k = 0; k < forward.size() && k < backward.size(); ++k)
+			{
+			StripMaker::Face&	faceA = expectedFaces[forward[k]  / 3];
+			StripMaker::Face&	faceB = expectedFaces[backward[k] / 3];
+			TQ3Uns32			edgeA = (forward[k]  + 2) % 3;
+			TQ3Uns32			edgeB = (backward[k] + 2) % 3;
+			
+			faceA.adjFace[edgeA] = backward[k] / 3;
+			faceA.adjEdge[edgeA] = edgeB;
+			faceB.adjFace[edgeB] = forward[k] / 3;
+			faceB.adjEdge[edgeB] = edgeA;
+			}
+		}
+
+	StripMaker::InitFaces(numFaces, &theFaces[0], stripFaces);
+
+	startTime = Seconds();
+	StripMaker::FindAdjacencies(stripFaces);
+	Report("StripMaker::FindAdjacencies", Seconds() - startTime, numFaces / 1.0e6, "M faces");
+
+	bool	sameLinks = true;
+
+	for (n = 0; sameLinks && n < numFaces; ++n)
+		sameLinks = memcmp(&stripFaces[n], &expectedFaces[n], sizeof(StripMaker::Face)) == 0;
+
+	passed = Check(sameLinks, "strip links match the reference") && passed;
+
+	return passed;
+}
+
+
+
+
+
+//=============================================================================
+//      Test_Silhouette : Time updating a shadow silhouette as a light moves.
+//-----------------------------------------------------------------------------
+//		Note :	A 512 x 512 grid is bent into waves, and a point light circles
+//				over it in small steps.  Each frame, the silhouette kept by a
+//				SilhouetteCache is compared with one computed from scratch by
+//				a new cache: the lit faces, the edge counters and the set of
+//				silhouette edges must all be the same.
+//-----------------------------------------------------------------------------
+static bool
+Test_Silhouette(void)
+{	const TQ3Uns32				kGridSize = 512, kNumFrames = 100;
+	const TQ3BackfacingStyle	kBackfacingStyles[] = { kQ3BackfacingStyleBoth, kQ3BackfacingStyleRemove };
+	const char*					kStyleNames[] = { "both", "remove" };
+	TQ3GeometryObject			theMesh;
+	TQ3LightObject				theLight;
+	TQ3PointLightData			lightData;
+	TQ3TriMeshData*				meshData;
+	TQ3EdgeVec					theEdges;
+	TQ3TriangleToEdgeVec		facesToEdges;
+	TQ3RationalPoint4D			lightPos;
+	TQ3Uns32					n, frame, style, numSilhouetteEdges;
+	double						startTime, updateTime, recomputeTime;
+	char						theLabel[64];
+	bool						passed = true;
+
+
+
+	// Create the mesh and the light
+	theMesh = CreateGridTriMesh(kGridSize, kGridSize);
+	if (!Check(theMesh != nullptr, "create TriMesh"))
+		return false;
+
+	Q3TriMesh_LockData(theMesh, kQ3False, &meshData);
+	for (n = 0; n < meshData->numPoints; ++n)
+		meshData->points[n].z = 4.0f * sinf(0.05f * meshData->points[n].x) * cosf(0.07f * meshData->points[n].y);
+	Q3TriMesh_UnlockData(theMesh);
+
+	memset(&lightData, 0, sizeof(lightData));
+	lightData.lightData.isOn       = kQ3True;
+	lightData.lightData.brightness = 1.0f;
+	Q3ColorRGB_Set(&lightData.lightData.color, 1.0f, 1.0f, 1.0f);
+	lightData.castsShadows         = kQ3True;
+	theLight = Q3PointLight_New(&lightData);
+
+	Q3TriMesh_LockData(theMesh, kQ3True, &meshData);
+	QOCalcTriMeshEdges(*meshData, theEdges, &facesToEdges);
+	printf("    %u faces, %u edges\n", (unsigned int) meshData->numTriangles, (unsigned int) theEdges.size());
+
+
+
+	// Move the light, and compare each update with a full recompute
+	for (style = 0; style < 2; ++style)
+		{
+		QORenderer::SilhouetteCache		theCache;
+		
+		updateTime         = 0.0;
+		recomputeTime      = 0.0;
+		numSilhouetteEdges = 0;
+		
+		for (frame = 0; frame <= kNumFrames; ++frame)
+			{
+			float	theAngle = 0.002f * frame;
+			
+			lightPos.x = 0.5f * kGridSize + 100.0f * cosf(theAngle);
+			lightPos.y = 0.5f * kGridSize + 100.0f * sinf(theAngle);
+			lightPos.z = 20.0f;
+			lightPos.w = 1.0f;
+			
+			startTime = Seconds();
+			const QORenderer::SilhouetteState&	theState = theCache.Update(theMesh, theLight, *meshData, nullptr,
+															theEdges, facesToEdges, lightPos, kBackfacingStyles[style]);
+			startTime = Seconds() - startTime;
+			
+			// The first frame builds the state, so is not counted
+			if (frame != 0)
+				updateTime += startTime;
+			
+			QORenderer::SilhouetteCache		freshCache;
+			
+			startTime = Seconds();
+			const QORenderer::SilhouetteState&	freshState = freshCache.Update(theMesh, theLight, *meshData, nullptr,
+															theEdges, facesToEdges, lightPos, kBackfacingStyles[style]);
+			startTime = Seconds() - startTime;
+			
+			if (frame != 0)
+				recomputeTime += startTime;
+			
+			
+			
+			// Compare the states
+			bool	sameState = theState.mEdgeCounters.size() == theEdges.size() &&
+								freshState.mEdgeCounters.size() == theEdges.size() &&
+								theState.mSilhouetteEdges.size() == freshState.mSilhouetteEdges.size();
+			
+			for (n = 0; sameState && n < meshData->numTriangles; ++n)
+				sameState = theState.mLitFaceFlags[n] == freshState.mLitFaceFlags[n];
+			
+			for (n = 0; sameState && n < theEdges.size(); ++n)
+				sameState = theState.mEdgeCounters[n] == freshState.mEdgeCounters[n];
+			
+			if (sameState)
+				{
+				std::vector<TQ3Uns32>	keptEdges(theState.mSilhouetteEdges.data(),
+											theState.mSilhouetteEdges.data() + theState.mSilhouetteEdges.size());
+				std::vector<TQ3Uns32>	freshEdges(freshState.mSilhouetteEdges.data(),
+											freshState.mSilhouetteEdges.data() + freshState.mSilhouetteEdges.size());
+				
+				std::sort(keptEdges.begin(), keptEdges.end());
+				std::sort(freshEdges.begin(), freshEdges.end());
+				sameState = keptEdges == freshEdges;
+				}
+			
+			if (!Check(sameState, "updated silhouette matches a full recompute"))
+				{
+				printf("    at frame %u, backfacing %s\n", (unsigned int) frame, kStyleNames[style]);
+				passed = false;
+				break;
+				}
+			
+			numSilhouetteEdges += (TQ3Uns32) theState.mSilhouetteEdges.size();
+			}
+		
+		printf("    backfacing %-29s %u silhouette edges per frame\n", kStyleNames[style],
+				(unsigned int) (numSilhouetteEdges / (kNumFrames + 1)));
+		
+		snprintf(theLabel, sizeof(theLabel), "update per frame, backfacing %s", kStyleNames[style]);
+		Report(theLabel, updateTime / kNumFrames);
+		
+		snprintf(theLabel, sizeof(theLabel), "recompute per frame, backfacing %s", kStyleNames[style]);
+		Report(theLabel, recomputeTime / kNumFrames);
+		}
+
+	Q3TriMesh_UnlockData(theMesh);
+	Q3Object_Dispose(theLight);
+	Q3Object_Dispose(theMesh);
+
+	return passed;
+}
+
+
+
+
+
+//=============================================================================
+//      Test_BatchTriMeshes : Time drawing many small TriMeshes, with batching.
+//-----------------------------------------------------------------------------
+//		Note :	The scene is a grid of small TriMeshes which share a colour,
+//				each in its own group with a translate.  Batching must cut
+//				the draw calls and give the same image, apart from rounding
+//				of the vertices, which batching transforms on the CPU.
+//
+//				The same triangles merged into one TriMesh by hand give the
+//				fastest frame that batching could reach.  What batching
+//				cannot remove is the cost of submitting each TriMesh.
+//-----------------------------------------------------------------------------
+static bool
+Test_BatchTriMeshes(void)
+{	const TQ3Uns32				kGridSize = 100, kNumFrames = 10;
+	const float					kSpacing = 2.5f;
+	std::vector<TQ3Uns32>		theImage, plainImage;
+	std::vector<TQ3Point3D>		mergedPoints;
+	std::vector<TQ3Vector3D>	mergedNormals;
+	std::vector<TQ3TriMeshTriangleData>	mergedTriangles;
+	TQ3TriMeshAttributeData		normalAttribute;
+	TQ3TriMeshData				mergedData, *meshData;
+	TQ3GroupObject				theScene, theCell, mergedScene;
+	TQ3Object					theObject, theMesh;
+	TQ3ColorRGB					theColor = { 0.9f, 0.6f, 0.2f };
+	TQ3Vector3D					theScale = { 0.032f, 0.032f, 0.032f };
+	TQ3Vector3D					theOffset;
+	TQ3ViewObject				theView;
+	TQ3Uns32					x, y, n, k, numDifferent, mergedDifferent;
+	unsigned long long			plainCalls, batchedCalls;
+	double						startTime;
+	bool						passed = true;
+
+
+
+	// Create the view
+	theView = CreateOpenGLView(256, 256, theImage);
+	if (theView == nullptr)
+		return true;
+
+
+
+	// Build the scene
+	theScene = Q3DisplayGroup_New();
+	theMesh  = CreateGridTriMesh(2, 2);
+
+	theObject = Q3ScaleTransform_New(&theScale);
+	Q3Group_AddObject(theScene, theObject);
+	Q3Object_Dispose(theObject);
+
+	theObject = Q3AttributeSet_New();
+	Q3AttributeSet_Add(theObject, kQ3AttributeTypeDiffuseColor, &theColor);
+	Q3Group_AddObject(theScene, theObject);
+	Q3Object_Dispose(theObject);
+
+	for (y = 0; y < kGridSize; ++y)
+		{
+		for (x = 0; x < kGridSize; ++x)
+			{
+			Q3Vector3D_Set(&theOffset, ((float) x - kGridSize / 2.0f) * kSpacing,
+									((float) y - kGridSize / 2.0f) * kSpacing, 0.0f);
+			
+			theCell   = Q3DisplayGroup_New();
+			theObject = Q3TranslateTransform_New(&theOffset);
+			Q3Group_AddObject(theCell, theObject);
+			Q3Group_AddObject(theCell, theMesh);
+			Q3Group_AddObject(theScene, theCell);
+			Q3Object_Dispose(theObject);
+			Q3Object_Dispose(theCell);
+			}
+		}
+
+
+
+	// Time frames without and with batching
+	SetRendererFlag(theView, kQ3RendererPropertyBatchSmallTriMeshes, kQ3False);
+	passed = Check(RenderFrame(theView, theScene), "render without batching") && passed;
+
+	startTime = Seconds();
+	for (n = 0; n < kNumFrames; ++n)
+		passed = Check(RenderFrame(theView, theScene), "render without batching") && passed;
+	Report("frame without batching", (Seconds() - startTime) / kNumFrames, 1.0, "frames");
+
+	plainCalls = GetRendererCount(theView, kQ3RendererPropertyDrawCallCount);
+	plainImage = theImage;
+
+	SetRendererFlag(theView, kQ3RendererPropertyBatchSmallTriMeshes, kQ3True);
+	passed = Check(RenderFrame(theView, theScene), "render with batching") && passed;
+
+	startTime = Seconds();
+	for (n = 0; n < kNumFrames; ++n)
+		passed = Check(RenderFrame(theView, theScene), "render with batching") && passed;
+	Report("frame with batching", (Seconds() - startTime) / kNumFrames, 1.0, "frames");
+
+	batchedCalls = GetRendererCount(theView, kQ3RendererPropertyDrawCallCount);
+	numDifferent = CountDifferentPixels(theImage, plainImage, 2);
+	printf("    draw calls per frame: %llu without batching, %llu with\n",
+				plainCalls, batchedCalls);
+
+
+
+	// Merge the meshes into one, and time that
+	Q3TriMesh_LockData(theMesh, kQ3True, &meshData);
+
+	for (y = 0; y < kGridSize; ++y)
+		{
+		for (x = 0; x < kGridSize; ++x)
+			{
+			TQ3Uns32	firstPoint = (TQ3Uns32) mergedPoints.size();
+			
+			Q3Vector3D_Set(&theOffset, ((float) x - kGridSize / 2.0f) * kSpacing,
+									((float) y - kGridSize / 2.0f) * kSpacing, 0.0f);
+			
+			for (n = 0; n < meshData->numPoints; ++n)
+				{
+				TQ3Point3D	thePoint;
+				TQ3Vector3D	theNormal = { 0.0f, 0.0f, 1.0f };
+				
+				Q3Point3D_Vector3D_Add(&meshData->points[n], &theOffset, &thePoint);
+				mergedPoints.push_back(thePoint);
+				mergedNormals.push_back(theNormal);
+				}
+			
+			for (n = 0; n < meshData->numTriangles; ++n)
+				{
+				TQ3TriMeshTriangleData	theTriangle = meshData->triangles[n];
+				
+				for (k = 0; k < 3; ++k)
+					theTriangle.pointIndices[k] += firstPoint;
+				
+				mergedTriangles.push_back(theTriangle);
+				}
+			}
+		}
+
+	Q3TriMesh_UnlockData(theMesh);
+
+	normalAttribute.attributeType     = kQ3AttributeTypeNormal;
+	normalAttribute.data              = &mergedNormals[0];
+	normalAttribute.attributeUseArray = nullptr;
+
+	memset(&mergedData, 0, sizeof(mergedData));
+	mergedData.numTriangles            = (TQ3Uns32) mergedTriangles.size();
+	mergedData.triangles               = &mergedTriangles[0];
+	mergedData.numPoints               = (TQ3Uns32) mergedPoints.size();
+	mergedData.points                  = &mergedPoints[0];
+	mergedData.numVertexAttributeTypes = 1;
+	mergedData.vertexAttributeTypes    = &normalAttribute;
+	Q3BoundingBox_SetFromPoints3D(&mergedData.bBox, &mergedPoints[0], mergedData.numPoints, sizeof(TQ3Point3D));
+
+	mergedScene = Q3DisplayGroup_New();
+
+	theObject = Q3ScaleTransform_New(&theScale);
+	Q3Group_AddObject(mergedScene, theObject);
+	Q3Object_Dispose(theObject);
+
+	theObject = Q3AttributeSet_New();
+	Q3AttributeSet_Add(theObject, kQ3AttributeTypeDiffuseColor, &theColor);
+	Q3Group_AddObject(mergedScene, theObject);
+	Q3Object_Dispose(theObject);
+
+	theObject = Q3TriMesh_New(&mergedData);
+	Q3Group_AddObject(mergedScene, theObject);
+	Q3Object_Dispose(theObject);
+
+	passed = Check(RenderFrame(theView, mergedScene), "render merged mesh") && passed;
+
+	startTime = Seconds();
+	for (n = 0; n < kNumFrames; ++n)
+		passed = Check(RenderFrame(theView, mergedScene), "render merged mesh") && passed;
+	Report("frame with one merged TriMesh", (Seconds() - startTime) / kNumFrames, 1.0, "frames");
+
+	mergedDifferent = CountDifferentPixels(theImage, plainImage, 2);
+
+
+
+	// Check the results
+	printf("    pixels differing: %u of %u batched, %u merged\n", (unsigned int) numDifferent,
+				(unsigned int) theImage.size(), (unsigned int) mergedDifferent);
+
+	passed = Check(plainCalls >= kGridSize * kGridSize, "one draw call per mesh without batching") && passed;
+	passed = Check(batchedCalls * 100 <= plainCalls, "batching merges draw calls") && passed;
+	passed = Check(numDifferent * 100 <= theImage.size(), "batched image matches plain image") && passed;
+	passed = Check(mergedDifferent * 100 <= theImage.size(), "merged image matches plain image") && passed;
+
+
+
+	// Clean up
+	Q3Object_Dispose(theView);
+	Q3Object_Dispose(theScene);
+	Q3Object_Dispose(mergedScene);
+	Q3Object_Dispose(theMesh);
+
+	return passed;
+}
+
+
+
+
+
+//=============================================================================
+//      CreateCheckerShader : Create a texture shader with a checkerboard.
+//-----------------------------------------------------------------------------
+static TQ3ShaderObject
+CreateCheckerShader(TQ3Uns32 colorA, TQ3Uns32 colorB)
+{	const TQ3Uns32				kSize = 16;
+	std::vector<TQ3Uns32>		thePixels(kSize * kSize);
+	TQ3StoragePixmap			thePixmap;
+	TQ3TextureObject			theTexture;
+	TQ3ShaderObject				theShader;
+	TQ3Uns32					x, y;
+
+
+
+	// Fill in the image
+	for (y = 0; y < kSize; ++y)
+		for (x = 0; x < kSize; ++x)
+			thePixels[y * kSize + x] = (((x / 4) + (y / 4)) % 2) ? colorA : colorB;
+
+
+
+	// Create the texture and its shader
+	memset(&thePixmap, 0, sizeof(thePixmap));
+	thePixmap.image     = Q3MemoryStorage_New((const unsigned char*) &thePixels[0], kSize * kSize * 4);
+	thePixmap.width     = kSize;
+	thePixmap.height    = kSize;
+	thePixmap.rowBytes  = kSize * 4;
+	thePixmap.pixelSize = 32;
+	thePixmap.pixelType = kQ3PixelTypeRGB32;
+#if QUESA_HOST_IS_BIG_ENDIAN
+	thePixmap.bitOrder  = kQ3EndianBig;
+	thePixmap.byteOrder = kQ3EndianBig;
+#else
+	thePixmap.bitOrder  = kQ3EndianLittle;
+	thePixmap.byteOrder = kQ3EndianLittle;
+#endif
+
+	theTexture = Q3PixmapTexture_New(&thePixmap);
+	Q3Object_Dispose(thePixmap.image);
+
+	theShader = Q3TextureShader_New(theTexture);
+	Q3Object_Dispose(theTexture);
+
+	return theShader;
+}
+
+
+
+
+
+//=============================================================================
+//      Test_SortTriMeshes : Time drawing interleaved materials, with sorting.
+//-----------------------------------------------------------------------------
+//		Note :	The scene is a grid of TriMeshes large enough to be cached,
+//				each in its own group, which cycles through a few opaque
+//				textures and a few plain colours.  Sorting must cut the
+//				program switches and texture binds, and since the meshes do
+//				not overlap, give the same image.
+//-----------------------------------------------------------------------------
+static bool
+Test_SortTriMeshes(void)
+{	const TQ3Uns32				kGridSize = 40, kNumTextures = 4, kNumColors = 4, kNumFrames = 10;
+	const float					kSpacing = 7.0f;
+	std::vector<TQ3ShaderObject>	theShaders;
+	std::vector<TQ3Object>		theColorSets;
+	std::vector<TQ3Uns32>		theImage, plainImage;
+	TQ3GroupObject				theScene, theCell;
+	TQ3Object					theObject, theMesh;
+	TQ3Vector3D					theScale = { 0.03f, 0.03f, 0.03f };
+	TQ3Vector3D					theOffset;
+	TQ3ViewObject				theView;
+	TQ3Uns32					x, y, n, numDifferent;
+	unsigned long long			plainSwitches, plainBinds, sortedSwitches, sortedBinds;
+	double						startTime;
+	bool						passed = true;
+
+
+
+	// Create the view
+	theView = CreateOpenGLView(256, 256, theImage);
+	if (theView == nullptr)
+		return true;
+
+
+
+	// Create the materials
+	for (n = 0; n < kNumTextures; ++n)
+		theShaders.push_back(CreateCheckerShader(0xFF000000 | (0x3F << (n * 6 % 24)), 0xFFFFFFFF));
+
+	for (n = 0; n < kNumColors; ++n)
+		{
+		TQ3ColorRGB	theColor = { 0.2f + 0.2f * n, 0.8f - 0.2f * n, 0.5f };
+		
+		theObject = Q3AttributeSet_New();
+		Q3AttributeSet_Add(theObject, kQ3AttributeTypeDiffuseColor, &theColor);
+		theColorSets.push_back(theObject);
+		}
+
+
+
+	// Build the scene, alternating textured and plain cells
+	theScene = Q3DisplayGroup_New();
+	theMesh  = CreateGridTriMesh(6, 6);
+
+	theObject = Q3ScaleTransform_New(&theScale);
+	Q3Group_AddObject(theScene, theObject);
+	Q3Object_Dispose(theObject);
+
+	for (y = 0; y < kGridSize; ++y)
+		{
+		for (x = 0; x < kGridSize; ++x)
+			{
+			n = y * kGridSize + x;
+			Q3Vector3D_Set(&theOffset, ((float) x - kGridSize / 2.0f) * kSpacing,
+									((float) y - kGridSize / 2.0f) * kSpacing, 0.0f);
+			
+			theCell   = Q3DisplayGroup_New();
+			theObject = Q3TranslateTransform_New(&theOffset);
+			Q3Group_AddObject(theCell, theObject);
+			Q3Object_Dispose(theObject);
+			
+			if (n % 2)
+				Q3Group_AddObject(theCell, theShaders[(n / 2) % kNumTextures]);
+			else
+				Q3Group_AddObject(theCell, theColorSets[(n / 2) % kNumColors]);
+			
+			Q3Group_AddObject(theCell, theMesh);
+			Q3Group_AddObject(theScene, theCell);
+			Q3Object_Dispose(theCell);
+			}
+		}
+
+
+
+	// Time frames without and with sorting
+	SetRendererFlag(theView, kQ3RendererPropertySortOpaqueTriMeshes, kQ3False);
+	passed = Check(RenderFrame(theView, theScene), "render without sorting") && passed;
+
+	startTime = Seconds();
+	for (n = 0; n < kNumFrames; ++n)
+		passed = Check(RenderFrame(theView, theScene), "render without sorting") && passed;
+	Report("frame without sorting", (Seconds() - startTime) / kNumFrames, 1.0, "frames");
+
+	plainSwitches = GetRendererCount(theView, kQ3RendererPropertyProgramSwitchCount);
+	plainBinds    = GetRendererCount(theView, kQ3RendererPropertyTextureBindCount);
+	plainImage    = theImage;
+
+	SetRendererFlag(theView, kQ3RendererPropertySortOpaqueTriMeshes, kQ3True);
+	passed = Check(RenderFrame(theView, theScene), "render with sorting") && passed;
+
+	startTime = Seconds();
+	for (n = 0; n < kNumFrames; ++n)
+		passed = Check(RenderFrame(theView, theScene), "render with sorting") && passed;
+	Report("frame with sorting", (Seconds() - startTime) / kNumFrames, 1.0, "frames");
+
+	sortedSwitches = GetRendererCount(theView, kQ3RendererPropertyProgramSwitchCount);
+	sortedBinds    = GetRendererCount(theView, kQ3RendererPropertyTextureBindCount);
+	printf("    program switches per frame: %llu without sorting, %llu with\n", plainSwitches, sortedSwitches);
+	printf("    texture binds per frame: %llu without sorting, %llu with\n", plainBinds, sortedBinds);
+
+
+
+	// Check the results
+	numDifferent = CountDifferentPixels(theImage, plainImage, 0);
+	printf("    pixels differing: %u of %u\n", (unsigned int) numDifferent, (unsigned int) theImage.size());
+
+	passed = Check(plainSwitches >= kGridSize * kGridSize - 1, "a program switch per mesh without sorting") && passed;
+	passed = Check(sortedSwitches <= 2 * (kNumTextures + kNumColors), "sorting cuts program switches") && passed;
+	passed = Check(plainBinds >= kGridSize * kGridSize / 2, "a texture bind per textured mesh without sorting") && passed;
+	passed = Check(sortedBinds >= kNumTextures && sortedBinds <= 2 * kNumTextures, "sorting cuts texture binds") && passed;
+	passed = Check(numDifferent == 0, "sorted image matches plain image") && passed;
+
+
+
+	// Clean up
+	Q3Object_Dispose(theView);
+	Q3Object_Dispose(theScene);
+	Q3Object_Dispose(theMesh);
+
+	for (TQ3ShaderObject& theShader : theShaders)
+		Q3Object_CleanDispose(&theShader);
+	for (TQ3Object& theSet : theColorSets)
+		Q3Object_CleanDispose(&theSet);
+
+	return passed;
+}
+
+
+
+
+
+//=============================================================================
+//      CreateTransparentScene : Create a scene of transparent TriMeshes.
+//-----------------------------------------------------------------------------
+//		Note :	The scene is a stack of tilted grids which overlap on screen,
+//				in front of a row of small grids which do not.  Every mesh is
+//				half transparent, so the overlapping grids are merged into
+//				one large block for sorting, and the small grids each make a
+//				block of their own.
+//-----------------------------------------------------------------------------
+static TQ3GroupObject
+CreateTransparentScene(void)
+{	const TQ3Uns32				kNumLayers = 12, kLayerSize = 64, kNumSmall = 24;
+	TQ3ColorRGB					theTransparency = { 0.5f, 0.5f, 0.5f };
+	TQ3ColorRGB					theColor;
+	TQ3RotateTransformData		theRotation;
+	TQ3GroupObject				theScene, theLayer;
+	TQ3Object					theObject, theMesh;
+	TQ3Vector3D					theScale, theOffset;
+	TQ3Uns32					n;
+
+
+
+	// Create the scene, which is transparent throughout
+	theScene  = Q3DisplayGroup_New();
+	theObject = Q3AttributeSet_New();
+	Q3AttributeSet_Add(theObject, kQ3AttributeTypeTransparencyColor, &theTransparency);
+	Q3Group_AddObject(theScene, theObject);
+	Q3Object_Dispose(theObject);
+
+
+
+	// Add the stack of large grids
+	theMesh = CreateGridTriMesh(kLayerSize, kLayerSize);
+	Q3Vector3D_Set(&theScale, 5.0f / kLayerSize, 5.0f / kLayerSize, 1.0f);
+
+	for (n = 0; n < kNumLayers; ++n)
+		{
+		theLayer = Q3DisplayGroup_New();
+		
+		Q3ColorRGB_Set(&theColor, (float) n / kNumLayers, 0.5f, 1.0f - (float) n / kNumLayers);
+		theObject = Q3AttributeSet_New();
+		Q3AttributeSet_Add(theObject, kQ3AttributeTypeDiffuseColor, &theColor);
+		Q3Group_AddObject(theLayer, theObject);
+		Q3Object_Dispose(theObject);
+		
+		Q3Vector3D_Set(&theOffset, -4.0f + 0.4f * n, -2.0f + 0.2f * n, -0.4f * n);
+		theObject = Q3TranslateTransform_New(&theOffset);
+		Q3Group_AddObject(theLayer, theObject);
+		Q3Object_Dispose(theObject);
+		
+		theRotation.axis    = kQ3AxisY;
+		theRotation.radians = 0.05f * ((float) n - kNumLayers / 2.0f);
+		theObject = Q3RotateTransform_New(&theRotation);
+		Q3Group_AddObject(theLayer, theObject);
+		Q3Object_Dispose(theObject);
+		
+		theObject = Q3ScaleTransform_New(&theScale);
+		Q3Group_AddObject(theLayer, theObject);
+		Q3Object_Dispose(theObject);
+		
+		Q3Group_AddObject(theLayer, theMesh);
+		Q3Group_AddObject(theScene, theLayer);
+		Q3Object_Dispose(theLayer);
+		}
+
+	Q3Object_Dispose(theMesh);
+
+
+
+	// Add the row of small grids
+	theMesh = CreateGridTriMesh(3, 3);
+	Q3Vector3D_Set(&theScale, 0.1f, 0.1f, 1.0f);
+
+	for (n = 0; n < kNumSmall; ++n)
+		{
+		theLayer = Q3DisplayGroup_New();
+		
+		Q3Vector3D_Set(&theOffset, -3.6f + 0.3f * n, -2.8f, 1.0f);
+		theObject = Q3TranslateTransform_New(&theOffset);
+		Q3Group_AddObject(theLayer, theObject);
+		Q3Object_Dispose(theObject);
+		
+		theObject = Q3ScaleTransform_New(&theScale);
+		Q3Group_AddObject(theLayer, theObject);
+		Q3Object_Dispose(theObject);
+		
+		Q3Group_AddObject(theLayer, theMesh);
+		Q3Group_AddObject(theScene, theLayer);
+		Q3Object_Dispose(theLayer);
+		}
+
+	Q3Object_Dispose(theMesh);
+
+	return theScene;
+}
+
+
+
+
+
+//=============================================================================
+//      Test_TransparentSort : Time sorting transparent TriMeshes, 1..N threads.
+//-----------------------------------------------------------------------------
+//		Note :	Most of each frame goes into breaking the TriMeshes into
+//				triangles and sorting them back to front, which is split
+//				across the worker threads.  The sort is stable, so the image
+//				must be the same on any number of threads.  The time of the
+//				sort itself is reported by the renderer.
+//-----------------------------------------------------------------------------
+static bool
+Test_TransparentSort(void)
+{	const TQ3Uns32				kThreadCounts[] = { 1, 2, 4, 8 };
+	const TQ3Uns32				kNumFrames = 5;
+	std::vector<TQ3Uns32>		theImage, firstImage;
+	TQ3GroupObject				theScene;
+	TQ3ViewObject				theView;
+	TQ3Uns32					n, numDifferent;
+	unsigned long long			sortMicroseconds;
+	double						startTime, frameTime;
+	char						theLabel[64];
+	bool						passed = true;
+
+
+
+	// Create the view and the scene
+	theView = CreateOpenGLView(256, 256, theImage);
+	if (theView == nullptr)
+		return true;
+
+	theScene = CreateTransparentScene();
+
+
+
+	// Time frames on each thread count
+	for (TQ3Uns32 numThreads : kThreadCounts)
+		{
+		Q3SetThreadCount(numThreads);
+		passed = Check(RenderFrame(theView, theScene), "render transparent scene") && passed;
+		
+		sortMicroseconds = 0;
+		startTime = Seconds();
+		for (n = 0; n < kNumFrames; ++n)
+			{
+			passed = Check(RenderFrame(theView, theScene), "render transparent scene") && passed;
+			sortMicroseconds += GetRendererCount(theView, kQ3RendererPropertyTransparencySortTime);
+			}
+		
+		frameTime = (Seconds() - startTime) / kNumFrames;
+		snprintf(theLabel, sizeof(theLabel), "frame on %u threads", (unsigned int) numThreads);
+		Report(theLabel, frameTime, 1.0, "frames");
+		snprintf(theLabel, sizeof(theLabel), "sort on %u threads", (unsigned int) numThreads);
+		Report(theLabel, sortMicroseconds * 1.0e-6 / kNumFrames, 1.0, "sorts");
+		
+		passed = Check(sortMicroseconds > 0, "renderer reported the sort time") && passed;
+		passed = Check(sortMicroseconds * 1.0e-6 / kNumFrames <= frameTime, "sort time within the frame") && passed;
+		
+		if (firstImage.empty())
+			firstImage = theImage;
+		else
+			{
+			numDifferent = CountDifferentPixels(theImage, firstImage, 0);
+			passed = Check(numDifferent == 0, "image matches the image on 1 thread") && passed;
+			}
+		}
+
+	Q3SetThreadCount(0);
+
+
+
+	// Check that the transparent layers were drawn
+	numDifferent = 0;
+	for (n = 1; n < firstImage.size(); ++n)
+		numDifferent += (firstImage[n] != firstImage[0]);
+
+	passed = Check(numDifferent * 4 >= firstImage.size(), "transparent scene was drawn") && passed;
+
+
+
+	// Clean up
+	Q3Object_Dispose(theView);
+	Q3Object_Dispose(theScene);
+
+	return passed;
+}
+
+
+
+
+
+//=============================================================================
+//      Test_WeightedTransparency : Compare sorted and weighted transparency.
+//-----------------------------------------------------------------------------
+//		Note :	Each mode gets a view of its own, so that the heap measured
+//				includes the buffers the renderer keeps between frames.
+//				The offscreen buffers of weighted transparency live in video
+//				memory, and are not counted.  Weighted transparency is an
+//				approximation, so its image is expected to differ a little;
+//				if it is identical, the renderer fell back to sorting.
+//-----------------------------------------------------------------------------
+static bool
+Test_WeightedTransparency(void)
+{	const TQ3Boolean			kModes[] = { kQ3False, kQ3True };
+	const char*					kModeNames[] = { "sorted", "weighted" };
+	const TQ3Uns32				kNumFrames = 5;
+	std::vector<TQ3Uns32>		theImage, sortedImage;
+	long long					heapBytes[2] = { 0, 0 };
+	TQ3GroupObject				theScene;
+	TQ3ViewObject				theView;
+	TQ3Uns32					m, n, numDifferent;
+	long long					startBytes;
+	double						startTime;
+	char						theLabel[64];
+	bool						passed = true;
+
+
+
+	// Time frames in each mode
+	theScene = CreateTransparentScene();
+
+	for (m = 0; m < 2; ++m)
+		{
+		theView = CreateOpenGLView(256, 256, theImage);
+		if (theView == nullptr)
+			{
+			Q3Object_Dispose(theScene);
+			return true;
+			}
+		
+		SetRendererFlag(theView, kQ3RendererPropertyOrderIndependentTransparency, kModes[m]);
+		startBytes = ResetHeapPeak();
+		passed = Check(RenderFrame(theView, theScene), "render transparent scene") && passed;
+		
+		startTime = Seconds();
+		for (n = 0; n < kNumFrames; ++n)
+			passed = Check(RenderFrame(theView, theScene), "render transparent scene") && passed;
+		
+		snprintf(theLabel, sizeof(theLabel), "frame with %s transparency", kModeNames[m]);
+		Report(theLabel, (Seconds() - startTime) / kNumFrames, 1.0, "frames");
+		
+		heapBytes[m] = gHeapPeak.load() - startBytes;
+		if (m == 0)
+			sortedImage = theImage;
+		
+		Q3Object_Dispose(theView);
+		}
+
+	printf("    heap high-water mark: %.1f KB sorted, %.1f KB weighted\n",
+				heapBytes[0] / 1024.0, heapBytes[1] / 1024.0);
+
+
+
+	// Check the results
+	numDifferent = CountDifferentPixels(theImage, sortedImage, 0);
+	printf("    pixels differing: %u of %u\n", (unsigned int) numDifferent, (unsigned int) theImage.size());
+
+	if (numDifferent == 0)
+		printf("    weighted transparency is not available, sorted instead\n");
+	else
+		passed = Check(heapBytes[1] * 4 < heapBytes[0], "weighted transparency uses less heap") && passed;
+
+
+
+	// Clean up
+	Q3Object_Dispose(theScene);
+
+	return passed;
+}
+
+
+
+
+
+//=============================================================================
+//      CreateSoftwareScene : Create one of the software renderer test scenes.
+//-----------------------------------------------------------------------------
+//		Note :	Scene 0 is a Phong shaded sphere, scene 1 a textured grid
+//				seen at an angle, and scene 2 the transparent scene.  Between
+//				them they cover lighting, perspective correct texturing and
+//				blending.  Returns nullptr past the last scene.
+//-----------------------------------------------------------------------------
+static TQ3GroupObject
+CreateSoftwareScene(TQ3Uns32 sceneIndex)
+{	TQ3ColorRGB					theDiffuse  = { 0.8f, 0.3f, 0.2f };
+	TQ3ColorRGB					theSpecular = { 1.0f, 1.0f, 1.0f };
+	float						theControl  = 20.0f;
+	TQ3RotateTransformData		theRotation;
+	TQ3EllipsoidData			sphereData;
+	TQ3GroupObject				theScene;
+	TQ3Object					theObject;
+	TQ3Vector3D					theOffset;
+
+
+
+	switch (sceneIndex)
+		{
+		case 0:
+			theScene  = Q3DisplayGroup_New();
+			theObject = Q3PhongIllumination_New();
+			Q3Group_AddObject(theScene, theObject);
+			Q3Object_Dispose(theObject);
+			
+			theObject = Q3AttributeSet_New();
+			Q3AttributeSet_Add(theObject, kQ3AttributeTypeDiffuseColor,   &theDiffuse);
+			Q3AttributeSet_Add(theObject, kQ3AttributeTypeSpecularColor,  &theSpecular);
+			Q3AttributeSet_Add(theObject, kQ3AttributeTypeSpecularControl, &theControl);
+			Q3Group_AddObject(theScene, theObject);
+			Q3Object_Dispose(theObject);
+			
+			memset(&sphereData, 0, sizeof(sphereData));
+			Q3Vector3D_Set(&sphereData.orientation, 0.0f, 2.5f, 0.0f);
+			Q3Vector3D_Set(&sphereData.majorRadius, 0.0f, 0.0f, 2.5f);
+			Q3Vector3D_Set(&sphereData.minorRadius, 2.5f, 0.0f, 0.0f);
+			sphereData.uMax = sphereData.vMax = 1.0f;
+			
+			theObject = Q3Ellipsoid_New(&sphereData);
+			Q3Group_AddObject(theScene, theObject);
+			Q3Object_Dispose(theObject);
+			break;
+		
+		case 1:
+			theScene  = Q3DisplayGroup_New();
+			theObject = Q3LambertIllumination_New();
+			Q3Group_AddObject(theScene, theObject);
+			Q3Object_Dispose(theObject);
+			
+			theObject = CreateCheckerShader(0xFFE0E0E0, 0xFF2040C0);
+			Q3Group_AddObject(theScene, theObject);
+			Q3Object_Dispose(theObject);
+			
+			theRotation.axis    = kQ3AxisX;
+			theRotation.radians = -0.9f;
+			theObject = Q3RotateTransform_New(&theRotation);
+			Q3Group_AddObject(theScene, theObject);
+			Q3Object_Dispose(theObject);
+			
+			Q3Vector3D_Set(&theOffset, -4.0f, -4.0f, 0.0f);
+			theObject = Q3TranslateTransform_New(&theOffset);
+			Q3Group_AddObject(theScene, theObject);
+			Q3Object_Dispose(theObject);
+			
+			theObject = CreateGridTriMesh(8, 8);
+			Q3Group_AddObject(theScene, theObject);
+			Q3Object_Dispose(theObject);
+			break;
+		
+		case 2:
+			theScene = CreateTransparentScene();
+			break;
+		
+		default:
+			theScene = nullptr;
+			break;
+		}
+
+	return theScene;
+}
+
+
+
+
+
+//=============================================================================
+//      Test_SoftwareGolden : Compare software renderer images with references.
+//-----------------------------------------------------------------------------
+//		Note :	The reference images are kept in SDK/Models/Test/Images.  If
+//				one is missing, the rendered image is written in its place,
+//				so that new references can be made by deleting the old ones.
+//				Rounding may differ between compilers, so a few pixels are
+//				allowed to differ by a few levels.
+//-----------------------------------------------------------------------------
+static bool
+Test_SoftwareGolden(void)
+{	const char*					kImageNames[] = { "Software_Lit", "Software_Textured", "Software_Transparent" };
+	const TQ3Uns32				kSize = 96, kTolerance = 2;
+	std::vector<TQ3Uns32>		theImage, goldenImage;
+	TQ3GroupObject				theScene;
+	TQ3ViewObject				theView;
+	TQ3Uns32					n, numDifferent;
+	char						thePath[256];
+	bool						passed = true;
+
+
+
+	// Create the view
+	theView = CreateView(kQ3RendererTypeSoftware, kSize, kSize, theImage);
+	if (!Check(theView != nullptr, "create view"))
+		return false;
+
+
+
+	// Render each scene and compare it with its reference
+	for (n = 0; (theScene = CreateSoftwareScene(n)) != nullptr; ++n)
+		{
+		passed = Check(RenderFrame(theView, theScene), "render scene") && passed;
+		Q3Object_Dispose(theScene);
+		
+		for (TQ3Uns32& theColor : theImage)
+			theColor |= 0xFF000000;
+		
+		snprintf(thePath, sizeof(thePath), "%s%s.ppm", kGoldenImageDir, kImageNames[n]);
+		if (FileSize(thePath) == 0)
+			{
+			passed = Check(WritePPM(thePath, kSize, kSize, theImage), "write reference image") && passed;
+			printf("    %-40s created\n", kImageNames[n]);
+			continue;
+			}
+		
+		if (!Check(ReadPPM(thePath, kSize, kSize, goldenImage), "read reference image"))
+			{
+			passed = false;
+			continue;
+			}
+		
+		numDifferent = CountDifferentPixels(theImage, goldenImage, kTolerance);
+		printf("    %-40s %u pixels differ\n", kImageNames[n], (unsigned int) numDifferent);
+		passed = Check(numDifferent * 100 <= theImage.size(), "image matches the reference") && passed;
+		}
+
+
+
+	// Clean up
+	Q3Object_Dispose(theView);
+
+	return passed;
+}
+
+
+
+
+
+//=============================================================================
+//      Test_SoftwareFrameRate : Time the software renderer on 1..N threads.
+//-----------------------------------------------------------------------------
+//		Note :	Each test scene is drawn at a typical window size.  The
+//				triangles are rasterized in tiles, one thread to a tile, so
+//				the image must be the same on any number of threads.
+//-----------------------------------------------------------------------------
+static bool
+Test_SoftwareFrameRate(void)
+{	const TQ3Uns32				kThreadCounts[] = { 1, 2, 4, 8 };
+	const TQ3Uns32				kNumFrames = 5;
+	std::vector<TQ3Uns32>		theImage, firstImage;
+	TQ3GroupObject				theScene;
+	TQ3ViewObject				theView;
+	TQ3Uns32					n, m, numDifferent;
+	double						startTime;
+	char						theLabel[64];
+	bool						passed = true;
+
+
+
+	// Create the view
+	theView = CreateView(kQ3RendererTypeSoftware, 512, 512, theImage);
+	if (!Check(theView != nullptr, "create view"))
+		return false;
+
+
+
+	// Time frames of each scene on each thread count
+	for (n = 0; (theScene = CreateSoftwareScene(n)) != nullptr; ++n)
+		{
+		firstImage.clear();
+		
+		for (TQ3Uns32 numThreads : kThreadCounts)
+			{
+			Q3SetThreadCount(numThreads);
+			passed = Check(RenderFrame(theView, theScene), "render scene") && passed;
+			
+			startTime = Seconds();
+			for (m = 0; m < kNumFrames; ++m)
+				passed = Check(RenderFrame(theView, theScene), "render scene") && passed;
+			
+			snprintf(theLabel, sizeof(theLabel), "scene %u frame on %u threads",
+						(unsigned int) n, (unsigned int) numThreads);
+			Report(theLabel, (Seconds() - startTime) / kNumFrames, 1.0, "frames");
+			
+			if (firstImage.empty())
+				firstImage = theImage;
+			else
+				{
+				numDifferent = CountDifferentPixels(theImage, firstImage, 0);
+				passed = Check(numDifferent == 0, "image matches the image on 1 thread") && passed;
+				}
+			}
+		
+		Q3Object_Dispose(theScene);
+		}
+
+	Q3SetThreadCount(0);
+
+
+
+	// Clean up
+	Q3Object_Dispose(theView);
+
+	return passed;
+}
+
+
+
+
+
+//=============================================================================
+//      Test_HeadlessThumbnails : Time rendering thumbnails with OpenGL.
+//-----------------------------------------------------------------------------
+//		Note :	A thumbnail server renders many small images, one scene
+//				each.  With a new view for each thumbnail, every image pays
+//				for setting up an FBO on the shared headless context; with
+//				one view, only the frames are paid for, and asynchronous
+//				readback lets the next frame start before the last has been
+//				copied out.  Each way must give the same images.
+//-----------------------------------------------------------------------------
+static bool
+Test_HeadlessThumbnails(void)
+{	const char*					kModeNames[] = { "new view each", "one view", "one view, async readback" };
+	const TQ3Uns32				kSize = 128, kNumThumbnails = 60, kNumScenes = 3, kFramesInFlight = 4;
+	std::vector<TQ3Uns32>		theImage, lastImages[kNumScenes];
+	TQ3GroupObject				theScenes[kNumScenes];
+	TQ3DrawContextObject		theDrawContext;
+	TQ3ViewObject				theView;
+	TQ3Uns32					m, n, numDifferent;
+	double						startTime;
+	bool						passed = true;
+
+
+
+	// Check that OpenGL is available, and create the scenes
+	theView = CreateOpenGLView(kSize, kSize, theImage);
+	if (theView == nullptr)
+		return true;
+
+	for (n = 0; n < kNumScenes; ++n)
+		theScenes[n] = CreateSoftwareScene(n);
+
+
+
+	// Time the thumbnails in each mode
+	for (m = 0; m < 3; ++m)
+		{
+		if (m == 2)
+			{
+			theDrawContext = nullptr;
+			Q3View_GetDrawContext(theView, &theDrawContext);
+			Q3Object_SetProperty(theDrawContext, kQ3DrawContextPropertyGLAsyncReadback,
+									sizeof(kFramesInFlight), &kFramesInFlight);
+			Q3Object_Dispose(theDrawContext);
+			}
+		
+		startTime = Seconds();
+		for (n = 0; n < kNumThumbnails; ++n)
+			{
+			if (m == 0)
+				{
+				Q3Object_Dispose(theView);
+				theView = CreateView(kQ3RendererTypeOpenGL, kSize, kSize, theImage);
+				}
+			
+			passed = Check(RenderFrame(theView, theScenes[n % kNumScenes]), "render thumbnail") && passed;
+			}
+		
+		Q3View_Sync(theView);
+		Report(kModeNames[m], Seconds() - startTime, kNumThumbnails, "thumbnails");
+		
+		// Render each scene once more, and compare the images
+		for (n = 0; n < kNumScenes; ++n)
+			{
+			passed = Check(RenderFrame(theView, theScenes[n]), "render thumbnail") && passed;
+			Q3View_Sync(theView);
+			
+			if (m == 0)
+				lastImages[n] = theImage;
+			else
+				{
+				numDifferent = CountDifferentPixels(theImage, lastImages[n], 0);
+				passed = Check(numDifferent == 0, "thumbnail matches the one from a new view") && passed;
+				}
+			}
+		}
+
+
+
+	// Clean up
+	Q3Object_Dispose(theView);
+
+	for (n = 0; n < kNumScenes; ++n)
+		Q3Object_Dispose(theScenes[n]);
+
+	return passed;
+}
+
+
+
+
+
+//=============================================================================
+//      ClassLookupMetaHandler : Metahandler for the ClassLookup classes.
+//-----------------------------------------------------------------------------
+static TQ3XFunctionPointer
+ClassLookupMetaHandler(TQ3XMethodType /*methodType*/)
+{
+	return nullptr;
+}
+
+
+
+
+
+//=============================================================================
+//      Test_ClassLookup : Time class lookups, and look up during registration.
+//-----------------------------------------------------------------------------
+//		Note :	Class lookups don't lock, so the rate should grow with the
+//				number of threads.  Lookups by name search every class, and
+//				are much slower than lookups by type.
+//
+//				The stress test looks up classes and creates objects on
+//				several threads, while another thread registers and
+//				unregisters enough classes to make the class index grow.  It
+//				is most useful in a build with ThreadSanitizer.
+//
+//				The shared object test takes and releases references to one
+//				object on 1..N threads, then has several threads duplicate a
+//				shared group, reference it, and edit and dispose their copies
+//				while holding weak references to them.  The last reference to
+//				one more copy is released on whichever thread finishes last,
+//				and its weak reference must be zeroed all the same.
+//-----------------------------------------------------------------------------
+static bool
+Test_ClassLookup(void)
+{	const TQ3Uns32				kThreadCounts[] = { 1, 2, 4, 8 };
+	const TQ3Uns32				kNumTypeLookups = 4000000, kNumNameLookups = 20000;
+	const TQ3Uns32				kNumRounds = 4, kNumChurnClasses = 1500, kNumReaders = 4;
+	const TQ3Uns32				kNumReferences = 4000000, kNumDuplicates = 20000;
+	TQ3PointData				thePoint = { { 0.0f, 0.0f, 0.0f }, nullptr };
+	TQ3Object					sharedGroup, sharedPoint, handOffGroup, handOffReference, theObject;
+	TQ3Uns32					groupEditIndex;
+	std::vector<TQ3XObjectClass>	churnClasses;
+	std::vector<std::thread>	theThreads;
+	std::atomic<TQ3Uns32>		numErrors( 0 );
+	std::atomic<bool>			isDone( false );
+	TQ3XObjectClass				stableClass;
+	TQ3ObjectType				stableType, theType;
+	TQ3Uns32					n;
+	double						startTime;
+	char						theLabel[64];
+	bool						passed = true;
+
+
+
+	// Register a class which is never unregistered
+	stableClass = Q3XObjectHierarchy_RegisterClass(kQ3ObjectTypeShared, &stableType,
+						"PerfTest:ClassLookup", ClassLookupMetaHandler, nullptr, 0, 0);
+	if (!Check(stableClass != nullptr, "register class"))
+		return false;
+
+
+
+	// Time lookups on each thread count
+	for (TQ3Uns32 numThreads : kThreadCounts)
+		{
+		startTime = Seconds();
+		for (n = 0; n < numThreads; ++n)
+			theThreads.push_back(std::thread([&]()
+				{
+				for (TQ3Uns32 i = 0; i < kNumTypeLookups / numThreads; ++i)
+					if (Q3ObjectHierarchy_IsTypeRegistered(kQ3GeometryTypeTriMesh) != kQ3True)
+						numErrors++;
+				}));
+		for (std::thread& theThread : theThreads)
+			theThread.join();
+		theThreads.clear();
+		
+		snprintf(theLabel, sizeof(theLabel), "type lookups on %u threads", (unsigned int) numThreads);
+		Report(theLabel, Seconds() - startTime, kNumTypeLookups / 1.0e6, "M lookups");
+		}
+
+	for (TQ3Uns32 numThreads : kThreadCounts)
+		{
+		startTime = Seconds();
+		for (n = 0; n < numThreads; ++n)
+			theThreads.push_back(std::thread([&]()
+				{
+				TQ3ObjectType	foundType;
+				
+				for (TQ3Uns32 i = 0; i < kNumNameLookups / numThreads; ++i)
+					if (Q3ObjectHierarchy_GetTypeFromString("PerfTest:ClassLookup", &foundType) != kQ3Success ||
+						foundType != stableType)
+						numErrors++;
+				}));
+		for (std::thread& theThread : theThreads)
+			theThread.join();
+		theThreads.clear();
+		
+		snprintf(theLabel, sizeof(theLabel), "name lookups on %u threads", (unsigned int) numThreads);
+		Report(theLabel, Seconds() - startTime, kNumNameLookups / 1.0e3, "k lookups");
+		}
+
+	passed = Check(numErrors == 0, "lookups find the class") && passed;
+
+
+
+	// Look up classes and create objects while classes come and go
+	numErrors = 0;
+	for (n = 0; n < kNumReaders; ++n)
+		theThreads.push_back(std::thread([&]()
+			{
+			TQ3ObjectType	foundType;
+			TQ3PointData	thePoint = { { 0.0f, 0.0f, 0.0f }, nullptr };
+			TQ3Object		theObject;
+			
+			while (!isDone)
+				{
+				if (Q3ObjectHierarchy_IsTypeRegistered(kQ3GeometryTypeTriMesh) != kQ3True)
+					numErrors++;
+				
+				if (Q3ObjectHierarchy_GetTypeFromString("PerfTest:ClassLookup", &foundType) != kQ3Success ||
+					foundType != stableType)
+					numErrors++;
+				
+				theObject = Q3Point_New(&thePoint);
+				if (theObject == nullptr || Q3Object_GetLeafType(theObject) != kQ3GeometryTypePoint)
+					numErrors++;
+				if (theObject != nullptr)
+					Q3Object_Dispose(theObject);
+				}
+			}));
+
+	startTime = Seconds();
+	for (TQ3Uns32 theRound = 0; theRound < kNumRounds && passed; ++theRound)
+		{
+		for (n = 0; n < kNumChurnClasses; ++n)
+			{
+			snprintf(theLabel, sizeof(theLabel), "PerfTest:Churn%u", (unsigned int) n);
+			churnClasses.push_back(Q3XObjectHierarchy_RegisterClass(kQ3ObjectTypeShared, &theType,
+						theLabel, ClassLookupMetaHandler, nullptr, 0, 0));
+			passed = Check(churnClasses.back() != nullptr, "register class while looking up") && passed;
+			}
+		
+		for (TQ3XObjectClass theClass : churnClasses)
+			if (theClass != nullptr)
+				passed = Check(Q3XObjectHierarchy_UnregisterClass(theClass) == kQ3Success,
+								"unregister class while looking up") && passed;
+		churnClasses.clear();
+		}
+
+	isDone = true;
+	for (std::thread& theThread : theThreads)
+		theThread.join();
+	theThreads.clear();
+
+	Report("register and unregister while looking up", Seconds() - startTime,
+			kNumRounds * kNumChurnClasses, "classes");
+	passed = Check(numErrors == 0, "lookups and new objects succeed during registration") && passed;
+
+
+
+	// Take and release references to one object on each thread count
+	sharedGroup = Q3DisplayGroup_New();
+	sharedPoint = Q3Point_New(&thePoint);
+	if (!Check(sharedGroup != nullptr && sharedPoint != nullptr, "create shared objects"))
+		{
+		Q3Object_CleanDispose(&sharedGroup);
+		Q3Object_CleanDispose(&sharedPoint);
+		Q3XObjectHierarchy_UnregisterClass(stableClass);
+		return false;
+		}
+
+	for (n = 0; n < 16; ++n)
+		{
+		thePoint.point.x = (float) n;
+		theObject = Q3Point_New(&thePoint);
+		Q3Group_AddObject(sharedGroup, theObject);
+		Q3Object_Dispose(theObject);
+		}
+	groupEditIndex = Q3Shared_GetEditIndex(sharedGroup);
+
+	for (TQ3Uns32 numThreads : kThreadCounts)
+		{
+		startTime = Seconds();
+		for (n = 0; n < numThreads; ++n)
+			theThreads.push_back(std::thread([&]()
+				{
+				for (TQ3Uns32 i = 0; i < kNumReferences / numThreads; ++i)
+					Q3Object_Dispose(Q3Shared_GetReference(sharedPoint));
+				}));
+		for (std::thread& theThread : theThreads)
+			theThread.join();
+		theThreads.clear();
+		
+		snprintf(theLabel, sizeof(theLabel), "reference and dispose on %u threads", (unsigned int) numThreads);
+		Report(theLabel, Seconds() - startTime, kNumReferences / 1.0e6, "M pairs");
+		}
+
+	passed = Check(Q3Shared_GetReferenceCount(sharedPoint) == 1, "references are balanced") && passed;
+
+
+
+	// Duplicate, edit and dispose shared objects on several threads
+	numErrors = 0;
+	handOffGroup = handOffReference = Q3Object_Duplicate(sharedGroup);
+	if (!Check(handOffGroup != nullptr, "duplicate group to hand off"))
+		{
+		Q3Object_Dispose(sharedGroup);
+		Q3Object_Dispose(sharedPoint);
+		Q3XObjectHierarchy_UnregisterClass(stableClass);
+		return false;
+		}
+
+	Q3Object_GetWeakReference(&handOffGroup);
+	for (n = 1; n < kNumReaders; ++n)
+		Q3Shared_GetReference(handOffReference);
+
+	startTime = Seconds();
+	for (n = 0; n < kNumReaders; ++n)
+		theThreads.push_back(std::thread([&]()
+			{
+			TQ3Object		theDuplicate, weakDuplicate, theReference;
+			TQ3Uns32		oldIndex;
+			
+			for (TQ3Uns32 i = 0; i < kNumDuplicates / kNumReaders; ++i)
+				{
+				theDuplicate = Q3Object_Duplicate(sharedGroup);
+				if (theDuplicate == nullptr || Q3Shared_GetReferenceCount(theDuplicate) != 1)
+					{
+					numErrors++;
+					Q3Object_CleanDispose(&theDuplicate);
+					continue;
+					}
+				
+				theReference = Q3Shared_GetReference(sharedGroup);
+				if (theReference != sharedGroup || Q3Shared_GetEditIndex(sharedGroup) != groupEditIndex)
+					numErrors++;
+				
+				Q3Group_AddObject(theDuplicate, sharedPoint);
+				
+				weakDuplicate = theDuplicate;
+				Q3Object_GetWeakReference(&weakDuplicate);
+				
+				oldIndex = Q3Shared_GetEditIndex(theDuplicate);
+				Q3Shared_Edited(theDuplicate);
+				if (Q3Shared_GetEditIndex(theDuplicate) == oldIndex)
+					numErrors++;
+				
+				Q3Object_Dispose(theDuplicate);
+				Q3Object_Dispose(theReference);
+				if (weakDuplicate != nullptr)
+					numErrors++;
+				}
+			
+			Q3Object_Dispose(handOffReference);
+			}));
+	for (std::thread& theThread : theThreads)
+		theThread.join();
+	theThreads.clear();
+
+	Report("duplicate, edit and dispose on threads", Seconds() - startTime,
+			kNumDuplicates / 1.0e3, "k groups");
+	passed = Check(numErrors == 0, "shared objects survive duplication on threads") && passed;
+	passed = Check(handOffGroup == nullptr, "weak reference zeroed on another thread") && passed;
+	passed = Check(Q3Shared_GetReferenceCount(sharedGroup) == 1 &&
+					Q3Shared_GetReferenceCount(sharedPoint) == 1, "shared references are balanced") && passed;
+	passed = Check(Q3Shared_GetEditIndex(sharedGroup) == groupEditIndex, "shared group is unedited") && passed;
+
+	Q3Object_Dispose(sharedGroup);
+	Q3Object_Dispose(sharedPoint);
+
+
+
+	// Clean up
+	passed = Check(Q3XObjectHierarchy_UnregisterClass(stableClass) == kQ3Success, "unregister class") && passed;
+
+	return passed;
+}
+
+
+
+
+
+//=============================================================================
+//      Test_RayShadeThreads : Time ray tracing on 1..N threads.
+//-----------------------------------------------------------------------------
+//		Note :	The RayShade renderer is a plug-in, so the test is skipped
+//				unless it has been registered; the Unix build links it into
+//				the test.  The scene is a floor under a row of tiles, lit by
+//				a light which casts shadows, so that the shadow caches and
+//				the supersampling of the shadow edges are both exercised.
+//				The image must be the same on any number of threads.  The
+//				plug-in reports the number of rays it spawned, from its
+//				statistics counters.
+//-----------------------------------------------------------------------------
+static bool
+Test_RayShadeThreads(void)
+{	const TQ3Uns32				kThreadCounts[] = { 1, 2, 4, 8 };
+	const TQ3ObjectType			kRayCountProperty = Q3_OBJECT_TYPE('r', 's', 'r', 'c');
+	unsigned long long			numRays, firstNumRays = 0;
+	std::vector<TQ3Uns32>		theImage, firstImage;
+	TQ3DirectionalLightData		lightData;
+	TQ3ObjectType				rendererType;
+	TQ3GroupObject				theScene, theTile, theLights;
+	TQ3Object					theObject, theMesh;
+	TQ3ColorRGB					theColor;
+	TQ3Vector3D					theScale, theOffset;
+	TQ3ViewObject				theView;
+	TQ3Uns32					n, numDifferent;
+	double						startTime, frameTime;
+	char						theLabel[64];
+	bool						passed = true;
+
+
+
+	// Create the view, with a light which casts shadows
+	if (Q3ObjectHierarchy_GetTypeFromString("RayShadeRenderer", &rendererType) != kQ3Success)
+		{
+		printf("    the RayShade renderer is not registered, skipped\n");
+		return true;
+		}
+
+	theView = CreateView(rendererType, 128, 128, theImage);
+	if (!Check(theView != nullptr, "create RayShade view"))
+		return false;
+
+	memset(&lightData, 0, sizeof(lightData));
+	lightData.lightData.isOn       = kQ3True;
+	lightData.lightData.brightness = 1.0f;
+	Q3ColorRGB_Set(&lightData.lightData.color, 1.0f, 1.0f, 1.0f);
+	lightData.castsShadows         = kQ3True;
+	Q3Vector3D_Set(&lightData.direction, -0.5f, -0.5f, -1.0f);
+	Q3Vector3D_Normalize(&lightData.direction, &lightData.direction);
+
+	theLights = Q3LightGroup_New();
+	theObject = Q3DirectionalLight_New(&lightData);
+	Q3Group_AddObject(theLights, theObject);
+	Q3Object_Dispose(theObject);
+	Q3View_SetLightGroup(theView, theLights);
+	Q3Object_Dispose(theLights);
+
+
+
+	// Create the scene
+	theScene = Q3DisplayGroup_New();
+	theMesh  = CreateGridTriMesh(4, 4);
+
+	Q3Vector3D_Set(&theOffset, -4.0f, -4.0f, -2.0f);
+	theObject = Q3TranslateTransform_New(&theOffset);
+	Q3Group_AddObject(theScene, theObject);
+	Q3Object_Dispose(theObject);
+
+	Q3Vector3D_Set(&theScale, 2.0f, 2.0f, 1.0f);
+	theObject = Q3ScaleTransform_New(&theScale);
+	Q3Group_AddObject(theScene, theObject);
+	Q3Object_Dispose(theObject);
+
+	Q3Group_AddObject(theScene, theMesh);
+	Q3Object_Dispose(theMesh);
+
+	theMesh = CreateGridTriMesh(1, 1);
+	for (n = 0; n < 4; ++n)
+		{
+		theTile = Q3DisplayGroup_New();
+		
+		Q3ColorRGB_Set(&theColor, 1.0f - 0.25f * n, 0.5f, 0.25f * n);
+		theObject = Q3AttributeSet_New();
+		Q3AttributeSet_Add(theObject, kQ3AttributeTypeDiffuseColor, &theColor);
+		Q3Group_AddObject(theTile, theObject);
+		Q3Object_Dispose(theObject);
+		
+		Q3Vector3D_Set(&theOffset, 0.5f + 1.75f * n, 2.5f + 0.5f * n, 2.0f);
+		theObject = Q3TranslateTransform_New(&theOffset);
+		Q3Group_AddObject(theTile, theObject);
+		Q3Object_Dispose(theObject);
+		
+		Q3Group_AddObject(theTile, theMesh);
+		Q3Group_AddObject(theScene, theTile);
+		Q3Object_Dispose(theTile);
+		}
+
+	Q3Object_Dispose(theMesh);
+
+
+
+	// Trace the scene on each thread count
+	for (TQ3Uns32 numThreads : kThreadCounts)
+		{
+		Q3SetThreadCount(numThreads);
+		
+		startTime = Seconds();
+		passed = Check(RenderFrame(theView, theScene), "ray trace scene") && passed;
+		frameTime = Seconds() - startTime;
+		numRays   = GetRendererCount(theView, kRayCountProperty);
+		
+		snprintf(theLabel, sizeof(theLabel), "frame on %u threads", (unsigned int) numThreads);
+		Report(theLabel, frameTime, (double) numRays, "rays");
+		
+		if (firstImage.empty())
+			{
+			firstImage   = theImage;
+			firstNumRays = numRays;
+			printf("    rays per frame: %llu\n", numRays);
+			passed = Check(numRays > 0, "renderer reported the rays traced") && passed;
+			}
+		else
+			{
+			numDifferent = CountDifferentPixels(theImage, firstImage, 0);
+			passed = Check(numDifferent == 0, "image matches the image on 1 thread") && passed;
+			passed = Check(numRays == firstNumRays, "same rays as on 1 thread") && passed;
+			}
+		}
+
+	Q3SetThreadCount(0);
+
+
+
+	// Clean up
+	Q3Object_Dispose(theView);
+	Q3Object_Dispose(theScene);
+
+	return passed;
+}
+
+
+
+
+
+//=============================================================================
+//      Test_RayShadeAccelerators : Compare RayShade's grid and hierarchy.
+//-----------------------------------------------------------------------------
+//		Note :	The scene is a cluster of small tiles standing on a floor
+//				far larger than the view, the case in which the old fixed
+//				25x25x25 grid puts most of the objects in a few voxels.  The
+//				same scene is traced through the grid and through the
+//				bounding volume hierarchy, which must find the same hits and
+//				so produce the same image and spawn the same rays.  Each
+//				tile is a TriMesh, which the two structures test in a
+//				different order, so the image also checks that a mesh finds
+//				its recorded hit triangle however the hits interleave.  The
+//				plug-in reports the time to build each structure and the
+//				bytes it holds.
+//-----------------------------------------------------------------------------
+static bool
+Test_RayShadeAccelerators(void)
+{	const TQ3ObjectType			kAcceleratorProperty = Q3_OBJECT_TYPE('r', 's', 'a', 'c');
+	const TQ3ObjectType			kRayCountProperty    = Q3_OBJECT_TYPE('r', 's', 'r', 'c');
+	const TQ3ObjectType			kBuildTimeProperty   = Q3_OBJECT_TYPE('r', 's', 'b', 't');
+	const TQ3ObjectType			kBuildBytesProperty  = Q3_OBJECT_TYPE('r', 's', 'b', 'b');
+	const TQ3Uns32				kClusterSize = 16;
+	const char*					kNames[]     = { "BVH", "grid" };
+	unsigned long long			numRays[2], buildTime[2], buildBytes[2];
+	std::vector<TQ3Uns32>		theImage, images[2];
+	TQ3DirectionalLightData		lightData;
+	TQ3ObjectType				rendererType;
+	TQ3GroupObject				theScene, theTile, theLights;
+	TQ3Object					theObject, theMesh;
+	TQ3RendererObject			theRenderer;
+	TQ3Vector3D					theScale, theOffset;
+	TQ3ViewObject				theView;
+	TQ3Uns32					x, y, z, n, numDifferent;
+	double						startTime, traceTime;
+	char						theLabel[64];
+	bool						passed = true;
+
+
+
+	// Create the view, with a light which casts shadows
+	if (Q3ObjectHierarchy_GetTypeFromString("RayShadeRenderer", &rendererType) != kQ3Success)
+		{
+		printf("    the RayShade renderer is not registered, skipped\n");
+		return true;
+		}
+
+	theView = CreateView(rendererType, 128, 128, theImage);
+	if (!Check(theView != nullptr, "create RayShade view"))
+		return false;
+
+	memset(&lightData, 0, sizeof(lightData));
+	lightData.lightData.isOn       = kQ3True;
+	lightData.lightData.brightness = 1.0f;
+	Q3ColorRGB_Set(&lightData.lightData.color, 1.0f, 1.0f, 1.0f);
+	lightData.castsShadows         = kQ3True;
+	Q3Vector3D_Set(&lightData.direction, -0.5f, -0.5f, -1.0f);
+	Q3Vector3D_Normalize(&lightData.direction, &lightData.direction);
+
+	theLights = Q3LightGroup_New();
+	theObject = Q3DirectionalLight_New(&lightData);
+	Q3Group_AddObject(theLights, theObject);
+	Q3Object_Dispose(theObject);
+	Q3View_SetLightGroup(theView, theLights);
+	Q3Object_Dispose(theLights);
+
+
+
+	// Create the scene: a 200 unit floor, and 16x16x4 tiles in 4 units
+	theScene = Q3DisplayGroup_New();
+
+	theTile = Q3DisplayGroup_New();
+	Q3Vector3D_Set(&theOffset, -100.0f, -100.0f, -2.0f);
+	theObject = Q3TranslateTransform_New(&theOffset);
+	Q3Group_AddObject(theTile, theObject);
+	Q3Object_Dispose(theObject);
+
+	Q3Vector3D_Set(&theScale, 200.0f, 200.0f, 1.0f);
+	theObject = Q3ScaleTransform_New(&theScale);
+	Q3Group_AddObject(theTile, theObject);
+	Q3Object_Dispose(theObject);
+
+	theMesh = CreateGridTriMesh(1, 1);
+	Q3Group_AddObject(theTile, theMesh);
+	Q3Object_Dispose(theMesh);
+	Q3Group_AddObject(theScene, theTile);
+	Q3Object_Dispose(theTile);
+
+	theMesh = CreateGridTriMesh(1, 1);
+	for (z = 0; z < 4; ++z)
+		{
+		for (y = 0; y < kClusterSize; ++y)
+			{
+			for (x = 0; x < kClusterSize; ++x)
+				{
+				theTile = Q3DisplayGroup_New();
+				
+				Q3Vector3D_Set(&theOffset, -2.0f + 0.25f * x, -2.0f + 0.25f * y, -1.5f + 0.4f * z);
+				theObject = Q3TranslateTransform_New(&theOffset);
+				Q3Group_AddObject(theTile, theObject);
+				Q3Object_Dispose(theObject);
+				
+				Q3Vector3D_Set(&theScale, 0.15f, 0.15f, 1.0f);
+				theObject = Q3ScaleTransform_New(&theScale);
+				Q3Group_AddObject(theTile, theObject);
+				Q3Object_Dispose(theObject);
+				
+				Q3Group_AddObject(theTile, theMesh);
+				Q3Group_AddObject(theScene, theTile);
+				Q3Object_Dispose(theTile);
+				}
+			}
+		}
+
+	Q3Object_Dispose(theMesh);
+
+
+
+	// Trace the scene through each accelerator
+	for (n = 0; n < 2; ++n)
+		{
+		Q3View_GetRenderer(theView, &theRenderer);
+		Q3Object_SetProperty(theRenderer, kAcceleratorProperty, sizeof(n), &n);
+		Q3Object_Dispose(theRenderer);
+		
+		startTime = Seconds();
+		passed = Check(RenderFrame(theView, theScene), "ray trace scene") && passed;
+		traceTime = Seconds() - startTime;
+		
+		numRays[n]    = GetRendererCount(theView, kRayCountProperty);
+		buildTime[n]  = GetRendererCount(theView, kBuildTimeProperty);
+		buildBytes[n] = GetRendererCount(theView, kBuildBytesProperty);
+		images[n]     = theImage;
+		
+		traceTime -= buildTime[n] / 1000000.0;
+		snprintf(theLabel, sizeof(theLabel), "%s build", kNames[n]);
+		Report(theLabel, buildTime[n] / 1000000.0);
+		printf("    %s holds %llu bytes\n", kNames[n], buildBytes[n]);
+		snprintf(theLabel, sizeof(theLabel), "%s trace", kNames[n]);
+		Report(theLabel, traceTime, (double) numRays[n], "rays");
+		
+		passed = Check(numRays[n] > 0, "renderer reported the rays traced") && passed;
+		passed = Check(buildBytes[n] > 0, "renderer reported the accelerator size") && passed;
+		}
+
+	numDifferent = CountDifferentPixels(images[0], images[1], 0);
+	passed = Check(numDifferent == 0, "grid and BVH images match") && passed;
+	passed = Check(numRays[0] == numRays[1], "grid and BVH spawn the same rays") && passed;
+
+
+
+	// Clean up
+	Q3Object_Dispose(theView);
+	Q3Object_Dispose(theScene);
+
+	return passed;
+}
+
+
+
+
+
+//=============================================================================
+//      Test table
+//-----------------------------------------------------------------------------
+static const TestEntry gTests[] = {
+	{ "HashTable",			Test_HashTable,			"Hash table operations/s, open addressing vs. chained" },
+	{ "StorageRead",		Test_StorageRead,		"3DMF read MB/s, path vs. mapped storage" },
+	{ "SwappedRead",		Test_SwappedRead,		"3DMF geometry array read MB/s, native vs. swapped" },
+	{ "ParallelRead",		Test_ParallelRead,		"3DMF database file read MB/s, 1..N threads" },
+	{ "RoundTrip",			Test_RoundTrip,			"3DMF binary write and read back MB/s" },
+	{ "PickTriMesh",		Test_PickTriMesh,		"TriMesh picks/s, with and without a BVH" },
+	{ "PickIndex",			Test_PickIndex,			"Scene picks/s and geometries picked, with and without a pick index" },
+	{ "PushPop",			Test_PushPop,			"View state push/pop rate" },
+	{ "GroupBounds",		Test_GroupBounds,		"Automatic group culling of a 100k building city" },
+	{ "OptimizeHierarchy",	Test_OptimizeHierarchy,	"TriMesh optimization of a scene, 1..N threads" },
+	{ "VertexCache",		Test_VertexCache,		"Vertex cache miss ratio of a shuffled grid, before and after reordering" },
+	{ "EdgeAdjacency",		Test_EdgeAdjacency,		"Edges and face links of a 1M-face TriMesh" },
+	{ "Silhouette",			Test_Silhouette,		"Shadow silhouette updates as a light moves over a large TriMesh" },
+	{ "BatchTriMeshes",		Test_BatchTriMeshes,	"OpenGL draw calls and fps for 10k small TriMeshes" },
+	{ "SortTriMeshes",		Test_SortTriMeshes,		"OpenGL state changes and fps for interleaved materials" },
+	{ "TransparentSort",	Test_TransparentSort,	"OpenGL transparency sorting fps, 1..N threads" },
+	{ "WeightedTransparency", Test_WeightedTransparency, "OpenGL fps and heap, sorted vs. weighted transparency" },
+	{ "SoftwareGolden",		Test_SoftwareGolden,	"Software renderer images vs. reference images" },
+	{ "SoftwareFrameRate",	Test_SoftwareFrameRate,	"Software renderer fps, 1..N threads" },
+	{ "HeadlessThumbnails",	Test_HeadlessThumbnails, "OpenGL pixmap thumbnails/s, new vs. reused view" },
+	{ "ClassLookup",		Test_ClassLookup,		"Class lookups/s, 1..N threads, lookups during registration, and shared references" },
+	{ "RayShadeThreads",	Test_RayShadeThreads,	"RayShade ray tracing fps, 1..N threads" },
+	{ "RayShadeAccelerators", Test_RayShadeAccelerators, "RayShade build ms, bytes and rays/s, grid vs. BVH" },
+	{ nullptr,				nullptr,				nullptr }
+};
+
+
+
+
+
+//=============================================================================
+//      main : Entry point.
+//-----------------------------------------------------------------------------
+#pragma mark -
+int
+main(int argc, char* argv[])
+{	std::vector<const char*>	testNames;
+	const TestEntry*			theTest;
+	int							numFailed = 0;
+	int							n;
+
+
+
+	// Parse the arguments
+	for (n = 1; n < argc; ++n)
+		{
+		testNames.push_back(argv[n]);
+		}
+
+
+
+	// Run the tests
+	Initialize();
+
+	for (theTest = gTests; theTest->name != nullptr; ++theTest)
+		{
+		bool	wanted = testNames.empty();
+
+		for (n = 0; n < (int) testNames.size() && !wanted; ++n)
+			wanted = (strcmp(testNames[n], theTest->name) == 0);
+
+		if (!wanted)
+			continue;
+
+		printf("%s: %s\n", theTest->name, theTest->description);
+		if (!theTest->function())
+			{
+			printf("%s: FAILED\n", theTest->name);
+			numFailed++;
+			}
+		}
+
+	Terminate();
+
+	return (numFailed == 0) ? 0 : 1;
+}
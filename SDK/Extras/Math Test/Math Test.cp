@@ -51,6 +51,21 @@
 #include <iostream.h>
 #include <math.h>
 #include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+
+
+
+
+//=============================================================================
+//      Build constants
+//-----------------------------------------------------------------------------
+// Timings vary from run to run, so leave them out when comparing the output
+// with that of QD3D
+#ifndef MATH_TEST_TIMING
+	#define MATH_TEST_TIMING					1
+#endif
 
 
 
@@ -5985,6 +6000,528 @@ Test_Q3BoundingSphere_UnionRationalPoint4D()
 
 
 
+//=============================================================================
+//	Packed Array Consistency
+//-----------------------------------------------------------------------------
+//		Note :	Tightly packed arrays may be handled 4 at a time with SIMD code,
+//				while strided arrays are handled one at a time, so the results
+//				of the two must be compared to the bit.  Most of the lengths
+//				aren't a multiple of 4, so that the left over elements are
+//				checked too, and the arrays start at each alignment.
+//-----------------------------------------------------------------------------
+#pragma mark -
+
+const unsigned long kArrayLengths[] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 13, 16, 31, 257, 1003 };
+const unsigned long kNumArrayLengths = sizeof(kArrayLengths) / sizeof(kArrayLengths[0]);
+const unsigned long kMaxArrayLength = 1003;
+const unsigned long kNumArrayOffsets = 4;
+
+struct TQ3StridedPoint3D
+{
+	TQ3Point3D value;
+	float ignore;
+};
+struct TQ3StridedVector3D
+{
+	TQ3Vector3D value;
+	float ignore;
+};
+struct TQ3StridedRationalPoint4D
+{
+	TQ3RationalPoint4D value;
+	float ignore;
+};
+
+static TQ3Point3D gPackedIn[kMaxArrayLength + kNumArrayOffsets];
+static TQ3Point3D gPackedOut[kMaxArrayLength];
+static TQ3Point3D gPackedSame[kMaxArrayLength + kNumArrayOffsets];
+static TQ3RationalPoint4D gPackedOut4D[kMaxArrayLength];
+static TQ3StridedPoint3D gStridedIn[kMaxArrayLength];
+static TQ3StridedPoint3D gStridedOut[kMaxArrayLength];
+static TQ3StridedRationalPoint4D gStridedOut4D[kMaxArrayLength];
+
+//	Return a pseudo-random float in [-100, 100], the same on every platform.
+static float
+RandomFloat(TQ3Uns32& seed)
+{
+	seed = seed * 1664525UL + 1013904223UL;
+	return ((float) ((seed >> 8) & 0xFFFF) / 65536.0f) * 200.0f - 100.0f;
+}
+
+//	Fill the input arrays with the same points, including some signed zeros.
+static void
+FillArrays(TQ3Uns32 seed)
+{
+	unsigned long i;
+
+	for (i = 0; i < kMaxArrayLength + kNumArrayOffsets; ++i)
+	{
+		gPackedIn[i].x = RandomFloat(seed);
+		gPackedIn[i].y = RandomFloat(seed);
+		gPackedIn[i].z = RandomFloat(seed);
+		
+		if (i % 11 == 5)
+			gPackedIn[i].x = gPackedIn[i].y = (i % 2) ? -0.0f : 0.0f;
+	}
+}
+
+//	Copy the packed input, starting at an offset, into the strided input.
+static void
+CopyToStrided(unsigned long offset, unsigned long numPoints)
+{
+	unsigned long i;
+
+	for (i = 0; i < numPoints; ++i)
+	{
+		gStridedIn[i].value = gPackedIn[offset + i];
+		gStridedIn[i].ignore = 12345.0f;
+	}
+}
+
+//	Fill a matrix with pseudo-random values.  An affine matrix has a last
+//	column of (0, 0, 0, 1), while a projective one keeps w well away from 0.
+static void
+RandomMatrix(TQ3Matrix4x4& matrix4x4, TQ3Uns32 seed, TQ3Boolean isAffine)
+{
+	int i, j;
+
+	for (i = 0; i < 4; ++i)
+		for (j = 0; j < 4; ++j)
+			matrix4x4.value[i][j] = RandomFloat(seed) / 10.0f;
+
+	for (i = 0; i < 3; ++i)
+		matrix4x4.value[i][3] = isAffine ? 0.0f : RandomFloat(seed) / 1000.0f;
+
+	matrix4x4.value[3][3] = isAffine ? 1.0f : 500.0f;
+}
+
+//	Return the number of floats between two floats, counting both zeros as one.
+static TQ3Uns32
+UlpDistance(float a, float b)
+{
+	TQ3Int32 ia, ib;
+
+	memcpy(&ia, &a, sizeof(ia));
+	memcpy(&ib, &b, sizeof(ib));
+
+	if (ia < 0)
+		ia = (TQ3Int32) (0x80000000UL - (TQ3Uns32) ia);
+	if (ib < 0)
+		ib = (TQ3Int32) (0x80000000UL - (TQ3Uns32) ib);
+
+	return (ia > ib) ? (TQ3Uns32) (ia - ib) : (TQ3Uns32) (ib - ia);
+}
+
+//	Keep the largest distance between two floats.
+static void
+AccumulateUlps(TQ3Uns32& maxUlps, float a, float b)
+{
+	TQ3Uns32 ulps = UlpDistance(a, b);
+
+	if (ulps > maxUlps)
+		maxUlps = ulps;
+}
+
+//	Are two floats the same to the bit?
+static TQ3Boolean
+BitsEqual(float a, float b)
+{
+	return (TQ3Boolean) (memcmp(&a, &b, sizeof(float)) == 0);
+}
+
+//	Report the results of comparing some arrays.
+static void
+Report(const char* what, TQ3Boolean isSame, const char* sameText = "bit-exact")
+{
+	cout << "    " << what << ": " << (isSame ? sameText : "DIFFERENT") << endl;
+}
+
+static void
+Report(const char* what, TQ3Uns32 maxUlps)
+{
+	cout << "    " << what << ": " << maxUlps << " ulp" << endl;
+}
+
+//	TQ3Status Q3Point3D_To3DTransformArray(const TQ3Point3D* inPoints3D, const TQ3Matrix4x4* matrix4x4, TQ3Point3D* outPoints3D, TQ3Uns32 numPoints, TQ3Uns32 inStructSize, TQ3Uns32 outStructSize)
+static void
+Test_Packed_Q3Point3D_To3DTransformArray()
+{
+	Begin("Q3Point3D_To3DTransformArray");
+
+	const char* phaseNames[2] = { "Affine", "Projective" };
+	TQ3Matrix4x4 matrix4x4;
+	TQ3Point3D single;
+	unsigned long n, offset, i;
+	int phase;
+
+	FillArrays(1);
+
+	for (phase = 0; phase < 2; ++phase)
+	{
+		BeginPhase(phaseNames[phase]);
+		RandomMatrix(matrix4x4, 2, (TQ3Boolean) (phase == 0));
+
+		TQ3Boolean stridedExact = kQ3True;
+		TQ3Boolean sameExact = kQ3True;
+		TQ3Uns32 maxUlps = 0;
+
+		for (n = 0; n < kNumArrayLengths; ++n)
+		{
+			unsigned long numPoints = kArrayLengths[n];
+
+			for (offset = 0; offset < kNumArrayOffsets; ++offset)
+			{
+				CopyToStrided(offset, numPoints);
+				memcpy(gPackedSame, gPackedIn, sizeof(gPackedSame));
+
+				Q3Point3D_To3DTransformArray(&gPackedIn[offset], &matrix4x4, gPackedOut, numPoints,
+					sizeof(TQ3Point3D), sizeof(TQ3Point3D));
+				Q3Point3D_To3DTransformArray(&gStridedIn[0].value, &matrix4x4, &gStridedOut[0].value, numPoints,
+					sizeof(TQ3StridedPoint3D), sizeof(TQ3StridedPoint3D));
+				Q3Point3D_To3DTransformArray(&gPackedSame[offset], &matrix4x4, &gPackedSame[offset], numPoints,
+					sizeof(TQ3Point3D), sizeof(TQ3Point3D));
+
+				for (i = 0; i < numPoints; ++i)
+				{
+					const TQ3Point3D& packed = gPackedOut[i];
+					const TQ3Point3D& strided = gStridedOut[i].value;
+					const TQ3Point3D& same = gPackedSame[offset + i];
+
+					if (!BitsEqual(packed.x, strided.x) || !BitsEqual(packed.y, strided.y) || !BitsEqual(packed.z, strided.z))
+						stridedExact = kQ3False;
+					if (!BitsEqual(packed.x, same.x) || !BitsEqual(packed.y, same.y) || !BitsEqual(packed.z, same.z))
+						sameExact = kQ3False;
+
+					Q3Point3D_Transform(&gPackedIn[offset + i], &matrix4x4, &single);
+					AccumulateUlps(maxUlps, packed.x, single.x);
+					AccumulateUlps(maxUlps, packed.y, single.y);
+					AccumulateUlps(maxUlps, packed.z, single.z);
+				}
+			}
+		}
+
+		Report("packed vs. strided", stridedExact);
+		Report("packed vs. same parameter", sameExact);
+		Report("packed vs. Q3Point3D_Transform", maxUlps);
+	}
+}
+
+//	TQ3Status Q3Point3D_To4DTransformArray(const TQ3Point3D* inPoints3D, const TQ3Matrix4x4* matrix4x4, TQ3RationalPoint4D* outRationalPoints4D, TQ3Uns32 numPoints, TQ3Uns32 inStructSize, TQ3Uns32 outStructSize)
+static void
+Test_Packed_Q3Point3D_To4DTransformArray()
+{
+	Begin("Q3Point3D_To4DTransformArray");
+
+	TQ3Matrix4x4 matrix4x4;
+	TQ3RationalPoint4D single, point4D;
+	TQ3Boolean stridedExact = kQ3True;
+	TQ3Uns32 maxUlps = 0;
+	unsigned long n, offset, i;
+
+	FillArrays(3);
+	RandomMatrix(matrix4x4, 4, kQ3False);
+
+	for (n = 0; n < kNumArrayLengths; ++n)
+	{
+		unsigned long numPoints = kArrayLengths[n];
+
+		for (offset = 0; offset < kNumArrayOffsets; ++offset)
+		{
+			CopyToStrided(offset, numPoints);
+
+			Q3Point3D_To4DTransformArray(&gPackedIn[offset], &matrix4x4, gPackedOut4D, numPoints,
+				sizeof(TQ3Point3D), sizeof(TQ3RationalPoint4D));
+			Q3Point3D_To4DTransformArray(&gStridedIn[0].value, &matrix4x4, &gStridedOut4D[0].value, numPoints,
+				sizeof(TQ3StridedPoint3D), sizeof(TQ3StridedRationalPoint4D));
+
+			for (i = 0; i < numPoints; ++i)
+			{
+				const TQ3RationalPoint4D& packed = gPackedOut4D[i];
+				const TQ3RationalPoint4D& strided = gStridedOut4D[i].value;
+
+				if (!BitsEqual(packed.x, strided.x) || !BitsEqual(packed.y, strided.y) ||
+					!BitsEqual(packed.z, strided.z) || !BitsEqual(packed.w, strided.w))
+					stridedExact = kQ3False;
+
+				Q3Point3D_To4D(&gPackedIn[offset + i], &point4D);
+				Q3RationalPoint4D_Transform(&point4D, &matrix4x4, &single);
+				AccumulateUlps(maxUlps, packed.x, single.x);
+				AccumulateUlps(maxUlps, packed.y, single.y);
+				AccumulateUlps(maxUlps, packed.z, single.z);
+				AccumulateUlps(maxUlps, packed.w, single.w);
+			}
+		}
+	}
+
+	Report("packed vs. strided", stridedExact);
+	Report("packed vs. Q3RationalPoint4D_Transform", maxUlps);
+}
+
+//	TQ3Status Q3Vector3D_To3DTransformArray(const TQ3Vector3D* inVectors3D, const TQ3Matrix4x4* matrix4x4, TQ3Vector3D* outVectors3D, TQ3Uns32 numVectors, TQ3Uns32 inStructSize, TQ3Uns32 outStructSize)
+static void
+Test_Packed_Q3Vector3D_To3DTransformArray()
+{
+	Begin("Q3Vector3D_To3DTransformArray");
+
+	TQ3Matrix4x4 matrix4x4;
+	TQ3Vector3D single;
+	TQ3Boolean stridedExact = kQ3True;
+	TQ3Boolean sameExact = kQ3True;
+	TQ3Uns32 maxUlps = 0;
+	unsigned long n, offset, i;
+
+	FillArrays(5);
+	RandomMatrix(matrix4x4, 6, kQ3False);
+
+	for (n = 0; n < kNumArrayLengths; ++n)
+	{
+		unsigned long numVectors = kArrayLengths[n];
+
+		for (offset = 0; offset < kNumArrayOffsets; ++offset)
+		{
+			CopyToStrided(offset, numVectors);
+			memcpy(gPackedSame, gPackedIn, sizeof(gPackedSame));
+
+			Q3Vector3D_To3DTransformArray((const TQ3Vector3D*) &gPackedIn[offset], &matrix4x4,
+				(TQ3Vector3D*) gPackedOut, numVectors, sizeof(TQ3Vector3D), sizeof(TQ3Vector3D));
+			Q3Vector3D_To3DTransformArray((const TQ3Vector3D*) &gStridedIn[0].value, &matrix4x4,
+				(TQ3Vector3D*) &gStridedOut[0].value, numVectors,
+				sizeof(TQ3StridedVector3D), sizeof(TQ3StridedVector3D));
+			Q3Vector3D_To3DTransformArray((const TQ3Vector3D*) &gPackedSame[offset], &matrix4x4,
+				(TQ3Vector3D*) &gPackedSame[offset], numVectors, sizeof(TQ3Vector3D), sizeof(TQ3Vector3D));
+
+			for (i = 0; i < numVectors; ++i)
+			{
+				const TQ3Point3D& packed = gPackedOut[i];
+				const TQ3Point3D& strided = gStridedOut[i].value;
+				const TQ3Point3D& same = gPackedSame[offset + i];
+
+				if (!BitsEqual(packed.x, strided.x) || !BitsEqual(packed.y, strided.y) || !BitsEqual(packed.z, strided.z))
+					stridedExact = kQ3False;
+				if (!BitsEqual(packed.x, same.x) || !BitsEqual(packed.y, same.y) || !BitsEqual(packed.z, same.z))
+					sameExact = kQ3False;
+
+				Q3Vector3D_Transform((const TQ3Vector3D*) &gPackedIn[offset + i], &matrix4x4, &single);
+				AccumulateUlps(maxUlps, packed.x, single.x);
+				AccumulateUlps(maxUlps, packed.y, single.y);
+				AccumulateUlps(maxUlps, packed.z, single.z);
+			}
+		}
+	}
+
+	Report("packed vs. strided", stridedExact);
+	Report("packed vs. same parameter", sameExact);
+	Report("packed vs. Q3Vector3D_Transform", maxUlps);
+}
+
+//	TQ3BoundingBox* Q3BoundingBox_SetFromPoints3D(TQ3BoundingBox* bBox, const TQ3Point3D* points3D, unsigned long numPoints, unsigned long structSize);
+static void
+Test_Packed_Q3BoundingBox_SetFromPoints3D()
+{
+	Begin("Q3BoundingBox_SetFromPoints3D");
+
+	const char* phaseNames[2] = { "Nonzero Bounds", "Zero Bounds" };
+	TQ3BoundingBox packed, strided, single;
+	unsigned long n, offset, i;
+	int phase;
+
+	for (phase = 0; phase < 2; ++phase)
+	{
+		BeginPhase(phaseNames[phase]);
+		FillArrays(7);
+
+		// Make the signed zeros the largest x and the smallest y
+		if (phase == 1)
+		{
+			for (i = 0; i < kMaxArrayLength + kNumArrayOffsets; ++i)
+			{
+				if (gPackedIn[i].x > 0.0f)
+					gPackedIn[i].x = -gPackedIn[i].x;
+				if (gPackedIn[i].y < 0.0f)
+					gPackedIn[i].y = -gPackedIn[i].y;
+			}
+		}
+
+		TQ3Boolean stridedExact = kQ3True;
+		TQ3Boolean singleEqual = kQ3True;
+
+		for (n = 0; n < kNumArrayLengths; ++n)
+		{
+			unsigned long numPoints = kArrayLengths[n];
+
+			for (offset = 0; offset < kNumArrayOffsets; ++offset)
+			{
+				CopyToStrided(offset, numPoints);
+
+				Q3BoundingBox_SetFromPoints3D(&packed, &gPackedIn[offset], numPoints, sizeof(TQ3Point3D));
+				Q3BoundingBox_SetFromPoints3D(&strided, &gStridedIn[0].value, numPoints, sizeof(TQ3StridedPoint3D));
+
+				Q3BoundingBox_Reset(&single);
+				for (i = 0; i < numPoints; ++i)
+					Q3BoundingBox_UnionPoint3D(&single, &gPackedIn[offset + i], &single);
+
+				if (packed.isEmpty != strided.isEmpty || packed.isEmpty != single.isEmpty)
+				{
+					stridedExact = singleEqual = kQ3False;
+					continue;
+				}
+
+				if (packed.isEmpty)
+					continue;
+
+				if (memcmp(&packed.min, &strided.min, sizeof(TQ3Point3D)) != 0 ||
+					memcmp(&packed.max, &strided.max, sizeof(TQ3Point3D)) != 0)
+					stridedExact = kQ3False;
+
+				// The union can choose either zero, so only compare values here
+				if (packed.min.x != single.min.x || packed.min.y != single.min.y || packed.min.z != single.min.z ||
+					packed.max.x != single.max.x || packed.max.y != single.max.y || packed.max.z != single.max.z)
+					singleEqual = kQ3False;
+			}
+		}
+
+		Report("packed vs. strided", stridedExact);
+		Report("packed vs. Q3BoundingBox_UnionPoint3D", singleEqual, "equal");
+	}
+}
+
+
+
+
+
+#if MATH_TEST_TIMING
+//=============================================================================
+//	Packed Array Timings
+//-----------------------------------------------------------------------------
+//		Note :	Compares the speed of tightly packed and strided arrays, which
+//				take the SIMD and scalar paths respectively where SIMD is
+//				available.  The lengths are odd, so the scalar tails count too.
+//-----------------------------------------------------------------------------
+#pragma mark -
+
+const unsigned long kTimingLength = 1000003;
+const unsigned long kTimingRepeats = 50;
+
+//	Report a time in seconds as millions of points a second.
+static void
+ReportRate(const char* what, clock_t startTime)
+{
+	double seconds = (double) (clock() - startTime) / CLOCKS_PER_SEC;
+	double rate = (seconds > 0.0) ? (kTimingLength * (double) kTimingRepeats) / seconds / 1.0e6 : 0.0;
+
+	cout << "    " << setw(40) << setiosflags(ios::left) << what << resetiosflags(ios::left)
+		 << setw(10) << setprecision(1) << setiosflags(ios::fixed) << rate << " Mpoints/s" << endl;
+}
+
+static void
+Time_Packed_Arrays()
+{
+	Begin("Packed and strided arrays");
+
+	TQ3Point3D* packedIn = (TQ3Point3D*) malloc(kTimingLength * sizeof(TQ3Point3D));
+	TQ3Point3D* packedOut = (TQ3Point3D*) malloc(kTimingLength * sizeof(TQ3Point3D));
+	TQ3RationalPoint4D* packedOut4D = (TQ3RationalPoint4D*) malloc(kTimingLength * sizeof(TQ3RationalPoint4D));
+	TQ3StridedPoint3D* stridedIn = (TQ3StridedPoint3D*) malloc(kTimingLength * sizeof(TQ3StridedPoint3D));
+	TQ3StridedPoint3D* stridedOut = (TQ3StridedPoint3D*) malloc(kTimingLength * sizeof(TQ3StridedPoint3D));
+	TQ3StridedRationalPoint4D* stridedOut4D = (TQ3StridedRationalPoint4D*) malloc(kTimingLength * sizeof(TQ3StridedRationalPoint4D));
+
+	if (packedIn == NULL || packedOut == NULL || packedOut4D == NULL ||
+		stridedIn == NULL || stridedOut == NULL || stridedOut4D == NULL)
+	{
+		Test("*** Out of memory ***");
+	}
+	else
+	{
+		TQ3Matrix4x4 affine, projective;
+		TQ3BoundingBox bBox;
+		TQ3Uns32 seed = 9;
+		unsigned long i, n;
+		clock_t startTime;
+
+		for (i = 0; i < kTimingLength; ++i)
+		{
+			packedIn[i].x = RandomFloat(seed);
+			packedIn[i].y = RandomFloat(seed);
+			packedIn[i].z = RandomFloat(seed);
+			stridedIn[i].value = packedIn[i];
+		}
+
+		RandomMatrix(affine, 10, kQ3True);
+		RandomMatrix(projective, 11, kQ3False);
+
+		startTime = clock();
+		for (n = 0; n < kTimingRepeats; ++n)
+			Q3Point3D_To3DTransformArray(packedIn, &affine, packedOut, kTimingLength,
+				sizeof(TQ3Point3D), sizeof(TQ3Point3D));
+		ReportRate("Point3D_To3D affine, packed", startTime);
+
+		startTime = clock();
+		for (n = 0; n < kTimingRepeats; ++n)
+			Q3Point3D_To3DTransformArray(&stridedIn[0].value, &affine, &stridedOut[0].value, kTimingLength,
+				sizeof(TQ3StridedPoint3D), sizeof(TQ3StridedPoint3D));
+		ReportRate("Point3D_To3D affine, strided", startTime);
+
+		startTime = clock();
+		for (n = 0; n < kTimingRepeats; ++n)
+			Q3Point3D_To3DTransformArray(packedIn, &projective, packedOut, kTimingLength,
+				sizeof(TQ3Point3D), sizeof(TQ3Point3D));
+		ReportRate("Point3D_To3D projective, packed", startTime);
+
+		startTime = clock();
+		for (n = 0; n < kTimingRepeats; ++n)
+			Q3Point3D_To3DTransformArray(&stridedIn[0].value, &projective, &stridedOut[0].value, kTimingLength,
+				sizeof(TQ3StridedPoint3D), sizeof(TQ3StridedPoint3D));
+		ReportRate("Point3D_To3D projective, strided", startTime);
+
+		startTime = clock();
+		for (n = 0; n < kTimingRepeats; ++n)
+			Q3Point3D_To4DTransformArray(packedIn, &projective, packedOut4D, kTimingLength,
+				sizeof(TQ3Point3D), sizeof(TQ3RationalPoint4D));
+		ReportRate("Point3D_To4D, packed", startTime);
+
+		startTime = clock();
+		for (n = 0; n < kTimingRepeats; ++n)
+			Q3Point3D_To4DTransformArray(&stridedIn[0].value, &projective, &stridedOut4D[0].value, kTimingLength,
+				sizeof(TQ3StridedPoint3D), sizeof(TQ3StridedRationalPoint4D));
+		ReportRate("Point3D_To4D, strided", startTime);
+
+		startTime = clock();
+		for (n = 0; n < kTimingRepeats; ++n)
+			Q3Vector3D_To3DTransformArray((const TQ3Vector3D*) packedIn, &affine, (TQ3Vector3D*) packedOut,
+				kTimingLength, sizeof(TQ3Vector3D), sizeof(TQ3Vector3D));
+		ReportRate("Vector3D_To3D, packed", startTime);
+
+		startTime = clock();
+		for (n = 0; n < kTimingRepeats; ++n)
+			Q3Vector3D_To3DTransformArray((const TQ3Vector3D*) &stridedIn[0].value, &affine,
+				(TQ3Vector3D*) &stridedOut[0].value, kTimingLength,
+				sizeof(TQ3StridedVector3D), sizeof(TQ3StridedVector3D));
+		ReportRate("Vector3D_To3D, strided", startTime);
+
+		startTime = clock();
+		for (n = 0; n < kTimingRepeats; ++n)
+			Q3BoundingBox_SetFromPoints3D(&bBox, packedIn, kTimingLength, sizeof(TQ3Point3D));
+		ReportRate("BoundingBox_SetFromPoints3D, packed", startTime);
+
+		startTime = clock();
+		for (n = 0; n < kTimingRepeats; ++n)
+			Q3BoundingBox_SetFromPoints3D(&bBox, &stridedIn[0].value, kTimingLength, sizeof(TQ3StridedPoint3D));
+		ReportRate("BoundingBox_SetFromPoints3D, strided", startTime);
+	}
+
+	free(packedIn);
+	free(packedOut);
+	free(packedOut4D);
+	free(stridedIn);
+	free(stridedOut);
+	free(stridedOut4D);
+}
+#endif // MATH_TEST_TIMING
+
+
+
+
+
 //=============================================================================
 //		Public functions.
 //-----------------------------------------------------------------------------
@@ -6193,6 +6730,17 @@ int main(void)
 	Test_Q3BoundingSphere_UnionPoint3D();
 	Test_Q3BoundingSphere_UnionRationalPoint4D();
 
+	BeginSection("Packed Array Consistency");
+	Test_Packed_Q3Point3D_To3DTransformArray();
+	Test_Packed_Q3Point3D_To4DTransformArray();
+	Test_Packed_Q3Vector3D_To3DTransformArray();
+	Test_Packed_Q3BoundingBox_SetFromPoints3D();
+
+#if MATH_TEST_TIMING
+	BeginSection("Packed Array Timings");
+	Time_Packed_Arrays();
+#endif
+
 	// Clean up.
 	Terminate();
 
@@ -56,6 +56,43 @@
 #include "RT_Surface.h"
 
 
+/******************************************************************************
+ **																			 **
+ **								Constants								     **
+ **																			 **
+ *****************************************************************************/
+/*
+ *	Renderer properties in which the plug-in reports on the most recent
+ *	frame.  Data type: TQ3Uns64.
+ *
+ *	kRSRendererPropertyRayCount		Rays spawned: eye, shadow, reflected
+ *									and refracted.
+ *	kRSRendererPropertyBuildTime	Microseconds taken to build the
+ *									accelerator over the scene.
+ *	kRSRendererPropertyBuildBytes	Bytes held by the accelerator.
+ */
+enum
+{
+	kRSRendererPropertyRayCount		= Q3_OBJECT_TYPE('r', 's', 'r', 'c'),
+	kRSRendererPropertyBuildTime	= Q3_OBJECT_TYPE('r', 's', 'b', 't'),
+	kRSRendererPropertyBuildBytes	= Q3_OBJECT_TYPE('r', 's', 'b', 'b')
+};
+
+/*
+ *	Renderer property which selects the accelerator, read at the end of
+ *	each frame's submission.  Data type: TQ3Uns32, one of the values below.
+ *	The default is the bounding volume hierarchy; the uniform grid is the
+ *	structure used before, kept for comparison.
+ */
+enum
+{
+	kRSRendererPropertyAccelerator	= Q3_OBJECT_TYPE('r', 's', 'a', 'c'),
+	
+	kRSAcceleratorBvh				= 0,
+	kRSAcceleratorGrid				= 1
+};
+
+
 /******************************************************************************
  **																			 **
  **								Data Structure							     **
@@ -126,6 +163,12 @@ TQ3Status RS_Geometry_Triangle(
 	TQ3GeometryObject 			triangle, 
 	const TQ3TriangleData		*triangleData);
 		
+TQ3Status RS_Geometry_TriMesh(
+	TQ3ViewObject 				view, 
+	TRSRendererPrivate			*srPrivate,
+	TQ3GeometryObject 			triMesh, 
+	const TQ3TriMeshData		*triMeshData);
+		
 TQ3Status RS_Geometry_Line(
 	TQ3ViewObject 				view, 
 	TRSRendererPrivate			*srPrivate,
@@ -55,10 +55,12 @@
 	#include <Quesa/Quesa.h>
 	#include <Quesa/QuesaGroup.h>
 	#include <Quesa/QuesaExtension.h>
+	#include <Quesa/QuesaView.h>
 #else
 	#include <Quesa.h>
 	#include <QuesaGroup.h>
 	#include <QuesaExtension.h>
+	#include <QuesaView.h>
 #endif
 
 #include <stdlib.h>
@@ -106,6 +108,15 @@ TQ3Status RS_Exit(
 
 #endif /* QUESA_OS_MACINTOSH */
 
+#if QUESA_OS_UNIX
+extern "C" {
+/*
+ *  Shared library initialization entry point
+ */
+void RS_Initialize() __attribute__ ((constructor));
+}
+#endif /* QUESA_OS_UNIX */
+
 #if QUESA_OS_WIN32
 #include <Windows.h>
 
@@ -446,6 +457,21 @@ TQ3Status RS_StartPass(
     
     return kQ3Success;
 }
+/*===========================================================================*\
+ *
+ *	Routine:	rs_TraceProgress()
+ *
+ *	Comments:	Reports the progress of the ray tracer to the view.
+ *
+\*===========================================================================*/
+static TQ3Status
+rs_TraceProgress(
+	void					*inView,
+	int						inCurrent,
+	int						inTotal)
+{
+	return Q3XView_IdleProgress((TQ3ViewObject)inView, inCurrent, inTotal);
+}
 /*===========================================================================*\
  *
  *	Routine:	SR_EndPass()
@@ -462,12 +488,26 @@ TQ3ViewStatus RS_EndPass(
 	TQ3ViewStatus	result = kQ3ViewStatusDone;
 	TQ3Status 		theStatus;
 	TRSRasterizer	*theRasterizer = NULL;
+	TQ3RendererObject	theRenderer = NULL;
+	TQ3Uns32		theAccelerator = kRSAcceleratorBvh;
+	unsigned long long	numRays, buildTime, buildBytes;
+	unsigned long	numBytes;
 	TQ3Float32*		buf = NULL ;
 	/*
 	 * Do the raytracing:
 	 */
     TQ3DrawContextObject theDrawContext = NULL;
     
+    if (Q3View_GetRenderer(pView, &theRenderer) == kQ3Success)
+    {
+    	Q3Object_GetProperty(theRenderer, kRSRendererPropertyAccelerator,
+    		sizeof(theAccelerator), NULL, &theAccelerator);
+    	Q3Object_Dispose(theRenderer);
+    	theRenderer = NULL;
+    }
+    RT_SetAccelerator(rsPrivate->raytracer, theAccelerator == kRSAcceleratorGrid ?
+    	kRTAcceleratorGrid : kRTAcceleratorBvh);
+    
     theStatus = RT_EndScene(rsPrivate->raytracer);
     if (theStatus != kQ3Success)
     {
@@ -514,12 +554,40 @@ TQ3ViewStatus RS_EndPass(
 	              goto cleanup;
 	        }
 	      
+			/*
+			 * RayTrace the image, calling the user supplied idle method
+			 * and cancelling if the user wants to.
+			 */
+			if (RTRayTracer_Trace(theTracer, rs_TraceProgress, pView) != kQ3Success)
+			{
+				result = kQ3ViewStatusCancelled;
+				goto cleanup;
+			}
+			
+			/*
+			 * Report the number of rays, so that the rate can be measured,
+			 * and what it cost to build the accelerator.
+			 */
+			numRays = RTRayTracer_GetRayCount(theTracer);
+			RT_GetBuildStats(rsPrivate->raytracer, &buildTime, &numBytes);
+			buildBytes = numBytes;
+			if (Q3View_GetRenderer(pView, &theRenderer) == kQ3Success)
+			{
+				Q3Object_SetProperty(theRenderer, kRSRendererPropertyRayCount,
+					sizeof(numRays), &numRays);
+				Q3Object_SetProperty(theRenderer, kRSRendererPropertyBuildTime,
+					sizeof(buildTime), &buildTime);
+				Q3Object_SetProperty(theRenderer, kRSRendererPropertyBuildBytes,
+					sizeof(buildBytes), &buildBytes);
+				Q3Object_Dispose(theRenderer);
+			}
+	      
 	      	RSRasterizer_Start( theRasterizer );
 	                
 	        for (int i = 0; i < yres; i++)
 	        {
 	        	/*
-	        	 * RayTrace the next scan line
+	        	 * Get the next scan line
 	        	 */
 	        	if (RTRayTracer_ScanNextLine(theTracer,i,(TQ3Float32(*)[4])buf, xres * 4 * sizeof ( TQ3Float32 ) ) != kQ3Success)
 	            {
@@ -537,17 +605,6 @@ TQ3ViewStatus RS_EndPass(
             	}
 	            RSRasterizer_Rasterize_RGB_Span(theRasterizer,left,i+top,width,(TQ3Float32(*)[4])buf);
            		RSRasterizer_Unlock(theRasterizer);
-
-         		/*
-         		 * Call user supplied idle method and cancel if the user 
-         		 * wants to.
-         		 */
-                if (Q3XView_IdleProgress(pView,i,yres) != kQ3Success)
-                {
-            		result = kQ3ViewStatusCancelled;
-            		goto cleanup;
-            	}
-            	
             }
             
 	      	RSRasterizer_Finish( theRasterizer );
@@ -626,6 +683,10 @@ static TQ3XFunctionPointer RS_Geometry_MetaHandler(
 			return (TQ3XFunctionPointer) RS_Geometry_Triangle;
 			break;
 		}
+		case kQ3GeometryTypeTriMesh: {
+			return (TQ3XFunctionPointer) RS_Geometry_TriMesh;
+			break;
+		}
 		default: {
 			return NULL;
 			break;
@@ -945,7 +1006,7 @@ TQ3Status RS_Exit(
 
 
 
-#elif TARGET_RT_MAC_MACHO
+#elif TARGET_RT_MAC_MACHO || QUESA_OS_UNIX
 
 void RS_Initialize()
 {
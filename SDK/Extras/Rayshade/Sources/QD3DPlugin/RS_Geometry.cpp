@@ -45,6 +45,8 @@
 //-----------------------------------------------------------------------------
 #include "RSPrefix.h"
 
+#include <vector>
+
 #include "RSPlugin.h"
 #include "RS_Attributes.h"
 
@@ -223,6 +225,228 @@ exit:
 	return theStatus;
 }
 
+/*===========================================================================*\
+ *
+ *	Routine:	rs_SurfaceAttributeSize()
+ *
+ *	Comments:	Returns the size of the data of an attribute that
+ *				RS_UpdateAttributes uses to set up the surface, or 0 if the
+ *				attribute doesn't affect the surface.
+ *
+\*===========================================================================*/
+static TQ3Uns32
+rs_SurfaceAttributeSize(
+						TQ3AttributeType			inType)
+{
+	switch (inType)
+	{
+		case kQ3AttributeTypeAmbientCoefficient:
+		case kQ3AttributeTypeSpecularControl:
+			return sizeof(float);
+		
+		case kQ3AttributeTypeDiffuseColor:
+		case kQ3AttributeTypeSpecularColor:
+		case kQ3AttributeTypeTransparencyColor:
+			return sizeof(TQ3ColorRGB);
+		
+		case kQ3AttributeTypeHighlightState:
+			return sizeof(TQ3Switch);
+		
+		case kQ3AttributeTypeSurfaceShader:
+			return sizeof(TQ3SurfaceShaderObject);
+		
+		default:
+			return 0;
+	}
+}
+
+/*===========================================================================*\
+ *
+ *	Routine:	rs_Geometry_TriMeshFaces()
+ *
+ *	Comments:	Submits the triangles of a TriMesh one at a time, each with
+ *				the surface given by its own attributes. The points, normals
+ *				and parameters are already in world space.
+ *
+\*===========================================================================*/
+static TQ3Status
+rs_Geometry_TriMeshFaces(
+						TQ3ViewObject 				pView,
+						TRSRendererPrivate			*rsPrivate,
+						const TQ3TriMeshData		*pTriMeshData,
+						const TQ3Point3D			*inPoints,
+						const TQ3Vector3D			*inNormals,
+						const TQ3Param2D			*inParams)
+{
+	TQ3Status			theStatus = kQ3Success;
+	CTexture			*savedTexture = rsPrivate->raytracer->currentTexture;
+	
+	for (TQ3Uns32 n = 0; n < pTriMeshData->numTriangles; n++)
+	{
+		TQ3AttributeSet		theFaceSet;
+		TQ3AttributeSet		theAttributeSet;
+		const TQ3Uns32		*theIndices = pTriMeshData->triangles[n].pointIndices;
+		TQ3Point3D			theVertices[3];
+		TQ3Vector3D			theNormals[3];
+		TQ3Param2D			theParams[3];
+		
+		/*
+		 * Build this face's attribute set, on top of the TriMesh's:
+		 */
+		theFaceSet = Q3AttributeSet_New();
+		if (theFaceSet == NULL)
+			return kQ3Failure;
+		
+		for (TQ3Uns32 i = 0; i < pTriMeshData->numTriangleAttributeTypes; i++)
+		{
+			const TQ3TriMeshAttributeData	*theData = &pTriMeshData->triangleAttributeTypes[i];
+			TQ3Uns32						theSize = rs_SurfaceAttributeSize(theData->attributeType);
+			
+			if ((theSize == 0) || (theData->data == NULL))
+				continue;
+			if ((theData->attributeUseArray != NULL) && !theData->attributeUseArray[n])
+				continue;
+			Q3AttributeSet_Add(theFaceSet, theData->attributeType,
+				(const char *) theData->data + n * theSize);
+		}
+		
+		theAttributeSet = theFaceSet;
+		if (pTriMeshData->triMeshAttributeSet != NULL)
+		{
+			theAttributeSet = Q3AttributeSet_New();
+			if (theAttributeSet != NULL)
+				Q3AttributeSet_Inherit(pTriMeshData->triMeshAttributeSet, theFaceSet, theAttributeSet);
+			Q3Object_Dispose(theFaceSet);
+			if (theAttributeSet == NULL)
+				return kQ3Failure;
+		}
+		
+		rsPrivate->raytracer->currentTexture = savedTexture;
+		theStatus = RS_UpdateAttributes(pView,rsPrivate,theAttributeSet);
+		Q3Object_Dispose(theAttributeSet);
+		if (theStatus != kQ3Success)
+			break;
+		
+		for (int j = 0; j < 3; j++)
+		{
+			theVertices[j] = inPoints[theIndices[j]];
+			if (inNormals)
+				theNormals[j] = inNormals[theIndices[j]];
+			if (inParams)
+				theParams[j] = inParams[theIndices[j]];
+		}
+		
+		theStatus = RT_SubmitTriangle(rsPrivate->raytracer,
+			(inNormals ? kRTTriangleType_Phong : kRTTriangleType_Flat),
+			theVertices,theNormals,(inParams ? theParams : NULL));
+		if (theStatus != kQ3Success)
+			break;
+	}
+	
+	rsPrivate->raytracer->currentTexture = savedTexture;
+	return theStatus;
+}
+
+/*===========================================================================*\
+ *
+ *	Routine:	RS_Geometry_TriMesh()
+ *
+ *	Comments:	Submits a TriMesh to the raytracer as a single mesh object,
+ *				which shares its vertices between triangles instead of
+ *				making an object for each one. Vertex normals and UVs are
+ *				used if every vertex has them. A TriMesh whose triangles
+ *				carry surface attributes of their own is submitted a
+ *				triangle at a time.
+ *
+\*===========================================================================*/
+TQ3Status RS_Geometry_TriMesh(
+						TQ3ViewObject 				pView,
+						TRSRendererPrivate			*rsPrivate,
+						TQ3GeometryObject			/*pGeom*/, 
+						const TQ3TriMeshData		*pTriMeshData)
+{
+	TQ3Status						theStatus = kQ3Success;
+	CTexture						*savedTexture = rsPrivate->raytracer->currentTexture;
+	const TQ3TriMeshAttributeData	*theNormalData = NULL;
+	const TQ3TriMeshAttributeData	*theSurfaceUVData = NULL;
+	const TQ3TriMeshAttributeData	*theShadingUVData = NULL;
+	const TQ3TriMeshAttributeData	*theUVData;
+	std::vector<TQ3Point3D>			thePoints(pTriMeshData->numPoints);
+	std::vector<TQ3Vector3D>		theNormals;
+	std::vector<TQ3Param2D>			theParams;
+	bool							hasFaceSurfaces = false;
+	
+	if ((pTriMeshData->numPoints == 0) || (pTriMeshData->numTriangles == 0))
+		return kQ3Success;
+	
+	theStatus = RS_UpdateAttributes(pView,rsPrivate,pTriMeshData->triMeshAttributeSet);
+	if (theStatus != kQ3Success)
+		goto exit;
+	
+	/*
+	 * Find the vertex attributes that every vertex has:
+	 */
+	for (TQ3Uns32 i = 0; i < pTriMeshData->numVertexAttributeTypes; i++)
+	{
+		const TQ3TriMeshAttributeData	*theData = &pTriMeshData->vertexAttributeTypes[i];
+		
+		if ((theData->data == NULL) || (theData->attributeUseArray != NULL))
+			continue;
+		if (theData->attributeType == kQ3AttributeTypeNormal)
+			theNormalData = theData;
+		else if (theData->attributeType == kQ3AttributeTypeSurfaceUV)
+			theSurfaceUVData = theData;
+		else if (theData->attributeType == kQ3AttributeTypeShadingUV)
+			theShadingUVData = theData;
+	}
+	theUVData = (theSurfaceUVData != NULL ? theSurfaceUVData : theShadingUVData);
+	
+	for (TQ3Uns32 i = 0; i < pTriMeshData->numTriangleAttributeTypes; i++)
+	{
+		if ((pTriMeshData->triangleAttributeTypes[i].data != NULL) &&
+			(rs_SurfaceAttributeSize(pTriMeshData->triangleAttributeTypes[i].attributeType) != 0))
+			hasFaceSurfaces = true;
+	}
+	
+	/*
+	 * Transform the vertex data to world space:
+	 */
+	for (TQ3Uns32 i = 0; i < pTriMeshData->numPoints; i++)
+		Q3Point3D_Transform(&pTriMeshData->points[i],&(rsPrivate->localToWorld),&thePoints[i]);
+	
+	if (theNormalData != NULL)
+	{
+		const TQ3Vector3D	*theVertexNormals = (const TQ3Vector3D *) theNormalData->data;
+		
+		theNormals.resize(pTriMeshData->numPoints);
+		for (TQ3Uns32 i = 0; i < pTriMeshData->numPoints; i++)
+			Q3Vector3D_Transform(&theVertexNormals[i],&(rsPrivate->localToWorld),&theNormals[i]);
+	}
+	
+	if (theUVData != NULL)
+	{
+		const TQ3Param2D	*theVertexParams = (const TQ3Param2D *) theUVData->data;
+		
+		theParams.resize(pTriMeshData->numPoints);
+		for (TQ3Uns32 i = 0; i < pTriMeshData->numPoints; i++)
+			Q3Param2D_Transform(&theVertexParams[i],&rsPrivate->uvTransform,&theParams[i]);
+	}
+	
+	if (hasFaceSurfaces)
+		theStatus = rs_Geometry_TriMeshFaces(pView,rsPrivate,pTriMeshData,&thePoints[0],
+			(theNormalData ? &theNormals[0] : NULL),
+			(theUVData ? &theParams[0] : NULL));
+	else
+		theStatus = RT_SubmitTriMesh(rsPrivate->raytracer,pTriMeshData->numPoints,&thePoints[0],
+			(theNormalData ? &theNormals[0] : NULL),
+			(theUVData ? &theParams[0] : NULL),
+			pTriMeshData->numTriangles,pTriMeshData->triangles);
+	
+exit:
+	rsPrivate->raytracer->currentTexture = savedTexture;
+	return theStatus;
+}
+
 /*===========================================================================*\
  *
  *	Routine	:	RS_Geometry_Marker()
@@ -71,8 +71,10 @@
 	#endif
 #elif defined(WIN32)
 	
+#elif QUESA_OS_UNIX
+	// Only pixmap draw contexts are supported
 #else
-	#error "Only MacOS + Win32 API-s are currently supported!"
+	#error "Only MacOS, Win32 and Unix API-s are currently supported!"
 #endif
 #include "libshade/viewing.h"
 
@@ -178,9 +180,9 @@ TRSRasterizer	*RSRasterizer_Create(
 	theDrawContextType = Q3DrawContext_GetType(theDrawContext);
 
 	if(theData.clearImageMethod == kQ3ClearMethodWithColor){
-		Screen.background.r = theData.clearImageColor.r;
-		Screen.background.g = theData.clearImageColor.g;
-		Screen.background.b = theData.clearImageColor.b;
+		TheScreen.background.r = theData.clearImageColor.r;
+		TheScreen.background.g = theData.clearImageColor.g;
+		TheScreen.background.b = theData.clearImageColor.b;
 	}
 	switch (theDrawContextType)
 	{
@@ -58,6 +58,7 @@
 #endif
 
 
+#include <stdint.h>
 #include <stdlib.h>
 
 #include "RS_Texture.h"
@@ -639,9 +640,9 @@ RS_SetShaderSurface(
 	/*
 	 * Update the texture state otherwise:
 	 */
-	if (!RT_IsTextureDefined(rsPrivate->raytracer,(int)theTexture))
+	if (!RT_IsTextureDefined(rsPrivate->raytracer,(int)(intptr_t)theTexture))
 	{
-		result = RS_DefineTexture(rsPrivate,(int)theTexture,theTexture);
+		result = RS_DefineTexture(rsPrivate,(int)(intptr_t)theTexture,theTexture);
 		if (result != kQ3Success)
 		{
 			RT_SetCurrentTexture(rsPrivate->raytracer,kRTTexture_None);
@@ -651,7 +652,7 @@ RS_SetShaderSurface(
 	/*
 	 * Set the texture to the current one
 	 */
-	result = RT_SetCurrentTexture(rsPrivate->raytracer,(int)theTexture);
+	result = RT_SetCurrentTexture(rsPrivate->raytracer,(int)(intptr_t)theTexture);
 	/*
 	 * Set UV transformation
 	 */
@@ -44,6 +44,8 @@
 //-----------------------------------------------------------------------------
 #include "RSPrefix.h"
 
+#include <chrono>
+
 #include "RT.h"
 #include "RT_Light.h"
 #include "RT_DrawContext.h"
@@ -56,6 +58,7 @@
 #include "libsurf/atmosphere.h"
 #include "libobj/list.h"
 #include "liblight/light.h"
+#include "libobj/bvh.h"
 #include "libobj/grid.h"
 
 #include <stdlib.h>
@@ -106,6 +109,10 @@ TRTDrawContext		*RT_Create(void)
 		
 		theDrawContext->objects = NULL;
 		theDrawContext->currentTexture = NULL;
+		
+		theDrawContext->accelerator = kRTAcceleratorBvh;
+		theDrawContext->buildMicroseconds = 0;
+		theDrawContext->buildBytes = 0;
 	
 		return theDrawContext;
 	}
@@ -133,6 +140,37 @@ RT_Delete(TRTDrawContext *inContext)
 		
 	delete inContext;
 }
+/*===========================================================================*\
+ *
+ *	Routine:	RT_SetAccelerator()
+ *
+ *	Comments:	Selects the structure which encloses the objects of the
+ *				following scenes.
+ *
+\*===========================================================================*/
+void
+RT_SetAccelerator(TRTDrawContext *inContext, TRTAccelerator inAccelerator)
+{
+	if (!inContext)
+		return;
+	
+	inContext->accelerator = inAccelerator;
+}
+/*===========================================================================*\
+ *
+ *	Routine:	RT_GetBuildStats()
+ *
+ *	Comments:	Returns the time taken to build the accelerator of the last
+ *				scene, and the number of bytes it holds.
+ *
+\*===========================================================================*/
+void
+RT_GetBuildStats(TRTDrawContext *inContext,
+			unsigned long long *outMicroseconds, unsigned long *outBytes)
+{
+	*outMicroseconds = inContext ? inContext->buildMicroseconds : 0;
+	*outBytes        = inContext ? inContext->buildBytes : 0;
+}
 /*===========================================================================*\
  *
  *	Routine:	rt_Cleanup()
@@ -236,7 +274,7 @@ rt_Setup(TRTDrawContext * /*inContext*/)
 	Camera.focaldist = UNSET;
 	Camera.aperture = 0.;
 
-	Screen.xres = Screen.yres = UNSET;
+	TheScreen.xres = TheScreen.yres = UNSET;
 
 	Options.cpp = TRUE;
 	Options.maxdepth = MAXDEPTH;
@@ -358,21 +396,27 @@ TQ3Status
 RT_EndScene(TRTDrawContext *inContext)
 {
 	TQ3Status 	theStatus;
-	Geom		*theGrid;
+	Geom		*theAccel;
 	Geom		*theList;
+	std::chrono::steady_clock::time_point	startTime;
 	if (!inContext)
 		return kQ3Failure;
 
 
 	/*
-	 * For efficiency enclose the topmost item into a grid:
+	 * For efficiency enclose the topmost item into a bounding volume
+	 * hierarchy, which adapts to however the objects are distributed.
+	 * The fixed grid is kept so that the two can be compared.
 	 */
-	theGrid = GeomGridCreate(25,25,25);
-	if (!theGrid)
+	if (inContext->accelerator == kRTAcceleratorGrid)
+		theAccel = GeomGridCreate(25,25,25);
+	else
+		theAccel = GeomBvhCreate();
+	if (!theAccel)
 		return kQ3Failure;
-	AggregateConvert(theGrid,inContext->objects);
+	AggregateConvert(theAccel,inContext->objects);
 	
-	inContext->objects = theGrid;
+	inContext->objects = theAccel;
 	
 	/*
 	 * The topmost item should be a list. 
@@ -384,11 +428,20 @@ RT_EndScene(TRTDrawContext *inContext)
 	inContext->objects = theList;
 	
 	/*
-	 * Set the top level object to the world.
+	 * Set the top level object to the world.  Computing the bounds
+	 * builds the accelerator, so time it and measure what it holds.
 	 */
+	startTime = std::chrono::steady_clock::now();
 	GeomComputeBounds(theList);
 	World = theList;
 	
+	inContext->buildMicroseconds = std::chrono::duration_cast<std::chrono::microseconds>(
+						std::chrono::steady_clock::now() - startTime).count();
+	if (inContext->accelerator == kRTAcceleratorGrid)
+		inContext->buildBytes = GridMemory((Grid *)theAccel->obj);
+	else
+		inContext->buildBytes = BvhMemory((Bvh *)theAccel->obj);
+	
 	theStatus = rt_Cleanup(inContext);
 	if (theStatus == kQ3Failure)
 		return kQ3Failure;
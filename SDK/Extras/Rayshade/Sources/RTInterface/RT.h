@@ -58,6 +58,14 @@
  *****************************************************************************/
 typedef struct TRTDrawContext TRTDrawContext;
 
+/*
+ * Structure which encloses the scene's objects.
+ */
+typedef enum TRTAccelerator {
+	kRTAcceleratorBvh			= 0,		/* bounding volume hierarchy */
+	kRTAcceleratorGrid			= 1			/* uniform 25x25x25 grid */
+} TRTAccelerator;
+
 /******************************************************************************
  **																			 **
  **								Functions								     **
@@ -72,6 +80,10 @@ extern TQ3Status RT_BeginScene(TRTDrawContext *inContext);
 
 extern TQ3Status RT_Reset(TRTDrawContext *inContext);
 extern void	RT_Delete(TRTDrawContext *inContext);
+extern void RT_SetAccelerator(TRTDrawContext *inContext,
+			TRTAccelerator inAccelerator);
+extern void RT_GetBuildStats(TRTDrawContext *inContext,
+			unsigned long long *outMicroseconds, unsigned long *outBytes);
 /******************************************************************************
  **																			 **
  **						Camera Functions								     **
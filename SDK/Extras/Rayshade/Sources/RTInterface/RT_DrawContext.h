@@ -69,4 +69,8 @@
  	CTexture				*currentTexture;
  	
 	std::map<int,CTexture*>	definedTextures;
+ 	
+ 	TRTAccelerator			accelerator;
+ 	unsigned long long		buildMicroseconds;	/* last RT_EndScene */
+ 	unsigned long			buildBytes;
  };
\ No newline at end of file
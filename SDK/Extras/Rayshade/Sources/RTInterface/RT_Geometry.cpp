@@ -44,12 +44,15 @@
 //-----------------------------------------------------------------------------
 #include "RSPrefix.h"
 
+#include <float.h>
+#include <vector>
 
 #include "RT_Geometry.h"
 #include "RT_DrawContext.h"
 
 #include "libobj/geom.h"
 #include "libobj/triangle.h"
+#include "libobj/mesh.h"
 #include "libcommon/vector.h"
 
 
@@ -211,3 +214,120 @@ TQ3Status RT_SubmitTriangle(
 	
 	return result;
 }
+/*===========================================================================*\
+ *
+ *	Routine:	RT_SubmitTriMesh()
+ *
+ *	Comments:	Submits an indexed triangle mesh to the RayShade database as
+ *				a single mesh object, rather than an object per triangle.
+ *				Normals and parameters are per vertex, and are optional.
+ *				Degenerate triangles are ignored, as RT_SubmitTriangle
+ *				does.
+ *
+\*===========================================================================*/
+TQ3Status RT_SubmitTriMesh(
+				TRTDrawContext		*inDrawContext,
+				TQ3Uns32			inNumPoints,
+				const TQ3Point3D	*inPoints,
+				const TQ3Vector3D	*inNormals,
+				const TQ3Param2D	*inParams,
+				TQ3Uns32			inNumTriangles,
+				const TQ3TriMeshTriangleData *inTriangles)
+{
+	std::vector<Vector>	theVertices(inNumPoints);
+	std::vector<Vector>	theNormals;
+	std::vector<Vec2d>	theParams;
+	std::vector<int>	theIndices;
+	Geom				*theMesh = NULL;
+	TQ3Status			result;
+	CTexture			*saveCurrentTexture;
+	
+	for (TQ3Uns32 i = 0; i < inNumPoints; i++)
+	{
+		theVertices[i].x = inPoints[i].x;
+		theVertices[i].y = inPoints[i].y;
+		theVertices[i].z = inPoints[i].z;
+	}
+	
+	if (inNormals)
+	{
+		theNormals.resize(inNumPoints);
+		for (TQ3Uns32 i = 0; i < inNumPoints; i++)
+		{
+			theNormals[i].x = inNormals[i].x;
+			theNormals[i].y = inNormals[i].y;
+			theNormals[i].z = inNormals[i].z;
+		}
+	}
+	
+	if (inParams)
+	{
+		theParams.resize(inNumPoints);
+		for (TQ3Uns32 i = 0; i < inNumPoints; i++)
+		{
+			theParams[i].u = inParams[i].u;
+			theParams[i].v = inParams[i].v;
+		}
+	}
+	
+	/*
+	 * Keep the triangles that are neither degenerate nor have a zero
+	 * vertex normal:
+	 */
+	theIndices.reserve(3 * inNumTriangles);
+	for (TQ3Uns32 n = 0; n < inNumTriangles; n++)
+	{
+		const TQ3Uns32	*theTriangle = inTriangles[n].pointIndices;
+		Vector			e[2];
+		Vector			ptmp;
+		
+		if ((theTriangle[0] >= inNumPoints) ||
+			(theTriangle[1] >= inNumPoints) ||
+			(theTriangle[2] >= inNumPoints))
+			return kQ3Failure;
+		
+		VecSub(theVertices[theTriangle[1]], theVertices[theTriangle[0]], &e[0]);
+		VecSub(theVertices[theTriangle[2]], theVertices[theTriangle[1]], &e[1]);
+		VecCross(&e[0], &e[1], &ptmp);
+		if (VecNormalize(&ptmp) < DBL_EPSILON)
+			continue;
+		
+		if (inNormals)
+		{
+			ptmp = theNormals[theTriangle[0]];
+			if (VecNormalize(&ptmp) < DBL_EPSILON)
+				continue;
+			ptmp = theNormals[theTriangle[1]];
+			if (VecNormalize(&ptmp) < DBL_EPSILON)
+				continue;
+			ptmp = theNormals[theTriangle[2]];
+			if (VecNormalize(&ptmp) < DBL_EPSILON)
+				continue;
+		}
+		
+		theIndices.push_back((int) theTriangle[0]);
+		theIndices.push_back((int) theTriangle[1]);
+		theIndices.push_back((int) theTriangle[2]);
+	}
+	
+	if (theIndices.empty())
+		return kQ3Success;
+	
+	theMesh = GeomMeshCreate((int) inNumPoints, &theVertices[0],
+					(inNormals ? &theNormals[0] : NULL),
+					(inParams ? &theParams[0] : NULL),
+					(int) (theIndices.size() / 3),
+					(int (*)[3]) &theIndices[0]);
+	
+	saveCurrentTexture = inDrawContext->currentTexture;
+	if (inParams == NULL)
+		inDrawContext->currentTexture = NULL;
+	
+	result = rt_SubmitGeometry(inDrawContext,theMesh);
+	if (theMesh)
+		theMesh->prims = (int) (theIndices.size() / 3);
+	
+	inDrawContext->currentTexture = saveCurrentTexture;
+	
+	return result;
+}
@@ -45,8 +45,10 @@
 
 #if __MACH__
 	#include <Quesa/Quesa.h>
+	#include <Quesa/QuesaGeometry.h>
 #else
 	#include <Quesa.h>
+	#include <QuesaGeometry.h>
 #endif
 
 #include "RT.h"
@@ -71,5 +73,14 @@ TQ3Status RT_SubmitTriangle(
 				TQ3Vector3D			inNormals[3],
 				TQ3Param2D			inParams[3]);
 
+TQ3Status RT_SubmitTriMesh(
+				TRTDrawContext		*inDrawContext,
+				TQ3Uns32			inNumPoints,
+				const TQ3Point3D	*inPoints,
+				const TQ3Vector3D	*inNormals,
+				const TQ3Param2D	*inParams,
+				TQ3Uns32			inNumTriangles,
+				const TQ3TriMeshTriangleData *inTriangles);
+
 
 #endif	/* _RT_H_ */ 
\ No newline at end of file
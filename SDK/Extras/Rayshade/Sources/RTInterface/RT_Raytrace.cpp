@@ -44,6 +44,9 @@
 //-----------------------------------------------------------------------------
 #include "RSPrefix.h"
 
+#include <atomic>
+#include <thread>
+#include <vector>
 
 #include "RT.h"
 #include "RT_Geometry.h"
@@ -52,11 +55,13 @@
 
 #include "libobj/geom.h"
 #include "libobj/triangle.h"
+#include "liblight/light.h"
 #include "libshade/rayshade.h"
 #include "libshade/picture.h"
 #include "libcommon/sampling.h"
 #include "libshade/options.h"
 #include "libshade/viewing.h"
+#include "libshade/stats.h"
 
 #if defined(Q3_PROFILE) && Q3_PROFILE
 #include <profiler.h>
@@ -73,11 +78,6 @@
 int kRTSamples_Unsampled 			= -1;
 int kRTSamples_Supersampled			= -2;
 
-typedef struct TRTScanline {
-	Pixel		*pixelValues;
-	int			*numberOfSamples;
-} TRTScanline;
-
 typedef struct TRTRayTracer {
 	TRTDrawContext			*drawContext;
 	
@@ -89,17 +89,66 @@ typedef struct TRTRayTracer {
 	int						width;
 	int						height;
 	
-	TRTScanline				scan0;
-	TRTScanline				scan1;
-	TRTScanline				scan2;
+	/*
+	 * The whole image is traced before it is handed out a line at a time,
+	 * so that the lines can be traced in parallel.
+	 */
+	Pixel					*pixelValues;		/* width * height */
+	int						*numberOfSamples;	/* width * height */
+	char					*isHighContrast;	/* width * height */
+	bool					isTraced;
+	
+	/*
+	 * Progress of the trace, in lines.
+	 */
+	TRTProgressMethod		progressMethod;
+	void					*progressData;
+	int						progressLines;
+	int						progressTotal;
+	
+	/*
+	 * Rays spawned by the last trace: eye, shadow, reflected and refracted.
+	 */
+	unsigned long			numRays;
 } TRTRayTracer;
 
+/*
+ * A method tracing or refining the lines [inFirstLine, inEndLine) with
+ * the given top-level ray.  Returns the number of pixels it supersampled.
+ */
+typedef int (*TRTBandMethod)(
+					TRTRayTracer	*inTracer,
+					Ray				*ioRay,
+					int				inFirstLine,
+					int				inEndLine);
+
+/*
+ * State shared by the workers running one pass over the image.
+ */
+typedef struct TRTPass {
+	TRTRayTracer			*tracer;
+	TRTBandMethod			method;
+	bool					isCountingProgress;
+	
+	std::atomic<int>		nextBand;
+	std::atomic<int>		linesDone;
+	std::atomic<int>		numSupersampled;
+	std::atomic<bool>		isCancelled;
+} TRTPass;
+
 /******************************************************************************
  **																			 **
  **								Constants								     **
  **																			 **
  *****************************************************************************/
 
+/*
+ * Lines are handed out to the workers in bands of this many lines.  A band
+ * is small enough to balance the load between the workers, and large enough
+ * that the workers rarely contend for the next one.
+ */
+const int kRTBandHeight		= 4;
+
 /*
  * "Dither matrices" used to encode the 'number' of a ray that samples a
  * particular portion of a pixel.  Hand-coding is ugly, but...
@@ -143,6 +192,23 @@ const int kEightSamples[64] =	{ 8, 58, 59,  5,  4, 62, 63,  1,
 
 
 
+/*===========================================================================*\
+ *
+ *	Routine:	rt_SeedPixel()
+ *
+ *	Comments:	Seeds the random numbers used to sample a pixel, so that the
+ *				samples do not depend on which worker takes them.
+ *
+\*===========================================================================*/
+static void
+rt_SeedPixel(
+			TRTRayTracer		*inTracer,
+			int					xp,
+			int					yp,
+			int					inPass)
+{
+	WorkerSeedRandom(((unsigned long)yp * inTracer->width + xp) * 2 + inPass);
+}
 /*===========================================================================*\
  *
  *	Routine:	rt_FullySamplePixel()
@@ -153,6 +219,7 @@ const int kEightSamples[64] =	{ 8, 58, 59,  5,  4, 62, 63,  1,
 static TQ3Status
 rt_FullySamplePixel(
 			TRTRayTracer		*inTracer,
+			Ray					*ioRay,
 			int					xp,
 			int					yp,
 			Pixel 				*ioPixel,
@@ -192,8 +259,8 @@ rt_FullySamplePixel(
 		ioPixel->alpha 	*= inTracer->sampling.filter[x][y];
 	}
 	
+	rt_SeedPixel(inTracer, xp, yp, 1);
 	theSampleNum = 0;
-	xp += 0;
 	vpos = 0+yp-0.5*inTracer->sampling.filterwidth;
 	for (y = 0; y < inTracer->sampling.sidesamples; 
 					y++, vpos+= inTracer->sampling.filterdelta)
@@ -211,7 +278,7 @@ rt_FullySamplePixel(
 					v = vpos;
 				}
 				
-				SampleScreen(u, v, &inTracer->topRay, &color,
+				SampleScreen(u, v, ioRay, &color,
 					inTracer->sampleNumbers[theSampleNum]);
 				
 				ioPixel->r += color.r*inTracer->sampling.filter[x][y];
@@ -231,67 +298,86 @@ rt_FullySamplePixel(
 }
 /*===========================================================================*\
  *
- *	Routine:	rt_FullySamplePixel()
+ *	Routine:	rt_SingleSamplePixel()
  *
- *	Comments:	Samples a scanline until it's supersampled
+ *	Comments:	Samples a pixel once
  *
 \*===========================================================================*/
 static void
-rt_FullySampleScanline(
-		TRTRayTracer		*inTracer,
-		int 				y, 
-		TRTScanline 		*outScanline)
+rt_SingleSamplePixel(
+				TRTRayTracer		*inTracer,
+				Ray					*ioRay,
+				int					xp,
+				int 				yp,
+				Pixel 				*outPixel,
+				int	 				*outSample)
 {
-	int x;
+	Float upos, vpos;
+	int usamp, vsamp;
 
-	for (x = 0; x < inTracer->width; x++) {
-		outScanline->numberOfSamples[x] = kRTSamples_Unsampled;
-		rt_FullySamplePixel(inTracer,x, y, 
-				&outScanline->pixelValues[x], 
-				&outScanline->numberOfSamples[x]);
+	rt_SeedPixel(inTracer, xp, yp, 0);
+	/*
+	 * Pick a sample number...
+	 */
+	*outSample = nrand() * inTracer->sampling.totsamples;
+	/*
+	 * Take sample corresponding to sample #.
+	 */
+	usamp = *outSample % inTracer->sampling.sidesamples;
+	vsamp = *outSample / inTracer->sampling.sidesamples;
+
+	vpos = yp - 0.5*inTracer->sampling.filterwidth +
+			vsamp * inTracer->sampling.filterdelta;
+	upos = xp - 0.5*inTracer->sampling.filterwidth +
+			usamp*inTracer->sampling.filterdelta;
+	if (Options.jitter) {
+		vpos += nrand()*inTracer->sampling.filterdelta;
+		upos += nrand()*inTracer->sampling.filterdelta;
 	}
+	
+	SampleScreen(upos, vpos, ioRay, outPixel,
+		inTracer->sampleNumbers[*outSample]);
+	if (Options.samplemap)
+		outPixel->alpha = 0;
 }
 /*===========================================================================*\
  *
- *	Routine:	rt_SingleSamplePixel()
+ *	Routine:	rt_SampleBand()
  *
- *	Comments:	Samples a scanline once per pixel
+ *	Comments:	Samples each pixel of a band of lines once.  The top and
+ *				bottom lines and the left and right columns of the image
+ *				are always fully sampled, which minimizes artifacts that
+ *				may arise when piecing together images.
  *
 \*===========================================================================*/
-static void
-rt_SingleSampleScanline(
-				TRTRayTracer		*inTracer,
-				int 				y, 
-				TRTScanline 		*inScanline)
+static int
+rt_SampleBand(
+		TRTRayTracer		*inTracer,
+		Ray					*ioRay,
+		int 				inFirstLine, 
+		int 				inEndLine)
 {
-	Float upos, vpos, yp;
-	int x, usamp, vsamp;
-
-	yp = y - 0.5*inTracer->sampling.filterwidth;
-	for (x = 0; x < inTracer->width; x++) {
-		/*
-		 * Pick a sample number...
-		 */
-		inScanline->numberOfSamples[x] = nrand() * inTracer->sampling.totsamples;
-		/*
-		 * Take sample corresponding to sample #.
-		 */
-		usamp = inScanline->numberOfSamples[x] % inTracer->sampling.sidesamples;
-		vsamp = inScanline->numberOfSamples[x] / inTracer->sampling.sidesamples;
-
-		vpos = yp + vsamp * inTracer->sampling.filterdelta;
-		upos = x - 0.5*inTracer->sampling.filterwidth +
-				usamp*inTracer->sampling.filterdelta;
-		if (Options.jitter) {
-			vpos += nrand()*inTracer->sampling.filterdelta;
-			upos += nrand()*inTracer->sampling.filterdelta;
+	int x, y, i, numSupersampled = 0;
+	bool isEdgeLine;
+
+	for (y = inFirstLine; y < inEndLine; y++) {
+		isEdgeLine = (y == 0) || (y == inTracer->height - 1);
+		for (x = 0; x < inTracer->width; x++) {
+			i = y * inTracer->width + x;
+			if (isEdgeLine || x == 0 || x == inTracer->width - 1) {
+				inTracer->numberOfSamples[i] = kRTSamples_Unsampled;
+				rt_FullySamplePixel(inTracer, ioRay, x, y,
+					&inTracer->pixelValues[i],
+					&inTracer->numberOfSamples[i]);
+				numSupersampled++;
+			}
+			else
+				rt_SingleSamplePixel(inTracer, ioRay, x, y,
+					&inTracer->pixelValues[i],
+					&inTracer->numberOfSamples[i]);
 		}
-		
-		SampleScreen(upos, vpos, &inTracer->topRay,
-			&inScanline->pixelValues[x], inTracer->sampleNumbers[ inScanline->numberOfSamples[x]]);
-		if (Options.samplemap)
-			inScanline->pixelValues[x].alpha = 0;
-	}	
+	}
+	return numSupersampled;
 }
 
 /*===========================================================================*\
@@ -362,81 +448,257 @@ rt_ExcessiveContrast(
 }
 /*===========================================================================*\
  *
- *	Routine:	rt_AdaptiveRefineScanline()
+ *	Routine:	rt_FindContrastBand()
+ *
+ *	Comments:	Marks the pixels of a band of lines whose 4-neighborhood
+ *				has excessive contrast.  The pixels are only read, so the
+ *				marks depend on the image alone, not on the order in which
+ *				the bands are refined.
+ *
+\*===========================================================================*/
+static int
+rt_FindContrastBand(
+		TRTRayTracer	*inTracer,
+		Ray				* /*ioRay*/,
+        int            	inFirstLine, 
+        int            	inEndLine)
+{
+	int x, y;
+	Pixel *scan0, *scan1, *scan2;
+	char *isHighContrast;
+
+	for (y = inFirstLine; y < inEndLine; y++) {
+		isHighContrast = &inTracer->isHighContrast[y * inTracer->width];
+		memset(isHighContrast, 0, inTracer->width);
+		if (y == 0 || y == inTracer->height - 1)
+			continue;
+		
+		scan0 = &inTracer->pixelValues[(y - 1) * inTracer->width];
+		scan1 = &inTracer->pixelValues[y * inTracer->width];
+		scan2 = &inTracer->pixelValues[(y + 1) * inTracer->width];
+		for (x = 1; x < inTracer->width - 1; x++)
+			isHighContrast[x] = rt_ExcessiveContrast(inTracer, x,
+				scan0, scan1, scan2);
+	}
+	return 0;
+}
+/*===========================================================================*\
+ *
+ *	Routine:	rt_RefineBand()
+ *
+ *	Comments:	Supersamples the pixels of a band of lines that are in the
+ *				4-neighborhood of a pixel marked by rt_FindContrastBand.
+ *
+\*===========================================================================*/
+static int
+rt_RefineBand(
+		TRTRayTracer	*inTracer,
+		Ray				*ioRay,
+        int            	inFirstLine, 
+        int            	inEndLine)
+{
+	int x, y, i, width = inTracer->width, numSupersampled = 0;
+	const char *isHighContrast = inTracer->isHighContrast;
+
+	for (y = inFirstLine; y < inEndLine; y++) {
+		for (x = 0; x < width; x++) {
+			i = y * width + x;
+			if (inTracer->numberOfSamples[i] == kRTSamples_Supersampled)
+				continue;
+			if (isHighContrast[i] ||
+				(x > 0 && isHighContrast[i - 1]) ||
+				(x < width - 1 && isHighContrast[i + 1]) ||
+				(y > 0 && isHighContrast[i - width]) ||
+				(y < inTracer->height - 1 && isHighContrast[i + width])) {
+				rt_FullySamplePixel(inTracer, ioRay, x, y,
+					&inTracer->pixelValues[i],
+					&inTracer->numberOfSamples[i]);
+				numSupersampled++;
+			}
+		}
+	}
+	return numSupersampled;
+}
+/*===========================================================================*\
+ *
+ *	Routine:	rt_WorkOnPass()
  *
- *	Comments:	Adaptive refines a scanline until there is no Excessive 
- *				Contrast.
+ *	Comments:	Takes bands of a pass until none are left.  The calling
+ *				thread of RTRayTracer_Trace also reports the progress, and
+ *				cancels the pass if asked to.
  *
 \*===========================================================================*/
 static void
-rt_AdaptiveRefineScanline(
+rt_WorkOnPass(
+		TRTPass			*ioPass,
+		bool			inIsReporting)
+{
+	extern Light *Lights;
+	TRTRayTracer *tracer = ioPass->tracer;
+	Ray theRay = tracer->topRay;	/* SampleScreen writes to the ray */
+	int band, firstLine, endLine, linesDone;
+	
+	while (!ioPass->isCancelled) {
+		band = ioPass->nextBand++;
+		firstLine = band * kRTBandHeight;
+		if (firstLine >= tracer->height)
+			break;
+		endLine = min(firstLine + kRTBandHeight, tracer->height);
+		
+		/*
+		 * Start the band with empty shadow caches, so that its shadows
+		 * do not depend on the bands this worker traced before.
+		 */
+		LightClearCache(Lights);
+		ioPass->numSupersampled += (*ioPass->method)(tracer, &theRay,
+			firstLine, endLine);
+		linesDone = (ioPass->linesDone += endLine - firstLine);
+		
+		if (inIsReporting && tracer->progressMethod != NULL) {
+			if (!ioPass->isCountingProgress)
+				linesDone = 0;
+			if ((*tracer->progressMethod)(tracer->progressData,
+				tracer->progressLines + linesDone,
+				tracer->progressTotal) != kQ3Success)
+				ioPass->isCancelled = true;
+		}
+	}
+}
+/*===========================================================================*\
+ *
+ *	Routine:	rt_RunPass()
+ *
+ *	Comments:	Runs a band method over the whole image, on as many workers
+ *				as Q3SetThreadCount allows.  Returns the number of pixels
+ *				supersampled, or -1 if the pass was cancelled.
+ *
+\*===========================================================================*/
+static int
+rt_RunPass(
 		TRTRayTracer	*inTracer,
-        int            	y, 
-        TRTScanline    	*scan0, 
-        TRTScanline    	*scan1,
-        TRTScanline    	*scan2)
+		TRTBandMethod	inMethod,
+		bool			inIsCountingProgress)
 {
-	int x;
-	bool done;
-
+	TRTPass thePass;
+	std::vector<std::thread> workers;
+	TQ3Uns32 threadCount = 0;
+	int i, numWorkers;
+	
+	thePass.tracer = inTracer;
+	thePass.method = inMethod;
+	thePass.isCountingProgress = inIsCountingProgress;
+	thePass.nextBand = 0;
+	thePass.linesDone = 0;
+	thePass.numSupersampled = 0;
+	thePass.isCancelled = false;
+	
 	/*
-	 * Walk down scan1, looking at 4-neighbors for excessive contrast.
-	 * If found, supersample *all* neighbors not already supersampled.
-	 * The process is repeated until either there are no
-	 * high-contrast regions or all such regions are already supersampled.
+	 * Start the other workers; if a thread cannot be started, its bands
+	 * are taken by the workers that did start.
 	 */
-
-	do {
-		done = true;
-		for (x = 1; x < inTracer->width -1; x++) {
-			/*
-		 	 * Find min and max RGB for area we care about
-			 */
-			if (rt_ExcessiveContrast(inTracer,x, scan0->pixelValues, scan1->pixelValues,
-			    scan2->pixelValues)) {
-				if (scan1->numberOfSamples[x-1] != kRTSamples_Supersampled) {
-					done = false;
-					rt_FullySamplePixel(
-						inTracer,
-						x-1, y,
-						&scan1->pixelValues[x-1],
-						&scan1->numberOfSamples[x-1]);
-				}
-				if (scan0->numberOfSamples[x] != kRTSamples_Supersampled) {
-					done = false;
-					rt_FullySamplePixel(
-						inTracer,
-						x, y-1,
-						&scan0->pixelValues[x],
-						&scan0->numberOfSamples[x]);
-				}
-				if (scan1->numberOfSamples[x+1] != kRTSamples_Supersampled) {
-					done = false;
-					rt_FullySamplePixel(
-						inTracer,
-						x+1, y,
-						&scan1->pixelValues[x+1],
-						&scan1->numberOfSamples[x+1]);
-				}
-				if (scan2->numberOfSamples[x] != kRTSamples_Supersampled) {
-					done = false;
-					rt_FullySamplePixel(
-						inTracer,
-						x, y+1,
-						&scan2->pixelValues[x],
-						&scan2->numberOfSamples[x]);
-				}
-				if (scan1->numberOfSamples[x] != kRTSamples_Supersampled) {
-					done = false;
-					rt_FullySamplePixel(
-						inTracer,
-						x, y,
-						&scan1->pixelValues[x],
-						&scan1->numberOfSamples[x]);
-				}
-			}
-		}
-	} while (!done);
+	numWorkers = WorkerCount();
+	if (Q3GetThreadCount(&threadCount) == kQ3Success && threadCount > 0 &&
+		(int)threadCount < numWorkers)
+		numWorkers = (int)threadCount;
+	numWorkers = min(numWorkers,
+		(inTracer->height + kRTBandHeight - 1) / kRTBandHeight);
+	try
+	{
+		workers.reserve(numWorkers);
+		for (i = 1; i < numWorkers; i++)
+			workers.push_back(std::thread([&thePass, i]()
+			{
+				WorkerSetIndex(i);
+				rt_WorkOnPass(&thePass, false);
+			}));
+	}
+	catch (...)
+	{
+	}
+	
+	rt_WorkOnPass(&thePass, true);
+	
+	for (i = 0; i < (int)workers.size(); i++)
+		workers[i].join();
+	
+	if (thePass.isCancelled)
+		return -1;
+	if (inIsCountingProgress)
+		inTracer->progressLines += inTracer->height;
+	return thePass.numSupersampled;
+}
+/*===========================================================================*\
+ *
+ *	Routine:	rt_CountRays()
+ *
+ *	Comments:	Returns the number of rays spawned so far: eye, shadow,
+ *				reflected and refracted rays.
+ *
+\*===========================================================================*/
+static unsigned long
+rt_CountRays(void)
+{
+	unsigned long eyeRays, shadowRays, shadowHits, cacheHits, cacheMisses;
+	unsigned long hitRays, reflectRays, refractRays;
+	
+	ViewingStats(&eyeRays);
+	ShadowStats(&shadowRays, &shadowHits, &cacheHits, &cacheMisses);
+	ShadeStats(&hitRays, &reflectRays, &refractRays);
+	return eyeRays + shadowRays + reflectRays + refractRays;
+}
+/*===========================================================================*\
+ *
+ *	Routine:	rt_Trace()
+ *
+ *	Comments:	Traces the whole image.  Each pixel is sampled once, then
+ *				pixels are supersampled around those with excessive contrast
+ *				until none remain.  Each round marks the whole image before
+ *				any pixel is refined, so the result is the same for any
+ *				number of workers.
+ *
+ *				The serial tracer marked and refined in one sweep, with a
+ *				window of three lines, so a pixel's contrast could be
+ *				measured against pixels refined earlier in the sweep.
+ *				Marking from the unrefined image can supersample a few
+ *				pixels more or less, so the image differs slightly from
+ *				that of the serial tracer, but not between runs on
+ *				different numbers of workers.
+ *
+\*===========================================================================*/
+static TQ3Status
+rt_Trace(
+		TRTRayTracer	*inTracer)
+{
+	int numSupersampled;
+	bool isFirstRound = true;
+	unsigned long startRays = rt_CountRays();
+	
+	inTracer->progressLines = 0;
+	inTracer->progressTotal = inTracer->height;
+	if (inTracer->sampling.sidesamples > 1)
+		inTracer->progressTotal *= 2;
+	
+	if (rt_RunPass(inTracer, rt_SampleBand, true) < 0)
+		return kQ3Failure;
+	
+	if (inTracer->sampling.sidesamples > 1) {
+		do {
+			if (rt_RunPass(inTracer, rt_FindContrastBand, false) < 0)
+				return kQ3Failure;
+			numSupersampled = rt_RunPass(inTracer, rt_RefineBand,
+				isFirstRound);
+			if (numSupersampled < 0)
+				return kQ3Failure;
+			isFirstRound = false;
+		} while (numSupersampled > 0);
+	}
+	
+	/*
+	 * The workers have exited, so the counts include all their rays.
+	 */
+	inTracer->numRays = rt_CountRays() - startRays;
+	inTracer->isTraced = true;
+	return kQ3Success;
 }
 
 /*===========================================================================*\
@@ -465,8 +727,8 @@ RTRayTracer_Create(
 	 *	
 	 */
 	Options.resolution_set = TRUE;
-	Screen.xres = width;
-	Screen.yres = height;
+	TheScreen.xres = width;
+	TheScreen.yres = height;
 	result->width = width;
 	result->height = height;
    
@@ -520,19 +782,12 @@ RTRayTracer_Create(
 	/*
  	 * Allocate pixel arrays and arrays to store sampling info.
  	 */
-	result->scan0.pixelValues = (Pixel *)malloc(width * sizeof(Pixel));
-	if (!result->scan0.pixelValues)	goto cleanup;
-	result->scan1.pixelValues = (Pixel *)malloc(width * sizeof(Pixel));
-	if (!result->scan1.pixelValues)	goto cleanup;
-	result->scan2.pixelValues = (Pixel *)malloc(width * sizeof(Pixel));
-	if (!result->scan2.pixelValues)	goto cleanup;
-
-	result->scan0.numberOfSamples = (int *)malloc(width * sizeof(int));
-	if (!result->scan0.numberOfSamples)	goto cleanup;
-	result->scan1.numberOfSamples = (int *)malloc(width * sizeof(int));
-	if (!result->scan1.numberOfSamples)	goto cleanup;
-	result->scan2.numberOfSamples = (int *)malloc(width * sizeof(int));
-	if (!result->scan2.numberOfSamples)	goto cleanup;
+	result->pixelValues = (Pixel *)malloc(width * height * sizeof(Pixel));
+	if (!result->pixelValues)	goto cleanup;
+	result->numberOfSamples = (int *)malloc(width * height * sizeof(int));
+	if (!result->numberOfSamples)	goto cleanup;
+	result->isHighContrast = (char *)malloc(width * height);
+	if (!result->isHighContrast)	goto cleanup;
     
     /*
 	 * The top-level ray TopRay always has as its origin the
@@ -544,29 +799,41 @@ RTRayTracer_Create(
 	result->topRay.media = (Medium *)0;
 	result->topRay.depth = 0;
 
-	/*
-	 * Always fully sample the bottom and top rows and the left
-	 * and right column of pixels.  This minimizes artifacts that
-	 * may arise when piecing together images.
-	 */
-	rt_FullySampleScanline(result,0, &result->scan0);		
-	rt_SingleSampleScanline(result,1, &result->scan1);
-	rt_FullySamplePixel(result,0, 1, &result->scan1.pixelValues[0], &result->scan1.numberOfSamples[0]);
-	rt_FullySamplePixel(result,result->width -1, 1, &result->scan1.pixelValues[result->width -1],
-		&result->scan1.numberOfSamples[result->width -1]);
-    	
-
-	
 	return result;
 cleanup:
 	if (result) RTRayTracer_Delete(result);
 	return NULL;
 }
+/*===========================================================================*\
+ *
+ *	Routine:	RTRayTracer_Trace()
+ *
+ *	Comments:	Traces the image on all workers.  The progress method is
+ *				called on the calling thread, and the trace is cancelled
+ *				if it does not return kQ3Success.
+ *
+\*===========================================================================*/
+TQ3Status
+RTRayTracer_Trace(
+					TRTRayTracer 		*inTracer,
+					TRTProgressMethod	inProgress,
+					void				*inProgressData)
+{
+	TQ3Status	theStatus;
+	
+	inTracer->progressMethod = inProgress;
+	inTracer->progressData = inProgressData;
+	theStatus = rt_Trace(inTracer);
+	inTracer->progressMethod = NULL;
+	
+	return theStatus;
+}
 /*===========================================================================*\
  *
  *	Routine:	RTRayTracer_ScanNextLine()
  *
- *	Comments:	Scans the next line.
+ *	Comments:	Returns the next line, tracing the image first if
+ *				RTRayTracer_Trace has not been called.
  *
 \*===========================================================================*/
 TQ3Status
@@ -577,67 +844,45 @@ RTRayTracer_ScanNextLine(
 					int				inBufferSize)
 {
 	int 	i;
-	Pixel	*tmpPixel;
-	int		*tmpSample;
-	int		y;
+	Pixel	*scan;
 	
 	if ( inBufferSize < ( inTracer->width * 4 * sizeof ( TQ3Float32 ) ) )
 		return kQ3Failure;
 	
-	y = inCurrentLine+1;
-	if (1 <= y && y <= inTracer->height)
-	{
-		rt_SingleSampleScanline(inTracer,y+1, &inTracer->scan2);
-		rt_FullySamplePixel(inTracer,0, y+1, &inTracer->scan2.pixelValues[0], 
-											 &inTracer->scan2.numberOfSamples[0]);
-		rt_FullySamplePixel(inTracer,inTracer->width -1, y+1,
-							&inTracer->scan2.pixelValues[inTracer->width -1],
-							&inTracer->scan2.numberOfSamples[inTracer->width -1]);
-		if (inTracer->sampling.sidesamples > 1)
-			rt_AdaptiveRefineScanline(inTracer,y,&inTracer->scan0,&inTracer->scan1,&inTracer->scan2);
-	
-		for (i = 0; i < inTracer->width; i++)
-    	{
-	        outBuffer[i][0] = GAMMACORRECT ( inTracer->scan0.pixelValues[i].r ) ;
-	        outBuffer[i][1] = GAMMACORRECT ( inTracer->scan0.pixelValues[i].g ) ;
-	        outBuffer[i][2] = GAMMACORRECT ( inTracer->scan0.pixelValues[i].b ) ;
-	        outBuffer[i][3] = inTracer->scan0.pixelValues[i].alpha ;
-	    }	
-	    tmpPixel 							= inTracer->scan0.pixelValues;
-	    tmpSample 							= inTracer->scan0.numberOfSamples;
-	    inTracer->scan0.pixelValues 		= inTracer->scan1.pixelValues;
-	    inTracer->scan0.numberOfSamples 	= inTracer->scan1.numberOfSamples;
-	    inTracer->scan1.pixelValues 		= inTracer->scan2.pixelValues;
-	    inTracer->scan1.numberOfSamples 	= inTracer->scan2.numberOfSamples;
-	    inTracer->scan2.pixelValues 		= tmpPixel;
-	    inTracer->scan2.numberOfSamples 	= tmpSample;
-	}
-	else if (y == inTracer->height+1)
+	if (inCurrentLine < 0 || inCurrentLine >= inTracer->height)
+		return kQ3Failure;
+	
+	if (!inTracer->isTraced)
 	{
-		/*
-	     * Supersample last scanline.
-	     */
-	    for (y = 1; y < inTracer->width -1; y++) {
-		    if (inTracer->scan0.numberOfSamples[y] != kRTSamples_Supersampled)
-			   rt_FullySamplePixel(inTracer,y, inTracer->width -1,
-				    &inTracer->scan0.pixelValues[y],
-				    &inTracer->scan0.numberOfSamples[y]);
-	    }
-	    for (i = 0; i < inTracer->width; i++)
-    	{
-	        outBuffer[i][0] = GAMMACORRECT ( inTracer->scan0.pixelValues[i].r ) ;
-	        outBuffer[i][1] = GAMMACORRECT ( inTracer->scan0.pixelValues[i].g ) ;
-	        outBuffer[i][2] = GAMMACORRECT ( inTracer->scan0.pixelValues[i].b ) ;
-	        outBuffer[i][3] = inTracer->scan0.pixelValues[i].alpha ;
-	    }
+		inTracer->progressMethod = NULL;
+		if (rt_Trace(inTracer) != kQ3Success)
+			return kQ3Failure;
 	}
-	else
+	
+	scan = &inTracer->pixelValues[inCurrentLine * inTracer->width];
+	for (i = 0; i < inTracer->width; i++)
 	{
-		return kQ3Failure;
+		outBuffer[i][0] = GAMMACORRECT ( scan[i].r ) ;
+		outBuffer[i][1] = GAMMACORRECT ( scan[i].g ) ;
+		outBuffer[i][2] = GAMMACORRECT ( scan[i].b ) ;
+		outBuffer[i][3] = scan[i].alpha ;
 	}
 	
 	return kQ3Success;
 }
+/*===========================================================================*\
+ *
+ *	Routine:	RTRayTracer_GetRayCount()
+ *
+ *	Comments:	Returns the number of rays spawned by the trace.
+ *
+\*===========================================================================*/
+unsigned long
+RTRayTracer_GetRayCount(
+					const TRTRayTracer	*inTracer)
+{
+	return inTracer->numRays;
+}
 /*===========================================================================*\
  *
  *	Routine:	RTRayTracer_Delete()
@@ -655,18 +900,12 @@ RTRayTracer_Delete(TRTRayTracer *inTracer)
 	ProfilerTerm();
 #endif	
 
-	if (inTracer->scan0.pixelValues) free(inTracer->scan0.pixelValues);
-	if (inTracer->scan1.pixelValues) free(inTracer->scan1.pixelValues);
-	if (inTracer->scan2.pixelValues) free(inTracer->scan2.pixelValues);
-	inTracer->scan0.pixelValues = NULL;
-	inTracer->scan1.pixelValues = NULL;
-	inTracer->scan2.pixelValues = NULL;
-	if (inTracer->scan0.numberOfSamples) free(inTracer->scan0.numberOfSamples);
-	if (inTracer->scan1.numberOfSamples) free(inTracer->scan1.numberOfSamples);
-	if (inTracer->scan2.numberOfSamples) free(inTracer->scan2.numberOfSamples);
-	inTracer->scan0.numberOfSamples = NULL; 
-	inTracer->scan1.numberOfSamples = NULL;
-	inTracer->scan2.numberOfSamples = NULL;
+	if (inTracer->pixelValues) free(inTracer->pixelValues);
+	if (inTracer->numberOfSamples) free(inTracer->numberOfSamples);
+	if (inTracer->isHighContrast) free(inTracer->isHighContrast);
+	inTracer->pixelValues = NULL;
+	inTracer->numberOfSamples = NULL;
+	inTracer->isHighContrast = NULL;
 	
 	free(inTracer);
 
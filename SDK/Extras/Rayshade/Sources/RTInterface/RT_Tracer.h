@@ -58,6 +58,15 @@
  **																			 **
  *****************************************************************************/
 typedef struct TRTRayTracer		TRTRayTracer;
+
+/*
+ * Reports the number of lines traced so far, out of a total; returns
+ * kQ3Success to continue tracing.
+ */
+typedef TQ3Status (*TRTProgressMethod)(
+					void			*inProgressData,
+					int				inCurrent,
+					int				inTotal);
 /******************************************************************************
  **																			 **
  **								Functions								     **
@@ -69,12 +78,21 @@ RTRayTracer_Create(
 					int				width,
 					int				height);
 
+extern TQ3Status
+RTRayTracer_Trace(
+					TRTRayTracer 		*inTracer,
+					TRTProgressMethod	inProgress,
+					void				*inProgressData);
+
 extern TQ3Status
 RTRayTracer_ScanNextLine(
 					TRTRayTracer 	*inTracer,
 					int 			inCurrentLine,
 					TQ3Float32		outBuffer[][4],
 					int				inBufferSize);
+extern unsigned long
+RTRayTracer_GetRayCount(
+					const TRTRayTracer	*inTracer);
 extern void 
 RTRayTracer_Delete(TRTRayTracer		*theTracer);
 
@@ -50,6 +50,7 @@ typedef char * voidstar;
 #include "color.h"
 #include "transform.h"
 #include "error.h"
+#include "worker.h"
 
 #ifndef TRUE
 #define TRUE		1
@@ -87,7 +88,7 @@ typedef char * voidstar;
  * Some systems, such as the RS6000, have fast fabs already defined.
  */
 #ifndef fabs
-extern Float RSabstmp;
+extern thread_local Float RSabstmp;	/* per thread, as images are traced on several */
 #define fabs(x) 		((RSabstmp=x) < 0 ? -RSabstmp : RSabstmp)
 #endif
 
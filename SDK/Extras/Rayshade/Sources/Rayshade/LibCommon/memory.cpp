@@ -27,7 +27,8 @@
 #include <stdlib.h>
 #include <string.h>
 
-unsigned long TotalAllocated;
+static unsigned long AllocatedTotal;
+static thread_local WorkerCounter TotalAllocated(&AllocatedTotal);
 
 voidstar
 Malloc(unsigned int bytes)
@@ -63,7 +64,7 @@ void
 PrintMemoryStats(FILE *fp)
 {
 	fprintf(fp,"Total memory allocated:\t\t%lu bytes\n",
-			TotalAllocated);
+			TotalAllocated.Total());
 }
 
 /*
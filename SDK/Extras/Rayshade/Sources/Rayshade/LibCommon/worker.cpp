@@ -0,0 +1,135 @@
+/*  NAME:
+        worker.cpp
+
+    DESCRIPTION:
+        Per-thread state for tracing an image on several threads.
+
+    COPYRIGHT:
+        Copyright (c) 2026, Quesa Developers. All rights reserved.
+
+        For the current release of Quesa, please see:
+
+            <https://github.com/jwwalker/Quesa>
+        
+        Redistribution and use in source and binary forms, with or without
+        modification, are permitted provided that the following conditions
+        are met:
+        
+            o Redistributions of source code must retain the above copyright
+              notice, this list of conditions and the following disclaimer.
+        
+            o Redistributions in binary form must reproduce the above
+              copyright notice, this list of conditions and the following
+              disclaimer in the documentation and/or other materials provided
+              with the distribution.
+        
+            o Neither the name of Quesa nor the names of its contributors
+              may be used to endorse or promote products derived from this
+              software without specific prior written permission.
+        
+        THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+        "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+        LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+        A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+        OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+        SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+        TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+        PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+        LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+        NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+        SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+    ___________________________________________________________________________
+*/
+
+
+/*
+ * The standard headers come first, before common.h defines min and max.
+ */
+#include <mutex>
+#include <thread>
+
+#include "common.h"
+
+static thread_local int			WorkerNum = 0;
+static thread_local unsigned long long	RandomState = 0x853c49e6748fea9bULL;
+
+static std::mutex	CounterMutex;	/* guards the WorkerCounter totals */
+
+static int
+WorkerCountCompute(void)
+{
+	int count = (int)std::thread::hardware_concurrency();
+
+	if (count < 1)
+		count = 1;	/* unknown */
+	else if (count > MAXWORKERS)
+		count = MAXWORKERS;
+	return count;
+}
+
+int
+WorkerCount(void)
+{
+	static const int count = WorkerCountCompute();
+
+	return count;
+}
+
+int
+WorkerIndex(void)
+{
+	return WorkerNum;
+}
+
+void
+WorkerSetIndex(int index)
+{
+	WorkerNum = index;
+}
+
+/*
+ * Scramble the seed with the SplitMix64 finalizer, so that seeds that
+ * differ in a few low bits, such as neighbouring pixel numbers, start
+ * uncorrelated sequences.
+ */
+void
+WorkerSeedRandom(unsigned long seed)
+{
+	unsigned long long z = (unsigned long long)seed + 0x9e3779b97f4a7c15ULL;
+
+	z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+	z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+	z ^= z >> 31;
+	/*
+	 * xorshift must not be seeded with zero.
+	 */
+	RandomState = z ? z : 0x853c49e6748fea9bULL;
+}
+
+/*
+ * xorshift64* generator; returns a value in [0., 1.).
+ */
+double
+WorkerRandom(void)
+{
+	RandomState ^= RandomState >> 12;
+	RandomState ^= RandomState << 25;
+	RandomState ^= RandomState >> 27;
+	return (double)((RandomState * 0x2545f4914f6cdd1dULL) >> 11) *
+		(1. / 9007199254740992.);
+}
+
+WorkerCounter::~WorkerCounter()
+{
+	std::lock_guard<std::mutex> lock(CounterMutex);
+
+	*total += count;
+}
+
+unsigned long
+WorkerCounter::Total() const
+{
+	std::lock_guard<std::mutex> lock(CounterMutex);
+
+	return *total + count;
+}
@@ -0,0 +1,92 @@
+/*  NAME:
+        worker.h
+
+    DESCRIPTION:
+        Per-thread state for tracing an image on several threads.
+
+    COPYRIGHT:
+        Copyright (c) 2026, Quesa Developers. All rights reserved.
+
+        For the current release of Quesa, please see:
+
+            <https://github.com/jwwalker/Quesa>
+        
+        Redistribution and use in source and binary forms, with or without
+        modification, are permitted provided that the following conditions
+        are met:
+        
+            o Redistributions of source code must retain the above copyright
+              notice, this list of conditions and the following disclaimer.
+        
+            o Redistributions in binary form must reproduce the above
+              copyright notice, this list of conditions and the following
+              disclaimer in the documentation and/or other materials provided
+              with the distribution.
+        
+            o Neither the name of Quesa nor the names of its contributors
+              may be used to endorse or promote products derived from this
+              software without specific prior written permission.
+        
+        THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+        "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+        LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+        A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+        OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+        SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+        TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+        PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+        LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+        NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+        SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+    ___________________________________________________________________________
+*/
+
+
+#ifndef WORKER_H
+#define WORKER_H
+
+/*
+ * Upper limit on the number of threads that trace one image.
+ */
+#define MAXWORKERS	64
+
+/*
+ * Each thread tracing an image is a "worker", numbered from 0 to
+ * WorkerCount()-1.  The thread that sets up the scene is worker 0.
+ * State that cannot be kept in thread-local storage, such as the
+ * shadow caches of the lights, is indexed by WorkerIndex().
+ */
+extern int	WorkerCount(void);
+extern int	WorkerIndex(void);
+extern void	WorkerSetIndex(int index);
+
+/*
+ * Every worker has its own random number generator, used by nrand().
+ * Seeding it before sampling a pixel makes the samples taken for the
+ * pixel independent of which worker takes them, and in what order.
+ */
+extern void	WorkerSeedRandom(unsigned long seed);
+extern double	WorkerRandom(void);
+
+/*
+ * Statistics counter that each worker increments privately, declared
+ * as a static thread_local with a pointer to the shared total.  A
+ * worker's count is added to the total when the worker exits; Total()
+ * also includes the count of the calling thread.
+ */
+class WorkerCounter {
+public:
+			WorkerCounter(unsigned long *total)
+				: total(total), count(0) {}
+			~WorkerCounter();
+
+	void		operator++(int) { count++; }
+	void		operator+=(unsigned long n) { count += n; }
+	unsigned long	Total() const;
+
+private:
+	unsigned long	*total;		/* counts of exited workers */
+	unsigned long	count;		/* count of this worker */
+};
+
+#endif /* WORKER_H */
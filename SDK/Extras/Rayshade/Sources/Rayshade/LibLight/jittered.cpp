@@ -63,13 +63,15 @@ static void
 JitteredDirection(LightRef lr, Vector *pos, Vector* dir,Float *dist)
 {
     Jittered *lp = (Jittered*)lr;
+	Vector curpos;
 	/*
 	 * Choose a location with the area define by corner, e1
-	 * and e2 at which this sample will be taken.
+	 * and e2 at which this sample will be taken.  The location is
+	 * kept local, as several threads may be sampling the light.
 	 */
-	VecAddScaled(lp->pos, nrand(), lp->e1, &lp->curpos);
-	VecAddScaled(lp->curpos, nrand(), lp->e2, &lp->curpos);
-	VecSub(lp->curpos, *pos, dir);
+	VecAddScaled(lp->pos, nrand(), lp->e1, &curpos);
+	VecAddScaled(curpos, nrand(), lp->e2, &curpos);
+	VecSub(curpos, *pos, dir);
 	*dist = VecNormalize(dir);
 }
 static void
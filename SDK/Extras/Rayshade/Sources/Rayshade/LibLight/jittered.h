@@ -26,7 +26,7 @@
 #define LightJitteredCreate(c,p,u,v) LightCreate( \
 			(LightRef)JitteredCreate(p,u,v), JitteredMethods(), c)
 typedef struct {
-	Vector pos, curpos, e1, e2;
+	Vector pos, e1, e2;
 } Jittered;
 
 extern Jittered *JitteredCreate(Vector *pos,Vector* e1,Vector* e2);
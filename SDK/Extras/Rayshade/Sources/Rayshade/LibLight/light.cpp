@@ -22,6 +22,8 @@
  */
 #include "light.h"
 
+#include <string.h>
+
 Light *
 LightCreate(LightRef light, LightMethods *meth, Color *color)
 {
@@ -36,6 +38,7 @@ LightCreate(LightRef light, LightMethods *meth, Color *color)
 	ltmp->color = *color;
 	ltmp->next = (Light *)NULL;
 	ltmp->cache = (ShadowCache *)NULL;
+	ltmp->cachesize = 0;
 	ltmp->shadow = TRUE;
 	return ltmp;
 }
@@ -58,6 +61,24 @@ LightMethodsCreate(void)
 	return (LightMethods *)share_calloc(1, sizeof(LightMethods));
 }
 
+/*
+ * Empty the calling worker's shadow caches of a list of lights.  What a
+ * cache holds depends on the shadow rays traced before, so the image
+ * tracer empties it at the start of each band of lines, which makes the
+ * shadows of a band the same whichever worker traces it.
+ */
+void
+LightClearCache(Light *lights)
+{
+	Light *lp;
+
+	for (lp = lights; lp; lp = lp->next) {
+		if (lp->cache)
+			bzero(lp->cache + WorkerIndex() * lp->cachesize,
+				lp->cachesize * sizeof(ShadowCache));
+	}
+}
+
 /*
  * Compute light color.  Returns FALSE if in full shadow, TRUE otherwise.
  * Computed light color is stored in 'color'.
@@ -70,9 +91,18 @@ LightIntens(
             int             noshadow, 
             Color           *color)
 {
+	ShadowCache *cache;
+
+	/*
+	 * Each worker has its own shadow cache, as the cache is
+	 * updated by every shadow ray.
+	 */
+	cache = lp->cache;
+	if (cache)
+		cache += WorkerIndex() * lp->cachesize;
 	if (lp->methods->intens)
 		return (*lp->methods->intens)(lp->light, &lp->color,
-			lp->cache, ray, dist, noshadow || !lp->shadow, color);
+			cache, ray, dist, noshadow || !lp->shadow, color);
 	RLerror(RL_ABORT, "Cannot compute light intensity!\n");
 	return FALSE;
 }
@@ -87,7 +87,8 @@ typedef struct Light {
 	int shadow;		        
 	LightRef light;		    /* Pointer to light information */
 	LightMethods *methods;	/* Light source methods */
-	ShadowCache *cache;	    /* Shadow cache, if any */
+	ShadowCache *cache;	    /* Shadow cache, if any, for each worker */
+	int cachesize;		    /* # of cache entries for each worker */
 	struct Light *next;	    /* Next light in list */
 } Light;
 
@@ -100,6 +101,7 @@ extern Light	*LightCreate(
 extern void  LightDelete(Light*  inLight);
 
 extern void	LightAllocateCache();
+extern void	LightClearCache(Light *lights);
 extern void LightAddToDefined(Light *light);
 
 extern void LightDeleteDefinedLights();
@@ -32,7 +32,12 @@
  * Shadow stats.
  * External functions have read access via ShadowStats().
  */
-static unsigned long	ShadowRays, ShadowHits, CacheMisses, CacheHits;
+static unsigned long	ShadowRayTotal, ShadowHitTotal, CacheMissTotal,
+			CacheHitTotal;
+static thread_local WorkerCounter	ShadowRays(&ShadowRayTotal),
+			ShadowHits(&ShadowHitTotal),
+			CacheMisses(&CacheMissTotal),
+			CacheHits(&CacheHitTotal);
 /*
  * Options controlling how shadowing information is determined.
  * Set by external modules via ShadowSetOptions().
@@ -233,10 +238,10 @@ Shadowed(
 void
 ShadowStats(unsigned long *shadowrays,unsigned long * shadowhit,unsigned long* cachehit,unsigned long* cachemiss)
 {
-	*shadowrays = ShadowRays;
-	*shadowhit = ShadowHits;
-	*cachehit = CacheHits;
-	*cachemiss = CacheMisses;
+	*shadowrays = ShadowRays.Total();
+	*shadowhit = ShadowHits.Total();
+	*cachehit = CacheHits.Total();
+	*cachemiss = CacheMisses.Total();
 }
 
 void
@@ -29,7 +29,9 @@
 static Methods *iBlobMethods = NULL;
 static char blobName[] = "blob";
 
-unsigned long BlobTests, BlobHits;
+static unsigned long BlobTestTotal, BlobHitTotal;
+static thread_local WorkerCounter BlobTests(&BlobTestTotal),
+	BlobHits(&BlobHitTotal);
 
 static int
 BlobIntersect(GeomRef gref, Ray *ray, Float mindist,Float *maxdist);
@@ -682,8 +684,8 @@ BlobName(void)
 static void
 BlobStats(unsigned long *tests,unsigned long *hits)
 {
-	*tests = BlobTests;
-	*hits = BlobHits;
+	*tests = BlobTests.Total();
+	*hits = BlobHits.Total();
 }
 
 Methods *
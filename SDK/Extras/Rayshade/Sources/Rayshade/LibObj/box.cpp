@@ -26,7 +26,9 @@
 static Methods *iBoxMethods = NULL;
 static char boxName[] = "box";
 
-unsigned long BoxTests, BoxHits;
+static unsigned long BoxTestTotal, BoxHitTotal;
+static thread_local WorkerCounter BoxTests(&BoxTestTotal),
+	BoxHits(&BoxHitTotal);
 
 Box *
 BoxCreate(Vector *v1,Vector* v2)
@@ -119,8 +121,8 @@ BoxName()
 static void
 BoxStats(unsigned long *tests,unsigned long * hits)
 {
-	*tests = BoxTests;
-	*hits = BoxHits;
+	*tests = BoxTests.Total();
+	*hits = BoxHits.Total();
 }
 Methods *
 BoxMethods()
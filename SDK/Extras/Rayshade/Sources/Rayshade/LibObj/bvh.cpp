@@ -0,0 +1,509 @@
+/*  NAME:
+        bvh.cpp
+
+    DESCRIPTION:
+        Bounding volume hierarchy built with the surface area heuristic.
+
+    COPYRIGHT:
+        Copyright (c) 2026, Quesa Developers. All rights reserved.
+
+        For the current release of Quesa, please see:
+
+            <https://github.com/jwwalker/Quesa>
+        
+        Redistribution and use in source and binary forms, with or without
+        modification, are permitted provided that the following conditions
+        are met:
+        
+            o Redistributions of source code must retain the above copyright
+              notice, this list of conditions and the following disclaimer.
+        
+            o Redistributions in binary form must reproduce the above
+              copyright notice, this list of conditions and the following
+              disclaimer in the documentation and/or other materials provided
+              with the distribution.
+        
+            o Neither the name of Quesa nor the names of its contributors
+              may be used to endorse or promote products derived from this
+              software without specific prior written permission.
+        
+        THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+        "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+        LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+        A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+        OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+        SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+        TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+        PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+        LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+        NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+        SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+    ___________________________________________________________________________
+*/
+
+
+#include "geom.h"
+#include "bvh.h"
+
+static Methods *iBvhMethods = NULL;
+static char bvhName[] = "bvh";
+
+#define BVHBINS			16		/* # of bins per axis when splitting */
+#define BVHLEAFSIZE		4		/* most primitives in a leaf */
+#define BVHNODECOST		0.5		/* cost of a node test, relative to a primitive */
+
+static unsigned long BvhTestTotal, BvhHitTotal;
+static thread_local WorkerCounter BvhTests(&BvhTestTotal),
+	BvhHits(&BvhHitTotal);
+
+/*
+ * State of a tree being built.
+ */
+typedef struct {
+	BvhTree	*tree;
+	Float	(*bounds)[2][3];	/* bounding box of each primitive */
+	Float	(*centroid)[3];		/* centre of each bounding box */
+} BvhBuild;
+
+static int BvhBuildNode(BvhBuild *build, int first, int count, int depth);
+static Float BvhArea(Float bounds[2][3]);
+static int BvhIntersect(GeomRef gref, Ray *ray, HitList *hitlist, Float mindist, Float *maxdist);
+static int BvhConvert(GeomRef gref, Geom *objlist);
+static void BvhBounds(GeomRef gref, Float bounds[2][3]);
+static void BvhStats(unsigned long *tests, unsigned long *hits);
+
+/*
+ * Reciprocal of a ray direction, for slab tests.  Components that are
+ * zero are replaced by a very large number of the same sign, so that the
+ * slab test never has to multiply zero by infinity.
+ */
+void
+BvhInverseDir(Vector *dir, Vector *invdir)
+{
+	invdir->x = 1. / (fabs(dir->x) > 1.e-30 ? dir->x :
+			(dir->x < 0. ? -1.e-30 : 1.e-30));
+	invdir->y = 1. / (fabs(dir->y) > 1.e-30 ? dir->y :
+			(dir->y < 0. ? -1.e-30 : 1.e-30));
+	invdir->z = 1. / (fabs(dir->z) > 1.e-30 ? dir->z :
+			(dir->z < 0. ? -1.e-30 : 1.e-30));
+}
+
+/*
+ * Build a tree over "nprims" primitives with the given bounding boxes.
+ * Returns the number of nodes in the tree.
+ */
+int
+BvhTreeBuild(BvhTree *tree, Float (*bounds)[2][3], int nprims)
+{
+	BvhBuild build;
+	int i;
+
+	tree->nodes = (BvhNode *)NULL;
+	tree->prims = (int *)NULL;
+	tree->nnodes = 0;
+	tree->nprims = nprims;
+	if (nprims < 1)
+		return 0;
+
+	/*
+	 * A binary tree with nprims leaves has at most 2*nprims-1 nodes.
+	 */
+	tree->nodes = (BvhNode *)Malloc((2*nprims - 1) * sizeof(BvhNode));
+	tree->prims = (int *)Malloc(nprims * sizeof(int));
+
+	build.tree = tree;
+	build.bounds = bounds;
+	build.centroid = (Float (*)[3])Malloc(nprims * sizeof(Float[3]));
+	for (i = 0; i < nprims; i++) {
+		tree->prims[i] = i;
+		build.centroid[i][X] = 0.5 * (bounds[i][LOW][X] + bounds[i][HIGH][X]);
+		build.centroid[i][Y] = 0.5 * (bounds[i][LOW][Y] + bounds[i][HIGH][Y]);
+		build.centroid[i][Z] = 0.5 * (bounds[i][LOW][Z] + bounds[i][HIGH][Z]);
+	}
+
+	(void)BvhBuildNode(&build, 0, nprims, 0);
+
+	Free((voidstar)build.centroid);
+	return tree->nnodes;
+}
+
+void
+BvhTreeFree(BvhTree *tree)
+{
+	if (tree->nodes)
+		Free((voidstar)tree->nodes);
+	if (tree->prims)
+		Free((voidstar)tree->prims);
+	tree->nodes = (BvhNode *)NULL;
+	tree->prims = (int *)NULL;
+	tree->nnodes = tree->nprims = 0;
+}
+
+/*
+ * Build the node for primitives first .. first+count-1 and the subtree
+ * below it, returning the index of the node.  The primitives are split
+ * where the surface area heuristic says it is cheapest to do so, trying
+ * BVHBINS-1 positions along each axis.  Past half the maximum depth, or
+ * when all the primitives have the same centre, they are simply split in
+ * half, which keeps the depth of the tree within BVHMAXDEPTH.
+ */
+static int
+BvhBuildNode(BvhBuild *build, int first, int count, int depth)
+{
+	BvhTree *tree = build->tree;
+	BvhNode *node;
+	int *prims = tree->prims;
+	Float cbounds[2][3], binbounds[BVHBINS][2][3], rbounds[2][3];
+	Float rarea[BVHBINS], cost, bestcost, scale, bestscale, tmp;
+	int bincount[BVHBINS], rcount[BVHBINS], lcount;
+	int index, i, j, b, axis, bestaxis, bestsplit, mid;
+
+	index = tree->nnodes++;
+	node = &tree->nodes[index];
+
+	BoundsInit(node->bounds);
+	BoundsInit(cbounds);
+	for (i = first; i < first + count; i++) {
+		BoundsEnlarge(node->bounds, build->bounds[prims[i]]);
+		for (j = 0; j < 3; j++) {
+			tmp = build->centroid[prims[i]][j];
+			if (tmp < cbounds[LOW][j])
+				cbounds[LOW][j] = tmp;
+			if (tmp > cbounds[HIGH][j])
+				cbounds[HIGH][j] = tmp;
+		}
+	}
+
+	if (count == 1) {
+		node->index = first;
+		node->count = 1;
+		node->axis = 0;
+		return index;
+	}
+
+	bestaxis = -1;
+	bestsplit = 0;
+	bestscale = 0.;
+	bestcost = FAR_AWAY;
+	for (axis = 0; depth < BVHMAXDEPTH/2 && axis < 3; axis++) {
+		if (cbounds[HIGH][axis] <= cbounds[LOW][axis])
+			continue;
+		scale = BVHBINS / (cbounds[HIGH][axis] - cbounds[LOW][axis]);
+
+		for (b = 0; b < BVHBINS; b++) {
+			bincount[b] = 0;
+			BoundsInit(binbounds[b]);
+		}
+		for (i = first; i < first + count; i++) {
+			b = (int)((build->centroid[prims[i]][axis] -
+					cbounds[LOW][axis]) * scale);
+			if (b >= BVHBINS)
+				b = BVHBINS - 1;
+			bincount[b]++;
+			BoundsEnlarge(binbounds[b], build->bounds[prims[i]]);
+		}
+
+		/*
+		 * Sweep from the right to find the area and count of
+		 * everything at or above each bin...
+		 */
+		BoundsInit(rbounds);
+		rcount[0] = 0;
+		for (b = BVHBINS - 1; b > 0; b--) {
+			if (bincount[b])
+				BoundsEnlarge(rbounds, binbounds[b]);
+			rcount[b] = (b < BVHBINS - 1 ? rcount[b+1] : 0) +
+					bincount[b];
+			rarea[b] = rcount[b] ? BvhArea(rbounds) : 0.;
+		}
+
+		/*
+		 * ...then from the left to find the cost of splitting
+		 * below each bin.
+		 */
+		BoundsInit(rbounds);
+		lcount = 0;
+		for (b = 1; b < BVHBINS; b++) {
+			if (bincount[b-1])
+				BoundsEnlarge(rbounds, binbounds[b-1]);
+			lcount += bincount[b-1];
+			if (lcount == 0 || rcount[b] == 0)
+				continue;
+			cost = lcount * BvhArea(rbounds) + rcount[b] * rarea[b];
+			if (cost < bestcost) {
+				bestcost = cost;
+				bestaxis = axis;
+				bestsplit = b;
+				bestscale = scale;
+			}
+		}
+	}
+
+	if (bestaxis >= 0) {
+		tmp = BvhArea(node->bounds);
+		bestcost = BVHNODECOST + (tmp > 0. ? bestcost / tmp : count);
+		if (count <= BVHLEAFSIZE && count <= bestcost) {
+			node->index = first;
+			node->count = count;
+			node->axis = 0;
+			return index;
+		}
+		/*
+		 * Partition the primitives about the chosen split.
+		 */
+		i = first;
+		j = first + count - 1;
+		while (i <= j) {
+			b = (int)((build->centroid[prims[i]][bestaxis] -
+					cbounds[LOW][bestaxis]) * bestscale);
+			if (b < bestsplit)
+				i++;
+			else {
+				mid = prims[i];
+				prims[i] = prims[j];
+				prims[j--] = mid;
+			}
+		}
+		mid = i - first;
+	} else {
+		if (count <= BVHLEAFSIZE) {
+			node->index = first;
+			node->count = count;
+			node->axis = 0;
+			return index;
+		}
+		/*
+		 * Split in half, visiting the children in order along
+		 * the longest side.
+		 */
+		bestaxis = X;
+		for (axis = Y; axis <= Z; axis++)
+			if (node->bounds[HIGH][axis] - node->bounds[LOW][axis] >
+			    node->bounds[HIGH][bestaxis] - node->bounds[LOW][bestaxis])
+				bestaxis = axis;
+		mid = 0;
+	}
+	if (mid == 0 || mid == count)
+		mid = count / 2;
+
+	node->count = 0;
+	node->axis = bestaxis;
+	/*
+	 * The first child is built next, so it is always index+1.
+	 */
+	(void)BvhBuildNode(build, first, mid, depth + 1);
+	node->index = BvhBuildNode(build, first + mid, count - mid, depth + 1);
+	return index;
+}
+
+static Float
+BvhArea(Float bounds[2][3])
+{
+	Float dx, dy, dz;
+
+	dx = bounds[HIGH][X] - bounds[LOW][X];
+	dy = bounds[HIGH][Y] - bounds[LOW][Y];
+	dz = bounds[HIGH][Z] - bounds[LOW][Z];
+	if (dx < 0. || dy < 0. || dz < 0.)
+		return 0.;
+	return 2. * (dx*dy + dy*dz + dz*dx);
+}
+
+Bvh *
+BvhCreate(void)
+{
+	return (Bvh *)share_calloc(1, sizeof(Bvh));
+}
+
+static void
+BvhDeleteObj(GeomRef inGeomRef)
+{
+	Bvh *bvh = (Bvh *)inGeomRef;
+
+	GeomDeleteEvery(bvh->objects);
+	GeomDeleteEvery(bvh->unbounded);
+	if (bvh->prims)
+		Free((voidstar)bvh->prims);
+	BvhTreeFree(&bvh->tree);
+
+	share_free(bvh);
+}
+
+static char *
+BvhName()
+{
+	return bvhName;
+}
+
+/*
+ * Intersect ray with the objects in the hierarchy.  The nearer child of
+ * each interior node is visited first, so that the ray has usually been
+ * clipped by the time the farther one is popped off the stack.
+ */
+static int
+BvhIntersect(
+		GeomRef			gref,
+		Ray				*ray,
+		HitList			*hitlist,
+		Float			mindist,
+		Float			*maxdist)
+{
+	Bvh *bvh = (Bvh *)gref;
+	Geom *obj;
+	BvhNode *node;
+	Vector invdir;
+	Float entry;
+	int stack[BVHMAXDEPTH], sp, current, dirneg[3], i, hit;
+
+	hit = FALSE;
+	/*
+	 * Check unbounded objects.
+	 */
+	for (obj = bvh->unbounded; obj; obj = obj->next) {
+		if (intersect(obj, ray, hitlist, mindist, maxdist))
+			hit = TRUE;
+	}
+
+	if (bvh->tree.nnodes == 0)
+		return hit;
+
+	BvhInverseDir(&ray->dir, &invdir);
+	dirneg[X] = invdir.x < 0.;
+	dirneg[Y] = invdir.y < 0.;
+	dirneg[Z] = invdir.z < 0.;
+
+	sp = 0;
+	current = 0;
+	for (;;) {
+		node = &bvh->tree.nodes[current];
+		BvhTests++;
+		if (BvhBoundsIntersect(node->bounds, &ray->pos, &invdir,
+				mindist, *maxdist, &entry)) {
+			BvhHits++;
+			if (node->count == 0) {
+				if (dirneg[node->axis]) {
+					stack[sp++] = current + 1;
+					current = node->index;
+				} else {
+					stack[sp++] = node->index;
+					current = current + 1;
+				}
+				continue;
+			}
+			for (i = 0; i < node->count; i++) {
+				if (intersect(bvh->prims[node->index + i], ray,
+						hitlist, mindist, maxdist))
+					hit = TRUE;
+			}
+		}
+		if (sp == 0)
+			break;
+		current = stack[--sp];
+	}
+
+	return hit;
+}
+
+static int
+BvhConvert(GeomRef gref, Geom *objlist)
+{
+	Bvh *bvh = (Bvh *)gref;
+	int num;
+
+	bvh->objects = objlist;
+	for (num = 0; objlist; objlist = objlist->next)
+		num += objlist->prims;
+
+	return num;
+}
+
+/*
+ * Compute the bounds of the objects and (re)build the hierarchy over the
+ * bounded ones.
+ */
+static void
+BvhBounds(GeomRef gref, Float bounds[2][3])
+{
+	Bvh *bvh = (Bvh *)gref;
+	Geom *obj, **objs;
+	Float (*objbounds)[2][3];
+	int num, i;
+
+	bvh->unbounded = GeomComputeAggregateBounds(&bvh->objects,
+				bvh->unbounded, bvh->bounds);
+	BoundsCopy(bvh->bounds, bounds);
+
+	if (bvh->prims)
+		Free((voidstar)bvh->prims);
+	bvh->prims = (Geom **)NULL;
+	BvhTreeFree(&bvh->tree);
+
+	for (num = 0, obj = bvh->objects; obj; obj = obj->next)
+		num++;
+	if (num == 0)
+		return;
+
+	objs = (Geom **)Malloc(num * sizeof(Geom *));
+	objbounds = (Float (*)[2][3])Malloc(num * sizeof(Float[2][3]));
+	for (i = 0, obj = bvh->objects; obj; obj = obj->next, i++) {
+		objs[i] = obj;
+		BoundsCopy(obj->bounds, objbounds[i]);
+	}
+
+	(void)BvhTreeBuild(&bvh->tree, objbounds, num);
+
+	/*
+	 * Store the objects in leaf order so that the objects of a leaf
+	 * are contiguous; the tree's own index array is then not needed.
+	 */
+	bvh->prims = (Geom **)Malloc(num * sizeof(Geom *));
+	for (i = 0; i < num; i++)
+		bvh->prims[i] = objs[bvh->tree.prims[i]];
+	Free((voidstar)bvh->tree.prims);
+	bvh->tree.prims = (int *)NULL;
+
+	Free((voidstar)objbounds);
+	Free((voidstar)objs);
+}
+
+static void
+BvhStats(unsigned long *tests, unsigned long *hits)
+{
+	*tests = BvhTests.Total();
+	*hits = BvhHits.Total();
+}
+
+/*
+ * Return the number of bytes held by the hierarchy and its object array.
+ * The node array is allocated for the largest possible tree.
+ */
+unsigned long
+BvhMemory(Bvh *bvh)
+{
+	unsigned long bytes;
+
+	bytes = sizeof(Bvh);
+	if (bvh->tree.nprims > 0)
+		bytes += (2*bvh->tree.nprims - 1) * sizeof(BvhNode) +
+			bvh->tree.nprims * sizeof(Geom *);
+	return bytes;
+}
+
+Methods *
+BvhMethods()
+{
+	if (iBvhMethods == (Methods *)NULL) {
+		iBvhMethods 						= MethodsCreate();
+		iBvhMethods->methods 				= BvhMethods;
+		iBvhMethods->create 				= (TGeomMethod_Create)BvhCreate;
+		iBvhMethods->intersect.aggregate 	= BvhIntersect;
+		iBvhMethods->name 					= BvhName;
+		iBvhMethods->convert 				= BvhConvert;
+		iBvhMethods->bounds 				= BvhBounds;
+		iBvhMethods->stats 					= BvhStats;
+		iBvhMethods->checkbounds 			= FALSE;
+		iBvhMethods->closed 				= TRUE;
+		iBvhMethods->deleteobj 				= BvhDeleteObj;
+	}
+	return iBvhMethods;
+}
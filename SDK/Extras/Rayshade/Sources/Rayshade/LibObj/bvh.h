@@ -0,0 +1,149 @@
+/*  NAME:
+        bvh.h
+
+    DESCRIPTION:
+        Bounding volume hierarchy built with the surface area heuristic.
+
+    COPYRIGHT:
+        Copyright (c) 2026, Quesa Developers. All rights reserved.
+
+        For the current release of Quesa, please see:
+
+            <https://github.com/jwwalker/Quesa>
+        
+        Redistribution and use in source and binary forms, with or without
+        modification, are permitted provided that the following conditions
+        are met:
+        
+            o Redistributions of source code must retain the above copyright
+              notice, this list of conditions and the following disclaimer.
+        
+            o Redistributions in binary form must reproduce the above
+              copyright notice, this list of conditions and the following
+              disclaimer in the documentation and/or other materials provided
+              with the distribution.
+        
+            o Neither the name of Quesa nor the names of its contributors
+              may be used to endorse or promote products derived from this
+              software without specific prior written permission.
+        
+        THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+        "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+        LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+        A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+        OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+        SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+        TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+        PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+        LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+        NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+        SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+    ___________________________________________________________________________
+*/
+
+
+#ifndef BVH_H
+#define BVH_H
+
+/*
+ * The hierarchy is stored as a flat array of nodes in depth-first order,
+ * so the first child of an interior node is always the node that follows
+ * it and only the index of the second child needs to be recorded.  The
+ * same tree holds the objects of a "bvh" aggregate and the triangles of
+ * a mesh.
+ */
+
+#define GeomBvhCreate()		GeomCreate((GeomRef)BvhCreate(), BvhMethods())
+
+#define BVHMAXDEPTH	64		/* Maximum depth of a tree. */
+
+/*
+ * Tree node
+ */
+typedef struct BvhNode {
+	Float	bounds[2][3];		/* bounding box */
+	int		index;			/* first primitive, or second child */
+	short	count,			/* # of primitives, 0 if interior */
+			axis;			/* split axis of interior node */
+} BvhNode;
+
+/*
+ * Tree
+ */
+typedef struct BvhTree {
+	BvhNode	*nodes;			/* nodes, root first */
+	int		nnodes;
+	int		*prims;			/* primitive indices in leaf order */
+	int		nprims;
+} BvhTree;
+
+/*
+ * Bvh object
+ */
+typedef struct {
+	struct Geom	*objects,		/* bounded objects */
+				*unbounded,		/* unbounded objects */
+				**prims;		/* bounded objects in leaf order */
+	BvhTree		tree;			/* hierarchy over bounded objects */
+	Float		bounds[2][3];	/* bounding box */
+} Bvh;
+
+/*
+ * Does a ray with origin "pos" and reciprocal direction "invdir" pass
+ * through the box between "mindist" and "maxdist"?  If so, return the
+ * distance at which it enters the box.
+ */
+inline int
+BvhBoundsIntersect(
+	Float		bounds[2][3],
+	Vector		*pos,
+	Vector		*invdir,
+	Float		mindist,
+	Float		maxdist,
+	Float		*entry)
+{
+	Float t0, t1, tmp;
+
+	t0 = (bounds[LOW][X] - pos->x) * invdir->x;
+	t1 = (bounds[HIGH][X] - pos->x) * invdir->x;
+	if (t0 > t1) {
+		tmp = t0; t0 = t1; t1 = tmp;
+	}
+	if (t0 > mindist)
+		mindist = t0;
+	if (t1 < maxdist)
+		maxdist = t1;
+
+	t0 = (bounds[LOW][Y] - pos->y) * invdir->y;
+	t1 = (bounds[HIGH][Y] - pos->y) * invdir->y;
+	if (t0 > t1) {
+		tmp = t0; t0 = t1; t1 = tmp;
+	}
+	if (t0 > mindist)
+		mindist = t0;
+	if (t1 < maxdist)
+		maxdist = t1;
+
+	t0 = (bounds[LOW][Z] - pos->z) * invdir->z;
+	t1 = (bounds[HIGH][Z] - pos->z) * invdir->z;
+	if (t0 > t1) {
+		tmp = t0; t0 = t1; t1 = tmp;
+	}
+	if (t0 > mindist)
+		mindist = t0;
+	if (t1 < maxdist)
+		maxdist = t1;
+
+	*entry = mindist;
+	return mindist <= maxdist;
+}
+
+extern void	BvhInverseDir(Vector *dir, Vector *invdir);
+extern int	BvhTreeBuild(BvhTree *tree, Float (*bounds)[2][3], int nprims);
+extern void	BvhTreeFree(BvhTree *tree);
+
+extern Bvh	*BvhCreate(void);
+extern unsigned long BvhMemory(Bvh *bvh);
+extern Methods	*BvhMethods();
+
+#endif /* BVH_H */
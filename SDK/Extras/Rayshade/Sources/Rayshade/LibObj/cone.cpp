@@ -26,7 +26,9 @@
 static Methods *iConeMethods = NULL;
 static char coneName[] = "cone";
 
-unsigned long ConeTests, ConeHits;
+static unsigned long ConeTestTotal, ConeHitTotal;
+static thread_local WorkerCounter ConeTests(&ConeTestTotal),
+	ConeHits(&ConeHitTotal);
 
 Cone *
 ConeCreate(Float br, Vector *bot, Float ar, Vector *apex)
@@ -283,8 +285,8 @@ ConeName()
 static void
 ConeStats(unsigned long *tests,unsigned long * hits)
 {
-	*tests = ConeTests;
-	*hits = ConeHits;
+	*tests = ConeTests.Total();
+	*hits = ConeHits.Total();
 }
 Methods *
 ConeMethods()
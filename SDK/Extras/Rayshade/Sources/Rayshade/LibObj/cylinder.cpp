@@ -26,7 +26,9 @@
 static Methods *iCylinderMethods = NULL;
 static char cylName[] = "cylinder";
 
-unsigned long CylTests, CylHits;
+static unsigned long CylTestTotal, CylHitTotal;
+static thread_local WorkerCounter CylTests(&CylTestTotal),
+	CylHits(&CylHitTotal);
 
 Cylinder *
 CylinderCreate(Float r, Vector *bot,Vector* top)
@@ -206,8 +208,8 @@ CylinderName()
 static void
 CylinderStats(unsigned long *tests,unsigned long * hits)
 {
-	*tests = CylTests;
-	*hits = CylHits;
+	*tests = CylTests.Total();
+	*hits = CylHits.Total();
 }
 Methods *
 CylinderMethods()
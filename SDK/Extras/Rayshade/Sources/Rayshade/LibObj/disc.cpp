@@ -26,7 +26,9 @@
 static Methods *iDiscMethods = NULL;
 static char discName[] = "disc";
 
-unsigned long DiscTests, DiscHits;
+static unsigned long DiscTestTotal, DiscHitTotal;
+static thread_local WorkerCounter DiscTests(&DiscTestTotal),
+	DiscHits(&DiscHitTotal);
 
 Disc *
 DiscCreate(
@@ -180,8 +182,8 @@ DiscName()
 static void
 DiscStats(unsigned long *tests,unsigned long * hits)
 {
-	*tests = DiscTests;
-	*hits = DiscHits;
+	*tests = DiscTests.Total();
+	*hits = DiscHits.Total();
 }
 
 Methods *
@@ -29,8 +29,26 @@
 static Methods *iGridMethods = NULL;
 static char gridName[] = "grid";
 
-static unsigned long raynumber = 1;		/* Current "ray number". */
+/*
+ * Each thread has its own "mailboxes", recording which objects it has
+ * already tested against the ray it is walking through a grid, so that
+ * threads sharing a grid do not overwrite each other's records.  An
+ * object's mailbox is found by hashing its address; if two objects share
+ * a mailbox, one of them may be tested more than once, which is harmless.
+ */
+#define MAILBOXES	256		/* must be a power of two */
+
+typedef struct {
+	Geom		*obj;
+	unsigned long	counter;
+} Mailbox;
+
+static thread_local Mailbox mailboxes[MAILBOXES];
+static thread_local unsigned long raynumber = 1;	/* Current "ray number". */
 										/* (should be "grid number") */
+
+#define MailboxOf(o)	(&mailboxes[(((size_t)(o) >> 4) ^ ((size_t)(o) >> 12)) \
+				& (MAILBOXES - 1)])
 						
 static void	engrid(Geom *obj,Grid *grid);
 
@@ -287,6 +305,7 @@ static int
 CheckVoxel(GeomList *list,Ray *ray,Float *raybounds[2][3],HitList *hitlist,unsigned long counter,Float mindist,Float*maxdist)
 {
 	Geom *obj;
+	Mailbox *box;
 	int hit;
 	Float lx, hx, ly, hy, lz, hz;
 
@@ -301,29 +320,23 @@ CheckVoxel(GeomList *list,Ray *ray,Float *raybounds[2][3],HitList *hitlist,unsig
 
 	do {
 		obj = list->obj;
+		box = MailboxOf(obj);
 		/*
-		 * If object's counter is greater than or equal to the
-		 * number associated with the current grid,
-		 * don't bother checking again.  In addition, if the
-		 * bounding box of the ray's extent in the voxel does
-		 * not intersect the bounding box of the object, don't bother.
+		 * If object's mailbox holds the number associated
+		 * with the current grid, don't bother checking again.
+		 * In addition, if the bounding box of the ray's extent
+		 * in the voxel does not intersect the bounding box of
+		 * the object, don't bother.
 		 */
-#ifdef SHAREDMEM
-		if (*obj->counter < counter &&
-#else
-		if (obj->counter < counter &&
-#endif
+		if ((box->obj != obj || box->counter != counter) &&
 		    obj->bounds[LOW][X] <= hx  &&
 		    obj->bounds[HIGH][X] >= lx &&
 		    obj->bounds[LOW][Y] <= hy  &&
 		    obj->bounds[HIGH][Y] >= ly &&
 		    obj->bounds[LOW][Z] <= hz  &&
 		    obj->bounds[HIGH][Z] >= lz) {
-#ifdef SHAREDMEM
-			*obj->counter = counter;
-#else
-			obj->counter = counter;
-#endif
+			box->obj = obj;
+			box->counter = counter;
 			if (intersect(obj, ray, hitlist, mindist, maxdist))
 				hit = TRUE;
 		}
@@ -424,6 +437,31 @@ GridFreeVoxels(Grid *grid)
 	}
 }
 
+/*
+ * Return the number of bytes held by the grid's voxels and their lists.
+ */
+unsigned long
+GridMemory(Grid *grid)
+{
+	unsigned long bytes;
+	int x, y, z;
+	GeomList *cell;
+
+	bytes = sizeof(Grid);
+	if (grid->cells == (GeomList ****)NULL)
+		return bytes;
+
+	bytes += grid->xsize * sizeof(GeomList ***) +
+		grid->xsize * grid->ysize * sizeof(GeomList **) +
+		grid->xsize * grid->ysize * grid->zsize * sizeof(GeomList *);
+	for (x = 0; x < grid->xsize; x++)
+		for (y = 0; y < grid->ysize; y++)
+			for (z = 0; z < grid->zsize; z++)
+				for (cell = grid->cells[x][y][z]; cell; cell = cell->next)
+					bytes += sizeof(GeomList);
+	return bytes;
+}
+
 Methods *
 GridMethods()
 {
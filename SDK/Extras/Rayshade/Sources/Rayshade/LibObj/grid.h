@@ -55,6 +55,7 @@ extern void	*GirdBounds();
 extern int	 GridConvert();
 
 extern Grid	*GridCreate(int x,int y,int z);
+extern unsigned long GridMemory(Grid *grid);
 
 extern Methods	*GridMethods();
 
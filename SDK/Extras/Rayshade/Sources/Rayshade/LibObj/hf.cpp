@@ -50,7 +50,9 @@ static float minalt(int i,int j,float **hfdata);
 static float maxalt(int i,int j,float **hfdata);
 
 
-unsigned long HFTests, HFHits;
+static unsigned long HFTestTotal, HFHitTotal;
+static thread_local WorkerCounter HFTests(&HFTestTotal),
+	HFHits(&HFHitTotal);
 
 Hf *
 HfCreate(char *filename)
@@ -688,8 +690,8 @@ HfName()
 static void
 HfStats(unsigned long *tests,unsigned long * hits)
 {
-	*tests = HFTests;
-	*hits = HFHits;
+	*tests = HFTests.Total();
+	*hits = HFHits.Total();
 }
 Methods *
 HfMethods()
@@ -27,7 +27,8 @@ static void AddToHitList(HitList *hitlist, Ray *ray, Float mind,Float dist, Geom
  * Number of bounding volume tests.
  * External modules have read access via IntersectStats().
  */
-static unsigned long BVTests;
+static unsigned long BVTestTotal;
+static thread_local WorkerCounter BVTests(&BVTestTotal);
 
 /*
  * Intersect object & ray.  Return distance from "pos" along "ray" to
@@ -90,9 +91,12 @@ intersect(
 		nmaxdist *= distfact;
 	}
 	/*
-	 * Geom has been updated to current time.
+	 * Geom has been updated to current time.  Only store the time
+	 * when it changes, so that threads tracing a still image only
+	 * read the geom.
 	 */
-	obj->timenow = ray->time;
+	if (obj->timenow != ray->time)
+		obj->timenow = ray->time;
 
 	/*
 	 * Call correct intersection routine.
@@ -165,5 +169,5 @@ AddToHitList(HitList *hitlist, Ray *ray, Float mind,Float dist, Geom *obj)
 void
 IntersectStats(unsigned long *bvtests)
 {
-	*bvtests = BVTests;
+	*bvtests = BVTests.Total();
 }
@@ -0,0 +1,544 @@
+/*  NAME:
+        mesh.cpp
+
+    DESCRIPTION:
+        Triangle mesh primitive with shared, indexed vertices.
+
+    COPYRIGHT:
+        Copyright (c) 2026, Quesa Developers. All rights reserved.
+
+        For the current release of Quesa, please see:
+
+            <https://github.com/jwwalker/Quesa>
+        
+        Redistribution and use in source and binary forms, with or without
+        modification, are permitted provided that the following conditions
+        are met:
+        
+            o Redistributions of source code must retain the above copyright
+              notice, this list of conditions and the following disclaimer.
+        
+            o Redistributions in binary form must reproduce the above
+              copyright notice, this list of conditions and the following
+              disclaimer in the documentation and/or other materials provided
+              with the distribution.
+        
+            o Neither the name of Quesa nor the names of its contributors
+              may be used to endorse or promote products derived from this
+              software without specific prior written permission.
+        
+        THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+        "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+        LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+        A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+        OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+        SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+        TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+        PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+        LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+        NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+        SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+    ___________________________________________________________________________
+*/
+
+
+#include "geom.h"
+#include "mesh.h"
+#include "triangle.h"
+
+static Methods *iMeshMethods = NULL;
+static char meshName[] = "mesh";
+
+static unsigned long MeshTestTotal, MeshHitTotal;
+static thread_local WorkerCounter MeshTests(&MeshTestTotal),
+	MeshHits(&MeshHitTotal);
+
+/*
+ * The mesh and triangle of the last hit found by each thread.  The normal
+ * and UV methods are given only the hit point, so they try this triangle
+ * first, and only search the mesh when the point does not lie on it, as
+ * when a shadow ray has hit the mesh since.
+ */
+static thread_local struct {
+	Mesh	*mesh;
+	int	tri;
+} MeshHit = { (Mesh *)NULL, 0 };
+
+static int MeshIntersect(GeomRef gref, Ray *ray, Float mindist, Float *maxdist);
+static Float MeshBarycentric(Mesh *mesh, int i, Vector *pos, Float b[3]);
+static int MeshLocate(Mesh *mesh, Vector *pos, Float b[3]);
+static void MeshFaceNormal(Mesh *mesh, int tri[3], Vector *nrm);
+static int MeshNormal(GeomRef gref, Vector *pos, Vector *nrm, Vector *gnrm);
+static void MeshUV(GeomRef gref, Vector *pos, Vector *norm, Vec2d *uv, Vector *dpdu, Vector *dpdv);
+static void MeshBounds(GeomRef gref, Float bounds[2][3]);
+static void MeshStats(unsigned long *tests, unsigned long *hits);
+
+/*
+ * Create and return reference to a mesh of "ntris" triangles whose
+ * corners index the "npoints" vertices.  Vertex normals and UV
+ * coordinates are optional.  The arrays are copied; triangles should not
+ * be degenerate.
+ */
+Mesh *
+MeshCreate(
+    int         npoints,
+    Vector      *p,
+    Vector      *vnorm,
+    Vec2d       *uv,
+    int         ntris,
+    int         (*tri)[3])
+{
+	Mesh *mesh;
+	Float (*bounds)[2][3], diag[3];
+	int i, j;
+
+	if (npoints < 3 || ntris < 1) {
+		RLerror(RL_ADVISE, "Empty mesh.\n");
+		return (Mesh *)NULL;
+	}
+	for (i = 0; i < ntris; i++) {
+		for (j = 0; j < 3; j++) {
+			if (tri[i][j] < 0 || tri[i][j] >= npoints) {
+				RLerror(RL_WARN, "Invalid mesh vertex index.\n");
+				return (Mesh *)NULL;
+			}
+		}
+	}
+
+	mesh = (Mesh *)share_calloc(sizeof(Mesh), 1);
+	mesh->npoints = npoints;
+	mesh->ntris = ntris;
+
+	mesh->p = (Vector *)Malloc(npoints * sizeof(Vector));
+	for (i = 0; i < npoints; i++)
+		mesh->p[i] = p[i];
+
+	if (vnorm) {
+		mesh->vnorm = (Vector *)Malloc(npoints * sizeof(Vector));
+		for (i = 0; i < npoints; i++) {
+			mesh->vnorm[i] = vnorm[i];
+			(void)VecNormalize(&mesh->vnorm[i]);
+		}
+	}
+
+	if (uv) {
+		mesh->uv = (Vec2d *)Malloc(npoints * sizeof(Vec2d));
+		for (i = 0; i < npoints; i++)
+			mesh->uv[i] = uv[i];
+	}
+
+	/*
+	 * Build the hierarchy, then store the triangles in leaf order.
+	 */
+	bounds = (Float (*)[2][3])Malloc(ntris * sizeof(Float[2][3]));
+	for (i = 0; i < ntris; i++) {
+		BoundsInit(bounds[i]);
+		for (j = 0; j < 3; j++) {
+			Vector *v = &mesh->p[tri[i][j]];
+			if (v->x < bounds[i][LOW][X]) bounds[i][LOW][X] = v->x;
+			if (v->x > bounds[i][HIGH][X]) bounds[i][HIGH][X] = v->x;
+			if (v->y < bounds[i][LOW][Y]) bounds[i][LOW][Y] = v->y;
+			if (v->y > bounds[i][HIGH][Y]) bounds[i][HIGH][Y] = v->y;
+			if (v->z < bounds[i][LOW][Z]) bounds[i][LOW][Z] = v->z;
+			if (v->z > bounds[i][HIGH][Z]) bounds[i][HIGH][Z] = v->z;
+		}
+	}
+	(void)BvhTreeBuild(&mesh->tree, bounds, ntris);
+	Free((voidstar)bounds);
+
+	mesh->tri = (int (*)[3])Malloc(ntris * sizeof(int[3]));
+	for (i = 0; i < ntris; i++) {
+		mesh->tri[i][0] = tri[mesh->tree.prims[i]][0];
+		mesh->tri[i][1] = tri[mesh->tree.prims[i]][1];
+		mesh->tri[i][2] = tri[mesh->tree.prims[i]][2];
+	}
+	Free((voidstar)mesh->tree.prims);
+	mesh->tree.prims = (int *)NULL;
+
+	/*
+	 * Hit points are recomputed from the ray, so allow them to stray
+	 * from the surface by a little more than roundoff.
+	 */
+	for (j = 0; j < 3; j++)
+		diag[j] = mesh->tree.nodes[0].bounds[HIGH][j] -
+				mesh->tree.nodes[0].bounds[LOW][j];
+	mesh->tolerance = EPSILON +
+		1.e-6 * sqrt(diag[X]*diag[X] + diag[Y]*diag[Y] + diag[Z]*diag[Z]);
+
+	return mesh;
+}
+
+static void
+MeshDeleteObj(GeomRef inObj)
+{
+	Mesh *mesh = (Mesh *)inObj;
+
+	if (mesh->p)
+		Free((voidstar)mesh->p);
+	if (mesh->vnorm)
+		Free((voidstar)mesh->vnorm);
+	if (mesh->uv)
+		Free((voidstar)mesh->uv);
+	if (mesh->tri)
+		Free((voidstar)mesh->tri);
+	BvhTreeFree(&mesh->tree);
+	share_free(mesh);
+}
+
+static char *
+MeshName()
+{
+	return meshName;
+}
+
+Methods *
+MeshMethods()
+{
+	if (iMeshMethods == (Methods *)NULL) {
+		iMeshMethods = MethodsCreate();
+		iMeshMethods->create = (TGeomMethod_Create)MeshCreate;
+		iMeshMethods->methods = MeshMethods;
+		iMeshMethods->name = MeshName;
+		iMeshMethods->intersect.normal = MeshIntersect;
+		iMeshMethods->normal = MeshNormal;
+		iMeshMethods->uv = MeshUV;
+		iMeshMethods->bounds = MeshBounds;
+		iMeshMethods->stats = MeshStats;
+		/* The root of the hierarchy is the bounding box. */
+		iMeshMethods->checkbounds = FALSE;
+		iMeshMethods->closed = FALSE;
+		iMeshMethods->deleteobj = MeshDeleteObj;
+	}
+	return iMeshMethods;
+}
+
+/*
+ * Intersect ray with one triangle of the mesh (Moller & Trumbore).
+ */
+static int
+MeshTriangleIntersect(
+    Mesh        *mesh,
+    int         tri[3],
+    Vector      *pos,
+    Vector      *dir,
+    Float       mindist,
+    Float       *maxdist)
+{
+	Vector *p0, e1, e2, pvec, tvec, qvec;
+	Float det, u, v, s;
+
+	MeshTests++;
+	p0 = &mesh->p[tri[0]];
+	VecSub(mesh->p[tri[1]], *p0, &e1);
+	VecSub(mesh->p[tri[2]], *p0, &e2);
+
+	pvec.x = dir->y * e2.z - dir->z * e2.y;
+	pvec.y = dir->z * e2.x - dir->x * e2.z;
+	pvec.z = dir->x * e2.y - dir->y * e2.x;
+	det = dotp(&e1, &pvec);
+	if (det == 0.)
+		return FALSE;
+	det = 1. / det;
+
+	VecSub(*pos, *p0, &tvec);
+	u = dotp(&tvec, &pvec) * det;
+	if (u < 0. || u > 1.)
+		return FALSE;
+
+	qvec.x = tvec.y * e1.z - tvec.z * e1.y;
+	qvec.y = tvec.z * e1.x - tvec.x * e1.z;
+	qvec.z = tvec.x * e1.y - tvec.y * e1.x;
+	v = dotp(dir, &qvec) * det;
+	if (v < 0. || u + v > 1.)
+		return FALSE;
+
+	s = dotp(&e2, &qvec) * det;
+	if (s < mindist || s > *maxdist)
+		return FALSE;
+
+	MeshHits++;
+	*maxdist = s;
+	return TRUE;
+}
+
+/*
+ * Intersect ray with mesh, nearer child of each node first.
+ */
+static int
+MeshIntersect(GeomRef gref, Ray *ray, Float mindist, Float *maxdist)
+{
+	Mesh *mesh = (Mesh *)gref;
+	BvhNode *node;
+	Vector pos, dir, invdir;
+	Float entry;
+	int stack[BVHMAXDEPTH], sp, current, dirneg[3], i, hit;
+
+	pos = ray->pos;
+	dir = ray->dir;
+	BvhInverseDir(&dir, &invdir);
+	dirneg[X] = invdir.x < 0.;
+	dirneg[Y] = invdir.y < 0.;
+	dirneg[Z] = invdir.z < 0.;
+
+	hit = -1;
+	sp = 0;
+	current = 0;
+	for (;;) {
+		node = &mesh->tree.nodes[current];
+		if (BvhBoundsIntersect(node->bounds, &pos, &invdir,
+				mindist, *maxdist, &entry)) {
+			if (node->count == 0) {
+				if (dirneg[node->axis]) {
+					stack[sp++] = current + 1;
+					current = node->index;
+				} else {
+					stack[sp++] = node->index;
+					current = current + 1;
+				}
+				continue;
+			}
+			for (i = node->index; i < node->index + node->count; i++) {
+				if (MeshTriangleIntersect(mesh, mesh->tri[i], &pos,
+						&dir, mindist, maxdist))
+					hit = i;
+			}
+		}
+		if (sp == 0)
+			break;
+		current = stack[--sp];
+	}
+
+	if (hit < 0)
+		return FALSE;
+	MeshHit.mesh = mesh;
+	MeshHit.tri = hit;
+	return TRUE;
+}
+
+/*
+ * Compute the barycentric coordinates of a point in triangle i, and return
+ * how far the point lies off the triangle: its distance from the plane,
+ * plus how far outside the edges it lies, scaled by the size of the
+ * triangle.
+ */
+static Float
+MeshBarycentric(Mesh *mesh, int i, Vector *pos, Float b[3])
+{
+	Vector *p0, e1, e2, vp, n, c;
+	Float nn, out;
+
+	p0 = &mesh->p[mesh->tri[i][0]];
+	VecSub(mesh->p[mesh->tri[i][1]], *p0, &e1);
+	VecSub(mesh->p[mesh->tri[i][2]], *p0, &e2);
+	VecSub(*pos, *p0, &vp);
+	VecCross(&e1, &e2, &n);
+	nn = dotp(&n, &n);
+	if (nn == 0.)
+		return FAR_AWAY;
+	VecCross(&vp, &e2, &c);
+	b[1] = dotp(&n, &c) / nn;
+	VecCross(&e1, &vp, &c);
+	b[2] = dotp(&n, &c) / nn;
+	b[0] = 1. - b[1] - b[2];
+
+	out = 0.;
+	if (-b[0] > out) out = -b[0];
+	if (-b[1] > out) out = -b[1];
+	if (-b[2] > out) out = -b[2];
+	nn = sqrt(nn);
+	return fabs(dotp(&n, &vp)) / nn + out * sqrt(nn);
+}
+
+/*
+ * Find the triangle on which a hit point lies, and the point's barycentric
+ * coordinates in it.  This is the triangle this thread last hit, unless
+ * the point lies off it; then the mesh is searched for the nearest
+ * triangle.  Where the point lies on an edge, either triangle will do.
+ */
+static int
+MeshLocate(Mesh *mesh, Vector *pos, Float b[3])
+{
+	BvhNode *node;
+	Float tol, err, besterr, sum, tb[3];
+	int stack[BVHMAXDEPTH], sp, current, i, best;
+
+	tol = mesh->tolerance;
+	best = 0;
+	besterr = FAR_AWAY;
+	b[0] = 1.;
+	b[1] = b[2] = 0.;
+
+	if (MeshHit.mesh == mesh) {
+		best = MeshHit.tri;
+		besterr = MeshBarycentric(mesh, best, pos, b);
+	}
+
+	sp = 0;
+	current = 0;
+	while (besterr > tol) {
+		node = &mesh->tree.nodes[current];
+		if (pos->x >= node->bounds[LOW][X] - tol &&
+		    pos->x <= node->bounds[HIGH][X] + tol &&
+		    pos->y >= node->bounds[LOW][Y] - tol &&
+		    pos->y <= node->bounds[HIGH][Y] + tol &&
+		    pos->z >= node->bounds[LOW][Z] - tol &&
+		    pos->z <= node->bounds[HIGH][Z] + tol) {
+			if (node->count == 0) {
+				stack[sp++] = node->index;
+				current = current + 1;
+				continue;
+			}
+			for (i = node->index; i < node->index + node->count; i++) {
+				err = MeshBarycentric(mesh, i, pos, tb);
+				if (err < besterr) {
+					besterr = err;
+					best = i;
+					b[0] = tb[0];
+					b[1] = tb[1];
+					b[2] = tb[2];
+				}
+			}
+		}
+		if (sp == 0)
+			break;
+		current = stack[--sp];
+	}
+
+	/*
+	 * Clamp points just outside the triangle onto it.
+	 */
+	for (i = 0; i < 3; i++)
+		if (b[i] < 0.)
+			b[i] = 0.;
+	sum = b[0] + b[1] + b[2];
+	b[0] /= sum;
+	b[1] /= sum;
+	b[2] /= sum;
+
+	return best;
+}
+
+/*
+ * Geometric normal of a triangle.  As for Phong-shaded triangles, it is
+ * flipped if it points away from the normal at the first vertex.
+ */
+static void
+MeshFaceNormal(Mesh *mesh, int tri[3], Vector *nrm)
+{
+	Vector e0, e1;
+
+	VecSub(mesh->p[tri[1]], mesh->p[tri[0]], &e0);
+	VecSub(mesh->p[tri[2]], mesh->p[tri[1]], &e1);
+	VecCross(&e0, &e1, nrm);
+	(void)VecNormalize(nrm);
+	if (mesh->vnorm && dotp(&mesh->vnorm[tri[0]], nrm) < 0.)
+		VecScale(-1., *nrm, nrm);
+}
+
+static int
+MeshNormal(GeomRef gref, Vector *pos, Vector *nrm, Vector *gnrm)
+{
+	Mesh *mesh = (Mesh *)gref;
+	int *tri;
+	Float b[3];
+
+	tri = mesh->tri[MeshLocate(mesh, pos, b)];
+	MeshFaceNormal(mesh, tri, gnrm);
+
+	if (mesh->vnorm == (Vector *)NULL) {
+		*nrm = *gnrm;
+		return FALSE;
+	}
+
+	/*
+	 * Interpolate vertex normals.
+	 */
+	nrm->x = b[0]*mesh->vnorm[tri[0]].x + b[1]*mesh->vnorm[tri[1]].x +
+		b[2]*mesh->vnorm[tri[2]].x;
+	nrm->y = b[0]*mesh->vnorm[tri[0]].y + b[1]*mesh->vnorm[tri[1]].y +
+		b[2]*mesh->vnorm[tri[2]].y;
+	nrm->z = b[0]*mesh->vnorm[tri[0]].z + b[1]*mesh->vnorm[tri[1]].z +
+		b[2]*mesh->vnorm[tri[2]].z;
+	(void)VecNormalize(nrm);
+	return TRUE;
+}
+
+/*
+ * UV coordinates and directions, computed as for a triangle object with
+ * the same vertices.
+ */
+/*ARGSUSED*/
+static void
+MeshUV(GeomRef gref, Vector *pos, Vector * /*norm*/, Vec2d *uv, Vector *dpdu, Vector *dpdv)
+{
+	Mesh *mesh = (Mesh *)gref;
+	int *tri;
+	Float b[3];
+	Vector p[3], e1, ptmp;
+	Vec2d t[3];
+
+	tri = mesh->tri[MeshLocate(mesh, pos, b)];
+
+	if (dpdu) {
+		p[0] = mesh->p[tri[0]];
+		p[1] = mesh->p[tri[1]];
+		p[2] = mesh->p[tri[2]];
+		if (mesh->uv == (Vec2d *)NULL) {
+			/*
+			 * Along the first edge, in the sense a triangle
+			 * object gives it after scaling by the dominant
+			 * part of its normal.
+			 */
+			VecSub(p[1], p[0], dpdu);
+			VecSub(p[2], p[1], &e1);
+			VecCross(dpdu, &e1, &ptmp);
+			if (fabs(ptmp.x) > fabs(ptmp.y) && fabs(ptmp.x) > fabs(ptmp.z)) {
+				if (ptmp.x < 0.)
+					VecScale(-1., *dpdu, dpdu);
+			} else if (fabs(ptmp.y) > fabs(ptmp.z)) {
+				if (ptmp.y < 0.)
+					VecScale(-1., *dpdu, dpdu);
+			} else if (ptmp.z < 0.)
+				VecScale(-1., *dpdu, dpdu);
+			(void)VecNormalize(dpdu);
+			VecSub(p[0], *pos, dpdv);
+			(void)VecNormalize(dpdv);
+		} else {
+			t[0] = mesh->uv[tri[0]];
+			t[1] = mesh->uv[tri[1]];
+			t[2] = mesh->uv[tri[2]];
+			TriangleSetdPdUV(p, t, dpdu, dpdv);
+		}
+	}
+
+	if (mesh->uv == (Vec2d *)NULL) {
+		uv->v = b[2];
+		if (equal(uv->v, 1.))
+			uv->u = 0.;
+		else
+			uv->u = b[1] / (b[0] + b[1]);
+	} else {
+		/*
+		 * Compute UV by taking weighted sum of UV coordinates.
+		 */
+		uv->u = b[0]*mesh->uv[tri[0]].u + b[1]*mesh->uv[tri[1]].u +
+			b[2]*mesh->uv[tri[2]].u;
+		uv->v = b[0]*mesh->uv[tri[0]].v + b[1]*mesh->uv[tri[1]].v +
+			b[2]*mesh->uv[tri[2]].v;
+	}
+}
+
+static void
+MeshBounds(GeomRef gref, Float bounds[2][3])
+{
+	Mesh *mesh = (Mesh *)gref;
+
+	BoundsCopy(mesh->tree.nodes[0].bounds, bounds);
+}
+
+static void
+MeshStats(unsigned long *tests, unsigned long *hits)
+{
+	*tests = MeshTests.Total();
+	*hits = MeshHits.Total();
+}
@@ -0,0 +1,84 @@
+/*  NAME:
+        mesh.h
+
+    DESCRIPTION:
+        Triangle mesh primitive with shared, indexed vertices.
+
+    COPYRIGHT:
+        Copyright (c) 2026, Quesa Developers. All rights reserved.
+
+        For the current release of Quesa, please see:
+
+            <https://github.com/jwwalker/Quesa>
+        
+        Redistribution and use in source and binary forms, with or without
+        modification, are permitted provided that the following conditions
+        are met:
+        
+            o Redistributions of source code must retain the above copyright
+              notice, this list of conditions and the following disclaimer.
+        
+            o Redistributions in binary form must reproduce the above
+              copyright notice, this list of conditions and the following
+              disclaimer in the documentation and/or other materials provided
+              with the distribution.
+        
+            o Neither the name of Quesa nor the names of its contributors
+              may be used to endorse or promote products derived from this
+              software without specific prior written permission.
+        
+        THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+        "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+        LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+        A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+        OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+        SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+        TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+        PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+        LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+        NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+        SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+    ___________________________________________________________________________
+*/
+
+
+
+
+#ifndef MESH_H
+#define MESH_H
+
+#include "bvh.h"
+
+#define GeomMeshCreate(np,p,n,uv,nt,t)	GeomCreate( \
+		(GeomRef)MeshCreate(np,p,n,uv,nt,t), MeshMethods())
+
+/*
+ * Mesh
+ *
+ * A mesh holds each vertex once and describes its triangles by vertex
+ * index, with a bounding volume hierarchy over the triangles.  This takes
+ * far less memory than a triangle object per face, and the whole mesh is
+ * a single object to the aggregate that contains it.
+ */
+typedef struct {
+	int		npoints,		/* # of vertices */
+			ntris;			/* # of triangles */
+	Vector	*p,				/* vertices */
+			*vnorm;			/* vertex normals, NULL if flat shaded */
+	Vec2d	*uv;			/* vertex UV coordinates, or NULL */
+	int		(*tri)[3];		/* vertex indices, in leaf order */
+	Float	tolerance;		/* how far a hit may lie off its triangle */
+	BvhTree	tree;			/* hierarchy over the triangles */
+} Mesh;
+
+extern Mesh	*MeshCreate(
+                    int         npoints,
+                    Vector      *p,
+                    Vector      *vnorm,
+                    Vec2d       *uv,
+                    int         ntris,
+                    int         (*tri)[3]);
+
+extern Methods	*MeshMethods();
+
+#endif /* MESH_H */
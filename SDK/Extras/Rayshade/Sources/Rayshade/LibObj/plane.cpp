@@ -26,7 +26,9 @@
 static Methods *iPlaneMethods = NULL;
 static char planeName[] = "plane";
 
-unsigned long PlaneTests, PlaneHits;
+static unsigned long PlaneTestTotal, PlaneHitTotal;
+static thread_local WorkerCounter PlaneTests(&PlaneTestTotal),
+	PlaneHits(&PlaneHitTotal);
 
 /*
  * create plane primitive
@@ -125,8 +127,8 @@ PlaneName()
 static void
 PlaneStats(unsigned long *tests,unsigned long * hits)
 {
-	*tests = PlaneTests;
-	*hits = PlaneHits;
+	*tests = PlaneTests.Total();
+	*hits = PlaneHits.Total();
 }
 
 Methods *
@@ -32,7 +32,9 @@
 static Methods *iPolygonMethods = NULL;
 static char polyName[] = "polygon";
 
-unsigned long PolyTests, PolyHits;
+static unsigned long PolyTestTotal, PolyHitTotal;
+static thread_local WorkerCounter PolyTests(&PolyTestTotal),
+	PolyHits(&PolyHitTotal);
 
 /*
  * Create a reference to a polygon with vertices equal to those
@@ -308,8 +310,8 @@ PolygonName()
 static void
 PolygonStats(unsigned long *tests,unsigned long * hits)
 {
-	*tests = PolyTests;
-	*hits = PolyHits;
+	*tests = PolyTests.Total();
+	*hits = PolyHits.Total();
 }
 
 Methods *
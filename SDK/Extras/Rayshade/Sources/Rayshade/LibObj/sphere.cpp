@@ -26,7 +26,9 @@
 static Methods *iSphereMethods = NULL;
 static char sphereName[] = "sphere";
 
-unsigned long SphTests, SphHits;
+static unsigned long SphTestTotal, SphHitTotal;
+static thread_local WorkerCounter SphTests(&SphTestTotal),
+	SphHits(&SphHitTotal);
 
 /*
  * Create & return reference to a sphere.
@@ -201,8 +203,8 @@ SphereName()
 static void
 SphereStats(unsigned long *tests,unsigned long* hits)
 {
-	*tests = SphTests;
-	*hits = SphHits;
+	*tests = SphTests.Total();
+	*hits = SphHits.Total();
 }
 
 Methods *
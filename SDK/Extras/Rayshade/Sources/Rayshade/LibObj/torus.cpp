@@ -25,7 +25,9 @@
 
 static Methods *iTorusMethods = NULL;
 static char torusName[] = "torus";
-unsigned long TorusTests, TorusHits;
+static unsigned long TorusTestTotal, TorusHitTotal;
+static thread_local WorkerCounter TorusTests(&TorusTestTotal),
+	TorusHits(&TorusHitTotal);
 
 /*
  * Create & return reference to a torus.
@@ -333,8 +335,8 @@ TorusName()
 static void
 TorusStats(unsigned long *tests, unsigned long *hits)
 {
-	*tests = TorusTests;
-	*hits = TorusHits;
+	*tests = TorusTests.Total();
+	*hits = TorusHits.Total();
 }
 
 Methods *
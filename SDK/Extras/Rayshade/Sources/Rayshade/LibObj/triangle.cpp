@@ -29,10 +29,12 @@
 static Methods *iTriangleMethods = NULL;
 static char triName[] = "triangle";
 
-unsigned long TriTests, TriHits;
+static unsigned long TriTestTotal, TriHitTotal;
+static thread_local WorkerCounter TriTests(&TriTestTotal),
+	TriHits(&TriHitTotal);
 
-static void	TriangleSetdPdUV( Vector p[3], Vec2d t[3], Vector *dpdu, Vector *dpdv);
 static int TriangleIntersect(GeomRef gref, Ray *ray, Float mindist,Float* maxdist);
+static void TriangleBarycentric(Triangle *tri, Vector *pos, Float b[3]);
 static int TriangleNormal(GeomRef gref, Vector *pos,Vector* nrm,Vector* gnrm);
 static void TriangleUV(GeomRef gref, Vector *pos,Vector* norm,Vec2d* uv,Vector* dpdu,Vector* dpdv);
 static void TriangleBounds(GeomRef gref, Float bounds[2][3]);
@@ -278,19 +280,57 @@ TriangleIntersect(GeomRef gref, Ray *ray, Float mindist,Float* maxdist)
 			return FALSE;
 	}
 
-	tri->b[0] = b0;
-	tri->b[1] = b1;
-	tri->b[2] = b2;
-
 	TriHits++;
 	*maxdist = s;
 	return TRUE;
 }
 
+/*
+ * Compute the barycentric coordinates of a point on the triangle, as
+ * TriangleIntersect does.  They are recomputed from the hit position rather
+ * than stored by TriangleIntersect, as several threads may be tracing rays
+ * that hit the same triangle.
+ */
+static void
+TriangleBarycentric(Triangle *tri, Vector *pos, Float b[3])
+{
+	Float qi1, qi2;
+
+	if (tri->index == XNORMAL) {
+		qi1 = pos->y;
+		qi2 = pos->z;
+		b[0] = tri->e[1].y * (qi2 - tri->p[1].z) -
+				tri->e[1].z * (qi1 - tri->p[1].y);
+		b[1] = tri->e[2].y * (qi2 - tri->p[2].z) -
+				tri->e[2].z * (qi1 - tri->p[2].y);
+		b[2] = tri->e[0].y * (qi2 - tri->p[0].z) -
+				tri->e[0].z * (qi1 - tri->p[0].y);
+	} else if (tri->index == YNORMAL) {
+		qi1 = pos->x;
+		qi2 = pos->z;
+		b[0] = tri->e[1].z * (qi1 - tri->p[1].x) -
+			tri->e[1].x * (qi2 - tri->p[1].z);
+		b[1] = tri->e[2].z * (qi1 - tri->p[2].x) -
+			tri->e[2].x * (qi2 - tri->p[2].z);
+		b[2] = tri->e[0].z * (qi1 - tri->p[0].x) -
+			tri->e[0].x * (qi2 - tri->p[0].z);
+	} else {
+		qi1 = pos->x;
+		qi2 = pos->y;
+		b[0] = tri->e[1].x * (qi2 - tri->p[1].y) -
+			tri->e[1].y * (qi1 - tri->p[1].x);
+		b[1] = tri->e[2].x * (qi2 - tri->p[2].y) -
+				tri->e[2].y * (qi1 - tri->p[2].x);
+		b[2] = tri->e[0].x * (qi2 - tri->p[0].y) -
+				tri->e[0].y * (qi1 - tri->p[0].x);
+	}
+}
+
 int
-TriangleNormal(GeomRef gref, Vector * /*pos*/,Vector* nrm,Vector* gnrm)
+TriangleNormal(GeomRef gref, Vector *pos,Vector* nrm,Vector* gnrm)
 {
 	Triangle *tri =(Triangle*)gref;
+	Float b[3];
 	*gnrm = tri->nrm;
 
 	if (tri->type == FLATTRI) {
@@ -301,12 +341,13 @@ TriangleNormal(GeomRef gref, Vector * /*pos*/,Vector* nrm,Vector* gnrm)
 	/*
 	 * Interpolate normals of Phong-shaded triangles.
 	 */
-	nrm->x = tri->b[0]*tri->vnorm[0].x+tri->b[1]*tri->vnorm[1].x+
-		tri->b[2]*tri->vnorm[2].x;
-	nrm->y = tri->b[0]*tri->vnorm[0].y+tri->b[1]*tri->vnorm[1].y+
-		tri->b[2]*tri->vnorm[2].y;
-	nrm->z = tri->b[0]*tri->vnorm[0].z+tri->b[1]*tri->vnorm[1].z+
-		tri->b[2]*tri->vnorm[2].z;
+	TriangleBarycentric(tri, pos, b);
+	nrm->x = b[0]*tri->vnorm[0].x+b[1]*tri->vnorm[1].x+
+		b[2]*tri->vnorm[2].x;
+	nrm->y = b[0]*tri->vnorm[0].y+b[1]*tri->vnorm[1].y+
+		b[2]*tri->vnorm[2].y;
+	nrm->z = b[0]*tri->vnorm[0].z+b[1]*tri->vnorm[1].z+
+		b[2]*tri->vnorm[2].z;
 	(void)VecNormalize(nrm);
 	return TRUE;
 }
@@ -316,16 +357,17 @@ static void
 TriangleUV(GeomRef gref, Vector *pos,Vector* /*norm*/,Vec2d* uv,Vector* dpdu,Vector* dpdv)
 {
 	Triangle *tri = (Triangle*)gref;
-	Float d;
+	Float d, b[3];
 
 	/*
 	 * Normalize barycentric coordinates.
 	 */
-	d = tri->b[0]+tri->b[1]+tri->b[2];
+	TriangleBarycentric(tri, pos, b);
+	d = b[0]+b[1]+b[2];
 
-	tri->b[0] /= d;
-	tri->b[1] /= d; 
-	tri->b[2] /= d;
+	b[0] /= d;
+	b[1] /= d; 
+	b[2] /= d;
 
 	if (dpdu) {
 		if (tri->uv == (Vec2d *)NULL) {
@@ -340,19 +382,19 @@ TriangleUV(GeomRef gref, Vector *pos,Vector* /*norm*/,Vec2d* uv,Vector* dpdu,Vec
 	}
 
 	if (tri->uv == (Vec2d *)NULL) {
-		uv->v = tri->b[2];
+		uv->v = b[2];
 		if (equal(uv->v, 1.))
 			uv->u = 0.;
 		else
-			uv->u = tri->b[1] / (tri->b[0] + tri->b[1]);
+			uv->u = b[1] / (b[0] + b[1]);
 	} else {
 		/*
 		 * Compute UV by taking weighted sum of UV coordinates.
 		 */
-		uv->u = tri->b[0]*tri->uv[0].u + tri->b[1]*tri->uv[1].u +
-			tri->b[2]*tri->uv[2].u;
-		uv->v = tri->b[0]*tri->uv[0].v + tri->b[1]*tri->uv[1].v +
-			tri->b[2]*tri->uv[2].v;
+		uv->u = b[0]*tri->uv[0].u + b[1]*tri->uv[1].u +
+			b[2]*tri->uv[2].u;
+		uv->v = b[0]*tri->uv[0].v + b[1]*tri->uv[1].v +
+			b[2]*tri->uv[2].v;
 	}
 }
 
@@ -389,15 +431,15 @@ TriangleName()
 static void
 TriangleStats(unsigned long *tests,unsigned long* hits)
 {
-	*tests = TriTests;
-	*hits = TriHits;
+	*tests = TriTests.Total();
+	*hits = TriHits.Total();
 }
 
 /*
  * Given three vertices of a triangle and the uv coordinates associated
  * with each, compute directions of u and v axes.
  */
-static void
+void
 TriangleSetdPdUV(
             Vector          p[3],   /* Triangle vertices */
             Vec2d           t[3],   /* uv coordinates for each vertex */
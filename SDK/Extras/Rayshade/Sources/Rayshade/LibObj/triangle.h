@@ -40,8 +40,7 @@ typedef struct {
 		e[3],		/* "edge" vectors (scaled) */
 		*vnorm,		/* Array of vertex normals */
 		*dpdu, *dpdv;	/* U and V direction vectors */
-	Float	d,		/* plane constant  */
-		b[3];		/* Array of barycentric coordinates */
+	Float	d;		/* plane constant  */
 	Vec2d	*uv;		/* Array of UV coordinates of vertices */
 	char	index,		/* Flag used for shading/intersection test. */
 		type;		/* type (to detect if phong or flat) */
@@ -61,6 +60,12 @@ extern Triangle	*TriangleCreate(
                     int         flipflag);
                     
 
+extern void	TriangleSetdPdUV(
+                    Vector      p[3],
+                    Vec2d       t[3],
+                    Vector      *dpdu,
+                    Vector      *dpdv);
+
 extern Methods	*TriangleMethods();
 
 #endif /* TRIANGLE_H */
@@ -89,11 +89,13 @@ LightSetup(void)
 	/*
 	 * Now that we've parsed the input file, we know what
 	 * maxlevel is, and we can allocate the correct amount of
-	 * space for each light source's cache.
+	 * space for each light source's cache, for each worker.
 	 */
 	for (ltmp = Lights; ltmp; ltmp = ltmp->next) {
+		ltmp->cachesize = Options.maxdepth + 1;
 		ltmp->cache = (ShadowCache *)Calloc(
-			(unsigned)Options.maxdepth + 1, sizeof(ShadowCache));
+			(unsigned)(ltmp->cachesize * WorkerCount()),
+			sizeof(ShadowCache));
 	}
 }
 
@@ -41,7 +41,7 @@
 #include "stats.h"
 
 
-Float RSabstmp;	/* Temporary value used by fabs macro.  Ugly. */
+thread_local Float RSabstmp;	/* Temporary value used by fabs macro.  Ugly. */
 static void RSmessage(char *str,char *pat,...);
 
 
@@ -86,7 +86,7 @@ RLmessagev(const char *type, const char *pat,va_list arg_ptr)
 void
 RLerror(int level, const char *pat, ...)
 {
-	va_list arg_ptr=NULL;
+	va_list arg_ptr;
 	
 	va_start(arg_ptr,pat);
 	
@@ -110,15 +110,18 @@ RLerror(int level, const char *pat, ...)
 			RLmessagev("Unknown error", pat, arg_ptr);
 			exit(3);
 	}
+	
+	va_end(arg_ptr);
 }
 
 static void
 RSmessage(char *type,char * pat,...)
 {
-	va_list arg_ptr = NULL;
+	va_list arg_ptr;
 	
 	va_start(arg_ptr,pat);
 	RLmessagev(type,pat,arg_ptr);
+	va_end(arg_ptr);
 }
 		
 #ifdef RUSAGE
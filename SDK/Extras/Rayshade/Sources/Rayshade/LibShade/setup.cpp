@@ -86,7 +86,7 @@ RSSetup()
 	Camera.focaldist = UNSET;
 	Camera.aperture = 0.;
 
-	Screen.xres = Screen.yres = UNSET;
+	TheScreen.xres = TheScreen.yres = UNSET;
 
 	Options.cpp = TRUE;
 	Options.maxdepth = MAXDEPTH;
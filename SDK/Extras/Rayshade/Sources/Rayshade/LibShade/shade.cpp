@@ -32,6 +32,15 @@
 Medium	TopMedium;
 Atmosphere *AtmosEffects;
 
+/*
+ * Ray stats.
+ * External functions have read access via ShadeStats().
+ */
+static unsigned long	HitRayTotal, ReflectRayTotal, RefractRayTotal;
+static thread_local WorkerCounter	HitRays(&HitRayTotal),
+			ReflectRays(&ReflectRayTotal),
+			RefractRays(&RefractRayTotal);
+
 static void
 shade(
         Vector      *pos,       /* hit pos */
@@ -89,7 +98,7 @@ ShadeRay(
 	surf = *stmp;
 	enter = ComputeSurfProps(hitlist, ray, &pos, &norm, &gnorm, &surf,
 			&smooth);
-	Stats.HitRays++;
+	HitRays++;
 
 	/*
 	 * Calculate ray color.
@@ -359,7 +368,7 @@ TransmitRay(
 	 */
 
 	if (!total_int_refl) {
-		Stats.RefractRays++;
+		RefractRays++;
 		hittmp.nodes = 0;
 		dist = FAR_AWAY;
 		TraceRay(&NewRay, &hittmp, EPSILON, &dist);
@@ -407,7 +416,7 @@ ReflectRay(
 	NewRay.sample = ray->sample;
 	NewRay.time = ray->time;
 	NewRay.depth = ray->depth + 1;
-	Stats.ReflectRays++;
+	ReflectRays++;
 	hittmp.nodes = 0;
 	dist = FAR_AWAY;
 	(void)TraceRay(&NewRay, &hittmp, EPSILON, &dist);
@@ -415,3 +424,11 @@ ReflectRay(
 	ColorMultiply(newcol, *intens, &newcol);
 	ColorAdd(*color, newcol, color);
 }
+
+void
+ShadeStats(unsigned long *hitrays,unsigned long *reflectrays,unsigned long *refractrays)
+{
+	*hitrays = HitRays.Total();
+	*reflectrays = ReflectRays.Total();
+	*refractrays = RefractRays.Total();
+}
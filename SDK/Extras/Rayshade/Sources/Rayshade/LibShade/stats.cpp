@@ -41,6 +41,8 @@ StatsPrint()
 	ShadowStats(&Stats.ShadowRays, &Stats.ShadowHits,
 		    &Stats.CacheHits, &Stats.CacheMisses);
 	IntersectStats(&Stats.BVTests);
+	ViewingStats(&Stats.EyeRays);
+	ShadeStats(&Stats.HitRays, &Stats.ReflectRays, &Stats.RefractRays);
 	
 	TotalRays = Stats.EyeRays + Stats.ShadowRays + Stats.ReflectRays
 			 + Stats.RefractRays;
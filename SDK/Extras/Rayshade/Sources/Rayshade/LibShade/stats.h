@@ -50,6 +50,8 @@ extern void OpenStatsFile();
 extern void RSGetCpuTime(Float *usertime,Float *systime);
 extern void ShadowStats(unsigned long *shadowrays,unsigned long * shadowhit,unsigned long* cachehit,unsigned long* cachemiss);
 extern void IntersectStats(unsigned long *bvtests);
+extern void ViewingStats(unsigned long *eyerays);
+extern void ShadeStats(unsigned long *hitrays,unsigned long *reflectrays,unsigned long *refractrays);
 extern void PrintMemoryStats(FILE *fp);
 extern void GeomStats(Geom *obj, unsigned long *tests,unsigned long *hits);
 #endif /* STATS_H */
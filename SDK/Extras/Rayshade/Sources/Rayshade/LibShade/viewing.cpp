@@ -33,7 +33,14 @@
 #include "stats.h"
 
 RSCamera	Camera;
-RSScreen	Screen;
+RSScreen	TheScreen;
+
+/*
+ * # of eye rays.
+ * External functions have read access via ViewingStats().
+ */
+static unsigned long	EyeRayTotal;
+static thread_local WorkerCounter	EyeRays(&EyeRayTotal);
 
 void  SampleScreenFiltered();
 extern void SampleScreen(Float x, Float y,Ray *ray,Pixel *color, int sample);
@@ -46,13 +53,13 @@ RSViewing(void)
 	Float magnitude;
 
 	VecSub(Camera.lookp, Camera.pos, &Camera.dir);
-	Screen.firstray = Camera.dir;
+	TheScreen.firstray = Camera.dir;
 
 	Camera.lookdist = VecNormalize(&Camera.dir);
-	if (VecNormCross(&Camera.dir, &Camera.up, &Screen.scrni) == 0.)
+	if (VecNormCross(&Camera.dir, &Camera.up, &TheScreen.scrni) == 0.)
 		RLerror(RL_PANIC,
 			"The view and up directions are identical?\n");
-	(void)VecNormCross(&Screen.scrni, &Camera.dir, &Screen.scrnj);
+	(void)VecNormCross(&TheScreen.scrni, &Camera.dir, &TheScreen.scrnj);
 
 	/*
 	 * Add stereo separation if desired.
@@ -62,36 +69,36 @@ RSViewing(void)
 			magnitude = -.5 * Options.eyesep;
 		else
 			magnitude =  .5 * Options.eyesep;
-		Camera.pos.x += magnitude * Screen.scrni.x;
-		Camera.pos.y += magnitude * Screen.scrni.y;
-		Camera.pos.z += magnitude * Screen.scrni.z;
-		VecSub(Camera.lookp, Camera.pos, &Screen.firstray);
-		Camera.dir = Screen.firstray;
+		Camera.pos.x += magnitude * TheScreen.scrni.x;
+		Camera.pos.y += magnitude * TheScreen.scrni.y;
+		Camera.pos.z += magnitude * TheScreen.scrni.z;
+		VecSub(Camera.lookp, Camera.pos, &TheScreen.firstray);
+		Camera.dir = TheScreen.firstray;
 		Camera.lookdist = VecNormalize(&Camera.dir);
-		(void)VecNormCross(&Camera.dir, &Camera.up, &Screen.scrni);
-		(void)VecNormCross(&Screen.scrni, &Camera.dir, &Screen.scrnj);
+		(void)VecNormCross(&Camera.dir, &Camera.up, &TheScreen.scrni);
+		(void)VecNormCross(&TheScreen.scrni, &Camera.dir, &TheScreen.scrnj);
 	}
 
 	magnitude = 2.*Camera.lookdist * tan(deg2rad(0.5*Camera.hfov)) /
-				Screen.xres;
+				TheScreen.xres;
 
-	VecScale(magnitude, Screen.scrni, &Screen.scrnx);
+	VecScale(magnitude, TheScreen.scrni, &TheScreen.scrnx);
 	magnitude = 2.*Camera.lookdist * tan(deg2rad(0.5*Camera.vfov)) /
-				Screen.yres;
+				TheScreen.yres;
 #ifndef URT
 	/*
 	 * If using "generic" file format, render top-to-bottom (yick).
 	 */
 	magnitude *= -1;
 #endif
-	VecScale(magnitude, Screen.scrnj, &Screen.scrny);
+	VecScale(magnitude, TheScreen.scrnj, &TheScreen.scrny);
 
-	Screen.firstray.x -= 0.5*Screen.yres*Screen.scrny.x +
-			     0.5*Screen.xres*Screen.scrnx.x;
-	Screen.firstray.y -= 0.5*Screen.yres*Screen.scrny.y +
-			     0.5*Screen.xres*Screen.scrnx.y;
-	Screen.firstray.z -= 0.5*Screen.yres*Screen.scrny.z +
-			     0.5*Screen.xres*Screen.scrnx.z;
+	TheScreen.firstray.x -= 0.5*TheScreen.yres*TheScreen.scrny.x +
+			     0.5*TheScreen.xres*TheScreen.scrnx.x;
+	TheScreen.firstray.y -= 0.5*TheScreen.yres*TheScreen.scrny.y +
+			     0.5*TheScreen.xres*TheScreen.scrnx.y;
+	TheScreen.firstray.z -= 0.5*TheScreen.yres*TheScreen.scrny.z +
+			     0.5*TheScreen.xres*TheScreen.scrnx.z;
 
 	if (Camera.focaldist == UNSET)
 		Camera.focaldist = Camera.lookdist;
@@ -118,8 +125,8 @@ focus_blur_ray(Ray *ray)
 	 * Normalize the ray, and that's it.  Really.
 	 */
 	UnitCirclePoint(&circle_point, ray->sample);
-	VecComb(Camera.aperture * circle_point.x, Screen.scrni,
-		    Camera.aperture * circle_point.y, Screen.scrnj,
+	VecComb(Camera.aperture * circle_point.x, TheScreen.scrni,
+		    Camera.aperture * circle_point.y, TheScreen.scrnj,
 		    &aperture_inc);
 	VecAdd(aperture_inc, Camera.pos, &(ray->pos));
 	VecScale(Camera.focaldist, ray->dir, &(ray->dir));
@@ -148,10 +155,10 @@ ViewingSetup()
 	 * If such variables are not set to legal values on the command
 	 * line or in the input file, we must do it here.
 	 */
-	if (Screen.xres == UNSET)
-		Screen.xres = XRESOLUTION;
-	if (Screen.yres == UNSET)
-		Screen.yres = YRESOLUTION;
+	if (TheScreen.xres == UNSET)
+		TheScreen.xres = XRESOLUTION;
+	if (TheScreen.yres == UNSET)
+		TheScreen.yres = YRESOLUTION;
 
 	/*
 	 * The window to be rendered is defined by applying
@@ -165,8 +172,8 @@ ViewingSetup()
 	if (!Options.window_set) {
 		/* If no window set, set equal to entire screen. */	
 		Options.window[LOW][X] = Options.window[LOW][Y] = 0;
-		Options.window[HIGH][X] = Screen.xres -1;
-		Options.window[HIGH][Y] = Screen.yres -1;
+		Options.window[HIGH][X] = TheScreen.xres -1;
+		Options.window[HIGH][Y] = TheScreen.yres -1;
 	}
 
 	/* Truncate crop window to legal limits. */
@@ -183,20 +190,20 @@ ViewingSetup()
 	ywidth = Options.window[HIGH][Y] - Options.window[LOW][Y];
 
 	/* Compute x and y extents of window to be renered. */
-	Screen.minx = (int)(Options.window[LOW][X] +
+	TheScreen.minx = (int)(Options.window[LOW][X] +
 			Options.crop[LOW][X] * xwidth);
-	Screen.maxx = (int)(Options.window[LOW][X] +
+	TheScreen.maxx = (int)(Options.window[LOW][X] +
 			Options.crop[HIGH][X] * xwidth);
-	Screen.miny = (int)(Options.window[LOW][Y] +
+	TheScreen.miny = (int)(Options.window[LOW][Y] +
 			Options.crop[LOW][Y] * ywidth);
-	Screen.maxy = (int)(Options.window[LOW][Y] +
+	TheScreen.maxy = (int)(Options.window[LOW][Y] +
 			Options.crop[HIGH][Y] * ywidth);
 
 #ifdef URT
 	/*
 	 * If using the URT, we should use the RLE file header to
 	 * determine cropped window size.  Screen size
-	 * (Screen.xres, Screen.yres) is determined from command
+	 * (TheScreen.xres, TheScreen.yres) is determined from command
 	 * line or input file, as usual.
 	 *
 	 * If the cropped window computed in PictureSetWindow()
@@ -211,14 +218,14 @@ ViewingSetup()
 	}
 #endif
 
-	Screen.xsize = Screen.maxx - Screen.minx + 1;
-	Screen.ysize = Screen.maxy - Screen.miny + 1;
+	TheScreen.xsize = TheScreen.maxx - TheScreen.minx + 1;
+	TheScreen.ysize = TheScreen.maxy - TheScreen.miny + 1;
 
 	/*
 	 * Sanity check.
 	 */
-	if (Screen.minx < 0 || Screen.miny < 0 ||
-	    Screen.maxx >= Screen.xres || Screen.maxy >= Screen.yres)
+	if (TheScreen.minx < 0 || TheScreen.miny < 0 ||
+	    TheScreen.maxx >= TheScreen.xres || TheScreen.maxy >= TheScreen.yres)
 		RLerror(RL_PANIC, "Invalid window specification.\n");
 
 	/*
@@ -227,7 +234,7 @@ ViewingSetup()
 	 * probably a bad idea.  ("aspect" option?)
 	 */
 	if (Camera.vfov == UNSET)
-		Camera.vfov = Camera.hfov * Screen.yres / Screen.xres;
+		Camera.vfov = Camera.hfov * TheScreen.yres / TheScreen.xres;
 }
 
 static void
@@ -255,10 +262,10 @@ SampleScreen(
 	/*
 	 * Calculate ray direction.
 	 */
-	Stats.EyeRays++;
-	ray->dir.x = Screen.firstray.x + x*Screen.scrnx.x + y*Screen.scrny.x;
-	ray->dir.y = Screen.firstray.y + x*Screen.scrnx.y + y*Screen.scrny.y;
-	ray->dir.z = Screen.firstray.z + x*Screen.scrnx.z + y*Screen.scrny.z;
+	EyeRays++;
+	ray->dir.x = TheScreen.firstray.x + x*TheScreen.scrnx.x + y*TheScreen.scrny.x;
+	ray->dir.y = TheScreen.firstray.y + x*TheScreen.scrnx.y + y*TheScreen.scrny.y;
+	ray->dir.z = TheScreen.firstray.z + x*TheScreen.scrnx.z + y*TheScreen.scrny.z;
 
 	(void)VecNormalize(&ray->dir);
 
@@ -279,7 +286,7 @@ SampleScreen(
 	dist = FAR_AWAY;
 	hitlist.nodes = 0;
 	(void)TraceRay(ray, &hitlist, EPSILON, &dist);
-	ShadeRay(&hitlist, ray, dist, &Screen.background, &ctmp, &fullintens);
+	ShadeRay(&hitlist, ray, dist, &TheScreen.background, &ctmp, &fullintens);
 	color->r = ctmp.r;
 	color->g = ctmp.g;
 	color->b = ctmp.b;
@@ -289,3 +296,9 @@ SampleScreen(
 		color->alpha = 0.;
 	}
 }
+
+void
+ViewingStats(unsigned long *eyerays)
+{
+	*eyerays = EyeRays.Total();
+}
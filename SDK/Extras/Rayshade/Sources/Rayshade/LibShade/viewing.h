@@ -52,7 +52,7 @@ typedef struct {
 		focaldist;		/* Distance from eye to focal plane */
 } RSCamera;
 
-extern RSScreen Screen;
+extern RSScreen TheScreen;
 extern RSCamera Camera;
 
 extern void ViewingSetup(void);
@@ -46,7 +46,7 @@ SurfaceCreate()
 	stmp->srexp = stmp->stexp = DEFAULT_PHONGPOW;
 	stmp->statten = 1.;	/* No attenuation by default */
 
-	stmp->reflect = stmp->transp = 0.;
+	stmp->reflect = stmp->transp = stmp->translucency = 0.;
 
 	stmp->noshadow = FALSE;
 
@@ -52,11 +52,12 @@
 
 /*
  * Transformation structures used to map from texture space to
- * model/primitive/world space.
+ * model/primitive/world space.  Each thread tracing an image has
+ * its own.
  * 
  * ToDo: Remove these globals....
  */
-static Trans prim2model, model2text, prim2text, world2text;
+static thread_local Trans prim2model, model2text, prim2text, world2text;
 
 #define ApplyMapping(m,o,p,n,c,u,v)	(*(m->method))(m, o, p, n, c, u, v)
 /*===========================================================================*\
@@ -13,7 +13,7 @@
 
 #define BSD		/**/
 
-#if !__MACH__
+#if !__MACH__ && !QUESA_OS_UNIX
 
 /* bzero:
  *	This symbol is maped to memset if the  bzero() routine is not
@@ -93,15 +93,11 @@
 /* seednrand:
  *	This symbol defines the macro to be used in seeding the
  *	random number generator (see nrand).
+ *	Each thread tracing an image has its own generator (see worker.h).
  */
- // modifyed by sauro
-#ifdef __MWERKS__
-#define nrand()		((double)rand() / (double) 32767)
-#else
-	#define nrand()		((double)rand() / (double) 2147483647.0)
-#endif
+#define nrand()		WorkerRandom()
 
-#define seednrand(x)	srand(x)
+#define seednrand(x)	WorkerSeedRandom(x)
 
 /* VOIDFLAGS:
  *	This symbol indicates how much support of the void type is given by this
@@ -601,6 +601,7 @@ enum {
             kQ3RendererTypeOpenGL               = Q3_OBJECT_TYPE('o', 'g', 'l', 'r'),
             kQ3RendererTypeCartoon              = Q3_OBJECT_TYPE('t', 'o', 'o', 'n'),
             kQ3RendererTypeHiddenLine           = Q3_OBJECT_TYPE('h', 'd', 'n', 'l'),
+            kQ3RendererTypeSoftware             = Q3_OBJECT_TYPE('s', 'f', 't', 'r'),
         kQ3SharedTypeShape                      = Q3_OBJECT_TYPE('s', 'h', 'a', 'p'),
             kQ3ShapeTypeGeometry                = Q3_OBJECT_TYPE('g', 'm', 't', 'r'),
                 kQ3GeometryTypeBox              = Q3_OBJECT_TYPE('b', 'o', 'x', ' '),
@@ -708,6 +709,7 @@ enum {
                 kQ3MemoryStorageTypeHandle      = Q3_OBJECT_TYPE('h', 'n', 'd', 'l'),
             kQ3StorageTypePath                  = Q3_OBJECT_TYPE('Q', 's', 't', 'p'),
             kQ3StorageTypeFileStream            = Q3_OBJECT_TYPE('Q', 's', 'f', 's'),
+            kQ3StorageTypeMappedPath            = Q3_OBJECT_TYPE('Q', 's', 'm', 'p'),
             kQ3StorageTypeUnix                  = Q3_OBJECT_TYPE('u', 'x', 's', 't'),
                 kQ3UnixStorageTypePath          = Q3_OBJECT_TYPE('u', 'n', 'i', 'x'),
             kQ3StorageTypeMacintosh             = Q3_OBJECT_TYPE('m', 'a', 'c', 'n'),
@@ -1507,6 +1509,33 @@ typedef struct TQ3SubClassData {
  *		if you have called Q3Initialize twice, you must also call Q3Exit
  *		twice in order for Quesa to really shut down.
  *
+ *		Once Quesa is initialised it may be called from several threads at
+ *		once.  An object, and any objects it contains, must be used by only
+ *		one thread at a time, but independent objects (such as separate views
+ *		with their own draw contexts, renderers and scene graphs) may be
+ *		built, submitted and disposed on different threads at the same time.
+ *
+ *		The exception is the OpenGL renderer.  Its caches of textures and
+ *		buffers are shared between all OpenGL contexts, and on Unix all
+ *		pixmap draw contexts render through one shared EGL context, and
+ *		neither is synchronised.  Every view which renders with OpenGL must
+ *		therefore be used on the same thread, and so must its draw context
+ *		and any objects it has drawn.
+ *
+ *		References to shared objects may be taken and released on any thread,
+ *		with Q3Shared_GetReference and Q3Object_Dispose, and their edit index
+ *		may be read on any thread.  An object can therefore be handed from one
+ *		thread to another, or disposed on a different thread from the one
+ *		which created it.
+ *
+ *		Classes and plug-ins may be registered or unregistered on any thread,
+ *		but not while another thread is using objects of the classes concerned.
+ *		Other classes may be looked up, and their objects created, while a
+ *		class is being registered.  Q3Initialize and Q3Exit must not be called while another thread is
+ *		using Quesa.
+ *
+ *		Error codes are recorded per thread; see Q3Error_Get.
+ *
  *  @result                 Success or failure of the operation.
  */
 Q3_EXTERN_API_C ( TQ3Status  )
@@ -1608,6 +1637,57 @@ Q3GetReleaseVersion (
 
 
 
+/*!
+ *  @function
+ *      Q3SetThreadCount
+ *  @discussion
+ *      Sets the number of threads, including the calling thread, that Quesa
+ *      may use to split up work such as optimizing TriMeshes, rendering with
+ *      the software renderer, or reading files with Q3File_SetReadInParallel.
+ *
+ *      Passing 0 restores the default, the number of hardware threads.
+ *      Passing 1 makes Quesa do everything on the calling thread.
+ *      Must not be called while another thread is using Quesa.
+ *
+ *      <em>This function is not available in QD3D.</em>
+ *
+ *  @param threadCount      The number of threads.
+ *  @result                 Success or failure of the operation.
+ */
+#if QUESA_ALLOW_QD3D_EXTENSIONS
+
+Q3_EXTERN_API_C ( TQ3Status  )
+Q3SetThreadCount (
+    TQ3Uns32                      threadCount
+);
+
+#endif
+
+
+
+/*!
+ *  @function
+ *      Q3GetThreadCount
+ *  @discussion
+ *      Gets the number of threads, including the calling thread, that Quesa
+ *      may use to split up work.
+ *
+ *      <em>This function is not available in QD3D.</em>
+ *
+ *  @param threadCount      Receives the number of threads.
+ *  @result                 Success or failure of the operation.
+ */
+#if QUESA_ALLOW_QD3D_EXTENSIONS
+
+Q3_EXTERN_API_C ( TQ3Status  )
+Q3GetThreadCount (
+    TQ3Uns32                      * _Nonnull threadCount
+);
+
+#endif
+
+
+
 /*!
 	@function
 		Q3LogMessage
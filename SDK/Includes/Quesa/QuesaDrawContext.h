@@ -164,6 +164,7 @@ extern "C" {
  *					Request that a hardware-accelerated pixmap draw context
  *					(see kQ3DrawContextPropertyAcceleratedOffscreen) render multisampled with a
  *					specified number of samples, hardware and driver permitting.
+ *					Also honored by headless (EGL) pixmap draw contexts on Unix.
  *					Set this to 0 for  ordinary non-multisampled rendering.
  *					Data type: TQ3Uns32.  Default: 0.
  *	@constant	kQ3DrawContextPropertyAccelOffscreenIntFormat
@@ -182,6 +183,18 @@ extern "C" {
  *															glFinish before swapping buffers.
  *															Data type: TQ3Boolean.
  *															Default: kQ3False.
+ *	@constant	kQ3DrawContextPropertyGLAsyncReadback
+ *					Number of finished frames whose pixels may still be on their way
+ *					from OpenGL to a pixmap draw context, letting a headless (EGL)
+ *					pixmap context on Unix start the next frame without waiting for
+ *					the readback.  With a value N greater than 0, the pixmap of a frame
+ *					is filled in by the time N more headless pixmap frames have been
+ *					rendered in the process, when Q3View_Sync is called, or when the
+ *					renderer's OpenGL context is rebuilt or disposed.  Until then the
+ *					pixmap memory must remain valid, even if the draw context has been
+ *					given a different pixmap.  The value is clamped to 8.
+ *					Data type: TQ3Uns32.  Default: 0 (the pixmap is complete when
+ *					Q3View_EndRendering returns).
  *	@constant	kQ3DrawContextPropertyNSOpenGLContext		In the case of a Cocoa draw context, this
  *					is the NSOpenGLContext object associated with the context and its view.  
  *					Preferably, the view is an instance of a subclass of NSOpenGLView, and owns an
@@ -206,6 +219,7 @@ enum {
 	kQ3DrawContextPropertyGLPixelFormat             = Q3_OBJECT_TYPE('g', 'l', 'p', 'f'),
 	kQ3DrawContextPropertyGLDestroyCallback         = Q3_OBJECT_TYPE('g', 'l', 'd', 'c'),
 	kQ3DrawContextPropertyGLFinishBeforeSwap        = Q3_OBJECT_TYPE('f', 'i', 'b', 's'),
+	kQ3DrawContextPropertyGLAsyncReadback           = Q3_OBJECT_TYPE('g', 'l', 'a', 'r'),
 	kQ3DrawContextPropertyNSOpenGLContext           = Q3_OBJECT_TYPE('n', 's', 'o', 'g'),
 	kQ3DrawContextPropertyTypeSize32                = 0xFFFFFFFF
 };
@@ -898,6 +912,11 @@ Q3GenericDrawContext_New (
  *  @discussion
  *      Create a new Pixmap draw context object.
  *
+ *      On Unix, the OpenGL renderer draws every pixmap draw context through
+ *      one headless (EGL) OpenGL context, which can only be used by one
+ *      thread.  Views that render to pixmap draw contexts with the OpenGL
+ *      renderer must therefore all be rendered on the same thread.
+ *
  *  @param contextData      The data for the pixmap draw context object.
  *  @result                 The new draw context object.
  */
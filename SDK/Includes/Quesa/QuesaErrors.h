@@ -606,6 +606,9 @@ typedef Q3_CALLBACK_API_C(void,                TQ3NoticeMethod)(
  *      called when Quesa detects an error condition that it can't handle.
  *		Your callback should not call Quesa except for Error Manager routines.
  *
+ *		The callback is shared by all threads, and is invoked on the thread
+ *		whose Quesa call posted the error.
+ *
  *  @param errorPost        Callback to receive error notifications.
  *  @param reference        Constant passed to error callback.
  *  @result                 kQ3Success when the callback is installed.
@@ -673,6 +676,9 @@ Q3Notice_Register (
  *		unreported error code.  After this call, the next Quesa call that is not
  *		part of the Error Manager will clear the error codes.
  *
+ *		Error codes are recorded separately for each thread, so this returns
+ *		only the errors posted by Quesa calls made on the calling thread.
+ *
  *  @param firstError       Pointer to variable to receive the oldest error code
  *							that has not yet been reported.  May be nullptr if you
  *							don't need that information.
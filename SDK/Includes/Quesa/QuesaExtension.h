@@ -455,6 +455,34 @@ Q3XObjectHierarchy_FindClassByType (
 
 
 
+/*!
+ *  @function
+ *      Q3XObjectHierarchy_GetDynamicLookupCount
+ *  @discussion
+ *      Get the number of method lookups which needed a hash table search.
+ *
+ *      Frequently used methods are resolved into a flat table for each
+ *      class when the class is registered. Any other method is found
+ *      through a per-class hash table, and each such lookup is counted.
+ *      Reset the count at the start of a frame and read it at the end to
+ *      see how many dynamic lookups remain on the rendering path.
+ *
+ *      <em>This function is not available in QD3D.</em>
+ *
+ *  @param inReset          If true, the count is reset to 0 after it is read.
+ *  @result                 The number of dynamic method lookups.
+ */
+#if QUESA_ALLOW_QD3D_EXTENSIONS
+
+Q3_EXTERN_API_C ( TQ3Uns32  )
+Q3XObjectHierarchy_GetDynamicLookupCount (
+    TQ3Boolean                    inReset
+);
+
+#endif // QUESA_ALLOW_QD3D_EXTENSIONS
+
+
+
 /*!
  *  @function
  *      Q3XObjectClass_GetPrivate
@@ -1226,6 +1226,43 @@ typedef struct TQ3LayerShifts
 #endif
 
 
+#if QUESA_ALLOW_QD3D_EXTENSIONS
+
+/*!
+ *	@struct
+ *      TQ3GeometryCacheStatistics
+ *	@discussion
+ *		Statistics for the cache of decomposed geometries.
+ *
+ *		Geometries which are not natively supported by a renderer (e.g., a
+ *		sphere) are decomposed into simpler objects, which are cached
+ *		with the geometry. Several decompositions may be kept for each
+ *		geometry, keyed by the subdivision style, orientation style,
+ *		camera and local-to-world scale they were built for.
+ *
+ *		The counters wrap around on overflow.
+ *
+ *		<em>This structure is not available in QD3D.</em>
+ *	@field		hitCount			Number of submits which used a cached decomposition.
+ *	@field		missCount			Number of submits which had to build a decomposition.
+ *	@field		evictionCount		Number of cached decompositions discarded to stay
+ *									within the per-geometry or memory limits.
+ *	@field		entryCount			Number of decompositions currently cached.
+ *	@field		memoryUsed			Estimated size in bytes of the cached decompositions.
+ *	@field		memoryLimit			Memory budget in bytes for the cache.
+ */
+typedef struct TQ3GeometryCacheStatistics {
+	TQ3Uns32									hitCount;
+	TQ3Uns32									missCount;
+	TQ3Uns32									evictionCount;
+	TQ3Uns32									entryCount;
+	TQ3Uns32									memoryUsed;
+	TQ3Uns32									memoryLimit;
+} TQ3GeometryCacheStatistics;
+
+#endif // QUESA_ALLOW_QD3D_EXTENSIONS
+
+
 
 
 //=============================================================================
@@ -1592,6 +1629,55 @@ Q3Geometry_GetDecomposed (
 
 
 
+/*!
+ *	@function
+ *		Q3Geometry_GetCacheStatistics
+ *	@discussion
+ *		Gets statistics for the cache of decomposed geometries.
+ *
+ *		<em>This function is not available in QD3D.</em>
+ *
+ *	@param	statistics		Receives the cache statistics.
+ *	@result					Success or failure of the operation.
+ */
+#if QUESA_ALLOW_QD3D_EXTENSIONS
+
+Q3_EXTERN_API_C( TQ3Status )
+Q3Geometry_GetCacheStatistics (
+	TQ3GeometryCacheStatistics * _Nonnull	statistics
+);
+
+#endif
+
+
+
+/*!
+ *	@function
+ *		Q3Geometry_SetCacheMemoryLimit
+ *	@discussion
+ *		Sets the memory budget for the cache of decomposed geometries.
+ *
+ *		When the estimated size of the cached decompositions exceeds this
+ *		limit, the least recently used decompositions are discarded. The
+ *		decomposition most recently submitted is always kept, so a limit of 0
+ *		keeps a single decomposition at a time. The default limit is 64 MB.
+ *
+ *		<em>This function is not available in QD3D.</em>
+ *
+ *	@param	memoryLimit		The memory budget in bytes.
+ *	@result					Success or failure of the operation.
+ */
+#if QUESA_ALLOW_QD3D_EXTENSIONS
+
+Q3_EXTERN_API_C( TQ3Status )
+Q3Geometry_SetCacheMemoryLimit (
+	TQ3Uns32							memoryLimit
+);
+
+#endif
+
+
+
 /*!
 	@functiongroup	Box Functions
 */
@@ -7994,6 +8080,42 @@ Q3TriMesh_Optimize(
 
 
 
+/*!
+ *	@function
+ *		Q3TriMesh_OptimizeHierarchy
+ *	@abstract
+ *		Optimize each TriMesh in a hierarchy ahead of time, for the
+ *		interactive renderer.
+ *	
+ *	@discussion
+ *		The interactive renderer optimizes a TriMesh as by Q3TriMesh_Optimize
+ *		the first time it draws it, and caches the result on the TriMesh until
+ *		the TriMesh is edited.  This function does the same for each TriMesh
+ *		in an object, such as a group holding a whole scene, so that the work
+ *		can be done after loading the scene rather than in the first frame.
+ *		TriMeshes whose cached result is up to date are skipped.
+ *
+ *		Small TriMeshes are optimized several at once, each on its own thread,
+ *		and the work on each large TriMesh is split across several threads.
+ *		The number of threads is set by Q3SetThreadCount.  Other threads must
+ *		not use the TriMeshes, or the object, until this function returns.
+ *	
+ *      <em>This function is not available in QD3D.</em>
+ *
+ *	@param		inObject		A TriMesh, a group, or another object.
+ *	@result		Success or failure of the operation.
+*/
+#if QUESA_ALLOW_QD3D_EXTENSIONS
+
+Q3_EXTERN_API_C( TQ3Status )
+Q3TriMesh_OptimizeHierarchy(
+	TQ3Object _Nonnull inObject
+);
+
+#endif // QUESA_ALLOW_QD3D_EXTENSIONS
+
+
+
 /*!
 	@function		Q3TriMesh_MakeTriangleStrip
 	@abstract		Compute a triangle strip.
@@ -8031,6 +8153,90 @@ Q3TriMesh_MakeTriangleStrip(
 #endif // QUESA_ALLOW_QD3D_EXTENSIONS
 
 
+
+/*!
+	@function		Q3TriMesh_OptimizeTriangleOrder
+	@abstract		Reorder triangles for a GPU's post-transform vertex cache.
+	@discussion		A GPU keeps recently transformed vertices in a small cache,
+					so an indexed triangle list needs fewer vertex
+					transformations if triangles sharing vertices are drawn
+					close together.  This function reorders the triangles to
+					that end, using Tom Forsyth's linear-speed algorithm.  Each
+					triangle keeps its point indices in the same order, so
+					orientations are preserved.
+					
+					The OpenGL renderer does this itself when the renderer
+					property kQ3RendererPropertyVertexCacheOptimization is set.
+					Use Q3TriMesh_SimulateVertexCache to measure the result.
+					
+ 					<em>This function is not available in QD3D.</em>
+ 	@param	inNumTriangles	Number of triangles.
+ 	@param	inTriangles		Point indices for the triangles.  The length of
+ 							this array should be 3 * inNumTriangles.
+ 	@param	inNumPoints		Number of points.  Each point index must be less
+ 							than this.
+ 	@param	outTriangles	Receives the point indices of the reordered
+ 							triangles.  The length of this array should be
+ 							3 * inNumTriangles.
+ 	@result	Success or failure of the operation.
+*/
+#if QUESA_ALLOW_QD3D_EXTENSIONS
+
+Q3_EXTERN_API_C( TQ3Status )
+Q3TriMesh_OptimizeTriangleOrder(
+	TQ3Uns32 inNumTriangles,
+	const TQ3Uns32* _Nonnull inTriangles,
+	TQ3Uns32 inNumPoints,
+	TQ3Uns32* _Nonnull outTriangles
+);
+
+#endif // QUESA_ALLOW_QD3D_EXTENSIONS
+
+
+
+/*!
+	@function		Q3TriMesh_SimulateVertexCache
+	@abstract		Measure how well an indexed triangle list uses a FIFO
+					post-transform vertex cache.
+	@discussion		The triangles are run through a simulated first in, first
+					out cache of the given size, so that the effect of
+					Q3TriMesh_OptimizeTriangleOrder can be checked without a
+					GPU.
+					
+					The average cache miss ratio (ACMR) is the number of vertex
+					transformations per triangle.  It ranges from 3 down to
+					about 0.5 for a large regular mesh.  The average transform
+					to vertex ratio (ATVR) is the number of vertex
+					transformations per point used by the triangles.  It is at
+					least 1, and 1 is ideal.
+					
+ 					<em>This function is not available in QD3D.</em>
+ 	@param	inNumTriangles	Number of triangles.
+ 	@param	inTriangles		Point indices for the triangles.  The length of
+ 							this array should be 3 * inNumTriangles.
+ 	@param	inNumPoints		Number of points.  Each point index must be less
+ 							than this.
+ 	@param	inCacheSize		Number of vertices held by the simulated cache,
+ 							for example 16 or 32.
+ 	@param	outACMR			Receives the average cache miss ratio.
+ 	@param	outATVR			Receives the average transform to vertex ratio.
+ 	@result	Success or failure of the operation.
+*/
+#if QUESA_ALLOW_QD3D_EXTENSIONS
+
+Q3_EXTERN_API_C( TQ3Status )
+Q3TriMesh_SimulateVertexCache(
+	TQ3Uns32 inNumTriangles,
+	const TQ3Uns32* _Nonnull inTriangles,
+	TQ3Uns32 inNumPoints,
+	TQ3Uns32 inCacheSize,
+	float* _Nonnull outACMR,
+	float* _Nonnull outATVR
+);
+
+#endif // QUESA_ALLOW_QD3D_EXTENSIONS
+
+
 /*!
 	@function	Q3TriMesh_GetNakedGeometry
 	@abstract	Get a reference to the unattributed geometry owned by a TriMesh.
@@ -117,6 +117,33 @@ typedef enum {
 } TQ3DisplayGroupStateMasks;
 
 
+/*!
+	@enum	Display&nbsp;Group&nbsp;Property&nbsp;Types
+
+	@abstract	Object properties that may be set on display groups.
+
+	@constant	kQ3DisplayGroupPropertyPickIndex
+						When this property is true, picking through the group uses
+						a cached hierarchy of the bounds of its contents to skip
+						geometries and subgroups that the pick cannot reach.  The
+						cache is rebuilt when the group or anything inside it is
+						edited, so it is best suited to large scenes which are
+						picked more often than they change.  It is usually enough
+						to set the property on the top-level group of a scene.
+
+						Geometries which follow an inline group or a transform
+						that depends on the camera, and markers, which are picked
+						in window space, are always submitted.
+
+						Data type: TQ3Boolean.  Default value: kQ3False.
+						(Not in QD3D.)
+*/
+enum
+{
+	kQ3DisplayGroupPropertyPickIndex                = Q3_OBJECT_TYPE('d', 'g', 'p', 'x')
+};
+
+
 // Group method types
 enum {
     kQ3XMethodType_GroupAcceptObject            = Q3_METHOD_TYPE('g', 'a', 'c', 'o'),
@@ -1428,6 +1428,72 @@ Q3File_GetReadInGroup (
 
 
 
+/*!
+ *  @function
+ *      Q3File_SetReadInParallel
+ *  @discussion
+ *      Set whether a binary 3DMF file is read on several threads.
+ *
+ *		When this is on, the first call to Q3File_ReadObject reads every
+ *		top-level object in the file at once, on the threads set with
+ *		Q3SetThreadCount, and later calls return those objects in order.
+ *		Objects shared through the table of contents are shared in the
+ *		same way as when the file is read one object at a time, and the
+ *		objects returned are the same.  If the file is laid out in a way
+ *		the parallel reader can't handle, such as references to objects
+ *		further on in the file, or if Q3File_SkipObject is called, the
+ *		rest of the file is read one object at a time as usual.
+ *
+ *		The setting only takes effect if it is made before the first
+ *		object is read, and the whole file is kept in memory until it
+ *		is closed.  Errors posted while reading ahead are posted on the
+ *		threads which did the reading.  The file's idle method is not
+ *		called while the file is read ahead.
+ *
+ *		The default is off.
+ *
+ *      <em>This function is not available in QD3D.</em>
+ *
+ *  @param theFile          The file to update.
+ *  @param readInParallel   Whether to read the file on several threads.
+ *  @result                 Success or failure of the operation.
+ */
+#if QUESA_ALLOW_QD3D_EXTENSIONS
+
+Q3_EXTERN_API_C ( TQ3Status  )
+Q3File_SetReadInParallel (
+    TQ3FileObject _Nonnull                theFile,
+    TQ3Boolean                    readInParallel
+);
+
+#endif
+
+
+
+/*!
+ *  @function
+ *      Q3File_GetReadInParallel
+ *  @discussion
+ *      Get whether a binary 3DMF file is read on several threads.
+ *
+ *      <em>This function is not available in QD3D.</em>
+ *
+ *  @param theFile          The file to query.
+ *  @param readInParallel   Receives whether the file is read on several threads.
+ *  @result                 Success or failure of the operation.
+ */
+#if QUESA_ALLOW_QD3D_EXTENSIONS
+
+Q3_EXTERN_API_C ( TQ3Status  )
+Q3File_GetReadInParallel (
+    TQ3FileObject _Nonnull                theFile,
+    TQ3Boolean                    * _Nonnull readInParallel
+);
+
+#endif
+
+
+
 /*!
  *  @function
  *      Q3File_SetIdleMethod
@@ -282,6 +282,93 @@ enum
 					for more information.
 					
 					Data type: TQ3CastShadowsOverrideCallback.  Default: nullptr.
+	
+	@constant	kQ3RendererPropertyVertexCacheOptimization
+					Whether a TriMesh cached in video memory should be drawn as
+					a list of triangles reordered for the GPU's post-transform
+					vertex cache, with its vertices renumbered in order of
+					first use, rather than as a triangle strip.  Current GPUs
+					gain little from strips, and a reordered list usually needs
+					fewer vertex transformations.  When this is true,
+					kQ3RendererPropertyAutomaticTriangleStrips and any triangle
+					strip element are ignored.  Only used by the OpenGL
+					renderer.  See also Q3TriMesh_OptimizeTriangleOrder.
+					
+					Data type: TQ3Boolean.  Default: kQ3False.
+	
+	@constant	kQ3RendererPropertyBatchSmallTriMeshes
+					Whether small opaque TriMeshes that are submitted one after
+					another with the same material should be merged into a
+					single draw call.  Their vertices are transformed to camera
+					coordinates on the CPU, so that meshes with different
+					transforms can share a draw call.  This helps scenes made
+					of many small TriMeshes, which would otherwise be limited
+					by the number of draw calls.  Meshes are not reordered to
+					group them by material, so submit meshes that share a
+					material together.  Only used by the OpenGL renderer.
+					
+					Data type: TQ3Boolean.  Default: kQ3False.
+	
+	@constant	kQ3RendererPropertyDrawCallCount
+					The renderer uses this property to report the number of
+					OpenGL draw calls made in the most recent frame.  Currently
+					only supported by the OpenGL renderer.
+					
+					Data type: TQ3Uns64.
+	
+	@constant	kQ3RendererPropertySortOpaqueTriMeshes
+					Whether opaque TriMeshes that are cached in video memory
+					should be drawn at the end of the pass, or when a style
+					changes, rather than as they are submitted.  The queued
+					TriMeshes are drawn sorted by surface shader and material,
+					so that fewer shader program switches and texture binds are
+					needed when an application interleaves materials.  Only
+					used by the OpenGL renderer.
+					
+					Data type: TQ3Boolean.  Default: kQ3False.
+	
+	@constant	kQ3RendererPropertyProgramSwitchCount
+					The renderer uses this property to report the number of
+					times it switched shader programs in the most recent frame.
+					Currently only supported by the OpenGL renderer.
+					
+					Data type: TQ3Uns64.
+	
+	@constant	kQ3RendererPropertyTextureBindCount
+					The renderer uses this property to report the number of
+					textures it bound in the most recent frame.  Currently only
+					supported by the OpenGL renderer.
+					
+					Data type: TQ3Uns64.
+	
+	@constant	kQ3RendererPropertyTransparencySortTime
+					The renderer uses this property to report the time, in
+					microseconds, that it spent sorting transparent primitives
+					back to front in the most recent frame.  Currently only
+					supported by the OpenGL renderer.
+					
+					Data type: TQ3Uns64.
+	
+	@constant	kQ3RendererPropertyOrderIndependentTransparency
+					Whether transparent TriMeshes should be drawn with weighted,
+					blended order-independent transparency rather than being
+					broken into triangles and sorted back to front.  The
+					TriMeshes are drawn in the order they were submitted, from
+					video memory like opaque ones, and need no sorting, which
+					is much faster and uses less memory when there is a lot of
+					transparent geometry.  The cost is that the result is an
+					approximation, in which overlapping transparent surfaces
+					are blended with weights depending on their depth and
+					opacity rather than in exact order.  Set this to kQ3False
+					when exact ordering matters.  Transparent geometry that is
+					not a retained TriMesh with uniform transparency, or that
+					is drawn with a different projection than the first such
+					TriMesh of the frame, is still drawn sorted, as is all
+					transparency when the OpenGL context does not support the
+					needed framebuffer objects or is multisampled.  Only used
+					by the OpenGL renderer.
+					
+					Data type: TQ3Boolean.  Default: kQ3False.
 */
 enum
 {
@@ -305,7 +392,15 @@ enum
 	kQ3RendererPropertyPrimitivesRenderedCount      = Q3_OBJECT_TYPE('p', 'r', 'n', 'c'),
 	kQ3RendererPropertyIsLayerShifting              = Q3_OBJECT_TYPE('r', 'i', 'l', 's'),
 	kQ3RendererPropertyClippingPlane                = Q3_OBJECT_TYPE('c', 'l', 'i', 'p'),
-	kQ3RendererPropertyCastShadowsOverride          = Q3_OBJECT_TYPE('c', 's', 'o', 'c')
+	kQ3RendererPropertyCastShadowsOverride          = Q3_OBJECT_TYPE('c', 's', 'o', 'c'),
+	kQ3RendererPropertyVertexCacheOptimization      = Q3_OBJECT_TYPE('v', 'c', 'o', 'p'),
+	kQ3RendererPropertyBatchSmallTriMeshes          = Q3_OBJECT_TYPE('b', 's', 't', 'm'),
+	kQ3RendererPropertyDrawCallCount                = Q3_OBJECT_TYPE('d', 'r', 'c', 'c'),
+	kQ3RendererPropertySortOpaqueTriMeshes          = Q3_OBJECT_TYPE('s', 'o', 't', 'm'),
+	kQ3RendererPropertyProgramSwitchCount           = Q3_OBJECT_TYPE('p', 'g', 's', 'c'),
+	kQ3RendererPropertyTextureBindCount             = Q3_OBJECT_TYPE('t', 'x', 'b', 'c'),
+	kQ3RendererPropertyTransparencySortTime         = Q3_OBJECT_TYPE('t', 's', 'r', 't'),
+	kQ3RendererPropertyOrderIndependentTransparency = Q3_OBJECT_TYPE('o', 'i', 't', 'r')
 };
 
 
@@ -1380,6 +1475,7 @@ typedef Q3_CALLBACK_API_C(TQ3Status,           TQ3XRendererModalConfigureMethod)
  *		<ul>
  *			<li><code>kQ3RendererTypeOpenGL</code>, new OpenGL</li>
  *			<li><code>kQ3RendererTypeGeneric</code>, generic renderer</li>
+ *			<li><code>kQ3RendererTypeSoftware</code>, software rasterizer</li>
  *		</ul>
  *
  *		One can also get a complete list of installed renderer types by calling
@@ -572,6 +572,43 @@ Q3PathStorage_Get (
 #endif // QUESA_ALLOW_QD3D_EXTENSIONS
 
 
+/*!
+ *  @function
+ *      Q3MappedPathStorage_New
+ *  @discussion
+ *      Creates a storage object of type kQ3StorageTypeMappedPath.
+ *
+ *		Like path storage, this type of storage is associated with a file
+ *		specified by a path name. It is intended for reading large files:
+ *		where the platform supports it, a file opened for reading is mapped
+ *		into memory, and otherwise it is read through a large buffer. Files
+ *		opened for writing are also buffered.
+ *
+ *		The file format readers can borrow data directly from the mapped
+ *		file rather than copying it one value at a time.
+ *
+ *		As with other storage types, offsets are 32-bit, so files larger
+ *		than 4 GB can't be opened for reading, and a write which would
+ *		extend a file past 4 GB fails.
+ *
+ *		The file is not modified while it is open for reading, so it must not
+ *		be truncated by another process during that time.
+ *
+ *      <em>This function is not available in QD3D.</em>
+ *
+ *  @param pathName         A NUL-terminated pathname, as might be passed to fopen.
+ *  @result                 The new storage object.
+ */
+#if QUESA_ALLOW_QD3D_EXTENSIONS
+
+Q3_EXTERN_API_C ( TQ3StorageObject _Nonnull )
+Q3MappedPathStorage_New (
+    const char                    * _Nonnull pathName
+);
+
+#endif // QUESA_ALLOW_QD3D_EXTENSIONS
+
+
 /*!
 	@functiongroup Multiplatform File Stream Storage
 */
@@ -817,6 +817,44 @@ Q3View_AllowAllGroupCulling (
 
 
 
+/*!
+ *  @function
+ *      Q3View_AllowAutomaticGroupCulling
+ *  @discussion
+ *      Set the automatic group culling state of a view.
+ *
+ *      If automatic group culling is active, a rendering view will skip
+ *      display groups whose contents are not visible, even if they do not
+ *      have a bounding box set by Q3DisplayGroup_SetAndUseBoundingBox.
+ *      The bounds of each display group are computed from its contents
+ *      when first needed, and kept until something in the group is edited.
+ *
+ *      Only display groups which are not inline can be culled, and a group
+ *      is never culled if its bounds can't be known in advance, such as a
+ *      group containing a marker, a camera or a reset transform.  Groups
+ *      with a bounding box of their own are culled as before, according to
+ *      Q3View_AllowAllGroupCulling.
+ *
+ *      Automatic group culling is off by default.
+ *
+ *      <em>This function is not available in QD3D.</em>
+ *
+ *  @param view             The view to update.
+ *  @param allowCulling     The new automatic group culling state for the view.
+ *  @result                 Success or failure of the operation.
+ */
+#if QUESA_ALLOW_QD3D_EXTENSIONS
+
+Q3_EXTERN_API_C ( TQ3Status  )
+Q3View_AllowAutomaticGroupCulling (
+    TQ3ViewObject _Nonnull                view,
+    TQ3Boolean                    allowCulling
+);
+
+#endif // QUESA_ALLOW_QD3D_EXTENSIONS
+
+
+
 /*!
  *  @function
  *      Q3View_TransformLocalToWorld